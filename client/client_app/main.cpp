@@ -17,6 +17,8 @@
 #include "ipc_sync/Protocol.hpp"
 #include <iostream>
 #include <iomanip>
+#include <future>
+#include <vector>
  
 using namespace ipc_demo;
 
@@ -92,6 +94,22 @@ int main() {
             std::cout << "Failed to get time: " << timeResult.error_message << std::endl;
         }
 
+        // Asynchronous calls on a pipelined channel
+        std::cout << "\n=== Asynchronous Calls ===" << std::endl;
+        ChannelOptions options;
+        options.pipelining = true;
+        auto pipelined_channel = std::make_shared<Channel>(Protocol::UDS_PATH, options);
+        Calculator async_calculator(pipelined_channel);
+
+        std::vector<std::future<Calculator::Result>> futures;
+        for (int i = 1; i <= 5; ++i) {
+            futures.push_back(async_calculator.MultiplyAsync(i, i));
+        }
+        for (size_t i = 0; i < futures.size(); ++i) {
+            std::string label = std::to_string(i + 1) + " * " + std::to_string(i + 1);
+            PrintResult(label, futures[i].get());
+        }
+
         std::cout << "\n[Client] All operations completed!" << std::endl;
         
         // No need to call Disconnect() - destructor will handle it automatically!
@@ -0,0 +1,359 @@
+/**
+ * @file LoadGenerator.cpp
+ * @brief Implementation of the load generator
+ */
+
+#include "LoadGenerator.hpp"
+#include "ipc_sync/CalculatorClient.hpp"
+#include "ipc_sync/TimeClient.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ipc_demo {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Sleep this much less than needed and yield the rest: timer slack would
+// otherwise delay every scheduled send and show up as latency
+constexpr auto SPIN_AHEAD = std::chrono::microseconds(100);
+
+uint64_t Nanoseconds(Clock::duration duration) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+Clock::duration Seconds(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void WaitUntil(Clock::time_point deadline) {
+    if (Clock::now() + SPIN_AHEAD < deadline) {
+        std::this_thread::sleep_until(deadline - SPIN_AHEAD);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+std::string MixEntry::Name() const {
+    switch (operation) {
+        case LoadOperation::Add:      return "add";
+        case LoadOperation::Subtract: return "sub";
+        case LoadOperation::Multiply: return "mul";
+        case LoadOperation::Divide:   return "div";
+        case LoadOperation::Time:     return "time";
+        case LoadOperation::Batch:    return "batch" + std::to_string(batch_size);
+    }
+    return "unknown";
+}
+
+bool LoadOptions::ParseMix(const std::string& text, std::vector<MixEntry>& mix) {
+    std::vector<MixEntry> parsed;
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = std::min(text.find(',', pos), text.size());
+        std::string item = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        MixEntry entry;
+        size_t colon = item.find(':');
+        std::string name = item.substr(0, colon);
+        if (colon != std::string::npos) {
+            std::string weight = item.substr(colon + 1);
+            if (weight.empty() || weight.size() > 6 ||
+                weight.find_first_not_of("0123456789") != std::string::npos) {
+                return false;
+            }
+            entry.weight = static_cast<uint32_t>(std::stoul(weight));
+        }
+
+        if (name == "add") {
+            entry.operation = LoadOperation::Add;
+        } else if (name == "sub") {
+            entry.operation = LoadOperation::Subtract;
+        } else if (name == "mul") {
+            entry.operation = LoadOperation::Multiply;
+        } else if (name == "div") {
+            entry.operation = LoadOperation::Divide;
+        } else if (name == "time") {
+            entry.operation = LoadOperation::Time;
+        } else if (name.compare(0, 5, "batch") == 0) {
+            std::string size = name.substr(5);
+            if (size.empty() || size.size() > 4 || size.find_first_not_of("0123456789") != std::string::npos) {
+                return false;
+            }
+            entry.operation = LoadOperation::Batch;
+            entry.batch_size = std::stoul(size);
+            if (entry.batch_size == 0) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        parsed.push_back(entry);
+    }
+
+    mix = std::move(parsed);
+    return true;
+}
+
+void LoadTotals::Add(const LoadTotals& other) {
+    requests += other.requests;
+    errors += other.errors;
+    latency.Add(other.latency);
+    service.Add(other.service);
+}
+
+void LoadTotals::Reset() {
+    requests = 0;
+    errors = 0;
+    latency.Reset();
+    service.Reset();
+}
+
+struct LoadGenerator::Schedule {
+    Clock::time_point start;            // Sending begins (warm-up)
+    Clock::time_point measure_start;    // Calls scheduled from here on are measured
+    Clock::time_point end;              // No call is scheduled from here on
+    Clock::duration send_interval{};    // Per connection, open loop only
+};
+
+struct LoadGenerator::Worker {
+    struct Connection {
+        std::shared_ptr<Channel> channel;
+        std::unique_ptr<Calculator> calculator;
+        std::unique_ptr<TimeClient> time;
+        Clock::time_point next_send;
+    };
+
+    size_t index = 0;
+    std::vector<Connection> connections;
+    std::thread thread;
+
+    std::mutex mutex;                       // Guards the totals below
+    LoadTotals interval;                    // Since the reporter last collected
+    std::vector<LoadTotals> per_operation;  // Whole measured run
+};
+
+LoadGenerator::LoadGenerator(const LoadOptions& options)
+    : options_(options) {
+    if (options_.connections == 0 || options_.threads == 0) {
+        throw std::invalid_argument("LoadGenerator: connections and threads must be positive");
+    }
+    if (!(options_.rate >= 0) || !(options_.duration_s > 0) || !(options_.interval_s > 0) ||
+        !(options_.warmup_s >= 0)) {
+        throw std::invalid_argument("LoadGenerator: invalid rate, duration, warm-up or interval");
+    }
+    if (options_.mix.empty()) {
+        options_.mix.push_back(MixEntry{});
+    }
+    uint64_t total_weight = 0;
+    for (const auto& entry : options_.mix) {
+        total_weight += entry.weight;
+    }
+    if (total_weight == 0) {
+        throw std::invalid_argument("LoadGenerator: the mix needs a positive weight");
+    }
+    options_.threads = std::min(options_.threads, options_.connections);
+}
+
+LoadReport LoadGenerator::Run(const IntervalCallback& on_interval) {
+    LoadReport report;
+    report.mix = options_.mix;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t i = 0; i < options_.threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->index = i;
+        workers.back()->per_operation.resize(options_.mix.size());
+    }
+    for (size_t i = 0; i < options_.connections; ++i) {
+        auto channel = std::make_shared<Channel>(options_.socket_path, options_.channel);
+        if (!channel->IsConnected()) {
+            report.error_message = "Cannot connect to " + options_.socket_path + ": " + channel->GetLastError();
+            return report;
+        }
+        Worker::Connection connection;
+        connection.calculator = std::make_unique<Calculator>(channel);
+        connection.time = std::make_unique<TimeClient>(channel);
+        connection.channel = std::move(channel);
+        workers[i % workers.size()]->connections.push_back(std::move(connection));
+    }
+
+    Schedule schedule;
+    schedule.start = Clock::now();
+    schedule.measure_start = schedule.start + Seconds(options_.warmup_s);
+    schedule.end = schedule.measure_start + Seconds(options_.duration_s);
+    if (options_.rate > 0) {
+        schedule.send_interval = Seconds(static_cast<double>(options_.connections) / options_.rate);
+        // Stagger the connections over one interval instead of sending in bursts
+        size_t global = 0;
+        for (size_t round = 0; global < options_.connections; ++round) {
+            for (auto& worker : workers) {
+                if (round < worker->connections.size()) {
+                    worker->connections[round].next_send =
+                        schedule.start + schedule.send_interval * global / options_.connections;
+                    ++global;
+                }
+            }
+        }
+    }
+
+    for (auto& worker : workers) {
+        Worker* raw = worker.get();
+        raw->thread = std::thread([this, raw, &schedule]() { RunWorker(*raw, schedule); });
+    }
+
+    // Report every interval of the measured run; the last one also gets
+    // the calls still in flight at the end
+    LoadTotals interval;
+    Clock::time_point last = schedule.measure_start;
+    std::this_thread::sleep_until(schedule.measure_start);
+    while (true) {
+        Clock::time_point until = std::min(last + Seconds(options_.interval_s), schedule.end);
+        std::this_thread::sleep_until(until);
+        if (until >= schedule.end) {
+            for (auto& worker : workers) {
+                worker->thread.join();
+            }
+        }
+
+        interval.Reset();
+        for (auto& worker : workers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            interval.Add(worker->interval);
+            worker->interval.Reset();
+        }
+        if (on_interval) {
+            IntervalReport progress;
+            progress.elapsed_s = std::chrono::duration<double>(until - schedule.measure_start).count();
+            progress.interval_s = std::chrono::duration<double>(until - last).count();
+            progress.totals.Add(interval);
+            on_interval(progress);
+        }
+        last = until;
+        if (until >= schedule.end) {
+            break;
+        }
+    }
+
+    report.per_operation.resize(options_.mix.size());
+    for (auto& worker : workers) {
+        for (size_t op = 0; op < options_.mix.size(); ++op) {
+            report.per_operation[op].Add(worker->per_operation[op]);
+            report.totals.Add(worker->per_operation[op]);
+        }
+    }
+    report.elapsed_s = options_.duration_s;
+    report.success = true;
+    return report;
+}
+
+void LoadGenerator::RunWorker(Worker& worker, const Schedule& schedule) {
+    const bool open_loop = options_.rate > 0;
+    const auto& mix = options_.mix;
+
+    std::vector<uint32_t> cumulative;
+    uint32_t total_weight = 0;
+    for (const auto& entry : mix) {
+        total_weight += entry.weight;
+        cumulative.push_back(total_weight);
+    }
+
+    std::mt19937_64 rng(0x9E3779B97F4A7C15ull + worker.index);
+    std::uniform_int_distribution<uint32_t> pick(0, total_weight - 1);
+    std::uniform_real_distribution<double> operand(1.0, 1000.0);
+    auto response = std::make_unique<ResponseBuffer>();
+    std::vector<std::pair<double, double>> operands;
+
+    size_t next_connection = 0;
+    while (true) {
+        Worker::Connection* connection = nullptr;
+        Clock::time_point scheduled;
+        if (open_loop) {
+            // The connection that is due first
+            connection = &*std::min_element(worker.connections.begin(), worker.connections.end(),
+                [](const auto& a, const auto& b) { return a.next_send < b.next_send; });
+            scheduled = connection->next_send;
+            if (scheduled >= schedule.end) {
+                break;
+            }
+            WaitUntil(scheduled);
+            connection->next_send += schedule.send_interval;
+        } else {
+            connection = &worker.connections[next_connection];
+            next_connection = (next_connection + 1) % worker.connections.size();
+            scheduled = Clock::now();
+            if (scheduled >= schedule.end) {
+                break;
+            }
+        }
+
+        uint32_t ticket = pick(rng);
+        size_t op = static_cast<size_t>(std::upper_bound(cumulative.begin(), cumulative.end(), ticket) -
+                                        cumulative.begin());
+        const MixEntry& entry = mix[op];
+        double a = operand(rng);
+        double b = operand(rng);
+        if (entry.operation == LoadOperation::Batch) {
+            operands.resize(entry.batch_size);
+            for (auto& pair : operands) {
+                pair = {operand(rng), operand(rng)};
+            }
+        }
+
+        Clock::time_point sent = Clock::now();
+        bool ok = false;
+        switch (entry.operation) {
+            case LoadOperation::Add:
+                ok = connection->calculator->Add(a, b, *response).success;
+                break;
+            case LoadOperation::Subtract:
+                ok = connection->calculator->Subtract(a, b, *response).success;
+                break;
+            case LoadOperation::Multiply:
+                ok = connection->calculator->Multiply(a, b, *response).success;
+                break;
+            case LoadOperation::Divide:
+                ok = connection->calculator->Divide(a, b, *response).success;
+                break;
+            case LoadOperation::Time:
+                ok = connection->time->GetCurrentTime(*response).success;
+                break;
+            case LoadOperation::Batch: {
+                auto results = connection->calculator->AddBatch(operands);
+                ok = std::all_of(results.begin(), results.end(), [](const auto& r) { return r.success; });
+                break;
+            }
+        }
+        Clock::time_point done = Clock::now();
+
+        if (scheduled < schedule.measure_start) {
+            continue;
+        }
+        uint64_t latency = Nanoseconds(done - scheduled);
+        uint64_t service = Nanoseconds(done - sent);
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        for (LoadTotals* totals : {&worker.interval, &worker.per_operation[op]}) {
+            ++totals->requests;
+            if (ok) {
+                totals->latency.Record(latency);
+                totals->service.Record(service);
+            } else {
+                ++totals->errors;
+            }
+        }
+    }
+}
+
+} // namespace ipc_demo
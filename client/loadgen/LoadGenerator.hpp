@@ -0,0 +1,164 @@
+/**
+ * @file LoadGenerator.hpp
+ * @brief Open- and closed-loop load generation against the IPC server
+ *
+ * Built only on libipc_sync: each connection is a Channel driven through
+ * the Calculator and TimeClient proxies, like any other client.
+ */
+#ifndef IPC_LOADGEN_LOAD_GENERATOR_HPP
+#define IPC_LOADGEN_LOAD_GENERATOR_HPP
+
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/LatencyHistogram.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @brief Calls the load generator can issue
+ */
+enum class LoadOperation {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Time,
+    Batch   // AddBatch of batch_size additions: the payload grows with the size
+};
+
+/**
+ * @struct MixEntry
+ * @brief One operation of the request mix and its relative weight
+ */
+struct MixEntry {
+    LoadOperation operation = LoadOperation::Add;
+    size_t batch_size = 0;    // Batch only
+    uint32_t weight = 1;
+
+    std::string Name() const;
+};
+
+/**
+ * @struct LoadOptions
+ * @brief What to run, how hard and for how long
+ */
+struct LoadOptions {
+    std::string socket_path = Protocol::UDS_PATH;
+    size_t connections = 1;     // Channels, spread over the threads
+    size_t threads = 1;         // Sending threads, at most one per connection; closed
+                                // loop keeps one call in flight per thread
+
+    /**
+     * Target rate in requests per second over all connections (open
+     * loop): each connection sends on a fixed schedule whether or not
+     * earlier calls were slow, and latency is measured from the time a
+     * call was scheduled, so stalls are charged to every call they delay
+     * (no coordinated omission). 0 runs closed loop: every connection
+     * sends its next call as soon as the previous one returns.
+     */
+    double rate = 0;
+
+    double duration_s = 10;     // Measured run
+    double warmup_s = 0;        // Run first, not measured
+    double interval_s = 1;      // Between progress reports
+    std::vector<MixEntry> mix;  // Empty: Add only
+    ChannelOptions channel;
+
+    /**
+     * @brief Parse a mix such as "add:6,time:2,batch16:1" (weight defaults to 1)
+     *
+     * Names: add, sub, mul, div, time and batchN (AddBatch of N pairs).
+     * @return false if malformed (mix is unchanged)
+     */
+    static bool ParseMix(const std::string& text, std::vector<MixEntry>& mix);
+};
+
+/**
+ * @struct LoadTotals
+ * @brief Calls completed in some span of the run
+ *
+ * latency runs from the scheduled send time (open loop) or the actual
+ * send (closed loop) to completion; service always from the actual send.
+ * The two differ only once the generator falls behind its schedule.
+ */
+struct LoadTotals {
+    uint64_t requests = 0;      // Including errors
+    uint64_t errors = 0;        // Failed calls (not in the histograms)
+    LatencyHistogram latency;
+    LatencyHistogram service;
+
+    void Add(const LoadTotals& other);
+    void Reset();
+};
+
+/**
+ * @struct IntervalReport
+ * @brief Progress of the measured run, once per interval
+ */
+struct IntervalReport {
+    double elapsed_s = 0;       // Since the end of the warm-up
+    double interval_s = 0;      // Length of this interval
+    LoadTotals totals;
+};
+
+/**
+ * @struct LoadReport
+ * @brief Outcome of the measured run
+ */
+struct LoadReport {
+    bool success = false;       // false: could not connect (see error_message)
+    double elapsed_s = 0;
+    LoadTotals totals;
+    std::vector<LoadTotals> per_operation;   // Parallel to the mix
+    std::vector<MixEntry> mix;
+    std::string error_message;
+};
+
+/**
+ * @class LoadGenerator
+ * @brief Drives a mix of calls over many connections and measures them
+ *
+ * Every thread owns its connections and records into its own histograms;
+ * the reporting thread collects them each interval under a per-thread
+ * lock that the sender holds only to record.
+ */
+class LoadGenerator {
+public:
+    using IntervalCallback = std::function<void(const IntervalReport&)>;
+
+    /**
+     * @throws std::invalid_argument on zero connections or threads, a
+     *         negative rate, a non-positive duration or interval, or a mix
+     *         with no weight
+     */
+    explicit LoadGenerator(const LoadOptions& options);
+
+    // Disable copy/move
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+    LoadGenerator(LoadGenerator&&) = delete;
+    LoadGenerator& operator=(LoadGenerator&&) = delete;
+
+    /**
+     * @brief Connect, warm up, run for duration_s and report
+     * @param on_interval Called on the calling thread after every interval
+     */
+    LoadReport Run(const IntervalCallback& on_interval = IntervalCallback());
+
+private:
+    struct Schedule;
+    struct Worker;
+
+    void RunWorker(Worker& worker, const Schedule& schedule);
+
+    LoadOptions options_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_LOADGEN_LOAD_GENERATOR_HPP
@@ -0,0 +1,251 @@
+/**
+ * @file main.cpp
+ * @brief Load generator for the IPC server
+ *
+ * Drives Calculator and TimeClient calls at a fixed rate (open loop) or
+ * as fast as the server answers (closed loop) and prints latency
+ * percentiles every interval and for the whole run. The exit status makes
+ * it usable as a release gate: 2 if any call failed or --max-p99-us was
+ * exceeded.
+ */
+
+#include "LoadGenerator.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Tracer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ipc_demo;
+
+namespace {
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --socket PATH          Server socket (default: " << Protocol::UDS_PATH << ")\n"
+              << "  --connections N        Connections (default: 1)\n"
+              << "  --threads N            Sending threads, at most one per connection (default: 1)\n"
+              << "  --rate R               Requests/s over all connections, open loop; 0 = closed loop\n"
+              << "                         (default: 0)\n"
+              << "  --duration S           Measured seconds (default: 10)\n"
+              << "  --warmup S             Unmeasured seconds first (default: 0)\n"
+              << "  --interval S           Seconds between progress lines (default: 1)\n"
+              << "  --mix LIST             Weighted calls, e.g. add:6,time:2,batch32:1; names: add, sub,\n"
+              << "                         mul, div, time, batchN (AddBatch of N additions) (default: add)\n"
+              << "  --shm                  Use the shared-memory transport\n"
+              << "  --compression          Negotiate payload compression\n"
+              << "  --spin-wait US         Poll for responses this long before blocking (default: 0)\n"
+              << "  --max-p99-us US        Exit with status 2 if the p99 latency is higher\n"
+              << "  --trace-rate R         Trace fraction R (0..1) of calls, server side too (default: 0)\n"
+              << "  --trace-file PATH      Write the traced calls to PATH as a Chrome trace\n"
+              << "  --help                 Show this message" << std::endl;
+}
+
+bool ParseNumber(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0' && value >= 0;
+}
+
+/**
+ * @brief Parse command-line arguments
+ * @return false if the arguments are invalid or --help was requested
+ */
+bool ParseArguments(int argc, char* argv[], LoadOptions& options, double& max_p99_us,
+                    std::string& trace_file) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        double value = 0;
+
+        if (arg == "--socket" && has_value) {
+            options.socket_path = argv[++i];
+        } else if ((arg == "--connections" || arg == "--threads") && has_value) {
+            if (!ParseNumber(argv[++i], value) || value < 1) {
+                std::cerr << "[LoadGen] " << arg << " must be a positive number" << std::endl;
+                return false;
+            }
+            (arg == "--connections" ? options.connections : options.threads) = static_cast<size_t>(value);
+        } else if ((arg == "--rate" || arg == "--duration" || arg == "--warmup" ||
+                    arg == "--interval") && has_value) {
+            if (!ParseNumber(argv[++i], value)) {
+                std::cerr << "[LoadGen] " << arg << " must be a non-negative number" << std::endl;
+                return false;
+            }
+            if (arg == "--rate") {
+                options.rate = value;
+            } else if (arg == "--duration") {
+                options.duration_s = value;
+            } else if (arg == "--warmup") {
+                options.warmup_s = value;
+            } else {
+                options.interval_s = value;
+            }
+        } else if (arg == "--mix" && has_value) {
+            if (!LoadOptions::ParseMix(argv[++i], options.mix)) {
+                std::cerr << "[LoadGen] Invalid mix: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--shm") {
+            options.channel.transport = Transport::SharedMemory;
+        } else if (arg == "--compression") {
+            options.channel.compression = true;
+        } else if (arg == "--spin-wait" && has_value) {
+            if (!ParseNumber(argv[++i], value)) {
+                std::cerr << "[LoadGen] --spin-wait must be a non-negative number" << std::endl;
+                return false;
+            }
+            options.channel.spin_wait_us = static_cast<uint32_t>(value);
+        } else if (arg == "--max-p99-us" && has_value) {
+            if (!ParseNumber(argv[++i], max_p99_us)) {
+                std::cerr << "[LoadGen] --max-p99-us must be a non-negative number" << std::endl;
+                return false;
+            }
+        } else if (arg == "--trace-rate" && has_value) {
+            if (!ParseNumber(argv[++i], value) || value > 1) {
+                std::cerr << "[LoadGen] --trace-rate must be between 0 and 1" << std::endl;
+                return false;
+            }
+            options.channel.trace_sample_rate = value;
+        } else if (arg == "--trace-file" && has_value) {
+            trace_file = argv[++i];
+        } else {
+            if (arg != "--help") {
+                std::cerr << "[LoadGen] Unknown or incomplete option: " << arg << std::endl;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+double Micros(uint64_t ns) {
+    return static_cast<double>(ns) / 1e3;
+}
+
+void PrintIntervalHeader() {
+    std::cout << std::setw(8) << "time(s)" << std::setw(11) << "req/s" << std::setw(8) << "errors"
+              << std::setw(11) << "p50(us)" << std::setw(11) << "p90(us)" << std::setw(11) << "p99(us)"
+              << std::setw(11) << "p99.9(us)" << std::setw(11) << "max(us)" << std::endl;
+}
+
+void PrintInterval(const IntervalReport& progress) {
+    const LatencyHistogram& latency = progress.totals.latency;
+    double rate = progress.interval_s > 0 ? static_cast<double>(progress.totals.requests) / progress.interval_s : 0;
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(8) << progress.elapsed_s << std::setw(11) << rate
+              << std::setw(8) << progress.totals.errors
+              << std::setw(11) << Micros(latency.Percentile(0.50))
+              << std::setw(11) << Micros(latency.Percentile(0.90))
+              << std::setw(11) << Micros(latency.Percentile(0.99))
+              << std::setw(11) << Micros(latency.Percentile(0.999))
+              << std::setw(11) << Micros(latency.Max()) << std::endl;
+}
+
+void PrintDistribution(const std::string& title, const LatencyHistogram& histogram) {
+    std::cout << title << " (us): mean " << Micros(static_cast<uint64_t>(histogram.Mean()))
+              << "  min " << Micros(histogram.Min()) << '\n';
+    for (double q : {0.50, 0.75, 0.90, 0.99, 0.999, 0.9999, 1.0}) {
+        std::cout << "  " << std::setw(8) << std::setprecision(q >= 0.999 ? 3 : 1) << q * 100 << "%"
+                  << std::setprecision(1) << std::setw(12) << Micros(histogram.Percentile(q)) << '\n';
+    }
+}
+
+void PrintReport(const LoadOptions& options, const LoadReport& report) {
+    const LoadTotals& totals = report.totals;
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n=== Summary (" << (options.rate > 0 ? "open" : "closed") << " loop, "
+              << options.connections << " connection(s), " << std::min(options.threads, options.connections)
+              << " thread(s)) ===\n"
+              << "Requests: " << totals.requests << " in " << report.elapsed_s << " s ("
+              << static_cast<double>(totals.requests) / report.elapsed_s << " req/s";
+    if (options.rate > 0) {
+        std::cout << ", target " << options.rate;
+    }
+    std::cout << "), errors: " << totals.errors << '\n';
+
+    PrintDistribution("Latency, from scheduled send", totals.latency);
+    if (options.rate > 0) {
+        PrintDistribution("Service time, from actual send", totals.service);
+    }
+
+    std::cout << std::setw(12) << "operation" << std::setw(12) << "requests" << std::setw(8) << "errors"
+              << std::setw(11) << "p50(us)" << std::setw(11) << "p99(us)" << std::setw(11) << "max(us)" << '\n';
+    for (size_t i = 0; i < report.mix.size(); ++i) {
+        const LoadTotals& op = report.per_operation[i];
+        std::cout << std::setw(12) << report.mix[i].Name() << std::setw(12) << op.requests
+                  << std::setw(8) << op.errors
+                  << std::setw(11) << Micros(op.latency.Percentile(0.50))
+                  << std::setw(11) << Micros(op.latency.Percentile(0.99))
+                  << std::setw(11) << Micros(op.latency.Max()) << '\n';
+    }
+    std::cout << std::flush;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+    double max_p99_us = 0;
+    std::string trace_file;
+    if (!ParseArguments(argc, argv, options, max_p99_us, trace_file)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        LoadGenerator generator(options);
+        std::cout << "=== IPC Load Generator ===\n"
+                  << "Target: " << options.socket_path << ", ";
+        if (options.rate > 0) {
+            std::cout << options.rate << " req/s";
+        } else {
+            std::cout << "max throughput";
+        }
+        std::cout << " for " << options.duration_s << " s" << std::endl;
+
+        bool header_printed = false;
+        bool tracing = options.channel.trace_sample_rate > 0;
+        LoadReport report = generator.Run([&header_printed, tracing](const IntervalReport& progress) {
+            if (tracing) {
+                trace::Tracer::Global().Collect();
+            }
+            if (!header_printed) {
+                PrintIntervalHeader();
+                header_printed = true;
+            }
+            PrintInterval(progress);
+        });
+        if (!report.success) {
+            std::cerr << "[LoadGen] " << report.error_message << std::endl;
+            return 1;
+        }
+        PrintReport(options, report);
+
+        if (tracing && !trace_file.empty()) {
+            if (trace::Tracer::Global().WriteChromeTrace(trace_file)) {
+                std::cout << "Trace written to " << trace_file << std::endl;
+            } else {
+                std::cerr << "[LoadGen] Failed to write trace " << trace_file << std::endl;
+            }
+        }
+
+        int status = 0;
+        if (report.totals.errors > 0) {
+            std::cerr << "[LoadGen] " << report.totals.errors << " call(s) failed" << std::endl;
+            status = 2;
+        }
+        double p99_us = Micros(report.totals.latency.Percentile(0.99));
+        if (max_p99_us > 0 && p99_us > max_p99_us) {
+            std::cerr << "[LoadGen] p99 latency " << p99_us << " us exceeds " << max_p99_us << " us" << std::endl;
+            status = 2;
+        }
+        return status;
+    } catch (const std::exception& e) {
+        std::cerr << "[LoadGen] " << e.what() << std::endl;
+        return 1;
+    }
+}
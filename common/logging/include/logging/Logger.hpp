@@ -0,0 +1,168 @@
+/**
+ * @file Logger.hpp
+ * @brief Asynchronous, level-gated logging
+ *
+ * Log sites format straight into a per-thread lock-free ring; a background
+ * writer thread drains the rings and writes whole batches to stdout
+ * (Trace..Info) and stderr (Warn, Error). The logging thread never blocks
+ * and never performs I/O.
+ *
+ * Two gates keep disabled levels free:
+ * - Compile time: levels below LOGGING_COMPILE_LEVEL (0 = Trace ... 4 = Error)
+ *   compile to nothing.
+ * - Run time: levels below GetLevel() cost one relaxed atomic load; the
+ *   streamed arguments are not evaluated.
+ *
+ * Usage:
+ * @code
+ * LOG_INFO("[Reactor " << index << "] New client connected (fd=" << fd << ")");
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#ifndef LOGGING_COMPILE_LEVEL
+#define LOGGING_COMPILE_LEVEL 0
+#endif
+
+namespace logging {
+
+/**
+ * @enum Level
+ * @brief Message severity, in increasing order
+ */
+enum class Level {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5     // Only valid for SetLevel()
+};
+
+/**
+ * @brief Receives every written line on the writer thread (no trailing newline)
+ */
+using Sink = std::function<void(Level level, std::string_view line)>;
+
+// Longest line kept; longer messages are truncated
+constexpr size_t MAX_LINE_LENGTH = 240;
+
+// Lines a thread can have queued before further lines are dropped
+constexpr size_t THREAD_BUFFER_LINES = 256;
+
+// Longest time a queued line waits for the writer thread
+constexpr int FLUSH_INTERVAL_MS = 10;
+
+/**
+ * @brief Set the lowest level that is logged (default: Info)
+ */
+void SetLevel(Level level);
+
+/**
+ * @brief Get the lowest level that is logged
+ */
+Level GetLevel();
+
+/**
+ * @brief Parse "trace", "debug", "info", "warn", "error" or "off"
+ * @param name Level name
+ * @param level Output: parsed level
+ * @return false if the name is unknown
+ */
+bool ParseLevel(const std::string& name, Level& level);
+
+/**
+ * @brief Get the lower-case name of a level
+ */
+const char* LevelName(Level level);
+
+/**
+ * @brief Block until every line logged before the call has been written
+ */
+void Flush();
+
+/**
+ * @brief Replace the stdout/stderr output
+ * @param sink Called for every line on the writer thread, or nullptr to
+ *        restore the default output
+ */
+void SetSink(Sink sink);
+
+/**
+ * @brief Get the number of lines dropped because a thread buffer was full
+ */
+uint64_t GetDroppedCount();
+
+namespace detail {
+extern std::atomic<int> g_min_level;
+}
+
+/**
+ * @brief True if statements of this level are compiled in (LOGGING_COMPILE_LEVEL)
+ */
+constexpr bool IsCompiledIn(Level level) {
+    return static_cast<int>(level) >= LOGGING_COMPILE_LEVEL;
+}
+
+/**
+ * @brief True if messages of this level are currently logged
+ */
+inline bool IsEnabled(Level level) {
+    return static_cast<int>(level) >= detail::g_min_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * @class LogLine
+ * @brief One message being formatted into the calling thread's ring
+ *
+ * Reserves a ring slot on construction and publishes it on destruction.
+ * Converts to false when the ring is full (the message is dropped and
+ * counted). Use the LOG_* macros rather than this class directly.
+ */
+class LogLine {
+public:
+    explicit LogLine(Level level);
+    ~LogLine();
+
+    // Disable copy/move
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+    LogLine(LogLine&&) = delete;
+    LogLine& operator=(LogLine&&) = delete;
+
+    /**
+     * @brief Stream writing into the reserved slot (valid while this object lives)
+     */
+    std::ostream& Stream() { return *stream_; }
+
+    explicit operator bool() const { return stream_ != nullptr; }
+
+private:
+    std::ostream* stream_{nullptr};
+};
+
+} // namespace logging
+
+#define LOGGING_LOG(level, ...)                                                     \
+    do {                                                                            \
+        if (::logging::IsCompiledIn(level) && ::logging::IsEnabled(level)) {        \
+            if (::logging::LogLine logging_line_{level}) {                          \
+                logging_line_.Stream() << __VA_ARGS__;                              \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#define LOG_TRACE(...) LOGGING_LOG(::logging::Level::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) LOGGING_LOG(::logging::Level::Debug, __VA_ARGS__)
+#define LOG_INFO(...) LOGGING_LOG(::logging::Level::Info, __VA_ARGS__)
+#define LOG_WARN(...) LOGGING_LOG(::logging::Level::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOGGING_LOG(::logging::Level::Error, __VA_ARGS__)
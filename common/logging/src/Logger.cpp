@@ -0,0 +1,416 @@
+/**
+ * @file Logger.cpp
+ * @brief Per-thread log rings and the background writer that drains them
+ */
+
+#include "logging/Logger.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace logging {
+
+namespace detail {
+std::atomic<int> g_min_level{static_cast<int>(Level::Info)};
+}
+
+namespace {
+
+/**
+ * @struct Slot
+ * @brief One formatted line (fixed size, so the ring never allocates)
+ */
+struct Slot {
+    uint64_t sequence;   // Global order across threads
+    uint16_t length;
+    Level level;
+    char text[MAX_LINE_LENGTH];
+};
+
+/**
+ * @struct ThreadBuffer
+ * @brief Single-producer/single-consumer ring owned by one logging thread
+ */
+struct ThreadBuffer {
+    Slot slots[THREAD_BUFFER_LINES];
+    alignas(64) std::atomic<size_t> head{0};   // Next slot the owner thread fills
+    alignas(64) std::atomic<size_t> tail{0};   // Next slot the writer reads
+    std::atomic<bool> retired{false};          // Owner thread exited
+};
+
+/**
+ * @class SlotStreamBuf
+ * @brief streambuf over a slot's text; output past the end is discarded
+ */
+class SlotStreamBuf : public std::streambuf {
+public:
+    void Reset(char* begin, size_t capacity) { setp(begin, begin + capacity); }
+    size_t Length() const { return static_cast<size_t>(pptr() - pbase()); }
+};
+
+/**
+ * @class Writer
+ * @brief Owns the ring registry and the background writer thread
+ */
+class Writer {
+public:
+    static Writer& Instance();
+    static bool Created() { return created_.load(std::memory_order_acquire); }
+
+    std::shared_ptr<ThreadBuffer> Register();
+    void Flush();
+    void SetSink(Sink sink);
+    void Shutdown();
+    void Drain();
+    bool IsAsync() const { return async_.load(); }
+
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> dropped{0};
+
+private:
+    Writer();
+    void Run();
+    void Emit(Level level, const char* text, size_t len);
+    static void WriteAll(int fd, std::string& batch);
+
+    static std::atomic<bool> created_;
+
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+    // Serialises drains; guards everything below up to wait_mutex_
+    std::mutex drain_mutex_;
+    Sink sink_;
+    std::vector<std::shared_ptr<ThreadBuffer>> snapshot_;
+    std::vector<size_t> heads_;
+    std::vector<bool> retired_;
+    std::vector<const Slot*> entries_;
+    std::string out_batch_;
+    std::string err_batch_;
+    uint64_t reported_drops_{0};
+
+    std::mutex wait_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    uint64_t flush_requested_{0};
+    uint64_t flush_done_{0};
+    bool stop_{false};
+
+    std::atomic<bool> async_{true};   // Cleared at exit: lines are then written by the caller
+    std::thread thread_;
+};
+
+std::atomic<bool> Writer::created_{false};
+
+Writer& Writer::Instance() {
+    // Never destroyed: threads may still log while statics are torn down
+    static Writer* writer = new Writer();
+    return *writer;
+}
+
+Writer::Writer() {
+    // Sized up front so that draining a few threads never allocates
+    constexpr size_t EXPECTED_THREADS = 64;
+    buffers_.reserve(EXPECTED_THREADS);
+    snapshot_.reserve(EXPECTED_THREADS);
+    heads_.reserve(EXPECTED_THREADS);
+    retired_.reserve(EXPECTED_THREADS);
+    entries_.reserve(THREAD_BUFFER_LINES);
+    out_batch_.reserve(THREAD_BUFFER_LINES * (MAX_LINE_LENGTH + 1));
+    err_batch_.reserve(THREAD_BUFFER_LINES * (MAX_LINE_LENGTH + 1));
+    thread_ = std::thread([this]() { Run(); });
+    created_.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<ThreadBuffer> Writer::Register() {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    buffers_.push_back(buffer);
+    return buffer;
+}
+
+void Writer::Run() {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this]() {
+            return stop_ || flush_requested_ > flush_done_;
+        });
+        uint64_t target = flush_requested_;
+        lock.unlock();
+        Drain();
+        lock.lock();
+        flush_done_ = std::max(flush_done_, target);
+        flushed_.notify_all();
+    }
+}
+
+void Writer::Flush() {
+    if (!IsAsync()) {
+        Drain();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    uint64_t target = ++flush_requested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, target]() { return flush_done_ >= target; });
+}
+
+void Writer::SetSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    sink_ = std::move(sink);
+}
+
+void Writer::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        if (stop_) {
+            return;
+        }
+        async_.store(false);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+
+    // Lines published before async_ was cleared
+    Drain();
+
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    flush_done_ = flush_requested_;
+    flushed_.notify_all();
+}
+
+void Writer::Drain() {
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        snapshot_ = buffers_;
+    }
+
+    // Collect every published line; a ring retired before its head was read
+    // receives nothing more and can be dropped afterwards
+    entries_.clear();
+    heads_.resize(snapshot_.size());
+    retired_.assign(snapshot_.size(), false);
+    bool any_retired = false;
+    for (size_t i = 0; i < snapshot_.size(); ++i) {
+        ThreadBuffer& buffer = *snapshot_[i];
+        retired_[i] = buffer.retired.load(std::memory_order_acquire);
+        size_t tail = buffer.tail.load(std::memory_order_relaxed);
+        heads_[i] = buffer.head.load(std::memory_order_acquire);
+        for (size_t pos = tail; pos != heads_[i]; ++pos) {
+            entries_.push_back(&buffer.slots[pos % THREAD_BUFFER_LINES]);
+        }
+        any_retired = any_retired || retired_[i];
+    }
+
+    std::sort(entries_.begin(), entries_.end(),
+              [](const Slot* a, const Slot* b) { return a->sequence < b->sequence; });
+    for (const Slot* slot : entries_) {
+        Emit(slot->level, slot->text, slot->length);
+    }
+
+    // The slots are free for reuse only once their text was copied out
+    for (size_t i = 0; i < snapshot_.size(); ++i) {
+        snapshot_[i]->tail.store(heads_[i], std::memory_order_release);
+    }
+
+    uint64_t drops = dropped.load(std::memory_order_relaxed);
+    if (drops != reported_drops_) {
+        std::string line = "[Logger] Dropped " + std::to_string(drops - reported_drops_) +
+                           " message(s), thread buffer full";
+        Emit(Level::Warn, line.data(), line.size());
+        reported_drops_ = drops;
+    }
+
+    WriteAll(STDOUT_FILENO, out_batch_);
+    WriteAll(STDERR_FILENO, err_batch_);
+
+    if (any_retired) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (size_t i = 0; i < snapshot_.size(); ++i) {
+            if (retired_[i]) {
+                buffers_.erase(std::find(buffers_.begin(), buffers_.end(), snapshot_[i]));
+            }
+        }
+    }
+    snapshot_.clear();
+}
+
+void Writer::Emit(Level level, const char* text, size_t len) {
+    if (sink_) {
+        sink_(level, std::string_view(text, len));
+        return;
+    }
+    std::string& batch = level >= Level::Warn ? err_batch_ : out_batch_;
+    batch.append(text, len);
+    batch.push_back('\n');
+}
+
+void Writer::WriteAll(int fd, std::string& batch) {
+    size_t offset = 0;
+    while (offset < batch.size()) {
+        ssize_t n = ::write(fd, batch.data() + offset, batch.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // Nowhere left to report it
+        }
+        offset += static_cast<size_t>(n);
+    }
+    batch.clear();
+}
+
+// Drains the rings and stops the writer thread when the program exits
+struct ShutdownAtExit {
+    ~ShutdownAtExit() {
+        if (Writer::Created()) {
+            Writer::Instance().Shutdown();
+        }
+    }
+} g_shutdown_at_exit;
+
+/**
+ * @struct ThreadState
+ * @brief The calling thread's ring and the stream that formats into it
+ */
+struct ThreadState {
+    ThreadState() : buffer(Writer::Instance().Register()), stream(&streambuf) {
+        default_flags = stream.flags();
+    }
+
+    ~ThreadState();
+
+    std::shared_ptr<ThreadBuffer> buffer;
+    SlotStreamBuf streambuf;
+    std::ostream stream;
+    std::ios_base::fmtflags default_flags;
+    Slot* slot{nullptr};   // Reserved by the LogLine being formatted
+};
+
+// Set once the thread's ThreadState is gone (trivially destructible, so
+// it stays readable from later thread_local destructors)
+thread_local bool t_state_destroyed = false;
+
+ThreadState::~ThreadState() {
+    t_state_destroyed = true;
+    buffer->retired.store(true, std::memory_order_release);
+}
+
+ThreadState* LocalState() {
+    if (t_state_destroyed) {
+        return nullptr;
+    }
+    thread_local ThreadState state;
+    return &state;
+}
+
+} // namespace
+
+void SetLevel(Level level) {
+    detail::g_min_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+Level GetLevel() {
+    return static_cast<Level>(detail::g_min_level.load(std::memory_order_relaxed));
+}
+
+bool ParseLevel(const std::string& name, Level& level) {
+    for (int i = 0; i <= static_cast<int>(Level::Off); ++i) {
+        if (name == LevelName(static_cast<Level>(i))) {
+            level = static_cast<Level>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* LevelName(Level level) {
+    switch (level) {
+        case Level::Trace: return "trace";
+        case Level::Debug: return "debug";
+        case Level::Info:  return "info";
+        case Level::Warn:  return "warn";
+        case Level::Error: return "error";
+        case Level::Off:   return "off";
+    }
+    return "unknown";
+}
+
+void Flush() {
+    if (Writer::Created()) {
+        Writer::Instance().Flush();
+    }
+}
+
+void SetSink(Sink sink) {
+    Writer::Instance().SetSink(std::move(sink));
+}
+
+uint64_t GetDroppedCount() {
+    return Writer::Created() ? Writer::Instance().dropped.load() : 0;
+}
+
+LogLine::LogLine(Level level) {
+    // The first line of a thread registers its ring (and the first line of
+    // the process starts the writer); the message may still use errno
+    int saved_errno = errno;
+    Writer& writer = Writer::Instance();
+    ThreadState* local = LocalState();
+    errno = saved_errno;
+    if (local == nullptr) {
+        writer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;  // Thread is exiting
+    }
+    ThreadState& state = *local;
+
+    // A nested message (logged while formatting another one) or a full ring
+    ThreadBuffer& buffer = *state.buffer;
+    size_t head = buffer.head.load(std::memory_order_relaxed);
+    if (state.slot != nullptr ||
+        head - buffer.tail.load(std::memory_order_acquire) >= THREAD_BUFFER_LINES) {
+        writer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Slot& slot = buffer.slots[head % THREAD_BUFFER_LINES];
+    slot.sequence = writer.sequence.fetch_add(1, std::memory_order_relaxed);
+    slot.level = level;
+    state.slot = &slot;
+
+    // Manipulators such as std::hex must not leak into the next message
+    state.streambuf.Reset(slot.text, MAX_LINE_LENGTH);
+    state.stream.clear();
+    state.stream.flags(state.default_flags);
+    state.stream.precision(6);
+    state.stream.width(0);
+    state.stream.fill(' ');
+    stream_ = &state.stream;
+}
+
+LogLine::~LogLine() {
+    if (stream_ == nullptr) {
+        return;
+    }
+    ThreadState& state = *LocalState();
+    state.slot->length = static_cast<uint16_t>(state.streambuf.Length());
+    state.slot = nullptr;
+    ThreadBuffer& buffer = *state.buffer;
+    buffer.head.store(buffer.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    Writer& writer = Writer::Instance();
+    if (!writer.IsAsync()) {
+        writer.Drain();
+    }
+}
+
+} // namespace logging
@@ -0,0 +1,151 @@
+/**
+ * @file Executor.hpp
+ * @brief Common interface of the thread pools
+ *
+ * The server only depends on IExecutor, so the pool implementation can be
+ * chosen at runtime (see ThreadPool and WorkStealingThreadPool).
+ */
+
+#pragma once
+
+#include "thread_pool/Task.hpp"
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace thread_pool {
+
+/**
+ * @class IExecutor
+ * @brief Interface for executing tasks on worker threads
+ *
+ * Submit() and Post() are templates on top of the single virtual
+ * Enqueue(), so every implementation offers the same API. Tasks travel as
+ * thread_pool::Task, which stores small callables inline.
+ */
+class IExecutor {
+public:
+    virtual ~IExecutor() = default;
+
+    /**
+     * @brief Submit a task to the pool
+     * @tparam F Function type
+     * @tparam Args Argument types
+     * @param f Function to execute
+     * @param args Arguments to pass to the function
+     * @return std::future containing the result of the function
+     * @throws std::runtime_error if the pool is stopped
+     */
+    template<typename F, typename... Args>
+    auto Submit(F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type>;
+
+    /**
+     * @brief Queue a fire-and-forget task
+     *
+     * No future or shared state is created: a callable that fits
+     * Task::INLINE_SIZE is queued without any heap allocation. Exceptions
+     * thrown by the task are logged by the worker and otherwise dropped.
+     *
+     * @param f Callable invocable as f()
+     * @throws std::runtime_error if the pool is stopped
+     */
+    template<typename F>
+    void Post(F&& f) {
+        Enqueue(Task(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Submit a task unless the pool's queue is full
+     *
+     * Fails fast instead of queueing beyond the pool's max_pending_tasks
+     * bound, so a caller under overload can shed or defer the work.
+     *
+     * @return Future for the result, or an invalid future (valid() ==
+     *         false) if the queue is full
+     * @throws std::runtime_error if the pool is stopped
+     */
+    template<typename F, typename... Args>
+    auto TrySubmit(F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type>;
+
+    /**
+     * @brief Queue a fire-and-forget task unless the pool's queue is full
+     * @param f Callable invocable as f(); destroyed if the queue is full
+     * @return false if the queue is full
+     * @throws std::runtime_error if the pool is stopped
+     */
+    template<typename F>
+    bool TryPost(F&& f) {
+        Task task(std::forward<F>(f));
+        return TryEnqueue(task);
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     */
+    virtual size_t GetThreadCount() const = 0;
+
+    /**
+     * @brief Get the number of tasks waiting to be executed
+     */
+    virtual size_t GetPendingTaskCount() const = 0;
+
+    /**
+     * @brief Stop accepting tasks, run everything queued and join the workers
+     */
+    virtual void Shutdown() = 0;
+
+protected:
+    /**
+     * @brief Queue a type-erased task
+     * @throws std::runtime_error if the pool is stopped
+     */
+    virtual void Enqueue(Task task) = 0;
+
+    /**
+     * @brief Queue a task if the pool's bound allows it
+     * @param task Moved from only on success
+     * @return false if the queue is full
+     * @throws std::runtime_error if the pool is stopped
+     */
+    virtual bool TryEnqueue(Task& task) = 0;
+};
+
+// Template implementation must be in header
+template<typename F, typename... Args>
+auto IExecutor::Submit(F&& f, Args&&... args)
+    -> std::future<typename std::result_of<F(Args...)>::type> {
+
+    using return_type = typename std::result_of<F(Args...)>::type;
+
+    // Create a packaged task (move-only, so Task can own it directly)
+    std::packaged_task<return_type()> task(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+
+    std::future<return_type> result = task.get_future();
+    Enqueue(Task(std::move(task)));
+    return result;
+}
+
+template<typename F, typename... Args>
+auto IExecutor::TrySubmit(F&& f, Args&&... args)
+    -> std::future<typename std::result_of<F(Args...)>::type> {
+
+    using return_type = typename std::result_of<F(Args...)>::type;
+
+    std::packaged_task<return_type()> packaged(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+
+    std::future<return_type> result = packaged.get_future();
+    Task task(std::move(packaged));
+    if (!TryEnqueue(task)) {
+        return std::future<return_type>(); // Full: the abandoned task is dropped here
+    }
+    return result;
+}
+
+} // namespace thread_pool
@@ -0,0 +1,171 @@
+/**
+ * @file Task.hpp
+ * @brief Move-only type-erased task with inline small-buffer storage
+ *
+ * Replaces std::function<void()> in the pools: callables up to
+ * Task::INLINE_SIZE bytes are stored inside the Task itself, so queueing
+ * them performs no heap allocation. Move-only callables (captured
+ * std::vector, std::packaged_task, ...) are accepted as well.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace thread_pool {
+
+/**
+ * @class Task
+ * @brief Owning, move-only wrapper around a void() callable
+ *
+ * A callable is stored inline when it fits INLINE_SIZE, needs no more than
+ * std::max_align_t alignment and is nothrow move constructible (moving a
+ * Task must not throw). Anything else is moved to the heap. A Task is two
+ * cache lines, enough for a lambda capturing a copied request buffer and a
+ * handful of pointers and IDs.
+ */
+class Task {
+public:
+    static constexpr size_t INLINE_SIZE = 128 - sizeof(void*);
+
+    /**
+     * @brief True if F is stored without a heap allocation
+     */
+    template<typename F>
+    static constexpr bool StoresInline() {
+        return sizeof(F) <= INLINE_SIZE &&
+               alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+    /**
+     * @brief Construct an empty task
+     */
+    Task() noexcept = default;
+
+    /**
+     * @brief Wrap a callable
+     * @param f Callable invocable as f()
+     */
+    template<typename F,
+             typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Task>::value>::type>
+    Task(F&& f) {
+        using Callable = typename std::decay<F>::type;
+        if constexpr (StoresInline<Callable>()) {
+            new (storage_) Callable(std::forward<F>(f));
+        } else {
+            new (storage_) Callable*(new Callable(std::forward<F>(f)));
+        }
+        ops_ = &OPS<Callable>;
+    }
+
+    Task(Task&& other) noexcept {
+        MoveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        Reset();
+    }
+
+    // Disable copy
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    /**
+     * @brief Run the callable (the task must not be empty)
+     */
+    void operator()() {
+        ops_->invoke(storage_);
+    }
+
+    /**
+     * @brief True if the task holds a callable
+     */
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /**
+     * @brief True if the callable lives in the inline buffer
+     */
+    bool IsInline() const noexcept { return ops_ != nullptr && ops_->is_inline; }
+
+    /**
+     * @brief Destroy the callable, leaving the task empty
+     */
+    void Reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    /**
+     * @struct Ops
+     * @brief Per-callable-type operations (one static table per type)
+     */
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;  // Leaves src destroyed
+        void (*destroy)(void* storage) noexcept;
+        bool is_inline;
+    };
+
+    template<typename Callable>
+    static void Invoke(void* storage) {
+        if constexpr (StoresInline<Callable>()) {
+            (*std::launder(static_cast<Callable*>(storage)))();
+        } else {
+            (**std::launder(static_cast<Callable**>(storage)))();
+        }
+    }
+
+    template<typename Callable>
+    static void Move(void* dst, void* src) noexcept {
+        if constexpr (StoresInline<Callable>()) {
+            Callable* source = std::launder(static_cast<Callable*>(src));
+            new (dst) Callable(std::move(*source));
+            source->~Callable();
+        } else {
+            new (dst) Callable*(*std::launder(static_cast<Callable**>(src)));
+        }
+    }
+
+    template<typename Callable>
+    static void Destroy(void* storage) noexcept {
+        if constexpr (StoresInline<Callable>()) {
+            std::launder(static_cast<Callable*>(storage))->~Callable();
+        } else {
+            delete *std::launder(static_cast<Callable**>(storage));
+        }
+    }
+
+    template<typename Callable>
+    static constexpr Ops OPS = {&Invoke<Callable>, &Move<Callable>, &Destroy<Callable>,
+                                StoresInline<Callable>()};
+
+    void MoveFrom(Task& other) noexcept {
+        if (other.ops_ != nullptr) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_{nullptr};
+};
+
+static_assert(sizeof(Task) == 128, "Task should span exactly two cache lines");
+
+} // namespace thread_pool
@@ -0,0 +1,82 @@
+/**
+ * @file TaskQueue.hpp
+ * @brief FIFO ring of Tasks that stops allocating once it reached its peak size
+ */
+
+#pragma once
+
+#include "thread_pool/Task.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * @class TaskQueue
+ * @brief Growable ring buffer of Tasks (not thread-safe)
+ *
+ * Unlike std::queue (a std::deque that allocates and frees a block every
+ * few elements), the ring only allocates when it has to grow and never
+ * shrinks, so a pool in steady state queues tasks without touching the
+ * heap. Callers provide the locking.
+ */
+class TaskQueue {
+public:
+    /**
+     * @brief Construct an empty queue
+     * @param capacity Initial capacity (rounded up to a power of two)
+     */
+    explicit TaskQueue(size_t capacity = 64) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        ring_.resize(size);
+    }
+
+    /**
+     * @brief Append a task, growing the ring when full
+     */
+    void Push(Task&& task) {
+        if (size_ == ring_.size()) {
+            Grow();
+        }
+        ring_[(head_ + size_) & (ring_.size() - 1)] = std::move(task);
+        ++size_;
+    }
+
+    /**
+     * @brief Remove the oldest task
+     * @param task Output: the task, if any
+     * @return false if the queue was empty
+     */
+    bool Pop(Task& task) {
+        if (size_ == 0) {
+            return false;
+        }
+        task = std::move(ring_[head_]);
+        head_ = (head_ + 1) & (ring_.size() - 1);
+        --size_;
+        return true;
+    }
+
+    size_t Size() const { return size_; }
+    bool Empty() const { return size_ == 0; }
+
+private:
+    void Grow() {
+        std::vector<Task> ring(ring_.size() * 2);
+        for (size_t i = 0; i < size_; ++i) {
+            ring[i] = std::move(ring_[(head_ + i) & (ring_.size() - 1)]);
+        }
+        ring_.swap(ring);
+        head_ = 0;
+    }
+
+    std::vector<Task> ring_;
+    size_t head_{0};
+    size_t size_{0};
+};
+
+} // namespace thread_pool
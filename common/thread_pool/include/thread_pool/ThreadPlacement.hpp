@@ -0,0 +1,58 @@
+/**
+ * @file ThreadPlacement.hpp
+ * @brief CPU pinning for pool workers and other long-lived threads
+ *
+ * Pinning a latency-critical thread keeps its caches warm and, because
+ * Linux places a page on the NUMA node of the thread that first touches
+ * it, also keeps the memory that thread allocates and fills on its local
+ * node.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * @struct ThreadPlacement
+ * @brief CPUs a group of threads is pinned to
+ *
+ * Thread i of the group runs on cpus[i % cpus.size()]; with no CPUs
+ * listed the threads are left to the scheduler.
+ */
+struct ThreadPlacement {
+    std::vector<int> cpus;
+
+    bool IsPinned() const { return !cpus.empty(); }
+
+    /**
+     * @brief CPU of the index-th thread, or -1 if not pinned
+     */
+    int CpuFor(size_t index) const {
+        return cpus.empty() ? -1 : cpus[index % cpus.size()];
+    }
+
+    /**
+     * @brief Parse a CPU list such as "0-3,8,10" (the taskset/cpuset format)
+     * @return false if the list is empty or malformed (placement is unchanged)
+     */
+    static bool Parse(const std::string& list, ThreadPlacement& placement);
+};
+
+/**
+ * @brief Pin the calling thread to one CPU
+ * @param cpu CPU number; -1 leaves the thread unpinned and succeeds
+ * @return false if the CPU does not exist or is outside the process's
+ *         allowed set (errno is set)
+ */
+bool PinCurrentThread(int cpu);
+
+/**
+ * @brief NUMA node the calling thread currently runs on, or -1 if unknown
+ */
+int CurrentNumaNode();
+
+} // namespace thread_pool
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include "thread_pool/Executor.hpp"
+#include "thread_pool/TaskQueue.hpp"
+#include "thread_pool/ThreadPlacement.hpp"
 #include <vector>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -27,15 +29,24 @@ namespace thread_pool {
  * 
  * Based on the simple thread pool design from "C++ Concurrency in Action" Chapter 9.1.
  * Maintains a fixed number of worker threads and a task queue.
+ * All workers share the queue and its mutex; see WorkStealingThreadPool
+ * for a variant without a global lock. Tasks are submitted through
+ * IExecutor::Submit() or IExecutor::Post().
  */
-class ThreadPool {
+class ThreadPool : public IExecutor {
 public:
     /**
      * @brief Construct a thread pool with specified number of threads
      * @param num_threads Number of worker threads (default: hardware concurrency)
+     * @param max_pending_tasks Queue bound for TrySubmit()/TryPost(), 0 = unbounded.
+     *        Submit() and Post() always queue.
+     * @param placement CPUs the workers pin themselves to (default: unpinned);
+     *        a worker that cannot be pinned logs a warning and runs unpinned
      * @throws std::invalid_argument if num_threads is 0
      */
-    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency(),
+                        size_t max_pending_tasks = 0,
+                        const ThreadPlacement& placement = ThreadPlacement());
     
     /**
      * @brief Destructor - waits for all tasks to complete
@@ -48,30 +59,17 @@ public:
     ThreadPool(ThreadPool&&) = delete;
     ThreadPool& operator=(ThreadPool&&) = delete;
     
-    /**
-     * @brief Submit a task to the thread pool
-     * @tparam F Function type
-     * @tparam Args Argument types
-     * @param f Function to execute
-     * @param args Arguments to pass to the function
-     * @return std::future containing the result of the function
-     * @throws std::runtime_error if thread pool is stopped
-     */
-    template<typename F, typename... Args>
-    auto Submit(F&& f, Args&&... args) 
-        -> std::future<typename std::result_of<F(Args...)>::type>;
-    
     /**
      * @brief Get the number of worker threads
      * @return Number of threads in the pool
      */
-    size_t GetThreadCount() const { return workers_.size(); }
+    size_t GetThreadCount() const override { return workers_.size(); }
     
     /**
      * @brief Get the number of pending tasks in the queue
      * @return Number of tasks waiting to be executed
      */
-    size_t GetPendingTaskCount() const;
+    size_t GetPendingTaskCount() const override;
     
     /**
      * @brief Shutdown the thread pool and wait for all tasks to complete
@@ -79,14 +77,19 @@ public:
      * This is a graceful shutdown - all queued tasks will be executed.
      * After calling this, no new tasks can be submitted.
      */
-    void Shutdown();
+    void Shutdown() override;
+
+protected:
+    void Enqueue(Task task) override;
+    bool TryEnqueue(Task& task) override;
 
 private:
     // Worker threads
     std::vector<std::thread> workers_;
     
     // Task queue
-    std::queue<std::function<void()>> tasks_;
+    TaskQueue tasks_;
+    size_t max_pending_tasks_;
     
     // Synchronization primitives
     mutable std::mutex queue_mutex_;
@@ -100,39 +103,9 @@ private:
      * 
      * Continuously pulls tasks from the queue and executes them.
      * Exits when stop flag is set and queue is empty.
+     * @param cpu CPU to pin to first, -1 = unpinned
      */
-    void WorkerThread();
+    void WorkerThread(int cpu);
 };
 
-// Template implementation must be in header
-template<typename F, typename... Args>
-auto ThreadPool::Submit(F&& f, Args&&... args) 
-    -> std::future<typename std::result_of<F(Args...)>::type> {
-    
-    using return_type = typename std::result_of<F(Args...)>::type;
-    
-    // Create a packaged task
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
-    
-    std::future<return_type> result = task->get_future();
-    
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        
-        if (stop_) {
-            throw std::runtime_error("ThreadPool: cannot submit task to stopped pool");
-        }
-        
-        // Enqueue the task
-        tasks_.emplace([task]() { (*task)(); });
-    }
-    
-    // Notify one waiting thread
-    condition_.notify_one();
-    
-    return result;
-}
-
 } // namespace thread_pool
@@ -0,0 +1,164 @@
+/**
+ * @file WorkStealingDeque.hpp
+ * @brief Chase-Lev work-stealing deque (Lê, Pop, Cohen, Zappa Nardelli, PPoPP 2013)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * @class WorkStealingDeque
+ * @brief Lock-free deque owned by one worker and stolen from by all others
+ *
+ * The owner pushes and pops at the bottom (LIFO, cache-warm); thieves take
+ * from the top (FIFO, oldest work first). Only a pop racing a steal for the
+ * last element needs a CAS. The ring grows when full; replaced rings are
+ * kept until the deque is destroyed because a thief may still read them.
+ *
+ * @tparam T Element type, trivially copyable (the pools store pointers)
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "WorkStealingDeque elements are copied through atomics");
+
+public:
+    /**
+     * @brief Construct an empty deque
+     * @param capacity Initial capacity (rounded up to a power of two)
+     */
+    explicit WorkStealingDeque(size_t capacity = 256) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        rings_.push_back(std::make_unique<Ring>(size));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    // Disable copy/move
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    /**
+     * @brief Push at the bottom (owner only)
+     */
+    void Push(T item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(ring->Capacity()) - 1) {
+            ring = Grow(ring, top, bottom);
+        }
+        ring->Put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release); // Publishes the item to thieves
+    }
+
+    /**
+     * @brief Pop the most recently pushed element (owner only)
+     * @return false if the deque is empty
+     */
+    bool Pop(T& item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed); // Was empty
+            return false;
+        }
+
+        item = ring->Get(bottom);
+        if (top == bottom) {
+            // Last element: race the thieves for it
+            bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest element (any thread)
+     * @return false if the deque was empty or another thread won the race
+     */
+    bool Steal(T& item) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        item = ring->Get(top);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Approximate number of elements (exact when quiescent)
+     */
+    size_t Size() const {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+private:
+    class Ring {
+    public:
+        explicit Ring(size_t capacity)
+            : mask_(capacity - 1), slots_(new std::atomic<T>[capacity]) {}
+
+        size_t Capacity() const { return mask_ + 1; }
+
+        void Put(int64_t index, T item) {
+            slots_[static_cast<size_t>(index) & mask_].store(item, std::memory_order_relaxed);
+        }
+
+        T Get(int64_t index) const {
+            return slots_[static_cast<size_t>(index) & mask_].load(std::memory_order_relaxed);
+        }
+
+    private:
+        size_t mask_;
+        std::unique_ptr<std::atomic<T>[]> slots_;
+    };
+
+    // Owner only: copy the live range into a ring twice the size
+    Ring* Grow(Ring* ring, int64_t top, int64_t bottom) {
+        auto bigger = std::make_unique<Ring>(ring->Capacity() * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->Put(i, ring->Get(i));
+        }
+        Ring* result = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(result, std::memory_order_release);
+        return result;
+    }
+
+    // Owner and thieves write different ends: keep them on separate lines
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Ring*> ring_{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings_;  // Current and retired rings (owner only)
+};
+
+} // namespace thread_pool
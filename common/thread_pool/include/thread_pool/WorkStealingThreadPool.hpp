@@ -0,0 +1,149 @@
+/**
+ * @file WorkStealingThreadPool.hpp
+ * @brief Work-stealing thread pool (from C++ Concurrency in Action, Chapter 9.1.5)
+ *
+ * Every worker owns a lock-free Chase-Lev deque. Tasks submitted from a
+ * worker thread stay on that worker; idle workers steal from random victims.
+ */
+
+#pragma once
+
+#include "thread_pool/Executor.hpp"
+#include "thread_pool/TaskQueue.hpp"
+#include "thread_pool/ThreadPlacement.hpp"
+#include "thread_pool/WorkStealingDeque.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * @class WorkStealingThreadPool
+ * @brief Thread pool without a global task queue
+ *
+ * Submission:
+ * - From a worker thread (a task spawning tasks): pushed onto the worker's
+ *   own deque, no lock taken.
+ * - From any other thread (e.g. a server reactor): appended to one
+ *   worker's inbox, chosen round-robin, so submitters spread over N small
+ *   locks instead of contending on one.
+ *
+ * Execution: a worker runs its own deque newest-first, then its inbox,
+ * then steals the oldest task of randomly chosen victims.
+ *
+ * Allocation: external submissions are moved into the inbox ring, local
+ * ones into a TaskNode from the worker's free list. A node stolen by
+ * another worker is handed back to its owner's return list, so a pool in
+ * steady state queues small tasks without heap allocations.
+ *
+ * Idle handling: a worker that finds nothing spins (yielding) for a short
+ * while, then parks on a condition variable. Submitters only touch the
+ * condition variable when some worker is parked.
+ *
+ * Drop-in replacement for ThreadPool: same IExecutor Submit()/Post() API,
+ * exception handling and graceful Shutdown().
+ */
+class WorkStealingThreadPool : public IExecutor {
+public:
+    /**
+     * @brief Construct a pool with the specified number of worker threads
+     * @param num_threads Number of worker threads (default: hardware concurrency)
+     * @param max_pending_tasks Bound for TrySubmit()/TryPost(), 0 = unbounded.
+     *        Checked without a lock, so concurrent submitters may overshoot
+     *        it by one task each. Submit() and Post() always queue.
+     * @param placement CPUs the workers pin themselves to (default: unpinned);
+     *        a worker that cannot be pinned logs a warning and runs unpinned
+     * @throws std::invalid_argument if num_threads is 0
+     */
+    explicit WorkStealingThreadPool(size_t num_threads = std::thread::hardware_concurrency(),
+                                    size_t max_pending_tasks = 0,
+                                    const ThreadPlacement& placement = ThreadPlacement());
+
+    /**
+     * @brief Destructor - waits for all tasks to complete
+     */
+    ~WorkStealingThreadPool() override;
+
+    // Delete copy and move constructors/assignments
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool(WorkStealingThreadPool&&) = delete;
+    WorkStealingThreadPool& operator=(WorkStealingThreadPool&&) = delete;
+
+    size_t GetThreadCount() const override { return workers_.size(); }
+
+    /**
+     * @brief Get the number of queued tasks (deques and inboxes, not running)
+     */
+    size_t GetPendingTaskCount() const override;
+
+    /**
+     * @brief Shutdown the pool and wait for all queued tasks to complete
+     *
+     * After calling this, Submit() throws. Tasks still running may not
+     * submit follow-up tasks either.
+     */
+    void Shutdown() override;
+
+protected:
+    void Enqueue(Task task) override;
+    bool TryEnqueue(Task& task) override;
+
+private:
+    /**
+     * @struct TaskNode
+     * @brief Holder for a locally submitted task (the deque stores pointers)
+     */
+    struct TaskNode {
+        Task task;
+        TaskNode* next{nullptr};  // Free-list link
+        size_t owner{0};          // Worker whose free list the node belongs to
+    };
+
+    /**
+     * @struct Worker
+     * @brief Per-worker queues and thread
+     */
+    struct alignas(64) Worker {
+        WorkStealingDeque<TaskNode*> deque;   // Owner pushes/pops, others steal
+        std::mutex inbox_mutex;
+        TaskQueue inbox;                      // Submissions from outside the pool
+        std::thread thread;
+        uint64_t rng_state;                   // Victim selection (owner only)
+        TaskNode* free_nodes{nullptr};        // Owner only
+        std::mutex returned_mutex;
+        TaskNode* returned_nodes{nullptr};    // Nodes freed by thieves
+    };
+
+    // Spin rounds before an idle worker parks
+    static constexpr int SPIN_ROUNDS = 64;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    size_t max_pending_tasks_;
+    std::atomic<size_t> next_inbox_{0};
+
+    // Queued tasks; pairs with sleepers_ so a submit never misses a parked worker
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> sleepers_{0};
+    std::mutex park_mutex_;
+    std::condition_variable park_condition_;
+
+    std::atomic<bool> stop_{false};
+    std::atomic<size_t> active_submits_{0};  // Enqueue() calls Shutdown() must wait for
+    std::mutex shutdown_mutex_;
+
+    void WorkerThread(size_t index, int cpu);
+    bool FindTask(size_t index, Task& task);
+    bool TakeFromInbox(Worker& worker, bool wait_for_lock, Task& task);
+    TaskNode* AllocateNode(size_t index);
+    void ReleaseNode(size_t index, TaskNode* node);
+    void TakeFromNode(size_t index, TaskNode* node, Task& task);
+    void Park();
+    void WakeOne();
+};
+
+} // namespace thread_pool
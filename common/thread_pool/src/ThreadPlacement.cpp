@@ -0,0 +1,90 @@
+/**
+ * @file ThreadPlacement.cpp
+ * @brief Implementation of CPU pinning helpers
+ */
+
+#include "thread_pool/ThreadPlacement.hpp"
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+
+namespace thread_pool {
+
+namespace {
+
+// One non-negative number at list[pos], advancing pos
+bool ParseCpu(const std::string& list, size_t& pos, int& cpu) {
+    size_t start = pos;
+    long value = 0;
+    while (pos < list.size() && list[pos] >= '0' && list[pos] <= '9') {
+        value = value * 10 + (list[pos] - '0');
+        if (value >= CPU_SETSIZE) {
+            return false;
+        }
+        ++pos;
+    }
+    cpu = static_cast<int>(value);
+    return pos > start;
+}
+
+} // namespace
+
+bool ThreadPlacement::Parse(const std::string& list, ThreadPlacement& placement) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (true) {
+        int first = 0;
+        if (!ParseCpu(list, pos, first)) {
+            return false;
+        }
+        int last = first;
+        if (pos < list.size() && list[pos] == '-') {
+            ++pos;
+            if (!ParseCpu(list, pos, last) || last < first) {
+                return false;
+            }
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+
+        if (pos == list.size()) {
+            break;
+        }
+        if (list[pos] != ',') {
+            return false;
+        }
+        ++pos;
+    }
+
+    placement.cpus = std::move(cpus);
+    return true;
+}
+
+bool PinCurrentThread(int cpu) {
+    if (cpu < 0) {
+        return true;
+    }
+    if (cpu >= CPU_SETSIZE) {
+        errno = EINVAL;
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0; // 0: the calling thread
+}
+
+int CurrentNumaNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return -1;
+    }
+    return static_cast<int>(node);
+}
+
+} // namespace thread_pool
@@ -4,11 +4,14 @@
  */
 
 #include "thread_pool/ThreadPool.hpp"
-#include <iostream>
+#include "logging/Logger.hpp"
+#include <cerrno>
+#include <cstring>
 
 namespace thread_pool {
 
-ThreadPool::ThreadPool(size_t num_threads) {
+ThreadPool::ThreadPool(size_t num_threads, size_t max_pending_tasks, const ThreadPlacement& placement)
+    : max_pending_tasks_(max_pending_tasks) {
     if (num_threads == 0) {
         throw std::invalid_argument("ThreadPool: num_threads must be at least 1");
     }
@@ -17,7 +20,8 @@ ThreadPool::ThreadPool(size_t num_threads) {
     
     // Create worker threads
     for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back([this]() { WorkerThread(); });
+        int cpu = placement.CpuFor(i);
+        workers_.emplace_back([this, cpu]() { WorkerThread(cpu); });
     }
 }
 
@@ -25,28 +29,29 @@ ThreadPool::~ThreadPool() {
     Shutdown();
 }
 
-void ThreadPool::WorkerThread() {
+void ThreadPool::WorkerThread(int cpu) {
+    if (!PinCurrentThread(cpu)) {
+        LOG_WARN("[ThreadPool] Cannot pin worker to CPU " << cpu << ": " << std::strerror(errno));
+    }
+
     while (true) {
-        std::function<void()> task;
+        Task task;
         
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
             
             // Wait for a task or stop signal
             condition_.wait(lock, [this]() {
-                return stop_ || !tasks_.empty();
+                return stop_ || !tasks_.Empty();
             });
             
             // Exit if stopping and no more tasks
-            if (stop_ && tasks_.empty()) {
+            if (stop_ && tasks_.Empty()) {
                 return;
             }
             
             // Get the next task
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
-            }
+            tasks_.Pop(task);
         }
         
         // Execute the task (outside the lock)
@@ -54,19 +59,51 @@ void ThreadPool::WorkerThread() {
             try {
                 task();
             } catch (const std::exception& e) {
-                std::cerr << "[ThreadPool] Task threw exception: " 
-                          << e.what() << std::endl;
+                LOG_ERROR("[ThreadPool] Task threw exception: " << e.what());
             } catch (...) {
-                std::cerr << "[ThreadPool] Task threw unknown exception" 
-                          << std::endl;
+                LOG_ERROR("[ThreadPool] Task threw unknown exception");
             }
         }
     }
 }
 
+void ThreadPool::Enqueue(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+
+        if (stop_) {
+            throw std::runtime_error("ThreadPool: cannot submit task to stopped pool");
+        }
+
+        // Enqueue the task
+        tasks_.Push(std::move(task));
+    }
+
+    // Notify one waiting thread
+    condition_.notify_one();
+}
+
+bool ThreadPool::TryEnqueue(Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+
+        if (stop_) {
+            throw std::runtime_error("ThreadPool: cannot submit task to stopped pool");
+        }
+        if (max_pending_tasks_ > 0 && tasks_.Size() >= max_pending_tasks_) {
+            return false;
+        }
+
+        tasks_.Push(std::move(task));
+    }
+
+    condition_.notify_one();
+    return true;
+}
+
 size_t ThreadPool::GetPendingTaskCount() const {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    return tasks_.size();
+    return tasks_.Size();
 }
 
 void ThreadPool::Shutdown() {
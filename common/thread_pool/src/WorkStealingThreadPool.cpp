@@ -0,0 +1,273 @@
+/**
+ * @file WorkStealingThreadPool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ */
+
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include "logging/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace thread_pool {
+
+namespace {
+
+// Worker identity of the current thread, for local submission
+thread_local const WorkStealingThreadPool* tls_pool = nullptr;
+thread_local size_t tls_worker = 0;
+
+uint64_t NextRandom(uint64_t& state) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t num_threads, size_t max_pending_tasks,
+                                               const ThreadPlacement& placement)
+    : max_pending_tasks_(max_pending_tasks) {
+    if (num_threads == 0) {
+        throw std::invalid_argument("WorkStealingThreadPool: num_threads must be at least 1");
+    }
+
+    // All queues exist before any worker can try to steal from them
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->rng_state = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        int cpu = placement.CpuFor(i);
+        workers_[i]->thread = std::thread([this, i, cpu]() { WorkerThread(i, cpu); });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    Shutdown();
+
+    // Every task ran, so every node is back on its owner's lists
+    for (auto& worker : workers_) {
+        for (TaskNode* list : {worker->free_nodes, worker->returned_nodes}) {
+            while (list != nullptr) {
+                TaskNode* next = list->next;
+                delete list;
+                list = next;
+            }
+        }
+    }
+}
+
+void WorkStealingThreadPool::Enqueue(Task task) {
+    // Announce the submit before checking stop_, so Shutdown() either
+    // sees it and waits, or we see stop_ and back out
+    active_submits_.fetch_add(1, std::memory_order_seq_cst);
+    if (stop_.load(std::memory_order_seq_cst)) {
+        active_submits_.fetch_sub(1, std::memory_order_release);
+        throw std::runtime_error("WorkStealingThreadPool: cannot submit task to stopped pool");
+    }
+
+    // Counted before it is published: a spinning worker may run it (and
+    // decrement) before this thread gets past Push()
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    try {
+        if (tls_pool == this) {
+            TaskNode* node = AllocateNode(tls_worker);
+            node->task = std::move(task);
+            workers_[tls_worker]->deque.Push(node);
+        } else {
+            Worker& worker = *workers_[next_inbox_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+            std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+            worker.inbox.Push(std::move(task));
+        }
+    } catch (...) {
+        pending_.fetch_sub(1, std::memory_order_seq_cst);
+        active_submits_.fetch_sub(1, std::memory_order_release);
+        throw;
+    }
+
+    active_submits_.fetch_sub(1, std::memory_order_release);
+    WakeOne();
+}
+
+bool WorkStealingThreadPool::TryEnqueue(Task& task) {
+    if (max_pending_tasks_ > 0 && pending_.load(std::memory_order_relaxed) >= max_pending_tasks_) {
+        if (stop_.load(std::memory_order_acquire)) {
+            throw std::runtime_error("WorkStealingThreadPool: cannot submit task to stopped pool");
+        }
+        return false;
+    }
+
+    Enqueue(std::move(task));
+    return true;
+}
+
+size_t WorkStealingThreadPool::GetPendingTaskCount() const {
+    return pending_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::Shutdown() {
+    std::lock_guard<std::mutex> shutdown_lock(shutdown_mutex_);
+    if (stop_.exchange(true, std::memory_order_seq_cst)) {
+        return; // Already stopped
+    }
+
+    // Let submits that got past the stop_ check finish queueing
+    while (active_submits_.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        park_condition_.notify_all();
+    }
+
+    // Workers drain every queued task before they exit
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void WorkStealingThreadPool::WorkerThread(size_t index, int cpu) {
+    if (!PinCurrentThread(cpu)) {
+        LOG_WARN("[WorkStealingThreadPool] Cannot pin worker " << index << " to CPU " << cpu << ": "
+                 << std::strerror(errno));
+    }
+
+    tls_pool = this;
+    tls_worker = index;
+
+    int idle_rounds = 0;
+    Task task;
+    while (true) {
+        if (FindTask(index, task)) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            idle_rounds = 0;
+
+            try {
+                task();
+            } catch (const std::exception& e) {
+                LOG_ERROR("[WorkStealingThreadPool] Task threw exception: " << e.what());
+            } catch (...) {
+                LOG_ERROR("[WorkStealingThreadPool] Task threw unknown exception");
+            }
+            task.Reset();
+            continue;
+        }
+
+        if (stop_.load(std::memory_order_acquire) && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+
+        if (++idle_rounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+        Park();
+        idle_rounds = 0;
+    }
+}
+
+bool WorkStealingThreadPool::FindTask(size_t index, Task& task) {
+    Worker& self = *workers_[index];
+    TaskNode* node = nullptr;
+
+    if (self.deque.Pop(node)) {
+        TakeFromNode(index, node, task);
+        return true;
+    }
+    if (TakeFromInbox(self, true, task)) {
+        return true;
+    }
+
+    // Steal, starting at a random victim
+    size_t count = workers_.size();
+    size_t start = static_cast<size_t>(NextRandom(self.rng_state) % count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == index) {
+            continue;
+        }
+        if (workers_[victim]->deque.Steal(node)) {
+            TakeFromNode(index, node, task);
+            return true;
+        }
+        if (TakeFromInbox(*workers_[victim], false, task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingThreadPool::TakeFromInbox(Worker& worker, bool wait_for_lock, Task& task) {
+    std::unique_lock<std::mutex> lock(worker.inbox_mutex, std::defer_lock);
+    if (wait_for_lock) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return false; // Busy: try the next victim instead
+    }
+    return worker.inbox.Pop(task);
+}
+
+void WorkStealingThreadPool::TakeFromNode(size_t index, TaskNode* node, Task& task) {
+    // Recycle the node before running, so a task that submits more work
+    // finds it on the free list
+    task = std::move(node->task);
+    ReleaseNode(index, node);
+}
+
+WorkStealingThreadPool::TaskNode* WorkStealingThreadPool::AllocateNode(size_t index) {
+    Worker& self = *workers_[index];
+    if (self.free_nodes == nullptr) {
+        std::lock_guard<std::mutex> lock(self.returned_mutex);
+        self.free_nodes = self.returned_nodes;
+        self.returned_nodes = nullptr;
+    }
+
+    TaskNode* node = self.free_nodes;
+    if (node == nullptr) {
+        node = new TaskNode();
+        node->owner = index;
+        return node;
+    }
+    self.free_nodes = node->next;
+    return node;
+}
+
+void WorkStealingThreadPool::ReleaseNode(size_t index, TaskNode* node) {
+    Worker& owner = *workers_[node->owner];
+    if (node->owner == index) {
+        node->next = owner.free_nodes;
+        owner.free_nodes = node;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(owner.returned_mutex);
+    node->next = owner.returned_nodes;
+    owner.returned_nodes = node;
+}
+
+void WorkStealingThreadPool::Park() {
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    park_condition_.wait(lock, [this]() {
+        return pending_.load(std::memory_order_seq_cst) > 0 || stop_.load(std::memory_order_seq_cst);
+    });
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::WakeOne() {
+    if (sleepers_.load(std::memory_order_seq_cst) == 0) {
+        return; // Everyone is busy or spinning and will find the task
+    }
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    park_condition_.notify_one();
+}
+
+} // namespace thread_pool
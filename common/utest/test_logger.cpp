@@ -0,0 +1,190 @@
+/**
+ * @file test_logger.cpp
+ * @brief Unit tests for the asynchronous logger
+ *
+ * Test Coverage:
+ * - Runtime level gating (disabled arguments are not evaluated)
+ * - Formatting state, truncation and level parsing
+ * - Lines from many threads, including threads that already exited
+ * - Dropping instead of blocking when a thread buffer is full
+ */
+
+#include "logging/Logger.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace logging;
+
+namespace {
+
+/**
+ * @class LoggerTest
+ * @brief Captures every written line instead of printing it
+ */
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!IsCompiledIn(Level::Debug)) {
+            GTEST_SKIP() << "Built with LOGGING_COMPILE_LEVEL above debug";
+        }
+        Flush();
+        SetSink([this](Level level, std::string_view line) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lines_.emplace_back(level, std::string(line));
+        });
+        SetLevel(Level::Info);
+    }
+
+    void TearDown() override {
+        Flush();
+        SetSink(nullptr);
+        SetLevel(Level::Info);
+    }
+
+    // Lines written so far (waits for the writer thread first)
+    std::vector<std::pair<Level, std::string>> Lines() {
+        Flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lines_;
+    }
+
+    std::mutex mutex_;
+    std::vector<std::pair<Level, std::string>> lines_;
+};
+
+} // namespace
+
+TEST_F(LoggerTest, WritesEnabledLevels) {
+    LOG_INFO("[Test] value=" << 42);
+    LOG_ERROR("[Test] failed");
+
+    auto lines = Lines();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ(Level::Info, lines[0].first);
+    EXPECT_EQ("[Test] value=42", lines[0].second);
+    EXPECT_EQ(Level::Error, lines[1].first);
+    EXPECT_EQ("[Test] failed", lines[1].second);
+}
+
+TEST_F(LoggerTest, DisabledLevelsDoNotEvaluateArguments) {
+    int evaluated = 0;
+    auto touch = [&evaluated]() { return ++evaluated; };
+
+    SetLevel(Level::Warn);
+    LOG_DEBUG("[Test] " << touch());
+    LOG_INFO("[Test] " << touch());
+    LOG_WARN("[Test] " << touch());
+
+    EXPECT_EQ(1, evaluated);
+    auto lines = Lines();
+    ASSERT_EQ(1u, lines.size());
+    EXPECT_EQ(Level::Warn, lines[0].first);
+
+    SetLevel(Level::Off);
+    LOG_ERROR("[Test] " << touch());
+    EXPECT_EQ(1, evaluated);
+    EXPECT_EQ(1u, Lines().size());
+}
+
+TEST_F(LoggerTest, ManipulatorsDoNotLeakIntoNextLine) {
+    LOG_INFO(std::hex << 255);
+    LOG_INFO(255);
+
+    auto lines = Lines();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("ff", lines[0].second);
+    EXPECT_EQ("255", lines[1].second);
+}
+
+TEST_F(LoggerTest, TruncatesLongLines) {
+    std::string long_text(MAX_LINE_LENGTH + 100, 'x');
+    LOG_INFO(long_text << "tail");
+
+    auto lines = Lines();
+    ASSERT_EQ(1u, lines.size());
+    EXPECT_EQ(std::string(MAX_LINE_LENGTH, 'x'), lines[0].second);
+}
+
+TEST_F(LoggerTest, KeepsPerThreadOrderAcrossThreads) {
+    constexpr int THREADS = 4;
+    constexpr int LINES = 50;  // Below THREAD_BUFFER_LINES: nothing is dropped
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < LINES; ++i) {
+                LOG_INFO(t << ' ' << i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every thread already exited; its buffer is still drained
+    auto lines = Lines();
+    ASSERT_EQ(static_cast<size_t>(THREADS * LINES), lines.size());
+    std::vector<int> next(THREADS, 0);
+    for (const auto& line : lines) {
+        int t = std::stoi(line.second);
+        int i = std::stoi(line.second.substr(line.second.find(' ') + 1));
+        EXPECT_EQ(next[t], i);
+        next[t] = i + 1;
+    }
+}
+
+TEST_F(LoggerTest, DropsInsteadOfBlockingWhenBufferFull) {
+    // Hold the writer thread inside the sink so nothing is drained
+    std::mutex gate_mutex;
+    std::condition_variable gate;
+    bool entered = false;
+    bool released = false;
+    std::atomic<int> written{0};
+    SetSink([&](Level, std::string_view) {
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        entered = true;
+        gate.notify_all();
+        gate.wait(lock, [&]() { return released; });
+        written.fetch_add(1);
+    });
+
+    uint64_t dropped_before = GetDroppedCount();
+    LOG_INFO("[Test] first");
+    {
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        gate.wait(lock, [&]() { return entered; });
+    }
+
+    constexpr size_t EXTRA = 10;
+    for (size_t i = 0; i < THREAD_BUFFER_LINES + EXTRA; ++i) {
+        LOG_INFO("[Test] line " << i);
+    }
+    EXPECT_GE(GetDroppedCount() - dropped_before, EXTRA);
+
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex);
+        released = true;
+    }
+    gate.notify_all();
+    Flush();
+
+    // The queued lines and a "[Logger] Dropped ..." report
+    EXPECT_GT(written.load(), static_cast<int>(THREAD_BUFFER_LINES - EXTRA));
+}
+
+TEST(LoggerLevelTest, ParsesLevelNames) {
+    Level level = Level::Info;
+    EXPECT_TRUE(ParseLevel("debug", level));
+    EXPECT_EQ(Level::Debug, level);
+    EXPECT_TRUE(ParseLevel("off", level));
+    EXPECT_EQ(Level::Off, level);
+    EXPECT_FALSE(ParseLevel("verbose", level));
+    EXPECT_EQ(Level::Off, level);
+    EXPECT_STREQ("warn", LevelName(Level::Warn));
+}
@@ -0,0 +1,268 @@
+/**
+ * @file test_task.cpp
+ * @brief Unit tests for Task, TaskQueue and IExecutor::Post
+ *
+ * Test Coverage:
+ * - Inline vs. heap storage, move-only callables, moves and destruction
+ * - TaskQueue FIFO order across growth
+ * - Post on both pools, including the allocation-free steady state
+ */
+
+#include "thread_pool/Task.hpp"
+#include "thread_pool/TaskQueue.hpp"
+#include "thread_pool/ThreadPool.hpp"
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace thread_pool;
+
+// ============================================================================
+// Allocation counting (replaces the global operator new in this binary)
+// ============================================================================
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// Post `count` tasks and wait until all ran; returns allocations meanwhile
+size_t CountAllocationsForPosts(IExecutor& pool, int count) {
+    std::atomic<int> done{0};
+    size_t before = g_allocations.load();
+    for (int i = 0; i < count; ++i) {
+        pool.Post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (done.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+    return g_allocations.load() - before;
+}
+
+// Grow the pool's queues to hold `count` tasks at once: the workers are
+// held back until everything is queued
+void WarmUp(IExecutor& pool, int count) {
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    int workers = static_cast<int>(pool.GetThreadCount());
+    for (int i = 0; i < workers; ++i) {
+        pool.Post([&release, &done]() {
+            while (!release.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            done.fetch_add(1);
+        });
+    }
+    for (int i = 0; i < count; ++i) {
+        pool.Post([&done]() { done.fetch_add(1); });
+    }
+    release.store(true, std::memory_order_release);
+    while (done.load() < workers + count) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Task Tests
+// ============================================================================
+
+TEST(TaskTest, DefaultTaskIsEmpty) {
+    Task task;
+    EXPECT_FALSE(task);
+    EXPECT_FALSE(task.IsInline());
+}
+
+TEST(TaskTest, SmallLambdaIsStoredInline) {
+    int calls = 0;
+    int* counter = &calls;
+
+    size_t before = g_allocations.load();
+    Task task([counter]() { ++*counter; });
+    size_t allocations = g_allocations.load() - before;
+
+    EXPECT_EQ(0u, allocations);
+    EXPECT_TRUE(task.IsInline());
+    task();
+    task();
+    EXPECT_EQ(2, calls);
+}
+
+TEST(TaskTest, LargeCallableFallsBackToHeap) {
+    std::array<char, Task::INLINE_SIZE + 1> big{};
+    big[0] = 7;
+    int result = 0;
+
+    Task task([big, &result]() { result = big[0]; });
+    EXPECT_TRUE(task);
+    EXPECT_FALSE(task.IsInline());
+    task();
+    EXPECT_EQ(7, result);
+}
+
+TEST(TaskTest, AcceptsMoveOnlyCallables) {
+    auto value = std::make_unique<int>(42);
+    int result = 0;
+
+    Task task([value = std::move(value), &result]() { result = *value; });
+    EXPECT_TRUE(task.IsInline());
+    task();
+    EXPECT_EQ(42, result);
+}
+
+TEST(TaskTest, MoveTransfersCallableAndEmptiesSource) {
+    auto tracker = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = tracker;
+
+    Task first([tracker = std::move(tracker)]() { ++*tracker; });
+    Task second(std::move(first));
+    EXPECT_FALSE(first);
+    ASSERT_TRUE(second);
+    second();
+    EXPECT_EQ(1, *weak.lock());
+
+    Task third;
+    third = std::move(second);
+    EXPECT_FALSE(second);
+    third();
+    EXPECT_EQ(2, *weak.lock());
+
+    third.Reset();
+    EXPECT_FALSE(third);
+    EXPECT_TRUE(weak.expired()); // Captures destroyed with the callable
+}
+
+TEST(TaskTest, HeapCallableIsDestroyedOnce) {
+    auto tracker = std::make_shared<int>(0);
+    std::weak_ptr<int> weak = tracker;
+    std::array<char, Task::INLINE_SIZE> padding{};
+
+    {
+        Task task([tracker = std::move(tracker), padding]() { (void)padding; });
+        EXPECT_FALSE(task.IsInline());
+        Task moved(std::move(task));
+        EXPECT_FALSE(weak.expired());
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
+// ============================================================================
+// TaskQueue Tests
+// ============================================================================
+
+TEST(TaskQueueTest, KeepsFifoOrderAcrossGrowth) {
+    TaskQueue queue(2);
+    std::vector<int> order;
+
+    // Wrap the ring before it grows
+    queue.Push(Task([&order]() { order.push_back(0); }));
+    Task task;
+    ASSERT_TRUE(queue.Pop(task));
+    task();
+
+    for (int i = 1; i <= 10; ++i) {
+        queue.Push(Task([&order, i]() { order.push_back(i); }));
+    }
+    EXPECT_EQ(10u, queue.Size());
+
+    while (queue.Pop(task)) {
+        task();
+    }
+    EXPECT_TRUE(queue.Empty());
+    ASSERT_EQ(11u, order.size());
+    for (int i = 0; i <= 10; ++i) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+// ============================================================================
+// Post Tests
+// ============================================================================
+
+TEST(PostTest, RunsTasksOnBothPools) {
+    ThreadPool queue_pool(2);
+    WorkStealingThreadPool stealing_pool(2);
+
+    for (IExecutor* pool : {static_cast<IExecutor*>(&queue_pool), static_cast<IExecutor*>(&stealing_pool)}) {
+        std::atomic<int> sum{0};
+        for (int i = 1; i <= 100; ++i) {
+            pool->Post([&sum, i]() { sum.fetch_add(i); });
+        }
+        pool->Shutdown();
+        EXPECT_EQ(5050, sum.load());
+    }
+}
+
+TEST(PostTest, ThrowsOnStoppedPool) {
+    ThreadPool pool(1);
+    pool.Shutdown();
+    EXPECT_THROW(pool.Post([]() {}), std::runtime_error);
+}
+
+TEST(PostTest, ExceptionsDoNotStopThePool) {
+    WorkStealingThreadPool pool(2);
+    pool.Post([]() { throw std::runtime_error("dropped"); });
+    EXPECT_EQ(7, pool.Submit([]() { return 7; }).get());
+}
+
+TEST(PostTest, SharedQueuePoolPostsWithoutAllocating) {
+    ThreadPool pool(2);
+    WarmUp(pool, 1000);
+    EXPECT_EQ(0u, CountAllocationsForPosts(pool, 1000));
+}
+
+TEST(PostTest, WorkStealingPoolPostsWithoutAllocating) {
+    WorkStealingThreadPool pool(2);
+    WarmUp(pool, 1000);
+    EXPECT_EQ(0u, CountAllocationsForPosts(pool, 1000));
+}
+
+TEST(PostTest, WorkStealingPoolRecyclesLocalTaskNodes) {
+    WorkStealingThreadPool pool(1);
+    std::atomic<int> done{0};
+    constexpr int CHILDREN = 64;
+
+    auto fan_out = [&pool, &done]() {
+        for (int i = 0; i < CHILDREN; ++i) {
+            pool.Post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+    };
+
+    // A single worker, so every child is a local submission
+    pool.Post(fan_out);
+    while (done.load() < CHILDREN) {
+        std::this_thread::yield();
+    }
+
+    size_t before = g_allocations.load();
+    pool.Post(fan_out);
+    while (done.load() < 2 * CHILDREN) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(0u, g_allocations.load() - before);
+}
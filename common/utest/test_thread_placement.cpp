@@ -0,0 +1,96 @@
+/**
+ * @file test_thread_placement.cpp
+ * @brief Unit tests for CPU pinning of pool workers
+ */
+
+#include "thread_pool/ThreadPlacement.hpp"
+#include "thread_pool/ThreadPool.hpp"
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <thread>
+
+using namespace thread_pool;
+
+namespace {
+
+// First CPU this process may run on
+int AllowedCpu() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return -1;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(ThreadPlacementTest, ParsesCpuLists) {
+    ThreadPlacement placement;
+    ASSERT_TRUE(ThreadPlacement::Parse("0-3,8,10-11", placement));
+    EXPECT_EQ(placement.cpus, (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(placement.IsPinned());
+    EXPECT_EQ(placement.CpuFor(0), 0);
+    EXPECT_EQ(placement.CpuFor(7), 0); // Wraps around
+
+    ASSERT_TRUE(ThreadPlacement::Parse("5", placement));
+    EXPECT_EQ(placement.cpus, std::vector<int>{5});
+
+    // Malformed lists leave the placement alone
+    for (const char* bad : {"", "1,", ",1", "3-1", "a", "1-", "1 2", "99999"}) {
+        EXPECT_FALSE(ThreadPlacement::Parse(bad, placement)) << bad;
+        EXPECT_EQ(placement.cpus, std::vector<int>{5}) << bad;
+    }
+
+    EXPECT_FALSE(ThreadPlacement().IsPinned());
+    EXPECT_EQ(ThreadPlacement().CpuFor(3), -1);
+}
+
+TEST(ThreadPlacementTest, PinsTheCallingThread) {
+    int cpu = AllowedCpu();
+    ASSERT_GE(cpu, 0);
+
+    bool pinned = false;
+    int ran_on = -1;
+    std::thread thread([&]() {
+        pinned = PinCurrentThread(cpu);
+        ran_on = sched_getcpu();
+    });
+    thread.join();
+    EXPECT_TRUE(pinned);
+    EXPECT_EQ(ran_on, cpu);
+
+    EXPECT_TRUE(PinCurrentThread(-1)); // Unpinned: nothing to do
+    std::thread invalid([&]() { pinned = PinCurrentThread(CPU_SETSIZE); });
+    invalid.join();
+    EXPECT_FALSE(pinned);
+
+    EXPECT_GE(CurrentNumaNode(), 0);
+}
+
+TEST(ThreadPlacementTest, PoolWorkersRunOnTheirCpus) {
+    int cpu = AllowedCpu();
+    ASSERT_GE(cpu, 0);
+    ThreadPlacement placement{{cpu}};
+
+    ThreadPool pool(2, 0, placement);
+    EXPECT_EQ(pool.Submit([]() { return sched_getcpu(); }).get(), cpu);
+
+    WorkStealingThreadPool stealing(2, 0, placement);
+    EXPECT_EQ(stealing.Submit([]() { return sched_getcpu(); }).get(), cpu);
+}
+
+TEST(ThreadPlacementTest, UnusableCpuLeavesWorkersUnpinned) {
+    ThreadPlacement placement{{CPU_SETSIZE - 1}};
+    ThreadPool pool(1, 0, placement);
+    EXPECT_EQ(pool.Submit([]() { return 42; }).get(), 42);
+
+    WorkStealingThreadPool stealing(1, 0, placement);
+    EXPECT_EQ(stealing.Submit([]() { return 42; }).get(), 42);
+}
@@ -12,6 +12,7 @@
  * - Queue monitoring
  * - Stress testing with many tasks
  * - Thread safety verification
+ * - Bounded queue (TrySubmit / TryPost)
  */
 
 #include "thread_pool/ThreadPool.hpp"
@@ -499,6 +500,67 @@ TEST(ThreadPoolTest, TasksExecuteFasterWithMoreThreads) {
     EXPECT_LT(duration2, duration1 * 0.7);
 }
 
+// ============================================================================
+// Bounded Queue Tests
+// ============================================================================
+
+TEST(ThreadPoolTest, TrySubmitFailsFastWhenQueueFull) {
+    ThreadPool pool(1, 2);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> started;
+
+    // Occupy the only worker, then fill the queue
+    auto blocker = pool.Submit([gate, &started]() {
+        started.set_value();
+        gate.wait();
+    });
+    started.get_future().wait();
+
+    auto first = pool.TrySubmit([]() { return 1; });
+    auto second = pool.TrySubmit([]() { return 2; });
+    auto rejected = pool.TrySubmit([]() { return 3; });
+    bool posted = pool.TryPost([]() {});
+
+    EXPECT_TRUE(first.valid());
+    EXPECT_TRUE(second.valid());
+    EXPECT_FALSE(rejected.valid());
+    EXPECT_FALSE(posted);
+    EXPECT_EQ(2u, pool.GetPendingTaskCount());
+
+    // Submit() ignores the bound
+    auto forced = pool.Submit([]() { return 4; });
+
+    release.set_value();
+    EXPECT_EQ(1, first.get());
+    EXPECT_EQ(2, second.get());
+    EXPECT_EQ(4, forced.get());
+    blocker.get();
+
+    // Room again once the queue drained
+    auto later = pool.TrySubmit([]() { return 5; });
+    ASSERT_TRUE(later.valid());
+    EXPECT_EQ(5, later.get());
+}
+
+TEST(ThreadPoolTest, TrySubmitUnboundedByDefault) {
+    ThreadPool pool(1);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool.TrySubmit([i]() { return i; }));
+        ASSERT_TRUE(futures.back().valid());
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i, futures[i].get());
+    }
+}
+
+TEST(ThreadPoolTest, TrySubmitThrowsOnStoppedPool) {
+    ThreadPool pool(1, 4);
+    pool.Shutdown();
+    EXPECT_THROW(pool.TrySubmit([]() {}), std::runtime_error);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
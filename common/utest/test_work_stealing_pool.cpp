@@ -0,0 +1,332 @@
+/**
+ * @file test_work_stealing_pool.cpp
+ * @brief Unit tests for WorkStealingDeque and WorkStealingThreadPool
+ *
+ * Test Coverage:
+ * - Deque owner LIFO / thief FIFO order, growth, concurrent steals
+ * - Pool submission from outside and from worker threads
+ * - Stealing, parking and wake-up of idle workers
+ * - Exceptions, shutdown and the shared IExecutor interface
+ * - Bounded queue (TryPost), also while workers spin on it
+ */
+
+#include "thread_pool/WorkStealingDeque.hpp"
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include "thread_pool/ThreadPool.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace thread_pool;
+
+// ============================================================================
+// WorkStealingDeque Tests
+// ============================================================================
+
+TEST(WorkStealingDequeTest, OwnerPopsNewestThiefStealsOldest) {
+    WorkStealingDeque<int> deque(4);
+    for (int i = 1; i <= 3; ++i) {
+        deque.Push(i);
+    }
+
+    int value = 0;
+    ASSERT_TRUE(deque.Steal(value));
+    EXPECT_EQ(1, value);
+    ASSERT_TRUE(deque.Pop(value));
+    EXPECT_EQ(3, value);
+    ASSERT_TRUE(deque.Pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(deque.Pop(value));
+    EXPECT_FALSE(deque.Steal(value));
+    EXPECT_TRUE(deque.Empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsBeyondInitialCapacity) {
+    WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 1000; ++i) {
+        deque.Push(i);
+    }
+    EXPECT_EQ(1000u, deque.Size());
+
+    int value = 0;
+    for (int i = 999; i >= 0; --i) {
+        ASSERT_TRUE(deque.Pop(value));
+        EXPECT_EQ(i, value);
+    }
+}
+
+TEST(WorkStealingDequeTest, ConcurrentThievesTakeEachItemOnce) {
+    constexpr int ITEMS = 100000;
+    constexpr int THIEVES = 3;
+    WorkStealingDeque<int> deque(64);
+    std::vector<std::vector<int>> stolen(THIEVES);
+    std::vector<int> popped;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; ++t) {
+        thieves.emplace_back([&, t]() {
+            int value = 0;
+            while (!done.load() || !deque.Empty()) {
+                if (deque.Steal(value)) {
+                    stolen[t].push_back(value);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // The owner pushes (growing the ring) and pops concurrently with the thieves
+    int value = 0;
+    for (int i = 0; i < ITEMS; ++i) {
+        deque.Push(i);
+        if (i % 3 == 0 && deque.Pop(value)) {
+            popped.push_back(value);
+        }
+    }
+    while (deque.Pop(value)) {
+        popped.push_back(value);
+    }
+    done.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    std::vector<int> seen(ITEMS, 0);
+    for (int item : popped) {
+        seen[item]++;
+    }
+    for (const auto& items : stolen) {
+        for (int item : items) {
+            seen[item]++;
+        }
+    }
+    for (int i = 0; i < ITEMS; ++i) {
+        ASSERT_EQ(1, seen[i]) << "item " << i;
+    }
+}
+
+// ============================================================================
+// WorkStealingThreadPool Tests
+// ============================================================================
+
+TEST(WorkStealingThreadPoolTest, ConstructorRejectsZeroThreads) {
+    EXPECT_THROW(WorkStealingThreadPool pool(0), std::invalid_argument);
+}
+
+TEST(WorkStealingThreadPoolTest, SubmitReturnsResult) {
+    WorkStealingThreadPool pool(2);
+    EXPECT_EQ(2u, pool.GetThreadCount());
+
+    auto sum = pool.Submit([](int a, int b) { return a + b; }, 20, 22);
+    auto text = pool.Submit([]() { return std::string("stolen"); });
+    EXPECT_EQ(42, sum.get());
+    EXPECT_EQ("stolen", text.get());
+}
+
+TEST(WorkStealingThreadPoolTest, ManyTasksFromManySubmitters) {
+    WorkStealingThreadPool pool(4);
+    constexpr int SUBMITTERS = 4;
+    constexpr int TASKS = 5000;
+    std::atomic<int> counter{0};
+
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < SUBMITTERS; ++s) {
+        submitters.emplace_back([&]() {
+            std::vector<std::future<void>> futures;
+            for (int i = 0; i < TASKS; ++i) {
+                futures.push_back(pool.Submit([&counter]() { counter++; }));
+            }
+            for (auto& future : futures) {
+                future.get();
+            }
+        });
+    }
+    for (auto& submitter : submitters) {
+        submitter.join();
+    }
+
+    EXPECT_EQ(SUBMITTERS * TASKS, counter.load());
+    EXPECT_EQ(0u, pool.GetPendingTaskCount());
+}
+
+// Recursive fan-out: tasks submit their children from worker threads
+TEST(WorkStealingThreadPoolTest, NestedSubmissionFromWorkers) {
+    WorkStealingThreadPool pool(4);
+    std::atomic<int> leaves{0};
+    std::function<void(int)> spawn = [&](int depth) {
+        if (depth == 0) {
+            leaves++;
+            return;
+        }
+        pool.Submit(spawn, depth - 1);
+        pool.Submit(spawn, depth - 1);
+    };
+
+    pool.Submit(spawn, 12);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (leaves.load() < (1 << 12) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(1 << 12, leaves.load());
+    pool.Shutdown(); // Inner tasks still reference spawn
+}
+
+TEST(WorkStealingThreadPoolTest, IdleWorkersStealLocalWork) {
+    WorkStealingThreadPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> runners;
+
+    // One task queues everything on its own worker, then stays busy;
+    // only stealing lets the other workers run the children
+    auto parent = pool.Submit([&]() {
+        std::vector<std::future<void>> children;
+        for (int i = 0; i < 64; ++i) {
+            children.push_back(pool.Submit([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(mutex);
+                runners.insert(std::this_thread::get_id());
+            }));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::this_thread::get_id();
+    });
+
+    std::thread::id parent_id = parent.get();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (runners.size() > 1 || (runners.size() == 1 && *runners.begin() != parent_id)) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    pool.Shutdown(); // Children reference mutex and runners
+    ASSERT_FALSE(runners.empty());
+    EXPECT_TRUE(runners.size() > 1 || *runners.begin() != parent_id);
+}
+
+TEST(WorkStealingThreadPoolTest, ParkedWorkersWakeForNewTasks) {
+    WorkStealingThreadPool pool(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let the workers park
+
+    for (int round = 0; round < 20; ++round) {
+        auto future = pool.Submit([]() { return 7; });
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(2)));
+        EXPECT_EQ(7, future.get());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+TEST(WorkStealingThreadPoolTest, ExceptionsReachTheFutureAndPoolSurvives) {
+    WorkStealingThreadPool pool(2);
+    auto failing = pool.Submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+
+    auto ok = pool.Submit([]() { return 1; });
+    EXPECT_EQ(1, ok.get());
+}
+
+TEST(WorkStealingThreadPoolTest, ShutdownRunsQueuedTasks) {
+    std::atomic<int> completed{0};
+    {
+        WorkStealingThreadPool pool(2);
+        for (int i = 0; i < 100; ++i) {
+            pool.Submit([&completed]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                completed++;
+            });
+        }
+        pool.Shutdown();
+        EXPECT_EQ(100, completed.load());
+        EXPECT_NO_THROW(pool.Shutdown());
+        EXPECT_THROW(pool.Submit([]() {}), std::runtime_error);
+    }
+    EXPECT_EQ(100, completed.load());
+}
+
+TEST(WorkStealingThreadPoolTest, UsableThroughExecutorInterface) {
+    std::vector<std::unique_ptr<IExecutor>> executors;
+    executors.push_back(std::make_unique<ThreadPool>(2));
+    executors.push_back(std::make_unique<WorkStealingThreadPool>(2));
+
+    for (auto& executor : executors) {
+        auto future = executor->Submit([](int x) { return x * 2; }, 21);
+        EXPECT_EQ(42, future.get());
+        executor->Shutdown();
+    }
+}
+
+TEST(WorkStealingThreadPoolTest, TryPostFailsFastWhenFull) {
+    WorkStealingThreadPool pool(1, 3);
+    std::atomic<bool> release{false};
+    std::atomic<bool> started{false};
+    std::atomic<int> ran{0};
+
+    pool.Post([&]() {
+        started.store(true);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i) {
+        accepted += pool.TryPost([&ran]() { ran.fetch_add(1); }) ? 1 : 0;
+    }
+    EXPECT_EQ(3, accepted);
+    EXPECT_FALSE(pool.TrySubmit([]() { return 0; }).valid());
+
+    release.store(true);
+    pool.Shutdown();
+    EXPECT_EQ(3, ran.load());
+}
+
+TEST(WorkStealingThreadPoolTest, TryPostAcceptsWorkWhileWorkersSpin) {
+    constexpr int MAX_PENDING = 8;
+    constexpr int TASKS = 5000;
+    WorkStealingThreadPool pool(4, MAX_PENDING);
+    std::atomic<int> ran{0};
+    std::atomic<bool> done{false};
+    std::atomic<size_t> max_pending{0};
+
+    std::thread watcher([&]() {
+        while (!done.load()) {
+            size_t pending = pool.GetPendingTaskCount();
+            if (pending > max_pending.load()) {
+                max_pending.store(pending);
+            }
+        }
+    });
+
+    // Workers stay busy or spinning; never more than half the bound is
+    // outstanding, so every TryPost must be accepted
+    int refused = 0;
+    for (int i = 0; i < TASKS; ++i) {
+        while (i - ran.load() >= MAX_PENDING / 2) {
+            std::this_thread::yield();
+        }
+        refused += pool.TryPost([&ran]() { ran.fetch_add(1); }) ? 0 : 1;
+    }
+    pool.Shutdown();
+    done.store(true);
+    watcher.join();
+
+    EXPECT_EQ(0, refused);
+    EXPECT_EQ(TASKS, ran.load());
+    EXPECT_LE(max_pending.load(), static_cast<size_t>(MAX_PENDING));
+    EXPECT_EQ(0u, pool.GetPendingTaskCount());
+}
@@ -10,23 +10,243 @@
 #include "CalculatorService.hpp"
 #include "TimeService.hpp"
 #include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Tracer.hpp"
+#include "logging/Logger.hpp"
 #include <iostream>
+#include <fstream>
 #include <csignal>
+#include <cstdio>
 #include <memory>
 #include <atomic>
+#include <cstdlib>
+#include <string>
 
 using namespace ipc_demo;
 
 std::atomic<bool> shutdown_requested{false};
+std::atomic<int> received_signal{0};
+
+// How often --metrics-file is rewritten
+constexpr int METRICS_FILE_INTERVAL_MS = 1000;
+
+// How often recorded spans are collected from the reactor and worker rings
+constexpr int TRACE_COLLECT_INTERVAL_MS = 1000;
+
+/**
+ * @struct AppOptions
+ * @brief Options handled by the application rather than the server
+ */
+struct AppOptions {
+    std::string metrics_file;   // Empty: not written
+    std::string trace_file;     // Empty: not written
+    ResponseCacheOptions cache;
+};
 
 void SignalHandler(int signal) {
-    std::cout << "\n[Server] Received signal " << signal << ", shutting down..." << std::endl;
+    // Only async-signal-safe work here; the main loop logs the shutdown
+    received_signal.store(signal);
     shutdown_requested.store(true);
 }
 
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --reactors N           Number of event-loop threads (default: 1)\n"
+              << "  --accept-policy P      round-robin | least-loaded (default: round-robin)\n"
+              << "  --execution M          inline | pool (default: inline)\n"
+              << "  --workers N            Worker threads for --execution pool (default: all cores)\n"
+              << "  --pool K               queue | stealing: worker pool type (default: queue)\n"
+              << "  --no-shm               Refuse shared-memory transport negotiation\n"
+              << "  --io B                 epoll | io_uring: socket I/O backend (default: epoll)\n"
+              << "  --reactor-cpus LIST    Pin reactors to CPUs, e.g. 0-3,8 (default: unpinned)\n"
+              << "  --worker-cpus LIST     Pin pool workers to CPUs (default: unpinned)\n"
+              << "  --busy-poll US         Reactors spin US microseconds after the last event (default: 0)\n"
+              << "  --max-pending N        Queued requests per connection (default: unlimited)\n"
+              << "  --max-queued N         Requests waiting in the worker pool (default: unlimited)\n"
+              << "  --overload P           backpressure | reject: beyond those bounds (default: backpressure)\n"
+              << "  --cache N              Response cache entries for idempotent services, 0 = off (default: 4096)\n"
+              << "  --hot-restart PATH     Take over from the server on control socket PATH, then listen on it\n"
+              << "  --drain-timeout MS     After a takeover, wait MS for busy connections (default: 5000)\n"
+              << "  --log-level L          trace | debug | info | warn | error | off (default: info)\n"
+              << "  --metrics-file PATH    Write Prometheus metrics to PATH every second\n"
+              << "  --trace-rate R         Trace fraction R (0..1) of requests, plus those clients trace (default: 0)\n"
+              << "  --trace-file PATH      Write the traced requests to PATH as a Chrome trace on exit\n"
+              << "  --help                 Show this message" << std::endl;
+}
+
+/**
+ * @brief Parse command-line options into a server configuration
+ * @return false if the arguments are invalid or --help was requested
+ */
+bool ParseArguments(int argc, char* argv[], ServerConfig& config, AppOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "--reactors" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value <= 0) {
+                std::cerr << "[Server] --reactors must be a positive number" << std::endl;
+                return false;
+            }
+            config.num_reactors = static_cast<size_t>(value);
+        } else if (arg == "--accept-policy" && has_value) {
+            std::string policy = argv[++i];
+            if (policy == "round-robin") {
+                config.accept_policy = AcceptPolicy::RoundRobin;
+            } else if (policy == "least-loaded") {
+                config.accept_policy = AcceptPolicy::LeastLoaded;
+            } else {
+                std::cerr << "[Server] Unknown accept policy: " << policy << std::endl;
+                return false;
+            }
+        } else if (arg == "--execution" && has_value) {
+            std::string mode = argv[++i];
+            if (mode == "inline") {
+                config.execution_mode = ExecutionMode::Inline;
+            } else if (mode == "pool") {
+                config.execution_mode = ExecutionMode::ThreadPool;
+            } else {
+                std::cerr << "[Server] Unknown execution mode: " << mode << std::endl;
+                return false;
+            }
+        } else if (arg == "--workers" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value <= 0) {
+                std::cerr << "[Server] --workers must be a positive number" << std::endl;
+                return false;
+            }
+            config.worker_threads = static_cast<size_t>(value);
+        } else if (arg == "--pool" && has_value) {
+            std::string kind = argv[++i];
+            if (kind == "queue") {
+                config.worker_pool = WorkerPoolKind::SharedQueue;
+            } else if (kind == "stealing") {
+                config.worker_pool = WorkerPoolKind::WorkStealing;
+            } else {
+                std::cerr << "[Server] Unknown worker pool: " << kind << std::endl;
+                return false;
+            }
+        } else if (arg == "--no-shm") {
+            config.enable_shared_memory = false;
+        } else if (arg == "--io" && has_value) {
+            std::string backend = argv[++i];
+            if (backend == "epoll") {
+                config.io_backend = IoBackend::Epoll;
+            } else if (backend == "io_uring") {
+                config.io_backend = IoBackend::IoUring;
+            } else {
+                std::cerr << "[Server] Unknown I/O backend: " << backend << std::endl;
+                return false;
+            }
+        } else if ((arg == "--reactor-cpus" || arg == "--worker-cpus") && has_value) {
+            auto& placement = arg == "--reactor-cpus" ? config.reactor_placement : config.worker_placement;
+            if (!thread_pool::ThreadPlacement::Parse(argv[++i], placement)) {
+                std::cerr << "[Server] Invalid CPU list for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--busy-poll" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value < 0) {
+                std::cerr << "[Server] --busy-poll must not be negative" << std::endl;
+                return false;
+            }
+            config.busy_poll_us = static_cast<uint32_t>(value);
+        } else if (arg == "--max-pending" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value <= 0) {
+                std::cerr << "[Server] --max-pending must be a positive number" << std::endl;
+                return false;
+            }
+            config.max_pending_per_connection = static_cast<size_t>(value);
+        } else if (arg == "--max-queued" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value <= 0) {
+                std::cerr << "[Server] --max-queued must be a positive number" << std::endl;
+                return false;
+            }
+            config.max_queued_requests = static_cast<size_t>(value);
+        } else if (arg == "--overload" && has_value) {
+            std::string policy = argv[++i];
+            if (policy == "backpressure") {
+                config.overload_policy = OverloadPolicy::Backpressure;
+            } else if (policy == "reject") {
+                config.overload_policy = OverloadPolicy::Reject;
+            } else {
+                std::cerr << "[Server] Unknown overload policy: " << policy << std::endl;
+                return false;
+            }
+        } else if (arg == "--cache" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value < 0) {
+                std::cerr << "[Server] --cache must not be negative" << std::endl;
+                return false;
+            }
+            options.cache.capacity = static_cast<size_t>(value);
+        } else if (arg == "--hot-restart" && has_value) {
+            config.handoff_path = argv[++i];
+        } else if (arg == "--drain-timeout" && has_value) {
+            int value = std::atoi(argv[++i]);
+            if (value < 0) {
+                std::cerr << "[Server] --drain-timeout must not be negative" << std::endl;
+                return false;
+            }
+            config.handoff_drain_timeout_ms = static_cast<uint32_t>(value);
+        } else if (arg == "--log-level" && has_value) {
+            std::string name = argv[++i];
+            logging::Level level;
+            if (!logging::ParseLevel(name, level)) {
+                std::cerr << "[Server] Unknown log level: " << name << std::endl;
+                return false;
+            }
+            logging::SetLevel(level);
+        } else if (arg == "--metrics-file" && has_value) {
+            options.metrics_file = argv[++i];
+        } else if (arg == "--trace-rate" && has_value) {
+            double value = std::atof(argv[++i]);
+            if (value < 0.0 || value > 1.0) {
+                std::cerr << "[Server] --trace-rate must be between 0 and 1" << std::endl;
+                return false;
+            }
+            config.trace_sample_rate = value;
+        } else if (arg == "--trace-file" && has_value) {
+            options.trace_file = argv[++i];
+        } else {
+            if (arg != "--help") {
+                std::cerr << "[Server] Unknown or incomplete option: " << arg << std::endl;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Replace path with the current metrics (for a textfile collector)
+ *
+ * Written to a temporary file and renamed, so readers never see a partial file.
+ */
+void WriteMetricsFile(const std::string& path, const Metrics& metrics) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        out << Metrics::FormatPrometheus(metrics.Snapshot());
+        if (!out) {
+            LOG_WARN("[Server] Failed to write " << tmp_path);
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG_WARN("[Server] Failed to replace " << path);
+    }
+}
+
 int main(int argc, char* argv[]) {
-    (void)argc; // Not using command-line arguments currently
-    (void)argv; // Reserved for future configuration options
+    ServerConfig config;
+    AppOptions options;
+    if (!ParseArguments(argc, argv, config, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
     
     std::cout << "=== IPC Demo Server ===" << std::endl;
     std::cout << "Socket path: " << Protocol::UDS_PATH << std::endl;
@@ -38,51 +258,73 @@ int main(int argc, char* argv[]) {
 
     try {
         // Create service manager
-        auto service_manager = std::make_shared<ServiceManager>();
+        auto service_manager = std::make_shared<ServiceManager>(options.cache);
 
         // Register services
-        std::cout << "[Server] Registering services..." << std::endl;
+        LOG_INFO("[Server] Registering services...");
         
         auto calculator_service = std::make_shared<CalculatorService>();
         if (!service_manager->RegisterService(calculator_service)) {
-            std::cerr << "[Server] Failed to register CalculatorService" << std::endl;
+            LOG_ERROR("[Server] Failed to register CalculatorService");
             return 1;
         }
 
         auto time_service = std::make_shared<TimeService>();
         if (!service_manager->RegisterService(time_service)) {
-            std::cerr << "[Server] Failed to register TimeService" << std::endl;
+            LOG_ERROR("[Server] Failed to register TimeService");
             return 1;
         }
 
-        std::cout << "[Server] " << service_manager->GetServiceCount() 
-                  << " service(s) registered\n" << std::endl;
+        LOG_INFO("[Server] " << service_manager->GetServiceCount() << " service(s) registered");
 
         // Create and start server
-        auto server = std::make_unique<UDSServer>(Protocol::UDS_PATH, service_manager);
+        auto server = std::make_unique<UDSServer>(Protocol::UDS_PATH, service_manager, config);
         
         if (!server->Start()) {
-            std::cerr << "[Server] Failed to start server" << std::endl;
+            LOG_ERROR("[Server] Failed to start server");
             return 1;
         }
 
-        std::cout << "[Server] Server is running...\n" << std::endl;
+        LOG_INFO("[Server] Server is running...");
 
-        // Main loop - wait for shutdown
-        while (!shutdown_requested.load()) {
+        // Main loop - wait for shutdown, or for a successor to take over
+        auto next_metrics_write = std::chrono::steady_clock::now();
+        auto next_trace_collect = next_metrics_write;
+        bool tracing = config.trace_sample_rate > 0.0;
+        while (!shutdown_requested.load() && server->IsRunning()) {
+            if (!options.metrics_file.empty() && std::chrono::steady_clock::now() >= next_metrics_write) {
+                WriteMetricsFile(options.metrics_file, service_manager->GetMetrics());
+                next_metrics_write += std::chrono::milliseconds(METRICS_FILE_INTERVAL_MS);
+            }
+            if (tracing && std::chrono::steady_clock::now() >= next_trace_collect) {
+                trace::Tracer::Global().Collect();
+                next_trace_collect += std::chrono::milliseconds(TRACE_COLLECT_INTERVAL_MS);
+            }
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
 
         // Graceful shutdown
-        std::cout << "\n[Server] Shutting down gracefully..." << std::endl;
+        if (server->HasHandedOff()) {
+            LOG_INFO("[Server] Handed over to a new server process, exiting");
+        } else {
+            LOG_INFO("[Server] Received signal " << received_signal.load() << ", shutting down gracefully...");
+        }
         server->Stop();
         service_manager->Clear();
 
-        std::cout << "[Server] Shutdown complete" << std::endl;
+        if (tracing && !options.trace_file.empty()) {
+            if (trace::Tracer::Global().WriteChromeTrace(options.trace_file)) {
+                LOG_INFO("[Server] Trace written to " << options.trace_file);
+            } else {
+                LOG_WARN("[Server] Failed to write trace " << options.trace_file);
+            }
+        }
+
+        LOG_INFO("[Server] Shutdown complete");
         return 0;
 
     } catch (const std::exception& e) {
-        std::cerr << "[Server] Fatal error: " << e.what() << std::endl;
+        LOG_ERROR("[Server] Fatal error: " << e.what());
         return 1;
     }
 }
@@ -0,0 +1,93 @@
+/**
+ * @file BenchUtils.cpp
+ * @brief Implementation of the benchmark helpers
+ */
+
+#include "BenchUtils.hpp"
+#include "CalculatorService.hpp"
+#include "TimeService.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
+
+namespace ipc_demo {
+namespace bench {
+
+namespace {
+
+constexpr auto STARTUP_TIMEOUT = std::chrono::seconds(2);
+
+// Serves clients on several reactors so the scaling benchmarks are not
+// limited by a single event loop
+constexpr size_t BENCH_REACTORS = 4;
+
+} // namespace
+
+void LatencyRecorder::Report(benchmark::State& state) {
+    if (samples_.empty()) {
+        return;
+    }
+    std::sort(samples_.begin(), samples_.end());
+
+    auto percentile = [this](double q) {
+        size_t index = std::min(samples_.size() - 1, static_cast<size_t>(q * samples_.size()));
+        return static_cast<double>(samples_[index]) / 1000.0;
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["p999_us"] = percentile(0.999);
+}
+
+BenchServer& BenchServer::Instance(IoBackend backend) {
+    if (backend == IoBackend::IoUring) {
+        static BenchServer uring_instance(IoBackend::IoUring);
+        return uring_instance;
+    }
+    static BenchServer instance(IoBackend::Epoll);
+    return instance;
+}
+
+BenchServer::BenchServer(IoBackend backend)
+    : socket_path_("/tmp/ipc_bench_" + std::to_string(getpid()) +
+                   (backend == IoBackend::IoUring ? "_uring" : "") + ".sock")
+    , manager_(std::make_shared<ServiceManager>()) {
+    manager_->RegisterService(std::make_shared<CalculatorService>());
+    manager_->RegisterService(std::make_shared<TimeService>());
+
+    ServerConfig config;
+    config.num_reactors = BENCH_REACTORS;
+    config.io_backend = backend;
+    server_ = std::make_unique<UDSServer>(socket_path_, manager_, config);
+    if (!server_->Start()) {
+        return;
+    }
+
+    auto deadline = Clock::now() + STARTUP_TIMEOUT;
+    while (access(socket_path_.c_str(), F_OK) != 0 && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    running_ = access(socket_path_.c_str(), F_OK) == 0;
+}
+
+BenchServer::~BenchServer() {
+    if (server_) {
+        server_->Stop();
+    }
+}
+
+std::shared_ptr<Channel> BenchServer::Connect(const ChannelOptions& options) const {
+    auto deadline = Clock::now() + STARTUP_TIMEOUT;
+    while (true) {
+        auto channel = std::make_shared<Channel>(socket_path_, options);
+        if (channel->IsConnected()) {
+            return channel;
+        }
+        if (Clock::now() >= deadline) {
+            return nullptr;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+} // namespace bench
+} // namespace ipc_demo
@@ -0,0 +1,94 @@
+/**
+ * @file BenchUtils.hpp
+ * @brief Shared helpers for the benchmarks: latency percentiles and an in-process server
+ */
+
+#ifndef IPC_DEMO_BENCH_UTILS_HPP
+#define IPC_DEMO_BENCH_UTILS_HPP
+
+#include "UDSServer.hpp"
+#include "ServiceManager.hpp"
+#include "ipc_sync/Channel.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ipc_demo {
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @class LatencyRecorder
+ * @brief Collects per-call latencies and reports percentiles as benchmark counters
+ *
+ * Reported counters (microseconds): p50_us, p99_us, p999_us. Recorders
+ * filled on different threads can be merged before reporting.
+ */
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t expected = 0) { samples_.reserve(expected); }
+
+    void Record(Clock::duration latency) {
+        samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+    }
+
+    void Merge(const LatencyRecorder& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+    }
+
+    size_t Count() const { return samples_.size(); }
+
+    /**
+     * @brief Sort the samples and add the percentile counters to state
+     */
+    void Report(benchmark::State& state);
+
+private:
+    std::vector<int64_t> samples_;  // Nanoseconds
+};
+
+/**
+ * @class BenchServer
+ * @brief UDSServer with Calculator and Time services on a private socket path
+ *
+ * Started on first use and shared by all RPC benchmarks of the process;
+ * there is one instance per reactor I/O backend.
+ */
+class BenchServer {
+public:
+    static BenchServer& Instance(IoBackend backend = IoBackend::Epoll);
+
+    ~BenchServer();
+
+    // Disable copy/move
+    BenchServer(const BenchServer&) = delete;
+    BenchServer& operator=(const BenchServer&) = delete;
+    BenchServer(BenchServer&&) = delete;
+    BenchServer& operator=(BenchServer&&) = delete;
+
+    bool IsRunning() const { return running_; }
+    const std::string& SocketPath() const { return socket_path_; }
+    IoBackend GetIoBackend() const { return server_->GetIoBackend(); }
+
+    /**
+     * @brief Open a channel to the server
+     * @return Connected channel, or nullptr
+     */
+    std::shared_ptr<Channel> Connect(const ChannelOptions& options = ChannelOptions{}) const;
+
+private:
+    explicit BenchServer(IoBackend backend);
+
+    std::string socket_path_;
+    std::shared_ptr<ServiceManager> manager_;
+    std::unique_ptr<UDSServer> server_;
+    bool running_{false};
+};
+
+} // namespace bench
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_BENCH_UTILS_HPP
@@ -0,0 +1,269 @@
+/**
+ * @file bench_byte_buffer.cpp
+ * @brief ByteBuffer encode/decode benchmarks
+ */
+
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Compression.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Schema.hpp"
+#include "ipc_sync/TimeSchema.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Calculator request frame: [START][LEN][ROUTINE][VERSION][op][a][b][END]
+size_t EncodeCalculatorFrame(uint8_t* data, size_t len, double a, double b) {
+    ByteBuffer buf(data, len);
+    buf.PutByte(Protocol::START_BYTE);
+    buf.PutInt(0); // Placeholder for length
+    buf.PutInt(0x1000);
+    buf.PutByte(Protocol::VERSION);
+    buf.PutByte(0x01);
+    buf.PutDouble(a);
+    buf.PutDouble(b);
+    buf.PutByte(Protocol::END_BYTE);
+
+    size_t frame_len = buf.Position();
+    buf.SetPosition(1);
+    buf.PutInt(static_cast<uint32_t>(frame_len));
+    return frame_len;
+}
+
+// A map payload with the repetitive keys compression is aimed at
+size_t EncodeMapPayload(uint8_t* data, size_t len, int entries) {
+    std::unordered_map<std::string, std::string> map;
+    for (int i = 0; i < entries; ++i) {
+        map["sensor_temperature_celsius_" + std::to_string(i)] = std::to_string(20 + i % 7) + ".5";
+    }
+    ByteBuffer buf(data, len);
+    buf.PutMap(map);
+    return buf.Position();
+}
+
+} // namespace
+
+static void BM_ByteBufferEncodeFrame(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    double a = 1.0;
+    for (auto _ : state) {
+        size_t len = EncodeCalculatorFrame(frame, sizeof(frame), a, 2.0);
+        benchmark::DoNotOptimize(frame);
+        benchmark::DoNotOptimize(len);
+        a += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferEncodeFrame);
+
+static void BM_ByteBufferDecodeFrame(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    size_t frame_len = EncodeCalculatorFrame(frame, sizeof(frame), 1.5, 2.5);
+    for (auto _ : state) {
+        ByteBuffer buf(frame, frame_len);
+        uint8_t start = buf.GetByte();
+        uint32_t length = buf.GetInt();
+        uint32_t routine = buf.GetInt();
+        uint8_t version = buf.GetByte();
+        uint8_t op = buf.GetByte();
+        double a = buf.GetDouble();
+        double b = buf.GetDouble();
+        benchmark::DoNotOptimize(start + length + routine + version + op);
+        benchmark::DoNotOptimize(a + b);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferDecodeFrame);
+
+// The same frame through the generated schema codec
+static void BM_SchemaEncodeFrame(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    CalculatorRequest request{CalculatorOperation::Add, 1.0, 2.0};
+    for (auto _ : state) {
+        size_t len = EncodeFrame(CalculatorRpc::REQUEST_ROUTINE_ID, request, frame, sizeof(frame));
+        // The frame escapes, as it would to a socket; otherwise the encode is dead code
+        benchmark::DoNotOptimize(frame);
+        benchmark::DoNotOptimize(len);
+        request.a += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SchemaEncodeFrame);
+
+// The same frame behind a header encoded once, as ServiceManager hands it to services
+static void BM_ResponseBuilderEncodeFrame(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    const ResponseBuilder::Header header = ResponseBuilder::EncodeHeader(CalculatorRpc::REQUEST_ROUTINE_ID);
+    CalculatorRequest request{CalculatorOperation::Add, 1.0, 2.0};
+    for (auto _ : state) {
+        ResponseBuilder response(header, frame, sizeof(frame));
+        size_t len = response.Encode(request);
+        benchmark::DoNotOptimize(frame);
+        benchmark::DoNotOptimize(len);
+        request.a += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResponseBuilderEncodeFrame);
+
+static void BM_SchemaDecodeFrame(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    size_t frame_len = EncodeCalculatorFrame(frame, sizeof(frame), 1.5, 2.5);
+    std::string error;
+    for (auto _ : state) {
+        CalculatorRequest request{};
+        bool ok = DecodeFrame(CalculatorRpc::REQUEST_ROUTINE_ID, frame, frame_len, request, error);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(request.a + request.b);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SchemaDecodeFrame);
+
+// Time response with owned strings (/0, heap allocation for the timestamp)
+// vs. decoded in place (/1)
+static void BM_SchemaDecodeTimeResponse(benchmark::State& state) {
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    TimeResponse response{TimeStatus::Success, "2026-10-14 12:00:00.000", 1791979200, ""};
+    size_t frame_len = EncodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, response, frame, sizeof(frame));
+    bool in_place = state.range(0) != 0;
+    std::string error;
+    for (auto _ : state) {
+        if (in_place) {
+            TimeResponseView view{};
+            bool ok = DecodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, frame, frame_len, view, error);
+            benchmark::DoNotOptimize(ok);
+            benchmark::DoNotOptimize(view.timestamp.data());
+        } else {
+            TimeResponse owned{};
+            bool ok = DecodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, frame, frame_len, owned, error);
+            benchmark::DoNotOptimize(ok);
+            benchmark::DoNotOptimize(owned.timestamp.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SchemaDecodeTimeResponse)->Arg(0)->Arg(1);
+
+// 256 operand pairs (a batch of calculator payloads), element-wise (/0) vs. bulk (/1)
+static void BM_ByteBufferPutDoubles(benchmark::State& state) {
+    std::vector<double> values(512, 1.25);
+    uint8_t data[Protocol::MAX_PACKET_SIZE];
+    bool bulk = state.range(0) != 0;
+    for (auto _ : state) {
+        ByteBuffer buf(data, sizeof(data));
+        if (bulk) {
+            buf.PutDoubles(values.data(), values.size());
+        } else {
+            for (double v : values) {
+                buf.PutDouble(v);
+            }
+        }
+        benchmark::DoNotOptimize(data);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(values.size() * sizeof(double)));
+}
+BENCHMARK(BM_ByteBufferPutDoubles)->Arg(0)->Arg(1);
+
+// Big-endian integers: per-element byte swaps (/0) vs. the bulk kernel (/1)
+static void BM_ByteBufferPutInts(benchmark::State& state) {
+    std::vector<uint32_t> values(1024);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    uint8_t data[Protocol::MAX_PACKET_SIZE];
+    bool bulk = state.range(0) != 0;
+    for (auto _ : state) {
+        ByteBuffer buf(data, sizeof(data));
+        if (bulk) {
+            buf.PutInts(values.data(), values.size());
+        } else {
+            for (uint32_t v : values) {
+                buf.PutInt(v);
+            }
+        }
+        benchmark::DoNotOptimize(data);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(values.size() * sizeof(uint32_t)));
+}
+BENCHMARK(BM_ByteBufferPutInts)->Arg(0)->Arg(1);
+
+static void BM_ByteBufferStringRoundTrip(benchmark::State& state) {
+    const std::string text(static_cast<size_t>(state.range(0)), 'x');
+    uint8_t data[Protocol::MAX_PACKET_SIZE];
+    for (auto _ : state) {
+        ByteBuffer out(data, sizeof(data));
+        out.PutString(text);
+        ByteBuffer in(data, out.Position());
+        std::string decoded = in.GetString();
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ByteBufferStringRoundTrip)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_ByteBufferMapRoundTrip(benchmark::State& state) {
+    std::unordered_map<std::string, std::string> map;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        map["key" + std::to_string(i)] = "value" + std::to_string(i);
+    }
+    uint8_t data[Protocol::MAX_PACKET_SIZE];
+    for (auto _ : state) {
+        ByteBuffer out(data, sizeof(data));
+        out.PutMap(map);
+        ByteBuffer in(data, out.Position());
+        auto decoded = in.GetMap();
+        benchmark::DoNotOptimize(decoded.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferMapRoundTrip)->Arg(4)->Arg(32);
+
+// Map payload compressed without (/0) and with (/1) a dictionary of its keys
+static void BM_CompressPayload(benchmark::State& state) {
+    uint8_t payload[Protocol::MAX_PACKET_SIZE];
+    size_t payload_len = EncodeMapPayload(payload, sizeof(payload), 64);
+    uint8_t sample[Protocol::MAX_PACKET_SIZE];
+    CompressionDictionary dictionary(std::string_view(reinterpret_cast<const char*>(sample),
+                                                      EncodeMapPayload(sample, sizeof(sample), 16)));
+    const CompressionDictionary* used = state.range(0) ? &dictionary : nullptr;
+
+    uint8_t out[Protocol::MAX_PACKET_SIZE];
+    size_t out_len = 0;
+    for (auto _ : state) {
+        out_len = CompressPayload(payload, payload_len, out, sizeof(out), used);
+        benchmark::DoNotOptimize(out_len);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload_len));
+    state.counters["ratio"] = out_len > 0 ? static_cast<double>(payload_len) / static_cast<double>(out_len) : 0.0;
+}
+BENCHMARK(BM_CompressPayload)->Arg(0)->Arg(1);
+
+static void BM_DecompressPayload(benchmark::State& state) {
+    uint8_t payload[Protocol::MAX_PACKET_SIZE];
+    size_t payload_len = EncodeMapPayload(payload, sizeof(payload), 64);
+    uint8_t encoded[Protocol::MAX_PACKET_SIZE];
+    size_t encoded_len = CompressPayload(payload, payload_len, encoded, sizeof(encoded), nullptr);
+
+    uint8_t out[Protocol::MAX_PACKET_SIZE];
+    for (auto _ : state) {
+        size_t len = DecompressPayload(encoded, encoded_len, out, sizeof(out), nullptr);
+        benchmark::DoNotOptimize(len);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload_len));
+}
+BENCHMARK(BM_DecompressPayload);
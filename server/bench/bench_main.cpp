@@ -0,0 +1,26 @@
+/**
+ * @file bench_main.cpp
+ * @brief Benchmark entry point
+ *
+ * Connection messages of the server would be interleaved with the report,
+ * so only warnings and errors are logged. Per-request messages are debug
+ * level and stay disabled either way.
+ * Pass --benchmark_out=<file> --benchmark_out_format=json for a JSON
+ * report (the run_benchmarks target does this).
+ */
+
+#include "logging/Logger.hpp"
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    logging::SetLevel(logging::Level::Warn);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
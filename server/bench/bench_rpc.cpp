@@ -0,0 +1,235 @@
+/**
+ * @file bench_rpc.cpp
+ * @brief End-to-end RPC benchmarks against an in-process UDSServer
+ *
+ * Every benchmark reports per-call latency percentiles (p50_us, p99_us,
+ * p999_us) next to the call rate.
+ */
+
+#include "BenchUtils.hpp"
+#include "ipc_sync/CalculatorClient.hpp"
+#include "ipc_sync/ChannelPool.hpp"
+#include "ipc_sync/TimeClient.hpp"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+using namespace ipc_demo::bench;
+
+namespace {
+
+// Calls each client thread makes in one concurrent run
+constexpr size_t CALLS_PER_THREAD = 2000;
+
+/**
+ * @enum ChannelMode
+ * @brief How the client threads of a concurrent run reach the server
+ */
+enum class ChannelMode : int64_t {
+    PerThread = 0,        // One blocking Channel per thread
+    Shared = 1,           // One blocking Channel for all threads (serialized)
+    SharedPipelined = 2,  // One pipelined Channel for all threads
+    Pool = 3,             // ChannelPool of one blocking Channel per thread
+};
+
+const char* ModeName(ChannelMode mode) {
+    switch (mode) {
+        case ChannelMode::PerThread: return "per_thread";
+        case ChannelMode::Shared: return "shared";
+        case ChannelMode::SharedPipelined: return "shared_pipelined";
+        case ChannelMode::Pool: return "pool";
+    }
+    return "unknown";
+}
+
+/**
+ * @enum TransportMode
+ * @brief How a round-trip benchmark's channel and server move bytes
+ */
+enum class TransportMode : int64_t {
+    Socket = 0,        // Blocking socket I/O, epoll reactors
+    SharedMemory = 1,  // Shared-memory rings, epoll reactors
+    IoUring = 2,       // io_uring on both sides (one enter per client call)
+};
+
+ChannelOptions TransportOptions(TransportMode mode) {
+    ChannelOptions options;
+    options.transport = mode == TransportMode::SharedMemory ? Transport::SharedMemory : Transport::Socket;
+    options.io_uring = mode == TransportMode::IoUring;
+    return options;
+}
+
+BenchServer& ServerFor(TransportMode mode) {
+    return BenchServer::Instance(mode == TransportMode::IoUring ? IoBackend::IoUring : IoBackend::Epoll);
+}
+
+const char* TransportLabel(TransportMode mode, const Channel& channel) {
+    if (channel.IsSharedMemoryActive()) {
+        return "shm";
+    }
+    if (mode == TransportMode::IoUring && ServerFor(mode).GetIoBackend() == IoBackend::IoUring) {
+        return "io_uring";
+    }
+    return "socket";
+}
+
+std::shared_ptr<Channel> ConnectOrSkip(benchmark::State& state, const ChannelOptions& options,
+                                       TransportMode mode = TransportMode::Socket) {
+    BenchServer& server = ServerFor(mode);
+    if (!server.IsRunning()) {
+        state.SkipWithError("Benchmark server failed to start");
+        return nullptr;
+    }
+    auto channel = server.Connect(options);
+    if (!channel) {
+        state.SkipWithError("Failed to connect to benchmark server");
+    }
+    return channel;
+}
+
+} // namespace
+
+// Arg: TransportMode
+static void BM_CalculatorRoundTrip(benchmark::State& state) {
+    const TransportMode mode = static_cast<TransportMode>(state.range(0));
+    auto channel = ConnectOrSkip(state, TransportOptions(mode), mode);
+    if (!channel) {
+        return;
+    }
+    Calculator calculator(channel);
+    LatencyRecorder latency;
+
+    double a = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto result = calculator.Add(a, 1.0);
+        latency.Record(Clock::now() - start);
+        if (!result.success) {
+            state.SkipWithError(result.error_message.c_str());
+            break;
+        }
+        a = result.value;
+    }
+
+    state.SetLabel(TransportLabel(mode, *channel));
+    state.SetItemsProcessed(state.iterations());
+    latency.Report(state);
+}
+BENCHMARK(BM_CalculatorRoundTrip)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+// Arg: TransportMode
+static void BM_TimeRoundTrip(benchmark::State& state) {
+    const TransportMode mode = static_cast<TransportMode>(state.range(0));
+    auto channel = ConnectOrSkip(state, TransportOptions(mode), mode);
+    if (!channel) {
+        return;
+    }
+    TimeClient time_client(channel);
+    LatencyRecorder latency;
+
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto result = time_client.GetCurrentTime();
+        latency.Record(Clock::now() - start);
+        if (!result.success) {
+            state.SkipWithError(result.error_message.c_str());
+            break;
+        }
+    }
+
+    state.SetLabel(TransportLabel(mode, *channel));
+    state.SetItemsProcessed(state.iterations());
+    latency.Report(state);
+}
+BENCHMARK(BM_TimeRoundTrip)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+// Args: client threads, ChannelMode. One iteration is a full run of
+// CALLS_PER_THREAD calls per thread; percentiles cover every call.
+static void BM_ConcurrentClients(benchmark::State& state) {
+    const size_t threads = static_cast<size_t>(state.range(0));
+    const ChannelMode mode = static_cast<ChannelMode>(state.range(1));
+
+    ChannelOptions options;
+    options.pipelining = mode == ChannelMode::SharedPipelined;
+
+    std::vector<std::shared_ptr<Channel>> channels;
+    std::unique_ptr<ChannelPool> pool;
+    if (mode == ChannelMode::Pool) {
+        if (!ConnectOrSkip(state, options)) {
+            return;
+        }
+        ChannelPoolOptions pool_options;
+        pool_options.size = threads;
+        pool_options.channel = options;
+        pool = std::make_unique<ChannelPool>(BenchServer::Instance().SocketPath(), pool_options);
+    }
+    size_t channel_count = mode == ChannelMode::PerThread ? threads : (pool ? 0 : 1);
+    for (size_t i = 0; i < channel_count; ++i) {
+        auto channel = ConnectOrSkip(state, options);
+        if (!channel) {
+            return;
+        }
+        channels.push_back(std::move(channel));
+    }
+
+    LatencyRecorder latency(threads * CALLS_PER_THREAD);
+    size_t failures = 0;
+
+    for (auto _ : state) {
+        std::vector<LatencyRecorder> recorders(threads, LatencyRecorder(CALLS_PER_THREAD));
+        std::vector<std::thread> workers;
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<size_t> failed{0};
+
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                Calculator calculator(pool ? pool->Get() : channels[t % channels.size()]);
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < CALLS_PER_THREAD; ++i) {
+                    auto start = Clock::now();
+                    auto result = calculator.Add(static_cast<double>(t), static_cast<double>(i));
+                    recorders[t].Record(Clock::now() - start);
+                    if (!result.success) {
+                        failed.fetch_add(1);
+                    }
+                }
+            });
+        }
+
+        // Time the calls only, not thread start-up
+        while (ready.load() < threads) {
+            std::this_thread::yield();
+        }
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+
+        for (const auto& recorder : recorders) {
+            latency.Merge(recorder);
+        }
+        failures += failed.load();
+    }
+
+    if (failures > 0) {
+        state.SkipWithError("Some calls failed");
+        return;
+    }
+
+    state.SetLabel(ModeName(mode));
+    state.SetItemsProcessed(static_cast<int64_t>(latency.Count()));
+    latency.Report(state);
+}
+BENCHMARK(BM_ConcurrentClients)
+    ->ArgNames({"threads", "mode"})
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 2, 3}})
+    ->Iterations(1)
+    ->UseManualTime();
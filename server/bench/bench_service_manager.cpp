@@ -0,0 +1,107 @@
+/**
+ * @file bench_service_manager.cpp
+ * @brief ServiceManager::ExecuteService dispatch benchmarks (no sockets involved)
+ */
+
+#include "ServiceManager.hpp"
+#include "CalculatorService.hpp"
+#include "TimeService.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+using namespace ipc_demo;
+
+namespace {
+
+std::shared_ptr<ServiceManager> MakeManager() {
+    auto manager = std::make_shared<ServiceManager>();
+    manager->RegisterService(std::make_shared<CalculatorService>());
+    manager->RegisterService(std::make_shared<TimeService>());
+    return manager;
+}
+
+// Answers with an empty frame and does not log, so dispatch dominates
+class NullService : public IService {
+public:
+    explicit NullService(uint32_t routine_id) : routine_id_(routine_id) {}
+
+    uint32_t GetRequestRoutineId() const override { return routine_id_; }
+    uint32_t GetResponseRoutineId() const override { return routine_id_ + 1; }
+    std::string GetName() const override { return "NullService"; }
+
+    size_t Execute(const uint8_t*, size_t, uint8_t* output, size_t output_len) override {
+        ByteBuffer resp(output, output_len);
+        resp.PutByte(Protocol::START_BYTE);
+        resp.PutInt(static_cast<uint32_t>(Protocol::GetMinFrameSize()));
+        resp.PutInt(GetResponseRoutineId());
+        resp.PutByte(Protocol::VERSION);
+        resp.PutByte(Protocol::END_BYTE);
+        return resp.Position();
+    }
+
+private:
+    uint32_t routine_id_;
+};
+
+// Shared by all threads of the dispatch benchmark
+ServiceManager& DispatchManager() {
+    static ServiceManager manager;
+    static bool registered = []() {
+        for (uint32_t i = 0; i < 16; ++i) {
+            manager.RegisterService(std::make_shared<NullService>(0x1000 + i * 0x10));
+        }
+        return true;
+    }();
+    (void)registered;
+    return manager;
+}
+
+} // namespace
+
+// Routing cost from many threads at once; should stay flat as threads grow
+static void BM_ExecuteServiceDispatch(benchmark::State& state) {
+    ServiceManager& manager = DispatchManager();
+    uint8_t response[64];
+    uint32_t i = static_cast<uint32_t>(state.thread_index());
+    for (auto _ : state) {
+        uint32_t routine_id = 0x1000 + (i++ % 16) * 0x10;
+        size_t len = manager.ExecuteService(routine_id, nullptr, 0, response, sizeof(response));
+        benchmark::DoNotOptimize(len);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteServiceDispatch)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ExecuteServiceCalculator(benchmark::State& state) {
+    auto manager = MakeManager();
+
+    // Payload after the VERSION byte: [op][a][b]
+    uint8_t request[1 + 2 * sizeof(double)];
+    ByteBuffer buf(request, sizeof(request));
+    buf.PutByte(static_cast<uint8_t>(CalculatorService::Operation::Add));
+    buf.PutDouble(3.0);
+    buf.PutDouble(4.0);
+
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    for (auto _ : state) {
+        size_t len = manager->ExecuteService(0x1000, request, sizeof(request), response, sizeof(response));
+        benchmark::DoNotOptimize(len);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteServiceCalculator);
+
+static void BM_ExecuteServiceTime(benchmark::State& state) {
+    auto manager = MakeManager();
+    uint8_t request[1] = {static_cast<uint8_t>(TimeService::Operation::GetTimestamp)};
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    for (auto _ : state) {
+        size_t len = manager->ExecuteService(0x2000, request, sizeof(request), response, sizeof(response));
+        benchmark::DoNotOptimize(len);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteServiceTime);
@@ -0,0 +1,102 @@
+/**
+ * @file bench_thread_pool.cpp
+ * @brief Worker pool benchmarks: shared-queue ThreadPool vs. WorkStealingThreadPool,
+ *        Submit() vs. Post()
+ */
+
+#include "thread_pool/ThreadPool.hpp"
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+using namespace thread_pool;
+
+namespace {
+
+constexpr size_t POOL_THREADS = 4;
+
+// Tasks submitted per iteration, like a reactor offloading a burst of frames
+constexpr int BURST = 256;
+
+std::unique_ptr<IExecutor> MakePool(int64_t work_stealing) {
+    if (work_stealing) {
+        return std::make_unique<WorkStealingThreadPool>(POOL_THREADS);
+    }
+    return std::make_unique<ThreadPool>(POOL_THREADS);
+}
+
+} // namespace
+
+// Arg: 0 = ThreadPool, 1 = WorkStealingThreadPool. Benchmark threads act
+// as submitters (reactors) sharing one pool.
+static void BM_PoolSubmitBurst(benchmark::State& state) {
+    static std::unique_ptr<IExecutor> pool;
+    if (state.thread_index() == 0) {
+        pool = MakePool(state.range(0));
+    }
+    // All benchmark threads start the loop together, after the setup above
+    std::atomic<int> done{0};
+    for (auto _ : state) {
+        done.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < BURST; ++i) {
+            pool->Submit([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (done.load(std::memory_order_acquire) < BURST) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+    state.SetLabel(state.range(0) ? "work_stealing" : "shared_queue");
+}
+BENCHMARK(BM_PoolSubmitBurst)->Arg(0)->Arg(1)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// Same burst through Post(): no future, no shared state, no allocation
+static void BM_PoolPostBurst(benchmark::State& state) {
+    auto pool = MakePool(state.range(0));
+    std::atomic<int> done{0};
+    for (auto _ : state) {
+        done.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < BURST; ++i) {
+            pool->Post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (done.load(std::memory_order_acquire) < BURST) {
+            std::this_thread::yield();
+        }
+    }
+    pool->Shutdown();
+    state.SetItemsProcessed(state.iterations() * BURST);
+    state.SetLabel(state.range(0) ? "work_stealing" : "shared_queue");
+}
+BENCHMARK(BM_PoolPostBurst)->Arg(0)->Arg(1)->UseRealTime();
+
+// Recursive fan-out from inside the pool (local submission)
+static void BM_PoolNestedFanOut(benchmark::State& state) {
+    auto pool = MakePool(state.range(0));
+    constexpr int DEPTH = 10;
+
+    // Outlive the iterations: the last tasks may still be returning from spawn
+    std::atomic<int> leaves{0};
+    std::function<void(int)> spawn = [&](int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pool->Submit(spawn, depth - 1);
+        pool->Submit(spawn, depth - 1);
+    };
+
+    for (auto _ : state) {
+        leaves.store(0, std::memory_order_relaxed);
+        pool->Submit(spawn, DEPTH);
+        while (leaves.load(std::memory_order_acquire) < (1 << DEPTH)) {
+            std::this_thread::yield();
+        }
+    }
+    pool->Shutdown();
+    state.SetItemsProcessed(state.iterations() * ((2 << DEPTH) - 1));
+    state.SetLabel(state.range(0) ? "work_stealing" : "shared_queue");
+}
+BENCHMARK(BM_PoolNestedFanOut)->Arg(0)->Arg(1)->UseRealTime();
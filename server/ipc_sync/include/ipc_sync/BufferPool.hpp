@@ -0,0 +1,86 @@
+/**
+ * @file BufferPool.hpp
+ * @brief Fixed-size I/O blocks shared by many connections
+ */
+
+#ifndef IPC_SYNC_BUFFER_POOL_HPP
+#define IPC_SYNC_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class BufferPool
+ * @brief Single-threaded free list of equally sized byte blocks
+ *
+ * Blocks are carved from slabs of blocks_per_slab and never returned to
+ * the system before the pool is destroyed, so a connection that borrows a
+ * block while a frame is in flight and gives it back afterwards costs no
+ * allocation once the pool has warmed up. Idle connections hold nothing.
+ *
+ * Thread Safety: none; one thread (a reactor) owns the pool.
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Construct pool (no memory is allocated until the first Acquire)
+     * @param block_size Bytes per block (rounded up to a power of two)
+     * @param blocks_per_slab Blocks allocated together when the pool runs dry
+     * @throws std::invalid_argument if block_size or blocks_per_slab is 0
+     */
+    explicit BufferPool(size_t block_size, size_t blocks_per_slab = 16);
+
+    // Disable copy/move
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+
+    /**
+     * @brief Borrow a block (contents are unspecified)
+     */
+    uint8_t* Acquire();
+
+    /**
+     * @brief Give a block back
+     * @param block Block from Acquire() of this pool
+     */
+    void Release(uint8_t* block);
+
+    /**
+     * @brief Allocate and touch slabs until at least blocks are allocated
+     *
+     * Called from the owning thread, this also places the pages on that
+     * thread's NUMA node (first touch).
+     */
+    void Reserve(size_t blocks);
+
+    size_t BlockSize() const { return block_size_; }
+
+    /**
+     * @brief Blocks currently borrowed
+     */
+    size_t InUse() const { return allocated_ - free_.size(); }
+
+    /**
+     * @brief Blocks allocated so far (borrowed or free)
+     */
+    size_t Allocated() const { return allocated_; }
+
+private:
+    size_t block_size_;
+    size_t blocks_per_slab_;
+    size_t allocated_{0};
+    std::vector<std::unique_ptr<uint8_t[]>> slabs_;
+    std::vector<uint8_t*> free_;
+
+    void AddSlab();
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_BUFFER_POOL_HPP
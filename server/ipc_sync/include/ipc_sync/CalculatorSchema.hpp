@@ -0,0 +1,82 @@
+/**
+ * @file CalculatorSchema.hpp
+ * @brief Calculator RPC messages, shared by the client proxy and the service
+ */
+#ifndef IPC_SYNC_CALCULATOR_SCHEMA_HPP
+#define IPC_SYNC_CALCULATOR_SCHEMA_HPP
+
+#include "ipc_sync/Schema.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ipc_demo {
+
+enum class CalculatorOperation : uint8_t {
+    Add = 0x01,
+    Subtract = 0x02,
+    Multiply = 0x03,
+    Divide = 0x04
+};
+
+enum class CalculatorStatus : uint8_t {
+    Success = 0x00,
+    DivisionByZero = 0x01,
+    InvalidOperation = 0x02,
+    InvalidInput = 0x03
+};
+
+/**
+ * @struct CalculatorRequest
+ * @brief [operation:byte][operand_a:double][operand_b:double]
+ */
+struct CalculatorRequest {
+    CalculatorOperation op;
+    double a;
+    double b;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&CalculatorRequest::op, &CalculatorRequest::a, &CalculatorRequest::b);
+    }
+};
+
+/**
+ * @struct CalculatorResponse
+ * @brief [status:byte][result:double][error_msg:string]
+ */
+struct CalculatorResponse {
+    CalculatorStatus status;
+    double result;
+    std::string error;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&CalculatorResponse::status, &CalculatorResponse::result,
+                               &CalculatorResponse::error);
+    }
+};
+
+/**
+ * @struct CalculatorResponseView
+ * @brief CalculatorResponse decoded in place (error points into the frame)
+ */
+struct CalculatorResponseView {
+    CalculatorStatus status;
+    double result;
+    std::string_view error;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&CalculatorResponseView::status, &CalculatorResponseView::result,
+                               &CalculatorResponseView::error);
+    }
+};
+
+using CalculatorRpc = RpcMethod<0x00001000, 0x00001001, CalculatorRequest, CalculatorResponse>;
+
+static_assert(MessageCodec<CalculatorRequest>::FIXED_SIZE &&
+              MessageCodec<CalculatorRequest>::MIN_SIZE == 1 + 2 * sizeof(double),
+              "Calculator requests are fixed-size");
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_CALCULATOR_SCHEMA_HPP
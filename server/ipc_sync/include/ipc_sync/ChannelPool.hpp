@@ -0,0 +1,111 @@
+/**
+ * @file ChannelPool.hpp
+ * @brief Warm pool of client channels with per-thread affinity (Pimpl interface)
+ */
+#ifndef IPC_SYNC_CHANNEL_POOL_HPP
+#define IPC_SYNC_CHANNEL_POOL_HPP
+
+#include "ipc_sync/Channel.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ipc_demo {
+
+/**
+ * @struct ChannelPoolOptions
+ * @brief Options for ChannelPool
+ */
+struct ChannelPoolOptions {
+    size_t size = 0;                  // Channels kept connected (0: one per hardware thread)
+    ChannelOptions channel;           // Options of every channel
+    int health_check_interval_ms = 1000;  // Idle channels are probed this often (0: never)
+};
+
+/**
+ * @class ChannelPool
+ * @brief Fixed set of connected channels shared by the threads of a process
+ *
+ * All channels connect in the constructor, so the first RPC does not pay
+ * for connecting. Each thread is bound to one channel on its first Get()
+ * (round-robin) and remembers it in a small thread-local cache, so Get()
+ * never locks and the binding goes away with the thread. A thread using
+ * many pools in turn may be rebound to another channel of the pool it used
+ * longest ago. A background thread probes idle channels with
+ * Channel::CheckConnection() and reconnects those the server closed.
+ *
+ * With more threads than channels several threads share a channel; use
+ * ChannelOptions::pipelining so their calls overlap instead of queueing.
+ *
+ * @code
+ * ChannelPool pool("/tmp/server.sock");
+ * // On any thread:
+ * Calculator calc(pool.Get());
+ * auto result = calc.Add(5, 3);
+ * @endcode
+ */
+class ChannelPool {
+public:
+    /**
+     * @brief Create and connect the channels
+     * @param socket_path Path to UDS socket
+     * @param options Pool and channel options
+     *
+     * Channels that fail to connect are kept and retry on first use (and
+     * on every health check), like a single Channel.
+     */
+    explicit ChannelPool(const std::string& socket_path,
+                         const ChannelPoolOptions& options = ChannelPoolOptions{});
+
+    /**
+     * @brief Stops health checks and releases the channels
+     *
+     * Each channel disconnects once no caller holds it any more.
+     */
+    ~ChannelPool();
+
+    // Disable copy/move
+    ChannelPool(const ChannelPool&) = delete;
+    ChannelPool& operator=(const ChannelPool&) = delete;
+    ChannelPool(ChannelPool&&) = delete;
+    ChannelPool& operator=(ChannelPool&&) = delete;
+
+    /**
+     * @brief Channel bound to the calling thread
+     *
+     * Lock-free. The reference stays valid
+     * for the pool's lifetime.
+     */
+    const std::shared_ptr<Channel>& Get();
+
+    /**
+     * @brief Channel by index (0 .. Size() - 1)
+     * @throws std::out_of_range if index >= Size()
+     */
+    const std::shared_ptr<Channel>& At(size_t index) const;
+
+    /**
+     * @brief Number of channels
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Number of channels currently connected
+     */
+    size_t ConnectedCount() const;
+
+    /**
+     * @brief Run a health check on every channel now
+     * @return Number of channels connected afterwards
+     */
+    size_t CheckConnections();
+
+private:
+    // Opaque pointer to implementation
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_CHANNEL_POOL_HPP
@@ -0,0 +1,118 @@
+/**
+ * @file Compression.hpp
+ * @brief LZ4 block codec with preset dictionaries, for compressed frame payloads
+ *
+ * Used on connections that negotiated compression (see
+ * Protocol::COMPRESSION_NEGOTIATE_REQUEST_ROUTINE_ID): payloads above a
+ * threshold travel as [ORIGINAL_LEN:4][LZ4 block] with
+ * Protocol::FLAG_COMPRESSED set. The block format is standard LZ4, so any
+ * LZ4 decoder given the same dictionary reads it; the encoder is a small
+ * greedy one built for payloads of a few kilobytes, not a general archiver.
+ */
+#ifndef IPC_SYNC_COMPRESSION_HPP
+#define IPC_SYNC_COMPRESSION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class CompressionDictionary
+ * @brief Bytes both peers treat as preceding every payload
+ *
+ * Typical content is the map keys and field names that repeat across
+ * messages: with them in the dictionary even the first occurrence in a
+ * payload becomes a short back-reference. Client and server must hold the
+ * same bytes; the connection only uses the dictionary if their Id()s match.
+ *
+ * Immutable once built, so one instance may be shared by all threads.
+ */
+class CompressionDictionary {
+public:
+    static constexpr size_t MAX_SIZE = 64 * 1024;   // LZ4 window; only the tail of longer content is kept
+    static constexpr size_t HASH_LOG = 12;
+
+    /**
+     * @param content Dictionary bytes (e.g. concatenated sample payloads)
+     * @throws std::invalid_argument if content is empty
+     */
+    explicit CompressionDictionary(std::string_view content);
+
+    // Disable copy/move
+    CompressionDictionary(const CompressionDictionary&) = delete;
+    CompressionDictionary& operator=(const CompressionDictionary&) = delete;
+    CompressionDictionary(CompressionDictionary&&) = delete;
+    CompressionDictionary& operator=(CompressionDictionary&&) = delete;
+
+    /**
+     * @brief Content hash exchanged at negotiation, never 0
+     */
+    uint32_t Id() const { return id_; }
+
+    const uint8_t* Data() const { return bytes_.data(); }
+    size_t Size() const { return bytes_.size(); }
+
+    /**
+     * @brief Encoder hash table pre-filled with the dictionary's positions
+     */
+    const std::array<uint32_t, size_t(1) << HASH_LOG>& Table() const { return table_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    uint32_t id_;
+    std::array<uint32_t, size_t(1) << HASH_LOG> table_;
+};
+
+namespace lz4 {
+
+/**
+ * @brief Worst-case block size for len input bytes
+ */
+constexpr size_t CompressBound(size_t len) {
+    return len + len / 255 + 16;
+}
+
+/**
+ * @brief Encode src as one LZ4 block
+ * @param dictionary Optional; the decoder must be given the same one
+ * @return Block length, or 0 if it does not fit dst
+ */
+size_t Compress(const uint8_t* src, size_t len, uint8_t* dst, size_t capacity,
+                const CompressionDictionary* dictionary = nullptr);
+
+/**
+ * @brief Decode one LZ4 block of exactly dst_len output bytes
+ * @return false if the block is malformed, reaches outside its history or
+ *         does not produce exactly dst_len bytes (nothing is written past dst_len)
+ */
+bool Decompress(const uint8_t* src, size_t len, uint8_t* dst, size_t dst_len,
+                const CompressionDictionary* dictionary = nullptr);
+
+} // namespace lz4
+
+/**
+ * @brief Encode a frame payload as [ORIGINAL_LEN:4][LZ4 block]
+ * @return Encoded length, or 0 if it would not be smaller than len or not fit out
+ */
+size_t CompressPayload(const uint8_t* payload, size_t len, uint8_t* out, size_t capacity,
+                       const CompressionDictionary* dictionary);
+
+/**
+ * @brief Original length of an encoded payload, 0 if it is too short to tell
+ */
+size_t CompressedPayloadSize(const uint8_t* encoded, size_t len);
+
+/**
+ * @brief Decode a payload encoded by CompressPayload
+ * @return Original length, or 0 if it is malformed or larger than capacity
+ */
+size_t DecompressPayload(const uint8_t* encoded, size_t len, uint8_t* out, size_t capacity,
+                         const CompressionDictionary* dictionary);
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_COMPRESSION_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file FdPassing.hpp
+ * @brief Socket helpers: scatter/gather I/O and descriptor passing (SCM_RIGHTS)
+ */
+
+#ifndef IPC_SYNC_FD_PASSING_HPP
+#define IPC_SYNC_FD_PASSING_HPP
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @brief Maximum number of descriptors accepted per message
+ */
+constexpr size_t MAX_PASSED_FDS = 4;
+
+/**
+ * @brief Gather-send iovecs with one sendmsg, optionally attaching descriptors
+ * @param socket_fd Connected Unix stream socket
+ * @param iov Segments to send, in order
+ * @param iovcnt Number of segments
+ * @param fds Descriptors to pass with the first byte (may be null)
+ * @param fd_count Number of descriptors (at most MAX_PASSED_FDS)
+ * @return Bytes sent (possibly fewer than requested, see AdvanceIovec),
+ *         or -1 with errno set. Retries on EINTR.
+ */
+ssize_t SendVectored(int socket_fd, const struct iovec* iov, size_t iovcnt,
+                     const int* fds = nullptr, size_t fd_count = 0);
+
+/**
+ * @brief Scatter-receive into iovecs with one recvmsg, collecting descriptors
+ * @param socket_fd Connected Unix stream socket
+ * @param iov Destination segments, filled in order
+ * @param iovcnt Number of segments
+ * @param fds Output: received descriptors are appended (caller owns them)
+ * @param flags recv flags (e.g. MSG_DONTWAIT)
+ * @return Bytes received, 0 on orderly shutdown, or -1 with errno set
+ */
+ssize_t RecvVectored(int socket_fd, struct iovec* iov, size_t iovcnt,
+                     std::vector<int>& fds, int flags = 0);
+
+/**
+ * @brief Collect the SCM_RIGHTS descriptors of a received message
+ * @param msg Message whose msg_control/msg_controllen describe the control data
+ * @param fds Output: descriptors are appended in order (caller owns them)
+ */
+void CollectPassedFds(const struct msghdr& msg, std::vector<int>& fds);
+
+/**
+ * @brief Skip bytes already sent from the front of an iovec array
+ * @param iov In/out: advanced past finished segments; the first remaining
+ *        segment is trimmed in place
+ * @param iovcnt Number of segments at iov
+ * @param bytes Bytes that were sent
+ * @return Number of segments still to send
+ */
+size_t AdvanceIovec(struct iovec*& iov, size_t iovcnt, size_t bytes);
+
+/**
+ * @brief Send bytes with descriptors attached to the first byte
+ * @param socket_fd Connected Unix stream socket
+ * @param data Bytes to send (at least one byte is required to carry the fds)
+ * @param len Number of bytes
+ * @param fds Descriptors to pass (duplicated into the peer, still owned here)
+ * @param fd_count Number of descriptors (at most MAX_PASSED_FDS)
+ * @return Bytes sent, or -1 with errno set. Only the first call for a
+ *         buffer carries the descriptors; resend any remainder with send().
+ */
+ssize_t SendWithFds(int socket_fd, const uint8_t* data, size_t len,
+                    const int* fds, size_t fd_count);
+
+/**
+ * @brief Receive bytes and collect any descriptors that came with them
+ * @param socket_fd Connected Unix stream socket
+ * @param data Destination buffer
+ * @param len Destination capacity
+ * @param fds Output: received descriptors are appended (caller owns them)
+ * @param flags recv flags (e.g. MSG_DONTWAIT)
+ * @return Bytes received, 0 on orderly shutdown, or -1 with errno set
+ */
+ssize_t RecvWithFds(int socket_fd, uint8_t* data, size_t len,
+                    std::vector<int>& fds, int flags = 0);
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_FD_PASSING_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file FrameParser.hpp
+ * @brief Incremental parser that splits a byte stream into protocol frames
+ */
+
+#ifndef IPC_SYNC_FRAME_PARSER_HPP
+#define IPC_SYNC_FRAME_PARSER_HPP
+
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/RingBuffer.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ipc_demo {
+
+class BufferPool;
+
+/**
+ * @struct FrameView
+ * @brief A complete frame found in the stream
+ *
+ * Pointers stay valid until the next call to FrameParser::Next().
+ */
+struct FrameView {
+    const uint8_t* data;    // Whole frame, START through END
+    size_t length;          // Whole frame length
+    uint32_t routine_id;
+    uint8_t version;
+    const uint8_t* payload; // Bytes between the header and END_BYTE
+    size_t payload_len;
+};
+
+/**
+ * @class FrameParser
+ * @brief Accumulates stream data and yields every complete frame
+ *
+ * Frame structure:
+ *   [START:1][LENGTH:4][ROUTINE_ID:4][VERSION:1][payload][END:1]
+ *
+ * Usage:
+ * @code
+ * size_t space;
+ * uint8_t* dst = parser.Buffer().WritePtr(space);
+ * ssize_t n = recv(fd, dst, space, 0);
+ * parser.Buffer().CommitWrite(n);
+ *
+ * FrameView frame;
+ * while (parser.Next(frame) == FrameParser::Result::Frame) {
+ *     Handle(frame);
+ * }
+ * @endcode
+ */
+class FrameParser {
+public:
+    enum class Result {
+        Frame,     // A complete frame was returned
+        NeedMore,  // Partial frame buffered, read more data
+        Error      // Stream is corrupt, see GetError(); the connection cannot resync
+    };
+
+    /**
+     * @brief Construct parser
+     * @param max_frame_size Largest acceptable frame (also sizes the ring)
+     */
+    explicit FrameParser(size_t max_frame_size = Protocol::MAX_PACKET_SIZE);
+
+    /**
+     * @brief Construct parser on pooled storage
+     *
+     * The ring and the copy of a wrapped frame are borrowed from pool only
+     * while data is buffered or a frame is handed out.
+     *
+     * @param pool Block source, at least twice max_frame_size per block; must outlive the parser
+     * @param max_frame_size Largest acceptable frame
+     * @throws std::invalid_argument if the pool's blocks are too small
+     */
+    explicit FrameParser(BufferPool& pool, size_t max_frame_size = Protocol::MAX_PACKET_SIZE);
+
+    ~FrameParser();
+
+    // Disable copy/move
+    FrameParser(const FrameParser&) = delete;
+    FrameParser& operator=(const FrameParser&) = delete;
+    FrameParser(FrameParser&&) = delete;
+    FrameParser& operator=(FrameParser&&) = delete;
+
+    /**
+     * @brief Ring that receives stream data
+     */
+    RingBuffer& Buffer() { return ring_; }
+
+    /**
+     * @brief Extract the next complete frame
+     *
+     * The previously returned frame is released on entry, so the ring has
+     * room for the next read once Next() stops returning Result::Frame.
+     *
+     * @param frame Output frame view
+     * @return Parse result
+     */
+    Result Next(FrameView& frame);
+
+    /**
+     * @brief Whether a partial frame is buffered
+     */
+    bool HasPartialFrame() const { return ring_.Size() > pending_consume_; }
+
+    /**
+     * @brief Description of the last Result::Error
+     */
+    const std::string& GetError() const { return error_; }
+
+    /**
+     * @brief Drop buffered data and clear the error state
+     */
+    void Reset();
+
+private:
+    size_t max_frame_size_;
+    RingBuffer ring_;
+    std::vector<uint8_t> scratch_;  // Linearized copy of frames that wrap
+    BufferPool* pool_{nullptr};
+    uint8_t* pooled_scratch_{nullptr};  // Pooled parsers: the same, borrowed until the next call
+    size_t pending_consume_{0};
+    std::string error_;
+
+    const uint8_t* Linearize(size_t len);
+    void ReleaseScratch();
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_FRAME_PARSER_HPP
@@ -0,0 +1,153 @@
+/**
+ * @file RingBuffer.hpp
+ * @brief Fixed-capacity byte ring used to accumulate stream data
+ */
+
+#ifndef IPC_SYNC_RING_BUFFER_HPP
+#define IPC_SYNC_RING_BUFFER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace ipc_demo {
+
+class BufferPool;
+
+/**
+ * @class RingBuffer
+ * @brief Single-threaded circular byte buffer
+ *
+ * Capacity is rounded up to a power of two so positions wrap with a mask.
+ * Writers can receive directly into the ring via WritePtr()/CommitWrite();
+ * readers look at data with Peek()/ReadPtr() and release it with Consume().
+ *
+ * A ring built on a BufferPool borrows its storage on the first write and
+ * gives it back whenever it drains, so an idle ring holds no memory.
+ */
+class RingBuffer {
+public:
+    /**
+     * @brief Construct ring buffer
+     * @param capacity Minimum capacity in bytes (rounded up to a power of two)
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit RingBuffer(size_t capacity);
+
+    /**
+     * @brief Construct ring buffer on pooled storage
+     * @param pool Source of the storage (capacity is pool.BlockSize()); must outlive the ring
+     */
+    explicit RingBuffer(BufferPool& pool);
+
+    ~RingBuffer();
+
+    // Disable copy/move
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+    RingBuffer(RingBuffer&&) = delete;
+    RingBuffer& operator=(RingBuffer&&) = delete;
+
+    /**
+     * @brief Number of readable bytes
+     */
+    size_t Size() const { return static_cast<size_t>(tail_ - head_); }
+
+    /**
+     * @brief Total capacity in bytes
+     */
+    size_t Capacity() const { return capacity_; }
+
+    /**
+     * @brief Number of bytes that can still be written
+     */
+    size_t FreeSpace() const { return Capacity() - Size(); }
+
+    bool Empty() const { return head_ == tail_; }
+
+    /**
+     * @brief Get the contiguous writable region at the tail
+     * @param contiguous Output: number of bytes writable at the returned pointer
+     * @return Pointer to write position (contiguous may be 0 when full)
+     */
+    uint8_t* WritePtr(size_t& contiguous);
+
+    /**
+     * @brief Get all free space as up to two regions (tail to end, then start)
+     *
+     * Lets a scatter read (readv/recvmsg) fill the ring in one call even
+     * when the free space wraps. Commit with CommitWrite(total).
+     *
+     * @param second Output: start of the wrapped region
+     * @param second_len Output: its length (0 if the free space does not wrap)
+     * @param first_len Output: length of the region at the returned pointer
+     * @return Pointer to write position
+     */
+    uint8_t* WriteRegions(size_t& first_len, uint8_t*& second, size_t& second_len);
+
+    /**
+     * @brief Mark bytes written through WritePtr() as readable
+     * @param len Number of bytes written (must not exceed the region returned)
+     */
+    void CommitWrite(size_t len);
+
+    /**
+     * @brief Copy data into the ring
+     * @return false if there is not enough free space (nothing is written)
+     */
+    bool Write(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Copy readable bytes without consuming them
+     * @param offset Offset from the read position
+     * @param data Destination buffer
+     * @param len Number of bytes to copy
+     * @return false if fewer than offset + len bytes are readable
+     */
+    bool Peek(size_t offset, uint8_t* data, size_t len) const;
+
+    /**
+     * @brief Pointer to the first len readable bytes if they are contiguous
+     * @return Pointer into the ring, or nullptr if the range wraps or is short
+     */
+    const uint8_t* ReadPtr(size_t len) const;
+
+    /**
+     * @brief Release bytes from the read position
+     * @param len Number of bytes (clamped to Size())
+     */
+    void Consume(size_t len);
+
+    /**
+     * @brief Drop all buffered data
+     */
+    void Clear();
+
+    /**
+     * @brief Give pooled storage back if nothing is buffered
+     *
+     * For a reader that took WritePtr() but received nothing. No-op for
+     * rings that own their storage.
+     */
+    void ReleaseIfEmpty();
+
+    /**
+     * @brief Whether pooled storage is currently borrowed (always true when owned)
+     */
+    bool HasStorage() const { return data_ != nullptr; }
+
+private:
+    uint8_t* data_{nullptr};
+    size_t capacity_;
+    size_t mask_;
+    std::unique_ptr<uint8_t[]> owned_;  // Storage of a ring built with a capacity
+    BufferPool* pool_{nullptr};
+    uint64_t head_{0};  // Read position (monotonic)
+    uint64_t tail_{0};  // Write position (monotonic)
+
+    uint8_t* Storage();
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_RING_BUFFER_HPP
@@ -0,0 +1,438 @@
+/**
+ * @file Schema.hpp
+ * @brief Compile-time message schemas: fixed-layout, non-virtual codecs
+ *
+ * A message is a plain struct that lists its fields once:
+ * @code
+ * struct AddRequest {
+ *     uint8_t op;
+ *     double a;
+ *     double b;
+ *
+ *     static constexpr auto Fields() {
+ *         return std::make_tuple(&AddRequest::op, &AddRequest::a, &AddRequest::b);
+ *     }
+ * };
+ * @endcode
+ *
+ * MessageCodec<AddRequest> then encodes and decodes it with exactly the
+ * layout ByteBuffer would produce for the same Put/Get sequence (integers
+ * big-endian, floating point in host order, strings as [LEN:4][bytes]),
+ * so schema and hand-written code interoperate on the wire.
+ *
+ * Every field's size is known at compile time except for string bodies:
+ * MessageCodec<T>::MIN_SIZE is a constant, and for a message without
+ * strings (FIXED_SIZE) it is the whole encoding, so encode/decode check the
+ * bounds once; otherwise they check once for the fixed part plus once per
+ * string.
+ *
+ * Supported field types: bool, integers, enums, float, double,
+ * std::string, std::string_view (decoded in place) and nested messages.
+ * A string longer than its 32-bit length field can describe makes the
+ * message unencodable: Size() reports schema_detail::OVERSIZED.
+ */
+#ifndef IPC_SYNC_SCHEMA_HPP
+#define IPC_SYNC_SCHEMA_HPP
+
+#include "ipc_sync/Protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace ipc_demo {
+
+namespace schema_detail {
+
+// Size of a message that cannot be encoded; larger than any buffer
+constexpr size_t OVERSIZED = std::numeric_limits<size_t>::max();
+
+// Sizes add up to at most OVERSIZED instead of wrapping
+constexpr size_t AddSize(size_t a, size_t b) {
+    return b > OVERSIZED - a ? OVERSIZED : a + b;
+}
+
+// Body size of a string, OVERSIZED if [LEN:4] cannot hold it
+constexpr size_t StringSize(size_t len) {
+    return len > std::numeric_limits<uint32_t>::max() ? OVERSIZED : len;
+}
+
+} // namespace schema_detail
+
+/**
+ * @struct WireCodec
+ * @brief Wire format of one field type
+ *
+ * Each specialization provides:
+ * - MIN_SIZE: bytes always written
+ * - FIXED_SIZE: true if MIN_SIZE is all that is ever written
+ * - ExtraSize(value): bytes written beyond MIN_SIZE
+ * - Write(out, value): write without bounds checks, return the end
+ * - Read(in, budget, value): read and advance in; variable-length data
+ *   is taken from budget (bytes beyond the fixed part), false if short
+ */
+template <typename T, typename Enable = void>
+struct WireCodec;
+
+/**
+ * @brief Integers, big-endian
+ */
+template <typename T>
+struct WireCodec<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr size_t MIN_SIZE = sizeof(T);
+    static constexpr bool FIXED_SIZE = true;
+
+    static size_t ExtraSize(T) { return 0; }
+
+    static uint8_t* Write(uint8_t* out, T value) {
+        auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out[i] = static_cast<uint8_t>(bits >> (8 * (sizeof(T) - 1 - i)));
+        }
+        return out + sizeof(T);
+    }
+
+    static bool Read(const uint8_t*& in, size_t&, T& value) {
+        std::make_unsigned_t<T> bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits = static_cast<std::make_unsigned_t<T>>((bits << 8) | in[i]);
+        }
+        value = static_cast<T>(bits);
+        in += sizeof(T);
+        return true;
+    }
+};
+
+/**
+ * @brief bool, one byte (0 or 1)
+ */
+template <>
+struct WireCodec<bool> {
+    static constexpr size_t MIN_SIZE = 1;
+    static constexpr bool FIXED_SIZE = true;
+
+    static size_t ExtraSize(bool) { return 0; }
+
+    static uint8_t* Write(uint8_t* out, bool value) {
+        *out = value ? 1 : 0;
+        return out + 1;
+    }
+
+    static bool Read(const uint8_t*& in, size_t&, bool& value) {
+        value = *in++ != 0;
+        return true;
+    }
+};
+
+/**
+ * @brief Enums, as their underlying integer
+ */
+template <typename T>
+struct WireCodec<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using Underlying = WireCodec<std::underlying_type_t<T>>;
+    static constexpr size_t MIN_SIZE = Underlying::MIN_SIZE;
+    static constexpr bool FIXED_SIZE = true;
+
+    static size_t ExtraSize(T) { return 0; }
+
+    static uint8_t* Write(uint8_t* out, T value) {
+        return Underlying::Write(out, static_cast<std::underlying_type_t<T>>(value));
+    }
+
+    static bool Read(const uint8_t*& in, size_t& budget, T& value) {
+        std::underlying_type_t<T> raw;
+        Underlying::Read(in, budget, raw);
+        value = static_cast<T>(raw);
+        return true;
+    }
+};
+
+/**
+ * @brief float and double, IEEE 754 in host order (as ByteBuffer)
+ */
+template <typename T>
+struct WireCodec<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr size_t MIN_SIZE = sizeof(T);
+    static constexpr bool FIXED_SIZE = true;
+
+    static size_t ExtraSize(T) { return 0; }
+
+    static uint8_t* Write(uint8_t* out, T value) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    static bool Read(const uint8_t*& in, size_t&, T& value) {
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return true;
+    }
+};
+
+/**
+ * @brief std::string, [LEN:4][bytes]
+ */
+template <>
+struct WireCodec<std::string> {
+    static constexpr size_t MIN_SIZE = 4;
+    static constexpr bool FIXED_SIZE = false;
+
+    static size_t ExtraSize(const std::string& value) { return schema_detail::StringSize(value.size()); }
+
+    static uint8_t* Write(uint8_t* out, const std::string& value) {
+        out = WireCodec<uint32_t>::Write(out, static_cast<uint32_t>(value.size()));
+        if (!value.empty()) {
+            std::memcpy(out, value.data(), value.size());
+        }
+        return out + value.size();
+    }
+
+    static bool Read(const uint8_t*& in, size_t& budget, std::string& value) {
+        uint32_t len = 0;
+        WireCodec<uint32_t>::Read(in, budget, len);
+        if (len > budget) {
+            return false;
+        }
+        budget -= len;
+        value.assign(reinterpret_cast<const char*>(in), len);
+        in += len;
+        return true;
+    }
+};
+
+/**
+ * @brief std::string_view, same wire format as std::string
+ *
+ * Decoding points the view into the input instead of copying; the message
+ * is valid only while the decoded bytes are. Used for view variants of
+ * response messages (see RpcClient::CallView).
+ */
+template <>
+struct WireCodec<std::string_view> {
+    static constexpr size_t MIN_SIZE = 4;
+    static constexpr bool FIXED_SIZE = false;
+
+    static size_t ExtraSize(std::string_view value) { return schema_detail::StringSize(value.size()); }
+
+    static uint8_t* Write(uint8_t* out, std::string_view value) {
+        out = WireCodec<uint32_t>::Write(out, static_cast<uint32_t>(value.size()));
+        if (!value.empty()) {
+            std::memcpy(out, value.data(), value.size());
+        }
+        return out + value.size();
+    }
+
+    static bool Read(const uint8_t*& in, size_t& budget, std::string_view& value) {
+        uint32_t len = 0;
+        WireCodec<uint32_t>::Read(in, budget, len);
+        if (len > budget) {
+            return false;
+        }
+        budget -= len;
+        value = std::string_view(reinterpret_cast<const char*>(in), len);
+        in += len;
+        return true;
+    }
+};
+
+namespace schema_detail {
+
+template <typename P>
+struct MemberPointer;
+
+template <typename C, typename M>
+struct MemberPointer<M C::*> {
+    using Type = M;
+};
+
+// Codec of the field a member pointer refers to
+template <typename P>
+using FieldCodec = WireCodec<typename MemberPointer<P>::Type>;
+
+} // namespace schema_detail
+
+/**
+ * @class MessageCodec
+ * @brief Encoder/decoder generated from T::Fields()
+ */
+template <typename T>
+class MessageCodec {
+public:
+    // Bytes every encoding of T takes (strings count their length field only)
+    static constexpr size_t MIN_SIZE = std::apply(
+        [](auto... fields) { return (size_t{0} + ... + schema_detail::FieldCodec<decltype(fields)>::MIN_SIZE); },
+        T::Fields());
+
+    // True if every encoding of T is MIN_SIZE bytes
+    static constexpr bool FIXED_SIZE = std::apply(
+        [](auto... fields) { return (true && ... && schema_detail::FieldCodec<decltype(fields)>::FIXED_SIZE); },
+        T::Fields());
+
+    /**
+     * @brief Encoded size of a message
+     * @return schema_detail::OVERSIZED if a string is too long to encode
+     */
+    static size_t Size(const T& message) {
+        if constexpr (FIXED_SIZE) {
+            (void)message;
+            return MIN_SIZE;
+        } else {
+            size_t size = MIN_SIZE;
+            std::apply(
+                [&size, &message](auto... fields) {
+                    ((size = schema_detail::AddSize(
+                          size, schema_detail::FieldCodec<decltype(fields)>::ExtraSize(message.*fields))), ...);
+                },
+                T::Fields());
+            return size;
+        }
+    }
+
+    /**
+     * @brief Write a message without bounds checks
+     * @param out At least Size(message) bytes
+     * @return End of the written bytes
+     */
+    static uint8_t* Write(uint8_t* out, const T& message) {
+        std::apply(
+            [&out, &message](auto... fields) {
+                ((out = schema_detail::FieldCodec<decltype(fields)>::Write(out, message.*fields)), ...);
+            },
+            T::Fields());
+        return out;
+    }
+
+    /**
+     * @brief Read a message; variable-length data comes out of budget
+     * @param in Advanced past the message
+     * @param budget Bytes available beyond MIN_SIZE
+     */
+    static bool Read(const uint8_t*& in, size_t& budget, T& message) {
+        return std::apply(
+            [&in, &budget, &message](auto... fields) {
+                return (true && ... &&
+                        schema_detail::FieldCodec<decltype(fields)>::Read(in, budget, message.*fields));
+            },
+            T::Fields());
+    }
+
+    /**
+     * @brief Encode a message
+     * @return Bytes written, or 0 if it does not fit capacity
+     */
+    static size_t Encode(const T& message, uint8_t* out, size_t capacity) {
+        size_t size = Size(message);
+        if (size > capacity) {
+            return 0;
+        }
+        Write(out, message);
+        return size;
+    }
+
+    /**
+     * @brief Decode a message (trailing bytes are ignored)
+     * @return false if len is too short for the message
+     */
+    static bool Decode(const uint8_t* in, size_t len, T& message) {
+        if (len < MIN_SIZE) {
+            return false;
+        }
+        size_t budget = len - MIN_SIZE;
+        return Read(in, budget, message);
+    }
+};
+
+/**
+ * @brief Nested messages, inline
+ */
+template <typename T>
+struct WireCodec<T, std::void_t<decltype(T::Fields())>> {
+    static constexpr size_t MIN_SIZE = MessageCodec<T>::MIN_SIZE;
+    static constexpr bool FIXED_SIZE = MessageCodec<T>::FIXED_SIZE;
+
+    static size_t ExtraSize(const T& value) {
+        size_t size = MessageCodec<T>::Size(value);
+        return size == schema_detail::OVERSIZED ? size : size - MIN_SIZE;
+    }
+
+    static uint8_t* Write(uint8_t* out, const T& value) {
+        return MessageCodec<T>::Write(out, value);
+    }
+
+    static bool Read(const uint8_t*& in, size_t& budget, T& value) {
+        return MessageCodec<T>::Read(in, budget, value);
+    }
+};
+
+/**
+ * @struct RpcMethod
+ * @brief Routine IDs and message types of one RPC
+ */
+template <uint32_t RequestRoutineId, uint32_t ResponseRoutineId, typename RequestT, typename ResponseT>
+struct RpcMethod {
+    using Request = RequestT;
+    using Response = ResponseT;
+    static constexpr uint32_t REQUEST_ROUTINE_ID = RequestRoutineId;
+    static constexpr uint32_t RESPONSE_ROUTINE_ID = ResponseRoutineId;
+};
+
+/**
+ * @brief Encode a whole frame: [START][LEN][ROUTINE_ID][VERSION][message][END]
+ * @return Frame length, or 0 if it does not fit capacity
+ */
+template <typename T>
+size_t EncodeFrame(uint32_t routine_id, const T& message, uint8_t* out, size_t capacity) {
+    size_t size = MessageCodec<T>::Size(message);
+    if (capacity < Protocol::GetMinFrameSize() || size > capacity - Protocol::GetMinFrameSize()) {
+        return 0;
+    }
+    size_t frame_len = Protocol::GetMinFrameSize() + size;
+    out[0] = Protocol::START_BYTE;
+    WireCodec<uint32_t>::Write(out + 1, static_cast<uint32_t>(frame_len));
+    WireCodec<uint32_t>::Write(out + 5, routine_id);
+    out[9] = Protocol::VERSION;
+    uint8_t* end = MessageCodec<T>::Write(out + Protocol::FRAME_HEADER_SIZE, message);
+    *end = Protocol::END_BYTE;
+    return frame_len;
+}
+
+/**
+ * @brief Decode the message of a whole frame
+ * @param routine_id Routine ID the frame must carry
+ * @param error Set when returning false
+ * @return false if the frame is malformed, carries another routine ID or
+ *         is too short for the message
+ */
+template <typename T>
+bool DecodeFrame(uint32_t routine_id, const uint8_t* frame, size_t len, T& message, std::string& error) {
+    if (len < Protocol::GetMinFrameSize() || frame[0] != Protocol::START_BYTE ||
+        frame[len - 1] != Protocol::END_BYTE) {
+        error = "Invalid response frame";
+        return false;
+    }
+
+    const uint8_t* in = frame + 5;
+    size_t unused = 0;
+    uint32_t frame_routine_id = 0;
+    WireCodec<uint32_t>::Read(in, unused, frame_routine_id);
+    if (frame_routine_id != routine_id) {
+        error = "Unexpected routine ID in response";
+        return false;
+    }
+
+    size_t header_len = Protocol::FRAME_HEADER_SIZE + Protocol::GetExtensionSize(frame[9]);
+    if (header_len + 1 > len ||
+        !MessageCodec<T>::Decode(frame + header_len, len - header_len - 1, message)) {
+        error = "Truncated response payload";
+        return false;
+    }
+    return true;
+}
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_SCHEMA_HPP
@@ -6,8 +6,11 @@
 #define IPC_SYNC_TIME_CLIENT_HPP
 
 #include "ipc_sync/Channel.hpp"
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 namespace ipc_demo {
@@ -17,6 +20,9 @@ namespace ipc_demo {
  * @brief Client proxy for Time service
  * 
  * Uses Pimpl idiom - all implementation is hidden in shared library
+ *
+ * The asynchronous forms need a pipelined channel, see
+ * ChannelOptions::pipelining.
  */
 class TimeClient {
 public:
@@ -27,6 +33,31 @@ public:
         std::string error_message;
     };
 
+    /**
+     * @brief TimeResult whose strings point into a ResponseBuffer
+     *
+     * Returned by GetCurrentTime(ResponseBuffer&); no heap allocation is
+     * made, and the views are valid while the buffer is neither reused nor
+     * destroyed.
+     */
+    struct TimeResultView {
+        bool success;
+        std::string_view timestamp;
+        int64_t unix_timestamp;
+        std::string_view error_message;
+
+        TimeResult ToResult() const {
+            return TimeResult{success, std::string(timestamp), unix_timestamp, std::string(error_message)};
+        }
+    };
+
+    /**
+     * @brief Completion callback for asynchronous calls
+     *
+     * Runs on the channel's event-loop thread (see Channel::ExecuteRPCAsync).
+     */
+    using Callback = std::function<void(const TimeResult&)>;
+
     /**
      * @brief Construct TimeClient proxy
      * @param channel Communication channel
@@ -46,6 +77,36 @@ public:
      */
     TimeResult GetCurrentTime();
 
+    /**
+     * @brief Get current server time, decoded in place into buffer
+     */
+    TimeResultView GetCurrentTime(ResponseBuffer& buffer);
+
+    /**
+     * @brief Get current server time asynchronously (future)
+     */
+    std::future<TimeResult> GetCurrentTimeAsync();
+
+    /**
+     * @brief Get current server time asynchronously (callback)
+     */
+    void GetCurrentTimeAsync(Callback callback);
+
+    /**
+     * @brief Have the server push the current time every interval_ms
+     *        instead of polling (needs a pipelined channel)
+     * @param callback Gets every tick, then a failed result with the
+     *        reason once the stream ends (see Channel::Subscribe)
+     * @param stream_id Output: ID for Unsubscribe()
+     * @return false if the subscription could not be sent
+     */
+    bool Subscribe(uint32_t interval_ms, Callback callback, uint32_t& stream_id);
+
+    /**
+     * @brief Stop a time stream; its callback ends with "Stream cancelled"
+     */
+    bool Unsubscribe(uint32_t stream_id);
+
 private:
     // Opaque pointer to implementation
     struct Impl;
@@ -0,0 +1,55 @@
+/**
+ * @file BufferPool.cpp
+ * @brief Implementation of BufferPool
+ */
+
+#include "ipc_sync/BufferPool.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace ipc_demo {
+
+BufferPool::BufferPool(size_t block_size, size_t blocks_per_slab)
+    : block_size_(1)
+    , blocks_per_slab_(blocks_per_slab) {
+    if (block_size == 0 || blocks_per_slab == 0) {
+        throw std::invalid_argument("BufferPool: block size and blocks per slab must be > 0");
+    }
+    while (block_size_ < block_size) {
+        block_size_ <<= 1;
+    }
+}
+
+uint8_t* BufferPool::Acquire() {
+    if (free_.empty()) {
+        AddSlab();
+    }
+
+    uint8_t* block = free_.back();
+    free_.pop_back();
+    return block;
+}
+
+void BufferPool::Reserve(size_t blocks) {
+    while (allocated_ < blocks) {
+        AddSlab();
+        std::memset(slabs_.back().get(), 0, block_size_ * blocks_per_slab_); // Fault the pages in now
+    }
+}
+
+void BufferPool::AddSlab() {
+    slabs_.emplace_back(new uint8_t[block_size_ * blocks_per_slab_]);
+    uint8_t* slab = slabs_.back().get();
+    // Hand out the slab front to back
+    for (size_t i = blocks_per_slab_; i > 0; --i) {
+        free_.push_back(slab + (i - 1) * block_size_);
+    }
+    allocated_ += blocks_per_slab_;
+}
+
+void BufferPool::Release(uint8_t* block) {
+    // Most recently used first: the next Acquire gets a cache-warm block
+    free_.push_back(block);
+}
+
+} // namespace ipc_demo
@@ -4,102 +4,121 @@
  */
 
 #include "ipc_sync/CalculatorClient.hpp"
-#include "ipc_sync/ByteBuffer.hpp"
-#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
+#include "ipc_sync/RpcClient.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace ipc_demo {
 
-enum class Operation : uint8_t {
-    Add = 0x01,
-    Subtract = 0x02,
-    Multiply = 0x03,
-    Divide = 0x04
-};
+using Operation = CalculatorOperation;
 
 // Private implementation (hidden from client)
 struct Calculator::Impl {
     std::shared_ptr<Channel> channel_;
-    static constexpr uint32_t REQUEST_ROUTINE_ID = 0x00001000;
-    static constexpr uint32_t RESPONSE_ROUTINE_ID = 0x00001001;
+    RpcClient<CalculatorRpc> stub_;
 
     explicit Impl(std::shared_ptr<Channel> channel)
-        : channel_(channel) {
-        if (!channel_) {
+        : channel_(channel), stub_(NonNull(channel)) {
+    }
+
+    static std::shared_ptr<Channel> NonNull(std::shared_ptr<Channel> channel) {
+        if (!channel) {
             throw std::invalid_argument("Calculator: channel cannot be null");
         }
+        return channel;
+    }
+
+    static Calculator::Result ToResult(const CalculatorResponse& response) {
+        if (response.status == CalculatorStatus::Success) {
+            return Calculator::Result{true, response.result, ""};
+        }
+        return Calculator::Result{false, 0.0, response.error};
+    }
+
+    static Calculator::ResultView ToView(const CalculatorResponseView& response) {
+        if (response.status == CalculatorStatus::Success) {
+            return Calculator::ResultView{true, response.result, {}};
+        }
+        return Calculator::ResultView{false, 0.0, response.error};
+    }
+
+    Calculator::ResultView ExecuteOperation(Operation op, double a, double b, ResponseBuffer& buffer) {
+        CalculatorResponseView response;
+        std::string error;
+        if (!stub_.CallView(CalculatorRequest{op, a, b}, buffer.data, sizeof(buffer.data), response, error)) {
+            return Calculator::ResultView{false, 0.0, buffer.Keep(error)};
+        }
+        return ToView(response);
     }
 
     Calculator::Result ExecuteOperation(Operation op, double a, double b) {
-        Calculator::Result result;
-        result.success = false;
-        result.value = 0.0;
-
-        try {
-            // Build request payload
-            uint8_t request_data[1 + sizeof(double) * 2];
-            ByteBuffer request_buf(request_data, sizeof(request_data));
-            
-            request_buf.PutByte(static_cast<uint8_t>(op));
-            request_buf.PutDouble(a);
-            request_buf.PutDouble(b);
-
-            // Execute RPC
-            uint8_t response_data[Protocol::MAX_PACKET_SIZE];
-            size_t response_len = 0;
-
-            bool rpc_ok = channel_->ExecuteRPC(
-                REQUEST_ROUTINE_ID,
-                request_data, request_buf.Position(),
-                response_data, sizeof(response_data),
-                response_len
-            );
-
-            if (!rpc_ok) {
-                result.error_message = "RPC failed: " + channel_->GetLastError();
-                return result;
-            }
+        // Decoded in place, so the error message is copied once
+        ResponseBuffer buffer;
+        return ExecuteOperation(op, a, b, buffer).ToResult();
+    }
 
-            // Parse response
-            ByteBuffer response_buf(response_data, response_len);
-            
-            uint8_t start = response_buf.GetByte();
-            if (start != Protocol::START_BYTE) {
-                result.error_message = "Invalid response frame";
-                return result;
-            }
+    std::vector<Calculator::Result> ExecuteBatch(Operation op,
+                                                 const std::vector<std::pair<double, double>>& operands) {
+        // Encode every request into one flat buffer, referenced by the calls
+        constexpr size_t REQUEST_SIZE = MessageCodec<CalculatorRequest>::MIN_SIZE;
+        std::vector<uint8_t> requests(operands.size() * REQUEST_SIZE);
+        std::vector<BatchCall> calls;
+        calls.reserve(operands.size());
+
+        for (size_t i = 0; i < operands.size(); ++i) {
+            uint8_t* request_data = requests.data() + i * REQUEST_SIZE;
+            MessageCodec<CalculatorRequest>::Write(
+                request_data, CalculatorRequest{op, operands[i].first, operands[i].second});
+            calls.push_back(BatchCall{CalculatorRpc::REQUEST_ROUTINE_ID, request_data, REQUEST_SIZE});
+        }
 
-            uint32_t frame_len = response_buf.GetInt();
-            uint32_t routine_id = response_buf.GetInt();
-            
-            if (routine_id != RESPONSE_ROUTINE_ID) {
-                result.error_message = "Unexpected routine ID in response";
-                return result;
-            }
+        std::vector<Calculator::Result> results;
+        results.reserve(operands.size());
 
-            uint8_t version = response_buf.GetByte();
-            (void)version; // Protocol version for future use
-            (void)frame_len; // Frame length already validated
-            
-            uint8_t status = response_buf.GetByte();
-            double value = response_buf.GetDouble();
-            std::string error_msg = response_buf.GetString();
-
-            if (status == 0x00) { // Success
-                result.success = true;
-                result.value = value;
+        std::vector<RPCResponse> responses;
+        if (!channel_->ExecuteBatch(calls, responses)) {
+            std::string error = "RPC failed: " + channel_->GetLastError();
+            results.assign(operands.size(), Calculator::Result{false, 0.0, error});
+            return results;
+        }
+
+        for (const auto& response : responses) {
+            if (!response.success) {
+                results.push_back(Calculator::Result{false, 0.0, response.error_message});
+                continue;
+            }
+            CalculatorResponseView decoded;
+            std::string error;
+            if (!RpcClient<CalculatorRpc>::ParseResponse(response.frame.data(), response.frame.size(),
+                                                         decoded, error)) {
+                results.push_back(Calculator::Result{false, 0.0, error});
             } else {
-                result.success = false;
-                result.error_message = error_msg;
+                results.push_back(ToView(decoded).ToResult());
             }
+        }
+        return results;
+    }
 
-            return result;
-
-        } catch (const std::exception& e) {
-            result.error_message = std::string("Exception: ") + e.what();
-            return result;
+    void ExecuteOperationAsync(Operation op, double a, double b, Calculator::Callback callback) {
+        if (!callback) {
+            throw std::invalid_argument("Calculator: callback cannot be empty");
         }
+
+        stub_.CallAsync(CalculatorRequest{op, a, b},
+            [callback = std::move(callback)](bool success, const CalculatorResponse& response,
+                                             const std::string& error) {
+                callback(success ? ToResult(response) : Calculator::Result{false, 0.0, error});
+            });
+    }
+
+    std::future<Calculator::Result> ExecuteOperationAsync(Operation op, double a, double b) {
+        auto promise = std::make_shared<std::promise<Calculator::Result>>();
+        std::future<Calculator::Result> future = promise->get_future();
+
+        ExecuteOperationAsync(op, a, b, [promise](const Calculator::Result& result) {
+            promise->set_value(result);
+        });
+        return future;
     }
 };
 
@@ -126,4 +145,56 @@ Calculator::Result Calculator::Divide(double a, double b) {
     return pImpl_->ExecuteOperation(Operation::Divide, a, b);
 }
 
+Calculator::ResultView Calculator::Add(double a, double b, ResponseBuffer& buffer) {
+    return pImpl_->ExecuteOperation(Operation::Add, a, b, buffer);
+}
+
+Calculator::ResultView Calculator::Subtract(double a, double b, ResponseBuffer& buffer) {
+    return pImpl_->ExecuteOperation(Operation::Subtract, a, b, buffer);
+}
+
+Calculator::ResultView Calculator::Multiply(double a, double b, ResponseBuffer& buffer) {
+    return pImpl_->ExecuteOperation(Operation::Multiply, a, b, buffer);
+}
+
+Calculator::ResultView Calculator::Divide(double a, double b, ResponseBuffer& buffer) {
+    return pImpl_->ExecuteOperation(Operation::Divide, a, b, buffer);
+}
+
+std::vector<Calculator::Result> Calculator::AddBatch(const std::vector<std::pair<double, double>>& operands) {
+    return pImpl_->ExecuteBatch(Operation::Add, operands);
+}
+
+std::future<Calculator::Result> Calculator::AddAsync(double a, double b) {
+    return pImpl_->ExecuteOperationAsync(Operation::Add, a, b);
+}
+
+std::future<Calculator::Result> Calculator::SubtractAsync(double a, double b) {
+    return pImpl_->ExecuteOperationAsync(Operation::Subtract, a, b);
+}
+
+std::future<Calculator::Result> Calculator::MultiplyAsync(double a, double b) {
+    return pImpl_->ExecuteOperationAsync(Operation::Multiply, a, b);
+}
+
+std::future<Calculator::Result> Calculator::DivideAsync(double a, double b) {
+    return pImpl_->ExecuteOperationAsync(Operation::Divide, a, b);
+}
+
+void Calculator::AddAsync(double a, double b, Callback callback) {
+    pImpl_->ExecuteOperationAsync(Operation::Add, a, b, std::move(callback));
+}
+
+void Calculator::SubtractAsync(double a, double b, Callback callback) {
+    pImpl_->ExecuteOperationAsync(Operation::Subtract, a, b, std::move(callback));
+}
+
+void Calculator::MultiplyAsync(double a, double b, Callback callback) {
+    pImpl_->ExecuteOperationAsync(Operation::Multiply, a, b, std::move(callback));
+}
+
+void Calculator::DivideAsync(double a, double b, Callback callback) {
+    pImpl_->ExecuteOperationAsync(Operation::Divide, a, b, std::move(callback));
+}
+
 } // namespace ipc_demo
@@ -5,56 +5,270 @@
 
 #include "ipc_sync/Channel.hpp"
 #include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/ByteOrder.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/IoUring.hpp"
+#include "ipc_sync/LargePayload.hpp"
 #include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/ShmTransport.hpp"
+#include "ipc_sync/Tracer.hpp"
 
+#include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <iostream>
 #include <mutex>
 #include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace ipc_demo {
 
+namespace {
+
+// user_data of the linked io_uring exchange (see Channel::Impl::ExchangeUring)
+enum UringOp : uint64_t {
+    URING_SEND = 1,
+    URING_RECV,
+    URING_TIMEOUT,
+    URING_CANCEL
+};
+
+// ROUTINE_ID(4) + LEN(4) in front of every batch entry
+constexpr size_t BATCH_ENTRY_HEADER_SIZE = 8;
+
+// Load-shedding answer the server sends instead of a response
+bool IsServerBusy(const uint8_t* frame, size_t len) {
+    if (len < Protocol::GetMinFrameSize()) {
+        return false;
+    }
+    ByteBuffer header(const_cast<uint8_t*>(frame), len);
+    header.SetPosition(5);
+    return header.GetInt() == Protocol::SERVER_BUSY_ROUTINE_ID;
+}
+
+// Spin-wait hint to the CPU (lets a sibling hyperthread run)
+void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Closes a payload memfd once the request is sent (or abandoned)
+struct ScopedFd {
+    int fd = -1;
+    ~ScopedFd() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+// A request frame as gather segments: header, the caller's payload and
+// END. The payload is sent from the caller's memory, never copied.
+struct RequestFrame {
+    uint8_t header[Protocol::FRAME_HEADER_SIZE + Protocol::REQUEST_ID_SIZE + Protocol::TRACE_ID_SIZE +
+                   Protocol::FD_PAYLOAD_HEADER_SIZE];
+    uint8_t trailer = Protocol::END_BYTE;
+    struct iovec iov[3];
+    size_t iovcnt = 0;
+    ScopedFd payload;  // Sealed memfd carrying a large payload
+    std::vector<uint8_t> compressed;  // Payload as sent when FLAG_COMPRESSED is set
+};
+
+// Rewrite a compressed response frame as the plain frame it stands for;
+// returns the plain length, or 0 if the payload is corrupt or too large
+size_t InflateFrame(const uint8_t* frame, size_t len, uint8_t* out, size_t capacity,
+                    const CompressionDictionary* dictionary) {
+    if (len < Protocol::GetMinFrameSize() || capacity < Protocol::GetMinFrameSize()) {
+        return 0;
+    }
+    size_t payload_len = DecompressPayload(frame + Protocol::FRAME_HEADER_SIZE, len - Protocol::GetMinFrameSize(),
+                                           out + Protocol::FRAME_HEADER_SIZE, capacity - Protocol::GetMinFrameSize(),
+                                           dictionary);
+    if (payload_len == 0) {
+        return 0;
+    }
+
+    std::memcpy(out, frame, Protocol::FRAME_HEADER_SIZE);
+    out[Protocol::FRAME_HEADER_SIZE - 1] &= static_cast<uint8_t>(~Protocol::FLAG_COMPRESSED);
+    size_t plain_len = Protocol::GetMinFrameSize() + payload_len;
+    byte_order::StoreBigEndian<uint32_t>(out + 1, static_cast<uint32_t>(plain_len));
+    out[plain_len - 1] = Protocol::END_BYTE;
+    return plain_len;
+}
+
+// Append the sub-responses of one batched response frame to responses
+bool ParseBatchResponse(const uint8_t* data, size_t len, uint32_t expected_count,
+                        std::vector<RPCResponse>& responses) {
+    try {
+        ByteBuffer buf(const_cast<uint8_t*>(data), len);
+        if (buf.GetByte() != Protocol::START_BYTE) {
+            return false;
+        }
+        buf.GetInt(); // Frame length
+        if (buf.GetInt() != Protocol::BATCH_RESPONSE_ROUTINE_ID) {
+            return false;
+        }
+        buf.GetByte(); // Version
+        if (buf.GetInt() != expected_count) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < expected_count; ++i) {
+            uint32_t entry_len = buf.GetInt();
+            if (entry_len > len - buf.Position()) {
+                return false;
+            }
+
+            RPCResponse response;
+            response.success = entry_len > 0;
+            if (response.success) {
+                const uint8_t* entry = data + buf.Position();
+                response.frame.assign(entry, entry + entry_len);
+            } else {
+                response.error_message = "Service returned no response";
+            }
+            responses.push_back(std::move(response));
+            buf.SetPosition(buf.Position() + entry_len);
+        }
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
 // Private implementation (hidden from client)
 struct Channel::Impl {
+    using Clock = std::chrono::steady_clock;
+
     std::string socket_path_;
     int timeout_ms_;
+    bool pipelining_;
     int socket_fd_;
     std::atomic<bool> connected_;
     std::string last_error_;
     std::mutex mutex_;
-    std::vector<uint8_t> buffer_;
 
-    Impl(const std::string& socket_path, int timeout_ms)
+    // Pipelined mode: event-loop thread and the calls it completes
+    std::thread event_thread_;
+    int wake_fd_{-1};  // eventfd, wakes the loop when the first deadline is added
+    std::mutex pending_mutex_;
+    std::unordered_map<uint32_t, RPCCallback> pending_calls_;
+    std::deque<std::pair<Clock::time_point, uint32_t>> deadlines_; // FIFO, all calls share timeout_ms_
+    uint32_t next_request_id_{0}; // Guarded by mutex_
+
+    // Pipelined mode: server-push streams by stream ID (guarded by
+    // pending_mutex_) and the credits consumed frames earned, sent by the
+    // event loop
+    struct StreamState {
+        RPCCallback callback;
+        uint32_t grant_every;    // Consumed frames per credit grant
+        uint32_t consumed = 0;   // Event-loop thread only
+    };
+    std::unordered_map<uint32_t, std::shared_ptr<StreamState>> streams_;
+    std::vector<std::pair<uint32_t, uint32_t>> credit_grants_; // (stream ID, credits)
+
+    // Shared-memory transport (guarded by mutex_). Shared with the event
+    // loop so a Disconnect() from a callback cannot unmap it under the loop.
+    Transport transport_;
+    size_t shm_ring_capacity_;
+    size_t large_payload_threshold_;
+    uint32_t idle_timeout_ms_;
+    std::shared_ptr<ShmTransport> shm_;
+    FrameParser shm_parser_;  // Non-pipelined mode: reassembles responses from the ring
+
+    // io_uring backend (non-pipelined socket RPCs, guarded by mutex_)
+    std::unique_ptr<IoUring> ring_;
+
+    uint32_t spin_wait_us_;  // Non-pipelined receives poll this long before blocking
+
+    // Payload compression: what this connection negotiated (guarded by
+    // mutex_, reset on every connect)
+    bool compression_enabled_;
+    size_t compression_threshold_;
+    std::shared_ptr<const CompressionDictionary> compression_dictionary_;
+    uint8_t compression_{Protocol::COMPRESSION_REFUSED};
+
+    // Sampled RPCs record a trace::Span (see ChannelOptions::trace_sample_rate)
+    trace::Sampler trace_sampler_;
+    bool trace_propagation_;
+
+    Impl(const std::string& socket_path, const ChannelOptions& options)
         : socket_path_(socket_path)
-        , timeout_ms_(timeout_ms)
+        , timeout_ms_(options.timeout_ms)
+        , pipelining_(options.pipelining)
         , socket_fd_(-1)
-        , connected_(false) {
-        buffer_.resize(Protocol::MAX_PACKET_SIZE);
+        , connected_(false)
+        , transport_(options.transport)
+        , shm_ring_capacity_(options.shm_ring_capacity)
+        , large_payload_threshold_(options.large_payload_threshold)
+        , idle_timeout_ms_(options.idle_timeout_ms)
+        , spin_wait_us_(options.spin_wait_us)
+        , compression_enabled_(options.compression)
+        , compression_threshold_(options.compression_threshold)
+        , compression_dictionary_(options.compression_dictionary)
+        , trace_sampler_(options.trace_sample_rate)
+        , trace_propagation_(options.trace_propagation) {
+        if (pipelining_) {
+            wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (wake_fd_ < 0) {
+                throw std::runtime_error("Channel: eventfd failed: " + std::string(strerror(errno)));
+            }
+        } else if (options.io_uring) {
+            std::string error;
+            ring_ = IoUring::Create(8, error);
+            if (!ring_) {
+                std::cerr << "[Channel] io_uring unavailable, using plain syscalls: " << error << std::endl;
+            }
+        }
     }
 
     ~Impl() {
         Disconnect();
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+        }
     }
 
     bool Connect() {
         std::lock_guard<std::mutex> lock(mutex_);
-        
+        return ConnectLocked();
+    }
+
+    bool ConnectLocked() {
         if (connected_.load() && socket_fd_ >= 0) {
             return true;
         }
 
         // Close existing connection if any
         if (socket_fd_ >= 0) {
+            StopReader();
             close(socket_fd_);
             socket_fd_ = -1;
         }
+        shm_.reset(); // Every connection negotiates a fresh transport
+        compression_ = Protocol::COMPRESSION_REFUSED;
 
         // Create socket
         socket_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
@@ -116,28 +330,255 @@ struct Channel::Impl {
         struct timeval tv;
         tv.tv_sec = timeout_ms_ / 1000;
         tv.tv_usec = (timeout_ms_ % 1000) * 1000;
-        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        if (!pipelining_) {
+            // Pipelined mode waits in poll() and tracks deadlines per call
+            setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        }
         setsockopt(socket_fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 
+        if (idle_timeout_ms_ > 0) {
+            NegotiateIdleTimeout();
+        }
+        if (compression_enabled_) {
+            NegotiateCompression();
+        }
+        if (transport_ == Transport::SharedMemory) {
+            NegotiateSharedMemory();
+        }
+
         connected_.store(true);
         last_error_.clear();
+
+        if (pipelining_) {
+            event_thread_ = std::thread(&Impl::EventLoop, this, socket_fd_, shm_, ActiveDictionary());
+        }
         return true;
     }
 
     void Disconnect() {
         std::lock_guard<std::mutex> lock(mutex_);
         if (socket_fd_ >= 0) {
+            StopReader();
             close(socket_fd_);
             socket_fd_ = -1;
         }
+        shm_.reset();
         connected_.store(false);
     }
 
+    // Probe an idle connection without sending anything, reconnect if the
+    // server closed it. Never waits for an RPC in progress.
+    bool CheckConnection() {
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return connected_.load(); // In use: the RPC itself notices failures
+        }
+
+        // The pipelined event loop already watches the socket; elsewhere
+        // nothing is read while idle, so readable means EOF (or a reset)
+        if (!pipelining_ && connected_.load() && socket_fd_ >= 0) {
+            struct pollfd pfd;
+            pfd.fd = socket_fd_;
+            pfd.events = POLLIN | POLLRDHUP;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, 0) > 0) {
+                uint8_t byte;
+                if ((pfd.revents & (POLLHUP | POLLERR | POLLRDHUP)) ||
+                    recv(socket_fd_, &byte, 1, MSG_PEEK | MSG_DONTWAIT) <= 0) {
+                    connected_.store(false);
+                }
+            }
+        }
+        return ConnectLocked();
+    }
+
+    // Offer the server a shared-memory transport. Any failure leaves the
+    // socket in use: the connection itself is still fine.
+    void NegotiateSharedMemory() {
+        std::string error;
+        std::shared_ptr<ShmTransport> transport = ShmTransport::Create(shm_ring_capacity_, error);
+        if (!transport) {
+            std::cerr << "[Channel] Shared memory unavailable: " << error << std::endl;
+            return;
+        }
+
+        uint8_t request[Protocol::GetMinFrameSize()];
+        ByteBuffer request_buf(request, sizeof(request));
+        request_buf.PutByte(Protocol::START_BYTE);
+        request_buf.PutInt(static_cast<uint32_t>(sizeof(request)));
+        request_buf.PutInt(Protocol::SHM_NEGOTIATE_REQUEST_ROUTINE_ID);
+        request_buf.PutByte(Protocol::VERSION);
+        request_buf.PutByte(Protocol::END_BYTE);
+
+        int fds[3] = {transport->MemFd(), transport->RequestEventFd(), transport->ResponseEventFd()};
+        if (SendWithFds(socket_fd_, request, sizeof(request), fds, 3) != static_cast<ssize_t>(sizeof(request))) {
+            std::cerr << "[Channel] Shared memory offer failed: " << strerror(errno) << std::endl;
+            return;
+        }
+
+        // A server without shared-memory support never answers: after the
+        // timeout the socket simply stays in use
+        uint8_t status = 0;
+        if (!ReceiveNegotiation(Protocol::SHM_NEGOTIATE_RESPONSE_ROUTINE_ID, &status, sizeof(status), error)) {
+            std::cerr << "[Channel] Shared memory negotiation failed: " << error << std::endl;
+            return;
+        }
+        if (status != Protocol::SHM_ACCEPTED) {
+            return; // Refused (disabled or busy); not an error
+        }
+
+        shm_ = std::move(transport);
+        shm_parser_.Reset();
+    }
+
+    // Ask the server for this connection's inactivity timeout. On failure
+    // the server default applies; the connection itself is still fine.
+    void NegotiateIdleTimeout() {
+        uint8_t request[Protocol::GetMinFrameSize() + Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE];
+        ByteBuffer request_buf(request, sizeof(request));
+        request_buf.PutByte(Protocol::START_BYTE);
+        request_buf.PutInt(static_cast<uint32_t>(sizeof(request)));
+        request_buf.PutInt(Protocol::IDLE_TIMEOUT_REQUEST_ROUTINE_ID);
+        request_buf.PutByte(Protocol::VERSION);
+        request_buf.PutInt(idle_timeout_ms_);
+        request_buf.PutByte(Protocol::END_BYTE);
+
+        if (send(socket_fd_, request, sizeof(request), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(request))) {
+            std::cerr << "[Channel] Idle timeout request failed: " << strerror(errno) << std::endl;
+            return;
+        }
+
+        uint8_t granted[Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE];
+        std::string error;
+        if (!ReceiveNegotiation(Protocol::IDLE_TIMEOUT_RESPONSE_ROUTINE_ID, granted, sizeof(granted), error)) {
+            std::cerr << "[Channel] Idle timeout negotiation failed: " << error << std::endl;
+        }
+    }
+
+    // Offer payload compression, with our dictionary if we have one. On
+    // failure frames stay uncompressed; the connection itself is still fine.
+    void NegotiateCompression() {
+        uint8_t request[Protocol::GetMinFrameSize() + Protocol::COMPRESSION_NEGOTIATE_PAYLOAD_SIZE];
+        ByteBuffer request_buf(request, sizeof(request));
+        request_buf.PutByte(Protocol::START_BYTE);
+        request_buf.PutInt(static_cast<uint32_t>(sizeof(request)));
+        request_buf.PutInt(Protocol::COMPRESSION_NEGOTIATE_REQUEST_ROUTINE_ID);
+        request_buf.PutByte(Protocol::VERSION);
+        request_buf.PutInt(compression_dictionary_ ? compression_dictionary_->Id() : 0);
+        request_buf.PutByte(Protocol::END_BYTE);
+
+        if (send(socket_fd_, request, sizeof(request), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(request))) {
+            std::cerr << "[Channel] Compression request failed: " << strerror(errno) << std::endl;
+            return;
+        }
+
+        uint8_t status = Protocol::COMPRESSION_REFUSED;
+        std::string error;
+        if (!ReceiveNegotiation(Protocol::COMPRESSION_NEGOTIATE_RESPONSE_ROUTINE_ID, &status, sizeof(status), error)) {
+            std::cerr << "[Channel] Compression negotiation failed: " << error << std::endl;
+            return;
+        }
+        if (status == Protocol::COMPRESSION_LZ4 ||
+            (status == Protocol::COMPRESSION_LZ4_DICTIONARY && compression_dictionary_)) {
+            compression_ = status;
+        }
+    }
+
+    // Dictionary of the negotiated compression, if any; caller holds mutex_
+    const CompressionDictionary* ActiveDictionary() const {
+        return compression_ == Protocol::COMPRESSION_LZ4_DICTIONARY ? compression_dictionary_.get() : nullptr;
+    }
+
+    // Read one untagged response frame with a fixed-size payload
+    bool ReceiveNegotiation(uint32_t routine_id, uint8_t* payload, size_t payload_len, std::string& error) {
+        uint8_t response[Protocol::GetMinFrameSize() + Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE];
+        size_t expected = Protocol::GetMinFrameSize() + payload_len;
+        if (expected > sizeof(response)) {
+            error = "Negotiation payload too large";
+            return false;
+        }
+        size_t received = 0;
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms_);
+
+        while (received < expected) {
+            int wait_ms = static_cast<int>(
+                std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count());
+            if (wait_ms <= 0) {
+                error = "Receive timeout";
+                return false;
+            }
+
+            struct pollfd pfd;
+            pfd.fd = socket_fd_;
+            pfd.events = POLLIN;
+            int ret = poll(&pfd, 1, wait_ms);
+            if (ret < 0 && errno != EINTR) {
+                error = "poll failed: " + std::string(strerror(errno));
+                return false;
+            }
+            if (ret <= 0) {
+                continue;
+            }
+
+            ssize_t n = recv(socket_fd_, response + received, expected - received, MSG_DONTWAIT);
+            if (n < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+                    continue;
+                }
+                error = "recv failed: " + std::string(strerror(errno));
+                return false;
+            }
+            if (n == 0) {
+                error = "Connection closed by server";
+                return false;
+            }
+            received += static_cast<size_t>(n);
+        }
+
+        ByteBuffer buf(response, expected);
+        bool valid = buf.GetByte() == Protocol::START_BYTE &&
+                     buf.GetInt() == expected &&
+                     buf.GetInt() == routine_id &&
+                     buf.GetByte() == Protocol::VERSION;
+        std::memcpy(payload, buf.Consume(payload_len), payload_len);
+        if (!valid || buf.GetByte() != Protocol::END_BYTE) {
+            error = "Unexpected negotiation response";
+            return false;
+        }
+        return true;
+    }
+
+    // Stop the event loop (if any) and wait for it; caller holds mutex_
+    void StopReader() {
+        if (!event_thread_.joinable()) {
+            return;
+        }
+
+        shutdown(socket_fd_, SHUT_RDWR); // Loop sees EOF and fails outstanding calls
+        if (event_thread_.get_id() == std::this_thread::get_id()) {
+            event_thread_.detach(); // Disconnect() from a callback
+        } else {
+            event_thread_.join();
+        }
+    }
+
     bool ExecuteRPC(uint32_t routine_id,
                     const uint8_t* request_data, size_t request_len,
                     uint8_t* response_buffer, size_t response_buffer_size,
                     size_t& response_len) {
-        
+
+        if (pipelining_) {
+            return ExecutePipelined(routine_id, request_data, request_len,
+                                    response_buffer, response_buffer_size, response_len);
+        }
+
+        // Sampled calls record where their time goes (failed ones are not kept)
+        trace::Span span;
+        trace::Span* traced = trace_sampler_.Sample() ? &span : nullptr;
+        if (traced) {
+            StartSpan(span, routine_id);
+        }
+
         // Auto-reconnect if needed (handles timeouts transparently)
         if (!EnsureConnected()) {
             last_error_ = "Failed to establish connection";
@@ -147,37 +588,25 @@ struct Channel::Impl {
         std::lock_guard<std::mutex> lock(mutex_);
 
         // Build request frame
-        ByteBuffer request_buf(buffer_.data(), buffer_.size());
-        
-        request_buf.PutByte(Protocol::START_BYTE);
-        request_buf.PutInt(0); // Placeholder for length
-        request_buf.PutInt(routine_id);
-        request_buf.PutByte(Protocol::VERSION);
-        
-        // Add payload
-        if (request_data && request_len > 0) {
-            size_t pos = request_buf.Position();
-            if (pos + request_len >= buffer_.size()) {
-                last_error_ = "Request payload too large";
-                return false;
-            }
-            std::memcpy(buffer_.data() + pos, request_data, request_len);
-            request_buf.SetPosition(pos + request_len);
+        RequestFrame request;
+        if (!BuildRequest(routine_id, std::nullopt, request_data, request_len, request, last_error_,
+                          span.trace_id)) {
+            return false;
+        }
+        if (traced) {
+            span.Mark(trace::ClientStage::Encoded);
         }
-        
-        request_buf.PutByte(Protocol::END_BYTE);
-
-        // Update frame length
-        size_t frame_len = request_buf.Position();
-        request_buf.SetPosition(1);
-        request_buf.PutInt(static_cast<uint32_t>(frame_len));
 
         // Send request (with retry on connection failure)
-        if (!SendData(buffer_.data(), frame_len)) {
+        bool sent = false;
+        bool received = Exchange(request, response_buffer, response_buffer_size, response_len, sent, traced);
+        if (!sent) {
             connected_.store(false);
             
             // Retry once after reconnecting
-            if (Connect() && SendData(buffer_.data(), frame_len)) {
+            if (ConnectLocked() &&
+                (received = Exchange(request, response_buffer, response_buffer_size, response_len, sent, traced),
+                 sent)) {
                 // Successfully reconnected and sent
             } else {
                 last_error_ = "Failed to send after reconnect attempt";
@@ -186,115 +615,1066 @@ struct Channel::Impl {
         }
 
         // Receive response
-        if (!ReceiveData(response_buffer, response_buffer_size, response_len)) {
+        if (!received) {
             connected_.store(false);
             last_error_ = "Failed to receive response";
             return false;
         }
+        if (traced) {
+            span.Mark(trace::ClientStage::Received);
+        }
+
+        if (IsServerBusy(response_buffer, response_len)) {
+            response_len = 0;
+            last_error_ = "Server busy";
+            return false;
+        }
+
+        if (response_buffer[Protocol::FRAME_HEADER_SIZE - 1] & Protocol::FLAG_COMPRESSED) {
+            uint8_t plain[Protocol::MAX_PACKET_SIZE];
+            size_t plain_len = InflateFrame(response_buffer, response_len, plain, sizeof(plain), ActiveDictionary());
+            if (plain_len == 0 || plain_len > response_buffer_size) {
+                response_len = 0;
+                last_error_ = plain_len == 0 ? "Corrupt compressed response" : "Response too large for buffer";
+                return false;
+            }
+            std::memcpy(response_buffer, plain, plain_len);
+            response_len = plain_len;
+        }
 
+        if (traced) {
+            span.Mark(trace::ClientStage::Done);
+            trace::Tracer::Global().Record(span);
+        }
         return true;
     }
 
-    // Helper: Ensures connection is active (auto-reconnects if needed)
-    bool EnsureConnected() {
-        if (connected_.load() && socket_fd_ >= 0) {
-            return true; // Already connected
-        }
-        
-        // Need to (re)connect
-        return Connect();
+    // Begin the span of a sampled call; its trace ID (0 without
+    // trace_propagation) goes into the request
+    void StartSpan(trace::Span& span, uint32_t routine_id) const {
+        span.side = trace::Side::Client;
+        span.routine_id = routine_id;
+        span.trace_id = trace_propagation_ ? trace::NewTraceId() : 0;
+        span.Mark(trace::ClientStage::Start);
     }
 
-    bool SendData(const uint8_t* data, size_t len) {
-        size_t total_sent = 0;
+    bool ExecutePipelined(uint32_t routine_id,
+                          const uint8_t* request_data, size_t request_len,
+                          uint8_t* response_buffer, size_t response_buffer_size,
+                          size_t& response_len) {
+        response_len = 0;
 
-        while (total_sent < len) {
-            ssize_t sent = send(socket_fd_, data + total_sent, len - total_sent, MSG_NOSIGNAL);
-            
-            if (sent < 0) {
-                if (errno == EINTR) {
-                    continue;
+        struct SyncCall {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool done = false;
+            bool ok = false;
+            size_t length = 0;
+            std::string error;
+            uint64_t received_ticks = 0;  // Stamped by the event loop for a traced call
+        } call;
+
+        trace::Span span;
+        trace::Span* traced = trace_sampler_.Sample() ? &span : nullptr;
+        if (traced) {
+            StartSpan(span, routine_id);
+        }
+
+        StartPipelined(routine_id, request_data, request_len,
+            [&call, traced, response_buffer, response_buffer_size](bool success, const uint8_t* response,
+                                                                   size_t length, const std::string& error) {
+                std::lock_guard<std::mutex> lock(call.mutex);
+                if (traced) {
+                    call.received_ticks = trace::Now();
                 }
-                last_error_ = "send failed: " + std::string(strerror(errno));
-                return false;
-            }
+                if (success && length > response_buffer_size) {
+                    call.error = "Response too large for buffer";
+                } else if (success) {
+                    std::memcpy(response_buffer, response, length);
+                    call.length = length;
+                    call.ok = true;
+                } else {
+                    call.error = error;
+                }
+                call.done = true;
+                call.cv.notify_one();
+            }, traced);
 
-            if (sent == 0) {
-                last_error_ = "Connection closed by server";
-                return false;
-            }
+        // The event loop always completes the call (response, timeout or failure)
+        std::unique_lock<std::mutex> lock(call.mutex);
+        call.cv.wait(lock, [&call]() { return call.done; });
 
-            total_sent += sent;
+        if (!call.ok) {
+            std::string error = call.error;
+            lock.unlock();
+            SetLastError(error);
+            return false;
         }
 
+        response_len = call.length;
+        if (traced) {
+            span.ticks[static_cast<size_t>(trace::ClientStage::Received)] = call.received_ticks;
+            span.Mark(trace::ClientStage::Done);
+            trace::Tracer::Global().Record(span);
+        }
         return true;
     }
 
-    bool ReceiveData(uint8_t* data, size_t max_len, size_t& received) {
-        received = 0;
+    void ExecuteAsync(uint32_t routine_id,
+                      const uint8_t* request_data, size_t request_len,
+                      RPCCallback callback) {
+        if (!pipelining_) {
+            std::string error = "Asynchronous RPC requires ChannelOptions::pipelining";
+            SetLastError(error);
+            callback(false, nullptr, 0, error);
+            return;
+        }
 
-        // Read minimum frame size
-        size_t min_size = Protocol::GetMinFrameSize();
-        while (received < min_size) {
-            ssize_t n = recv(socket_fd_, data + received, max_len - received, 0);
-            
-            if (n < 0) {
-                if (errno == EINTR) {
-                    continue;
+        StartPipelined(routine_id, request_data, request_len, std::move(callback));
+    }
+
+    // Send a tagged request and register its callback with the event loop;
+    // span (if traced) gets the encode and send stages
+    void StartPipelined(uint32_t routine_id,
+                        const uint8_t* request_data, size_t request_len,
+                        RPCCallback callback, trace::Span* span = nullptr) {
+        // Failed callbacks run after the channel mutex is released
+        RPCCallback failed;
+        std::string error;
+        RequestFrame request;
+        {
+            // Only the send is serialized; waiting for the response is not
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (!ConnectLocked()) {
+                error = "Failed to establish connection: " + last_error_;
+                failed = std::move(callback);
+            } else if (!BuildRequest(routine_id, next_request_id_, request_data, request_len,
+                                     request, error, span ? span->trace_id : 0)) {
+                last_error_ = error;
+                failed = std::move(callback);
+            } else {
+                uint32_t request_id = next_request_id_++;
+                if (span) {
+                    span->Mark(trace::ClientStage::Encoded);
                 }
-                if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                    last_error_ = "Receive timeout";
-                    return false;
+
+                // Register before sending: the response may beat us back
+                RegisterCall(request_id, std::move(callback));
+
+                bool sent = SendRequest(request);
+                if (sent && span) {
+                    span->Mark(trace::ClientStage::Sent);
                 }
-                last_error_ = "recv failed: " + std::string(strerror(errno));
-                return false;
-            }
+                if (!sent) {
+                    // Retry once on a fresh connection. The old event loop
+                    // fails whatever is still registered, so take the call
+                    // back first (empty if the loop already failed it).
+                    connected_.store(false);
+                    RPCCallback retry = TakeCall(request_id);
 
-            if (n == 0) {
-                last_error_ = "Connection closed by server";
-                return false;
+                    if (retry && ConnectLocked()) {
+                        RegisterCall(request_id, std::move(retry));
+                        if (!SendRequest(request)) {
+                            connected_.store(false);
+                            retry = TakeCall(request_id);
+                        }
+                    }
+                    if (retry) {
+                        error = "Failed to send after reconnect attempt";
+                        last_error_ = error;
+                        failed = std::move(retry);
+                    }
+                }
             }
+        }
 
-            received += n;
+        if (failed) {
+            failed(false, nullptr, 0, error);
         }
+    }
 
-        // Parse frame length
-        try {
-            ByteBuffer buf(data, received);
-            buf.GetByte(); // START_BYTE
-            uint32_t frame_len = buf.GetInt();
+    bool Subscribe(uint32_t routine_id, const uint8_t* request_data, size_t request_len,
+                   const StreamOptions& options, RPCCallback on_frame, uint32_t& stream_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pipelining_) {
+            last_error_ = "Streams require ChannelOptions::pipelining";
+            return false;
+        }
 
-            // Read remaining data if needed
-            while (received < frame_len && received < max_len) {
-                ssize_t n = recv(socket_fd_, data + received, max_len - received, 0);
-                
-                if (n < 0) {
-                    if (errno == EINTR) {
-                        continue;
-                    }
-                    last_error_ = "recv failed: " + std::string(strerror(errno));
-                    return false;
-                }
+        // The subscription must travel inline: the server keeps its payload
+        std::vector<uint8_t> payload(Protocol::STREAM_SUBSCRIBE_HEADER_SIZE + request_len);
+        if (payload.size() > large_payload_threshold_ ||
+            Protocol::FRAME_HEADER_SIZE + Protocol::REQUEST_ID_SIZE + payload.size() + 1 > Protocol::MAX_PACKET_SIZE) {
+            last_error_ = "Stream request too large";
+            return false;
+        }
+        uint32_t window = std::max<uint32_t>(options.window, 1);
+        ByteBuffer buf(payload.data(), payload.size());
+        buf.PutInt(routine_id);
+        buf.PutInt(options.interval_ms);
+        buf.PutInt(window);
+        if (request_len > 0) {
+            std::memcpy(payload.data() + buf.Position(), request_data, request_len);
+        }
 
-                if (n == 0) {
-                    break;
-                }
+        if (!ConnectLocked()) {
+            last_error_ = "Failed to establish connection: " + last_error_;
+            return false;
+        }
 
-                received += n;
-            }
+        RequestFrame request;
+        if (!BuildRequest(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, next_request_id_, payload.data(), payload.size(),
+                          request, last_error_)) {
+            return false;
+        }
+        stream_id = next_request_id_++;
 
-            return true;
+        // Register before sending: the first frame may beat us back
+        auto stream = std::make_shared<StreamState>();
+        stream->callback = std::move(on_frame);
+        stream->grant_every = std::max<uint32_t>(window / 2, 1);
+        {
+            std::lock_guard<std::mutex> streams_lock(pending_mutex_);
+            streams_[stream_id] = stream;
+        }
 
-        } catch (const std::exception& e) {
-            last_error_ = std::string("Error parsing response: ") + e.what();
-            return false;
+        if (!SendRequest(request)) {
+            // Not resent on a new connection. Take the stream back, unless
+            // the event loop already ended it with the connection error.
+            connected_.store(false);
+            std::lock_guard<std::mutex> streams_lock(pending_mutex_);
+            return streams_.erase(stream_id) == 0;
         }
+        return true;
     }
-};
+
+    bool Unsubscribe(uint32_t stream_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        {
+            std::lock_guard<std::mutex> streams_lock(pending_mutex_);
+            if (streams_.find(stream_id) == streams_.end()) {
+                last_error_ = "Unknown stream";
+                return false;
+            }
+        }
+
+        uint8_t payload[Protocol::STREAM_CANCEL_PAYLOAD_SIZE];
+        ByteBuffer buf(payload, sizeof(payload));
+        buf.PutInt(stream_id);
+        return SendControl(Protocol::STREAM_CANCEL_ROUTINE_ID, payload, sizeof(payload));
+    }
+
+    // Send a frame the server does not answer with its request ID (stream
+    // control); tagged anyway so it never waits behind untagged requests.
+    // Caller holds mutex_.
+    bool SendControl(uint32_t routine_id, const uint8_t* payload, size_t payload_len) {
+        if (!connected_.load() || socket_fd_ < 0) {
+            last_error_ = "Not connected";
+            return false;
+        }
+        RequestFrame request;
+        if (!BuildRequest(routine_id, next_request_id_++, payload, payload_len, request, last_error_)) {
+            return false;
+        }
+        if (!SendRequest(request)) {
+            connected_.store(false);
+            return false;
+        }
+        return true;
+    }
+
+    void RegisterCall(uint32_t request_id, RPCCallback callback) {
+        bool first_deadline;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            first_deadline = deadlines_.empty();
+            pending_calls_[request_id] = std::move(callback);
+            deadlines_.emplace_back(Clock::now() + std::chrono::milliseconds(timeout_ms_), request_id);
+        }
+
+        if (first_deadline) {
+            // Loop may be sleeping without a timeout
+            uint64_t one = 1;
+            ssize_t ret = write(wake_fd_, &one, sizeof(one));
+            (void)ret; // Counter saturation still leaves the loop readable
+        }
+    }
+
+    RPCCallback TakeCall(uint32_t request_id) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        auto it = pending_calls_.find(request_id);
+        if (it == pending_calls_.end()) {
+            return nullptr;
+        }
+        RPCCallback callback = std::move(it->second);
+        pending_calls_.erase(it);
+        return callback;
+    }
+
+    // Event-loop thread (pipelined mode): demultiplex responses by request
+    // ID and expire calls whose deadline passed
+    void EventLoop(int fd, std::shared_ptr<ShmTransport> shm, const CompressionDictionary* dictionary) {
+        FrameParser parser;
+        std::string error;
+
+        // With shared memory the socket only reports the disconnect
+        struct pollfd fds[3];
+        fds[0].fd = fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = wake_fd_;
+        fds[1].events = POLLIN;
+        fds[2].fd = shm ? shm->ResponseEventFd() : -1;
+        fds[2].events = POLLIN;
+        nfds_t nfds = shm ? 3 : 2;
+
+        while (error.empty()) {
+            if (shm) {
+                error = DrainShmResponses(*shm, parser, dictionary);
+                if (!error.empty()) {
+                    break;
+                }
+            }
+
+            int wait_ms = ExpireCalls();
+            if (!SendCreditGrants(fd)) {
+                wait_ms = wait_ms < 0 ? 1 : std::min(wait_ms, 1); // Channel busy: retry shortly
+            }
+
+            int ret = poll(fds, nfds, wait_ms);
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = "poll failed: " + std::string(strerror(errno));
+                break;
+            }
+
+            if (shm) {
+                shm->Responses().SetReaderWaiting(false);
+                if (fds[2].revents & POLLIN) {
+                    ShmTransport::Drain(fds[2].fd);
+                }
+            }
+
+            if (fds[1].revents & POLLIN) {
+                uint64_t count;
+                ssize_t n = read(wake_fd_, &count, sizeof(count));
+                (void)n; // Only used to recompute the poll timeout
+            }
+
+            if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+                error = ReadResponses(fd, parser, dictionary);
+            }
+        }
+
+        connected_.store(false);
+        FailAllCalls(error);
+    }
+
+    // Drain the socket and complete every response; returns an error once
+    // the connection is unusable
+    std::string ReadResponses(int fd, FrameParser& parser, const CompressionDictionary* dictionary) {
+        std::vector<int> stray_fds;
+        while (true) {
+            // Scatter into both free regions of the parser's ring
+            struct iovec iov[2];
+            uint8_t* wrapped = nullptr;
+            iov[0].iov_base = parser.Buffer().WriteRegions(iov[0].iov_len, wrapped, iov[1].iov_len);
+            iov[1].iov_base = wrapped;
+
+            ssize_t n = RecvVectored(fd, iov, iov[1].iov_len > 0 ? 2 : 1, stray_fds, MSG_DONTWAIT);
+            for (int stray : stray_fds) {
+                close(stray); // The server never passes descriptors
+            }
+            stray_fds.clear();
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return std::string();
+                }
+                return "recv failed: " + std::string(strerror(errno));
+            }
+            if (n == 0) {
+                return "Connection closed by server";
+            }
+            parser.Buffer().CommitWrite(static_cast<size_t>(n));
+
+            FrameView frame;
+            FrameParser::Result result;
+            while ((result = parser.Next(frame)) == FrameParser::Result::Frame) {
+                CompleteCall(frame, dictionary);
+            }
+            if (result == FrameParser::Result::Error) {
+                return "Error parsing response: " + parser.GetError();
+            }
+        }
+    }
+
+    // Complete every response waiting in the shared-memory ring, then arm
+    // the doorbell; returns an error once the ring is unusable
+    std::string DrainShmResponses(ShmTransport& shm, FrameParser& parser, const CompressionDictionary* dictionary) {
+        ShmRing& ring = shm.Responses();
+
+        while (true) {
+            std::string error;
+            if (PullShmResponses(shm, parser, error) == 0) {
+                if (!error.empty()) {
+                    return error;
+                }
+                // About to sleep: publish it, then re-check for a racing write
+                ring.SetReaderWaiting(true);
+                if (ring.Empty()) {
+                    return std::string();
+                }
+                ring.SetReaderWaiting(false);
+                continue;
+            }
+
+            FrameView frame;
+            FrameParser::Result result;
+            while ((result = parser.Next(frame)) == FrameParser::Result::Frame) {
+                CompleteCall(frame, dictionary);
+            }
+            if (result == FrameParser::Result::Error) {
+                return "Error parsing response: " + parser.GetError();
+            }
+        }
+    }
+
+    // Move available response bytes from the ring into parser; returns the
+    // number of bytes moved
+    size_t PullShmResponses(ShmTransport& shm, FrameParser& parser, std::string& error) {
+        size_t space = 0;
+        uint8_t* dst = parser.Buffer().WritePtr(space);
+
+        bool corrupt = false;
+        size_t n = shm.Responses().Read(dst, space, corrupt);
+        if (corrupt) {
+            error = "Corrupt shared memory ring";
+            return 0;
+        }
+
+        if (n > 0) {
+            parser.Buffer().CommitWrite(n);
+            if (shm.Responses().WriterWaiting()) {
+                ShmTransport::Notify(shm.RequestEventFd()); // Server waits for this room
+            }
+        }
+        return n;
+    }
+
+    // dictionary: the one the loop's connection negotiated, if any
+    void CompleteCall(const FrameView& frame, const CompressionDictionary* dictionary) {
+        if (!(frame.version & Protocol::FLAG_REQUEST_ID) ||
+            frame.length < Protocol::GetMinFrameSize() + Protocol::REQUEST_ID_SIZE) {
+            return; // Not a pipelined response
+        }
+
+        ByteBuffer header(const_cast<uint8_t*>(frame.data), frame.length);
+        header.SetPosition(Protocol::FRAME_HEADER_SIZE);
+        uint32_t request_id = header.GetInt();
+
+        RPCCallback callback = TakeCall(request_id);
+        std::shared_ptr<StreamState> stream;
+        if (!callback) {
+            stream = FindStream(request_id);
+            if (!stream) {
+                return; // Call already timed out
+            }
+        }
+
+        // Hand back a plain frame: drop the request ID and its flag by
+        // moving only the header over it. The parser owns these bytes
+        // until the next read, and Next() already consumed them.
+        uint8_t* plain = const_cast<uint8_t*>(frame.data) + Protocol::REQUEST_ID_SIZE;
+        size_t length = frame.length - Protocol::REQUEST_ID_SIZE;
+        std::memmove(plain, frame.data, Protocol::FRAME_HEADER_SIZE);
+        ByteBuffer buf(plain, length);
+        buf.SetPosition(1);
+        buf.PutInt(static_cast<uint32_t>(length));
+        plain[Protocol::FRAME_HEADER_SIZE - 1] &= static_cast<uint8_t>(~Protocol::FLAG_REQUEST_ID);
+
+        if (plain[Protocol::FRAME_HEADER_SIZE - 1] & Protocol::FLAG_COMPRESSED) {
+            thread_local uint8_t inflated[Protocol::MAX_PACKET_SIZE];
+            length = InflateFrame(plain, length, inflated, sizeof(inflated), dictionary);
+            if (length == 0) {
+                if (stream) {
+                    stream->callback(false, nullptr, 0, "Corrupt compressed response");
+                } else {
+                    callback(false, nullptr, 0, "Corrupt compressed response");
+                }
+                return;
+            }
+            plain = inflated;
+        }
+
+        if (stream) {
+            DeliverStreamFrame(request_id, *stream, plain, length);
+            return;
+        }
+        if (IsServerBusy(plain, length)) {
+            callback(false, nullptr, 0, "Server busy");
+            return;
+        }
+        callback(true, plain, length, std::string());
+    }
+
+    std::shared_ptr<StreamState> FindStream(uint32_t stream_id) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        auto it = streams_.find(stream_id);
+        return it != streams_.end() ? it->second : nullptr;
+    }
+
+    // Event-loop thread: hand a stream frame to its callback, or end the
+    // stream on STREAM_END; earns the server a credit grant now and then
+    void DeliverStreamFrame(uint32_t stream_id, StreamState& stream, const uint8_t* frame, size_t length) {
+        ByteBuffer header(const_cast<uint8_t*>(frame), length);
+        header.SetPosition(5);
+        if (header.GetInt() == Protocol::STREAM_END_ROUTINE_ID) {
+            uint8_t status = length > Protocol::GetMinFrameSize() ? frame[Protocol::FRAME_HEADER_SIZE] : Protocol::STREAM_FAILED;
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                streams_.erase(stream_id);
+            }
+            const char* reason = status == Protocol::STREAM_CANCELLED ? "Stream cancelled"
+                               : status == Protocol::STREAM_REJECTED  ? "Stream rejected"
+                                                                      : "Stream failed";
+            stream.callback(false, nullptr, 0, reason);
+            return;
+        }
+
+        stream.callback(true, frame, length, std::string());
+
+        if (++stream.consumed >= stream.grant_every) {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            credit_grants_.emplace_back(stream_id, stream.consumed);
+            stream.consumed = 0;
+        }
+    }
+
+    // Send the credits earned so far on the loop's connection; false if the
+    // channel is busy sending and they must wait. Never blocks on mutex_: a
+    // thread holding it may be waiting for this loop to stop.
+    bool SendCreditGrants(int fd) {
+        std::vector<std::pair<uint32_t, uint32_t>> grants;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            if (credit_grants_.empty()) {
+                return true;
+            }
+            grants.swap(credit_grants_);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            std::lock_guard<std::mutex> pending_lock(pending_mutex_);
+            credit_grants_.insert(credit_grants_.end(), grants.begin(), grants.end());
+            return false;
+        }
+        if (socket_fd_ != fd) {
+            return true; // Reconnected meanwhile: the streams died with fd
+        }
+
+        for (const auto& [stream_id, credits] : grants) {
+            uint8_t payload[Protocol::STREAM_CREDIT_PAYLOAD_SIZE];
+            ByteBuffer buf(payload, sizeof(payload));
+            buf.PutInt(stream_id);
+            buf.PutInt(credits);
+            if (!SendControl(Protocol::STREAM_CREDIT_ROUTINE_ID, payload, sizeof(payload))) {
+                break; // The loop sees the broken connection next
+            }
+        }
+        return true;
+    }
+
+    // Fail calls past their deadline; returns the poll timeout until the next one
+    int ExpireCalls() {
+        std::vector<RPCCallback> expired;
+        int wait_ms = -1;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            auto now = Clock::now();
+
+            while (!deadlines_.empty()) {
+                auto [deadline, request_id] = deadlines_.front();
+                auto it = pending_calls_.find(request_id);
+                if (it == pending_calls_.end()) {
+                    deadlines_.pop_front(); // Already completed
+                    continue;
+                }
+                if (deadline > now) {
+                    wait_ms = static_cast<int>(
+                        std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count());
+                    break;
+                }
+                expired.push_back(std::move(it->second));
+                pending_calls_.erase(it);
+                deadlines_.pop_front();
+            }
+        }
+
+        for (auto& callback : expired) {
+            callback(false, nullptr, 0, "Receive timeout");
+        }
+        return wait_ms;
+    }
+
+    void FailAllCalls(const std::string& error) {
+        std::unordered_map<uint32_t, RPCCallback> calls;
+        std::unordered_map<uint32_t, std::shared_ptr<StreamState>> streams;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            calls.swap(pending_calls_);
+            deadlines_.clear();
+            streams.swap(streams_); // Streams end with their connection
+            credit_grants_.clear();
+        }
+
+        for (auto& [id, callback] : calls) {
+            callback(false, nullptr, 0, error);
+        }
+        for (auto& [id, stream] : streams) {
+            stream->callback(false, nullptr, 0, error);
+        }
+    }
+
+    void SetLastError(const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_error_ = error;
+    }
+
+    // Helper: Ensures connection is active (auto-reconnects if needed)
+    bool EnsureConnected() {
+        if (connected_.load() && socket_fd_ >= 0) {
+            return true; // Already connected
+        }
+        
+        // Need to (re)connect
+        return Connect();
+    }
+
+    // Describe a request frame in request. Payloads above the compression
+    // threshold are compressed (request.compressed) if that helps and the
+    // result fits a frame; large payloads otherwise go into a sealed memfd
+    // (request.payload) and the frame only carries their size.
+    // Caller holds mutex_.
+    bool BuildRequest(uint32_t routine_id, std::optional<uint32_t> request_id,
+                      const uint8_t* request_data, size_t request_len,
+                      RequestFrame& request, std::string& error, uint64_t trace_id = 0) {
+        size_t header_len = Protocol::FRAME_HEADER_SIZE + (request_id ? Protocol::REQUEST_ID_SIZE : 0) +
+                            (trace_id ? Protocol::TRACE_ID_SIZE : 0);
+
+        uint8_t version = Protocol::VERSION;
+        if (request_id) {
+            version |= Protocol::FLAG_REQUEST_ID;
+        }
+        if (trace_id) {
+            version |= Protocol::FLAG_TRACE_ID;
+        }
+
+        if (compression_ != Protocol::COMPRESSION_REFUSED && request_len >= compression_threshold_ &&
+            request_len <= Protocol::MAX_DECOMPRESSED_PAYLOAD_SIZE) {
+            request.compressed.resize(Protocol::MAX_PACKET_SIZE - header_len - 1);
+            size_t compressed_len = CompressPayload(request_data, request_len, request.compressed.data(),
+                                                    request.compressed.size(), ActiveDictionary());
+            if (compressed_len > 0) {
+                request.compressed.resize(compressed_len);
+                request_data = request.compressed.data();
+                request_len = compressed_len;
+                version |= Protocol::FLAG_COMPRESSED;
+            } else {
+                request.compressed.clear();
+            }
+        }
+
+        bool large = !(version & Protocol::FLAG_COMPRESSED) &&
+                     (request_len > large_payload_threshold_ ||
+                      header_len + request_len + 1 > Protocol::MAX_PACKET_SIZE);
+
+        if (large) {
+            if (shm_) {
+                error = "Large payloads need the socket transport";
+                return false;
+            }
+            request.payload.fd = CreateSealedPayload(request_data, request_len, error);
+            if (request.payload.fd < 0) {
+                return false;
+            }
+            version |= Protocol::FLAG_FD_PAYLOAD;
+        }
+
+        size_t body_len = large ? Protocol::FD_PAYLOAD_HEADER_SIZE : request_len;
+        ByteBuffer header(request.header, sizeof(request.header));
+        header.PutByte(Protocol::START_BYTE);
+        header.PutInt(static_cast<uint32_t>(header_len + body_len + 1));
+        header.PutInt(routine_id);
+        header.PutByte(version);
+        if (request_id) {
+            header.PutInt(*request_id);
+        }
+        if (trace_id) {
+            header.PutLong(static_cast<int64_t>(trace_id));
+        }
+        if (large) {
+            header.PutInt(static_cast<uint32_t>(request_len));
+        }
+
+        request.iovcnt = 0;
+        request.iov[request.iovcnt].iov_base = request.header;
+        request.iov[request.iovcnt++].iov_len = header.Position();
+        if (!large && request_data && request_len > 0) {
+            request.iov[request.iovcnt].iov_base = const_cast<uint8_t*>(request_data);
+            request.iov[request.iovcnt++].iov_len = request_len;
+        }
+        request.iov[request.iovcnt].iov_base = &request.trailer;
+        request.iov[request.iovcnt++].iov_len = 1;
+        return true;
+    }
+
+    // Send a request and read its response; sent reports whether the
+    // request left (a failed send may be retried on a new connection). A
+    // traced call's span gets the send stage (not seen through io_uring).
+    bool Exchange(const RequestFrame& request, uint8_t* data, size_t max_len, size_t& received, bool& sent,
+                  trace::Span* span = nullptr) {
+        if (ring_ && !shm_ && request.payload.fd < 0) {
+            return ExchangeUring(request, data, max_len, received, sent);
+        }
+        sent = SendRequest(request);
+        if (sent && span) {
+            span->Mark(trace::ClientStage::Sent);
+        }
+        return sent && ReceiveData(data, max_len, received);
+    }
+
+    // One io_uring_enter sends the request and receives the response:
+    // SENDMSG (MSG_WAITALL) -> RECV -> LINK_TIMEOUT are linked, so the
+    // receive starts once the whole request is out and is bounded by
+    // timeout_ms_. The rest of a long response is read with plain recv.
+    bool ExchangeUring(const RequestFrame& request, uint8_t* data, size_t max_len, size_t& received, bool& sent) {
+        received = 0;
+        sent = false;
+
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = const_cast<struct iovec*>(request.iov);
+        msg.msg_iovlen = request.iovcnt;
+        size_t request_len = 0;
+        for (size_t i = 0; i < request.iovcnt; ++i) {
+            request_len += request.iov[i].iov_len;
+        }
+
+        struct __kernel_timespec timeout;
+        timeout.tv_sec = timeout_ms_ / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeout_ms_ % 1000) * 1000000;
+
+        io_uring_sqe* send_sqe = ring_->GetSqe();
+        io_uring_sqe* recv_sqe = ring_->GetSqe();
+        io_uring_sqe* timeout_sqe = ring_->GetSqe();
+        if (!send_sqe || !recv_sqe || !timeout_sqe) {
+            last_error_ = "io_uring submission queue full";
+            return false;
+        }
+        IoUring::PrepSendMsg(send_sqe, socket_fd_, &msg, MSG_NOSIGNAL | MSG_WAITALL, URING_SEND);
+        send_sqe->flags |= IOSQE_IO_LINK;
+        IoUring::PrepRecv(recv_sqe, socket_fd_, data, max_len, 0, URING_RECV);
+        recv_sqe->flags |= IOSQE_IO_LINK;
+        IoUring::PrepLinkTimeout(timeout_sqe, &timeout, URING_TIMEOUT);
+
+        // All three complete (cancelled ones too) before the buffers may go
+        int send_res = -ECANCELED;
+        int recv_res = -ECANCELED;
+        unsigned completed = 0;
+        bool cancelled = false;
+        auto send_deadline = Clock::now() + std::chrono::milliseconds(timeout_ms_);
+
+        while (completed < 3) {
+            int ret = ring_->SubmitAndWait(cancelled ? 1 : 3 - completed, cancelled ? -1 : timeout_ms_);
+            if (ret < 0) {
+                last_error_ = "io_uring_enter failed: " + std::string(strerror(-ret));
+                return false;
+            }
+            ring_->ForEachCompletion([&](const io_uring_cqe& cqe) {
+                if (cqe.user_data == URING_SEND) {
+                    send_res = cqe.res;
+                } else if (cqe.user_data == URING_RECV) {
+                    recv_res = cqe.res;
+                }
+                if (cqe.user_data != URING_CANCEL) {
+                    ++completed;
+                }
+            });
+
+            // The link timeout only bounds the receive; a send into a full
+            // socket is given up like SO_SNDTIMEO would
+            if (completed == 0 && !cancelled && Clock::now() >= send_deadline) {
+                if (io_uring_sqe* sqe = ring_->GetSqe()) {
+                    IoUring::PrepCancelAll(sqe, URING_CANCEL);
+                    cancelled = true;
+                }
+            }
+        }
+
+        if (send_res < 0 || static_cast<size_t>(send_res) != request_len) {
+            last_error_ = send_res < 0 ? "sendmsg failed: " + std::string(strerror(-send_res))
+                                       : "Connection closed by server";
+            return false;
+        }
+        sent = true;
+
+        if (recv_res < 0) {
+            last_error_ = recv_res == -ECANCELED ? "Receive timeout" : "recv failed: " + std::string(strerror(-recv_res));
+            return false;
+        }
+        if (recv_res == 0) {
+            last_error_ = "Connection closed by server";
+            return false;
+        }
+
+        received = static_cast<size_t>(recv_res);
+        return ReceiveSocket(data, max_len, received);
+    }
+
+    // Send a frame, attaching its payload memfd (if any) to the first byte
+    bool SendRequest(const RequestFrame& request) {
+        if (shm_) {
+            return SendShm(request.iov, request.iovcnt);
+        }
+
+        // Advance a copy: a failed send is retried with the same frame
+        struct iovec iov[3];
+        std::copy(request.iov, request.iov + request.iovcnt, iov);
+        struct iovec* next = iov;
+        size_t remaining = request.iovcnt;
+        const int* fds = request.payload.fd >= 0 ? &request.payload.fd : nullptr;
+
+        while (remaining > 0) {
+            ssize_t sent = SendVectored(socket_fd_, next, remaining, fds, fds ? 1 : 0);
+            if (sent < 0) {
+                last_error_ = "sendmsg failed: " + std::string(strerror(errno));
+                return false;
+            }
+            if (sent == 0) {
+                last_error_ = "Connection closed by server";
+                return false;
+            }
+            fds = nullptr;
+            remaining = AdvanceIovec(next, remaining, static_cast<size_t>(sent));
+        }
+
+        return true;
+    }
+
+    // Producer side of the request ring; waits up to timeout_ms_ while it
+    // is full. The server is woken once the whole frame is in the ring.
+    bool SendShm(const struct iovec* iov, size_t iovcnt) {
+        ShmRing& ring = shm_->Requests();
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms_);
+
+        for (size_t i = 0; i < iovcnt; ++i) {
+            const uint8_t* data = static_cast<const uint8_t*>(iov[i].iov_base);
+            size_t len = iov[i].iov_len;
+
+            while (true) {
+                size_t written = ring.Write(data, len);
+                data += written;
+                len -= written;
+                if (len == 0) {
+                    break;
+                }
+
+                // Ring full: make sure the server drains what is there
+                if (ring.ReaderWaiting()) {
+                    ShmTransport::Notify(shm_->RequestEventFd());
+                }
+                if (Clock::now() >= deadline) {
+                    last_error_ = "Shared memory request ring full";
+                    return false;
+                }
+                // The server drains the ring without asking; poll for room
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+        if (ring.ReaderWaiting()) {
+            ShmTransport::Notify(shm_->RequestEventFd());
+        }
+        return true;
+    }
+
+    // Non-pipelined receive over shared memory: one frame from the ring
+    bool ReceiveShm(uint8_t* data, size_t max_len, size_t& received) {
+        ShmRing& ring = shm_->Responses();
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms_);
+        auto spin_until = Clock::now() + std::chrono::microseconds(spin_wait_us_);
+
+        while (true) {
+            FrameView frame;
+            FrameParser::Result result = shm_parser_.Next(frame);
+            if (result == FrameParser::Result::Frame) {
+                if (frame.length > max_len) {
+                    last_error_ = "Response too large for buffer";
+                    return false;
+                }
+                std::memcpy(data, frame.data, frame.length);
+                received = frame.length;
+                return true;
+            }
+            if (result == FrameParser::Result::Error) {
+                last_error_ = "Error parsing response: " + shm_parser_.GetError();
+                return false;
+            }
+
+            std::string error;
+            if (PullShmResponses(*shm_, shm_parser_, error) > 0) {
+                continue;
+            }
+            if (!error.empty()) {
+                last_error_ = error;
+                return false;
+            }
+
+            // Spin-wait: watch the ring without syscalls before sleeping
+            if (spin_wait_us_ > 0 && Clock::now() < spin_until) {
+                CpuRelax();
+                continue;
+            }
+
+            ring.SetReaderWaiting(true);
+            if (!ring.Empty()) {
+                ring.SetReaderWaiting(false);
+                continue;
+            }
+
+            int wait_ms = static_cast<int>(
+                std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count());
+            if (wait_ms <= 0) {
+                last_error_ = "Receive timeout";
+                return false;
+            }
+
+            struct pollfd fds[2];
+            fds[0].fd = shm_->ResponseEventFd();
+            fds[0].events = POLLIN;
+            fds[1].fd = socket_fd_;
+            fds[1].events = POLLIN;
+            int ret = poll(fds, 2, wait_ms);
+            ring.SetReaderWaiting(false);
+
+            if (ret < 0 && errno != EINTR) {
+                last_error_ = "poll failed: " + std::string(strerror(errno));
+                return false;
+            }
+            if (ret > 0 && (fds[0].revents & POLLIN)) {
+                ShmTransport::Drain(fds[0].fd);
+            }
+            if (ret > 0 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+                // Nothing but EOF is expected on the socket now
+                uint8_t byte;
+                ssize_t n = recv(socket_fd_, &byte, 1, MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    last_error_ = "Connection closed by server";
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Blocking recv, preceded by up to spin_wait_us_ of non-blocking ones
+    ssize_t SpinRecv(uint8_t* data, size_t len) {
+        if (spin_wait_us_ > 0) {
+            auto spin_until = Clock::now() + std::chrono::microseconds(spin_wait_us_);
+            do {
+                ssize_t n = recv(socket_fd_, data, len, MSG_DONTWAIT);
+                if (n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    return n;
+                }
+                CpuRelax();
+            } while (Clock::now() < spin_until);
+        }
+        return recv(socket_fd_, data, len, 0);
+    }
+
+    bool ReceiveData(uint8_t* data, size_t max_len, size_t& received) {
+        received = 0;
+
+        if (shm_) {
+            return ReceiveShm(data, max_len, received);
+        }
+        return ReceiveSocket(data, max_len, received);
+    }
+
+    // Read a response frame from the socket after the first `received`
+    // bytes already in data
+    bool ReceiveSocket(uint8_t* data, size_t max_len, size_t& received) {
+        // Read minimum frame size
+        size_t min_size = Protocol::GetMinFrameSize();
+        while (received < min_size) {
+            ssize_t n = SpinRecv(data + received, max_len - received);
+            
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    last_error_ = "Receive timeout";
+                    return false;
+                }
+                last_error_ = "recv failed: " + std::string(strerror(errno));
+                return false;
+            }
+
+            if (n == 0) {
+                last_error_ = "Connection closed by server";
+                return false;
+            }
+
+            received += n;
+        }
+
+        // Parse frame length
+        try {
+            ByteBuffer buf(data, received);
+            buf.GetByte(); // START_BYTE
+            uint32_t frame_len = buf.GetInt();
+
+            // Read remaining data if needed
+            while (received < frame_len && received < max_len) {
+                ssize_t n = SpinRecv(data + received, max_len - received);
+                
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    last_error_ = "recv failed: " + std::string(strerror(errno));
+                    return false;
+                }
+
+                if (n == 0) {
+                    break;
+                }
+
+                received += n;
+            }
+
+            return true;
+
+        } catch (const std::exception& e) {
+            last_error_ = std::string("Error parsing response: ") + e.what();
+            return false;
+        }
+    }
+};
 
 // Public interface implementation
 Channel::Channel(const std::string& socket_path, int timeout_ms)
-    : pImpl_(std::make_unique<Impl>(socket_path, timeout_ms)) {
+    : Channel(socket_path, ChannelOptions{timeout_ms, false}) {
+}
+
+Channel::Channel(const std::string& socket_path, const ChannelOptions& options)
+    : pImpl_(std::make_unique<Impl>(socket_path, options)) {
     // Auto-connect on construction
     // Note: If initial connection fails, it will auto-retry on first API call
     pImpl_->Connect();
@@ -319,15 +1699,125 @@ bool Channel::ExecuteRPC(uint32_t routine_id,
                               response_buffer, response_buffer_size, response_len);
 }
 
+bool Channel::ExecuteBatch(const std::vector<BatchCall>& calls, std::vector<RPCResponse>& responses) {
+    responses.clear();
+    responses.reserve(calls.size());
+
+    // Largest payload that still fits a frame with the request and trace ID extensions
+    const size_t max_payload = Protocol::MAX_PACKET_SIZE - Protocol::GetMinFrameSize()
+                               - Protocol::REQUEST_ID_SIZE - Protocol::TRACE_ID_SIZE - 1;
+    std::vector<uint8_t> request(max_payload);
+    std::vector<uint8_t> response(Protocol::MAX_PACKET_SIZE);
+
+    size_t next = 0;
+    while (next < calls.size()) {
+        // Pack as many calls as fit into one batch frame
+        ByteBuffer request_buf(request.data(), request.size());
+        request_buf.PutInt(0); // Placeholder for count
+
+        uint32_t count = 0;
+        while (next < calls.size() && count < Protocol::MAX_BATCH_CALLS &&
+               request_buf.Position() + BATCH_ENTRY_HEADER_SIZE + calls[next].request_len <= max_payload) {
+            const BatchCall& call = calls[next];
+            request_buf.PutInt(call.routine_id);
+            request_buf.PutInt(static_cast<uint32_t>(call.request_len));
+            if (call.request_len > 0) {
+                std::memcpy(request.data() + request_buf.Position(), call.request_data, call.request_len);
+                request_buf.SetPosition(request_buf.Position() + call.request_len);
+            }
+            ++next;
+            ++count;
+        }
+
+        if (count == 0) {
+            pImpl_->SetLastError("Batch call payload too large");
+            return false;
+        }
+
+        size_t request_len = request_buf.Position();
+        request_buf.SetPosition(0);
+        request_buf.PutInt(count);
+
+        size_t response_len = 0;
+        if (!ExecuteRPC(Protocol::BATCH_REQUEST_ROUTINE_ID, request.data(), request_len,
+                        response.data(), response.size(), response_len)) {
+            return false;
+        }
+
+        if (!ParseBatchResponse(response.data(), response_len, count, responses)) {
+            pImpl_->SetLastError("Malformed batch response");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::future<RPCResponse> Channel::ExecuteRPCAsync(uint32_t routine_id,
+                                                  const uint8_t* request_data, size_t request_len) {
+    auto promise = std::make_shared<std::promise<RPCResponse>>();
+    std::future<RPCResponse> future = promise->get_future();
+
+    pImpl_->ExecuteAsync(routine_id, request_data, request_len,
+        [promise](bool success, const uint8_t* response, size_t response_len, const std::string& error) {
+            RPCResponse result;
+            result.success = success;
+            if (success) {
+                result.frame.assign(response, response + response_len);
+            } else {
+                result.error_message = error;
+            }
+            promise->set_value(std::move(result));
+        });
+
+    return future;
+}
+
+void Channel::ExecuteRPCAsync(uint32_t routine_id,
+                              const uint8_t* request_data, size_t request_len,
+                              RPCCallback callback) {
+    if (!callback) {
+        throw std::invalid_argument("Channel: callback cannot be empty");
+    }
+    pImpl_->ExecuteAsync(routine_id, request_data, request_len, std::move(callback));
+}
+
+bool Channel::Subscribe(uint32_t routine_id,
+                        const uint8_t* request_data, size_t request_len,
+                        const StreamOptions& options, RPCCallback on_frame,
+                        uint32_t& stream_id) {
+    if (!on_frame) {
+        throw std::invalid_argument("Channel: stream callback cannot be empty");
+    }
+    return pImpl_->Subscribe(routine_id, request_data, request_len, options, std::move(on_frame), stream_id);
+}
+
+bool Channel::Unsubscribe(uint32_t stream_id) {
+    return pImpl_->Unsubscribe(stream_id);
+}
+
 bool Channel::IsConnected() const {
     return pImpl_->connected_.load();
 }
 
+bool Channel::IsPipelined() const {
+    return pImpl_->pipelining_;
+}
+
+bool Channel::IsSharedMemoryActive() const {
+    std::lock_guard<std::mutex> lock(pImpl_->mutex_);
+    return pImpl_->connected_.load() && pImpl_->shm_ != nullptr;
+}
+
 std::string Channel::GetLastError() const {
     std::lock_guard<std::mutex> lock(pImpl_->mutex_);
     return pImpl_->last_error_;
 }
 
+bool Channel::CheckConnection() {
+    return pImpl_->CheckConnection();
+}
+
 void Channel::Disconnect() {
     pImpl_->Disconnect();
 }
@@ -0,0 +1,159 @@
+/**
+ * @file ChannelPool.cpp
+ * @brief Implementation of ChannelPool (part of shared library)
+ */
+
+#include "ipc_sync/ChannelPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ipc_demo {
+
+namespace {
+
+std::atomic<uint64_t> next_pool_id{1};
+
+// Channel a thread was given by each pool it used, most recent first. The
+// entries die with the thread; a thread juggling more pools than this gets
+// a fresh channel from the pool it used longest ago.
+constexpr size_t AFFINITY_CACHE_SIZE = 8;
+
+struct Affinity {
+    uint64_t pool_id;
+    size_t channel;
+};
+
+size_t DefaultPoolSize() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+// Private implementation (hidden from client)
+struct ChannelPool::Impl {
+    const uint64_t id_;
+    std::vector<std::shared_ptr<Channel>> channels_;  // Fixed after construction
+
+    std::atomic<size_t> next_channel_{0};  // Round-robin for threads new to the pool
+
+    // Health checks
+    std::chrono::milliseconds health_check_interval_;
+    std::mutex health_mutex_;
+    std::condition_variable health_cv_;
+    bool stopping_{false};
+    std::thread health_thread_;
+
+    Impl(const std::string& socket_path, const ChannelPoolOptions& options)
+        : id_(next_pool_id.fetch_add(1))
+        , health_check_interval_(options.health_check_interval_ms) {
+        if (options.health_check_interval_ms < 0) {
+            throw std::invalid_argument("ChannelPool: health_check_interval_ms must be >= 0");
+        }
+
+        size_t size = options.size > 0 ? options.size : DefaultPoolSize();
+        channels_.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            channels_.push_back(std::make_shared<Channel>(socket_path, options.channel));
+        }
+
+        if (health_check_interval_.count() > 0) {
+            health_thread_ = std::thread(&Impl::HealthLoop, this);
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(health_mutex_);
+            stopping_ = true;
+        }
+        health_cv_.notify_all();
+        if (health_thread_.joinable()) {
+            health_thread_.join();
+        }
+    }
+
+    const std::shared_ptr<Channel>& Get() {
+        thread_local std::vector<Affinity> affinity;
+        if (!affinity.empty() && affinity.front().pool_id == id_) {
+            return channels_[affinity.front().channel];
+        }
+
+        // First call from this thread (or it last used another pool)
+        auto it = std::find_if(affinity.begin(), affinity.end(),
+                               [this](const Affinity& entry) { return entry.pool_id == id_; });
+        Affinity entry;
+        if (it != affinity.end()) {
+            entry = *it;
+            affinity.erase(it);
+        } else {
+            entry = Affinity{id_, next_channel_.fetch_add(1, std::memory_order_relaxed) % channels_.size()};
+            if (affinity.size() == AFFINITY_CACHE_SIZE) {
+                affinity.pop_back();
+            }
+        }
+        affinity.insert(affinity.begin(), entry);
+        return channels_[entry.channel];
+    }
+
+    size_t ConnectedCount() const {
+        return static_cast<size_t>(std::count_if(channels_.begin(), channels_.end(),
+            [](const std::shared_ptr<Channel>& channel) { return channel->IsConnected(); }));
+    }
+
+    size_t CheckConnections() {
+        size_t connected = 0;
+        for (const auto& channel : channels_) {
+            if (channel->CheckConnection()) {
+                ++connected;
+            }
+        }
+        return connected;
+    }
+
+    void HealthLoop() {
+        std::unique_lock<std::mutex> lock(health_mutex_);
+        while (!health_cv_.wait_for(lock, health_check_interval_, [this]() { return stopping_; })) {
+            lock.unlock();
+            CheckConnections();
+            lock.lock();
+        }
+    }
+};
+
+// Public interface implementation
+ChannelPool::ChannelPool(const std::string& socket_path, const ChannelPoolOptions& options)
+    : pImpl_(std::make_unique<Impl>(socket_path, options)) {
+}
+
+ChannelPool::~ChannelPool() = default;
+
+const std::shared_ptr<Channel>& ChannelPool::Get() {
+    return pImpl_->Get();
+}
+
+const std::shared_ptr<Channel>& ChannelPool::At(size_t index) const {
+    if (index >= pImpl_->channels_.size()) {
+        throw std::out_of_range("ChannelPool: channel index out of range");
+    }
+    return pImpl_->channels_[index];
+}
+
+size_t ChannelPool::Size() const {
+    return pImpl_->channels_.size();
+}
+
+size_t ChannelPool::ConnectedCount() const {
+    return pImpl_->ConnectedCount();
+}
+
+size_t ChannelPool::CheckConnections() {
+    return pImpl_->CheckConnections();
+}
+
+} // namespace ipc_demo
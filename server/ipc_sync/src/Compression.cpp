@@ -0,0 +1,284 @@
+/**
+ * @file Compression.cpp
+ * @brief Implementation of the LZ4 block codec and payload framing
+ */
+
+#include "ipc_sync/Compression.hpp"
+#include "ipc_sync/ByteOrder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace ipc_demo {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;    // A block always ends with this many literals
+constexpr size_t MFLIMIT = 12;         // The last match starts at least this far from the end
+constexpr size_t MAX_OFFSET = 65535;
+constexpr size_t SKIP_STRENGTH = 6;    // Incompressible input is scanned with growing steps
+constexpr size_t ORIGINAL_LEN_SIZE = 4;
+
+using HashTable = std::array<uint32_t, size_t(1) << CompressionDictionary::HASH_LOG>;
+
+uint32_t Load32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - CompressionDictionary::HASH_LOG);
+}
+
+// Length continuation bytes after a token nibble of 15
+void PutLength(uint8_t* dst, size_t& op, size_t length) {
+    while (length >= 255) {
+        dst[op++] = 255;
+        length -= 255;
+    }
+    dst[op++] = static_cast<uint8_t>(length);
+}
+
+bool GetLength(const uint8_t* src, size_t len, size_t& ip, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= len) {
+            return false;
+        }
+        byte = src[ip++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// One sequence: literals, then a match unless match_len is 0 (last sequence)
+bool EmitSequence(const uint8_t* literals, size_t literal_len, size_t offset, size_t match_len,
+                  uint8_t* dst, size_t capacity, size_t& op) {
+    size_t worst = 1 + literal_len / 255 + 1 + literal_len + 2 + match_len / 255 + 1;
+    if (worst > capacity - op) {
+        return false;
+    }
+
+    uint8_t* token = dst + op++;
+    uint8_t nibbles = 0;
+    if (literal_len >= 15) {
+        nibbles = 15 << 4;
+        PutLength(dst, op, literal_len - 15);
+    } else {
+        nibbles = static_cast<uint8_t>(literal_len << 4);
+    }
+    std::memcpy(dst + op, literals, literal_len);
+    op += literal_len;
+
+    if (match_len > 0) {
+        dst[op++] = static_cast<uint8_t>(offset);
+        dst[op++] = static_cast<uint8_t>(offset >> 8);
+        size_t extra = match_len - MIN_MATCH;
+        if (extra >= 15) {
+            nibbles |= 15;
+            PutLength(dst, op, extra - 15);
+        } else {
+            nibbles |= static_cast<uint8_t>(extra);
+        }
+    }
+    *token = nibbles;
+    return true;
+}
+
+} // namespace
+
+CompressionDictionary::CompressionDictionary(std::string_view content) {
+    if (content.empty()) {
+        throw std::invalid_argument("CompressionDictionary: content cannot be empty");
+    }
+    if (content.size() > MAX_SIZE) {
+        content.remove_prefix(content.size() - MAX_SIZE); // Matches reach back at most MAX_SIZE
+    }
+    bytes_.assign(content.begin(), content.end());
+
+    // FNV-1a; 0 means "no dictionary" on the wire
+    id_ = 2166136261u;
+    for (uint8_t byte : bytes_) {
+        id_ = (id_ ^ byte) * 16777619u;
+    }
+    if (id_ == 0) {
+        id_ = 1;
+    }
+
+    // Entries are position + 1, later positions win; 0 is empty
+    table_.fill(0);
+    for (size_t p = 0; p + MIN_MATCH <= bytes_.size(); ++p) {
+        table_[Hash(Load32(bytes_.data() + p))] = static_cast<uint32_t>(p + 1);
+    }
+}
+
+namespace lz4 {
+
+size_t Compress(const uint8_t* src, size_t len, uint8_t* dst, size_t capacity,
+                const CompressionDictionary* dictionary) {
+    // Positions are virtual: the dictionary, then src
+    const uint8_t* dict = dictionary ? dictionary->Data() : nullptr;
+    size_t dict_len = dictionary ? dictionary->Size() : 0;
+
+    HashTable table;
+    if (dictionary) {
+        table = dictionary->Table();
+    } else {
+        table.fill(0);
+    }
+
+    size_t op = 0;
+    size_t anchor = 0;
+    if (len > MFLIMIT) {
+        size_t ip = 0;
+        size_t match_end_limit = len - LAST_LITERALS;
+        size_t misses = 0;
+
+        while (ip <= len - MFLIMIT) {
+            uint32_t sequence = Load32(src + ip);
+            uint32_t hash = Hash(sequence);
+            size_t current = dict_len + ip;
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(current + 1);
+
+            if (candidate != 0 && current - (candidate - 1) <= MAX_OFFSET) {
+                size_t position = candidate - 1;
+                const uint8_t* match;
+                size_t max_len = match_end_limit - ip;
+                if (position < dict_len) {
+                    // Dictionary matches stop at its end
+                    match = dict + position;
+                    max_len = std::min(max_len, dict_len - position);
+                } else {
+                    match = src + (position - dict_len);
+                }
+
+                if (max_len >= MIN_MATCH && Load32(match) == sequence) {
+                    size_t match_len = MIN_MATCH;
+                    while (match_len < max_len && src[ip + match_len] == match[match_len]) {
+                        ++match_len;
+                    }
+                    if (!EmitSequence(src + anchor, ip - anchor, current - position, match_len, dst, capacity, op)) {
+                        return 0;
+                    }
+                    ip += match_len;
+                    anchor = ip;
+                    misses = 0;
+                    continue;
+                }
+            }
+            ip += 1 + (misses++ >> SKIP_STRENGTH);
+        }
+    }
+
+    if (!EmitSequence(src + anchor, len - anchor, 0, 0, dst, capacity, op)) {
+        return 0;
+    }
+    return op;
+}
+
+bool Decompress(const uint8_t* src, size_t len, uint8_t* dst, size_t dst_len,
+                const CompressionDictionary* dictionary) {
+    const uint8_t* dict = dictionary ? dictionary->Data() : nullptr;
+    size_t dict_len = dictionary ? dictionary->Size() : 0;
+
+    size_t ip = 0;
+    size_t op = 0;
+    while (true) {
+        if (ip >= len) {
+            return false;
+        }
+        uint8_t token = src[ip++];
+
+        size_t literal_len = token >> 4;
+        if (literal_len == 15 && !GetLength(src, len, ip, literal_len)) {
+            return false;
+        }
+        if (literal_len > len - ip || literal_len > dst_len - op) {
+            return false;
+        }
+        std::memcpy(dst + op, src + ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        if (ip == len) {
+            return op == dst_len; // Last sequence: literals only
+        }
+
+        if (len - ip < 2) {
+            return false;
+        }
+        size_t offset = src[ip] | (static_cast<size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op + dict_len) {
+            return false;
+        }
+
+        size_t match_len = token & 15;
+        if (match_len == 15 && !GetLength(src, len, ip, match_len)) {
+            return false;
+        }
+        match_len += MIN_MATCH;
+        if (match_len > dst_len - op) {
+            return false;
+        }
+
+        if (offset > op) {
+            // Starts in the dictionary, may run on into the output
+            size_t back = offset - op;
+            size_t from_dict = std::min(back, match_len);
+            std::memcpy(dst + op, dict + dict_len - back, from_dict);
+            op += from_dict;
+            match_len -= from_dict;
+        }
+
+        uint8_t* out = dst + op;
+        const uint8_t* match = out - offset;
+        if (offset >= match_len) {
+            std::memcpy(out, match, match_len);
+        } else {
+            for (size_t i = 0; i < match_len; ++i) {
+                out[i] = match[i]; // Overlapping: repeats the last offset bytes
+            }
+        }
+        op += match_len;
+    }
+}
+
+} // namespace lz4
+
+size_t CompressPayload(const uint8_t* payload, size_t len, uint8_t* out, size_t capacity,
+                       const CompressionDictionary* dictionary) {
+    // Only worth it if the result, with its length prefix, is smaller
+    if (len <= ORIGINAL_LEN_SIZE + 1 || capacity <= ORIGINAL_LEN_SIZE || len > UINT32_MAX) {
+        return 0;
+    }
+    size_t block_capacity = std::min(capacity - ORIGINAL_LEN_SIZE, len - ORIGINAL_LEN_SIZE - 1);
+
+    size_t block_len = lz4::Compress(payload, len, out + ORIGINAL_LEN_SIZE, block_capacity, dictionary);
+    if (block_len == 0) {
+        return 0;
+    }
+    byte_order::StoreBigEndian<uint32_t>(out, static_cast<uint32_t>(len));
+    return ORIGINAL_LEN_SIZE + block_len;
+}
+
+size_t CompressedPayloadSize(const uint8_t* encoded, size_t len) {
+    return len < ORIGINAL_LEN_SIZE ? 0 : byte_order::LoadBigEndian<uint32_t>(encoded);
+}
+
+size_t DecompressPayload(const uint8_t* encoded, size_t len, uint8_t* out, size_t capacity,
+                         const CompressionDictionary* dictionary) {
+    size_t original_len = CompressedPayloadSize(encoded, len);
+    if (original_len == 0 || original_len > capacity) {
+        return 0;
+    }
+    if (!lz4::Decompress(encoded + ORIGINAL_LEN_SIZE, len - ORIGINAL_LEN_SIZE, out, original_len, dictionary)) {
+        return 0;
+    }
+    return original_len;
+}
+
+} // namespace ipc_demo
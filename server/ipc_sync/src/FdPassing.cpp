@@ -0,0 +1,116 @@
+/**
+ * @file FdPassing.cpp
+ * @brief Implementation of SCM_RIGHTS helpers
+ */
+
+#include "ipc_sync/FdPassing.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace ipc_demo {
+
+ssize_t SendVectored(int socket_fd, const struct iovec* iov, size_t iovcnt,
+                     const int* fds, size_t fd_count) {
+    if (fd_count > MAX_PASSED_FDS) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+    std::memset(control, 0, sizeof(control));
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = const_cast<struct iovec*>(iov);
+    msg.msg_iovlen = iovcnt;
+
+    if (fd_count > 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+        std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_count);
+    }
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent;
+}
+
+ssize_t RecvVectored(int socket_fd, struct iovec* iov, size_t iovcnt,
+                     std::vector<int>& fds, int flags) {
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(socket_fd, &msg, flags | MSG_CMSG_CLOEXEC);
+    if (received < 0) {
+        return received;
+    }
+
+    CollectPassedFds(msg, fds);
+    return received;
+}
+
+void CollectPassedFds(const struct msghdr& msg, std::vector<int>& fds) {
+    struct msghdr& header = const_cast<struct msghdr&>(msg); // CMSG_NXTHDR takes a non-const pointer
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; ++i) {
+            int fd;
+            std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            fds.push_back(fd);
+        }
+    }
+}
+
+size_t AdvanceIovec(struct iovec*& iov, size_t iovcnt, size_t bytes) {
+    while (iovcnt > 0 && bytes >= iov->iov_len) {
+        bytes -= iov->iov_len;
+        ++iov;
+        --iovcnt;
+    }
+    if (iovcnt > 0) {
+        iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + bytes;
+        iov->iov_len -= bytes;
+    }
+    return iovcnt;
+}
+
+ssize_t SendWithFds(int socket_fd, const uint8_t* data, size_t len,
+                    const int* fds, size_t fd_count) {
+    if (len == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data);
+    iov.iov_len = len;
+    return SendVectored(socket_fd, &iov, 1, fds, fd_count);
+}
+
+ssize_t RecvWithFds(int socket_fd, uint8_t* data, size_t len,
+                    std::vector<int>& fds, int flags) {
+    struct iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = len;
+    return RecvVectored(socket_fd, &iov, 1, fds, flags);
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,123 @@
+/**
+ * @file FrameParser.cpp
+ * @brief Implementation of FrameParser
+ */
+
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/BufferPool.hpp"
+#include <arpa/inet.h> // For ntohl (network byte order)
+#include <cstring>
+#include <stdexcept>
+
+namespace ipc_demo {
+
+namespace {
+
+// START(1) + LENGTH(4) + ROUTINE_ID(4) + VERSION(1)
+constexpr size_t HEADER_SIZE = 10;
+
+uint32_t ReadNetworkInt(const uint8_t* data) {
+    uint32_t net_value;
+    std::memcpy(&net_value, data, sizeof(net_value));
+    return ntohl(net_value);
+}
+
+} // namespace
+
+FrameParser::FrameParser(size_t max_frame_size)
+    : max_frame_size_(max_frame_size)
+    , ring_(max_frame_size * 2) {
+}
+
+FrameParser::FrameParser(BufferPool& pool, size_t max_frame_size)
+    : max_frame_size_(max_frame_size)
+    , ring_(pool)
+    , pool_(&pool) {
+    if (pool.BlockSize() < max_frame_size * 2) {
+        throw std::invalid_argument("FrameParser: pool blocks must hold two maximum-size frames");
+    }
+}
+
+FrameParser::~FrameParser() {
+    ReleaseScratch();
+}
+
+FrameParser::Result FrameParser::Next(FrameView& frame) {
+    // Release the frame handed out by the previous call
+    ring_.Consume(pending_consume_);
+    pending_consume_ = 0;
+    ReleaseScratch();
+
+    if (!error_.empty()) {
+        return Result::Error;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    if (!ring_.Peek(0, header, sizeof(header))) {
+        return Result::NeedMore;
+    }
+
+    if (header[0] != Protocol::START_BYTE) {
+        error_ = "Invalid start byte";
+        return Result::Error;
+    }
+
+    uint32_t frame_len = ReadNetworkInt(header + 1);
+    if (frame_len < Protocol::GetMinFrameSize() || frame_len > max_frame_size_) {
+        error_ = "Invalid frame length: " + std::to_string(frame_len);
+        return Result::Error;
+    }
+
+    if (ring_.Size() < frame_len) {
+        return Result::NeedMore;
+    }
+
+    const uint8_t* data = ring_.ReadPtr(frame_len);
+    if (data == nullptr) {
+        data = Linearize(frame_len); // Frame wraps around the end of the ring
+    }
+
+    if (data[frame_len - 1] != Protocol::END_BYTE) {
+        error_ = "Missing end byte";
+        return Result::Error;
+    }
+
+    frame.data = data;
+    frame.length = frame_len;
+    frame.routine_id = ReadNetworkInt(header + 5);
+    frame.version = header[9];
+    frame.payload = data + HEADER_SIZE;
+    frame.payload_len = frame_len - HEADER_SIZE - 1;
+
+    pending_consume_ = frame_len;
+    return Result::Frame;
+}
+
+void FrameParser::Reset() {
+    ring_.Clear();
+    ReleaseScratch();
+    pending_consume_ = 0;
+    error_.clear();
+}
+
+const uint8_t* FrameParser::Linearize(size_t len) {
+    uint8_t* copy;
+    if (pool_) {
+        pooled_scratch_ = pool_->Acquire();
+        copy = pooled_scratch_;
+    } else {
+        scratch_.resize(len);
+        copy = scratch_.data();
+    }
+    ring_.Peek(0, copy, len);
+    return copy;
+}
+
+void FrameParser::ReleaseScratch() {
+    if (pooled_scratch_) {
+        pool_->Release(pooled_scratch_);
+        pooled_scratch_ = nullptr;
+    }
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,316 @@
+/**
+ * @file IoUring.cpp
+ * @brief Implementation of IoUring (part of shared library)
+ */
+
+#include "ipc_sync/IoUring.hpp"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+namespace ipc_demo {
+
+namespace {
+
+// Kernel feature bit from 6.3: the kernel also has multishot recvmsg (6.0),
+// multishot accept and provided buffer rings (5.19). Older uapi headers
+// lack the name.
+constexpr unsigned FEAT_REG_REG_RING = 1U << 13;
+constexpr unsigned REQUIRED_FEATURES = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                                       IORING_FEAT_FAST_POLL | IORING_FEAT_EXT_ARG | FEAT_REG_REG_RING;
+
+void PrepRw(io_uring_sqe* sqe, uint8_t opcode, int fd, uint64_t addr, uint32_t len, uint64_t user_data) {
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+void* MapRegion(size_t size, int fd, off_t offset) {
+    int flags = (fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS) | MAP_POPULATE;
+    void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, offset);
+    return region == MAP_FAILED ? nullptr : region;
+}
+
+} // namespace
+
+bool IoUring::IsSupported() {
+    static const bool supported = []() {
+        std::string error;
+        return Create(2, error) != nullptr;
+    }();
+    return supported;
+}
+
+std::unique_ptr<IoUring> IoUring::Create(unsigned entries, std::string& error) {
+    std::unique_ptr<IoUring> ring(new IoUring());
+    if (!ring->Setup(entries, error)) {
+        return nullptr;
+    }
+    return ring;
+}
+
+bool IoUring::Setup(unsigned entries, std::string& error) {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    // Completions run when we enter the kernel anyway; multishot requests
+    // post many CQEs per SQE, so the CQ gets extra room
+    params.flags = IORING_SETUP_CLAMP | IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SUBMIT_ALL;
+    params.cq_entries = entries * 8;
+
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+        error = "io_uring_setup failed: " + std::string(strerror(errno));
+        return false;
+    }
+
+    features_ = params.features;
+    if ((features_ & REQUIRED_FEATURES) != REQUIRED_FEATURES) {
+        error = "io_uring lacks required features (kernel 6.3 or later needed)";
+        return false;
+    }
+
+    // One mapping holds both rings (IORING_FEAT_SINGLE_MMAP)
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sq_ring_size_ = sq_size > cq_size ? sq_size : cq_size;
+    sq_ring_ = MapRegion(sq_ring_size_, ring_fd_, IORING_OFF_SQ_RING);
+    if (!sq_ring_) {
+        error = "mmap of io_uring rings failed: " + std::string(strerror(errno));
+        return false;
+    }
+    cq_ring_ = sq_ring_;
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(MapRegion(sqes_size_, ring_fd_, IORING_OFF_SQES));
+    if (!sqes_) {
+        error = "mmap of io_uring SQEs failed: " + std::string(strerror(errno));
+        return false;
+    }
+
+    auto* sq = static_cast<uint8_t*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sqe_tail_ = *sq_tail_;
+
+    // SQE i always sits in array slot i
+    auto* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < sq_entries_; ++i) {
+        array[i] = i;
+    }
+
+    auto* cq = static_cast<uint8_t*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+IoUring::~IoUring() {
+    if (buffers_) {
+        munmap(buffers_, buffers_size_);
+    }
+    if (buf_ring_) {
+        munmap(buf_ring_, buf_ring_size_);
+    }
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+    }
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_size_);
+    }
+    if (ring_fd_ >= 0) {
+        close(ring_fd_); // Also cancels whatever is still in flight
+    }
+}
+
+io_uring_sqe* IoUring::GetSqe() {
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_) {
+        Submit();
+        head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sqe_tail_ - head >= sq_entries_) {
+            return nullptr;
+        }
+    }
+
+    io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+    ++sqe_tail_;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+unsigned IoUring::Publish() {
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    return sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+int IoUring::Enter(unsigned to_submit, unsigned wait_nr, unsigned flags, const void* arg, size_t arg_size) {
+    int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, wait_nr, flags, arg, arg_size));
+    if (ret >= 0) {
+        return ret;
+    }
+    if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN) {
+        return 0; // Nothing (more) to do now; EBUSY: reap completions first
+    }
+    return -errno;
+}
+
+int IoUring::Submit() {
+    unsigned to_submit = Publish();
+    if (to_submit == 0) {
+        return 0;
+    }
+    return Enter(to_submit, 0, 0, nullptr, 0);
+}
+
+int IoUring::SubmitAndWait(unsigned wait_nr, int timeout_ms) {
+    unsigned to_submit = Publish();
+    unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    if (timeout_ms < 0 || wait_nr == 0) {
+        return Enter(to_submit, wait_nr, flags, nullptr, 0);
+    }
+
+    struct __kernel_timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+
+    struct io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    return Enter(to_submit, wait_nr, flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+bool IoUring::SetupBufferRing(uint16_t group, unsigned count, unsigned buffer_size, std::string& error) {
+    if (buf_ring_) {
+        error = "Buffer ring already registered";
+        return false;
+    }
+    if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || buffer_size == 0) {
+        error = "Invalid buffer ring geometry";
+        return false;
+    }
+
+    buf_ring_size_ = count * sizeof(io_uring_buf);
+    buf_ring_ = static_cast<io_uring_buf*>(MapRegion(buf_ring_size_, -1, 0));
+    buffers_size_ = static_cast<size_t>(count) * buffer_size;
+    buffers_ = static_cast<uint8_t*>(MapRegion(buffers_size_, -1, 0));
+    if (!buf_ring_ || !buffers_) {
+        error = "mmap of provided buffers failed: " + std::string(strerror(errno));
+        return false;
+    }
+
+    struct io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    reg.ring_entries = count;
+    reg.bgid = group;
+    if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        error = "Registering provided buffers failed: " + std::string(strerror(errno));
+        return false;
+    }
+
+    buffer_size_ = buffer_size;
+    buf_mask_ = count - 1;
+    buf_group_ = group;
+    for (unsigned i = 0; i < count; ++i) {
+        RecycleBuffer(static_cast<uint16_t>(i));
+    }
+    return true;
+}
+
+void IoUring::RecycleBuffer(uint16_t buffer_id) {
+    // Only addr/len/bid: slot 0's resv field is the ring tail. The ring is
+    // addressed as a plain array because io_uring_buf_ring's flexible
+    // array member lands at offset 8 when the uapi header is compiled as C++
+    io_uring_buf& buf = buf_ring_[buf_tail_ & buf_mask_];
+    buf.addr = reinterpret_cast<uint64_t>(Buffer(buffer_id));
+    buf.len = buffer_size_;
+    buf.bid = buffer_id;
+    ++buf_tail_;
+    __atomic_store_n(&buf_ring_[0].resv, buf_tail_, __ATOMIC_RELEASE);
+}
+
+bool IoUring::ParseRecvMsg(const uint8_t* data, size_t len, const struct msghdr& msg, RecvMsg& out) {
+    struct io_uring_recvmsg_out header;
+    size_t offset = sizeof(header) + msg.msg_namelen + msg.msg_controllen;
+    if (len < offset) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.controllen > msg.msg_controllen) {
+        return false;
+    }
+
+    std::memset(&out.control, 0, sizeof(out.control));
+    out.control.msg_control = const_cast<uint8_t*>(data + sizeof(header) + msg.msg_namelen);
+    out.control.msg_controllen = header.controllen;
+    out.payload = data + offset;
+    out.payload_len = len - offset;
+    return true;
+}
+
+void IoUring::PrepPollMultishot(io_uring_sqe* sqe, int fd, uint32_t events, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_POLL_ADD, fd, 0, IORING_POLL_ADD_MULTI, user_data);
+    sqe->poll32_events = events;
+}
+
+void IoUring::PrepRecvMsgMultishot(io_uring_sqe* sqe, int fd, struct msghdr* msg, uint16_t group,
+                                   unsigned flags, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_RECVMSG, fd, reinterpret_cast<uint64_t>(msg), 1, user_data);
+    sqe->msg_flags = flags;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = group;
+}
+
+void IoUring::PrepRecv(io_uring_sqe* sqe, int fd, void* data, size_t len, unsigned flags, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_RECV, fd, reinterpret_cast<uint64_t>(data), static_cast<uint32_t>(len), user_data);
+    sqe->msg_flags = flags;
+}
+
+void IoUring::PrepSend(io_uring_sqe* sqe, int fd, const void* data, size_t len, unsigned flags,
+                       uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_SEND, fd, reinterpret_cast<uint64_t>(data), static_cast<uint32_t>(len), user_data);
+    sqe->msg_flags = flags;
+}
+
+void IoUring::PrepSendMsg(io_uring_sqe* sqe, int fd, const struct msghdr* msg, unsigned flags,
+                          uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_SENDMSG, fd, reinterpret_cast<uint64_t>(msg), 1, user_data);
+    sqe->msg_flags = flags;
+}
+
+void IoUring::PrepAcceptMultishot(io_uring_sqe* sqe, int fd, int flags, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_ACCEPT, fd, 0, 0, user_data);
+    sqe->accept_flags = static_cast<uint32_t>(flags);
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+}
+
+void IoUring::PrepLinkTimeout(io_uring_sqe* sqe, const struct __kernel_timespec* timeout, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_LINK_TIMEOUT, -1, reinterpret_cast<uint64_t>(timeout), 1, user_data);
+}
+
+void IoUring::PrepCancel(io_uring_sqe* sqe, uint64_t target_user_data, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_ASYNC_CANCEL, -1, target_user_data, 0, user_data);
+}
+
+void IoUring::PrepCancelAll(io_uring_sqe* sqe, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_ASYNC_CANCEL, -1, 0, 0, user_data);
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+}
+
+void IoUring::PrepPollRemove(io_uring_sqe* sqe, uint64_t target_user_data, uint64_t user_data) {
+    PrepRw(sqe, IORING_OP_POLL_REMOVE, -1, target_user_data, 0, user_data);
+}
+
+} // namespace ipc_demo
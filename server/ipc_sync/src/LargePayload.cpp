@@ -0,0 +1,88 @@
+/**
+ * @file LargePayload.cpp
+ * @brief Implementation of sealed memfd payloads
+ */
+
+#include "ipc_sync/LargePayload.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace ipc_demo {
+
+namespace {
+
+constexpr int REQUIRED_SEALS = F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+} // namespace
+
+int CreateSealedPayload(const uint8_t* data, size_t len, std::string& error) {
+    if (len == 0 || len > Protocol::MAX_FD_PAYLOAD_SIZE) {
+        error = "Payload size out of range: " + std::to_string(len);
+        return -1;
+    }
+
+    int memfd = memfd_create("ipc_demo_payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0) {
+        error = "memfd_create failed: " + std::string(strerror(errno));
+        return -1;
+    }
+
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = write(memfd, data + written, len - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = "Writing payload failed: " + std::string(strerror(errno));
+            close(memfd);
+            return -1;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    if (fcntl(memfd, F_ADD_SEALS, REQUIRED_SEALS) < 0) {
+        error = "Sealing payload failed: " + std::string(strerror(errno));
+        close(memfd);
+        return -1;
+    }
+
+    return memfd;
+}
+
+std::shared_ptr<const PayloadView> PayloadView::Map(int memfd, size_t size, std::string& error) {
+    int seals = fcntl(memfd, F_GET_SEALS);
+    if (seals < 0 || (seals & (F_SEAL_WRITE | F_SEAL_SHRINK)) != (F_SEAL_WRITE | F_SEAL_SHRINK)) {
+        error = "Payload memfd is not sealed read-only";
+        close(memfd);
+        return nullptr;
+    }
+
+    struct stat st;
+    if (size == 0 || size > Protocol::MAX_FD_PAYLOAD_SIZE ||
+        fstat(memfd, &st) < 0 || static_cast<size_t>(st.st_size) != size) {
+        error = "Payload size mismatch";
+        close(memfd);
+        return nullptr;
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, memfd, 0);
+    close(memfd); // The mapping keeps the memory alive
+    if (addr == MAP_FAILED) {
+        error = "mmap failed: " + std::string(strerror(errno));
+        return nullptr;
+    }
+
+    return std::shared_ptr<const PayloadView>(new PayloadView(static_cast<const uint8_t*>(addr), size));
+}
+
+PayloadView::~PayloadView() {
+    munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,72 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation of the client-side latency histogram
+ */
+
+#include "ipc_sync/LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ipc_demo {
+
+LatencyHistogram::LatencyHistogram()
+    : buckets_(BUCKET_COUNT, 0) {
+}
+
+void LatencyHistogram::RecordCount(uint64_t value_ns, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    buckets_[Buckets::Index(value_ns)] += count;
+    min_ = count_ ? std::min(min_, value_ns) : value_ns;
+    max_ = std::max(max_, value_ns);
+    count_ += count;
+    sum_ += static_cast<double>(value_ns) * static_cast<double>(count);
+}
+
+void LatencyHistogram::Add(const LatencyHistogram& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    min_ = count_ ? std::min(min_, other.min_) : other.min_;
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+    sum_ += other.sum_;
+}
+
+void LatencyHistogram::Reset() {
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    count_ = 0;
+    min_ = 0;
+    max_ = 0;
+    sum_ = 0;
+}
+
+double LatencyHistogram::Mean() const {
+    return count_ ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+uint64_t LatencyHistogram::Percentile(double q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            if (i == BUCKET_COUNT - 1) {
+                return max_; // Overflow bucket: no upper bound
+            }
+            return std::max(std::min(Buckets::UpperBound(i), max_), min_);
+        }
+    }
+    return max_;
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,133 @@
+/**
+ * @file RingBuffer.cpp
+ * @brief Implementation of RingBuffer
+ */
+
+#include "ipc_sync/RingBuffer.hpp"
+#include "ipc_sync/BufferPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace ipc_demo {
+
+namespace {
+
+size_t RoundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+RingBuffer::RingBuffer(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("RingBuffer: capacity must be > 0");
+    }
+    capacity_ = RoundUpPowerOfTwo(capacity);
+    mask_ = capacity_ - 1;
+    owned_ = std::make_unique<uint8_t[]>(capacity_);
+    data_ = owned_.get();
+}
+
+RingBuffer::RingBuffer(BufferPool& pool)
+    : capacity_(pool.BlockSize())
+    , mask_(pool.BlockSize() - 1)
+    , pool_(&pool) {
+}
+
+RingBuffer::~RingBuffer() {
+    if (pool_ && data_) {
+        pool_->Release(data_);
+    }
+}
+
+uint8_t* RingBuffer::Storage() {
+    if (!data_) {
+        data_ = pool_->Acquire();
+    }
+    return data_;
+}
+
+uint8_t* RingBuffer::WritePtr(size_t& contiguous) {
+    size_t offset = static_cast<size_t>(tail_) & mask_;
+    contiguous = std::min(FreeSpace(), Capacity() - offset);
+    return Storage() + offset;
+}
+
+uint8_t* RingBuffer::WriteRegions(size_t& first_len, uint8_t*& second, size_t& second_len) {
+    uint8_t* first = WritePtr(first_len);
+    second = data_;
+    second_len = FreeSpace() - first_len;
+    return first;
+}
+
+void RingBuffer::CommitWrite(size_t len) {
+    tail_ += std::min(len, FreeSpace());
+}
+
+bool RingBuffer::Write(const uint8_t* data, size_t len) {
+    if (len > FreeSpace()) {
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+
+    uint8_t* storage = Storage();
+    size_t offset = static_cast<size_t>(tail_) & mask_;
+    size_t first = std::min(len, Capacity() - offset);
+    std::memcpy(storage + offset, data, first);
+    std::memcpy(storage, data + first, len - first);
+    tail_ += len;
+    return true;
+}
+
+bool RingBuffer::Peek(size_t offset, uint8_t* data, size_t len) const {
+    if (offset + len > Size()) {
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+
+    size_t start = static_cast<size_t>(head_ + offset) & mask_;
+    size_t first = std::min(len, Capacity() - start);
+    std::memcpy(data, data_ + start, first);
+    std::memcpy(data + first, data_, len - first);
+    return true;
+}
+
+const uint8_t* RingBuffer::ReadPtr(size_t len) const {
+    size_t start = static_cast<size_t>(head_) & mask_;
+    if (len > Size() || start + len > Capacity()) {
+        return nullptr;
+    }
+    return data_ + start;
+}
+
+void RingBuffer::Consume(size_t len) {
+    head_ += std::min(len, Size());
+    if (head_ == tail_) {
+        // Rewind so the next frame starts contiguous
+        head_ = tail_ = 0;
+        ReleaseIfEmpty();
+    }
+}
+
+void RingBuffer::Clear() {
+    head_ = tail_ = 0;
+    ReleaseIfEmpty();
+}
+
+void RingBuffer::ReleaseIfEmpty() {
+    if (pool_ && data_ && head_ == tail_) {
+        pool_->Release(data_);
+        data_ = nullptr;
+    }
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,258 @@
+/**
+ * @file ShmTransport.cpp
+ * @brief Implementation of ShmRing and ShmTransport
+ */
+
+#include "ipc_sync/ShmTransport.hpp"
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace ipc_demo {
+
+namespace {
+
+constexpr size_t CACHE_LINE = 64;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+size_t RoundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+// ============================================================================
+// ShmRing
+// ============================================================================
+
+ShmRing::ShmRing(void* region, size_t capacity)
+    : header_(static_cast<Header*>(region))
+    , data_(static_cast<uint8_t*>(region) + AlignUp(sizeof(Header), CACHE_LINE))
+    , capacity_(capacity) {
+}
+
+size_t ShmRing::RegionSize(size_t capacity) {
+    return AlignUp(sizeof(Header), CACHE_LINE) + AlignUp(capacity, CACHE_LINE);
+}
+
+void ShmRing::Initialize() {
+    new (header_) Header();
+    header_->head.store(0, std::memory_order_relaxed);
+    header_->tail.store(0, std::memory_order_relaxed);
+    header_->reader_waiting.store(1, std::memory_order_relaxed); // Ring the doorbell until the reader says otherwise
+    header_->writer_waiting.store(0, std::memory_order_relaxed);
+}
+
+size_t ShmRing::Write(const uint8_t* data, size_t len) {
+    uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    uint64_t head = header_->head.load(std::memory_order_acquire);
+
+    uint64_t used = tail - head;
+    if (used > capacity_) {
+        return 0; // Peer corrupted the indices; never write out of turn
+    }
+
+    size_t count = std::min(len, capacity_ - static_cast<size_t>(used));
+    size_t offset = static_cast<size_t>(tail) & (capacity_ - 1);
+    size_t first = std::min(count, capacity_ - offset);
+    std::memcpy(data_ + offset, data, first);
+    std::memcpy(data_, data + first, count - first);
+
+    header_->tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+size_t ShmRing::Read(uint8_t* dst, size_t max, bool& corrupt) {
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    uint64_t tail = header_->tail.load(std::memory_order_acquire);
+
+    uint64_t available = tail - head;
+    if (available > capacity_) {
+        corrupt = true;
+        return 0;
+    }
+
+    size_t count = std::min(max, static_cast<size_t>(available));
+    size_t offset = static_cast<size_t>(head) & (capacity_ - 1);
+    size_t first = std::min(count, capacity_ - offset);
+    std::memcpy(dst, data_ + offset, first);
+    std::memcpy(dst + first, data_, count - first);
+
+    header_->head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+bool ShmRing::Empty() const {
+    return header_->head.load(std::memory_order_acquire) ==
+           header_->tail.load(std::memory_order_acquire);
+}
+
+// The waiting flags pair with the indices in a Dekker-style handshake:
+// one side stores its flag (or index) and then loads the other's, so both
+// need sequential consistency.
+
+void ShmRing::SetReaderWaiting(bool waiting) {
+    header_->reader_waiting.store(waiting ? 1 : 0, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool ShmRing::ReaderWaiting() const {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return header_->reader_waiting.load(std::memory_order_seq_cst) != 0;
+}
+
+void ShmRing::SetWriterWaiting(bool waiting) {
+    header_->writer_waiting.store(waiting ? 1 : 0, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool ShmRing::WriterWaiting() const {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return header_->writer_waiting.load(std::memory_order_seq_cst) != 0;
+}
+
+// ============================================================================
+// ShmTransport
+// ============================================================================
+
+ShmTransport::ShmTransport(int memfd, int request_event, int response_event)
+    : memfd_(memfd)
+    , request_event_(request_event)
+    , response_event_(response_event) {
+}
+
+ShmTransport::~ShmTransport() {
+    if (base_ != nullptr) {
+        munmap(base_, size_);
+    }
+    for (int fd : {memfd_, request_event_, response_event_}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+std::unique_ptr<ShmTransport> ShmTransport::Create(size_t ring_capacity, std::string& error) {
+    ring_capacity = RoundUpPowerOfTwo(std::clamp(ring_capacity, MIN_RING_CAPACITY, MAX_RING_CAPACITY));
+
+    int memfd = memfd_create("ipc_demo_shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0) {
+        error = "memfd_create failed: " + std::string(strerror(errno));
+        return nullptr;
+    }
+
+    int request_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int response_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::unique_ptr<ShmTransport> transport(new ShmTransport(memfd, request_event, response_event));
+    if (request_event < 0 || response_event < 0) {
+        error = "eventfd failed: " + std::string(strerror(errno));
+        return nullptr;
+    }
+
+    size_t size = CACHE_LINE + 2 * ShmRing::RegionSize(ring_capacity);
+    if (ftruncate(memfd, static_cast<off_t>(size)) < 0) {
+        error = "ftruncate failed: " + std::string(strerror(errno));
+        return nullptr;
+    }
+
+    // The server maps this too: a fixed size keeps a shrink from faulting it
+    if (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+        error = "Sealing memfd failed: " + std::string(strerror(errno));
+        return nullptr;
+    }
+
+    if (!transport->Map(ring_capacity, error)) {
+        return nullptr;
+    }
+
+    Layout* layout = static_cast<Layout*>(transport->base_);
+    layout->magic = MAGIC;
+    layout->ring_capacity = static_cast<uint32_t>(ring_capacity);
+    layout->reserved = 0;
+    transport->requests_.Initialize();
+    transport->responses_.Initialize();
+
+    return transport;
+}
+
+std::unique_ptr<ShmTransport> ShmTransport::Attach(int memfd, int request_event, int response_event,
+                                                   std::string& error) {
+    std::unique_ptr<ShmTransport> transport(new ShmTransport(memfd, request_event, response_event));
+
+    int seals = fcntl(memfd, F_GET_SEALS);
+    if (seals < 0 || !(seals & F_SEAL_SHRINK)) {
+        error = "Shared memory is not sealed against shrinking";
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(memfd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(Layout)) {
+        error = "Shared memory too small";
+        return nullptr;
+    }
+
+    Layout layout;
+    if (pread(memfd, &layout, sizeof(layout), 0) != static_cast<ssize_t>(sizeof(layout))) {
+        error = "Failed to read shared memory layout";
+        return nullptr;
+    }
+
+    size_t capacity = layout.ring_capacity;
+    if (layout.magic != MAGIC || capacity < MIN_RING_CAPACITY || capacity > MAX_RING_CAPACITY ||
+        (capacity & (capacity - 1)) != 0) {
+        error = "Invalid shared memory layout";
+        return nullptr;
+    }
+
+    if (static_cast<size_t>(st.st_size) < CACHE_LINE + 2 * ShmRing::RegionSize(capacity)) {
+        error = "Shared memory smaller than its layout";
+        return nullptr;
+    }
+
+    if (!transport->Map(capacity, error)) {
+        return nullptr;
+    }
+    return transport;
+}
+
+bool ShmTransport::Map(size_t ring_capacity, std::string& error) {
+    size_ = CACHE_LINE + 2 * ShmRing::RegionSize(ring_capacity);
+    base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, memfd_, 0);
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        error = "mmap failed: " + std::string(strerror(errno));
+        return false;
+    }
+
+    uint8_t* region = static_cast<uint8_t*>(base_) + CACHE_LINE;
+    requests_ = ShmRing(region, ring_capacity);
+    responses_ = ShmRing(region + ShmRing::RegionSize(ring_capacity), ring_capacity);
+    return true;
+}
+
+void ShmTransport::Notify(int event_fd) {
+    uint64_t one = 1;
+    ssize_t ret = write(event_fd, &one, sizeof(one));
+    (void)ret; // EAGAIN only when the counter saturates; the peer is awake anyway
+}
+
+void ShmTransport::Drain(int event_fd) {
+    uint64_t count;
+    ssize_t ret = read(event_fd, &count, sizeof(count));
+    (void)ret; // Nothing pending is fine
+}
+
+} // namespace ipc_demo
@@ -0,0 +1,164 @@
+/**
+ * @file StatsClient.cpp
+ * @brief Implementation of StatsClient (part of shared library)
+ */
+
+#include "ipc_sync/StatsClient.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <stdexcept>
+
+namespace ipc_demo {
+
+// Private implementation (hidden from client)
+struct StatsClient::Impl {
+    std::shared_ptr<Channel> channel_;
+
+    explicit Impl(std::shared_ptr<Channel> channel)
+        : channel_(channel) {
+        if (!channel_) {
+            throw std::invalid_argument("StatsClient: channel cannot be null");
+        }
+    }
+
+    static uint64_t GetCounter(ByteBuffer& buf) {
+        return static_cast<uint64_t>(buf.GetLong());
+    }
+
+    static StatsClient::Histogram GetHistogram(ByteBuffer& buf) {
+        int64_t record[7];
+        buf.GetLongs(record, 7);
+
+        StatsClient::Histogram histogram;
+        histogram.count = static_cast<uint64_t>(record[0]);
+        histogram.sum_ns = static_cast<uint64_t>(record[1]);
+        histogram.max_ns = static_cast<uint64_t>(record[2]);
+        histogram.p50_ns = static_cast<uint64_t>(record[3]);
+        histogram.p90_ns = static_cast<uint64_t>(record[4]);
+        histogram.p99_ns = static_cast<uint64_t>(record[5]);
+        histogram.p999_ns = static_cast<uint64_t>(record[6]);
+        return histogram;
+    }
+
+    /**
+     * @brief Run the stats routine
+     * @return Empty string on success, otherwise the error message
+     */
+    std::string Request(uint8_t format, uint8_t* response_data, size_t response_size,
+                        size_t& response_len) {
+        uint8_t request_data[1] = {format};
+
+        bool rpc_ok = channel_->ExecuteRPC(
+            Protocol::STATS_REQUEST_ROUTINE_ID,
+            request_data, sizeof(request_data),
+            response_data, response_size,
+            response_len
+        );
+        if (!rpc_ok) {
+            return "RPC failed: " + channel_->GetLastError();
+        }
+        return "";
+    }
+
+    /**
+     * @brief Check the frame header and skip it
+     * @return false if this is not a stats response
+     */
+    static bool SkipHeader(ByteBuffer& buf) {
+        if (buf.GetByte() != Protocol::START_BYTE) {
+            return false;
+        }
+        buf.GetInt(); // Frame length already validated
+        if (buf.GetInt() != Protocol::STATS_RESPONSE_ROUTINE_ID) {
+            return false;
+        }
+        buf.GetByte(); // Version
+        return true;
+    }
+
+    StatsClient::StatsResult GetStats() {
+        StatsClient::StatsResult result;
+
+        uint8_t response_data[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        result.error_message = Request(Protocol::STATS_FORMAT_BINARY, response_data,
+                                       sizeof(response_data), response_len);
+        if (!result.error_message.empty()) {
+            return result;
+        }
+
+        try {
+            ByteBuffer buf(response_data, response_len);
+            if (!SkipHeader(buf)) {
+                result.error_message = "Unexpected routine ID in response";
+                return result;
+            }
+
+            result.connections_opened = GetCounter(buf);
+            result.connections_closed = GetCounter(buf);
+            uint32_t count = buf.GetInt();
+            for (uint32_t i = 0; i < count; ++i) {
+                StatsClient::RoutineStats routine;
+                routine.routine_id = buf.GetInt();
+                routine.name = buf.GetString();
+                routine.requests = GetCounter(buf);
+                routine.errors = GetCounter(buf);
+                routine.rejected = GetCounter(buf);
+                routine.bytes_in = GetCounter(buf);
+                routine.bytes_out = GetCounter(buf);
+                routine.queue_wait = GetHistogram(buf);
+                routine.execution = GetHistogram(buf);
+                result.routines.push_back(std::move(routine));
+            }
+            result.success = true;
+
+        } catch (const std::exception& e) {
+            result.routines.clear();
+            result.error_message = std::string("Exception: ") + e.what();
+        }
+        return result;
+    }
+
+    StatsClient::TextResult GetPrometheusText() {
+        StatsClient::TextResult result;
+
+        uint8_t response_data[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        result.error_message = Request(Protocol::STATS_FORMAT_PROMETHEUS, response_data,
+                                       sizeof(response_data), response_len);
+        if (!result.error_message.empty()) {
+            return result;
+        }
+
+        try {
+            ByteBuffer buf(response_data, response_len);
+            if (!SkipHeader(buf)) {
+                result.error_message = "Unexpected routine ID in response";
+                return result;
+            }
+            result.text = buf.GetString();
+            result.success = true;
+
+        } catch (const std::exception& e) {
+            result.error_message = std::string("Exception: ") + e.what();
+        }
+        return result;
+    }
+};
+
+// Public interface implementation
+StatsClient::StatsClient(std::shared_ptr<Channel> channel)
+    : pImpl_(std::make_unique<Impl>(channel)) {
+}
+
+StatsClient::~StatsClient() = default;
+
+StatsClient::StatsResult StatsClient::GetStats() {
+    return pImpl_->GetStats();
+}
+
+StatsClient::TextResult StatsClient::GetPrometheusText() {
+    return pImpl_->GetPrometheusText();
+}
+
+} // namespace ipc_demo
@@ -4,99 +4,82 @@
  */
 
 #include "ipc_sync/TimeClient.hpp"
-#include "ipc_sync/ByteBuffer.hpp"
-#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/RpcClient.hpp"
+#include "ipc_sync/TimeSchema.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace ipc_demo {
 
-enum class Operation : uint8_t {
-    GetTimestamp = 0x01
-};
-
 // Private implementation (hidden from client)
 struct TimeClient::Impl {
-    std::shared_ptr<Channel> channel_;
-    static constexpr uint32_t REQUEST_ROUTINE_ID = 0x00002000;
-    static constexpr uint32_t RESPONSE_ROUTINE_ID = 0x00002001;
+    RpcClient<TimeRpc> stub_;
 
     explicit Impl(std::shared_ptr<Channel> channel)
-        : channel_(channel) {
-        if (!channel_) {
+        : stub_(NonNull(channel)) {
+    }
+
+    static std::shared_ptr<Channel> NonNull(std::shared_ptr<Channel> channel) {
+        if (!channel) {
             throw std::invalid_argument("TimeClient: channel cannot be null");
         }
+        return channel;
+    }
+
+    static TimeClient::TimeResult ToResult(const TimeResponse& response) {
+        if (response.status == TimeStatus::Success) {
+            return TimeClient::TimeResult{true, response.timestamp, response.unix_timestamp, ""};
+        }
+        return TimeClient::TimeResult{false, "", 0, response.error};
+    }
+
+    TimeClient::TimeResultView GetCurrentTime(ResponseBuffer& buffer) {
+        TimeResponseView response;
+        std::string error;
+        if (!stub_.CallView(TimeRequest{TimeOperation::GetTimestamp}, buffer.data, sizeof(buffer.data),
+                            response, error)) {
+            return TimeClient::TimeResultView{false, {}, 0, buffer.Keep(error)};
+        }
+        if (response.status == TimeStatus::Success) {
+            return TimeClient::TimeResultView{true, response.timestamp, response.unix_timestamp, {}};
+        }
+        return TimeClient::TimeResultView{false, {}, 0, response.error};
     }
 
     TimeClient::TimeResult GetCurrentTime() {
-        TimeClient::TimeResult result;
-        result.success = false;
-        result.unix_timestamp = 0;
-
-        try {
-            // Build request payload
-            uint8_t request_data[1];
-            ByteBuffer request_buf(request_data, sizeof(request_data));
-            
-            request_buf.PutByte(static_cast<uint8_t>(Operation::GetTimestamp));
-
-            // Execute RPC
-            uint8_t response_data[Protocol::MAX_PACKET_SIZE];
-            size_t response_len = 0;
-
-            bool rpc_ok = channel_->ExecuteRPC(
-                REQUEST_ROUTINE_ID,
-                request_data, request_buf.Position(),
-                response_data, sizeof(response_data),
-                response_len
-            );
-
-            if (!rpc_ok) {
-                result.error_message = "RPC failed: " + channel_->GetLastError();
-                return result;
-            }
-
-            // Parse response
-            ByteBuffer response_buf(response_data, response_len);
-            
-            uint8_t start = response_buf.GetByte();
-            if (start != Protocol::START_BYTE) {
-                result.error_message = "Invalid response frame";
-                return result;
-            }
-
-            uint32_t frame_len = response_buf.GetInt();
-            uint32_t routine_id = response_buf.GetInt();
-            
-            if (routine_id != RESPONSE_ROUTINE_ID) {
-                result.error_message = "Unexpected routine ID in response";
-                return result;
-            }
-
-            uint8_t version = response_buf.GetByte();
-            (void)version; // Protocol version for future use
-            (void)frame_len; // Frame length already validated
-            
-            uint8_t status = response_buf.GetByte();
-            std::string timestamp = response_buf.GetString();
-            int64_t unix_timestamp = response_buf.GetLong();
-            std::string error_msg = response_buf.GetString();
-
-            if (status == 0x00) { // Success
-                result.success = true;
-                result.timestamp = timestamp;
-                result.unix_timestamp = unix_timestamp;
-            } else {
-                result.success = false;
-                result.error_message = error_msg;
-            }
-
-            return result;
-
-        } catch (const std::exception& e) {
-            result.error_message = std::string("Exception: ") + e.what();
-            return result;
+        // Decoded in place, so each string is copied once
+        ResponseBuffer buffer;
+        return GetCurrentTime(buffer).ToResult();
+    }
+
+    void GetCurrentTimeAsync(TimeClient::Callback callback) {
+        if (!callback) {
+            throw std::invalid_argument("TimeClient: callback cannot be empty");
         }
+
+        stub_.CallAsync(TimeRequest{TimeOperation::GetTimestamp},
+            [callback = std::move(callback)](bool success, const TimeResponse& response,
+                                             const std::string& error) {
+                callback(success ? ToResult(response) : TimeClient::TimeResult{false, "", 0, error});
+            });
+    }
+
+    bool Subscribe(uint32_t interval_ms, TimeClient::Callback callback, uint32_t& stream_id) {
+        if (!callback) {
+            throw std::invalid_argument("TimeClient: callback cannot be empty");
+        }
+
+        StreamOptions options;
+        options.interval_ms = interval_ms;
+        std::string error;
+        return stub_.Subscribe(TimeRequest{TimeOperation::GetTimestamp}, options,
+            [callback = std::move(callback)](bool success, const TimeResponse& response,
+                                             const std::string& stream_error) {
+                callback(success ? ToResult(response) : TimeClient::TimeResult{false, "", 0, stream_error});
+            }, stream_id, error);
+    }
+
+    bool Unsubscribe(uint32_t stream_id) {
+        return stub_.Unsubscribe(stream_id);
     }
 };
 
@@ -111,4 +94,30 @@ TimeClient::TimeResult TimeClient::GetCurrentTime() {
     return pImpl_->GetCurrentTime();
 }
 
+TimeClient::TimeResultView TimeClient::GetCurrentTime(ResponseBuffer& buffer) {
+    return pImpl_->GetCurrentTime(buffer);
+}
+
+std::future<TimeClient::TimeResult> TimeClient::GetCurrentTimeAsync() {
+    auto promise = std::make_shared<std::promise<TimeResult>>();
+    std::future<TimeResult> future = promise->get_future();
+
+    pImpl_->GetCurrentTimeAsync([promise](const TimeResult& result) {
+        promise->set_value(result);
+    });
+    return future;
+}
+
+void TimeClient::GetCurrentTimeAsync(Callback callback) {
+    pImpl_->GetCurrentTimeAsync(std::move(callback));
+}
+
+bool TimeClient::Subscribe(uint32_t interval_ms, Callback callback, uint32_t& stream_id) {
+    return pImpl_->Subscribe(interval_ms, std::move(callback), stream_id);
+}
+
+bool TimeClient::Unsubscribe(uint32_t stream_id) {
+    return pImpl_->Unsubscribe(stream_id);
+}
+
 } // namespace ipc_demo
@@ -0,0 +1,318 @@
+/**
+ * @file Tracer.cpp
+ * @brief Implementation of the sampling tracer and its Chrome trace export
+ */
+
+#include "ipc_sync/Tracer.hpp"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace ipc_demo {
+namespace trace {
+
+namespace {
+
+// Shortest interval the tick rate is measured over
+constexpr uint64_t CALIBRATION_NS = 10000000;
+
+uint64_t MonotonicNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// xorshift64*, seeded per thread
+uint64_t NextRandom() {
+    thread_local uint64_t state = [] {
+        uint64_t seed = MonotonicNs() ^ (static_cast<uint64_t>(syscall(SYS_gettid)) << 32);
+        return seed ? seed : 0x9E3779B97F4A7C15ull;
+    }();
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1Dull;
+}
+
+const char* StageName(Side side, size_t stage) {
+    static const char* const CLIENT[MAX_STAGES] = {"start", "encode", "send", "wait", "decode", ""};
+    static const char* const SERVER[MAX_STAGES] = {"receive", "parse", "queue", "lookup", "execute", "send"};
+    return side == Side::Client ? CLIENT[stage] : SERVER[stage];
+}
+
+const char* SideName(Side side) {
+    return side == Side::Client ? "client" : "server";
+}
+
+void PutHex(std::ostream& out, uint64_t value) {
+    char text[20];
+    std::snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(value));
+    out << '"' << text << '"';
+}
+
+} // namespace
+
+/**
+ * @struct Tracer::Ring
+ * @brief One recording thread's spans: single producer, single consumer
+ *
+ * The producer fills the slot at tail and then publishes it; the consumer
+ * (Collect, under the tracer's mutex) copies slots up to tail and then
+ * releases them by advancing head.
+ */
+struct Tracer::Ring {
+    std::unique_ptr<Span[]> slots{new Span[RING_CAPACITY]};
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> retired{false};   // Thread exited; removed once drained
+    uint32_t thread_id = static_cast<uint32_t>(syscall(SYS_gettid));
+};
+
+/**
+ * @struct Tracer::ThreadRing
+ * @brief Owns the calling thread's ring and retires it when the thread exits
+ */
+struct Tracer::ThreadRing {
+    std::shared_ptr<Ring> ring;
+
+    ~ThreadRing() {
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local Tracer::ThreadRing Tracer::thread_ring_;
+
+Sampler::Sampler(double rate) {
+    rate = std::min(std::max(rate, 0.0), 1.0);
+    enabled_ = rate > 0.0;
+    always_ = rate >= 1.0;
+    threshold_ = static_cast<uint64_t>(rate * 18446744073709551616.0); // rate * 2^64
+}
+
+bool Sampler::Sample() const {
+    return always_ || (enabled_ && NextRandom() < threshold_);
+}
+
+uint64_t NewTraceId() {
+    uint64_t id;
+    do {
+        id = NextRandom();
+    } while (id == 0);
+    return id;
+}
+
+Tracer& Tracer::Global() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer()
+    : base_ticks_(Now()),
+      base_ns_(MonotonicNs()) {
+}
+
+Tracer::~Tracer() = default;
+
+void Tracer::Record(const Span& span) {
+    Ring* ring = thread_ring_.ring.get();
+    if (!ring) {
+        ring = RegisterThread();
+    }
+
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->slots[tail & (RING_CAPACITY - 1)] = span;
+    ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+Tracer::Ring* Tracer::RegisterThread() {
+    auto ring = std::make_shared<Ring>();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.push_back(ring);
+    }
+    thread_ring_.ring = ring;
+    return ring.get();
+}
+
+size_t Tracer::Collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t collected = 0;
+
+    for (auto it = rings_.begin(); it != rings_.end();) {
+        Ring& ring = **it;
+        bool retired = ring.retired.load(std::memory_order_acquire); // Before reading tail: nothing follows
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        uint64_t tail = ring.tail.load(std::memory_order_acquire);
+
+        for (; head < tail; ++head) {
+            if (retained_.size() >= MAX_RETAINED) {
+                dropped_.fetch_add(tail - head, std::memory_order_relaxed);
+                head = tail;
+                break;
+            }
+            retained_.push_back(CollectedSpan{ring.slots[head & (RING_CAPACITY - 1)], ring.thread_id});
+            ++collected;
+        }
+        ring.head.store(head, std::memory_order_release);
+
+        if (retired) {
+            dropped_.fetch_add(ring.dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            it = rings_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return collected;
+}
+
+std::vector<CollectedSpan> Tracer::TakeSpans() {
+    Collect();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<CollectedSpan> spans;
+    spans.swap(retained_);
+    return spans;
+}
+
+uint64_t Tracer::Dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    for (const auto& ring : rings_) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+void Tracer::Calibrate() {
+    uint64_t elapsed = MonotonicNs() - base_ns_;
+    if (elapsed < CALIBRATION_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(CALIBRATION_NS - elapsed));
+    }
+    uint64_t ticks = Now();
+    uint64_t ns = MonotonicNs();
+    if (ticks > base_ticks_) {
+        ns_per_tick_ = static_cast<double>(ns - base_ns_) / static_cast<double>(ticks - base_ticks_);
+    }
+}
+
+double Tracer::NsPerTick() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Calibrate();
+    return ns_per_tick_;
+}
+
+uint64_t Tracer::TicksToNs(uint64_t ticks) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Calibrate();
+    // Spans may start before the tracer existed
+    double offset = static_cast<double>(static_cast<int64_t>(ticks - base_ticks_)) * ns_per_tick_;
+    return base_ns_ + static_cast<int64_t>(offset);
+}
+
+std::string Tracer::ExportChromeTrace() {
+    std::vector<CollectedSpan> spans = TakeSpans();
+    double ns_per_tick = NsPerTick();
+    uint64_t dropped = Dropped();
+
+    int pid = static_cast<int>(getpid());
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+
+    auto to_us = [this, ns_per_tick](uint64_t ticks) {
+        double offset = static_cast<double>(static_cast<int64_t>(ticks - base_ticks_)) * ns_per_tick;
+        return (static_cast<double>(base_ns_) + offset) / 1000.0;
+    };
+    bool first_event = true;
+    auto begin_event = [&](const char* name, const char* category, const char* phase, double ts,
+                           uint32_t tid) {
+        out << (first_event ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"" << category
+            << "\",\"ph\":\"" << phase << "\",\"ts\":" << ts << ",\"pid\":" << pid << ",\"tid\":" << tid;
+        first_event = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":" << dropped << "},\"traceEvents\":[";
+    for (const CollectedSpan& collected : spans) {
+        const Span& span = collected.span;
+        const char* side = SideName(span.side);
+
+        size_t first = MAX_STAGES;
+        size_t last = 0;
+        for (size_t i = 0; i < MAX_STAGES; ++i) {
+            if (span.ticks[i] != 0) {
+                first = std::min(first, i);
+                last = i;
+            }
+        }
+        if (first == MAX_STAGES) {
+            continue;
+        }
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%s 0x%x", side, span.routine_id);
+        double start_us = to_us(span.ticks[first]);
+        begin_event(name, side, "X", start_us, collected.thread_id);
+        out << ",\"dur\":" << to_us(span.ticks[last]) - start_us << ",\"args\":{\"routine_id\":";
+        PutHex(out, span.routine_id);
+        if (span.trace_id != 0) {
+            out << ",\"trace_id\":";
+            PutHex(out, span.trace_id);
+        }
+        out << "}}";
+
+        // One event per interval, from the previous stage passed
+        size_t previous = first;
+        for (size_t i = first + 1; i <= last; ++i) {
+            if (span.ticks[i] == 0) {
+                continue;
+            }
+            // A pipelined response may be stamped before its send was
+            double from_us = to_us(span.ticks[previous]);
+            begin_event(StageName(span.side, i), side, "X", from_us, collected.thread_id);
+            out << ",\"dur\":" << std::max(to_us(span.ticks[i]) - from_us, 0.0) << "}";
+            previous = i;
+        }
+
+        // Flow from the client's send to the server's receive
+        if (span.trace_id != 0) {
+            bool client = span.side == Side::Client;
+            uint64_t at = span.ticks[first];
+            if (client) {
+                size_t sent = static_cast<size_t>(ClientStage::Sent);
+                size_t encoded = static_cast<size_t>(ClientStage::Encoded);
+                at = span.ticks[sent] ? span.ticks[sent] : span.ticks[encoded] ? span.ticks[encoded] : at;
+            }
+            begin_event("rpc", "rpc", client ? "s" : "f", to_us(at), collected.thread_id);
+            out << (client ? "" : ",\"bp\":\"e\"") << ",\"id\":";
+            PutHex(out, span.trace_id);
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        out << ExportChromeTrace();
+        if (!out) {
+            return false;
+        }
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+} // namespace trace
+} // namespace ipc_demo
@@ -0,0 +1,175 @@
+/**
+ * @file ConnectionTable.hpp
+ * @brief Slab-allocated connection state indexed directly by descriptor
+ *
+ * Used by the reactors for ClientInfo: connections that come and go reuse
+ * slab slots instead of going through the allocator, and lookups by fd are
+ * an index into a flat vector instead of a hash probe.
+ */
+
+#ifndef IPC_DEMO_CONNECTION_TABLE_HPP
+#define IPC_DEMO_CONNECTION_TABLE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class ConnectionTable
+ * @brief Objects of type T keyed by small non-negative integers (descriptors)
+ *
+ * Slots are allocated SLOTS_PER_SLAB at a time and kept on a free list when
+ * their object is destroyed; addresses stay stable for an object's life.
+ * An object can be detached from its descriptor (the descriptor may then be
+ * reused) and destroyed later, e.g. when asynchronous I/O still refers to it.
+ *
+ * Thread Safety: none; one thread (a reactor) owns the table.
+ */
+template <typename T>
+class ConnectionTable {
+public:
+    static constexpr size_t SLOTS_PER_SLAB = 64;
+
+    ConnectionTable() = default;
+
+    /**
+     * @brief Destroy the indexed objects (detached ones must be destroyed first)
+     */
+    ~ConnectionTable() { Clear(); }
+
+    // Disable copy/move
+    ConnectionTable(const ConnectionTable&) = delete;
+    ConnectionTable& operator=(const ConnectionTable&) = delete;
+    ConnectionTable(ConnectionTable&&) = delete;
+    ConnectionTable& operator=(ConnectionTable&&) = delete;
+
+    /**
+     * @brief Construct an object for fd (which must not be indexed yet)
+     * @return The new object
+     */
+    template <typename... Args>
+    T* Emplace(int fd, Args&&... args) {
+        Slot* slot = AllocateSlot();
+        T* object;
+        try {
+            object = new (slot->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            FreeSlot(slot);
+            throw;
+        }
+        if (static_cast<size_t>(fd) >= by_fd_.size()) {
+            by_fd_.resize(static_cast<size_t>(fd) + 1, nullptr);
+        }
+        by_fd_[fd] = object;
+        size_++;
+        return object;
+    }
+
+    /**
+     * @brief Object indexed under fd, or nullptr
+     */
+    T* Find(int fd) const {
+        return fd >= 0 && static_cast<size_t>(fd) < by_fd_.size() ? by_fd_[fd] : nullptr;
+    }
+
+    /**
+     * @brief Destroy the object indexed under fd (no-op if there is none)
+     */
+    void Erase(int fd) {
+        if (T* object = Detach(fd)) {
+            Destroy(object);
+        }
+    }
+
+    /**
+     * @brief Unindex the object under fd but keep it alive
+     * @return The object (destroy it with Destroy), or nullptr
+     */
+    T* Detach(int fd) {
+        T* object = Find(fd);
+        if (object) {
+            by_fd_[fd] = nullptr;
+            size_--;
+        }
+        return object;
+    }
+
+    /**
+     * @brief Destroy a detached object and recycle its slot
+     */
+    void Destroy(T* object) {
+        object->~T();
+        FreeSlot(reinterpret_cast<Slot*>(object));
+    }
+
+    /**
+     * @brief Number of indexed objects
+     */
+    size_t Size() const { return size_; }
+
+    /**
+     * @brief Call fn(fd, object) for every indexed object
+     *
+     * fn must not add or remove entries.
+     */
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (size_t fd = 0; fd < by_fd_.size(); ++fd) {
+            if (by_fd_[fd]) {
+                fn(static_cast<int>(fd), *by_fd_[fd]);
+            }
+        }
+    }
+
+    /**
+     * @brief Destroy every indexed object (slabs are kept for reuse)
+     */
+    void Clear() {
+        for (size_t fd = 0; fd < by_fd_.size(); ++fd) {
+            if (by_fd_[fd]) {
+                Destroy(by_fd_[fd]);
+                by_fd_[fd] = nullptr;
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    // A free slot links to the next one; a used slot holds the object
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<T*> by_fd_;
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot* free_{nullptr};
+    size_t size_{0};
+
+    Slot* AllocateSlot() {
+        if (!free_) {
+            slabs_.emplace_back(new Slot[SLOTS_PER_SLAB]);
+            Slot* slab = slabs_.back().get();
+            for (size_t i = SLOTS_PER_SLAB; i > 0; --i) {
+                slab[i - 1].next = free_;
+                free_ = &slab[i - 1];
+            }
+        }
+        Slot* slot = free_;
+        free_ = slot->next;
+        return slot;
+    }
+
+    void FreeSlot(Slot* slot) {
+        slot->next = free_;
+        free_ = slot;
+    }
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_CONNECTION_TABLE_HPP
@@ -0,0 +1,153 @@
+/**
+ * @file HotRestart.hpp
+ * @brief Control protocol for handing a running server over to its successor
+ *
+ * A server with ServerConfig::handoff_path listens on that control socket.
+ * A new server process started with the same path connects to it and
+ * takes over:
+ *
+ *     successor                         predecessor
+ *     TAKEOVER [dictionary id]   --->
+ *                                <---   LISTENER (+ listening socket)
+ *                                       stops accepting, drains
+ *                                <---   CLIENTS (+ up to MAX_PASSED_FDS
+ *                                       idle connections), repeatedly
+ *                                <---   DONE, then exits
+ *     binds handoff_path itself
+ *
+ * The listening socket never closes, so connections queue in its backlog
+ * instead of failing while the processes swap. Established connections
+ * travel with the state they negotiated (inactivity timeout, compression);
+ * only connections with nothing buffered or executing are handed over.
+ *
+ * Every message is [KIND:1][LENGTH:2 BE][BODY], sent with one sendmsg so
+ * its descriptors ride on its first byte.
+ */
+
+#ifndef IPC_DEMO_HOT_RESTART_HPP
+#define IPC_DEMO_HOT_RESTART_HPP
+
+#include "ipc_sync/Protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @struct HandoffClient
+ * @brief Established connection moving between server processes
+ */
+struct HandoffClient {
+    int fd = -1;
+    uint32_t idle_timeout_ms = 0;                           // As negotiated, 0 = never
+    uint8_t compression = Protocol::COMPRESSION_REFUSED;    // Protocol::COMPRESSION_*
+};
+
+namespace hot_restart {
+
+constexpr uint32_t MAGIC = 0x49504348;   // "IPCH"
+constexpr uint8_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 3;
+constexpr size_t CLIENT_ENTRY_SIZE = 5;  // [IDLE_TIMEOUT_MS:4][COMPRESSION:1]
+
+// Blocking steps (connect, takeover, each CLIENTS batch) give up after this long
+constexpr int IO_TIMEOUT_MS = 2000;
+
+enum class MessageKind : uint8_t {
+    Takeover = 1,   // [MAGIC:4][VERSION:1][DICTIONARY_ID:4] (0 = no dictionary)
+    Listener = 2,   // [MAGIC:4][VERSION:1] + the listening socket
+    Clients = 3,    // [COUNT:1][COUNT x entry] + COUNT connections
+    Done = 4        // Empty; the predecessor is about to exit
+};
+
+/**
+ * @struct Message
+ * @brief One received control message (the caller owns fds)
+ */
+struct Message {
+    MessageKind kind = MessageKind::Done;
+    std::vector<uint8_t> body;
+    std::vector<int> fds;
+};
+
+/**
+ * @class MessageReader
+ * @brief Reassembles control messages from a stream socket
+ *
+ * Descriptors are queued in arrival order and each message claims as many
+ * as its kind carries. Works on blocking and non-blocking sockets alike.
+ */
+class MessageReader {
+public:
+    enum class Status {
+        Message,    // message was filled in
+        Again,      // Non-blocking socket (or timeout) with no complete message
+        Closed,     // Peer closed the socket
+        Error       // recv failed or the peer sent garbage
+    };
+
+    MessageReader() = default;
+    ~MessageReader();
+
+    // Disable copy/move
+    MessageReader(const MessageReader&) = delete;
+    MessageReader& operator=(const MessageReader&) = delete;
+    MessageReader(MessageReader&&) = delete;
+    MessageReader& operator=(MessageReader&&) = delete;
+
+    /**
+     * @brief Next complete message, reading from socket_fd as needed
+     * @param flags recv flags (MSG_DONTWAIT for a non-blocking poll)
+     */
+    Status Read(int socket_fd, Message& message, int flags = 0);
+
+    /**
+     * @brief Drop buffered bytes and close queued descriptors
+     */
+    void Reset();
+
+private:
+    bool TakeMessage(Message& message, bool& malformed);
+
+    std::vector<uint8_t> buffer_;
+    std::vector<int> fds_;
+};
+
+bool SendTakeover(int socket_fd, uint32_t dictionary_id);
+bool SendListener(int socket_fd, int listen_fd);
+bool SendDone(int socket_fd);
+
+/**
+ * @brief Send connections in batches of MAX_PASSED_FDS
+ * @return false if a batch could not be sent (the descriptors stay open
+ *         here either way; the peer holds duplicates of those it received)
+ */
+bool SendClients(int socket_fd, const std::vector<HandoffClient>& clients);
+
+/**
+ * @brief Decode a Takeover request
+ */
+bool ParseTakeover(const Message& message, uint32_t& dictionary_id);
+
+/**
+ * @brief Decode a Listener message (checks magic and version)
+ */
+bool ParseListener(const Message& message);
+
+/**
+ * @brief Decode a Clients batch, moving its descriptors into clients
+ * @return false if malformed (the descriptors are closed)
+ */
+bool ParseClients(Message& message, std::vector<HandoffClient>& clients);
+
+/**
+ * @brief Apply IO_TIMEOUT_MS to blocking sends and receives on socket_fd
+ */
+bool SetIoTimeout(int socket_fd);
+
+} // namespace hot_restart
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_HOT_RESTART_HPP
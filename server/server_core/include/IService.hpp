@@ -9,6 +9,7 @@
 #ifndef IPC_DEMO_ISERVICE_HPP
 #define IPC_DEMO_ISERVICE_HPP
 
+#include "ResponseBuilder.hpp"
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -41,8 +42,10 @@ public:
     /**
      * @brief Execute the service logic
      * 
-     * @param input Raw input data (already deserialized frame, starting after VERSION byte)
-     * @param input_len Length of input data
+     * @param input Raw input data (already deserialized frame, starting after VERSION byte).
+     *        Large payloads (Protocol::FLAG_FD_PAYLOAD) arrive as a read-only
+     *        memory mapping: never write through it or keep it after returning.
+     * @param input_len Length of input data (may exceed Protocol::MAX_PACKET_SIZE)
      * @param output Buffer to write response (including full frame)
      * @param output_len Maximum output buffer size
      * @return Number of bytes written to output, or 0 on error
@@ -50,11 +53,58 @@ public:
     virtual size_t Execute(const uint8_t* input, size_t input_len,
                           uint8_t* output, size_t output_len) = 0;
 
+    /**
+     * @brief Execute the service logic into a pre-stamped response frame
+     *
+     * Called by ServiceManager with the GetResponseRoutineId() header
+     * already in place: override it to write only the payload and return
+     * response.Finish(payload_len). The default runs Execute() over the
+     * whole buffer, so services that build their own frames keep working.
+     *
+     * @param input As for Execute()
+     * @param input_len As for Execute()
+     * @param response Frame being built in the outgoing buffer
+     * @return Number of bytes of the frame, or 0 on error
+     */
+    virtual size_t Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) {
+        return Execute(input, input_len, response.Frame(), response.FrameCapacity());
+    }
+
     /**
      * @brief Get service name for logging
      * @return Human-readable service name
      */
     virtual std::string GetName() const = 0;
+
+    /**
+     * @brief Whether Execute is cheap enough to run on the event-loop thread
+     *
+     * When the server offloads execution to a worker pool, requests for
+     * inline-safe services skip the hop and run directly on the reactor.
+     * Only return true for short, non-blocking handlers.
+     *
+     * @return true if the service may execute inline
+     */
+    virtual bool IsInlineSafe() const { return false; }
+
+    /**
+     * @brief Whether the response is a pure function of the request bytes
+     *
+     * Responses of idempotent services may be served from the
+     * ServiceManager's response cache without calling Execute. Only return
+     * true if Execute has no side effects and the same input always yields
+     * the same output (for at least GetCacheTtlMs()).
+     *
+     * @return true if responses may be cached
+     */
+    virtual bool IsIdempotent() const { return false; }
+
+    /**
+     * @brief How long a cached response stays valid
+     * @return Milliseconds, or 0 to keep it until evicted (only read when
+     *         IsIdempotent() is true)
+     */
+    virtual uint32_t GetCacheTtlMs() const { return 0; }
 };
 
 } // namespace ipc_demo
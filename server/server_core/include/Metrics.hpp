@@ -0,0 +1,209 @@
+/**
+ * @file Metrics.hpp
+ * @brief Per-routine request counters and latency histograms
+ *
+ * Recorded on the request path by ServiceManager (execution) and the
+ * reactors (queue wait, rejections, connections); read by the built-in
+ * stats routine (StatsService) and the Prometheus text dump.
+ */
+
+#ifndef IPC_DEMO_METRICS_HPP
+#define IPC_DEMO_METRICS_HPP
+
+#include "ipc_sync/LogLinearBuckets.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @struct HistogramSnapshot
+ * @brief Merged latency histogram (nanoseconds)
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets;   // Metrics::BUCKET_COUNT entries
+
+    /**
+     * @brief Value below which a fraction q of the samples fall
+     * @param q Quantile in [0, 1]
+     * @return Upper bound of the bucket holding the quantile (at most
+     *         max_ns), or 0 without samples
+     */
+    uint64_t Percentile(double q) const;
+};
+
+/**
+ * @struct RoutineMetrics
+ * @brief Totals for one routine ID
+ */
+struct RoutineMetrics {
+    uint32_t routine_id = 0;
+    std::string name;
+    uint64_t requests = 0;
+    uint64_t errors = 0;      // No response (unknown routine, failed or throwing service)
+    uint64_t rejected = 0;    // Answered with SERVER_BUSY instead of executing
+    uint64_t cache_hits = 0;  // Answered from the response cache (also counted in requests)
+    uint64_t bytes_in = 0;    // Request payload bytes
+    uint64_t bytes_out = 0;   // Response frame bytes
+    HistogramSnapshot queue_wait;   // Worker pool queue (offloaded requests only)
+    HistogramSnapshot execution;    // ServiceManager::ExecuteService
+};
+
+/**
+ * @struct MetricsSnapshot
+ * @brief Everything Metrics recorded so far
+ */
+struct MetricsSnapshot {
+    uint64_t connections_opened = 0;
+    uint64_t connections_closed = 0;
+    std::vector<RoutineMetrics> routines;   // Sorted by routine ID, "other" last
+};
+
+/**
+ * @class Metrics
+ * @brief Low-overhead request instrumentation
+ *
+ * Every recording thread owns a shard, so recording is a handful of plain
+ * (relaxed, uncontended) atomic stores: no locks, no shared cache lines.
+ * Snapshot() sums the shards. A routine gets its own slot once registered
+ * (up to MAX_ROUTINES); anything else is counted under OTHER_ROUTINE_ID so
+ * clients cannot grow the tables with made-up routine IDs.
+ *
+ * Histograms are log-linear (HDR-style): 8 sub-buckets per power of two,
+ * so every recorded value is reported within 12.5% of its true value.
+ *
+ * Shards live as long as the Metrics instance, so record from long-lived
+ * threads (reactors, pool workers).
+ *
+ * Thread Safety: all methods may be called from any thread.
+ */
+class Metrics {
+public:
+    static constexpr size_t MAX_ROUTINES = 64;
+    static constexpr uint32_t OTHER_ROUTINE_ID = 0xFFFFFFFF;
+
+    // Histogram geometry: values up to 2^(MAX_EXPONENT + 1) ns (~36 minutes)
+    using Buckets = LogLinearBuckets<3>;
+    static constexpr unsigned SUB_BUCKET_BITS = Buckets::SUB_BUCKET_BITS;
+    static constexpr size_t SUB_BUCKETS = Buckets::SUB_BUCKETS;
+    static constexpr unsigned MAX_EXPONENT = Buckets::MAX_EXPONENT;
+    static constexpr size_t BUCKET_COUNT = Buckets::BUCKET_COUNT;
+
+    Metrics();
+    ~Metrics();
+
+    // Disable copy/move
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+    Metrics& operator=(Metrics&&) = delete;
+
+    /**
+     * @brief Give a routine its own slot
+     * @param routine_id Request routine ID
+     * @param name Label used in snapshots
+     * @return false if all MAX_ROUTINES slots are taken (the routine is
+     *         then counted as "other"); true if registered or already known
+     */
+    bool RegisterRoutine(uint32_t routine_id, const std::string& name);
+
+    /**
+     * @brief Record one executed request
+     * @param error True if the request produced no response
+     */
+    void RecordRequest(uint32_t routine_id, size_t bytes_in, size_t bytes_out,
+                       bool error, uint64_t execution_ns);
+
+    /**
+     * @brief Record how long an offloaded request waited for a worker
+     */
+    void RecordQueueWait(uint32_t routine_id, uint64_t wait_ns);
+
+    /**
+     * @brief Record a request answered with SERVER_BUSY
+     */
+    void RecordRejected(uint32_t routine_id);
+
+    /**
+     * @brief Record a request answered from the response cache
+     */
+    void RecordCacheHit(uint32_t routine_id);
+
+    void RecordConnectionOpened();
+    void RecordConnectionClosed();
+
+    /**
+     * @brief Sum all shards
+     * @return Routines that were registered or saw traffic
+     */
+    MetricsSnapshot Snapshot() const;
+
+    /**
+     * @brief Render a snapshot in the Prometheus text exposition format
+     */
+    static std::string FormatPrometheus(const MetricsSnapshot& snapshot);
+
+    /**
+     * @brief Monotonic clock used for all durations, in nanoseconds
+     */
+    static uint64_t NowNs();
+
+    /**
+     * @brief Histogram bucket of a value
+     */
+    static size_t BucketIndex(uint64_t value) { return Buckets::Index(value); }
+
+    /**
+     * @brief Largest value stored in a bucket
+     */
+    static uint64_t BucketUpperBound(size_t index) { return Buckets::UpperBound(index); }
+
+private:
+    // Open-addressed routine table; slot SLOT_COUNT - 1 is "other"
+    static constexpr size_t TABLE_SIZE = 2 * MAX_ROUTINES;
+    static constexpr size_t SLOT_COUNT = TABLE_SIZE + 1;
+    static constexpr size_t OTHER_SLOT = TABLE_SIZE;
+    static constexpr uint32_t EMPTY_SLOT = OTHER_ROUTINE_ID;
+
+    struct Histogram;
+    struct RoutineCounters;
+    struct Shard;
+
+    /**
+     * @brief Slot of a routine, without locking
+     * @return Its slot, or OTHER_SLOT if it was never registered
+     */
+    size_t SlotFor(uint32_t routine_id) const;
+
+    /**
+     * @brief The calling thread's shard (created on first use)
+     */
+    Shard& LocalShard();
+
+    /**
+     * @brief Counters of a slot in the calling thread's shard
+     */
+    RoutineCounters& Counters(uint32_t routine_id);
+
+    const uint64_t id_;   // Distinguishes instances in the per-thread shard cache
+
+    std::array<std::atomic<uint32_t>, TABLE_SIZE> slot_ids_;
+    std::array<std::string, SLOT_COUNT> slot_names_;   // Written before the ID is published
+    size_t registered_{0};
+
+    mutable std::mutex mutex_;   // Registration and the shard list
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_METRICS_HPP
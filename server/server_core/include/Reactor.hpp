@@ -0,0 +1,535 @@
+/**
+ * @file Reactor.hpp
+ * @brief Per-thread event loop (epoll or io_uring) serving a slice of the client connections
+ *
+ * Each reactor owns:
+ * - Its own epoll or io_uring instance and event-loop thread
+ * - Its own slice of the connected clients
+ * - Its own inactivity timer (a timing wheel driven by a timerfd)
+ * - An eventfd used by the acceptor to hand over new connections and by
+ *   worker threads to hand back finished responses
+ */
+
+#ifndef IPC_DEMO_REACTOR_HPP
+#define IPC_DEMO_REACTOR_HPP
+
+#include "ConnectionTable.hpp"
+#include "HotRestart.hpp"
+#include "ServiceManager.hpp"
+#include "TimerWheel.hpp"
+#include "ipc_sync/BufferPool.hpp"
+#include "ipc_sync/Compression.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/IoUring.hpp"
+#include "ipc_sync/LargePayload.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/ShmTransport.hpp"
+#include "ipc_sync/Tracer.hpp"
+#include <sys/uio.h>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace thread_pool {
+class IExecutor;
+}
+
+namespace ipc_demo {
+
+/**
+ * @enum OverloadPolicy
+ * @brief What a reactor does with requests beyond the configured bounds
+ */
+enum class OverloadPolicy {
+    Backpressure,  // Stop reading from the connection until it drains
+    Reject         // Answer at once with a SERVER_BUSY frame
+};
+
+/**
+ * @enum IoBackend
+ * @brief How an event loop waits for and performs socket I/O
+ */
+enum class IoBackend {
+    Epoll,   // Readiness via epoll, then recvmsg/sendmsg per socket
+    IoUring  // Completions via io_uring (multishot receive, batched sends); falls back to Epoll
+};
+
+/**
+ * @struct ReactorOptions
+ * @brief Per-reactor tunables (filled in from ServerConfig)
+ */
+struct ReactorOptions {
+    bool shared_memory = true;   // Accept shared-memory negotiation from clients
+    bool compression = true;     // Accept compression negotiation from clients
+    size_t compression_threshold = 512;  // Response payloads from this size are compressed
+    std::shared_ptr<const CompressionDictionary> compression_dictionary;  // Offered by matching clients
+    size_t max_pending_per_connection = 0;  // Queued or executing requests per connection, 0 = unlimited
+    OverloadPolicy overload_policy = OverloadPolicy::Backpressure;
+    uint32_t inactivity_timeout_ms = Protocol::INACTIVITY_TIMEOUT_SEC * 1000;  // Per connection, 0 = never
+    uint32_t max_inactivity_timeout_ms = 0;  // Cap on client-requested timeouts, 0 = inactivity_timeout_ms
+    IoBackend io_backend = IoBackend::Epoll;
+    int cpu = -1;                    // CPU the reactor thread pins itself to, -1 = unpinned
+    uint32_t busy_poll_us = 0;       // Spin this long after the last event before blocking, 0 = always block
+    double trace_sample_rate = 0.0;  // Fraction of requests traced, 0 = tracing off
+};
+
+/**
+ * @struct PendingRequest
+ * @brief Untagged request waiting behind an offloaded one
+ */
+struct PendingRequest {
+    std::vector<uint8_t> frame;
+    std::shared_ptr<const PayloadView> payload;  // Set for FLAG_FD_PAYLOAD frames
+    uint64_t received_ticks = 0;                 // Tracing: when the frame was read
+};
+
+struct ClientInfo;
+
+/**
+ * @struct StreamInfo
+ * @brief Subscription of a client: a routine the reactor runs and pushes every interval
+ */
+struct StreamInfo {
+    ClientInfo* client;
+    uint32_t stream_id;             // Request ID of the subscribe frame, echoed on every frame
+    uint32_t routine_id;
+    std::vector<uint8_t> request;   // Payload the routine runs with each time
+    uint32_t interval_ms;
+    uint32_t credits;               // Frames the client still accepts
+    uint64_t next_ms = 0;           // Due time of the next frame
+    TimerNode timer;                // Scheduled while credits remain
+};
+
+/**
+ * @struct ClientInfo
+ * @brief Information about connected client
+ */
+struct ClientInfo {
+    int fd;
+    uint64_t connection_id;   // Distinguishes reuses of the same fd
+    uint64_t last_activity_ms = 0;      // Reactor's cached clock at the last request bytes
+    uint32_t idle_timeout_ms = 0;       // Inactivity timeout of this connection, 0 = never
+    TimerNode idle_timer;               // Due no earlier than last_activity_ms + idle_timeout_ms
+    FrameParser parser;       // Reassembles frames from the byte stream (pooled ring)
+    std::vector<uint8_t> send_buffer;   // Response bytes the socket did not accept yet
+    size_t send_offset = 0;             // First unsent byte in send_buffer
+    bool write_armed = false;           // EPOLLOUT registered
+    bool closing = false;               // Fatal I/O error, close after current event
+    bool request_in_flight = false;                     // Offloaded untagged request not yet answered
+    std::list<PendingRequest> pending_requests;         // Untagged frames queued behind it (ordering)
+    size_t offloaded = 0;                 // Requests queued on or running in the worker pool
+    bool stalled = false;                 // Worker pool was full; front of pending_requests retries
+    bool read_paused = false;             // Backpressure: frames are left unread
+    std::vector<int> received_fds;        // Descriptors passed with SCM_RIGHTS, not yet claimed
+    std::unique_ptr<ShmTransport> shm;    // Set once shared memory was negotiated
+    std::vector<std::unique_ptr<StreamInfo>> streams;  // At most Protocol::MAX_STREAMS_PER_CONNECTION
+    uint8_t compression = Protocol::COMPRESSION_REFUSED; // Negotiated codec (Protocol::COMPRESSION_*)
+
+    // io_uring backend only
+    size_t uring_ops = 0;                 // Submitted requests whose last completion is outstanding
+    bool recv_armed = false;              // Multishot recvmsg outstanding
+    bool doorbell_armed = false;          // Multishot poll on the shm request doorbell outstanding
+    bool send_queued = false;             // Waiting in the reactor's send queue
+    std::vector<uint8_t> inflight_send;   // Bytes of the SEND in flight (the kernel reads them)
+    size_t inflight_offset = 0;           // First byte of inflight_send not yet confirmed sent
+    std::vector<uint8_t> recv_backlog;    // Received while paused, beyond the parser ring's room
+    uint64_t received_ticks = 0;          // Tracing: when the frames being processed were read
+
+    explicit ClientInfo(BufferPool& buffers) : parser(buffers) {}
+};
+
+/**
+ * @class Reactor
+ * @brief Event loop that serves the client connections assigned to it
+ *
+ * Single Responsibility: Reads requests, dispatches them to the
+ * ServiceManager and writes responses for its own clients.
+ * Accepting connections is left to the owner (UDSServer).
+ *
+ * I/O: client sockets are edge-triggered, so every readable event drains
+ * the socket until EAGAIN. Bytes accumulate in the client's FrameParser
+ * and every complete frame is dispatched, however the stream was split
+ * or coalesced. Responses the socket cannot take immediately are queued
+ * and flushed on EPOLLOUT.
+ *
+ * Memory: connection state sits in ConnectionTable slab slots indexed by
+ * fd. A client's FrameParser borrows its ring from the reactor's
+ * BufferPool only while request bytes are buffered, so an idle connection
+ * costs one slot and churning connections do not touch the allocator.
+ *
+ * Execution: with a worker pool, requests for services that are not
+ * inline-safe run on the pool and the response is handed back to this
+ * reactor for sending. A connection has at most one offloaded untagged
+ * request at a time; later untagged frames wait in
+ * ClientInfo::pending_requests so responses leave in request order.
+ * Frames carrying a request ID (Protocol::FLAG_REQUEST_ID) skip the queue,
+ * run concurrently and are answered as they finish, with the ID echoed
+ * back so a pipelining client can match them.
+ *
+ * Large payloads: a FLAG_FD_PAYLOAD frame only carries the payload size;
+ * the bytes come in a sealed memfd passed with the frame. The reactor
+ * claims the descriptors in arrival order, maps each one read-only and
+ * hands the mapping to the service, so the payload is never copied.
+ *
+ * Overload: a connection counts its offloaded and queued requests against
+ * ReactorOptions::max_pending_per_connection, and the worker pool may
+ * refuse tasks beyond its own bound. With OverloadPolicy::Backpressure the
+ * reactor stops consuming the connection's frames (EPOLLIN is disarmed or
+ * the request ring is left alone) until requests complete; a request the
+ * pool refused is retried every STALL_RETRY_MS. With OverloadPolicy::Reject
+ * such requests are answered at once with a Protocol::SERVER_BUSY frame.
+ *
+ * Shared memory: a client may pass a memfd and two eventfds with the
+ * SHM_NEGOTIATE routine. From then on requests are read from and
+ * responses written to the ShmTransport rings; the request doorbell is
+ * registered in this reactor's epoll set. The socket stays open to detect
+ * disconnects. Response bytes the ring cannot take wait in send_buffer
+ * until the client frees space and rings the doorbell.
+ *
+ * io_uring backend (ReactorOptions::io_backend): one io_uring instance
+ * replaces epoll. Each client socket has a multishot recvmsg drawing on a
+ * ring of provided buffers, so a receive costs no syscall of its own; the
+ * bytes are copied into the FrameParser and the buffer is recycled. The
+ * wakeup eventfd, timerfd and shm doorbells use multishot polls. Responses
+ * are appended to send_buffer and the connection's next SEND is queued
+ * for the following io_uring_enter, which batches one send per connection
+ * per loop iteration; only one SEND is in flight per connection, which
+ * keeps responses in order. Backpressure cancels the multishot recvmsg;
+ * bytes that were already in flight wait in recv_backlog. A closed
+ * connection stays allocated until its outstanding requests completed.
+ * If io_uring is unavailable the reactor logs a warning and uses epoll.
+ *
+ * Inactivity: every connection has a timer in the reactor's TimerWheel.
+ * Activity only records the cached loop clock in last_activity_ms; when
+ * the timer comes due the reactor either closes the connection or, if it
+ * was active meanwhile, re-arms the timer for the remaining time. So a
+ * busy connection costs one wheel operation per timeout period, and a
+ * tick only visits the timers that are due. The timeout defaults to
+ * ReactorOptions::inactivity_timeout_ms; a client may pick its own with
+ * the IDLE_TIMEOUT routine (up to max_inactivity_timeout_ms).
+ *
+ * Streams: a client may subscribe to a routine (STREAM_SUBSCRIBE) with an
+ * interval and a number of credits. The reactor runs the routine with the
+ * subscribed payload at once and then every interval, driven by a
+ * second TimerWheel of STREAM_TICK_MS resolution, and pushes each response
+ * tagged with the stream ID. Every frame spends a credit; a stream without
+ * credits is unscheduled until the client grants more (STREAM_CREDIT), so
+ * a slow consumer holds at most its credits' worth of frames in the
+ * connection's buffers. While streams are scheduled the loop waits at most
+ * STREAM_TICK_MS. Streams end with a STREAM_END frame (cancelled, failed)
+ * or silently with their connection.
+ *
+ * Compression: a client may negotiate LZ4 (COMPRESSION_NEGOTIATE), with
+ * the server's dictionary if it offers the same one. Compressed request
+ * payloads are inflated into a reactor buffer before dispatch, so services
+ * never see them; responses of at least compression_threshold payload
+ * bytes are compressed in SendResponseFrame when that makes them smaller,
+ * for the socket and the shared-memory ring alike.
+ *
+ * Placement: with ReactorOptions::cpu the reactor thread pins itself
+ * before it runs and then allocates and touches its first frame buffers,
+ * so they sit on that CPU's NUMA node (first touch); everything allocated
+ * later on the reactor thread lands there as well.
+ *
+ * Busy polling (ReactorOptions::busy_poll_us): after any event the loop
+ * stops sleeping and polls with a zero timeout, and also reads every
+ * shared-memory request ring directly, with the rings' reader-waiting
+ * flag left clear so clients skip the doorbell write. Once nothing has
+ * arrived for busy_poll_us, the flags are set again and the loop goes back
+ * to its blocking wait, so an idle reactor costs no CPU.
+ *
+ * Hot restart: DetachClients() hands the connections that are between
+ * requests (nothing buffered, queued, executing or unsent) to the caller
+ * for passing to another process, with their negotiated inactivity
+ * timeout and compression, and removes them without closing them. Idle
+ * connections that cannot move (shared memory, streams, a dictionary the
+ * successor lacks, any io_uring connection: its multishot receive cannot
+ * be recalled with nothing in flight) are closed instead, so their clients
+ * reconnect; busy ones are left to finish. AdoptClient() is the receiving
+ * side.
+ *
+ * Tracing (ReactorOptions::trace_sample_rate): a sampled request, or one
+ * the client traces, gets a trace::Span stamped as it is read, parsed,
+ * looked up, executed and sent. An offloaded request's span travels with
+ * the task and its Completion and is recorded here, after the send.
+ *
+ * Thread Safety: AddClient(), AdoptClient(), DetachClients() and
+ * GetClientCount() may be called from any thread; everything else runs on
+ * the reactor thread.
+ */
+class Reactor {
+public:
+    /**
+     * @brief Construct reactor (no resources are acquired until Start)
+     * @param index Reactor index, used in log messages
+     * @param service_manager Service registry used to execute requests
+     * @param options Reactor tunables
+     */
+    Reactor(size_t index, std::shared_ptr<ServiceManager> service_manager,
+            const ReactorOptions& options = ReactorOptions{});
+
+    ~Reactor();
+
+    // Disable copy/move
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+
+    /**
+     * @brief Create epoll/timer/wakeup descriptors and start the event-loop thread
+     * @param worker_pool Pool for offloaded execution (not owned), or
+     *        nullptr to execute every request inline. Must outlive Stop()
+     *        or be shut down before it.
+     * @return true if started successfully
+     */
+    bool Start(thread_pool::IExecutor* worker_pool = nullptr);
+
+    /**
+     * @brief Stop the event-loop thread and close all of its clients
+     */
+    void Stop();
+
+    /**
+     * @brief Hand a freshly accepted (non-blocking) client over to this reactor
+     * @param client_fd Connected client socket
+     * @return true if queued; on false the caller still owns the descriptor
+     */
+    bool AddClient(int client_fd);
+
+    /**
+     * @brief Take over a connection another server process handed off
+     * @param client Connection with the state it negotiated there
+     * @return true if queued; on false the caller still owns the descriptor
+     */
+    bool AdoptClient(const HandoffClient& client);
+
+    /**
+     * @brief Detach the connections that are between requests (see Hot restart)
+     * @param dictionary_id Compression dictionary of the receiving server
+     *        (0 = none): connections using another one are not handed over
+     * @return Detached connections, now owned by the caller; empty if the
+     *         reactor is not running. Blocks until the reactor thread ran.
+     */
+    std::vector<HandoffClient> DetachClients(uint32_t dictionary_id);
+
+    /**
+     * @brief Get number of clients served by this reactor
+     * @return Client count (including connections still being handed over)
+     */
+    size_t GetClientCount() const { return client_count_.load(); }
+
+    /**
+     * @brief Get reactor index
+     */
+    size_t GetIndex() const { return index_; }
+
+    /**
+     * @brief Backend in use (valid after Start; may be Epoll after a fallback)
+     */
+    IoBackend GetIoBackend() const { return ring_ ? IoBackend::IoUring : IoBackend::Epoll; }
+
+    // Poll interval while a connection waits for worker pool room
+    static constexpr int STALL_RETRY_MS = 1;
+
+    // Inactivity timer resolution (timeouts fire at most this late)
+    static constexpr uint32_t IDLE_TICK_MS = 250;
+
+    // Stream timer resolution, also the shortest stream interval
+    static constexpr uint32_t STREAM_TICK_MS = 5;
+
+    // io_uring backend geometry: submission queue size and provided receive buffers
+    static constexpr unsigned URING_ENTRIES = 256;
+    static constexpr unsigned URING_RECV_BUFFERS = 128;
+    static constexpr unsigned URING_RECV_BUFFER_SIZE = 4096;
+
+    // Frame buffers allocated together when the reactor's pool runs dry
+    static constexpr size_t BUFFERS_PER_SLAB = 8;
+
+private:
+    /**
+     * @struct Completion
+     * @brief Response produced on a worker thread, waiting to be sent
+     */
+    struct Completion {
+        int fd;
+        uint64_t connection_id;
+        bool ordered;                   // Untagged request that blocked the connection
+        std::vector<uint8_t> response;  // Untagged frame as written by the service
+        std::optional<uint32_t> request_id;
+        std::unique_ptr<trace::Span> span;  // Traced request: stamped up to Executed
+    };
+
+    size_t index_;
+    std::shared_ptr<ServiceManager> service_manager_;
+    ReactorOptions options_;
+    thread_pool::IExecutor* worker_pool_{nullptr};
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    int epoll_fd_{-1};
+    int timer_fd_{-1};
+    int wake_fd_{-1};
+    bool timer_armed_{false};
+
+    // Inactivity timeouts; now_ms_ is read once per loop iteration
+    uint64_t now_ms_{0};
+    TimerWheel idle_timers_;
+    TimerWheel stream_timers_;
+    std::vector<uint8_t> inflate_buffer_;   // Decompressed request payload, sized on first negotiation
+    std::vector<uint8_t> deflate_buffer_;   // Compressed response frame
+
+    // Busy polling: spinning_ while events arrived within busy_poll_us
+    bool spinning_{false};
+    uint64_t last_active_us_{0};
+    std::vector<int> shm_poll_fds_;         // Scratch list of shared-memory clients
+
+    trace::Sampler trace_sampler_;
+
+    // Connection state: slab slots indexed by fd, frame buffers borrowed
+    // from the pool only while request bytes are buffered
+    BufferPool buffer_pool_{Protocol::MAX_PACKET_SIZE * 2, BUFFERS_PER_SLAB};
+    ConnectionTable<ClientInfo> clients_;
+    std::unordered_map<int, int> shm_doorbells_;  // Request eventfd -> client fd
+    std::vector<std::pair<int, uint64_t>> stalled_clients_;  // (fd, connection_id) waiting for pool room
+    std::atomic<size_t> client_count_{0};
+    uint64_t next_connection_id_{0};
+
+    // Connections accepted (or adopted) by the acceptor but not yet registered here
+    std::mutex pending_mutex_;
+    std::vector<HandoffClient> pending_clients_;
+
+    // DetachClients() request, answered by the reactor thread
+    std::mutex handoff_mutex_;
+    std::condition_variable handoff_cv_;
+    bool handoff_requested_{false};
+    uint32_t handoff_dictionary_id_{0};
+    std::vector<HandoffClient> handoff_clients_;
+
+    // Responses finished by worker threads
+    std::mutex completion_mutex_;
+    std::vector<Completion> completions_;
+
+    // io_uring backend (null with epoll)
+    std::unique_ptr<IoUring> ring_;
+    struct msghdr recv_msg_;             // Layout of every multishot recvmsg buffer
+    std::vector<std::pair<int, uint64_t>> send_queue_;  // (fd, connection_id) with a SEND to submit
+    std::vector<ClientInfo*> retired_clients_;  // Closed, detached from clients_, awaiting completions
+
+    // Reactor thread main loop
+    void ThreadFunc();
+    void RunUringLoop();
+
+    // Event handlers
+    void HandleWakeup();
+    void HandleCompletions();
+    bool RegisterClient(const HandoffClient& pending);
+    bool QueueClient(const HandoffClient& pending);
+    void HandleDetachRequest();
+    bool IsBetweenRequests(ClientInfo& client) const;
+    ClientInfo* FindClient(int fd, uint64_t connection_id) const;
+    bool HandleClientData(int client_fd);
+    bool HandleClientWritable(int client_fd);
+    bool HandleShmDoorbell(int client_fd);
+    void HandleClientClose(int client_fd);
+    void HandleInactivityTimer();
+    void HandleIdleTimeout(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                           std::optional<uint32_t> request_id);
+
+    // Streams
+    void HandleStreamSubscribe(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                               std::optional<uint32_t> request_id);
+    void HandleStreamCredit(ClientInfo& client, const uint8_t* payload, size_t payload_len);
+    void HandleStreamCancel(ClientInfo& client, const uint8_t* payload, size_t payload_len);
+    void HandleStreamTimers();
+    void PushStreamFrame(StreamInfo& stream);
+    void ScheduleStream(StreamInfo& stream);
+    StreamInfo* FindStream(ClientInfo& client, uint32_t stream_id);
+    void SendStreamEnd(ClientInfo& client, std::optional<uint32_t> stream_id, uint8_t status);
+    void RemoveStream(ClientInfo& client, uint32_t stream_id);
+    void ClearStreams(ClientInfo& client);
+    int LoopTimeoutMs() const;
+
+    // Protocol handling
+    bool ProcessFrames(ClientInfo& client);
+    void DispatchRequest(ClientInfo& client, const FrameView& frame);
+    size_t ProcessClientRequest(ClientInfo& client, const uint8_t* data, size_t len,
+                                std::shared_ptr<const PayloadView> large_payload = nullptr,
+                                uint64_t received_ticks = 0);
+    std::shared_ptr<const PayloadView> TakeLargePayload(ClientInfo& client, const FrameView& frame);
+    bool OffloadRequest(ClientInfo& client, uint32_t routine_id,
+                        const uint8_t* payload, size_t payload_len,
+                        std::optional<uint32_t> request_id,
+                        const std::shared_ptr<const PayloadView>& large_payload,
+                        bool& pool_full, std::unique_ptr<trace::Span> span = nullptr);
+    void DrainPendingRequests(ClientInfo& client);
+    bool AtConnectionLimit(const ClientInfo& client) const;
+    bool ShouldPauseReading(const ClientInfo& client) const;
+    bool ResumeReading(ClientInfo& client);
+    void RetryStalledClients();
+    void SendBusyResponse(ClientInfo& client, uint32_t routine_id, std::optional<uint32_t> request_id);
+    void HandleShmNegotiate(ClientInfo& client, std::optional<uint32_t> request_id);
+    bool DrainShmRequests(ClientInfo& client);
+    bool SendShmResponse(ClientInfo& client, const uint8_t* data, size_t len);
+    bool FlushShmBacklog(ClientInfo& client);
+    void NotifyShmReader(ClientInfo& client);
+    bool SendResponseFrame(ClientInfo& client, const uint8_t* frame, size_t len,
+                           std::optional<uint32_t> request_id);
+    bool SendResponse(ClientInfo& client, const struct iovec* iov, size_t iovcnt);
+    bool FlushSendBuffer(ClientInfo& client);
+    bool SetWriteInterest(ClientInfo& client, bool enabled);
+    bool SetReadInterest(ClientInfo& client, bool enabled);
+    bool UpdateInterest(ClientInfo& client, bool readable, bool writable);
+    void PostCompletion(Completion completion);
+    void Signal();
+
+    // io_uring backend
+    bool CreateUring();
+    io_uring_sqe* NextSqe();
+    bool WatchUring(int fd, uint64_t user_data);
+    void HandleUringCompletion(const io_uring_cqe& cqe);
+    ClientInfo* ReleaseUringRequest(const io_uring_cqe& cqe);
+    bool HandleUringRecv(ClientInfo& client, const io_uring_cqe& cqe);
+    bool HandleUringSent(ClientInfo& client, const io_uring_cqe& cqe);
+    bool ConsumeReceived(ClientInfo& client, const uint8_t* data, size_t len);
+    bool ArmUringRecv(ClientInfo& client);
+    void CancelUringRecv(ClientInfo& client);
+    bool WatchShmDoorbell(ClientInfo& client);
+    void QueueUringSend(ClientInfo& client);
+    void FlushUringSends();
+    bool StartUringSend(ClientInfo& client);
+    bool SubmitUringSend(ClientInfo& client);
+    void RetireUringClient(ClientInfo* client);
+    void DrainUring();
+
+    // Compression
+    void HandleCompressionNegotiate(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                                    std::optional<uint32_t> request_id);
+    const CompressionDictionary* DictionaryFor(const ClientInfo& client) const;
+    void AllocateCompressionBuffers();
+
+    // Placement and busy polling
+    void PlaceThread();
+    void UpdateBusyPoll(bool active);
+    bool PollShmClients();
+    bool ArmShmDoorbells();
+
+    // Utility methods
+    bool CreateInactivityTimer();
+    bool ArmInactivityTimer(bool enabled);
+    void ScheduleIdleTimer(ClientInfo& client);
+    bool CreateWakeupEvent();
+    void CloseAllClients();
+    void CloseDescriptors();
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_REACTOR_HPP
@@ -0,0 +1,131 @@
+/**
+ * @file ResponseBuilder.hpp
+ * @brief Response frame written in place behind a pre-encoded header
+ *
+ * ServiceManager encodes each service's response header once, at
+ * registration, and hands services a ResponseBuilder over the buffer the
+ * reactor sends from: a service only writes its payload and calls
+ * Finish(), which fills in the length and END byte.
+ */
+
+#ifndef IPC_DEMO_RESPONSE_BUILDER_HPP
+#define IPC_DEMO_RESPONSE_BUILDER_HPP
+
+#include "ipc_sync/ByteOrder.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Schema.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ipc_demo {
+
+/**
+ * @class ResponseBuilder
+ * @brief [START][LEN][ROUTINE_ID][VERSION][payload][END] over a caller's buffer
+ *
+ * The header is copied into the buffer on construction (LEN is patched by
+ * Finish()); nothing is allocated. A buffer too small for an empty frame
+ * gives a builder with no payload room whose Finish() returns 0.
+ * @code
+ * size_t MyService::Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) {
+ *     ByteBuffer payload(response.Payload(), response.PayloadCapacity());
+ *     payload.PutInt(42);
+ *     return response.Finish(payload.Position());
+ * }
+ * @endcode
+ */
+class ResponseBuilder {
+public:
+    using Header = std::array<uint8_t, Protocol::FRAME_HEADER_SIZE>;
+
+    /**
+     * @brief Encode the constant part of a response header (LEN is left 0)
+     */
+    static Header EncodeHeader(uint32_t routine_id) {
+        Header header{};
+        header[0] = Protocol::START_BYTE;
+        byte_order::StoreBigEndian<uint32_t>(header.data() + 5, routine_id);
+        header[Protocol::FRAME_HEADER_SIZE - 1] = Protocol::VERSION;
+        return header;
+    }
+
+    /**
+     * @param header Pre-encoded header (see EncodeHeader)
+     * @param output Buffer the frame is written to
+     * @param capacity Size of output
+     */
+    ResponseBuilder(const Header& header, uint8_t* output, size_t capacity)
+        : output_(output)
+        , capacity_(capacity >= Protocol::GetMinFrameSize() ? capacity : 0) {
+        if (capacity_ > 0) {
+            std::memcpy(output_, header.data(), header.size());
+        }
+    }
+
+    ResponseBuilder(uint32_t routine_id, uint8_t* output, size_t capacity)
+        : ResponseBuilder(EncodeHeader(routine_id), output, capacity) {
+    }
+
+    /**
+     * @brief Routine ID stamped into the header
+     */
+    uint32_t RoutineId() const {
+        return capacity_ > 0 ? byte_order::LoadBigEndian<uint32_t>(output_ + 5) : 0;
+    }
+
+    /**
+     * @brief Where the payload goes (right after the header)
+     */
+    uint8_t* Payload() { return output_ + Protocol::FRAME_HEADER_SIZE; }
+
+    /**
+     * @brief Payload bytes that fit (room for END is kept)
+     */
+    size_t PayloadCapacity() const {
+        return capacity_ > 0 ? capacity_ - Protocol::GetMinFrameSize() : 0;
+    }
+
+    /**
+     * @brief The whole buffer, for services that write their own frame
+     */
+    uint8_t* Frame() { return output_; }
+    size_t FrameCapacity() const { return capacity_; }
+
+    /**
+     * @brief Complete the frame after payload_len payload bytes
+     * @return Frame length, or 0 if the payload does not fit
+     */
+    size_t Finish(size_t payload_len) {
+        if (capacity_ == 0 || payload_len > PayloadCapacity()) {
+            return 0;
+        }
+        size_t frame_len = Protocol::GetMinFrameSize() + payload_len;
+        byte_order::StoreBigEndian<uint32_t>(output_ + 1, static_cast<uint32_t>(frame_len));
+        output_[frame_len - 1] = Protocol::END_BYTE;
+        return frame_len;
+    }
+
+    /**
+     * @brief Encode a schema message as the payload and complete the frame
+     * @return Frame length, or 0 if the message does not fit
+     */
+    template <typename T>
+    size_t Encode(const T& message) {
+        size_t size = MessageCodec<T>::Size(message);
+        if (capacity_ == 0 || size > PayloadCapacity()) {
+            return 0;
+        }
+        MessageCodec<T>::Write(Payload(), message);
+        return Finish(size);
+    }
+
+private:
+    uint8_t* output_;
+    size_t capacity_;   // 0 if output cannot hold a frame
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_RESPONSE_BUILDER_HPP
@@ -0,0 +1,141 @@
+/**
+ * @file ResponseCache.hpp
+ * @brief Sharded, bounded LRU cache of response frames for idempotent services
+ *
+ * Used by ServiceManager: a request for a service that declares itself
+ * idempotent (IService::IsIdempotent) is answered with the stored response
+ * frame when the same routine saw the same request bytes before.
+ */
+
+#ifndef IPC_DEMO_RESPONSE_CACHE_HPP
+#define IPC_DEMO_RESPONSE_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @struct ResponseCacheOptions
+ * @brief Bounds of a ResponseCache
+ */
+struct ResponseCacheOptions {
+    size_t capacity = 4096;             // Entries across all shards, 0 disables the cache
+    size_t max_request_bytes = 256;     // Larger requests are executed, never cached
+    size_t max_response_bytes = 1024;   // Larger responses are not stored
+};
+
+/**
+ * @struct ResponseCacheStats
+ * @brief Counters since construction (entries is current)
+ */
+struct ResponseCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;        // Lookups that found nothing (or an expired entry)
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;     // Least recently used entries dropped for room
+    size_t entries = 0;
+};
+
+/**
+ * @class ResponseCache
+ * @brief (routine ID, request bytes) -> response frame
+ *
+ * Keys are a 64-bit hash of the routine ID and request bytes; entries keep
+ * the request bytes too, so a hash collision is a miss, never a wrong
+ * answer. The key space is split into SHARDS independently locked LRU
+ * lists, each holding capacity / SHARDS entries, so concurrent reactors and
+ * workers rarely contend.
+ *
+ * Thread Safety: all methods may be called from any thread.
+ */
+class ResponseCache {
+public:
+    static constexpr size_t SHARDS = 16;
+
+    /**
+     * @struct Key
+     * @brief Hashed request, computed once for a lookup and the following insert
+     */
+    struct Key {
+        uint32_t routine_id;
+        const uint8_t* request;
+        size_t request_len;
+        uint64_t hash;
+    };
+
+    explicit ResponseCache(const ResponseCacheOptions& options = ResponseCacheOptions{});
+
+    // Disable copy/move
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+    ResponseCache(ResponseCache&&) = delete;
+    ResponseCache& operator=(ResponseCache&&) = delete;
+
+    /**
+     * @brief Whether a request of this size may be cached at all
+     */
+    bool Accepts(size_t request_len) const {
+        return shard_capacity_ > 0 && request_len <= options_.max_request_bytes;
+    }
+
+    static Key MakeKey(uint32_t routine_id, const uint8_t* request, size_t request_len);
+
+    /**
+     * @brief Copy the cached response for key into output
+     * @param now_ms Current time on the clock insertions used (steady, ms)
+     * @return Response length, or 0 on a miss (also if output is too small)
+     */
+    size_t Lookup(const Key& key, uint8_t* output, size_t output_len, uint64_t now_ms);
+
+    /**
+     * @brief Store a response frame (replaces an entry with the same key)
+     * @param ttl_ms Lifetime from now_ms, 0 = until evicted
+     */
+    void Insert(const Key& key, const uint8_t* response, size_t response_len,
+                uint32_t ttl_ms, uint64_t now_ms);
+
+    /**
+     * @brief Drop every entry
+     */
+    void Clear();
+
+    ResponseCacheStats GetStats() const;
+
+private:
+    struct Entry {
+        uint64_t hash;
+        uint32_t routine_id;
+        uint64_t expires_ms;          // 0 = never
+        size_t request_len;
+        std::vector<uint8_t> bytes;   // Request bytes, then the response frame
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;         // Most recently used first
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    };
+
+    ResponseCacheOptions options_;
+    size_t shard_capacity_;
+    std::array<Shard, SHARDS> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> insertions_{0};
+    std::atomic<uint64_t> evictions_{0};
+
+    Shard& ShardFor(uint64_t hash) { return shards_[(hash >> 32) % SHARDS]; }
+    static bool Matches(const Entry& entry, const Key& key);
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_RESPONSE_CACHE_HPP
@@ -9,8 +9,11 @@
 #define IPC_DEMO_SERVICE_MANAGER_HPP
 
 #include "IService.hpp"
+#include "Metrics.hpp"
+#include "ResponseCache.hpp"
+#include "StatsService.hpp"
+#include <atomic>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 #include <mutex>
 
@@ -22,11 +25,43 @@ namespace ipc_demo {
  * 
  * Thread-safe service registry that routes incoming requests
  * to appropriate service handlers based on routine ID.
+ *
+ * Routing is read-mostly: lookups read an immutable RoutingTable snapshot
+ * through one atomic pointer, without locks or reference-count traffic.
+ * RegisterService() and Clear() copy the table under mutex_, then publish
+ * the new snapshot. The replaced snapshot (and the services only it
+ * references) is freed after a grace period: the writer waits until every
+ * read that may still see it has finished. Readers count themselves in on
+ * one of READER_SLOTS cache-line-sized slots, so requests on different
+ * threads rarely share a counter. RegisterService() and Clear() therefore
+ * wait for in-flight requests and must not be called from inside a service.
+ *
+ * Built-in routines (Protocol::IsReservedRoutine) are handled here and
+ * cannot be registered:
+ * - Protocol::BATCH_REQUEST_ROUTINE_ID runs every sub-request of a batch
+ *   frame back-to-back and answers with one batched response.
+ * - Protocol::STATS_REQUEST_ROUTINE_ID is answered by StatsService with a
+ *   snapshot of GetMetrics().
+ *
+ * Services are called through IService::Respond() with a ResponseBuilder
+ * over the caller's output buffer, its header pre-encoded at registration
+ * from GetResponseRoutineId().
+ *
+ * Every ExecuteService() call is recorded in GetMetrics(): count, errors
+ * (no response), payload/response bytes and execution time per routine.
+ *
+ * Requests for idempotent services (IService::IsIdempotent) go through a
+ * ResponseCache first: a hit copies the stored response frame and skips
+ * the service. Clear() empties the cache along with the routes.
  */
 class ServiceManager {
 public:
-    ServiceManager() = default;
-    ~ServiceManager() = default;
+    /**
+     * @brief Construct an empty registry
+     * @param cache_options Response cache bounds (capacity 0 disables it)
+     */
+    explicit ServiceManager(const ResponseCacheOptions& cache_options = ResponseCacheOptions{});
+    ~ServiceManager();
 
     // Disable copy/move
     ServiceManager(const ServiceManager&) = delete;
@@ -37,7 +72,8 @@ public:
     /**
      * @brief Register a service
      * @param service Shared pointer to service implementation
-     * @return true if registered successfully, false if routine ID already exists
+     * @return true if registered successfully, false if routine ID already
+     *         exists or is reserved
      */
     bool RegisterService(std::shared_ptr<IService> service);
 
@@ -48,6 +84,25 @@ public:
      */
     bool IsRoutinePresent(uint32_t routine_id) const;
 
+    /**
+     * @brief Check if the service for a routine ID may execute inline
+     * @param routine_id Request routine ID
+     * @return true if the service is inline-safe, or no service is
+     *         registered (the error path is cheap). Batches (may contain
+     *         slow calls) and stats snapshots are never inline-safe.
+     */
+    bool IsInlineSafe(uint32_t routine_id) const;
+
+    /**
+     * @brief Get the request metrics (also recorded into by the reactors)
+     */
+    Metrics& GetMetrics() { return metrics_; }
+
+    /**
+     * @brief Get the response cache counters
+     */
+    ResponseCacheStats GetCacheStats() const { return cache_.GetStats(); }
+
     /**
      * @brief Execute service for given routine ID
      * @param routine_id Request routine ID
@@ -79,8 +134,116 @@ public:
     void Clear();
 
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<uint32_t, std::shared_ptr<IService>> services_;
+    /**
+     * @brief Route a request to the built-in routine or service handling it
+     * @return Number of bytes written to output, or 0 on error
+     */
+    size_t Dispatch(uint32_t routine_id,
+                    const uint8_t* input, size_t input_len,
+                    uint8_t* output, size_t output_len);
+
+    /**
+     * @brief Execute a batch frame payload and write the batched response frame
+     * @return Number of bytes written to output, or 0 if the batch is malformed
+     */
+    size_t ExecuteBatch(const uint8_t* input, size_t input_len,
+                        uint8_t* output, size_t output_len);
+
+    /**
+     * @struct Route
+     * @brief Routine ID and the service handling it
+     */
+    struct Route {
+        uint32_t routine_id;
+        IService* service;   // Owned by RoutingTable::services
+        ResponseBuilder::Header response_header;   // Stamped from GetResponseRoutineId()
+        bool cacheable;      // service->IsIdempotent(), read once at registration
+        uint32_t cache_ttl_ms;
+    };
+
+    /**
+     * @struct RoutingTable
+     * @brief Immutable snapshot of the registered services
+     */
+    struct RoutingTable {
+        std::vector<Route> routes;                        // Sorted by routine_id
+        std::vector<std::shared_ptr<IService>> services;  // Registration order
+    };
+
+    static constexpr size_t READER_SLOTS = 16;
+
+    /**
+     * @struct ReaderSlot
+     * @brief Reads in progress, one counter per epoch parity
+     */
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> active[2] = {};
+    };
+
+    /**
+     * @brief The calling thread's reader counter for the current epoch
+     */
+    std::atomic<uint64_t>& ReaderCount() const;
+
+    /**
+     * @class ReadGuard
+     * @brief Keeps the current snapshot alive for the guard's lifetime
+     */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const ServiceManager& manager);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const RoutingTable& Table() const { return *table_; }
+
+    private:
+        std::atomic<uint64_t>& active_;
+        const RoutingTable* table_;
+    };
+
+    /**
+     * @brief Find the route for a routine ID in a snapshot
+     * @return Route, or nullptr if not registered
+     */
+    static const Route* FindRoute(const RoutingTable& table, uint32_t routine_id);
+
+    /**
+     * @brief Answer from the response cache, or execute and remember the response
+     * @return Number of bytes written to output, or 0 on error
+     */
+    size_t ExecuteCached(const Route& route, const uint8_t* input, size_t input_len,
+                         uint8_t* output, size_t output_len);
+
+    /**
+     * @brief Make table the current snapshot and free the previous one
+     *        once no read can still see it
+     *
+     * Caller holds mutex_.
+     */
+    void Publish(std::unique_ptr<RoutingTable> table);
+
+    /**
+     * @brief Wait until every read that started before the call has finished
+     *
+     * Flips the epoch twice, each time waiting for the readers counted on
+     * the previous parity: new reads count on the other one, so the wait
+     * ends even while requests keep arriving. Caller holds mutex_.
+     */
+    void Synchronize();
+
+    Metrics metrics_;
+    StatsService stats_service_{metrics_};
+    const ResponseBuilder::Header stats_header_{ResponseBuilder::EncodeHeader(Protocol::STATS_RESPONSE_ROUTINE_ID)};
+    const ResponseBuilder::Header batch_header_{ResponseBuilder::EncodeHeader(Protocol::BATCH_RESPONSE_ROUTINE_ID)};
+    ResponseCache cache_;
+
+    std::mutex mutex_;                                 // Serializes writers
+    std::atomic<const RoutingTable*> table_{nullptr};  // Current snapshot (owned)
+    std::atomic<uint64_t> epoch_{0};                   // Parity picks the readers' counter
+    mutable ReaderSlot readers_[READER_SLOTS];
 };
 
 } // namespace ipc_demo
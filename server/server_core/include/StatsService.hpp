@@ -0,0 +1,64 @@
+/**
+ * @file StatsService.hpp
+ * @brief Built-in service exporting the server metrics
+ */
+
+#ifndef IPC_DEMO_STATS_SERVICE_HPP
+#define IPC_DEMO_STATS_SERVICE_HPP
+
+#include "IService.hpp"
+#include "Metrics.hpp"
+
+namespace ipc_demo {
+
+class ByteBuffer;
+
+/**
+ * @class StatsService
+ * @brief Answers Protocol::STATS_REQUEST_ROUTINE_ID with a metrics snapshot
+ *
+ * Owned and dispatched by ServiceManager (the routine ID is reserved, so
+ * it cannot be registered like other services).
+ *
+ * Request Format:
+ *   [format:byte] (Protocol::STATS_FORMAT_BINARY or STATS_FORMAT_PROMETHEUS)
+ *
+ * Response Format (full frame): see Protocol.hpp, "Server statistics"
+ */
+class StatsService : public IService {
+public:
+    /**
+     * @param metrics Metrics to report (must outlive the service)
+     */
+    explicit StatsService(const Metrics& metrics);
+    ~StatsService() override = default;
+
+    uint32_t GetRequestRoutineId() const override;
+    uint32_t GetResponseRoutineId() const override;
+
+    size_t Execute(const uint8_t* input, size_t input_len,
+                  uint8_t* output, size_t output_len) override;
+
+    size_t Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) override;
+
+    std::string GetName() const override {
+        return "Stats";
+    }
+
+private:
+    /**
+     * @brief Write the binary payload
+     */
+    void PutBinary(ByteBuffer& response, const MetricsSnapshot& snapshot, size_t limit) const;
+
+    /**
+     * @brief Write the Prometheus text payload
+     */
+    void PutPrometheus(ByteBuffer& response, const MetricsSnapshot& snapshot, size_t limit) const;
+
+    const Metrics& metrics_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_STATS_SERVICE_HPP
@@ -0,0 +1,164 @@
+/**
+ * @file TimerWheel.hpp
+ * @brief Hierarchical timing wheel with intrusive timer nodes
+ *
+ * Used by the reactors for connection inactivity timeouts: scheduling and
+ * cancelling are O(1) list operations, and advancing the clock only visits
+ * the slots that became due instead of every connection.
+ */
+
+#ifndef IPC_DEMO_TIMER_WHEEL_HPP
+#define IPC_DEMO_TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc_demo {
+
+/**
+ * @struct TimerNode
+ * @brief Intrusive hook embedded in the object a timer belongs to
+ *
+ * A node is linked into at most one wheel slot. It must not be destroyed
+ * while scheduled unless the wheel is gone; Cancel it first.
+ */
+struct TimerNode {
+    TimerNode* prev = nullptr;
+    TimerNode* next = nullptr;
+    uint64_t expiry = 0;       // Wheel tick at which the timer is due
+    void* owner = nullptr;     // Object the node is embedded in, for the expiry callback
+
+    TimerNode() = default;
+    ~TimerNode() { Unlink(); }
+
+    // Disable copy/move (linked nodes are referenced by address)
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+    TimerNode(TimerNode&&) = delete;
+    TimerNode& operator=(TimerNode&&) = delete;
+
+    bool IsScheduled() const { return next != nullptr; }
+
+    void Unlink() {
+        if (next) {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = nullptr;
+        }
+    }
+};
+
+/**
+ * @class TimerWheel
+ * @brief Four levels of 64 slots, each level 64 times coarser than the last
+ *
+ * Time is counted in ticks of tick_ms. A timer due within 64 ticks sits in
+ * a level-0 slot; later ones sit in a coarser level and cascade one level
+ * down when the wheel reaches their slot (the classic BSD/Linux scheme).
+ * Timers beyond the top level's range are parked in its last slot and
+ * re-filed when they come up, so any deadline works.
+ *
+ * A timer never fires early: it is due on the first Advance() whose time
+ * is at or past its deadline, and at most one tick late.
+ *
+ * Thread Safety: none, the wheel belongs to one event-loop thread.
+ */
+class TimerWheel {
+public:
+    static constexpr size_t LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr uint64_t MAX_TICKS = uint64_t(1) << (LEVELS * SLOT_BITS);  // Span before parking
+
+    /**
+     * @brief Construct empty wheel
+     * @param now_ms Current time in milliseconds (any monotonic base)
+     * @param tick_ms Wheel resolution in milliseconds
+     * @throws std::invalid_argument if tick_ms is 0
+     */
+    TimerWheel(uint64_t now_ms, uint32_t tick_ms);
+
+    /**
+     * @brief Detaches the nodes still scheduled (they are not fired)
+     */
+    ~TimerWheel();
+
+    // Disable copy/move
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    /**
+     * @brief Schedule (or move) a timer
+     * @param node Timer hook, may already be scheduled
+     * @param deadline_ms Time at which it becomes due; past deadlines fire on the next tick
+     */
+    void Schedule(TimerNode& node, uint64_t deadline_ms);
+
+    /**
+     * @brief Unschedule a timer (no-op if it is not scheduled)
+     */
+    void Cancel(TimerNode& node);
+
+    /**
+     * @brief Move the wheel's clock forward and fire the timers now due
+     * @param now_ms Current time; earlier than the last call is ignored
+     * @param on_expired Called with each due node, already unscheduled; it
+     *        may schedule or cancel any node, including the one passed
+     * @return Number of timers fired
+     */
+    template <typename Callback>
+    size_t Advance(uint64_t now_ms, Callback&& on_expired) {
+        TimerNode expired;
+        expired.prev = expired.next = &expired;
+        CollectExpired(now_ms, expired);
+
+        size_t fired = 0;
+        while (expired.next != &expired) {
+            TimerNode& node = *expired.next;
+            node.Unlink();
+            --size_;
+            ++fired;
+            on_expired(node);
+        }
+        expired.prev = expired.next = nullptr;
+        return fired;
+    }
+
+    /**
+     * @brief Number of scheduled timers
+     */
+    size_t Size() const { return size_; }
+
+    /**
+     * @brief Wheel resolution in milliseconds
+     */
+    uint32_t TickMs() const { return tick_ms_; }
+
+    /**
+     * @brief Coarse monotonic clock in milliseconds (CLOCK_MONOTONIC_COARSE)
+     *
+     * Cheap enough to read once per event-loop iteration; resolution is the
+     * kernel tick (a few milliseconds), far finer than any timeout.
+     */
+    static uint64_t CoarseNowMs();
+
+private:
+    uint32_t tick_ms_;
+    uint64_t current_tick_;   // Last tick processed
+    size_t size_{0};
+    TimerNode slots_[LEVELS][SLOTS];  // Sentinels of circular lists
+
+    // File node into the slot matching its expiry
+    void Insert(TimerNode& node);
+    // Re-file every node of one slot (they are all due below this level)
+    void Cascade(size_t level, size_t slot);
+    // Process ticks up to now_ms, moving due nodes into the expired list
+    void CollectExpired(uint64_t now_ms, TimerNode& expired);
+    static void Append(TimerNode& list, TimerNode& node);
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_TIMER_WHEEL_HPP
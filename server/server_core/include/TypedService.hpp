@@ -0,0 +1,77 @@
+/**
+ * @file TypedService.hpp
+ * @brief IService adapter generated from an RpcMethod schema
+ */
+
+#ifndef IPC_DEMO_TYPED_SERVICE_HPP
+#define IPC_DEMO_TYPED_SERVICE_HPP
+
+#include "IService.hpp"
+#include "ipc_sync/Schema.hpp"
+
+namespace ipc_demo {
+
+/**
+ * @class TypedService
+ * @brief Service that works on decoded messages instead of raw frames
+ *
+ * Respond() decodes the request with MessageCodec, calls Handle() and
+ * encodes the response message behind the pre-stamped header, so derived
+ * services contain only their logic:
+ * @code
+ * class CalculatorService : public TypedService<CalculatorRpc> {
+ *     void Handle(const CalculatorRequest& request, CalculatorResponse& response) override;
+ * };
+ * @endcode
+ */
+template <typename Method>
+class TypedService : public IService {
+public:
+    using Request = typename Method::Request;
+    using Response = typename Method::Response;
+
+    uint32_t GetRequestRoutineId() const override {
+        return Method::REQUEST_ROUTINE_ID;
+    }
+
+    uint32_t GetResponseRoutineId() const override {
+        return Method::RESPONSE_ROUTINE_ID;
+    }
+
+    size_t Execute(const uint8_t* input, size_t input_len,
+                   uint8_t* output, size_t output_len) final {
+        ResponseBuilder response(Method::RESPONSE_ROUTINE_ID, output, output_len);
+        return Respond(input, input_len, response);
+    }
+
+    size_t Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) final {
+        Request request{};
+        Response response_message{};
+        if (MessageCodec<Request>::Decode(input, input_len, request)) {
+            Handle(request, response_message);
+        } else if (!HandleInvalidRequest(response_message)) {
+            return 0;
+        }
+        // 0 (no response) if it does not fit the buffer
+        return response.Encode(response_message);
+    }
+
+protected:
+    /**
+     * @brief Service logic
+     */
+    virtual void Handle(const Request& request, Response& response) = 0;
+
+    /**
+     * @brief Called instead of Handle() when the request is too short
+     * @return true to send response, false to send nothing (default)
+     */
+    virtual bool HandleInvalidRequest(Response& response) {
+        (void)response;
+        return false;
+    }
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_DEMO_TYPED_SERVICE_HPP
@@ -1,11 +1,13 @@
 /**
  * @file UDSServer.hpp
- * @brief Unix Domain Socket server with epoll
+ * @brief Unix Domain Socket server with epoll or io_uring
  * 
  * Provides robust server implementation with:
- * - Epoll-based event loop
+ * - Epoll-based event loop, or io_uring (multishot accept and receive)
+ * - Multi-reactor mode (one acceptor, N event-loop threads)
  * - Connection management
- * - Inactivity timeout
+ * - Inactivity timeout (per connection)
+ * - Hot restart (listening socket and idle connections handed to a successor)
  * - Error recovery
  */
 
@@ -13,24 +15,73 @@
 #define IPC_DEMO_UDS_SERVER_HPP
 
 #include "ServiceManager.hpp"
+#include "Reactor.hpp"
+#include "HotRestart.hpp"
 #include "ipc_sync/Protocol.hpp"
+#include "thread_pool/Executor.hpp"
+#include "thread_pool/ThreadPlacement.hpp"
 #include <string>
 #include <thread>
 #include <atomic>
-#include <unordered_map>
+#include <vector>
 #include <memory>
 #include <sys/epoll.h>
 
 namespace ipc_demo {
 
 /**
- * @struct ClientInfo
- * @brief Information about connected client
+ * @enum AcceptPolicy
+ * @brief How the acceptor distributes new connections across reactors
  */
-struct ClientInfo {
-    int fd;
-    time_t last_activity;
-    std::vector<uint8_t> recv_buffer;
+enum class AcceptPolicy {
+    RoundRobin,   // Cycle through reactors in order
+    LeastLoaded   // Pick the reactor with the fewest connected clients
+};
+
+/**
+ * @enum ExecutionMode
+ * @brief Where IService::Execute runs
+ */
+enum class ExecutionMode {
+    Inline,     // On the reactor thread that read the request
+    ThreadPool  // On a shared worker pool, unless the service is inline-safe
+};
+
+/**
+ * @enum WorkerPoolKind
+ * @brief Worker pool implementation for ExecutionMode::ThreadPool
+ */
+enum class WorkerPoolKind {
+    SharedQueue,   // thread_pool::ThreadPool: one queue behind one mutex
+    WorkStealing   // thread_pool::WorkStealingThreadPool: per-worker deques
+};
+
+/**
+ * @struct ServerConfig
+ * @brief Tunables for UDSServer
+ */
+struct ServerConfig {
+    size_t num_reactors = 1;                               // Event-loop threads serving clients
+    AcceptPolicy accept_policy = AcceptPolicy::RoundRobin; // Connection distribution
+    ExecutionMode execution_mode = ExecutionMode::Inline;  // Service execution placement
+    size_t worker_threads = 0;                             // Pool size, 0 = hardware concurrency
+    WorkerPoolKind worker_pool = WorkerPoolKind::SharedQueue; // Pool implementation
+    bool enable_shared_memory = true;                      // Accept shared-memory transport negotiation
+    bool enable_compression = true;                        // Accept compression negotiation
+    size_t compression_threshold = 512;                    // Response payloads from this size are compressed
+    std::shared_ptr<const CompressionDictionary> compression_dictionary; // Used with clients holding the same one
+    size_t max_pending_per_connection = 0;                 // Offloaded requests per connection, 0 = unlimited
+    size_t max_queued_requests = 0;                        // Requests waiting in the worker pool, 0 = unlimited
+    OverloadPolicy overload_policy = OverloadPolicy::Backpressure; // Beyond either bound
+    uint32_t inactivity_timeout_ms = Protocol::INACTIVITY_TIMEOUT_SEC * 1000; // Idle connections closed, 0 = never
+    uint32_t max_inactivity_timeout_ms = 0;                // Cap on client-chosen timeouts, 0 = inactivity_timeout_ms
+    IoBackend io_backend = IoBackend::Epoll;               // Acceptor and reactors; IoUring falls back to Epoll
+    thread_pool::ThreadPlacement reactor_placement;        // Reactor i pinned to cpus[i % n], empty = unpinned
+    thread_pool::ThreadPlacement worker_placement;         // Same for the worker pool's threads
+    uint32_t busy_poll_us = 0;                             // Reactors spin this long after the last event, 0 = always block
+    std::string handoff_path;                              // Hot-restart control socket, empty = disabled
+    uint32_t handoff_drain_timeout_ms = 5000;              // Busy connections finish this long, then close
+    double trace_sample_rate = 0.0;                        // Fraction of requests traced, 0 = tracing off
 };
 
 /**
@@ -39,6 +90,30 @@ struct ClientInfo {
  * 
  * Single Responsibility: Manages network communication and event loop
  * Depends on ServiceManager abstraction (Dependency Inversion)
+ *
+ * The server thread only accepts connections; each accepted client is
+ * handed to one of ServerConfig::num_reactors reactors, which then owns
+ * all I/O and request execution for that client.
+ *
+ * With IoBackend::IoUring the acceptor keeps one multishot accept armed
+ * on the listening socket, so a burst of connections costs a single
+ * io_uring_enter. Kernels without the needed io_uring features are
+ * detected once at construction and the server runs on epoll instead.
+ *
+ * Hot restart (ServerConfig::handoff_path, see HotRestart.hpp): a server
+ * started while another one serves the same handoff_path takes over its
+ * listening socket instead of binding, and then receives its connections
+ * as they fall idle, so clients neither see refused connects nor all
+ * reconnect at once. The old server stops accepting, keeps serving its
+ * busy connections until they hand over or handoff_drain_timeout_ms
+ * passes, then exits on its own (IsRunning() turns false, HasHandedOff()
+ * true) without removing the socket files, which now belong to the new
+ * server. If nobody answers on handoff_path the server starts normally.
+ *
+ * Tracing (ServerConfig::trace_sample_rate, see ipc_sync/Tracer.hpp): the
+ * reactors record per-stage timings of that fraction of requests, and of
+ * every request a client traces (Protocol::FLAG_TRACE_ID), into
+ * trace::Tracer::Global().
  */
 class UDSServer {
 public:
@@ -50,6 +125,17 @@ public:
     explicit UDSServer(const std::string& socket_path,
                        std::shared_ptr<ServiceManager> service_manager);
 
+    /**
+     * @brief Construct UDS server with explicit configuration
+     * @param socket_path Path to Unix socket file
+     * @param service_manager Service registry
+     * @param config Server tunables
+     * @throws std::invalid_argument if config.num_reactors is 0
+     */
+    UDSServer(const std::string& socket_path,
+              std::shared_ptr<ServiceManager> service_manager,
+              const ServerConfig& config);
+
     ~UDSServer();
 
     // Disable copy/move
@@ -75,32 +161,76 @@ public:
      */
     bool IsRunning() const { return running_.load(); }
 
+    /**
+     * @brief Check if this server handed its socket to a successor (hot restart)
+     */
+    bool HasHandedOff() const { return handed_off_.load(); }
+
+    /**
+     * @brief Get number of connections adopted from a predecessor (hot restart)
+     */
+    size_t GetAdoptedClientCount() const { return adopted_clients_.load(); }
+
     /**
      * @brief Get number of connected clients
-     * @return Client count
+     * @return Client count (sum over all reactors)
      */
     size_t GetClientCount() const;
 
+    /**
+     * @brief Get number of reactors serving clients
+     * @return Reactor count
+     */
+    size_t GetReactorCount() const { return reactors_.size(); }
+
+    /**
+     * @brief Get number of clients served by a single reactor
+     * @param index Reactor index in [0, GetReactorCount())
+     * @return Client count of that reactor
+     */
+    size_t GetReactorClientCount(size_t index) const;
+
+    /**
+     * @brief Get the I/O backend in use (Epoll if IoUring was requested but is unsupported)
+     */
+    IoBackend GetIoBackend() const { return config_.io_backend; }
+
 private:
     enum class ServerState {
         CreateSocket,
         ListenSocket,
         WaitAndHandleEvents,
+        Drain,
         Cleanup,
         Exit
     };
 
     std::string socket_path_;
     std::shared_ptr<ServiceManager> service_manager_;
+    ServerConfig config_;
     
     std::atomic<bool> running_{false};
     std::thread server_thread_;
     
     int server_fd_{-1};
     int epoll_fd_{-1};
-    int timer_fd_{-1};
+    std::unique_ptr<IoUring> accept_ring_;  // IoBackend::IoUring only
+
+    // Hot restart: control socket, and the other server while handing over
+    int control_fd_{-1};                     // Listening on config_.handoff_path
+    int peer_fd_{-1};                         // Predecessor (receiving) or successor (draining)
+    hot_restart::MessageReader peer_reader_;
+    int candidate_fd_{-1};                    // Would-be successor, handshake pending
+    hot_restart::MessageReader candidate_reader_;
+    uint64_t candidate_deadline_ms_{0};       // Dropped if its takeover request is not in by then
+    uint32_t successor_dictionary_id_{0};
+    uint64_t drain_deadline_ms_{0};
+    std::atomic<bool> handed_off_{false};
+    std::atomic<size_t> adopted_clients_{0};
     
-    std::unordered_map<int, std::unique_ptr<ClientInfo>> clients_;
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    size_t next_reactor_{0};
+    std::unique_ptr<thread_pool::IExecutor> worker_pool_;
     
     // Server thread main loop
     void ServerThreadFunc();
@@ -109,21 +239,32 @@ private:
     ServerState HandleCreateSocket();
     ServerState HandleListenSocket();
     ServerState HandleWaitAndHandleEvents();
+    ServerState HandleDrain();
     ServerState HandleCleanup();
     
     // Event handlers
     bool HandleNewConnection();
-    bool HandleClientData(int client_fd);
-    void HandleClientClose(int client_fd);
-    void HandleInactivityTimer();
-    
-    // Protocol handling
-    size_t ProcessClientRequest(int client_fd, const uint8_t* data, size_t len);
+    bool HandOverClient(int client_fd);
+    bool ArmMultishotAccept();
+
+    // Hot restart
+    bool TakeOverListener();
+    bool CreateControlSocket();
+    bool WatchFd(int fd, uint64_t tag);
+    void UnwatchFd(int fd, uint64_t tag);
+    void AcceptSuccessor();
+    ServerState HandleSuccessor();
+    void DropSuccessorCandidate();
+    void ExpireSuccessorCandidate();
+    void HandlePredecessorMessages();
+    void ClosePeer();
+    void TransferClients();
     
     // Utility methods
-    bool CreateInactivityTimer();
+    Reactor& SelectReactor();
+    bool StartReactors();
+    void StopReactors();
     bool SetNonBlocking(int fd);
-    void CloseAllClients();
     void RemoveSocketFile();
 };
 
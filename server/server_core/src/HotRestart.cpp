@@ -0,0 +1,225 @@
+/**
+ * @file HotRestart.cpp
+ * @brief Implementation of the hot-restart control protocol
+ */
+
+#include "HotRestart.hpp"
+#include "ipc_sync/ByteOrder.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+
+namespace ipc_demo {
+namespace hot_restart {
+
+namespace {
+
+constexpr size_t HELLO_SIZE = 5;       // [MAGIC:4][VERSION:1]
+constexpr size_t MAX_BODY_SIZE = 1 + MAX_PASSED_FDS * CLIENT_ENTRY_SIZE;
+
+void CloseAll(std::vector<int>& fds) {
+    for (int fd : fds) {
+        close(fd);
+    }
+    fds.clear();
+}
+
+// Whole message in one sendmsg (then the rest, if the socket took less)
+bool SendMessage(int socket_fd, MessageKind kind, const uint8_t* body, size_t body_len,
+                 const int* fds = nullptr, size_t fd_count = 0) {
+    uint8_t message[HEADER_SIZE + MAX_BODY_SIZE];
+    message[0] = static_cast<uint8_t>(kind);
+    byte_order::StoreBigEndian(message + 1, static_cast<uint16_t>(body_len));
+    std::copy(body, body + body_len, message + HEADER_SIZE);
+    size_t len = HEADER_SIZE + body_len;
+
+    ssize_t sent = SendWithFds(socket_fd, message, len, fds, fd_count);
+    if (sent < 0) {
+        return false;
+    }
+    size_t offset = static_cast<size_t>(sent);
+    while (offset < len) {
+        ssize_t more = send(socket_fd, message + offset, len - offset, MSG_NOSIGNAL);
+        if (more < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        offset += static_cast<size_t>(more);
+    }
+    return true;
+}
+
+void PutHello(uint8_t* body) {
+    byte_order::StoreBigEndian(body, MAGIC);
+    body[4] = VERSION;
+}
+
+bool CheckHello(const std::vector<uint8_t>& body) {
+    return body.size() >= HELLO_SIZE && byte_order::LoadBigEndian<uint32_t>(body.data()) == MAGIC &&
+           body[4] == VERSION;
+}
+
+} // namespace
+
+MessageReader::~MessageReader() {
+    Reset();
+}
+
+MessageReader::Status MessageReader::Read(int socket_fd, Message& message, int flags) {
+    while (true) {
+        bool malformed = false;
+        if (TakeMessage(message, malformed)) {
+            return Status::Message;
+        }
+        if (malformed) {
+            return Status::Error;
+        }
+
+        uint8_t chunk[256];
+        ssize_t received = RecvWithFds(socket_fd, chunk, sizeof(chunk), fds_, flags);
+        if (received == 0) {
+            return Status::Closed;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK ? Status::Again : Status::Error;
+        }
+        buffer_.insert(buffer_.end(), chunk, chunk + received);
+    }
+}
+
+void MessageReader::Reset() {
+    buffer_.clear();
+    CloseAll(fds_);
+}
+
+bool MessageReader::TakeMessage(Message& message, bool& malformed) {
+    if (buffer_.size() < HEADER_SIZE) {
+        return false;
+    }
+    size_t body_len = byte_order::LoadBigEndian<uint16_t>(buffer_.data() + 1);
+    if (body_len > MAX_BODY_SIZE) {
+        malformed = true;
+        return false;
+    }
+    if (buffer_.size() < HEADER_SIZE + body_len) {
+        return false;
+    }
+
+    auto kind = static_cast<MessageKind>(buffer_[0]);
+    size_t fd_count = 0;
+    switch (kind) {
+        case MessageKind::Takeover:
+        case MessageKind::Done:
+            break;
+        case MessageKind::Listener:
+            fd_count = 1;
+            break;
+        case MessageKind::Clients:
+            fd_count = body_len > 0 ? buffer_[HEADER_SIZE] : 0;
+            break;
+        default:
+            malformed = true;
+            return false;
+    }
+    // Descriptors come with a message's first byte, so they are here by now
+    if (fds_.size() < fd_count) {
+        malformed = true;
+        return false;
+    }
+
+    message.kind = kind;
+    message.body.assign(buffer_.begin() + HEADER_SIZE, buffer_.begin() + HEADER_SIZE + body_len);
+    message.fds.assign(fds_.begin(), fds_.begin() + fd_count);
+    fds_.erase(fds_.begin(), fds_.begin() + fd_count);
+    buffer_.erase(buffer_.begin(), buffer_.begin() + HEADER_SIZE + body_len);
+    return true;
+}
+
+bool SendTakeover(int socket_fd, uint32_t dictionary_id) {
+    uint8_t body[HELLO_SIZE + 4];
+    PutHello(body);
+    byte_order::StoreBigEndian(body + HELLO_SIZE, dictionary_id);
+    return SendMessage(socket_fd, MessageKind::Takeover, body, sizeof(body));
+}
+
+bool SendListener(int socket_fd, int listen_fd) {
+    uint8_t body[HELLO_SIZE];
+    PutHello(body);
+    return SendMessage(socket_fd, MessageKind::Listener, body, sizeof(body), &listen_fd, 1);
+}
+
+bool SendDone(int socket_fd) {
+    return SendMessage(socket_fd, MessageKind::Done, nullptr, 0);
+}
+
+bool SendClients(int socket_fd, const std::vector<HandoffClient>& clients) {
+    for (size_t first = 0; first < clients.size(); first += MAX_PASSED_FDS) {
+        size_t count = std::min(MAX_PASSED_FDS, clients.size() - first);
+        uint8_t body[MAX_BODY_SIZE];
+        int fds[MAX_PASSED_FDS];
+        body[0] = static_cast<uint8_t>(count);
+        for (size_t i = 0; i < count; ++i) {
+            const HandoffClient& client = clients[first + i];
+            uint8_t* entry = body + 1 + i * CLIENT_ENTRY_SIZE;
+            byte_order::StoreBigEndian(entry, client.idle_timeout_ms);
+            entry[4] = client.compression;
+            fds[i] = client.fd;
+        }
+        if (!SendMessage(socket_fd, MessageKind::Clients, body, 1 + count * CLIENT_ENTRY_SIZE, fds, count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParseTakeover(const Message& message, uint32_t& dictionary_id) {
+    if (message.kind != MessageKind::Takeover || message.body.size() != HELLO_SIZE + 4 ||
+        !CheckHello(message.body)) {
+        return false;
+    }
+    dictionary_id = byte_order::LoadBigEndian<uint32_t>(message.body.data() + HELLO_SIZE);
+    return true;
+}
+
+bool ParseListener(const Message& message) {
+    return message.kind == MessageKind::Listener && message.body.size() == HELLO_SIZE &&
+           CheckHello(message.body) && message.fds.size() == 1;
+}
+
+bool ParseClients(Message& message, std::vector<HandoffClient>& clients) {
+    size_t count = message.body.empty() ? 0 : message.body[0];
+    if (message.kind != MessageKind::Clients || count == 0 ||
+        message.body.size() != 1 + count * CLIENT_ENTRY_SIZE || message.fds.size() != count) {
+        CloseAll(message.fds);
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* entry = message.body.data() + 1 + i * CLIENT_ENTRY_SIZE;
+        HandoffClient client;
+        client.fd = message.fds[i];
+        client.idle_timeout_ms = byte_order::LoadBigEndian<uint32_t>(entry);
+        client.compression = entry[4];
+        clients.push_back(client);
+    }
+    message.fds.clear();
+    return true;
+}
+
+bool SetIoTimeout(int socket_fd) {
+    struct timeval timeout;
+    timeout.tv_sec = IO_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (IO_TIMEOUT_MS % 1000) * 1000;
+    return setsockopt(socket_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0 &&
+           setsockopt(socket_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+} // namespace hot_restart
+} // namespace ipc_demo
@@ -0,0 +1,349 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of Metrics
+ */
+
+#include "Metrics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace ipc_demo {
+
+namespace {
+
+// Distinguishes Metrics instances (addresses can be reused)
+std::atomic<uint64_t> g_next_metrics_id{1};
+
+// Only the owning thread writes a shard: plain load + store, no RMW
+inline void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+const double PROMETHEUS_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+// Escape a Prometheus label value
+std::string EscapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+struct Metrics::Histogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+
+    void Record(uint64_t value) {
+        Add(count, 1);
+        Add(sum_ns, value);
+        if (value > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(value, std::memory_order_relaxed);
+        }
+        Add(buckets[BucketIndex(value)], 1);
+    }
+
+    void MergeInto(HistogramSnapshot& snapshot) const {
+        snapshot.count += count.load(std::memory_order_relaxed);
+        snapshot.sum_ns += sum_ns.load(std::memory_order_relaxed);
+        snapshot.max_ns = std::max(snapshot.max_ns, max_ns.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            snapshot.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+struct Metrics::RoutineCounters {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+    Histogram queue_wait;
+    Histogram execution;
+};
+
+struct Metrics::Shard {
+    std::thread::id owner;
+    std::atomic<uint64_t> connections_opened{0};
+    std::atomic<uint64_t> connections_closed{0};
+    // Allocated by the owner on first use, read by Snapshot()
+    std::array<std::atomic<RoutineCounters*>, SLOT_COUNT> counters{};
+
+    ~Shard() {
+        for (auto& slot : counters) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+uint64_t HistogramSnapshot::Percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(Metrics::BucketUpperBound(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+Metrics::Metrics()
+    : id_(g_next_metrics_id.fetch_add(1, std::memory_order_relaxed)) {
+    for (auto& slot : slot_ids_) {
+        slot.store(EMPTY_SLOT, std::memory_order_relaxed);
+    }
+    slot_names_[OTHER_SLOT] = "other";
+}
+
+Metrics::~Metrics() = default;
+
+bool Metrics::RegisterRoutine(uint32_t routine_id, const std::string& name) {
+    if (routine_id == EMPTY_SLOT) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (SlotFor(routine_id) != OTHER_SLOT) {
+        return true;
+    }
+    if (registered_ == MAX_ROUTINES) {
+        return false;
+    }
+
+    size_t slot = (routine_id * 2654435761u) % TABLE_SIZE;
+    while (slot_ids_[slot].load(std::memory_order_relaxed) != EMPTY_SLOT) {
+        slot = (slot + 1) % TABLE_SIZE;
+    }
+    slot_names_[slot] = name;
+    slot_ids_[slot].store(routine_id, std::memory_order_release);
+    registered_++;
+    return true;
+}
+
+void Metrics::RecordRequest(uint32_t routine_id, size_t bytes_in, size_t bytes_out,
+                            bool error, uint64_t execution_ns) {
+    RoutineCounters& counters = Counters(routine_id);
+    Add(counters.requests, 1);
+    if (error) {
+        Add(counters.errors, 1);
+    }
+    Add(counters.bytes_in, bytes_in);
+    Add(counters.bytes_out, bytes_out);
+    counters.execution.Record(execution_ns);
+}
+
+void Metrics::RecordQueueWait(uint32_t routine_id, uint64_t wait_ns) {
+    Counters(routine_id).queue_wait.Record(wait_ns);
+}
+
+void Metrics::RecordRejected(uint32_t routine_id) {
+    Add(Counters(routine_id).rejected, 1);
+}
+
+void Metrics::RecordCacheHit(uint32_t routine_id) {
+    Add(Counters(routine_id).cache_hits, 1);
+}
+
+void Metrics::RecordConnectionOpened() {
+    Add(LocalShard().connections_opened, 1);
+}
+
+void Metrics::RecordConnectionClosed() {
+    Add(LocalShard().connections_closed, 1);
+}
+
+MetricsSnapshot Metrics::Snapshot() const {
+    MetricsSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& shard : shards_) {
+        snapshot.connections_opened += shard->connections_opened.load(std::memory_order_relaxed);
+        snapshot.connections_closed += shard->connections_closed.load(std::memory_order_relaxed);
+    }
+
+    for (size_t slot = 0; slot < SLOT_COUNT; ++slot) {
+        uint32_t routine_id = slot == OTHER_SLOT ? OTHER_ROUTINE_ID
+                                                 : slot_ids_[slot].load(std::memory_order_relaxed);
+        if (routine_id == EMPTY_SLOT && slot != OTHER_SLOT) {
+            continue;
+        }
+
+        RoutineMetrics routine;
+        routine.routine_id = routine_id;
+        routine.name = slot_names_[slot];
+        routine.queue_wait.buckets.assign(BUCKET_COUNT, 0);
+        routine.execution.buckets.assign(BUCKET_COUNT, 0);
+
+        bool seen = false;
+        for (const auto& shard : shards_) {
+            const RoutineCounters* counters = shard->counters[slot].load(std::memory_order_acquire);
+            if (counters == nullptr) {
+                continue;
+            }
+            seen = true;
+            routine.requests += counters->requests.load(std::memory_order_relaxed);
+            routine.errors += counters->errors.load(std::memory_order_relaxed);
+            routine.rejected += counters->rejected.load(std::memory_order_relaxed);
+            routine.cache_hits += counters->cache_hits.load(std::memory_order_relaxed);
+            routine.bytes_in += counters->bytes_in.load(std::memory_order_relaxed);
+            routine.bytes_out += counters->bytes_out.load(std::memory_order_relaxed);
+            counters->queue_wait.MergeInto(routine.queue_wait);
+            counters->execution.MergeInto(routine.execution);
+        }
+
+        // Unregistered traffic only shows up once there is some
+        if (slot != OTHER_SLOT || seen) {
+            snapshot.routines.push_back(std::move(routine));
+        }
+    }
+
+    std::sort(snapshot.routines.begin(), snapshot.routines.end(),
+              [](const RoutineMetrics& a, const RoutineMetrics& b) { return a.routine_id < b.routine_id; });
+    return snapshot;
+}
+
+std::string Metrics::FormatPrometheus(const MetricsSnapshot& snapshot) {
+    std::ostringstream out;
+
+    auto family = [&out](const char* name, const char* type, const char* help) {
+        out << "# HELP " << name << ' ' << help << '\n';
+        out << "# TYPE " << name << ' ' << type << '\n';
+    };
+    auto labels = [](const RoutineMetrics& routine) {
+        std::ostringstream label;
+        if (routine.routine_id == OTHER_ROUTINE_ID) {
+            label << "routine=\"other\"";
+        } else {
+            label << "routine=\"0x" << std::hex << routine.routine_id << '"';
+        }
+        label << ",service=\"" << EscapeLabel(routine.name) << '"';
+        return label.str();
+    };
+    auto counter = [&](const char* name, const char* help, uint64_t RoutineMetrics::*field) {
+        family(name, "counter", help);
+        for (const auto& routine : snapshot.routines) {
+            out << name << '{' << labels(routine) << "} " << routine.*field << '\n';
+        }
+    };
+    auto summary = [&](const char* name, const char* help, HistogramSnapshot RoutineMetrics::*field) {
+        family(name, "summary", help);
+        out << std::setprecision(9);
+        for (const auto& routine : snapshot.routines) {
+            const HistogramSnapshot& histogram = routine.*field;
+            std::string label = labels(routine);
+            for (double q : PROMETHEUS_QUANTILES) {
+                out << name << '{' << label << ",quantile=\"" << q << "\"} "
+                    << static_cast<double>(histogram.Percentile(q)) / 1e9 << '\n';
+            }
+            out << name << "_sum{" << label << "} " << static_cast<double>(histogram.sum_ns) / 1e9 << '\n';
+            out << name << "_count{" << label << "} " << histogram.count << '\n';
+        }
+    };
+
+    family("ipc_connections_opened_total", "counter", "Client connections accepted.");
+    out << "ipc_connections_opened_total " << snapshot.connections_opened << '\n';
+    family("ipc_connections_closed_total", "counter", "Client connections closed.");
+    out << "ipc_connections_closed_total " << snapshot.connections_closed << '\n';
+    family("ipc_connections_active", "gauge", "Client connections currently open.");
+    out << "ipc_connections_active "
+        << (snapshot.connections_opened - std::min(snapshot.connections_opened, snapshot.connections_closed))
+        << '\n';
+
+    counter("ipc_requests_total", "Requests executed.", &RoutineMetrics::requests);
+    counter("ipc_request_errors_total", "Requests that produced no response.", &RoutineMetrics::errors);
+    counter("ipc_requests_rejected_total", "Requests answered with SERVER_BUSY.", &RoutineMetrics::rejected);
+    counter("ipc_response_cache_hits_total", "Requests answered from the response cache.",
+            &RoutineMetrics::cache_hits);
+    counter("ipc_request_bytes_total", "Request payload bytes.", &RoutineMetrics::bytes_in);
+    counter("ipc_response_bytes_total", "Response frame bytes.", &RoutineMetrics::bytes_out);
+    summary("ipc_request_queue_wait_seconds", "Time offloaded requests waited for a worker.",
+            &RoutineMetrics::queue_wait);
+    summary("ipc_request_execution_seconds", "Time spent executing requests.", &RoutineMetrics::execution);
+
+    return out.str();
+}
+
+uint64_t Metrics::NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+size_t Metrics::SlotFor(uint32_t routine_id) const {
+    if (routine_id == EMPTY_SLOT) {
+        return OTHER_SLOT;
+    }
+    size_t slot = (routine_id * 2654435761u) % TABLE_SIZE;
+    // At most half full, so an empty slot always ends the probe
+    for (;;) {
+        uint32_t id = slot_ids_[slot].load(std::memory_order_acquire);
+        if (id == routine_id) {
+            return slot;
+        }
+        if (id == EMPTY_SLOT) {
+            return OTHER_SLOT;
+        }
+        slot = (slot + 1) % TABLE_SIZE;
+    }
+}
+
+Metrics::Shard& Metrics::LocalShard() {
+    struct Cache {
+        uint64_t metrics_id = 0;
+        Shard* shard = nullptr;
+    };
+    thread_local Cache cache;
+    if (cache.metrics_id == id_) {
+        return *cache.shard;
+    }
+
+    // First use from this thread (or it last recorded into another instance)
+    std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(shards_.begin(), shards_.end(),
+                           [self](const std::unique_ptr<Shard>& shard) { return shard->owner == self; });
+    if (it == shards_.end()) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->owner = self;
+        it = shards_.end() - 1;
+    }
+    cache = Cache{id_, it->get()};
+    return **it;
+}
+
+Metrics::RoutineCounters& Metrics::Counters(uint32_t routine_id) {
+    Shard& shard = LocalShard();
+    size_t slot = SlotFor(routine_id);
+
+    RoutineCounters* counters = shard.counters[slot].load(std::memory_order_relaxed);
+    if (counters == nullptr) {
+        counters = new RoutineCounters();
+        shard.counters[slot].store(counters, std::memory_order_release);
+    }
+    return *counters;
+}
+
+} // namespace ipc_demo
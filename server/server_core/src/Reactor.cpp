@@ -0,0 +1,2195 @@
+/**
+ * @file Reactor.cpp
+ * @brief Implementation of per-thread reactor (epoll or io_uring)
+ */
+
+#include "Reactor.hpp"
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/ByteOrder.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include "logging/Logger.hpp"
+#include "thread_pool/Executor.hpp"
+#include "thread_pool/ThreadPlacement.hpp"
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+namespace ipc_demo {
+
+namespace {
+
+// Largest iovec array passed to Reactor::SendResponse
+constexpr size_t MAX_RESPONSE_SEGMENTS = 4;
+
+/**
+ * @struct ResponseSegments
+ * @brief A response frame as gather segments for sendmsg
+ *
+ * With a request ID the header is rebuilt here (length patched, flag set,
+ * ID appended) and the service's bytes after VERSION follow as a second
+ * segment, so nothing is shifted in the service's buffer.
+ */
+struct ResponseSegments {
+    uint8_t header[Protocol::FRAME_HEADER_SIZE + Protocol::REQUEST_ID_SIZE];
+    struct iovec iov[2];
+    size_t iovcnt = 0;
+};
+
+/**
+ * @brief Describe a service response frame, tagged with the request ID if any
+ * @return false if the frame is malformed
+ */
+bool BuildResponseSegments(const uint8_t* frame, size_t len, std::optional<uint32_t> request_id,
+                           ResponseSegments& out) {
+    if (len < Protocol::GetMinFrameSize()) {
+        return false;
+    }
+
+    if (!request_id) {
+        out.iov[0].iov_base = const_cast<uint8_t*>(frame);
+        out.iov[0].iov_len = len;
+        out.iovcnt = 1;
+        return true;
+    }
+
+    ByteBuffer header(out.header, sizeof(out.header));
+    header.PutByte(frame[0]);
+    header.PutInt(static_cast<uint32_t>(len + Protocol::REQUEST_ID_SIZE));
+    std::memcpy(out.header + header.Position(), frame + header.Position(), 4); // Routine ID as is
+    header.SetPosition(Protocol::FRAME_HEADER_SIZE - 1);
+    header.PutByte(frame[Protocol::FRAME_HEADER_SIZE - 1] | Protocol::FLAG_REQUEST_ID);
+    header.PutInt(*request_id);
+
+    out.iov[0].iov_base = out.header;
+    out.iov[0].iov_len = sizeof(out.header);
+    out.iov[1].iov_base = const_cast<uint8_t*>(frame + Protocol::FRAME_HEADER_SIZE);
+    out.iov[1].iov_len = len - Protocol::FRAME_HEADER_SIZE;
+    out.iovcnt = 2;
+    return true;
+}
+
+/**
+ * @brief Copy a response frame into out with its payload compressed
+ * @return Length of the copy, or 0 if compression would not shrink the frame
+ */
+size_t CompressResponseFrame(const uint8_t* frame, size_t len, uint8_t* out, size_t capacity,
+                             const CompressionDictionary* dictionary) {
+    if ((frame[Protocol::FRAME_HEADER_SIZE - 1] & Protocol::FLAG_COMPRESSED) || capacity < Protocol::GetMinFrameSize()) {
+        return 0;
+    }
+
+    size_t compressed_len = CompressPayload(frame + Protocol::FRAME_HEADER_SIZE, len - Protocol::GetMinFrameSize(),
+                                            out + Protocol::FRAME_HEADER_SIZE, capacity - Protocol::GetMinFrameSize(),
+                                            dictionary);
+    if (compressed_len == 0) {
+        return 0;
+    }
+
+    // Same header with the flag set and the length patched
+    std::memcpy(out, frame, Protocol::FRAME_HEADER_SIZE);
+    out[Protocol::FRAME_HEADER_SIZE - 1] |= Protocol::FLAG_COMPRESSED;
+    size_t frame_len = Protocol::GetMinFrameSize() + compressed_len;
+    byte_order::StoreBigEndian<uint32_t>(out + 1, static_cast<uint32_t>(frame_len));
+    out[frame_len - 1] = Protocol::END_BYTE;
+    return frame_len;
+}
+
+/**
+ * @brief Request ID of a tagged frame (the first bytes after the header)
+ */
+std::optional<uint32_t> FrameRequestId(const FrameView& frame) {
+    if (!(frame.version & Protocol::FLAG_REQUEST_ID) || frame.payload_len < Protocol::REQUEST_ID_SIZE) {
+        return std::nullopt;
+    }
+    ByteBuffer id(const_cast<uint8_t*>(frame.payload), Protocol::REQUEST_ID_SIZE);
+    return id.GetInt();
+}
+
+// io_uring user_data: ClientInfo address (8-byte aligned) | operation
+enum UringOp : uint64_t {
+    URING_IGNORE = 0,   // Cancellations, nothing to do
+    URING_WAKE,
+    URING_TIMER,
+    URING_RECV,
+    URING_SEND,
+    URING_DOORBELL
+};
+constexpr uint64_t URING_OP_MASK = 7;
+static_assert(alignof(ClientInfo) > URING_OP_MASK, "ClientInfo addresses must leave room for the operation");
+
+constexpr uint16_t URING_BUFFER_GROUP = 0;
+
+uint64_t UringTag(ClientInfo& client, UringOp op) {
+    return reinterpret_cast<uint64_t>(&client) | op;
+}
+
+void CloseFds(std::vector<int>& fds) {
+    for (int fd : fds) {
+        close(fd);
+    }
+    fds.clear();
+}
+
+// Fine-grained clock for busy polling (the loop clock is coarse)
+uint64_t MonotonicUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+} // namespace
+
+Reactor::Reactor(size_t index, std::shared_ptr<ServiceManager> service_manager,
+                 const ReactorOptions& options)
+    : index_(index)
+    , service_manager_(service_manager)
+    , options_(options)
+    , idle_timers_(TimerWheel::CoarseNowMs(), IDLE_TICK_MS)
+    , stream_timers_(TimerWheel::CoarseNowMs(), STREAM_TICK_MS)
+    , trace_sampler_(options.trace_sample_rate) {
+
+    if (!service_manager_) {
+        throw std::invalid_argument("Reactor: service_manager cannot be null");
+    }
+}
+
+Reactor::~Reactor() {
+    Stop();
+}
+
+bool Reactor::Start(thread_pool::IExecutor* worker_pool) {
+    if (running_.load()) {
+        return false;
+    }
+
+    worker_pool_ = worker_pool;
+    now_ms_ = TimerWheel::CoarseNowMs();
+
+    if (options_.io_backend == IoBackend::IoUring) {
+        CreateUring(); // Falls back to epoll on failure
+    }
+
+    if (!ring_) {
+        epoll_fd_ = epoll_create1(0);
+        if (epoll_fd_ < 0) {
+            LOG_ERROR("[Reactor " << index_ << "] epoll_create1 failed: " << strerror(errno));
+            return false;
+        }
+    }
+
+    if (!CreateWakeupEvent() || !CreateInactivityTimer()) {
+        CloseDescriptors();
+        return false;
+    }
+
+    running_.store(true);
+    thread_ = std::thread(&Reactor::ThreadFunc, this);
+    return true;
+}
+
+void Reactor::Stop() {
+    if (running_.exchange(false)) {
+        // Kick the loop out of epoll_wait
+        uint64_t one = 1;
+        ssize_t ret = write(wake_fd_, &one, sizeof(one));
+        (void)ret; // Loop also re-checks running_ on its 1 second timeout
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    CloseAllClients();
+    CloseDescriptors();
+    worker_pool_ = nullptr;
+}
+
+bool Reactor::AddClient(int client_fd) {
+    HandoffClient fresh;
+    fresh.fd = client_fd;
+    fresh.idle_timeout_ms = options_.inactivity_timeout_ms;
+    return QueueClient(fresh);
+}
+
+bool Reactor::AdoptClient(const HandoffClient& client) {
+    return QueueClient(client);
+}
+
+bool Reactor::QueueClient(const HandoffClient& pending) {
+    if (!running_.load()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_clients_.push_back(pending);
+    }
+    client_count_.fetch_add(1);
+
+    Signal();
+    return true;
+}
+
+std::vector<HandoffClient> Reactor::DetachClients(uint32_t dictionary_id) {
+    std::unique_lock<std::mutex> lock(handoff_mutex_);
+    if (!running_.load()) {
+        return {};
+    }
+    handoff_dictionary_id_ = dictionary_id;
+    handoff_requested_ = true;
+    Signal();
+
+    // Re-check running_ now and then: a stopping loop answers no more requests
+    while (handoff_requested_ && running_.load()) {
+        handoff_cv_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    handoff_requested_ = false;
+    std::vector<HandoffClient> detached;
+    detached.swap(handoff_clients_);
+    return detached;
+}
+
+void Reactor::Signal() {
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        LOG_ERROR("[Reactor " << index_ << "] Failed to signal wakeup: " << strerror(errno));
+    }
+}
+
+void Reactor::ThreadFunc() {
+    PlaceThread();
+
+    if (ring_) {
+        RunUringLoop();
+        return;
+    }
+
+    constexpr int MAX_EVENTS = 64;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (running_.load()) {
+        int nfds = epoll_wait(epoll_fd_, events, MAX_EVENTS, spinning_ ? 0 : LoopTimeoutMs());
+        now_ms_ = TimerWheel::CoarseNowMs(); // The only clock read per iteration
+
+        if (nfds < 0) {
+            if (errno == EINTR) {
+                continue; // Interrupted, continue
+            }
+            LOG_ERROR("[Reactor " << index_ << "] epoll_wait failed: " << strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < nfds; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == wake_fd_) {
+                // New connections or finished offloaded requests
+                HandleWakeup();
+            } else if (fd == timer_fd_) {
+                // Inactivity timer fired
+                HandleInactivityTimer();
+            } else if (auto doorbell = shm_doorbells_.find(fd); doorbell != shm_doorbells_.end()) {
+                // Shared-memory client rang its request doorbell
+                int client_fd = doorbell->second;
+                if (!HandleShmDoorbell(client_fd)) {
+                    HandleClientClose(client_fd);
+                }
+            } else {
+                // Client data, writable socket or error
+                uint32_t mask = events[i].events;
+                bool keep = true;
+
+                if (mask & EPOLLIN) {
+                    keep = HandleClientData(fd);
+                }
+                if (keep && (mask & EPOLLOUT)) {
+                    keep = HandleClientWritable(fd);
+                }
+                if (keep && (mask & (EPOLLERR | EPOLLHUP))) {
+                    keep = false;
+                }
+                if (!keep) {
+                    HandleClientClose(fd);
+                }
+            }
+        }
+
+        if (!stalled_clients_.empty()) {
+            RetryStalledClients();
+        }
+        if (stream_timers_.Size() > 0) {
+            HandleStreamTimers();
+        }
+        if (options_.busy_poll_us > 0) {
+            UpdateBusyPoll(nfds > 0);
+        }
+    }
+}
+
+void Reactor::PlaceThread() {
+    if (options_.cpu < 0) {
+        return;
+    }
+    if (!thread_pool::PinCurrentThread(options_.cpu)) {
+        LOG_WARN("[Reactor " << index_ << "] Cannot pin to CPU " << options_.cpu << ": " << strerror(errno));
+        return;
+    }
+
+    // First touch from here puts the frame buffers on this CPU's node
+    buffer_pool_.Reserve(BUFFERS_PER_SLAB);
+    LOG_INFO("[Reactor " << index_ << "] Pinned to CPU " << options_.cpu
+             << " (NUMA node " << thread_pool::CurrentNumaNode() << ")");
+}
+
+void Reactor::UpdateBusyPoll(bool active) {
+    uint64_t now_us = MonotonicUs();
+    if (spinning_ && PollShmClients()) {
+        active = true;
+    }
+
+    if (active) {
+        spinning_ = true;
+        last_active_us_ = now_us;
+        return;
+    }
+
+    if (spinning_ && now_us - last_active_us_ >= options_.busy_poll_us) {
+        // Idle: back to blocking waits, unless a ring was written meanwhile
+        spinning_ = false;
+        if (ArmShmDoorbells()) {
+            spinning_ = true;
+            last_active_us_ = now_us;
+        }
+    }
+}
+
+bool Reactor::PollShmClients() {
+    // Draining may close clients, which edits shm_doorbells_
+    shm_poll_fds_.clear();
+    for (const auto& [doorbell, client_fd] : shm_doorbells_) {
+        shm_poll_fds_.push_back(client_fd);
+    }
+
+    bool active = false;
+    for (int client_fd : shm_poll_fds_) {
+        ClientInfo* client = clients_.Find(client_fd);
+        if (!client || !client->shm || client->read_paused || client->shm->Requests().Empty()) {
+            continue;
+        }
+        active = true;
+        client->last_activity_ms = now_ms_;
+        if (!DrainShmRequests(*client)) {
+            HandleClientClose(client_fd);
+        }
+    }
+    return active;
+}
+
+bool Reactor::ArmShmDoorbells() {
+    bool pending = false;
+    for (const auto& [doorbell, client_fd] : shm_doorbells_) {
+        ClientInfo* client = clients_.Find(client_fd);
+        if (!client || !client->shm || client->read_paused) {
+            continue;
+        }
+        // Publish that we sleep, then re-check so a racing write is not missed
+        ShmRing& ring = client->shm->Requests();
+        ring.SetReaderWaiting(true);
+        if (!ring.Empty()) {
+            ring.SetReaderWaiting(false);
+            pending = true;
+        }
+    }
+    return pending;
+}
+
+int Reactor::LoopTimeoutMs() const {
+    // 1 second, or quick retries while a client waits for pool room, or
+    // the next stream tick
+    if (!stalled_clients_.empty()) {
+        return STALL_RETRY_MS;
+    }
+    return stream_timers_.Size() > 0 ? static_cast<int>(STREAM_TICK_MS) : 1000;
+}
+
+void Reactor::HandleWakeup() {
+    uint64_t count;
+    ssize_t ret = read(wake_fd_, &count, sizeof(count));
+    (void)ret; // Counter value is irrelevant, the pending list is authoritative
+
+    std::vector<HandoffClient> pending;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending.swap(pending_clients_);
+    }
+
+    for (const auto& client : pending) {
+        if (!RegisterClient(client)) {
+            close(client.fd);
+            client_count_.fetch_sub(1);
+        }
+    }
+
+    HandleCompletions();
+    HandleDetachRequest();
+}
+
+void Reactor::HandleDetachRequest() {
+    uint32_t dictionary_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(handoff_mutex_);
+        if (!handoff_requested_) {
+            return;
+        }
+        dictionary_id = handoff_dictionary_id_;
+    }
+
+    const CompressionDictionary* dictionary = options_.compression_dictionary.get();
+    bool dictionary_moves = dictionary && dictionary->Id() == dictionary_id;
+
+    std::vector<int> movable;
+    std::vector<int> closable;
+    clients_.ForEach([&](int fd, ClientInfo& client) {
+        if (!IsBetweenRequests(client)) {
+            return; // Busy: asked again on the next round
+        }
+        bool moves = !ring_ && !client.shm && client.streams.empty() &&
+                     (client.compression != Protocol::COMPRESSION_LZ4_DICTIONARY || dictionary_moves);
+        (moves ? movable : closable).push_back(fd);
+    });
+
+    std::vector<HandoffClient> detached;
+    for (int fd : movable) {
+        ClientInfo* client = clients_.Detach(fd);
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        idle_timers_.Cancel(client->idle_timer);
+
+        HandoffClient moved;
+        moved.fd = fd;
+        moved.idle_timeout_ms = client->idle_timeout_ms;
+        moved.compression = client->compression;
+        detached.push_back(moved);
+
+        clients_.Destroy(client);
+        client_count_.fetch_sub(1);
+        service_manager_->GetMetrics().RecordConnectionClosed();
+    }
+    for (int fd : closable) {
+        HandleClientClose(fd);
+    }
+    if (!detached.empty() || !closable.empty()) {
+        LOG_INFO("[Reactor " << index_ << "] Handing off " << detached.size() << " client(s), closed "
+                 << closable.size() << " (remaining=" << clients_.Size() << ")");
+    }
+
+    std::lock_guard<std::mutex> lock(handoff_mutex_);
+    handoff_clients_ = std::move(detached);
+    handoff_requested_ = false;
+    handoff_cv_.notify_all();
+}
+
+bool Reactor::IsBetweenRequests(ClientInfo& client) const {
+    return !client.closing && client.parser.Buffer().Empty() && client.send_buffer.empty() &&
+           client.inflight_send.empty() && !client.request_in_flight && client.pending_requests.empty() &&
+           client.offloaded == 0 && !client.stalled && !client.read_paused && client.received_fds.empty() &&
+           client.recv_backlog.empty() && (!client.shm || client.shm->Requests().Empty());
+}
+
+void Reactor::HandleCompletions() {
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex_);
+        completions.swap(completions_);
+    }
+
+    for (auto& completion : completions) {
+        ClientInfo* found = FindClient(completion.fd, completion.connection_id);
+        if (!found) {
+            continue; // Client went away while its request was executing
+        }
+
+        ClientInfo& client = *found;
+        client.offloaded--;
+        if (completion.ordered) {
+            client.request_in_flight = false;
+        }
+
+        if (!completion.response.empty()) {
+            if (SendResponseFrame(client, completion.response.data(), completion.response.size(),
+                                  completion.request_id) && completion.span) {
+                completion.span->Mark(trace::ServerStage::Sent);
+                trace::Tracer::Global().Record(*completion.span);
+            }
+        } else if (completion.request_id && FindStream(client, *completion.request_id)) {
+            // A stream frame the routine failed to produce ends the stream
+            RemoveStream(client, *completion.request_id);
+            SendStreamEnd(client, completion.request_id, Protocol::STREAM_FAILED);
+        }
+
+        DrainPendingRequests(client);
+
+        if (client.read_paused && !ShouldPauseReading(client) && !ResumeReading(client)) {
+            client.closing = true;
+        }
+
+        if (client.closing) {
+            HandleClientClose(completion.fd);
+        }
+    }
+}
+
+void Reactor::RetryStalledClients() {
+    std::vector<std::pair<int, uint64_t>> stalled;
+    stalled.swap(stalled_clients_); // Clients the pool refuses again re-register
+
+    for (const auto& [fd, connection_id] : stalled) {
+        ClientInfo* found = FindClient(fd, connection_id);
+        if (!found) {
+            continue;
+        }
+
+        ClientInfo& client = *found;
+        client.stalled = false;
+        DrainPendingRequests(client);
+
+        if (client.read_paused && !ShouldPauseReading(client) && !ResumeReading(client)) {
+            client.closing = true;
+        }
+        if (client.closing) {
+            HandleClientClose(fd);
+        }
+    }
+}
+
+ClientInfo* Reactor::FindClient(int fd, uint64_t connection_id) const {
+    ClientInfo* client = clients_.Find(fd);
+    return client && client->connection_id == connection_id ? client : nullptr;
+}
+
+bool Reactor::RegisterClient(const HandoffClient& pending) {
+    int client_fd = pending.fd;
+    // Add to epoll
+    if (!ring_) {
+        struct epoll_event ev;
+        ev.events = EPOLLIN | EPOLLET; // Edge-triggered
+        ev.data.fd = client_fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
+            LOG_ERROR("[Reactor " << index_ << "] epoll_ctl failed for client: " << strerror(errno));
+            return false;
+        }
+    }
+
+    // Connection state lives in a recycled slab slot; its frame buffer is
+    // only borrowed from the pool while request bytes are buffered
+    ClientInfo* client = clients_.Emplace(client_fd, buffer_pool_);
+    client->fd = client_fd;
+    client->connection_id = next_connection_id_++;
+    if (ring_ && !ArmUringRecv(*client)) {
+        clients_.Erase(client_fd);
+        return false; // Nothing was submitted
+    }
+    client->last_activity_ms = now_ms_;
+    client->idle_timeout_ms = pending.idle_timeout_ms;
+    client->idle_timer.owner = client;
+    client->compression = pending.compression;
+    if (client->compression != Protocol::COMPRESSION_REFUSED) {
+        AllocateCompressionBuffers(); // Negotiated with the server it was handed off from
+    }
+    ScheduleIdleTimer(*client);
+
+    service_manager_->GetMetrics().RecordConnectionOpened();
+
+    LOG_INFO("[Reactor " << index_ << "] New client connected (fd=" << client_fd
+             << ", total=" << clients_.Size() << ")");
+
+    return true;
+}
+
+bool Reactor::HandleClientData(int client_fd) {
+    ClientInfo* found = clients_.Find(client_fd);
+    if (!found) {
+        return false;
+    }
+
+    ClientInfo& client = *found;
+    RingBuffer& ring = client.parser.Buffer();
+
+    if (client.read_paused && !client.shm) {
+        return true; // Backpressure: the socket keeps the data until we resume
+    }
+
+    // Edge-triggered: keep reading until the socket is drained
+    while (true) {
+        // Never zero: complete frames were consumed, so at most one
+        // partial frame (< half the ring) is buffered. Scatter into both
+        // free regions so a wrapped ring still fills in one call.
+        struct iovec iov[2];
+        uint8_t* wrapped = nullptr;
+        iov[0].iov_base = ring.WriteRegions(iov[0].iov_len, wrapped, iov[1].iov_len);
+        iov[1].iov_base = wrapped;
+
+        // recvmsg also picks up passed descriptors (shared memory, large payloads)
+        ssize_t bytes_read = RecvVectored(client_fd, iov, iov[1].iov_len > 0 ? 2 : 1, client.received_fds);
+
+        if (bytes_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                ring.ReleaseIfEmpty(); // Drained: an idle connection holds no buffer
+                break;
+            }
+            LOG_ERROR("[Reactor " << index_ << "] recv failed: " << strerror(errno));
+            return false;
+        }
+
+        if (bytes_read == 0) {
+            // Connection closed by client
+            LOG_INFO("[Reactor " << index_ << "] Client disconnected (fd=" << client_fd << ")");
+            return false;
+        }
+
+        ring.CommitWrite(static_cast<size_t>(bytes_read));
+
+        // Update activity timestamp (the wheel re-checks it when the timer is due)
+        client.last_activity_ms = now_ms_;
+
+        // Dispatch every complete frame received so far
+        if (!ProcessFrames(client)) {
+            return false;
+        }
+
+        if (ShouldPauseReading(client)) {
+            // Backpressure: leave the rest in the socket until requests complete
+            client.read_paused = true;
+            return SetReadInterest(client, false);
+        }
+
+        // Frames claim their descriptors; only a partial frame may still own some
+        if (client.received_fds.size() > MAX_PASSED_FDS) {
+            LOG_WARN("[Reactor " << index_ << "] Too many unclaimed descriptors (fd=" << client_fd << ")");
+            return false;
+        }
+    }
+
+    return true; // Keep connection alive
+}
+
+bool Reactor::HandleClientWritable(int client_fd) {
+    ClientInfo* client = clients_.Find(client_fd);
+    return client && FlushSendBuffer(*client);
+}
+
+bool Reactor::HandleShmDoorbell(int client_fd) {
+    ClientInfo* found = clients_.Find(client_fd);
+    if (!found || !found->shm) {
+        return false;
+    }
+
+    ClientInfo& client = *found;
+    ShmTransport::Drain(client.shm->RequestEventFd());
+    client.last_activity_ms = now_ms_;
+
+    // The doorbell also means the client made room in the response ring
+    if (!FlushShmBacklog(client)) {
+        return false;
+    }
+    return DrainShmRequests(client);
+}
+
+void Reactor::HandleClientClose(int client_fd) {
+    ClientInfo* client = clients_.Detach(client_fd);
+    if (!client) {
+        return;
+    }
+
+    if (client->shm) {
+        int doorbell = client->shm->RequestEventFd();
+        if (!ring_) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, doorbell, nullptr);
+        }
+        shm_doorbells_.erase(doorbell);
+    }
+    CloseFds(client->received_fds);
+    idle_timers_.Cancel(client->idle_timer);
+    ClearStreams(*client);
+
+    if (ring_) {
+        RetireUringClient(client); // Closes the socket
+    } else {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, client_fd, nullptr);
+        close(client_fd);
+        clients_.Destroy(client);
+    }
+    client_count_.fetch_sub(1);
+    service_manager_->GetMetrics().RecordConnectionClosed();
+
+    LOG_INFO("[Reactor " << index_ << "] Client closed (fd=" << client_fd
+             << ", remaining=" << clients_.Size() << ")");
+}
+
+void Reactor::HandleInactivityTimer() {
+    uint64_t expirations;
+    ssize_t ret = read(timer_fd_, &expirations, sizeof(expirations));
+    (void)ret; // Expiration count is irrelevant, the wheel tracks elapsed ticks
+
+    // Only the timers now due are visited
+    idle_timers_.Advance(now_ms_, [this](TimerNode& node) {
+        ClientInfo& client = *static_cast<ClientInfo*>(node.owner);
+        if (now_ms_ - client.last_activity_ms < client.idle_timeout_ms) {
+            ScheduleIdleTimer(client); // Active meanwhile: wait for the rest of the timeout
+            return;
+        }
+        LOG_INFO("[Reactor " << index_ << "] Closing inactive client (fd=" << client.fd << ")");
+        HandleClientClose(client.fd);
+    });
+
+    if (idle_timers_.Size() == 0) {
+        ArmInactivityTimer(false); // No ticks while nothing can time out
+    }
+}
+
+void Reactor::ScheduleIdleTimer(ClientInfo& client) {
+    if (client.idle_timeout_ms == 0) {
+        idle_timers_.Cancel(client.idle_timer);
+        return;
+    }
+
+    idle_timers_.Schedule(client.idle_timer, client.last_activity_ms + client.idle_timeout_ms);
+    if (!timer_armed_ && !ArmInactivityTimer(true)) {
+        LOG_ERROR("[Reactor " << index_ << "] Inactivity timeouts suspended");
+    }
+}
+
+void Reactor::HandleIdleTimeout(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                                std::optional<uint32_t> request_id) {
+    if (payload_len != Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed idle-timeout request (fd=" << client.fd << ")");
+        return;
+    }
+
+    ByteBuffer request(const_cast<uint8_t*>(payload), payload_len);
+    uint32_t requested = request.GetInt();
+
+    uint32_t limit = options_.max_inactivity_timeout_ms > 0 ? options_.max_inactivity_timeout_ms
+                                                            : options_.inactivity_timeout_ms;
+    uint32_t timeout = options_.inactivity_timeout_ms;
+    if (requested > 0) {
+        timeout = limit > 0 ? std::min(requested, limit) : requested;
+    }
+
+    client.idle_timeout_ms = timeout;
+    client.last_activity_ms = now_ms_;
+    ScheduleIdleTimer(client);
+
+    uint8_t response[Protocol::GetMinFrameSize() + Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE];
+    ResponseBuilder frame(Protocol::IDLE_TIMEOUT_RESPONSE_ROUTINE_ID, response, sizeof(response));
+    ByteBuffer buf(frame.Payload(), frame.PayloadCapacity());
+    buf.PutInt(timeout);
+
+    SendResponseFrame(client, response, frame.Finish(buf.Position()), request_id);
+}
+
+void Reactor::HandleStreamSubscribe(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                                    std::optional<uint32_t> request_id) {
+    if (!request_id || payload_len < Protocol::STREAM_SUBSCRIBE_HEADER_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed subscribe request (fd=" << client.fd << ")");
+        SendStreamEnd(client, request_id, Protocol::STREAM_REJECTED);
+        return;
+    }
+
+    ByteBuffer request(const_cast<uint8_t*>(payload), payload_len);
+    uint32_t routine_id = request.GetInt();
+    uint32_t interval_ms = request.GetInt();
+    uint32_t credits = request.GetInt();
+
+    // Only services (and the stats snapshot) can be streamed, not connection control
+    bool streamable = routine_id == Protocol::STATS_REQUEST_ROUTINE_ID ||
+                      (!Protocol::IsReservedRoutine(routine_id) && service_manager_->IsRoutinePresent(routine_id));
+    if (!streamable || client.streams.size() >= Protocol::MAX_STREAMS_PER_CONNECTION ||
+        FindStream(client, *request_id)) {
+        LOG_WARN("[Reactor " << index_ << "] Rejected stream of routine 0x" << std::hex << routine_id
+                 << std::dec << " (fd=" << client.fd << ")");
+        SendStreamEnd(client, request_id, Protocol::STREAM_REJECTED);
+        return;
+    }
+
+    auto stream = std::make_unique<StreamInfo>();
+    stream->client = &client;
+    stream->stream_id = *request_id;
+    stream->routine_id = routine_id;
+    stream->request.assign(payload + Protocol::STREAM_SUBSCRIBE_HEADER_SIZE, payload + payload_len);
+    stream->interval_ms = std::max(interval_ms, STREAM_TICK_MS);
+    stream->credits = credits;
+    stream->next_ms = now_ms_;
+    stream->timer.owner = stream.get();
+    client.streams.push_back(std::move(stream));
+
+    LOG_DEBUG("[Reactor " << index_ << "] Stream " << *request_id << " of routine 0x" << std::hex << routine_id
+              << std::dec << " every " << client.streams.back()->interval_ms << "ms (fd=" << client.fd << ")");
+
+    // The first frame goes out at once
+    if (credits > 0) {
+        PushStreamFrame(*client.streams.back());
+    }
+}
+
+void Reactor::HandleStreamCredit(ClientInfo& client, const uint8_t* payload, size_t payload_len) {
+    if (payload_len != Protocol::STREAM_CREDIT_PAYLOAD_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed stream credit (fd=" << client.fd << ")");
+        return;
+    }
+
+    ByteBuffer request(const_cast<uint8_t*>(payload), payload_len);
+    uint32_t stream_id = request.GetInt();
+    uint32_t credits = request.GetInt();
+
+    StreamInfo* stream = FindStream(client, stream_id);
+    if (!stream) {
+        return; // Ended meanwhile
+    }
+
+    uint64_t total = static_cast<uint64_t>(stream->credits) + credits;
+    stream->credits = static_cast<uint32_t>(std::min<uint64_t>(total, UINT32_MAX));
+    if (stream->credits > 0 && !stream->timer.IsScheduled()) {
+        // Resume a paused stream; a frame overdue meanwhile goes out on the next tick
+        stream_timers_.Schedule(stream->timer, std::max(stream->next_ms, now_ms_));
+    }
+}
+
+void Reactor::HandleStreamCancel(ClientInfo& client, const uint8_t* payload, size_t payload_len) {
+    if (payload_len != Protocol::STREAM_CANCEL_PAYLOAD_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed stream cancel (fd=" << client.fd << ")");
+        return;
+    }
+
+    ByteBuffer request(const_cast<uint8_t*>(payload), payload_len);
+    uint32_t stream_id = request.GetInt();
+    if (FindStream(client, stream_id)) {
+        RemoveStream(client, stream_id);
+        SendStreamEnd(client, stream_id, Protocol::STREAM_CANCELLED);
+    }
+}
+
+void Reactor::HandleStreamTimers() {
+    // Pushing may fail a connection; it is closed once the wheel is done
+    std::vector<std::pair<int, uint64_t>> failed;
+
+    stream_timers_.Advance(now_ms_, [this, &failed](TimerNode& node) {
+        StreamInfo& stream = *static_cast<StreamInfo*>(node.owner);
+        ClientInfo& client = *stream.client;
+        if (client.closing) {
+            return;
+        }
+        PushStreamFrame(stream);
+        if (client.closing) {
+            failed.emplace_back(client.fd, client.connection_id);
+        }
+    });
+
+    for (const auto& [fd, connection_id] : failed) {
+        if (FindClient(fd, connection_id)) {
+            HandleClientClose(fd);
+        }
+    }
+}
+
+void Reactor::PushStreamFrame(StreamInfo& stream) {
+    ClientInfo& client = *stream.client;
+
+    if (worker_pool_ && !service_manager_->IsInlineSafe(stream.routine_id)) {
+        bool pool_full = false;
+        if (!OffloadRequest(client, stream.routine_id, stream.request.data(), stream.request.size(),
+                            stream.stream_id, nullptr, pool_full)) {
+            // No room in the pool: this frame is skipped, the credit kept
+            ScheduleStream(stream);
+            return;
+        }
+    } else {
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = service_manager_->ExecuteService(
+            stream.routine_id, stream.request.data(), stream.request.size(),
+            response, sizeof(response) - Protocol::REQUEST_ID_SIZE);
+        if (response_len == 0) {
+            uint32_t stream_id = stream.stream_id;
+            RemoveStream(client, stream_id); // Destroys stream
+            SendStreamEnd(client, stream_id, Protocol::STREAM_FAILED);
+            return;
+        }
+        SendResponseFrame(client, response, response_len, stream.stream_id);
+    }
+
+    stream.credits--;
+    ScheduleStream(stream);
+}
+
+void Reactor::ScheduleStream(StreamInfo& stream) {
+    // Keep the cadence; a stream that fell behind skips the missed frames
+    stream.next_ms += stream.interval_ms;
+    if (stream.next_ms <= now_ms_) {
+        stream.next_ms = now_ms_ + stream.interval_ms;
+    }
+    if (stream.credits > 0) {
+        stream_timers_.Schedule(stream.timer, stream.next_ms);
+    }
+}
+
+StreamInfo* Reactor::FindStream(ClientInfo& client, uint32_t stream_id) {
+    for (auto& stream : client.streams) {
+        if (stream->stream_id == stream_id) {
+            return stream.get();
+        }
+    }
+    return nullptr;
+}
+
+void Reactor::SendStreamEnd(ClientInfo& client, std::optional<uint32_t> stream_id, uint8_t status) {
+    uint8_t response[Protocol::GetMinFrameSize() + Protocol::STREAM_END_PAYLOAD_SIZE];
+    ResponseBuilder frame(Protocol::STREAM_END_ROUTINE_ID, response, sizeof(response));
+    frame.Payload()[0] = status;
+
+    SendResponseFrame(client, response, frame.Finish(Protocol::STREAM_END_PAYLOAD_SIZE), stream_id);
+}
+
+void Reactor::RemoveStream(ClientInfo& client, uint32_t stream_id) {
+    for (auto it = client.streams.begin(); it != client.streams.end(); ++it) {
+        if ((*it)->stream_id == stream_id) {
+            stream_timers_.Cancel((*it)->timer);
+            client.streams.erase(it);
+            return;
+        }
+    }
+}
+
+void Reactor::ClearStreams(ClientInfo& client) {
+    for (auto& stream : client.streams) {
+        stream_timers_.Cancel(stream->timer);
+    }
+    client.streams.clear();
+}
+
+bool Reactor::ProcessFrames(ClientInfo& client) {
+    FrameView frame;
+    FrameParser::Result result = FrameParser::Result::NeedMore;
+    if (trace_sampler_.Enabled()) {
+        client.received_ticks = trace::Now();
+    }
+
+    while (!client.closing && !ShouldPauseReading(client) &&
+           (result = client.parser.Next(frame)) == FrameParser::Result::Frame) {
+        DispatchRequest(client, frame);
+    }
+
+    if (result == FrameParser::Result::Error) {
+        LOG_WARN("[Reactor " << index_ << "] Protocol error (fd=" << client.fd
+                 << "): " << client.parser.GetError());
+        return false;
+    }
+
+    return !client.closing;
+}
+
+void Reactor::DispatchRequest(ClientInfo& client, const FrameView& frame) {
+    // Frames with a request ID are matched by the client and may complete
+    // out of order; only untagged frames keep per-connection ordering
+    bool tagged = (frame.version & Protocol::FLAG_REQUEST_ID) != 0;
+
+    // Claim the memfd now: descriptors are matched to frames in arrival order
+    std::shared_ptr<const PayloadView> large_payload;
+    if (frame.version & Protocol::FLAG_FD_PAYLOAD) {
+        large_payload = TakeLargePayload(client, frame);
+        if (!large_payload) {
+            client.closing = true;
+            return;
+        }
+    }
+
+    if (options_.overload_policy == OverloadPolicy::Reject && AtConnectionLimit(client) &&
+        worker_pool_ && !service_manager_->IsInlineSafe(frame.routine_id) &&
+        frame.routine_id != Protocol::SHM_NEGOTIATE_REQUEST_ROUTINE_ID &&
+        frame.routine_id != Protocol::IDLE_TIMEOUT_REQUEST_ROUTINE_ID) {
+        // Shed load: this request would only wait behind the others
+        SendBusyResponse(client, frame.routine_id, FrameRequestId(frame));
+        return;
+    }
+
+    if (client.request_in_flight && !tagged) {
+        // Wait behind the offloaded request
+        client.pending_requests.push_back(
+            PendingRequest{std::vector<uint8_t>(frame.data, frame.data + frame.length), std::move(large_payload),
+                           client.received_ticks});
+        return;
+    }
+
+    size_t response_len = ProcessClientRequest(client, frame.data, frame.length, std::move(large_payload),
+                                               client.received_ticks);
+    (void)response_len; // Response sent directly to client (or later, when offloaded)
+}
+
+std::shared_ptr<const PayloadView> Reactor::TakeLargePayload(ClientInfo& client, const FrameView& frame) {
+    size_t extension_len = Protocol::GetExtensionSize(frame.version);
+    if (frame.payload_len != extension_len + Protocol::FD_PAYLOAD_HEADER_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed large-payload frame (fd=" << client.fd << ")");
+        return nullptr;
+    }
+    if (client.received_fds.empty()) {
+        LOG_WARN("[Reactor " << index_ << "] Large-payload frame without a descriptor (fd=" << client.fd << ")");
+        return nullptr;
+    }
+
+    ByteBuffer header(const_cast<uint8_t*>(frame.payload + extension_len), Protocol::FD_PAYLOAD_HEADER_SIZE);
+    size_t size = header.GetInt();
+
+    int memfd = client.received_fds.front();
+    client.received_fds.erase(client.received_fds.begin());
+
+    std::string error;
+    std::shared_ptr<const PayloadView> payload = PayloadView::Map(memfd, size, error); // Owns memfd now
+    if (!payload) {
+        LOG_WARN("[Reactor " << index_ << "] Rejected large payload (fd=" << client.fd << "): " << error);
+    }
+    return payload;
+}
+
+size_t Reactor::ProcessClientRequest(ClientInfo& client, const uint8_t* data, size_t len,
+                                     std::shared_ptr<const PayloadView> large_payload,
+                                     uint64_t received_ticks) {
+    if (len < Protocol::GetMinFrameSize()) {
+        LOG_WARN("[Reactor " << index_ << "] Packet too small: " << len << " bytes");
+        return 0;
+    }
+
+    try {
+        // Parse frame
+        ByteBuffer request(const_cast<uint8_t*>(data), len);
+
+        uint8_t start = request.GetByte();
+        if (start != Protocol::START_BYTE) {
+            LOG_WARN("[Reactor " << index_ << "] Invalid start byte: 0x" << std::hex << (int)start << std::dec);
+            return 0;
+        }
+
+        uint32_t frame_len = request.GetInt();
+        (void)frame_len; // Frame length already validated in protocol parsing
+
+        uint32_t routine_id = request.GetInt();
+        uint8_t version = request.GetByte();
+
+        uint8_t allowed_flags = Protocol::FLAG_REQUEST_ID | Protocol::FLAG_TRACE_ID | Protocol::FLAG_FD_PAYLOAD;
+        if (client.compression != Protocol::COMPRESSION_REFUSED && !large_payload) {
+            allowed_flags |= Protocol::FLAG_COMPRESSED;
+        }
+        if ((version & Protocol::VERSION_MASK) != Protocol::VERSION ||
+            (version & Protocol::FLAGS_MASK & ~allowed_flags) != 0 ||
+            ((version & Protocol::FLAG_FD_PAYLOAD) != 0) != (large_payload != nullptr)) {
+            LOG_WARN("[Reactor " << index_ << "] Unsupported version: " << (int)version);
+            return 0;
+        }
+
+        size_t extension_len = Protocol::GetExtensionSize(version);
+        if (len < Protocol::GetMinFrameSize() + extension_len) {
+            LOG_WARN("[Reactor " << index_ << "] Packet too small for header extension: " << len << " bytes");
+            return 0;
+        }
+
+        std::optional<uint32_t> request_id;
+        if (version & Protocol::FLAG_REQUEST_ID) {
+            request_id = request.GetInt();
+        }
+        uint64_t trace_id = 0;
+        if (version & Protocol::FLAG_TRACE_ID) {
+            trace_id = static_cast<uint64_t>(request.GetLong());
+        }
+
+        // Transport negotiation is connection state, not a service
+        if (routine_id == Protocol::SHM_NEGOTIATE_REQUEST_ROUTINE_ID) {
+            HandleShmNegotiate(client, request_id);
+            return 0;
+        }
+
+        const uint8_t* payload = data + request.Position();
+        size_t payload_len = len - request.Position() - 1; // Exclude END_BYTE
+
+        if (version & Protocol::FLAG_COMPRESSED) {
+            // Valid until the next compressed request; executing and offloading copy what they keep
+            size_t inflated = DecompressPayload(payload, payload_len, inflate_buffer_.data(), inflate_buffer_.size(),
+                                                DictionaryFor(client));
+            if (inflated == 0) {
+                LOG_WARN("[Reactor " << index_ << "] Corrupt compressed payload (fd=" << client.fd << ")");
+                return 0;
+            }
+            payload = inflate_buffer_.data();
+            payload_len = inflated;
+        }
+
+        if (routine_id == Protocol::COMPRESSION_NEGOTIATE_REQUEST_ROUTINE_ID && !large_payload) {
+            HandleCompressionNegotiate(client, payload, payload_len, request_id);
+            return 0;
+        }
+
+        // So is the connection's inactivity timeout
+        if (routine_id == Protocol::IDLE_TIMEOUT_REQUEST_ROUTINE_ID && !large_payload) {
+            HandleIdleTimeout(client, payload, payload_len, request_id);
+            return 0;
+        }
+
+        // And its streams
+        if (routine_id == Protocol::STREAM_SUBSCRIBE_ROUTINE_ID) {
+            HandleStreamSubscribe(client, large_payload ? nullptr : payload, large_payload ? 0 : payload_len,
+                                  request_id);
+            return 0;
+        }
+        if (routine_id == Protocol::STREAM_CREDIT_ROUTINE_ID && !large_payload) {
+            HandleStreamCredit(client, payload, payload_len);
+            return 0;
+        }
+        if (routine_id == Protocol::STREAM_CANCEL_ROUTINE_ID && !large_payload) {
+            HandleStreamCancel(client, payload, payload_len);
+            return 0;
+        }
+        if (large_payload) {
+            // Read straight from the sealed mapping
+            payload = large_payload->Data();
+            payload_len = large_payload->Size();
+        }
+
+        // Sampled requests, and those the client traces, record their stages
+        trace::Span span;
+        bool traced = trace_sampler_.Enabled() && (trace_id != 0 || trace_sampler_.Sample());
+        if (traced) {
+            span.trace_id = trace_id;
+            span.routine_id = routine_id;
+            span.ticks[static_cast<size_t>(trace::ServerStage::Received)] = received_ticks;
+            span.Mark(trace::ServerStage::Parsed);
+        }
+
+        // Slow services go to the worker pool, cheap ones stay on this thread
+        if (worker_pool_ && !service_manager_->IsInlineSafe(routine_id)) {
+            bool pool_full = false;
+            if (!OffloadRequest(client, routine_id, payload, payload_len, request_id, large_payload, pool_full,
+                                traced ? std::make_unique<trace::Span>(span) : nullptr) &&
+                pool_full) {
+                if (options_.overload_policy == OverloadPolicy::Reject) {
+                    SendBusyResponse(client, routine_id, request_id);
+                } else {
+                    // Retry the frame once the pool has room; the connection
+                    // stops consuming frames meanwhile, so nothing overtakes it
+                    client.pending_requests.push_front(
+                        PendingRequest{std::vector<uint8_t>(data, data + len), std::move(large_payload),
+                                       received_ticks});
+                    if (!client.stalled) {
+                        client.stalled = true;
+                        stalled_clients_.emplace_back(client.fd, client.connection_id);
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // Prepare response buffer (the echoed request ID must still fit a frame)
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+
+        // Execute service
+        trace::ScopedActiveSpan active_span(traced ? &span : nullptr);
+        size_t response_len = service_manager_->ExecuteService(
+            routine_id,
+            payload,
+            payload_len,
+            response,
+            sizeof(response) - extension_len
+        );
+        if (traced) {
+            span.Mark(trace::ServerStage::Executed);
+        }
+
+        if (response_len > 0 && SendResponseFrame(client, response, response_len, request_id)) {
+            if (traced) {
+                span.Mark(trace::ServerStage::Sent);
+                trace::Tracer::Global().Record(span);
+            }
+            return response_len;
+        }
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("[Reactor " << index_ << "] Exception processing request: " << e.what());
+        return 0;
+    }
+}
+
+bool Reactor::OffloadRequest(ClientInfo& client, uint32_t routine_id,
+                             const uint8_t* payload, size_t payload_len,
+                             std::optional<uint32_t> request_id,
+                             const std::shared_ptr<const PayloadView>& large_payload,
+                             bool& pool_full, std::unique_ptr<trace::Span> span) {
+    int fd = client.fd;
+    uint64_t connection_id = client.connection_id;
+    bool ordered = !request_id.has_value();
+
+    // Inline payloads live in the parser ring and must be copied; a mapped
+    // large payload is shared with the worker instead
+    std::vector<uint8_t> request;
+    if (!large_payload) {
+        request.assign(payload, payload + payload_len);
+    }
+
+    uint64_t enqueued_ns = Metrics::NowNs();
+    auto task = [this, fd, connection_id, ordered, routine_id, request_id, enqueued_ns,
+                 request = std::move(request), large_payload, span = std::move(span)]() mutable {
+        service_manager_->GetMetrics().RecordQueueWait(routine_id, Metrics::NowNs() - enqueued_ns);
+        size_t extension_len = request_id ? Protocol::REQUEST_ID_SIZE : 0;
+        if (span) {
+            span->Mark(trace::ServerStage::Dequeued);
+        }
+
+        // Built in this worker's frame buffer; only the response bytes are queued
+        thread_local uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len;
+        {
+            trace::ScopedActiveSpan active_span(span.get());
+            response_len = service_manager_->ExecuteService(
+                routine_id,
+                large_payload ? large_payload->Data() : request.data(),
+                large_payload ? large_payload->Size() : request.size(),
+                response,
+                sizeof(response) - extension_len
+            );
+        }
+        if (span) {
+            span->Mark(trace::ServerStage::Executed);
+        }
+
+        // Tagged when sent; a traced request's span is recorded then
+        PostCompletion(Completion{fd, connection_id, ordered,
+                                  std::vector<uint8_t>(response, response + response_len), request_id,
+                                  std::move(span)});
+    };
+    static_assert(thread_pool::Task::StoresInline<decltype(task)>(),
+                  "Offloaded requests should be queued without a heap allocation");
+
+    try {
+        // Fire-and-forget: the response comes back as a Completion
+        if (!worker_pool_->TryPost(std::move(task))) {
+            pool_full = true;
+            return false;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("[Reactor " << index_ << "] Failed to offload request: " << e.what());
+        return false;
+    }
+
+    client.offloaded++;
+    if (ordered) {
+        client.request_in_flight = true;
+    }
+    return true;
+}
+
+void Reactor::DrainPendingRequests(ClientInfo& client) {
+    while (!client.request_in_flight && !client.stalled && !client.pending_requests.empty()) {
+        PendingRequest pending = std::move(client.pending_requests.front());
+        client.pending_requests.pop_front();
+        ProcessClientRequest(client, pending.frame.data(), pending.frame.size(), std::move(pending.payload),
+                             pending.received_ticks);
+    }
+}
+
+bool Reactor::AtConnectionLimit(const ClientInfo& client) const {
+    size_t limit = options_.max_pending_per_connection;
+    return limit > 0 && client.offloaded + client.pending_requests.size() >= limit;
+}
+
+bool Reactor::ShouldPauseReading(const ClientInfo& client) const {
+    if (client.stalled) {
+        return true;
+    }
+    if (!AtConnectionLimit(client)) {
+        return false;
+    }
+    // Untagged frames are answered in order, so behind an in-flight request
+    // even a rejection would have to wait: pause under either policy
+    return options_.overload_policy == OverloadPolicy::Backpressure || client.request_in_flight;
+}
+
+bool Reactor::ResumeReading(ClientInfo& client) {
+    client.read_paused = false;
+
+    // Frames already buffered go first; they may pause the connection again
+    if (!ProcessFrames(client)) {
+        return false;
+    }
+    if (ShouldPauseReading(client)) {
+        client.read_paused = true;
+        return true;
+    }
+
+    if (client.shm) {
+        return DrainShmRequests(client);
+    }
+    if (ring_) {
+        // Bytes that arrived while pausing go first
+        std::vector<uint8_t> backlog;
+        backlog.swap(client.recv_backlog);
+        return ConsumeReceived(client, backlog.data(), backlog.size()) &&
+               (client.read_paused || ArmUringRecv(client));
+    }
+    return SetReadInterest(client, true) && HandleClientData(client.fd);
+}
+
+void Reactor::SendBusyResponse(ClientInfo& client, uint32_t routine_id, std::optional<uint32_t> request_id) {
+    service_manager_->GetMetrics().RecordRejected(routine_id);
+
+    uint8_t response[Protocol::GetMinFrameSize() + Protocol::SERVER_BUSY_PAYLOAD_SIZE];
+    ResponseBuilder frame(Protocol::SERVER_BUSY_ROUTINE_ID, response, sizeof(response));
+    ByteBuffer buf(frame.Payload(), frame.PayloadCapacity());
+    buf.PutInt(routine_id);
+
+    SendResponseFrame(client, response, frame.Finish(buf.Position()), request_id);
+}
+
+void Reactor::HandleCompressionNegotiate(ClientInfo& client, const uint8_t* payload, size_t payload_len,
+                                         std::optional<uint32_t> request_id) {
+    if (payload_len != Protocol::COMPRESSION_NEGOTIATE_PAYLOAD_SIZE) {
+        LOG_WARN("[Reactor " << index_ << "] Malformed compression request (fd=" << client.fd << ")");
+        return;
+    }
+
+    ByteBuffer request(const_cast<uint8_t*>(payload), payload_len);
+    uint32_t dictionary_id = request.GetInt();
+
+    uint8_t status = Protocol::COMPRESSION_REFUSED;
+    if (options_.compression) {
+        const CompressionDictionary* dictionary = options_.compression_dictionary.get();
+        status = dictionary_id != 0 && dictionary && dictionary->Id() == dictionary_id
+                     ? Protocol::COMPRESSION_LZ4_DICTIONARY
+                     : Protocol::COMPRESSION_LZ4;
+        AllocateCompressionBuffers();
+    }
+
+    // Too short to be compressed itself
+    client.compression = status;
+    uint8_t response[Protocol::GetMinFrameSize() + Protocol::COMPRESSION_NEGOTIATE_RESPONSE_SIZE];
+    ResponseBuilder frame(Protocol::COMPRESSION_NEGOTIATE_RESPONSE_ROUTINE_ID, response, sizeof(response));
+    frame.Payload()[0] = status;
+    SendResponseFrame(client, response, frame.Finish(Protocol::COMPRESSION_NEGOTIATE_RESPONSE_SIZE), request_id);
+
+    LOG_DEBUG("[Reactor " << index_ << "] Compression " << static_cast<int>(status) << " (fd=" << client.fd << ")");
+}
+
+const CompressionDictionary* Reactor::DictionaryFor(const ClientInfo& client) const {
+    return client.compression == Protocol::COMPRESSION_LZ4_DICTIONARY ? options_.compression_dictionary.get()
+                                                                       : nullptr;
+}
+
+void Reactor::AllocateCompressionBuffers() {
+    if (inflate_buffer_.empty()) {
+        inflate_buffer_.resize(Protocol::MAX_DECOMPRESSED_PAYLOAD_SIZE);
+        deflate_buffer_.resize(Protocol::MAX_PACKET_SIZE);
+    }
+}
+
+void Reactor::HandleShmNegotiate(ClientInfo& client, std::optional<uint32_t> request_id) {
+    std::vector<int> fds;
+    fds.swap(client.received_fds);
+
+    uint8_t status = Protocol::SHM_ACCEPTED;
+    std::unique_ptr<ShmTransport> transport;
+    std::string error;
+
+    if (!options_.shared_memory) {
+        status = Protocol::SHM_DISABLED;
+    } else if (fds.size() != 3) {
+        status = Protocol::SHM_INVALID;
+        error = "expected 3 descriptors, got " + std::to_string(fds.size());
+    } else if (client.shm || client.request_in_flight || client.offloaded > 0 ||
+               !client.pending_requests.empty() || !client.send_buffer.empty() ||
+               !client.inflight_send.empty()) {
+        // Switching mid-stream would reorder responses
+        status = Protocol::SHM_BUSY;
+    } else {
+        transport = ShmTransport::Attach(fds[0], fds[1], fds[2], error); // Owns the fds now
+        fds.clear();
+        if (!transport) {
+            status = Protocol::SHM_INVALID;
+        }
+    }
+    CloseFds(fds);
+
+    if (transport && !ring_) {
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = transport->RequestEventFd();
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, transport->RequestEventFd(), &ev) < 0) {
+            error = "epoll_ctl failed for doorbell: " + std::string(strerror(errno));
+            status = Protocol::SHM_INVALID;
+            transport.reset();
+        }
+    }
+
+    if (!error.empty()) {
+        LOG_WARN("[Reactor " << index_ << "] Shared memory rejected (fd=" << client.fd
+                 << "): " << error);
+    }
+
+    // The answer still travels over the socket
+    uint8_t response[Protocol::GetMinFrameSize() + 1];
+    ResponseBuilder frame(Protocol::SHM_NEGOTIATE_RESPONSE_ROUTINE_ID, response, sizeof(response));
+    frame.Payload()[0] = status;
+
+    if (!SendResponseFrame(client, response, frame.Finish(1), request_id) || !transport) {
+        if (transport && !ring_) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, transport->RequestEventFd(), nullptr);
+        }
+        return;
+    }
+
+    // io_uring: the answer leaves send_buffer now, which from here on
+    // holds response-ring backlog
+    if (ring_ && !StartUringSend(client)) {
+        client.closing = true;
+        return;
+    }
+
+    shm_doorbells_[transport->RequestEventFd()] = client.fd;
+    client.shm = std::move(transport);
+
+    if (ring_ && !WatchShmDoorbell(client)) {
+        client.closing = true;
+        return;
+    }
+
+    LOG_INFO("[Reactor " << index_ << "] Shared memory transport active (fd=" << client.fd
+             << ", ring=" << client.shm->Requests().Capacity() << " bytes)");
+
+    if (!DrainShmRequests(client)) {
+        client.closing = true;
+    }
+}
+
+bool Reactor::DrainShmRequests(ClientInfo& client) {
+    ShmRing& ring = client.shm->Requests();
+    RingBuffer& buffer = client.parser.Buffer();
+
+    // Awake: the client need not ring while we are draining
+    ring.SetReaderWaiting(false);
+
+    while (true) {
+        if (ShouldPauseReading(client)) {
+            // Backpressure: the client's writes block on the full ring;
+            // ResumeReading() drains it
+            client.read_paused = true;
+            return true;
+        }
+
+        size_t space = 0;
+        uint8_t* dst = buffer.WritePtr(space);
+
+        bool corrupt = false;
+        size_t n = ring.Read(dst, space, corrupt);
+        if (corrupt) {
+            LOG_WARN("[Reactor " << index_ << "] Corrupt shared memory ring (fd=" << client.fd << ")");
+            return false;
+        }
+
+        if (n == 0) {
+            if (spinning_) {
+                break; // Busy polling reads the ring again next iteration, no doorbell needed
+            }
+            // Publish that we sleep, then re-check so a racing write is not missed
+            ring.SetReaderWaiting(true);
+            if (ring.Empty()) {
+                break;
+            }
+            ring.SetReaderWaiting(false);
+            continue;
+        }
+
+        buffer.CommitWrite(n);
+        if (!ProcessFrames(client)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Reactor::SendShmResponse(ClientInfo& client, const uint8_t* data, size_t len) {
+    // Keep order: only write directly when no backlog is waiting
+    if (client.send_buffer.empty()) {
+        size_t written = client.shm->Responses().Write(data, len);
+        if (written > 0) {
+            NotifyShmReader(client);
+        }
+        data += written;
+        len -= written;
+    }
+
+    if (len == 0) {
+        return true;
+    }
+
+    client.send_buffer.insert(client.send_buffer.end(), data, data + len);
+    return FlushShmBacklog(client);
+}
+
+bool Reactor::FlushShmBacklog(ClientInfo& client) {
+    ShmRing& ring = client.shm->Responses();
+
+    while (client.send_offset < client.send_buffer.size()) {
+        size_t written = ring.Write(client.send_buffer.data() + client.send_offset,
+                                    client.send_buffer.size() - client.send_offset);
+        if (written > 0) {
+            client.send_offset += written;
+            NotifyShmReader(client);
+            continue;
+        }
+        if (ring.WriterWaiting()) {
+            return true; // Already asked and re-checked: wait for the doorbell
+        }
+        // Ask the client to ring back, then retry once in case it just made room
+        ring.SetWriterWaiting(true);
+    }
+
+    ring.SetWriterWaiting(false);
+    std::vector<uint8_t>().swap(client.send_buffer); // Backlogs are rare: do not keep the memory
+    client.send_offset = 0;
+    return true;
+}
+
+void Reactor::NotifyShmReader(ClientInfo& client) {
+    if (client.shm->Responses().ReaderWaiting()) {
+        ShmTransport::Notify(client.shm->ResponseEventFd());
+    }
+}
+
+bool Reactor::SendResponseFrame(ClientInfo& client, const uint8_t* frame, size_t len,
+                                std::optional<uint32_t> request_id) {
+    if (client.compression != Protocol::COMPRESSION_REFUSED &&
+        len >= Protocol::GetMinFrameSize() + options_.compression_threshold) {
+        if (size_t compressed_len = CompressResponseFrame(frame, len, deflate_buffer_.data(),
+                                                          deflate_buffer_.size(), DictionaryFor(client))) {
+            frame = deflate_buffer_.data();
+            len = compressed_len;
+        }
+    }
+
+    ResponseSegments segments;
+    if (!BuildResponseSegments(frame, len, request_id, segments)) {
+        LOG_ERROR("[Reactor " << index_ << "] Malformed response frame: " << len << " bytes");
+        return false;
+    }
+    return SendResponse(client, segments.iov, segments.iovcnt);
+}
+
+bool Reactor::SendResponse(ClientInfo& client, const struct iovec* iov, size_t iovcnt) {
+    if (client.closing) {
+        return false;
+    }
+
+    if (client.shm) {
+        for (size_t i = 0; i < iovcnt; ++i) {
+            if (!SendShmResponse(client, static_cast<const uint8_t*>(iov[i].iov_base), iov[i].iov_len)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (ring_) {
+        // Goes out with the next io_uring_enter, behind anything already queued
+        for (size_t i = 0; i < iovcnt; ++i) {
+            const uint8_t* data = static_cast<const uint8_t*>(iov[i].iov_base);
+            client.send_buffer.insert(client.send_buffer.end(), data, data + iov[i].iov_len);
+        }
+        QueueUringSend(client);
+        return true;
+    }
+
+    struct iovec pending[MAX_RESPONSE_SEGMENTS];
+    std::copy(iov, iov + iovcnt, pending);
+    struct iovec* next = pending;
+    size_t remaining = iovcnt;
+
+    // Fast path: nothing queued, gather-write straight to the socket
+    while (client.send_buffer.empty() && remaining > 0) {
+        ssize_t sent = SendVectored(client.fd, next, remaining);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            LOG_ERROR("[Reactor " << index_ << "] send failed: " << strerror(errno));
+            client.closing = true;
+            return false;
+        }
+        remaining = AdvanceIovec(next, remaining, static_cast<size_t>(sent));
+    }
+
+    if (remaining == 0) {
+        return true;
+    }
+
+    // Socket is full: keep the rest (after anything already queued)
+    for (size_t i = 0; i < remaining; ++i) {
+        const uint8_t* data = static_cast<const uint8_t*>(next[i].iov_base);
+        client.send_buffer.insert(client.send_buffer.end(), data, data + next[i].iov_len);
+    }
+    return SetWriteInterest(client, true);
+}
+
+bool Reactor::FlushSendBuffer(ClientInfo& client) {
+    while (client.send_offset < client.send_buffer.size()) {
+        ssize_t sent = send(client.fd,
+                            client.send_buffer.data() + client.send_offset,
+                            client.send_buffer.size() - client.send_offset,
+                            MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true; // Wait for the next EPOLLOUT
+            }
+            LOG_ERROR("[Reactor " << index_ << "] send failed: " << strerror(errno));
+            return false;
+        }
+        client.send_offset += static_cast<size_t>(sent);
+    }
+
+    std::vector<uint8_t>().swap(client.send_buffer); // Backlogs are rare: do not keep the memory
+    client.send_offset = 0;
+    return SetWriteInterest(client, false);
+}
+
+bool Reactor::SetWriteInterest(ClientInfo& client, bool enabled) {
+    if (client.write_armed == enabled) {
+        return true;
+    }
+    if (!UpdateInterest(client, !client.read_paused || client.shm != nullptr, enabled)) {
+        return false;
+    }
+
+    client.write_armed = enabled;
+    return true;
+}
+
+bool Reactor::SetReadInterest(ClientInfo& client, bool enabled) {
+    if (client.shm) {
+        return true; // The socket only reports the disconnect; keep it armed
+    }
+    return UpdateInterest(client, enabled, client.write_armed);
+}
+
+bool Reactor::UpdateInterest(ClientInfo& client, bool readable, bool writable) {
+    struct epoll_event ev;
+    ev.events = EPOLLET;
+    if (readable) {
+        ev.events |= EPOLLIN;
+    }
+    if (writable) {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.fd = client.fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &ev) < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] epoll_ctl failed to update client: " << strerror(errno));
+        client.closing = true;
+        return false;
+    }
+    return true;
+}
+
+void Reactor::PostCompletion(Completion completion) {
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex_);
+        completions_.push_back(std::move(completion));
+    }
+    Signal();
+}
+
+bool Reactor::CreateInactivityTimer() {
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (timer_fd_ < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] timerfd_create failed: " << strerror(errno));
+        return false;
+    }
+
+    // Armed by the first timeout scheduled (see ArmInactivityTimer)
+    timer_armed_ = false;
+
+    if (ring_) {
+        return true; // Polled through the ring (see RunUringLoop)
+    }
+
+    // Add to epoll
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = timer_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev) < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] epoll_ctl failed for timer: " << strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool Reactor::ArmInactivityTimer(bool enabled) {
+    // Tick every IDLE_TICK_MS while timeouts are scheduled, otherwise stay quiet
+    struct itimerspec its;
+    its.it_value.tv_sec = enabled ? IDLE_TICK_MS / 1000 : 0;
+    its.it_value.tv_nsec = enabled ? (IDLE_TICK_MS % 1000) * 1000000L : 0;
+    its.it_interval = its.it_value;
+
+    if (timerfd_settime(timer_fd_, 0, &its, nullptr) < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] timerfd_settime failed: " << strerror(errno));
+        return false;
+    }
+    timer_armed_ = enabled;
+    return true;
+}
+
+bool Reactor::CreateWakeupEvent() {
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] eventfd failed: " << strerror(errno));
+        return false;
+    }
+
+    if (ring_) {
+        return true; // Polled through the ring (see RunUringLoop)
+    }
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) < 0) {
+        LOG_ERROR("[Reactor " << index_ << "] epoll_ctl failed for wakeup: " << strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void Reactor::CloseAllClients() {
+    clients_.ForEach([this](int fd, ClientInfo& client) {
+        if (epoll_fd_ >= 0) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        close(fd);
+        CloseFds(client.received_fds);
+        idle_timers_.Cancel(client.idle_timer);
+        ClearStreams(client);
+    });
+    clients_.Clear();
+    for (ClientInfo* client : retired_clients_) {
+        clients_.Destroy(client);
+    }
+    retired_clients_.clear();
+    send_queue_.clear();
+    shm_doorbells_.clear(); // Doorbells were owned by the clients' transports
+
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex_);
+        completions_.clear();
+    }
+
+    // Connections handed over after the loop stopped
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    for (const auto& client : pending_clients_) {
+        close(client.fd);
+    }
+    pending_clients_.clear();
+
+    client_count_.store(0);
+}
+
+void Reactor::CloseDescriptors() {
+    if (timer_fd_ >= 0) {
+        close(timer_fd_);
+        timer_fd_ = -1;
+    }
+
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    ring_.reset();
+}
+
+bool Reactor::CreateUring() {
+    std::string error;
+    std::unique_ptr<IoUring> ring = IoUring::Create(URING_ENTRIES, error);
+    if (!ring || !ring->SetupBufferRing(URING_BUFFER_GROUP, URING_RECV_BUFFERS, URING_RECV_BUFFER_SIZE, error)) {
+        LOG_WARN("[Reactor " << index_ << "] io_uring unavailable, using epoll: " << error);
+        return false;
+    }
+
+    // Multishot recvmsg lays out each buffer as header, control data, payload
+    std::memset(&recv_msg_, 0, sizeof(recv_msg_));
+    recv_msg_.msg_controllen = CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS);
+
+    ring_ = std::move(ring);
+    return true;
+}
+
+void Reactor::RunUringLoop() {
+    if (!WatchUring(wake_fd_, URING_WAKE) || !WatchUring(timer_fd_, URING_TIMER)) {
+        return;
+    }
+
+    while (running_.load()) {
+        // Responses produced since the last wait go out with this enter
+        FlushUringSends();
+
+        int ret = ring_->SubmitAndWait(spinning_ ? 0 : 1, LoopTimeoutMs());
+        now_ms_ = TimerWheel::CoarseNowMs(); // The only clock read per iteration
+
+        if (ret < 0) {
+            LOG_ERROR("[Reactor " << index_ << "] io_uring_enter failed: " << strerror(-ret));
+            break;
+        }
+
+        unsigned completed = ring_->ForEachCompletion([this](const io_uring_cqe& cqe) { HandleUringCompletion(cqe); });
+
+        if (!stalled_clients_.empty()) {
+            RetryStalledClients();
+        }
+        if (stream_timers_.Size() > 0) {
+            HandleStreamTimers();
+        }
+        if (options_.busy_poll_us > 0) {
+            UpdateBusyPoll(completed > 0);
+        }
+    }
+
+    DrainUring();
+}
+
+io_uring_sqe* Reactor::NextSqe() {
+    io_uring_sqe* sqe = ring_->GetSqe();
+    if (!sqe) {
+        LOG_ERROR("[Reactor " << index_ << "] io_uring submission queue full");
+    }
+    return sqe;
+}
+
+bool Reactor::WatchUring(int fd, uint64_t user_data) {
+    io_uring_sqe* sqe = NextSqe();
+    if (!sqe) {
+        return false;
+    }
+    IoUring::PrepPollMultishot(sqe, fd, POLLIN, user_data);
+    return true;
+}
+
+void Reactor::HandleUringCompletion(const io_uring_cqe& cqe) {
+    uint64_t op = cqe.user_data & URING_OP_MASK;
+    bool more = IoUring::HasMore(cqe);
+
+    if (op == URING_WAKE || op == URING_TIMER) {
+        // A multishot poll may end (e.g. on overflow); poll again
+        if (!more && !WatchUring(op == URING_WAKE ? wake_fd_ : timer_fd_, op)) {
+            LOG_ERROR("[Reactor " << index_ << "] Failed to re-arm " << (op == URING_WAKE ? "wakeup" : "timer"));
+        }
+        if (op == URING_WAKE) {
+            HandleWakeup();
+        } else {
+            HandleInactivityTimer();
+        }
+        return;
+    }
+
+    ClientInfo* client = ReleaseUringRequest(cqe);
+    if (!client) {
+        return;
+    }
+
+    bool keep = true;
+    switch (op) {
+        case URING_RECV:
+            keep = HandleUringRecv(*client, cqe);
+            if (keep && !more && !client->read_paused) {
+                keep = ArmUringRecv(*client); // Ended by a lack of buffers or a cancelled pause
+            }
+            break;
+        case URING_SEND:
+            keep = HandleUringSent(*client, cqe);
+            break;
+        case URING_DOORBELL:
+            keep = cqe.res >= 0 && HandleShmDoorbell(client->fd) && (more || WatchShmDoorbell(*client));
+            break;
+        default:
+            break;
+    }
+
+    if (!keep || client->closing) {
+        HandleClientClose(client->fd);
+    }
+}
+
+ClientInfo* Reactor::ReleaseUringRequest(const io_uring_cqe& cqe) {
+    auto* client = reinterpret_cast<ClientInfo*>(cqe.user_data & ~URING_OP_MASK);
+    if (!client) {
+        return nullptr;
+    }
+
+    if (!IoUring::HasMore(cqe)) {
+        // Last completion of this request
+        uint64_t op = cqe.user_data & URING_OP_MASK;
+        client->uring_ops--;
+        if (op == URING_RECV) {
+            client->recv_armed = false;
+        } else if (op == URING_DOORBELL) {
+            client->doorbell_armed = false;
+        }
+    }
+
+    if (client->fd >= 0) {
+        return client;
+    }
+
+    // Closed connection: hand back the buffer, free it with its last completion
+    if (cqe.flags & IORING_CQE_F_BUFFER) {
+        ring_->RecycleBuffer(IoUring::BufferId(cqe));
+    }
+    if (client->uring_ops == 0) {
+        retired_clients_.erase(std::find(retired_clients_.begin(), retired_clients_.end(), client));
+        clients_.Destroy(client);
+    }
+    return nullptr;
+}
+
+bool Reactor::HandleUringRecv(ClientInfo& client, const io_uring_cqe& cqe) {
+    if (cqe.res < 0) {
+        if (cqe.res == -ENOBUFS || cqe.res == -ECANCELED) {
+            return true; // Buffers ran out for a moment, or the pause took effect
+        }
+        LOG_ERROR("[Reactor " << index_ << "] recv failed: " << strerror(-cqe.res));
+        return false;
+    }
+
+    uint16_t buffer_id = IoUring::BufferId(cqe);
+    IoUring::RecvMsg msg;
+    if (!(cqe.flags & IORING_CQE_F_BUFFER) ||
+        !IoUring::ParseRecvMsg(ring_->Buffer(buffer_id), static_cast<size_t>(cqe.res), recv_msg_, msg)) {
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            ring_->RecycleBuffer(buffer_id);
+        }
+        LOG_ERROR("[Reactor " << index_ << "] Malformed recvmsg completion (fd=" << client.fd << ")");
+        return false;
+    }
+
+    // Descriptors passed with these bytes (shared memory, large payloads)
+    CollectPassedFds(msg.control, client.received_fds);
+
+    bool was_paused = client.read_paused;
+    bool keep = msg.payload_len > 0;
+    if (!keep) {
+        // Connection closed by client
+        LOG_INFO("[Reactor " << index_ << "] Client disconnected (fd=" << client.fd << ")");
+    } else {
+        client.last_activity_ms = now_ms_;
+        keep = ConsumeReceived(client, msg.payload, msg.payload_len);
+    }
+    ring_->RecycleBuffer(buffer_id);
+
+    if (!keep) {
+        return false;
+    }
+    if (client.read_paused) {
+        if (!was_paused) {
+            CancelUringRecv(client); // Backpressure: leave the rest in the socket
+        }
+        return true;
+    }
+
+    // Frames claim their descriptors; only a partial frame may still own some
+    if (client.received_fds.size() > MAX_PASSED_FDS) {
+        LOG_WARN("[Reactor " << index_ << "] Too many unclaimed descriptors (fd=" << client.fd << ")");
+        return false;
+    }
+    return true;
+}
+
+bool Reactor::ConsumeReceived(ClientInfo& client, const uint8_t* data, size_t len) {
+    RingBuffer& ring = client.parser.Buffer();
+
+    // Dispatching always frees the ring (it holds two maximum-size frames),
+    // so each pass makes progress until the connection pauses
+    while (len > 0 && !client.read_paused) {
+        size_t n = std::min(len, ring.FreeSpace());
+        ring.Write(data, n);
+        data += n;
+        len -= n;
+
+        if (!ProcessFrames(client)) {
+            return false;
+        }
+        client.read_paused = ShouldPauseReading(client);
+    }
+
+    // Paused: the rest waits for ResumeReading()
+    client.recv_backlog.insert(client.recv_backlog.end(), data, data + len);
+    return true;
+}
+
+bool Reactor::ArmUringRecv(ClientInfo& client) {
+    if (client.recv_armed) {
+        return true; // Still armed, or being cancelled (re-armed when that completes)
+    }
+
+    io_uring_sqe* sqe = NextSqe();
+    if (!sqe) {
+        client.closing = true;
+        return false;
+    }
+    IoUring::PrepRecvMsgMultishot(sqe, client.fd, &recv_msg_, URING_BUFFER_GROUP, MSG_CMSG_CLOEXEC,
+                                  UringTag(client, URING_RECV));
+    client.recv_armed = true;
+    client.uring_ops++;
+    return true;
+}
+
+void Reactor::CancelUringRecv(ClientInfo& client) {
+    if (!client.recv_armed || client.shm) {
+        return; // The socket of a shared-memory client only reports the disconnect; keep it armed
+    }
+    if (io_uring_sqe* sqe = NextSqe()) {
+        IoUring::PrepCancel(sqe, UringTag(client, URING_RECV), URING_IGNORE);
+    }
+}
+
+bool Reactor::WatchShmDoorbell(ClientInfo& client) {
+    if (!WatchUring(client.shm->RequestEventFd(), UringTag(client, URING_DOORBELL))) {
+        return false;
+    }
+    client.doorbell_armed = true;
+    client.uring_ops++;
+    return true;
+}
+
+void Reactor::QueueUringSend(ClientInfo& client) {
+    // With a SEND in flight its completion starts the next one
+    if (!client.send_queued && client.inflight_send.empty()) {
+        client.send_queued = true;
+        send_queue_.emplace_back(client.fd, client.connection_id);
+    }
+}
+
+void Reactor::FlushUringSends() {
+    for (const auto& [fd, connection_id] : send_queue_) {
+        ClientInfo* found = FindClient(fd, connection_id);
+        if (!found) {
+            continue;
+        }
+
+        ClientInfo& client = *found;
+        client.send_queued = false;
+        if (!StartUringSend(client)) {
+            HandleClientClose(fd);
+        }
+    }
+    send_queue_.clear();
+}
+
+bool Reactor::StartUringSend(ClientInfo& client) {
+    if (!client.inflight_send.empty() || client.send_buffer.empty() || client.shm) {
+        return true; // Busy, idle, or send_buffer is response-ring backlog
+    }
+
+    // Everything queued so far leaves as one SEND; the buffers swap roles
+    client.inflight_send.swap(client.send_buffer);
+    client.inflight_offset = 0;
+    return SubmitUringSend(client);
+}
+
+bool Reactor::SubmitUringSend(ClientInfo& client) {
+    io_uring_sqe* sqe = NextSqe();
+    if (!sqe) {
+        return false;
+    }
+    IoUring::PrepSend(sqe, client.fd, client.inflight_send.data() + client.inflight_offset,
+                      client.inflight_send.size() - client.inflight_offset, MSG_NOSIGNAL,
+                      UringTag(client, URING_SEND));
+    client.uring_ops++;
+    return true;
+}
+
+bool Reactor::HandleUringSent(ClientInfo& client, const io_uring_cqe& cqe) {
+    if (cqe.res <= 0) {
+        LOG_ERROR("[Reactor " << index_ << "] send failed: "
+                  << (cqe.res < 0 ? strerror(-cqe.res) : "connection closed"));
+        return false;
+    }
+
+    client.inflight_offset += static_cast<size_t>(cqe.res);
+    if (client.inflight_offset < client.inflight_send.size()) {
+        return SubmitUringSend(client); // Short send: the rest, still ahead of anything queued
+    }
+
+    client.inflight_send.clear();
+    client.inflight_offset = 0;
+    return StartUringSend(client); // Responses queued meanwhile
+}
+
+void Reactor::RetireUringClient(ClientInfo* client) {
+    // Requests still in flight point at the connection: end them, and keep
+    // it allocated until their last completions arrive
+    shutdown(client->fd, SHUT_RDWR); // Fails a pending SEND, ends the recvmsg
+    if (client->recv_armed) {
+        CancelUringRecv(*client);
+    }
+    if (client->doorbell_armed) {
+        if (io_uring_sqe* sqe = NextSqe()) {
+            IoUring::PrepCancel(sqe, UringTag(*client, URING_DOORBELL), URING_IGNORE);
+        }
+    }
+
+    close(client->fd); // The kernel holds its own reference until the requests end
+    client->fd = -1;
+    if (client->uring_ops > 0) {
+        retired_clients_.push_back(client);
+    } else {
+        clients_.Destroy(client);
+    }
+}
+
+void Reactor::DrainUring() {
+    // No request may outlive the buffers it uses: cancel everything and
+    // wait (bounded) for the completions. Connections close after the loop.
+    clients_.ForEach([](int fd, const ClientInfo&) { shutdown(fd, SHUT_RDWR); });
+    if (io_uring_sqe* sqe = NextSqe()) {
+        IoUring::PrepCancelAll(sqe, URING_IGNORE);
+    }
+
+    auto outstanding = [this]() {
+        size_t ops = retired_clients_.size();
+        clients_.ForEach([&ops](int, const ClientInfo& client) { ops += client.uring_ops; });
+        return ops;
+    };
+
+    for (int i = 0; i < 100 && outstanding() > 0; ++i) {
+        ring_->SubmitAndWait(1, 10);
+        ring_->ForEachCompletion([this](const io_uring_cqe& cqe) {
+            if (ReleaseUringRequest(cqe) && (cqe.flags & IORING_CQE_F_BUFFER)) {
+                ring_->RecycleBuffer(IoUring::BufferId(cqe));
+            }
+        });
+    }
+}
+
+} // namespace ipc_demo
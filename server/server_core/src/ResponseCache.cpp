@@ -0,0 +1,111 @@
+/**
+ * @file ResponseCache.cpp
+ * @brief Implementation of ResponseCache
+ */
+
+#include "ResponseCache.hpp"
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+
+namespace ipc_demo {
+
+ResponseCache::ResponseCache(const ResponseCacheOptions& options)
+    : options_(options)
+    , shard_capacity_((options.capacity + SHARDS - 1) / SHARDS) {
+}
+
+ResponseCache::Key ResponseCache::MakeKey(uint32_t routine_id, const uint8_t* request, size_t request_len) {
+    uint64_t hash = std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(request), request_len));
+    // Mix the routine in so equal payloads of different routines spread out
+    hash ^= (static_cast<uint64_t>(routine_id) + 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 31;
+    return Key{routine_id, request, request_len, hash};
+}
+
+bool ResponseCache::Matches(const Entry& entry, const Key& key) {
+    return entry.routine_id == key.routine_id && entry.request_len == key.request_len &&
+           std::memcmp(entry.bytes.data(), key.request, key.request_len) == 0;
+}
+
+size_t ResponseCache::Lookup(const Key& key, uint8_t* output, size_t output_len, uint64_t now_ms) {
+    Shard& shard = ShardFor(key.hash);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key.hash);
+        if (it != shard.index.end() && Matches(*it->second, key)) {
+            Entry& entry = *it->second;
+            size_t response_len = entry.bytes.size() - entry.request_len;
+            if (entry.expires_ms != 0 && now_ms >= entry.expires_ms) {
+                shard.lru.erase(it->second);
+                shard.index.erase(it);
+            } else if (response_len <= output_len) {
+                std::memcpy(output, entry.bytes.data() + entry.request_len, response_len);
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return response_len;
+            }
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+void ResponseCache::Insert(const Key& key, const uint8_t* response, size_t response_len,
+                           uint32_t ttl_ms, uint64_t now_ms) {
+    if (!Accepts(key.request_len) || response_len == 0 || response_len > options_.max_response_bytes) {
+        return;
+    }
+
+    Shard& shard = ShardFor(key.hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key.hash);
+    if (it != shard.index.end()) {
+        // Same key stored meanwhile by another thread, or a colliding one: replace
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    } else if (shard.lru.size() >= shard_capacity_) {
+        // Reuse the least recently used entry (and its buffer) for the new one
+        shard.lru.splice(shard.lru.begin(), shard.lru, std::prev(shard.lru.end()));
+        shard.index.erase(shard.lru.front().hash);
+        shard.index.emplace(key.hash, shard.lru.begin());
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        shard.lru.emplace_front();
+        shard.index.emplace(key.hash, shard.lru.begin());
+    }
+
+    Entry& entry = shard.lru.front();
+    entry.hash = key.hash;
+    entry.routine_id = key.routine_id;
+    entry.expires_ms = ttl_ms == 0 ? 0 : now_ms + ttl_ms;
+    entry.request_len = key.request_len;
+    entry.bytes.assign(key.request, key.request + key.request_len);
+    entry.bytes.insert(entry.bytes.end(), response, response + response_len);
+    insertions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ResponseCache::Clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.lru.clear();
+    }
+}
+
+ResponseCacheStats ResponseCache::GetStats() const {
+    ResponseCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.insertions = insertions_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.lru.size();
+    }
+    return stats;
+}
+
+} // namespace ipc_demo
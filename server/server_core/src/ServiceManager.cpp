@@ -4,89 +4,263 @@
  */
 
 #include "ServiceManager.hpp"
-#include <iostream>
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Tracer.hpp"
+#include "logging/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
 
 namespace ipc_demo {
 
+ServiceManager::ServiceManager(const ResponseCacheOptions& cache_options)
+    : cache_(cache_options) {
+    metrics_.RegisterRoutine(Protocol::BATCH_REQUEST_ROUTINE_ID, "Batch");
+    metrics_.RegisterRoutine(Protocol::STATS_REQUEST_ROUTINE_ID, stats_service_.GetName());
+    Publish(std::make_unique<RoutingTable>());
+}
+
+ServiceManager::~ServiceManager() {
+    delete table_.load(std::memory_order_relaxed);
+}
+
+std::atomic<uint64_t>& ServiceManager::ReaderCount() const {
+    // Threads keep their slot, spread by thread ID
+    thread_local size_t slot = std::hash<std::thread::id>{}(std::this_thread::get_id()) % READER_SLOTS;
+    return readers_[slot].active[epoch_.load(std::memory_order_relaxed) & 1];
+}
+
+ServiceManager::ReadGuard::ReadGuard(const ServiceManager& manager)
+    : active_(manager.ReaderCount()) {
+    // Counted in before loading the snapshot: a writer that publishes after
+    // this sees the count and waits for the guard
+    active_.fetch_add(1, std::memory_order_seq_cst);
+    table_ = manager.table_.load(std::memory_order_seq_cst);
+}
+
+ServiceManager::ReadGuard::~ReadGuard() {
+    active_.fetch_sub(1, std::memory_order_release);
+}
+
 bool ServiceManager::RegisterService(std::shared_ptr<IService> service) {
     if (!service) {
-        std::cerr << "[ServiceManager] Cannot register null service" << std::endl;
+        LOG_ERROR("[ServiceManager] Cannot register null service");
         return false;
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
     
     uint32_t routine_id = service->GetRequestRoutineId();
+
+    if (Protocol::IsReservedRoutine(routine_id)) {
+        LOG_ERROR("[ServiceManager] Routine ID 0x" << std::hex << routine_id << std::dec
+                  << " is reserved for built-in routines");
+        return false;
+    }
     
-    // Check if already registered
-    if (services_.find(routine_id) != services_.end()) {
-        std::cerr << "[ServiceManager] Service with routine ID 0x"
+    // Check if already registered (writers need no guard: only they free snapshots)
+    const RoutingTable& current = *table_.load(std::memory_order_relaxed);
+    if (FindRoute(current, routine_id) != nullptr) {
+        LOG_ERROR("[ServiceManager] Service with routine ID 0x"
                   << std::hex << routine_id << std::dec
-                  << " already registered" << std::endl;
+                  << " already registered");
         return false;
     }
 
-    services_[routine_id] = service;
+    // Copy the current snapshot and add the route in sorted position
+    auto table = std::make_unique<RoutingTable>(current);
+    auto pos = std::lower_bound(table->routes.begin(), table->routes.end(), routine_id,
+                                [](const Route& route, uint32_t id) { return route.routine_id < id; });
+    table->routes.insert(pos, Route{routine_id, service.get(),
+                                    ResponseBuilder::EncodeHeader(service->GetResponseRoutineId()),
+                                    service->IsIdempotent(), service->GetCacheTtlMs()});
+    table->services.push_back(service);
+    Publish(std::move(table));
+
+    if (!metrics_.RegisterRoutine(routine_id, service->GetName())) {
+        LOG_WARN("[ServiceManager] Metrics table full, " << service->GetName()
+                 << " is counted as \"other\"");
+    }
     
-    std::cout << "[ServiceManager] Registered service: " << service->GetName()
-              << " (Request ID: 0x" << std::hex << routine_id << std::dec << ")"
-              << std::endl;
+    LOG_INFO("[ServiceManager] Registered service: " << service->GetName()
+             << " (Request ID: 0x" << std::hex << routine_id << std::dec << ")");
     
     return true;
 }
 
 bool ServiceManager::IsRoutinePresent(uint32_t routine_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return services_.find(routine_id) != services_.end();
+    ReadGuard guard(*this);
+    return FindRoute(guard.Table(), routine_id) != nullptr;
+}
+
+bool ServiceManager::IsInlineSafe(uint32_t routine_id) const {
+    if (routine_id == Protocol::BATCH_REQUEST_ROUTINE_ID ||
+        routine_id == Protocol::STATS_REQUEST_ROUTINE_ID) {
+        return false;
+    }
+
+    ReadGuard guard(*this);
+    const Route* route = FindRoute(guard.Table(), routine_id);
+    return route == nullptr || route->service->IsInlineSafe();
 }
 
 size_t ServiceManager::ExecuteService(uint32_t routine_id,
                                      const uint8_t* input, size_t input_len,
                                      uint8_t* output, size_t output_len) {
-    std::shared_ptr<IService> service;
-    
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = services_.find(routine_id);
-        if (it == services_.end()) {
-            std::cerr << "[ServiceManager] No service found for routine ID 0x"
-                      << std::hex << routine_id << std::dec << std::endl;
-            return 0;
+    uint64_t start_ns = Metrics::NowNs();
+    size_t written = Dispatch(routine_id, input, input_len, output, output_len);
+    metrics_.RecordRequest(routine_id, input_len, written, written == 0, Metrics::NowNs() - start_ns);
+    return written;
+}
+
+size_t ServiceManager::Dispatch(uint32_t routine_id,
+                               const uint8_t* input, size_t input_len,
+                               uint8_t* output, size_t output_len) {
+    if (routine_id == Protocol::BATCH_REQUEST_ROUTINE_ID) {
+        return ExecuteBatch(input, input_len, output, output_len);
+    }
+    if (routine_id == Protocol::STATS_REQUEST_ROUTINE_ID) {
+        ResponseBuilder response(stats_header_, output, output_len);
+        return stats_service_.Respond(input, input_len, response);
+    }
+
+    // The guarded snapshot keeps the service alive; no lock or refcount needed
+    ReadGuard guard(*this);
+    const Route* route = FindRoute(guard.Table(), routine_id);
+    if (route == nullptr) {
+        LOG_WARN("[ServiceManager] No service found for routine ID 0x"
+                 << std::hex << routine_id << std::dec);
+        return 0;
+    }
+    IService* service = route->service;
+    trace::MarkActive(trace::ServerStage::Lookup);
+
+    try {
+        if (route->cacheable && cache_.Accepts(input_len)) {
+            return ExecuteCached(*route, input, input_len, output, output_len);
         }
-        service = it->second;
+        ResponseBuilder response(route->response_header, output, output_len);
+        return service->Respond(input, input_len, response);
+    } catch (const std::exception& e) {
+        LOG_ERROR("[ServiceManager] Exception in service " << service->GetName()
+                  << ": " << e.what());
+        return 0;
     }
+}
+
+size_t ServiceManager::ExecuteCached(const Route& route, const uint8_t* input, size_t input_len,
+                                     uint8_t* output, size_t output_len) {
+    ResponseCache::Key key = ResponseCache::MakeKey(route.routine_id, input, input_len);
+    uint64_t now_ms = Metrics::NowNs() / 1000000;
+
+    size_t written = cache_.Lookup(key, output, output_len, now_ms);
+    if (written > 0) {
+        metrics_.RecordCacheHit(route.routine_id);
+        return written;
+    }
+
+    ResponseBuilder response(route.response_header, output, output_len);
+    written = route.service->Respond(input, input_len, response);
+    if (written > 0) {
+        cache_.Insert(key, output, written, route.cache_ttl_ms, now_ms);
+    }
+    return written;
+}
 
-    // Execute outside of lock to allow concurrent service execution
+size_t ServiceManager::ExecuteBatch(const uint8_t* input, size_t input_len,
+                                   uint8_t* output, size_t output_len) {
     try {
-        return service->Execute(input, input_len, output, output_len);
+        ByteBuffer request(const_cast<uint8_t*>(input), input_len);
+        uint32_t count = request.GetInt();
+        if (count > Protocol::MAX_BATCH_CALLS) {
+            LOG_WARN("[ServiceManager] Batch too large: " << count << " calls");
+            return 0;
+        }
+
+        ResponseBuilder frame(batch_header_, output, output_len);
+        uint8_t* payload = frame.Payload();
+        size_t payload_capacity = frame.PayloadCapacity();
+        ByteBuffer response(payload, payload_capacity);
+        response.PutInt(count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t routine_id = request.GetInt();
+            uint32_t len = request.GetInt();
+            if (len > input_len - request.Position()) {
+                LOG_WARN("[ServiceManager] Batch entry " << i << " exceeds frame");
+                return 0;
+            }
+            const uint8_t* sub_payload = input + request.Position();
+            request.SetPosition(request.Position() + len);
+
+            // Run the sub-request straight into the response, after its length
+            size_t len_pos = response.Position();
+            response.PutInt(0);
+            size_t space = payload_capacity - response.Position();
+            size_t written = 0;
+            if (space > 0 && routine_id != Protocol::BATCH_REQUEST_ROUTINE_ID) {
+                written = ExecuteService(routine_id, sub_payload, len,
+                                         payload + response.Position(), space);
+            }
+
+            response.SetPosition(len_pos);
+            response.PutInt(static_cast<uint32_t>(written));
+            response.SetPosition(len_pos + 4 + written);
+        }
+
+        return frame.Finish(response.Position());
+
     } catch (const std::exception& e) {
-        std::cerr << "[ServiceManager] Exception in service " << service->GetName()
-                  << ": " << e.what() << std::endl;
+        LOG_WARN("[ServiceManager] Malformed batch: " << e.what());
         return 0;
     }
 }
 
 std::vector<std::shared_ptr<IService>> ServiceManager::GetAllServices() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<std::shared_ptr<IService>> result;
-    result.reserve(services_.size());
-    
-    for (const auto& [id, service] : services_) {
-        result.push_back(service);
-    }
-    
-    return result;
+    ReadGuard guard(*this);
+    return guard.Table().services;
 }
 
 size_t ServiceManager::GetServiceCount() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return services_.size();
+    ReadGuard guard(*this);
+    return guard.Table().routes.size();
 }
 
 void ServiceManager::Clear() {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::cout << "[ServiceManager] Clearing " << services_.size() << " services" << std::endl;
-    services_.clear();
+    LOG_INFO("[ServiceManager] Clearing " << GetServiceCount() << " services");
+    Publish(std::make_unique<RoutingTable>());
+    cache_.Clear(); // Routine IDs may be registered again by other services
+}
+
+const ServiceManager::Route* ServiceManager::FindRoute(const RoutingTable& table, uint32_t routine_id) {
+    auto it = std::lower_bound(table.routes.begin(), table.routes.end(), routine_id,
+                               [](const Route& route, uint32_t id) { return route.routine_id < id; });
+    if (it == table.routes.end() || it->routine_id != routine_id) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+void ServiceManager::Publish(std::unique_ptr<RoutingTable> table) {
+    std::unique_ptr<const RoutingTable> previous(table_.exchange(table.release(), std::memory_order_seq_cst));
+    if (previous) {
+        // Readers may still hold the previous snapshot: free it after them
+        Synchronize();
+    }
+}
+
+void ServiceManager::Synchronize() {
+    for (int flip = 0; flip < 2; ++flip) {
+        uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        for (ReaderSlot& slot : readers_) {
+            while (slot.active[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
 }
 
 } // namespace ipc_demo
@@ -0,0 +1,129 @@
+/**
+ * @file StatsService.cpp
+ * @brief Implementation of StatsService
+ */
+
+#include "StatsService.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "logging/Logger.hpp"
+#include <stdexcept>
+
+namespace ipc_demo {
+
+static_assert(Metrics::OTHER_ROUTINE_ID == Protocol::STATS_OTHER_ROUTINE_ID,
+              "The stats routine reports unregistered routines under STATS_OTHER_ROUTINE_ID");
+
+namespace {
+
+constexpr size_t HISTOGRAM_RECORD_SIZE = 7 * 8;
+constexpr size_t ROUTINE_RECORD_SIZE = 4 + 4 + 5 * 8 + 2 * HISTOGRAM_RECORD_SIZE;   // Without the name bytes
+constexpr const char TRUNCATED_MARKER[] = "# truncated\n";
+
+void PutHistogram(ByteBuffer& response, const HistogramSnapshot& histogram) {
+    const int64_t record[] = {
+        static_cast<int64_t>(histogram.count),
+        static_cast<int64_t>(histogram.sum_ns),
+        static_cast<int64_t>(histogram.max_ns),
+        static_cast<int64_t>(histogram.Percentile(0.5)),
+        static_cast<int64_t>(histogram.Percentile(0.9)),
+        static_cast<int64_t>(histogram.Percentile(0.99)),
+        static_cast<int64_t>(histogram.Percentile(0.999)),
+    };
+    static_assert(sizeof(record) == HISTOGRAM_RECORD_SIZE, "Histogram record layout");
+    response.PutLongs(record, sizeof(record) / sizeof(record[0]));
+}
+
+} // namespace
+
+StatsService::StatsService(const Metrics& metrics)
+    : metrics_(metrics) {
+}
+
+uint32_t StatsService::GetRequestRoutineId() const {
+    return Protocol::STATS_REQUEST_ROUTINE_ID;
+}
+
+uint32_t StatsService::GetResponseRoutineId() const {
+    return Protocol::STATS_RESPONSE_ROUTINE_ID;
+}
+
+size_t StatsService::Execute(const uint8_t* input, size_t input_len,
+                             uint8_t* output, size_t output_len) {
+    ResponseBuilder response(GetResponseRoutineId(), output, output_len);
+    return Respond(input, input_len, response);
+}
+
+size_t StatsService::Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) {
+    uint8_t format = input_len > 0 ? input[0] : Protocol::STATS_FORMAT_BINARY;
+    if (format != Protocol::STATS_FORMAT_BINARY && format != Protocol::STATS_FORMAT_PROMETHEUS) {
+        LOG_WARN("[StatsService] Unknown format: " << static_cast<int>(format));
+        return 0;
+    }
+
+    try {
+        MetricsSnapshot snapshot = metrics_.Snapshot();
+
+        ByteBuffer payload(response.Payload(), response.PayloadCapacity());
+        size_t limit = response.PayloadCapacity();
+        if (format == Protocol::STATS_FORMAT_BINARY) {
+            PutBinary(payload, snapshot, limit);
+        } else {
+            PutPrometheus(payload, snapshot, limit);
+        }
+        return response.Finish(payload.Position());
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("[StatsService] Exception: " << e.what());
+        return 0;
+    }
+}
+
+void StatsService::PutBinary(ByteBuffer& response, const MetricsSnapshot& snapshot, size_t limit) const {
+    response.PutLong(static_cast<int64_t>(snapshot.connections_opened));
+    response.PutLong(static_cast<int64_t>(snapshot.connections_closed));
+    size_t count_pos = response.Position();
+    response.PutInt(0); // Placeholder for count
+
+    uint32_t count = 0;
+    for (const auto& routine : snapshot.routines) {
+        if (response.Position() + ROUTINE_RECORD_SIZE + routine.name.size() > limit) {
+            break;
+        }
+        response.PutInt(routine.routine_id);
+        response.PutString(routine.name);
+        response.PutLong(static_cast<int64_t>(routine.requests));
+        response.PutLong(static_cast<int64_t>(routine.errors));
+        response.PutLong(static_cast<int64_t>(routine.rejected));
+        response.PutLong(static_cast<int64_t>(routine.bytes_in));
+        response.PutLong(static_cast<int64_t>(routine.bytes_out));
+        PutHistogram(response, routine.queue_wait);
+        PutHistogram(response, routine.execution);
+        count++;
+    }
+
+    size_t end = response.Position();
+    response.SetPosition(count_pos);
+    response.PutInt(count);
+    response.SetPosition(end);
+}
+
+void StatsService::PutPrometheus(ByteBuffer& response, const MetricsSnapshot& snapshot, size_t limit) const {
+    std::string text = Metrics::FormatPrometheus(snapshot);
+
+    size_t start = response.Position() + 4; // After the string length
+    if (start + sizeof(TRUNCATED_MARKER) > limit) {
+        throw std::overflow_error("No room for statistics");
+    }
+    size_t space = limit - start;
+    if (text.size() > space) {
+        // Keep whole lines only, then say so
+        size_t keep = space - (sizeof(TRUNCATED_MARKER) - 1);
+        size_t last_newline = text.rfind('\n', keep - 1);
+        text.resize(last_newline == std::string::npos ? 0 : last_newline + 1);
+        text += TRUNCATED_MARKER;
+    }
+    response.PutString(text);
+}
+
+} // namespace ipc_demo
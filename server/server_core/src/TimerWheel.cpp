@@ -0,0 +1,128 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Implementation of TimerWheel
+ */
+
+#include "TimerWheel.hpp"
+#include <ctime>
+#include <stdexcept>
+
+namespace ipc_demo {
+
+TimerWheel::TimerWheel(uint64_t now_ms, uint32_t tick_ms)
+    : tick_ms_(tick_ms) {
+
+    if (tick_ms == 0) {
+        throw std::invalid_argument("TimerWheel: tick_ms must be > 0");
+    }
+
+    current_tick_ = now_ms / tick_ms_;
+    for (auto& level : slots_) {
+        for (auto& slot : level) {
+            slot.prev = slot.next = &slot;
+        }
+    }
+}
+
+TimerWheel::~TimerWheel() {
+    for (auto& level : slots_) {
+        for (auto& slot : level) {
+            while (slot.next != &slot) {
+                slot.next->Unlink();
+            }
+            slot.prev = slot.next = nullptr;
+        }
+    }
+}
+
+uint64_t TimerWheel::CoarseNowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+}
+
+void TimerWheel::Schedule(TimerNode& node, uint64_t deadline_ms) {
+    if (node.IsScheduled()) {
+        node.Unlink();
+    } else {
+        ++size_;
+    }
+
+    // Round up: a timer must not fire before its deadline
+    uint64_t expiry = deadline_ms / tick_ms_ + (deadline_ms % tick_ms_ != 0 ? 1 : 0);
+    node.expiry = expiry > current_tick_ ? expiry : current_tick_ + 1;
+    Insert(node);
+}
+
+void TimerWheel::Cancel(TimerNode& node) {
+    if (node.IsScheduled()) {
+        node.Unlink();
+        --size_;
+    }
+}
+
+void TimerWheel::Append(TimerNode& list, TimerNode& node) {
+    node.prev = list.prev;
+    node.next = &list;
+    list.prev->next = &node;
+    list.prev = &node;
+}
+
+void TimerWheel::Insert(TimerNode& node) {
+    uint64_t delta = node.expiry - current_tick_;
+    uint64_t expiry = node.expiry;
+    if (delta >= MAX_TICKS) {
+        // Park at the far end of the top level; re-filed when it comes up
+        expiry = current_tick_ + MAX_TICKS - 1;
+        delta = MAX_TICKS - 1;
+    }
+
+    size_t level = 0;
+    while (delta >= (uint64_t(1) << ((level + 1) * SLOT_BITS))) {
+        ++level;
+    }
+    size_t slot = static_cast<size_t>(expiry >> (level * SLOT_BITS)) & (SLOTS - 1);
+    Append(slots_[level][slot], node);
+}
+
+void TimerWheel::Cascade(size_t level, size_t slot) {
+    TimerNode& list = slots_[level][slot];
+    while (list.next != &list) {
+        TimerNode& node = *list.next;
+        node.Unlink();
+        Insert(node);
+    }
+}
+
+void TimerWheel::CollectExpired(uint64_t now_ms, TimerNode& expired) {
+    uint64_t target = now_ms / tick_ms_;
+    if (size_ == 0 && target > current_tick_) {
+        current_tick_ = target; // Nothing scheduled: skip the empty ticks
+        return;
+    }
+
+    while (current_tick_ < target) {
+        ++current_tick_;
+
+        // Entering a new slot of a coarser level: bring its timers down
+        for (size_t level = 1; level < LEVELS; ++level) {
+            if (current_tick_ & ((uint64_t(1) << (level * SLOT_BITS)) - 1)) {
+                break;
+            }
+            Cascade(level, static_cast<size_t>(current_tick_ >> (level * SLOT_BITS)) & (SLOTS - 1));
+        }
+
+        TimerNode& list = slots_[0][current_tick_ & (SLOTS - 1)];
+        while (list.next != &list) {
+            TimerNode& node = *list.next;
+            node.Unlink();
+            if (node.expiry > current_tick_) {
+                Insert(node);  // Parked timer, not due yet
+            } else {
+                Append(expired, node);
+            }
+        }
+    }
+}
+
+} // namespace ipc_demo
@@ -4,26 +4,88 @@
  */
 
 #include "UDSServer.hpp"
-#include "ipc_sync/ByteBuffer.hpp"
+#include "logging/Logger.hpp"
+#include "thread_pool/ThreadPool.hpp"
+#include "thread_pool/WorkStealingThreadPool.hpp"
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
-#include <sys/timerfd.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstring>
-#include <iostream>
 #include <algorithm>
+#include <chrono>
 
 namespace ipc_demo {
 
+namespace {
+
+// io_uring acceptor: user_data of each armed request
+constexpr uint64_t ACCEPT_TAG = 0;
+constexpr uint64_t CONTROL_TAG = 1;   // Poll on the hot-restart control socket
+constexpr uint64_t PEER_TAG = 2;      // Poll on the connection to the predecessor
+constexpr uint64_t REMOVE_TAG = 3;    // Poll removals
+constexpr uint64_t CANDIDATE_TAG = 4; // Poll on a would-be successor
+
+// While draining, the acceptor hands idle connections over this often
+constexpr int DRAIN_POLL_MS = 10;
+
+bool FillAddress(const std::string& path, struct sockaddr_un& addr) {
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return true;
+}
+
+} // namespace
+
 UDSServer::UDSServer(const std::string& socket_path,
                      std::shared_ptr<ServiceManager> service_manager)
+    : UDSServer(socket_path, service_manager, ServerConfig{}) {
+}
+
+UDSServer::UDSServer(const std::string& socket_path,
+                     std::shared_ptr<ServiceManager> service_manager,
+                     const ServerConfig& config)
     : socket_path_(socket_path)
-    , service_manager_(service_manager) {
+    , service_manager_(service_manager)
+    , config_(config) {
     
     if (!service_manager_) {
         throw std::invalid_argument("UDSServer: service_manager cannot be null");
     }
+    if (config_.num_reactors == 0) {
+        throw std::invalid_argument("UDSServer: num_reactors must be at least 1");
+    }
+    if (config_.io_backend == IoBackend::IoUring && !IoUring::IsSupported()) {
+        LOG_WARN("[UDSServer] io_uring unsupported by this kernel, using epoll");
+        config_.io_backend = IoBackend::Epoll;
+    }
+
+    // Reactors are created up front (without threads or descriptors) so the
+    // set never changes while the server runs
+    ReactorOptions reactor_options;
+    reactor_options.shared_memory = config_.enable_shared_memory;
+    reactor_options.compression = config_.enable_compression;
+    reactor_options.compression_threshold = config_.compression_threshold;
+    reactor_options.compression_dictionary = config_.compression_dictionary;
+    reactor_options.max_pending_per_connection = config_.max_pending_per_connection;
+    reactor_options.overload_policy = config_.overload_policy;
+    reactor_options.inactivity_timeout_ms = config_.inactivity_timeout_ms;
+    reactor_options.max_inactivity_timeout_ms = config_.max_inactivity_timeout_ms;
+    reactor_options.io_backend = config_.io_backend;
+    reactor_options.busy_poll_us = config_.busy_poll_us;
+    reactor_options.trace_sample_rate = config_.trace_sample_rate;
+
+    reactors_.reserve(config_.num_reactors);
+    for (size_t i = 0; i < config_.num_reactors; ++i) {
+        reactor_options.cpu = config_.reactor_placement.CpuFor(i);
+        reactors_.push_back(std::make_unique<Reactor>(i, service_manager_, reactor_options));
+    }
 }
 
 UDSServer::~UDSServer() {
@@ -32,34 +94,49 @@ UDSServer::~UDSServer() {
 
 bool UDSServer::Start() {
     if (running_.load()) {
-        std::cerr << "[UDSServer] Already running" << std::endl;
+        LOG_ERROR("[UDSServer] Already running");
         return false;
     }
 
+    if (server_thread_.joinable()) {
+        server_thread_.join(); // Exited on its own after a hand-off
+    }
+    handed_off_.store(false);
+
     running_.store(true);
     server_thread_ = std::thread(&UDSServer::ServerThreadFunc, this);
     
-    std::cout << "[UDSServer] Started on: " << socket_path_ << std::endl;
+    LOG_INFO("[UDSServer] Started on: " << socket_path_);
     return true;
 }
 
 void UDSServer::Stop() {
-    if (!running_.load()) {
+    if (!running_.exchange(false) && !server_thread_.joinable()) {
         return;
     }
 
-    std::cout << "[UDSServer] Stopping..." << std::endl;
-    running_.store(false);
+    LOG_INFO("[UDSServer] Stopping...");
 
     if (server_thread_.joinable()) {
         server_thread_.join();
     }
 
-    std::cout << "[UDSServer] Stopped" << std::endl;
+    LOG_INFO("[UDSServer] Stopped");
 }
 
 size_t UDSServer::GetClientCount() const {
-    return clients_.size();
+    size_t total = 0;
+    for (const auto& reactor : reactors_) {
+        total += reactor->GetClientCount();
+    }
+    return total;
+}
+
+size_t UDSServer::GetReactorClientCount(size_t index) const {
+    if (index >= reactors_.size()) {
+        throw std::out_of_range("UDSServer: reactor index out of range");
+    }
+    return reactors_[index]->GetClientCount();
 }
 
 void UDSServer::ServerThreadFunc() {
@@ -76,6 +153,9 @@ void UDSServer::ServerThreadFunc() {
             case ServerState::WaitAndHandleEvents:
                 state = HandleWaitAndHandleEvents();
                 break;
+            case ServerState::Drain:
+                state = HandleDrain();
+                break;
             case ServerState::Cleanup:
                 state = HandleCleanup();
                 break;
@@ -86,22 +166,31 @@ void UDSServer::ServerThreadFunc() {
     }
 
     HandleCleanup();
+
+    if (handed_off_.load()) {
+        running_.store(false); // The successor serves from here on
+    }
 }
 
 UDSServer::ServerState UDSServer::HandleCreateSocket() {
+    // Hot restart: keep serving on the running server's socket
+    if (!config_.handoff_path.empty() && TakeOverListener()) {
+        return ServerState::ListenSocket;
+    }
+
     // Remove existing socket file
     RemoveSocketFile();
 
     // Create socket
     server_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
     if (server_fd_ < 0) {
-        std::cerr << "[UDSServer] Failed to create socket: " << strerror(errno) << std::endl;
+        LOG_ERROR("[UDSServer] Failed to create socket: " << strerror(errno));
         return ServerState::Exit;
     }
 
     // Set non-blocking
     if (!SetNonBlocking(server_fd_)) {
-        std::cerr << "[UDSServer] Failed to set non-blocking" << std::endl;
+        LOG_ERROR("[UDSServer] Failed to set non-blocking");
         close(server_fd_);
         server_fd_ = -1;
         return ServerState::Exit;
@@ -114,26 +203,35 @@ UDSServer::ServerState UDSServer::HandleCreateSocket() {
     strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
 
     if (bind(server_fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        std::cerr << "[UDSServer] Bind failed: " << strerror(errno) << std::endl;
+        LOG_ERROR("[UDSServer] Bind failed: " << strerror(errno));
         close(server_fd_);
         server_fd_ = -1;
         return ServerState::Exit;
     }
 
-    std::cout << "[UDSServer] Socket created and bound" << std::endl;
+    LOG_INFO("[UDSServer] Socket created and bound");
     return ServerState::ListenSocket;
 }
 
 UDSServer::ServerState UDSServer::HandleListenSocket() {
     if (listen(server_fd_, 10) < 0) {
-        std::cerr << "[UDSServer] Listen failed: " << strerror(errno) << std::endl;
+        LOG_ERROR("[UDSServer] Listen failed: " << strerror(errno));
         return ServerState::Cleanup;
     }
 
+    if (config_.io_backend == IoBackend::IoUring) {
+        std::string error;
+        accept_ring_ = IoUring::Create(64, error);
+        if (!accept_ring_ || !ArmMultishotAccept()) {
+            LOG_WARN("[UDSServer] io_uring accept unavailable, using epoll: " << error);
+            accept_ring_.reset();
+        }
+    }
+
     // Create epoll instance
-    epoll_fd_ = epoll_create1(0);
-    if (epoll_fd_ < 0) {
-        std::cerr << "[UDSServer] epoll_create1 failed: " << strerror(errno) << std::endl;
+    epoll_fd_ = accept_ring_ ? -1 : epoll_create1(0);
+    if (!accept_ring_ && epoll_fd_ < 0) {
+        LOG_ERROR("[UDSServer] epoll_create1 failed: " << strerror(errno));
         return ServerState::Cleanup;
     }
 
@@ -141,22 +239,103 @@ UDSServer::ServerState UDSServer::HandleListenSocket() {
     struct epoll_event ev;
     ev.events = EPOLLIN;
     ev.data.fd = server_fd_;
-    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_fd_, &ev) < 0) {
-        std::cerr << "[UDSServer] epoll_ctl failed for server_fd: " << strerror(errno) << std::endl;
+    if (!accept_ring_ && epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_fd_, &ev) < 0) {
+        LOG_ERROR("[UDSServer] epoll_ctl failed for server_fd: " << strerror(errno));
         return ServerState::Cleanup;
     }
 
-    // Create inactivity timer
-    if (!CreateInactivityTimer()) {
-        std::cerr << "[UDSServer] Failed to create inactivity timer" << std::endl;
+    // Start reactors that will serve the accepted clients
+    if (!StartReactors()) {
+        LOG_ERROR("[UDSServer] Failed to start reactors");
         return ServerState::Cleanup;
     }
 
-    std::cout << "[UDSServer] Listening for connections" << std::endl;
+    // Hot restart: connections arrive from the predecessor first; the
+    // control socket opens once it is done
+    if (peer_fd_ >= 0 && !WatchFd(peer_fd_, PEER_TAG)) {
+        LOG_ERROR("[UDSServer] Cannot watch the predecessor: " << strerror(errno));
+        ClosePeer();
+    }
+    if (peer_fd_ < 0 && !config_.handoff_path.empty()) {
+        CreateControlSocket(); // Serve without hot restart on failure
+    }
+
+    LOG_INFO("[UDSServer] Listening for connections ("
+             << reactors_.size() << " reactor(s))");
     return ServerState::WaitAndHandleEvents;
 }
 
 UDSServer::ServerState UDSServer::HandleWaitAndHandleEvents() {
+    if (accept_ring_) {
+        int ret = accept_ring_->SubmitAndWait(1, 1000); // 1 second timeout
+        if (ret < 0) {
+            LOG_ERROR("[UDSServer] io_uring_enter failed: " << strerror(-ret));
+            return ServerState::Cleanup;
+        }
+
+        // Each accept completion is one accepted connection
+        bool rearm = false;
+        bool rearm_control = false;
+        bool rearm_peer = false;
+        bool rearm_candidate = false;
+        bool control_ready = false;
+        bool peer_ready = false;
+        bool candidate_ready = false;
+        accept_ring_->ForEachCompletion([&](const io_uring_cqe& cqe) {
+            if (cqe.user_data == CONTROL_TAG || cqe.user_data == PEER_TAG) {
+                bool control = cqe.user_data == CONTROL_TAG;
+                (control ? control_ready : peer_ready) = cqe.res > 0;
+                (control ? rearm_control : rearm_peer) = !IoUring::HasMore(cqe);
+                return;
+            }
+            if (cqe.user_data == CANDIDATE_TAG) {
+                candidate_ready = cqe.res > 0;
+                rearm_candidate = !IoUring::HasMore(cqe);
+                return;
+            }
+            if (cqe.user_data != ACCEPT_TAG) {
+                return; // Poll removal
+            }
+            if (cqe.res >= 0) {
+                if (!HandOverClient(cqe.res)) {
+                    LOG_ERROR("[UDSServer] Failed to accept new connection");
+                }
+            } else if (cqe.res != -EAGAIN && cqe.res != -ECANCELED) {
+                LOG_ERROR("[UDSServer] Accept failed: " << strerror(-cqe.res));
+            }
+            rearm = rearm || !IoUring::HasMore(cqe);
+        });
+
+        if (rearm && !ArmMultishotAccept()) {
+            LOG_ERROR("[UDSServer] Failed to re-arm accept");
+            return ServerState::Cleanup;
+        }
+        // Multishot polls end on removal (descriptor closed) or overflow
+        if (rearm_peer && peer_fd_ >= 0) {
+            WatchFd(peer_fd_, PEER_TAG);
+        }
+        if (rearm_control && control_fd_ >= 0) {
+            WatchFd(control_fd_, CONTROL_TAG);
+        }
+        if (rearm_candidate && candidate_fd_ >= 0) {
+            WatchFd(candidate_fd_, CANDIDATE_TAG);
+        }
+        if (peer_ready && peer_fd_ >= 0) {
+            HandlePredecessorMessages();
+        }
+        if (control_ready && control_fd_ >= 0) {
+            AcceptSuccessor();
+        }
+        if (candidate_ready && candidate_fd_ >= 0) {
+            ServerState next = HandleSuccessor();
+            if (next != ServerState::WaitAndHandleEvents) {
+                return next;
+            }
+        }
+        ExpireSuccessorCandidate();
+        return ServerState::WaitAndHandleEvents;
+    }
+
     constexpr int MAX_EVENTS = 64;
     struct epoll_event events[MAX_EVENTS];
 
@@ -166,57 +345,83 @@ UDSServer::ServerState UDSServer::HandleWaitAndHandleEvents() {
         if (errno == EINTR) {
             return ServerState::WaitAndHandleEvents; // Interrupted, continue
         }
-        std::cerr << "[UDSServer] epoll_wait failed: " << strerror(errno) << std::endl;
+        LOG_ERROR("[UDSServer] epoll_wait failed: " << strerror(errno));
         return ServerState::Cleanup;
     }
 
     for (int i = 0; i < nfds; ++i) {
         int fd = events[i].data.fd;
-
         if (fd == server_fd_) {
             // New connection
             if (!HandleNewConnection()) {
-                std::cerr << "[UDSServer] Failed to accept new connection" << std::endl;
+                LOG_ERROR("[UDSServer] Failed to accept new connection");
             }
-        } else if (fd == timer_fd_) {
-            // Inactivity timer fired
-            HandleInactivityTimer();
-        } else {
-            // Client data or error
-            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
-                HandleClientClose(fd);
-            } else if (events[i].events & EPOLLIN) {
-                if (!HandleClientData(fd)) {
-                    HandleClientClose(fd);
-                }
+        } else if (fd == peer_fd_) {
+            HandlePredecessorMessages();
+        } else if (fd == control_fd_) {
+            AcceptSuccessor();
+        } else if (fd == candidate_fd_) {
+            ServerState next = HandleSuccessor();
+            if (next != ServerState::WaitAndHandleEvents) {
+                return next;
             }
         }
     }
 
+    ExpireSuccessorCandidate();
     return ServerState::WaitAndHandleEvents;
 }
 
-UDSServer::ServerState UDSServer::HandleCleanup() {
-    std::cout << "[UDSServer] Cleaning up..." << std::endl;
+UDSServer::ServerState UDSServer::HandleDrain() {
+    TransferClients();
+
+    size_t remaining = GetClientCount();
+    bool expired = TimerWheel::CoarseNowMs() >= drain_deadline_ms_;
+    if (remaining > 0 && !expired && peer_fd_ >= 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_POLL_MS));
+        return ServerState::Drain;
+    }
+
+    if (remaining > 0) {
+        LOG_WARN("[UDSServer] Closing " << remaining << " client(s) still busy after the drain");
+    }
+    if (peer_fd_ >= 0) {
+        hot_restart::SendDone(peer_fd_);
+        ClosePeer();
+    }
+    LOG_INFO("[UDSServer] Hand-off complete");
+    return ServerState::Cleanup;
+}
 
-    CloseAllClients();
+UDSServer::ServerState UDSServer::HandleCleanup() {
+    LOG_INFO("[UDSServer] Cleaning up...");
 
-    if (timer_fd_ >= 0) {
-        close(timer_fd_);
-        timer_fd_ = -1;
+    ClosePeer();
+    DropSuccessorCandidate();
+    if (control_fd_ >= 0) {
+        close(control_fd_);
+        control_fd_ = -1;
+        unlink(config_.handoff_path.c_str());
     }
 
+    StopReactors();
+
     if (epoll_fd_ >= 0) {
         close(epoll_fd_);
         epoll_fd_ = -1;
     }
 
+    accept_ring_.reset(); // Cancels the multishot accept
+
     if (server_fd_ >= 0) {
         close(server_fd_);
         server_fd_ = -1;
     }
 
-    RemoveSocketFile();
+    // After a hand-off the socket file is the successor's
+    if (!handed_off_.load()) {
+        RemoveSocketFile();
+    }
 
     return ServerState::Exit;
 }
@@ -225,205 +430,337 @@ bool UDSServer::HandleNewConnection() {
     int client_fd = accept(server_fd_, nullptr, nullptr);
     if (client_fd < 0) {
         if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            std::cerr << "[UDSServer] Accept failed: " << strerror(errno) << std::endl;
+            LOG_ERROR("[UDSServer] Accept failed: " << strerror(errno));
         }
         return false;
     }
 
     if (!SetNonBlocking(client_fd)) {
-        std::cerr << "[UDSServer] Failed to set client non-blocking" << std::endl;
+        LOG_ERROR("[UDSServer] Failed to set client non-blocking");
         close(client_fd);
         return false;
     }
 
-    // Add to epoll
-    struct epoll_event ev;
-    ev.events = EPOLLIN | EPOLLET; // Edge-triggered
-    ev.data.fd = client_fd;
-    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
-        std::cerr << "[UDSServer] epoll_ctl failed for client: " << strerror(errno) << std::endl;
+    return HandOverClient(client_fd);
+}
+
+bool UDSServer::HandOverClient(int client_fd) {
+    // Hand the client over to a reactor
+    Reactor& reactor = SelectReactor();
+    if (!reactor.AddClient(client_fd)) {
+        LOG_ERROR("[UDSServer] Reactor " << reactor.GetIndex()
+                  << " rejected client");
         close(client_fd);
         return false;
     }
 
-    // Create client info
-    auto client = std::make_unique<ClientInfo>();
-    client->fd = client_fd;
-    client->last_activity = time(nullptr);
-    client->recv_buffer.reserve(Protocol::MAX_PACKET_SIZE);
-
-    clients_[client_fd] = std::move(client);
-
-    std::cout << "[UDSServer] New client connected (fd=" << client_fd 
-              << ", total=" << clients_.size() << ")" << std::endl;
+    LOG_INFO("[UDSServer] New client accepted (fd=" << client_fd
+             << ", reactor=" << reactor.GetIndex() << ")");
 
     return true;
 }
 
-bool UDSServer::HandleClientData(int client_fd) {
-    auto it = clients_.find(client_fd);
-    if (it == clients_.end()) {
+bool UDSServer::ArmMultishotAccept() {
+    io_uring_sqe* sqe = accept_ring_->GetSqe();
+    if (!sqe) {
         return false;
     }
+    // Accepted sockets come out non-blocking, like HandleNewConnection() leaves them
+    IoUring::PrepAcceptMultishot(sqe, server_fd_, SOCK_NONBLOCK | SOCK_CLOEXEC, ACCEPT_TAG);
+    return accept_ring_->Submit() >= 0;
+}
 
-    auto& client = it->second;
-    uint8_t buffer[Protocol::MAX_PACKET_SIZE];
+bool UDSServer::TakeOverListener() {
+    struct sockaddr_un addr;
+    if (!FillAddress(config_.handoff_path, addr)) {
+        LOG_WARN("[UDSServer] Hot-restart path too long: " << config_.handoff_path);
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd); // Nobody serving there: a cold start
+        return false;
+    }
 
-    // Read available data
-    ssize_t bytes_read = recv(client_fd, buffer, sizeof(buffer), 0);
-    
-    if (bytes_read < 0) {
-        if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            std::cerr << "[UDSServer] recv failed: " << strerror(errno) << std::endl;
-            return false;
+    uint32_t dictionary_id = config_.compression_dictionary ? config_.compression_dictionary->Id() : 0;
+    hot_restart::Message reply;
+    if (!hot_restart::SetIoTimeout(fd) || !hot_restart::SendTakeover(fd, dictionary_id) ||
+        peer_reader_.Read(fd, reply) != hot_restart::MessageReader::Status::Message ||
+        !hot_restart::ParseListener(reply) || !SetNonBlocking(reply.fds[0]) || !SetNonBlocking(fd)) {
+        LOG_WARN("[UDSServer] Hot restart failed on " << config_.handoff_path << ", starting cold");
+        for (int passed : reply.fds) {
+            close(passed);
         }
-        return true; // No data available
+        peer_reader_.Reset();
+        close(fd);
+        return false;
     }
 
-    if (bytes_read == 0) {
-        // Connection closed by client
-        std::cout << "[UDSServer] Client disconnected (fd=" << client_fd << ")" << std::endl;
+    server_fd_ = reply.fds[0];
+    peer_fd_ = fd;
+    LOG_INFO("[UDSServer] Took over the listening socket from the server on " << config_.handoff_path);
+    return true;
+}
+
+bool UDSServer::CreateControlSocket() {
+    struct sockaddr_un addr;
+    if (!FillAddress(config_.handoff_path, addr)) {
+        LOG_ERROR("[UDSServer] Hot-restart path too long: " << config_.handoff_path);
         return false;
     }
 
-    // Update activity timestamp
-    client->last_activity = time(nullptr);
+    unlink(config_.handoff_path.c_str()); // Left behind by a server that did not exit cleanly
+    control_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (control_fd_ < 0 ||
+        bind(control_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(control_fd_, 1) < 0 || !WatchFd(control_fd_, CONTROL_TAG)) {
+        LOG_ERROR("[UDSServer] Hot-restart control socket failed: " << strerror(errno));
+        if (control_fd_ >= 0) {
+            close(control_fd_);
+            control_fd_ = -1;
+        }
+        return false;
+    }
 
-    // Process the request
-    size_t response_len = ProcessClientRequest(client_fd, buffer, bytes_read);
-    (void)response_len; // Response sent directly to client in ProcessClientRequest
-    
-    return true; // Keep connection alive
+    LOG_INFO("[UDSServer] Hot restart enabled on " << config_.handoff_path);
+    return true;
 }
 
-void UDSServer::HandleClientClose(int client_fd) {
-    auto it = clients_.find(client_fd);
-    if (it == clients_.end()) {
-        return;
+bool UDSServer::WatchFd(int fd, uint64_t tag) {
+    if (accept_ring_) {
+        io_uring_sqe* sqe = accept_ring_->GetSqe();
+        if (!sqe) {
+            return false;
+        }
+        IoUring::PrepPollMultishot(sqe, fd, POLLIN, tag);
+        return accept_ring_->Submit() >= 0;
     }
 
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, client_fd, nullptr);
-    close(client_fd);
-    clients_.erase(it);
-
-    std::cout << "[UDSServer] Client closed (fd=" << client_fd 
-              << ", remaining=" << clients_.size() << ")" << std::endl;
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0;
 }
 
-void UDSServer::HandleInactivityTimer() {
-    uint64_t expirations;
-    read(timer_fd_, &expirations, sizeof(expirations));
-
-    time_t now = time(nullptr);
-    std::vector<int> inactive_clients;
+void UDSServer::UnwatchFd(int fd, uint64_t tag) {
+    if (accept_ring_) {
+        if (io_uring_sqe* sqe = accept_ring_->GetSqe()) {
+            IoUring::PrepPollRemove(sqe, tag, REMOVE_TAG);
+            accept_ring_->Submit();
+        }
+    } else if (epoll_fd_ >= 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
 
-    for (const auto& [fd, client] : clients_) {
-        if ((now - client->last_activity) > Protocol::INACTIVITY_TIMEOUT_SEC) {
-            inactive_clients.push_back(fd);
+void UDSServer::AcceptSuccessor() {
+    int fd = accept4(control_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            LOG_WARN("[UDSServer] Hot-restart accept failed: " << strerror(errno));
         }
+        return;
+    }
+    if (candidate_fd_ >= 0) {
+        // One takeover at a time; that server starts cold instead
+        LOG_WARN("[UDSServer] Refusing a hot-restart request while another is pending");
+        close(fd);
+        return;
     }
 
-    for (int fd : inactive_clients) {
-        std::cout << "[UDSServer] Closing inactive client (fd=" << fd << ")" << std::endl;
-        HandleClientClose(fd);
+    // The takeover request is read as it arrives, so a silent peer cannot
+    // hold up accepting clients; it only has IO_TIMEOUT_MS to send it
+    if (!hot_restart::SetIoTimeout(fd) || !WatchFd(fd, CANDIDATE_TAG)) {
+        LOG_WARN("[UDSServer] Cannot watch a hot-restart request: " << strerror(errno));
+        close(fd);
+        return;
     }
+    candidate_fd_ = fd;
+    candidate_deadline_ms_ = TimerWheel::CoarseNowMs() + hot_restart::IO_TIMEOUT_MS;
 }
 
-size_t UDSServer::ProcessClientRequest(int client_fd, const uint8_t* data, size_t len) {
-    if (len < Protocol::GetMinFrameSize()) {
-        std::cerr << "[UDSServer] Packet too small: " << len << " bytes" << std::endl;
-        return 0;
-    }
+UDSServer::ServerState UDSServer::HandleSuccessor() {
+    hot_restart::Message request;
+    auto status = candidate_reader_.Read(candidate_fd_, request, MSG_DONTWAIT);
+    if (status == hot_restart::MessageReader::Status::Again) {
+        return ServerState::WaitAndHandleEvents;
+    }
+
+    uint32_t dictionary_id = 0;
+    if (status != hot_restart::MessageReader::Status::Message ||
+        !hot_restart::ParseTakeover(request, dictionary_id) || !hot_restart::SendListener(candidate_fd_, server_fd_)) {
+        LOG_WARN("[UDSServer] Ignoring a failed hot-restart request");
+        DropSuccessorCandidate();
+        return ServerState::WaitAndHandleEvents;
+    }
+    int fd = candidate_fd_;
+    UnwatchFd(fd, CANDIDATE_TAG);
+    candidate_fd_ = -1;
+    candidate_reader_.Reset();
+
+    // The successor accepts from here on, and owns both socket paths
+    handed_off_.store(true);
+    peer_fd_ = fd;
+    successor_dictionary_id_ = dictionary_id;
+    drain_deadline_ms_ = TimerWheel::CoarseNowMs() + config_.handoff_drain_timeout_ms;
+    if (accept_ring_) {
+        accept_ring_.reset(); // Cancels the multishot accept and polls
+    } else {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, server_fd_, nullptr);
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, control_fd_, nullptr);
+    }
+    close(control_fd_);
+    control_fd_ = -1;
+
+    LOG_INFO("[UDSServer] Handed the listening socket to a successor, draining "
+             << GetClientCount() << " client(s)");
+    return ServerState::Drain;
+}
 
-    try {
-        // Parse frame
-        ByteBuffer request(const_cast<uint8_t*>(data), len);
-        
-        uint8_t start = request.GetByte();
-        if (start != Protocol::START_BYTE) {
-            std::cerr << "[UDSServer] Invalid start byte: 0x" << std::hex << (int)start << std::dec << std::endl;
-            return 0;
-        }
+void UDSServer::DropSuccessorCandidate() {
+    if (candidate_fd_ < 0) {
+        return;
+    }
+    UnwatchFd(candidate_fd_, CANDIDATE_TAG);
+    close(candidate_fd_);
+    candidate_fd_ = -1;
+    candidate_reader_.Reset();
+}
 
-        uint32_t frame_len = request.GetInt();
-        (void)frame_len; // Frame length already validated in protocol parsing
-        
-        uint32_t routine_id = request.GetInt();
-        uint8_t version = request.GetByte();
+void UDSServer::ExpireSuccessorCandidate() {
+    if (candidate_fd_ >= 0 && TimerWheel::CoarseNowMs() >= candidate_deadline_ms_) {
+        LOG_WARN("[UDSServer] Dropping a hot-restart request that never arrived");
+        DropSuccessorCandidate();
+    }
+}
 
-        if (version != Protocol::VERSION) {
-            std::cerr << "[UDSServer] Unsupported version: " << (int)version << std::endl;
-            return 0;
+void UDSServer::HandlePredecessorMessages() {
+    while (true) {
+        hot_restart::Message message;
+        auto status = peer_reader_.Read(peer_fd_, message, MSG_DONTWAIT);
+        if (status == hot_restart::MessageReader::Status::Again) {
+            return;
         }
 
-        // Prepare response buffer
-        uint8_t response[Protocol::MAX_PACKET_SIZE];
-        
-        // Execute service
-        size_t payload_start = request.Position();
-        size_t payload_len = len - payload_start - 1; // Exclude END_BYTE
-        
-        size_t response_len = service_manager_->ExecuteService(
-            routine_id,
-            data + payload_start,
-            payload_len,
-            response,
-            sizeof(response)
-        );
-
-        if (response_len > 0) {
-            // Send response
-            ssize_t sent = send(client_fd, response, response_len, MSG_NOSIGNAL);
-            if (sent < 0) {
-                std::cerr << "[UDSServer] send failed: " << strerror(errno) << std::endl;
-                return 0;
+        std::vector<HandoffClient> clients;
+        if (status == hot_restart::MessageReader::Status::Message &&
+            message.kind == hot_restart::MessageKind::Clients && hot_restart::ParseClients(message, clients)) {
+            for (const auto& client : clients) {
+                Reactor& reactor = SelectReactor();
+                if (!reactor.AdoptClient(client)) {
+                    close(client.fd);
+                    continue;
+                }
+                adopted_clients_.fetch_add(1);
             }
-            return response_len;
+            continue;
         }
 
-        return 0;
-
-    } catch (const std::exception& e) {
-        std::cerr << "[UDSServer] Exception processing request: " << e.what() << std::endl;
-        return 0;
+        // Done, or the predecessor went away: either way it is finished
+        if (status == hot_restart::MessageReader::Status::Message &&
+            message.kind == hot_restart::MessageKind::Done) {
+            LOG_INFO("[UDSServer] Hot restart complete, " << adopted_clients_.load() << " client(s) adopted");
+        } else {
+            LOG_WARN("[UDSServer] Predecessor ended the hand-off early ("
+                     << adopted_clients_.load() << " client(s) adopted)");
+        }
+        for (int fd : message.fds) {
+            close(fd);
+        }
+        ClosePeer();
+        CreateControlSocket();
+        return;
     }
 }
 
-bool UDSServer::CreateInactivityTimer() {
-    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
-    if (timer_fd_ < 0) {
-        std::cerr << "[UDSServer] timerfd_create failed: " << strerror(errno) << std::endl;
-        return false;
+void UDSServer::ClosePeer() {
+    if (peer_fd_ < 0) {
+        return;
     }
+    UnwatchFd(peer_fd_, PEER_TAG);
+    close(peer_fd_);
+    peer_fd_ = -1;
+    peer_reader_.Reset();
+}
 
-    // Set timer to fire every 60 seconds
-    struct itimerspec its;
-    its.it_value.tv_sec = 60;
-    its.it_value.tv_nsec = 0;
-    its.it_interval.tv_sec = 60;
-    its.it_interval.tv_nsec = 0;
+void UDSServer::TransferClients() {
+    for (auto& reactor : reactors_) {
+        std::vector<HandoffClient> clients = reactor->DetachClients(successor_dictionary_id_);
+        if (clients.empty()) {
+            continue;
+        }
+        if (peer_fd_ >= 0 && !hot_restart::SendClients(peer_fd_, clients)) {
+            LOG_ERROR("[UDSServer] Lost the successor: " << strerror(errno));
+            ClosePeer();
+        }
+        for (const auto& client : clients) {
+            close(client.fd); // The successor holds its own copies
+        }
+    }
+}
 
-    if (timerfd_settime(timer_fd_, 0, &its, nullptr) < 0) {
-        std::cerr << "[UDSServer] timerfd_settime failed: " << strerror(errno) << std::endl;
-        close(timer_fd_);
-        timer_fd_ = -1;
-        return false;
+Reactor& UDSServer::SelectReactor() {
+    if (config_.accept_policy == AcceptPolicy::LeastLoaded) {
+        size_t best = 0;
+        for (size_t i = 1; i < reactors_.size(); ++i) {
+            if (reactors_[i]->GetClientCount() < reactors_[best]->GetClientCount()) {
+                best = i;
+            }
+        }
+        return *reactors_[best];
     }
 
-    // Add to epoll
-    struct epoll_event ev;
-    ev.events = EPOLLIN;
-    ev.data.fd = timer_fd_;
-    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev) < 0) {
-        std::cerr << "[UDSServer] epoll_ctl failed for timer: " << strerror(errno) << std::endl;
-        close(timer_fd_);
-        timer_fd_ = -1;
-        return false;
+    Reactor& reactor = *reactors_[next_reactor_];
+    next_reactor_ = (next_reactor_ + 1) % reactors_.size();
+    return reactor;
+}
+
+bool UDSServer::StartReactors() {
+    if (config_.execution_mode == ExecutionMode::ThreadPool) {
+        size_t workers = config_.worker_threads;
+        if (workers == 0) {
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (config_.worker_pool == WorkerPoolKind::WorkStealing) {
+            worker_pool_ = std::make_unique<thread_pool::WorkStealingThreadPool>(
+                workers, config_.max_queued_requests, config_.worker_placement);
+        } else {
+            worker_pool_ = std::make_unique<thread_pool::ThreadPool>(
+                workers, config_.max_queued_requests, config_.worker_placement);
+        }
+        LOG_INFO("[UDSServer] Offloading service execution to "
+                 << workers << " worker thread(s)"
+                 << (config_.worker_pool == WorkerPoolKind::WorkStealing ? " (work stealing)" : "")
+                 << (config_.worker_placement.IsPinned() ? " (pinned)" : ""));
+        if (config_.max_queued_requests > 0) {
+            LOG_INFO("[UDSServer] At most " << config_.max_queued_requests << " queued request(s), then "
+                     << (config_.overload_policy == OverloadPolicy::Reject ? "rejecting" : "backpressure"));
+        }
     }
 
+    for (auto& reactor : reactors_) {
+        if (!reactor->Start(worker_pool_.get())) {
+            return false;
+        }
+    }
     return true;
 }
 
+void UDSServer::StopReactors() {
+    // Drain the pool first so every finished response reaches a live reactor
+    if (worker_pool_) {
+        worker_pool_->Shutdown();
+        worker_pool_.reset();
+    }
+
+    for (auto& reactor : reactors_) {
+        reactor->Stop();
+    }
+}
+
 bool UDSServer::SetNonBlocking(int fd) {
     int flags = fcntl(fd, F_GETFL, 0);
     if (flags < 0) {
@@ -432,21 +769,9 @@ bool UDSServer::SetNonBlocking(int fd) {
     return fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
 }
 
-void UDSServer::CloseAllClients() {
-    std::cout << "[UDSServer] Closing " << clients_.size() << " clients" << std::endl;
-    
-    for (auto& [fd, client] : clients_) {
-        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
-        close(fd);
-    }
-    
-    clients_.clear();
-}
-
 void UDSServer::RemoveSocketFile() {
     if (unlink(socket_path_.c_str()) < 0 && errno != ENOENT) {
-        std::cerr << "[UDSServer] Warning: Failed to remove socket file: " 
-                  << strerror(errno) << std::endl;
+        LOG_WARN("[UDSServer] Failed to remove socket file: " << strerror(errno));
     }
 }
 
@@ -8,7 +8,8 @@
 #ifndef IPC_DEMO_CALCULATOR_SERVICE_HPP
 #define IPC_DEMO_CALCULATOR_SERVICE_HPP
 
-#include "IService.hpp"
+#include "TypedService.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
 
 namespace ipc_demo {
 
@@ -22,48 +23,33 @@ namespace ipc_demo {
  * - Multiply: a * b
  * - Divide: a / b (with error handling for division by zero)
  * 
- * Request Format (after version byte):
- *   [operation:byte][operand_a:double][operand_b:double]
- * 
- * Response Format (full frame):
- *   [START][LENGTH][RESPONSE_ID][VERSION][status:byte][result:double][error_msg:string][END]
+ * Messages: CalculatorRequest / CalculatorResponse (CalculatorSchema.hpp),
+ * routine IDs 0x1000 / 0x1001.
  */
-class CalculatorService : public IService {
+class CalculatorService : public TypedService<CalculatorRpc> {
 public:
-    // Operation codes
-    enum class Operation : uint8_t {
-        Add = 0x01,
-        Subtract = 0x02,
-        Multiply = 0x03,
-        Divide = 0x04
-    };
-
-    // Status codes
-    enum class Status : uint8_t {
-        Success = 0x00,
-        DivisionByZero = 0x01,
-        InvalidOperation = 0x02,
-        InvalidInput = 0x03
-    };
+    using Operation = CalculatorOperation;
+    using Status = CalculatorStatus;
 
     CalculatorService() = default;
     ~CalculatorService() override = default;
 
-    uint32_t GetRequestRoutineId() const override {
-        return 0x1000; // Calculator request ID
+    std::string GetName() const override {
+        return "CalculatorService";
     }
 
-    uint32_t GetResponseRoutineId() const override {
-        return 0x1001; // Calculator response ID
+    bool IsInlineSafe() const override {
+        return true; // Pure arithmetic, never blocks
     }
 
-    size_t Execute(const uint8_t* input, size_t input_len,
-                  uint8_t* output, size_t output_len) override;
-
-    std::string GetName() const override {
-        return "CalculatorService";
+    bool IsIdempotent() const override {
+        return true; // The result depends on the operands only
     }
 
+protected:
+    void Handle(const CalculatorRequest& request, CalculatorResponse& response) override;
+    bool HandleInvalidRequest(CalculatorResponse& response) override;
+
 private:
     /**
      * @brief Execute arithmetic operation
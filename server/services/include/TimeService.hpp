@@ -8,7 +8,8 @@
 #ifndef IPC_DEMO_TIME_SERVICE_HPP
 #define IPC_DEMO_TIME_SERVICE_HPP
 
-#include "IService.hpp"
+#include "TypedService.hpp"
+#include "ipc_sync/TimeSchema.hpp"
 
 namespace ipc_demo {
 
@@ -19,44 +20,25 @@ namespace ipc_demo {
  * Operations:
  * - GetTimestamp: Returns current server time in human-readable format and Unix timestamp
  * 
- * Request Format (after version byte):
- *   [operation:byte]
- * 
- * Response Format (full frame):
- *   [START][LENGTH][RESPONSE_ID][VERSION][status:byte][timestamp:string][unix_timestamp:int64][error_msg:string][END]
+ * Messages: TimeRequest / TimeResponse (TimeSchema.hpp), routine IDs
+ * 0x2000 / 0x2001.
  */
-class TimeService : public IService {
+class TimeService : public TypedService<TimeRpc> {
 public:
-    // Operation codes
-    enum class Operation : uint8_t {
-        GetTimestamp = 0x01
-    };
-
-    // Status codes
-    enum class Status : uint8_t {
-        Success = 0x00,
-        InvalidOperation = 0x01,
-        InvalidInput = 0x02
-    };
+    using Operation = TimeOperation;
+    using Status = TimeStatus;
 
     TimeService() = default;
     ~TimeService() override = default;
 
-    uint32_t GetRequestRoutineId() const override {
-        return 0x2000; // Time service request ID
-    }
-
-    uint32_t GetResponseRoutineId() const override {
-        return 0x2001; // Time service response ID
-    }
-
-    size_t Execute(const uint8_t* input, size_t input_len,
-                  uint8_t* output, size_t output_len) override;
-
     std::string GetName() const override {
         return "TimeService";
     }
 
+protected:
+    void Handle(const TimeRequest& request, TimeResponse& response) override;
+    bool HandleInvalidRequest(TimeResponse& response) override;
+
 private:
     /**
      * @brief Get current server timestamp
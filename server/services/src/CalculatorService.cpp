@@ -4,75 +4,27 @@
  */
 
 #include "CalculatorService.hpp"
-#include "ipc_sync/ByteBuffer.hpp"
-#include "ipc_sync/Protocol.hpp"
-#include <iostream>
+#include "logging/Logger.hpp"
 #include <cmath>
 
 namespace ipc_demo {
 
-size_t CalculatorService::Execute(const uint8_t* input, size_t input_len,
-                                  uint8_t* output, size_t output_len) {
-    try {
-        // Parse request
-        ByteBuffer request(const_cast<uint8_t*>(input), input_len);
-        
-        uint8_t op_byte = request.GetByte();
-        double operand_a = request.GetDouble();
-        double operand_b = request.GetDouble();
+void CalculatorService::Handle(const CalculatorRequest& request, CalculatorResponse& response) {
+    LOG_DEBUG("[CalculatorService] Request: op=" << static_cast<int>(request.op)
+              << ", a=" << request.a << ", b=" << request.b);
 
-        Operation op = static_cast<Operation>(op_byte);
+    response.status = ExecuteOperation(request.op, request.a, request.b, response.result, response.error);
 
-        std::cout << "[CalculatorService] Request: op=" << (int)op_byte
-                  << ", a=" << operand_a << ", b=" << operand_b << std::endl;
-
-        // Execute operation
-        double result = 0.0;
-        std::string error_msg;
-        Status status = ExecuteOperation(op, operand_a, operand_b, result, error_msg);
-
-        // Build response frame
-        ByteBuffer response(output, output_len);
-        
-        response.PutByte(Protocol::START_BYTE);
-        response.PutInt(0); // Placeholder for length
-        response.PutInt(GetResponseRoutineId());
-        response.PutByte(Protocol::VERSION);
-        response.PutByte(static_cast<uint8_t>(status));
-        response.PutDouble(result);
-        response.PutString(error_msg);
-        response.PutByte(Protocol::END_BYTE);
-
-        // Update length
-        size_t total_len = response.Position();
-        response.SetPosition(1);
-        response.PutInt(total_len);
-
-        std::cout << "[CalculatorService] Response: status=" << (int)status
-                  << ", result=" << result << std::endl;
-
-        return total_len;
-
-    } catch (const std::exception& e) {
-        std::cerr << "[CalculatorService] Exception: " << e.what() << std::endl;
-        
-        // Build error response
-        ByteBuffer response(output, output_len);
-        response.PutByte(Protocol::START_BYTE);
-        response.PutInt(0);
-        response.PutInt(GetResponseRoutineId());
-        response.PutByte(Protocol::VERSION);
-        response.PutByte(static_cast<uint8_t>(Status::InvalidInput));
-        response.PutDouble(0.0);
-        response.PutString(std::string("Exception: ") + e.what());
-        response.PutByte(Protocol::END_BYTE);
-
-        size_t total_len = response.Position();
-        response.SetPosition(1);
-        response.PutInt(total_len);
+    LOG_DEBUG("[CalculatorService] Response: status=" << static_cast<int>(response.status)
+              << ", result=" << response.result);
+}
 
-        return total_len;
-    }
+bool CalculatorService::HandleInvalidRequest(CalculatorResponse& response) {
+    LOG_WARN("[CalculatorService] Truncated request");
+    response.status = Status::InvalidInput;
+    response.result = 0.0;
+    response.error = "Truncated request";
+    return true;
 }
 
 CalculatorService::Status CalculatorService::ExecuteOperation(
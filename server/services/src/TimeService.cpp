@@ -4,117 +4,73 @@
  */
 
 #include "TimeService.hpp"
-#include "ipc_sync/ByteBuffer.hpp"
-#include "ipc_sync/Protocol.hpp"
-#include <iostream>
+#include "logging/Logger.hpp"
 #include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
 namespace ipc_demo {
 
-size_t TimeService::Execute(const uint8_t* input, size_t input_len,
-                            uint8_t* output, size_t output_len) {
-    try {
-        // Parse request
-        ByteBuffer request(const_cast<uint8_t*>(input), input_len);
-        
-        uint8_t op_byte = request.GetByte();
-        Operation op = static_cast<Operation>(op_byte);
+void TimeService::Handle(const TimeRequest& request, TimeResponse& response) {
+    LOG_DEBUG("[TimeService] Request: op=" << static_cast<int>(request.op));
 
-        std::cout << "[TimeService] Request: op=" << (int)op_byte << std::endl;
-
-        // Execute operation
-        std::string timestamp;
-        int64_t unix_timestamp = 0;
-        std::string error_msg;
-        Status status = Status::InvalidOperation;
-
-        if (op == Operation::GetTimestamp) {
-            status = GetCurrentTimestamp(timestamp, unix_timestamp, error_msg);
-        } else {
-            error_msg = "Invalid operation code";
-            status = Status::InvalidOperation;
-        }
-
-        // Build response frame
-        ByteBuffer response(output, output_len);
-        
-        response.PutByte(Protocol::START_BYTE);
-        response.PutInt(0); // Placeholder for length
-        response.PutInt(GetResponseRoutineId());
-        response.PutByte(Protocol::VERSION);
-        response.PutByte(static_cast<uint8_t>(status));
-        response.PutString(timestamp);
-        response.PutLong(unix_timestamp);
-        response.PutString(error_msg);
-        response.PutByte(Protocol::END_BYTE);
-
-        // Update length
-        size_t total_len = response.Position();
-        response.SetPosition(1);
-        response.PutInt(total_len);
-
-        std::cout << "[TimeService] Response: status=" << (int)status
-                  << ", timestamp=" << timestamp 
-                  << ", unix=" << unix_timestamp << std::endl;
-
-        return total_len;
-
-    } catch (const std::exception& e) {
-        std::cerr << "[TimeService] Exception: " << e.what() << std::endl;
-        
-        // Build error response
-        ByteBuffer response(output, output_len);
-        response.PutByte(Protocol::START_BYTE);
-        response.PutInt(0);
-        response.PutInt(GetResponseRoutineId());
-        response.PutByte(Protocol::VERSION);
-        response.PutByte(static_cast<uint8_t>(Status::InvalidInput));
-        response.PutString("");
-        response.PutLong(0);
-        response.PutString(std::string("Exception: ") + e.what());
-        response.PutByte(Protocol::END_BYTE);
+    if (request.op == Operation::GetTimestamp) {
+        response.status = GetCurrentTimestamp(response.timestamp, response.unix_timestamp, response.error);
+    } else {
+        response.error = "Invalid operation code";
+        response.status = Status::InvalidOperation;
+    }
 
-        size_t total_len = response.Position();
-        response.SetPosition(1);
-        response.PutInt(total_len);
+    LOG_DEBUG("[TimeService] Response: status=" << static_cast<int>(response.status)
+              << ", timestamp=" << response.timestamp
+              << ", unix=" << response.unix_timestamp);
+}
 
-        return total_len;
-    }
+bool TimeService::HandleInvalidRequest(TimeResponse& response) {
+    LOG_WARN("[TimeService] Truncated request");
+    response.status = Status::InvalidInput;
+    response.unix_timestamp = 0;
+    response.error = "Truncated request";
+    return true;
 }
 
 TimeService::Status TimeService::GetCurrentTimestamp(
     std::string& timestamp, int64_t& unix_timestamp, std::string& error) {
-    
-    try {
-        // Get current time
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
-        
-        // Format timestamp as ISO 8601: YYYY-MM-DD HH:MM:SS.mmm
+
+    // localtime_r/strftime only run when the second changes; within a
+    // second only the milliseconds are formatted
+    struct SecondCache {
+        time_t second = -1;
+        char prefix[32];        // "YYYY-MM-DD HH:MM:SS"
+        size_t prefix_len = 0;
+    };
+    thread_local SecondCache cache;
+
+    auto now = std::chrono::system_clock::now();
+    auto ms_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    time_t second = static_cast<time_t>(ms_since_epoch / 1000);
+    int ms = static_cast<int>(ms_since_epoch % 1000);
+
+    if (second != cache.second) {
         std::tm tm_now;
-        localtime_r(&time_t_now, &tm_now);
-        
-        std::ostringstream oss;
-        oss << std::put_time(&tm_now, "%Y-%m-%d %H:%M:%S")
-            << '.' << std::setfill('0') << std::setw(3) << ms.count();
-        
-        timestamp = oss.str();
-        unix_timestamp = static_cast<int64_t>(time_t_now);
-        error.clear();
-        
-        return Status::Success;
-        
-    } catch (const std::exception& e) {
-        error = std::string("Failed to get timestamp: ") + e.what();
-        timestamp.clear();
-        unix_timestamp = 0;
-        return Status::InvalidInput;
+        if (localtime_r(&second, &tm_now) == nullptr) {
+            error = "Failed to get timestamp: localtime_r failed";
+            timestamp.clear();
+            unix_timestamp = 0;
+            return Status::InvalidInput;
+        }
+        cache.prefix_len = std::strftime(cache.prefix, sizeof(cache.prefix), "%Y-%m-%d %H:%M:%S", &tm_now);
+        cache.second = second;
     }
+
+    // Format timestamp as ISO 8601: YYYY-MM-DD HH:MM:SS.mmm
+    char millis[5] = {'.', static_cast<char>('0' + ms / 100), static_cast<char>('0' + ms / 10 % 10),
+                      static_cast<char>('0' + ms % 10), '\0'};
+    timestamp.assign(cache.prefix, cache.prefix_len);
+    timestamp.append(millis, 4);
+    unix_timestamp = static_cast<int64_t>(second);
+    error.clear();
+
+    return Status::Success;
 }
 
 } // namespace ipc_demo
@@ -0,0 +1,188 @@
+/**
+ * @file ServerFixture.hpp
+ * @brief Shared fixture for in-process server tests
+ *
+ * Starts a UDSServer on a per-process socket path and connects Channels or
+ * plain sockets to it; tests that speak the wire protocol directly build,
+ * send and read raw frames with the static helpers. Per-feature fixtures
+ * derive from it, register their services on manager_ in SetUp() and call
+ * StartServer() from the test.
+ */
+#ifndef IPC_DEMO_UTEST_SERVER_FIXTURE_HPP
+#define IPC_DEMO_UTEST_SERVER_FIXTURE_HPP
+
+#include "UDSServer.hpp"
+#include "ServiceManager.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ServerFixture : public ::testing::Test {
+public:
+    /**
+     * @brief Frame: [START][LEN][ROUTINE][VERSION|flags][REQUEST_ID][payload][END]
+     *
+     * The request ID (and FLAG_REQUEST_ID) only if one is given.
+     */
+    static std::vector<uint8_t> BuildFrame(uint32_t routine_id, const uint8_t* payload, size_t len,
+                                           uint8_t flags = 0,
+                                           std::optional<uint32_t> request_id = std::nullopt) {
+        size_t extension_len = request_id ? ipc_demo::Protocol::REQUEST_ID_SIZE : 0;
+        std::vector<uint8_t> frame(ipc_demo::Protocol::GetMinFrameSize() + extension_len + len);
+        ipc_demo::ByteBuffer buf(frame.data(), frame.size());
+        buf.PutByte(ipc_demo::Protocol::START_BYTE);
+        buf.PutInt(static_cast<uint32_t>(frame.size()));
+        buf.PutInt(routine_id);
+        buf.PutByte(ipc_demo::Protocol::VERSION | flags |
+                    (request_id ? ipc_demo::Protocol::FLAG_REQUEST_ID : 0));
+        if (request_id) {
+            buf.PutInt(*request_id);
+        }
+        if (len > 0) {
+            std::memcpy(frame.data() + buf.Position(), payload, len);
+        }
+        frame.back() = ipc_demo::Protocol::END_BYTE;
+        return frame;
+    }
+
+    static bool SendFrame(int fd, const std::vector<uint8_t>& frame) {
+        return send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(frame.size());
+    }
+
+    /**
+     * @brief Next whole frame from fd (valid until parser is used again)
+     * @return false if none arrives within timeout_ms or the peer closed
+     */
+    static bool NextFrame(int fd, ipc_demo::FrameParser& parser, ipc_demo::FrameView& frame,
+                          int timeout_ms = 1000) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            if (parser.Next(frame) == ipc_demo::FrameParser::Result::Frame) {
+                return true;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            struct pollfd pfd{fd, POLLIN, 0};
+            if (left <= 0 || poll(&pfd, 1, static_cast<int>(left)) <= 0) {
+                return false;
+            }
+            size_t space = 0;
+            uint8_t* dst = parser.Buffer().WritePtr(space);
+            ssize_t n = recv(fd, dst, space, 0);
+            if (n <= 0) {
+                return false;
+            }
+            parser.Buffer().CommitWrite(static_cast<size_t>(n));
+        }
+    }
+
+    /**
+     * @brief Copy of the next whole frame; empty if none arrives in time
+     */
+    static std::vector<uint8_t> ReadFrame(int fd, ipc_demo::FrameParser& parser, int timeout_ms = 1000) {
+        ipc_demo::FrameView frame;
+        if (!NextFrame(fd, parser, frame, timeout_ms)) {
+            return {};
+        }
+        return std::vector<uint8_t>(frame.data, frame.data + frame.length);
+    }
+
+    template<typename Predicate>
+    static bool WaitUntil(Predicate predicate, int timeout_ms = 3000) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (predicate()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return predicate();
+    }
+
+protected:
+    /**
+     * @param name Distinguishes the socket path of each test file
+     */
+    explicit ServerFixture(const std::string& name)
+        : socket_path_("/tmp/test_ipc_" + name + "_" + std::to_string(getpid()) + ".sock")
+        , manager_(std::make_shared<ipc_demo::ServiceManager>()) {
+    }
+
+    void TearDown() override {
+        if (server_) {
+            server_->Stop();
+        }
+    }
+
+    /**
+     * @brief Start a server on socket_path_ and wait until it listens
+     */
+    std::unique_ptr<ipc_demo::UDSServer> LaunchServer(std::shared_ptr<ipc_demo::ServiceManager> manager,
+                                                      const ipc_demo::ServerConfig& config) {
+        auto server = std::make_unique<ipc_demo::UDSServer>(socket_path_, std::move(manager), config);
+        EXPECT_TRUE(server->Start());
+        EXPECT_TRUE(WaitUntil([this]() { return access(socket_path_.c_str(), F_OK) == 0; }));
+        return server;
+    }
+
+    /**
+     * @brief Start server_ with manager_'s services
+     */
+    void StartServer(const ipc_demo::ServerConfig& config = ipc_demo::ServerConfig{}) {
+        server_ = LaunchServer(manager_, config);
+    }
+
+    /**
+     * @brief Channel to the server, retried until it connects (or times out)
+     */
+    std::shared_ptr<ipc_demo::Channel> Connect(
+        const ipc_demo::ChannelOptions& options = ipc_demo::ChannelOptions{1000, false}) {
+        std::shared_ptr<ipc_demo::Channel> channel;
+        WaitUntil([&]() {
+            channel = std::make_shared<ipc_demo::Channel>(socket_path_, options);
+            return channel->IsConnected();
+        });
+        return channel;
+    }
+
+    /**
+     * @brief Plain blocking socket, bypassing Channel framing (the test closes it)
+     *
+     * Receives time out after 2 s, so a missing response fails the test
+     * instead of hanging it.
+     */
+    int ConnectRaw() {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        struct timeval tv{2, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        return fd;
+    }
+
+    std::string socket_path_;
+    std::shared_ptr<ipc_demo::ServiceManager> manager_;
+    std::unique_ptr<ipc_demo::UDSServer> server_;
+};
+
+#endif // IPC_DEMO_UTEST_SERVER_FIXTURE_HPP
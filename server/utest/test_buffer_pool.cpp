@@ -0,0 +1,275 @@
+/**
+ * @file test_buffer_pool.cpp
+ * @brief Unit tests for BufferPool, pooled rings and parsers, and ConnectionTable
+ */
+
+#include "ConnectionTable.hpp"
+#include "ipc_sync/BufferPool.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/RingBuffer.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+std::vector<uint8_t> BuildFrame(uint32_t routine_id, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame(Protocol::GetMinFrameSize() + payload.size());
+    ByteBuffer buf(frame.data(), frame.size());
+    buf.PutByte(Protocol::START_BYTE);
+    buf.PutInt(static_cast<uint32_t>(frame.size()));
+    buf.PutInt(routine_id);
+    buf.PutByte(Protocol::VERSION);
+    for (uint8_t b : payload) {
+        buf.PutByte(b);
+    }
+    buf.PutByte(Protocol::END_BYTE);
+    return frame;
+}
+
+struct Tracked {
+    static int live;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    ~Tracked() { --live; }
+};
+
+int Tracked::live = 0;
+
+} // namespace
+
+// ============================================================================
+// BufferPool
+// ============================================================================
+
+TEST(BufferPoolTest, BlocksAreReusedMostRecentFirst) {
+    BufferPool pool(100, 4);
+    EXPECT_EQ(pool.BlockSize(), 128u);
+    EXPECT_EQ(pool.Allocated(), 0u);
+
+    uint8_t* a = pool.Acquire();
+    uint8_t* b = pool.Acquire();
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.Allocated(), 4u);
+    EXPECT_EQ(pool.InUse(), 2u);
+
+    pool.Release(a);
+    EXPECT_EQ(pool.Acquire(), a);
+    pool.Release(a);
+    pool.Release(b);
+    EXPECT_EQ(pool.InUse(), 0u);
+}
+
+TEST(BufferPoolTest, GrowsBySlabWithDistinctBlocks) {
+    BufferPool pool(64, 2);
+    std::set<uint8_t*> blocks;
+    for (int i = 0; i < 7; ++i) {
+        uint8_t* block = pool.Acquire();
+        std::fill(block, block + pool.BlockSize(), static_cast<uint8_t>(i)); // No overlap
+        blocks.insert(block);
+    }
+    EXPECT_EQ(blocks.size(), 7u);
+    EXPECT_EQ(pool.Allocated(), 8u);
+    for (uint8_t* block : blocks) {
+        pool.Release(block);
+    }
+    EXPECT_EQ(pool.InUse(), 0u);
+}
+
+TEST(BufferPoolTest, ReserveAllocatesWholeSlabsUpFront) {
+    BufferPool pool(1024, 4);
+    pool.Reserve(6);
+    EXPECT_EQ(pool.Allocated(), 8u);
+    EXPECT_EQ(pool.InUse(), 0u);
+
+    pool.Reserve(3); // Already there
+    EXPECT_EQ(pool.Allocated(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        pool.Acquire();
+    }
+    EXPECT_EQ(pool.Allocated(), 8u);
+}
+
+TEST(BufferPoolTest, RejectsZeroSizes) {
+    EXPECT_THROW(BufferPool(0), std::invalid_argument);
+    EXPECT_THROW(BufferPool(64, 0), std::invalid_argument);
+}
+
+// ============================================================================
+// Pooled RingBuffer / FrameParser
+// ============================================================================
+
+TEST(PooledRingBufferTest, BorrowsOnlyWhileDataIsBuffered) {
+    BufferPool pool(16);
+    RingBuffer ring(pool);
+    EXPECT_EQ(ring.Capacity(), 16u);
+    EXPECT_EQ(ring.FreeSpace(), 16u);
+    EXPECT_FALSE(ring.HasStorage());
+
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    ASSERT_TRUE(ring.Write(data, sizeof(data)));
+    EXPECT_EQ(pool.InUse(), 1u);
+    ring.Consume(2);
+    EXPECT_EQ(pool.InUse(), 1u);
+    ring.Consume(3);
+    EXPECT_EQ(pool.InUse(), 0u);
+
+    // A read that came back empty
+    size_t space = 0;
+    ring.WritePtr(space);
+    EXPECT_EQ(space, 16u);
+    EXPECT_EQ(pool.InUse(), 1u);
+    ring.ReleaseIfEmpty();
+    EXPECT_EQ(pool.InUse(), 0u);
+
+    ASSERT_TRUE(ring.Write(data, sizeof(data)));
+    ring.ReleaseIfEmpty(); // Keeps buffered data
+    EXPECT_EQ(pool.InUse(), 1u);
+    uint8_t out[5];
+    ASSERT_TRUE(ring.Peek(0, out, sizeof(out)));
+    EXPECT_EQ(out[4], 5);
+    ring.Clear();
+    EXPECT_EQ(pool.InUse(), 0u);
+}
+
+TEST(PooledRingBufferTest, DestructorReturnsStorage) {
+    BufferPool pool(16);
+    {
+        RingBuffer ring(pool);
+        const uint8_t byte = 7;
+        ASSERT_TRUE(ring.Write(&byte, 1));
+        EXPECT_EQ(pool.InUse(), 1u);
+    }
+    EXPECT_EQ(pool.InUse(), 0u);
+}
+
+TEST(PooledFrameParserTest, ManyParsersShareFewBlocks) {
+    BufferPool pool(128, 2);  // Two 64-byte frames per block
+    std::vector<std::unique_ptr<FrameParser>> parsers;
+    for (int i = 0; i < 50; ++i) {
+        parsers.push_back(std::make_unique<FrameParser>(pool, 64));
+    }
+
+    auto bytes = BuildFrame(0x3000, std::vector<uint8_t>(20, 1));
+    FrameView frame;
+    for (auto& parser : parsers) {
+        ASSERT_TRUE(parser->Buffer().Write(bytes.data(), bytes.size()));
+        ASSERT_EQ(parser->Next(frame), FrameParser::Result::Frame);
+        EXPECT_EQ(frame.routine_id, 0x3000u);
+        EXPECT_EQ(parser->Next(frame), FrameParser::Result::NeedMore);
+    }
+
+    // Each frame was released before the next parser borrowed the block
+    EXPECT_EQ(pool.InUse(), 0u);
+    EXPECT_EQ(pool.Allocated(), 2u);
+}
+
+TEST(PooledFrameParserTest, WrappedFrameBorrowsScratchUntilNextCall) {
+    BufferPool pool(128);
+    FrameParser parser(pool, 64);
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 20; ++i) {
+        auto bytes = BuildFrame(0x3000 + i, std::vector<uint8_t>(40, i)); // 51 bytes
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    // Odd chunk size keeps a partial frame buffered, so frames straddle the ring end
+    constexpr size_t CHUNK = 37;
+    FrameView frame;
+    uint8_t expected = 0;
+    size_t peak = 0;
+    for (size_t pos = 0; pos < stream.size(); pos += CHUNK) {
+        size_t len = std::min(CHUNK, stream.size() - pos);
+        ASSERT_TRUE(parser.Buffer().Write(stream.data() + pos, len));
+
+        while (parser.Next(frame) == FrameParser::Result::Frame) {
+            peak = std::max(peak, pool.InUse());
+            EXPECT_EQ(frame.routine_id, 0x3000u + expected);
+            EXPECT_EQ(frame.payload[39], expected);
+            ++expected;
+        }
+        EXPECT_LE(pool.InUse(), 1u); // Only the ring while a partial frame waits
+    }
+    EXPECT_EQ(expected, 20);
+    EXPECT_EQ(peak, 2u); // Ring plus the linearized copy of a wrapped frame
+    EXPECT_EQ(pool.InUse(), 0u);
+}
+
+TEST(PooledFrameParserTest, RejectsBlocksSmallerThanTwoFrames) {
+    BufferPool pool(64);
+    EXPECT_THROW(FrameParser(pool, 64), std::invalid_argument);
+}
+
+// ============================================================================
+// ConnectionTable
+// ============================================================================
+
+TEST(ConnectionTableTest, IndexesByDescriptor) {
+    ConnectionTable<Tracked> table;
+    Tracked* a = table.Emplace(3, 30);
+    Tracked* b = table.Emplace(100, 1000);
+    EXPECT_EQ(table.Size(), 2u);
+    EXPECT_EQ(table.Find(3), a);
+    EXPECT_EQ(table.Find(100), b);
+    EXPECT_EQ(table.Find(4), nullptr);
+    EXPECT_EQ(table.Find(-1), nullptr);
+    EXPECT_EQ(table.Find(5000), nullptr);
+
+    std::vector<int> fds;
+    table.ForEach([&fds](int fd, Tracked& object) {
+        EXPECT_EQ(object.value, fd * 10);
+        fds.push_back(fd);
+    });
+    EXPECT_EQ(fds, (std::vector<int>{3, 100}));
+
+    table.Erase(3);
+    table.Erase(3); // No-op
+    EXPECT_EQ(table.Find(3), nullptr);
+    EXPECT_EQ(table.Size(), 1u);
+    EXPECT_EQ(Tracked::live, 1);
+    table.Clear();
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(ConnectionTableTest, SlotsAreRecycled) {
+    ConnectionTable<Tracked> table;
+    Tracked* first = table.Emplace(7, 1);
+    table.Erase(7);
+    EXPECT_EQ(table.Emplace(8, 2), first); // Same slot, no allocation
+
+    // Addresses stay stable while the table grows past a slab
+    std::vector<Tracked*> objects;
+    for (int fd = 10; fd < 10 + static_cast<int>(2 * ConnectionTable<Tracked>::SLOTS_PER_SLAB); ++fd) {
+        objects.push_back(table.Emplace(fd, fd));
+    }
+    for (size_t i = 0; i < objects.size(); ++i) {
+        EXPECT_EQ(table.Find(10 + static_cast<int>(i)), objects[i]);
+        EXPECT_EQ(objects[i]->value, 10 + static_cast<int>(i));
+    }
+}
+
+TEST(ConnectionTableTest, DetachedObjectsOutliveTheirDescriptor) {
+    ConnectionTable<Tracked> table;
+    Tracked* old = table.Emplace(5, 1);
+    ASSERT_EQ(table.Detach(5), old);
+    EXPECT_EQ(table.Size(), 0u);
+
+    // The descriptor is reused while the old object is still alive
+    Tracked* reused = table.Emplace(5, 2);
+    EXPECT_NE(reused, old);
+    EXPECT_EQ(old->value, 1);
+    EXPECT_EQ(Tracked::live, 2);
+
+    table.Destroy(old);
+    EXPECT_EQ(Tracked::live, 1);
+    table.Clear();
+    EXPECT_EQ(Tracked::live, 0);
+}
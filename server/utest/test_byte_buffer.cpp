@@ -5,8 +5,10 @@
 
 #include "ipc_sync/ByteBuffer.hpp"
 #include <gtest/gtest.h>
-#include <vector>
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <vector>
 
 using namespace ipc_demo;
 
@@ -205,3 +207,152 @@ TEST_F(ByteBufferTest, NegativeNumbers) {
     EXPECT_DOUBLE_EQ(buf.GetDouble(), -123.456);
     EXPECT_DOUBLE_EQ(buf.GetDouble(), -1e-10);
 }
+
+TEST_F(ByteBufferTest, IntegersAreBigEndian) {
+    ByteBuffer buf(buffer_.data(), buffer_.size());
+    
+    buf.PutShort(0x0102);
+    buf.PutInt(0x03040506);
+    buf.PutLong(0x0708090A0B0C0D0ELL);
+    
+    const uint8_t expected[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+    ASSERT_EQ(sizeof(expected), buf.Position());
+    EXPECT_EQ(0, std::memcmp(expected, buffer_.data(), sizeof(expected)));
+    
+    buf.Reset();
+    EXPECT_EQ(buf.GetShort(), 0x0102);
+    EXPECT_EQ(buf.GetInt(), 0x03040506u);
+    EXPECT_EQ(buf.GetLong(), 0x0708090A0B0C0D0ELL);
+}
+
+TEST_F(ByteBufferTest, BulkMatchesElementWise) {
+    // Odd counts and an unaligned start exercise the vector and scalar paths
+    std::vector<uint32_t> ints(37);
+    std::vector<int64_t> longs(19);
+    std::vector<double> doubles(23);
+    for (size_t i = 0; i < ints.size(); ++i) ints[i] = static_cast<uint32_t>(0x01020304u * (i + 1));
+    for (size_t i = 0; i < longs.size(); ++i) longs[i] = -static_cast<int64_t>(0x0102030405060708LL * (i + 1));
+    for (size_t i = 0; i < doubles.size(); ++i) doubles[i] = 0.5 * static_cast<double>(i) - 3.0;
+    
+    std::vector<uint8_t> expected(1024);
+    ByteBuffer single(expected.data(), expected.size());
+    single.PutByte(0xAA);
+    for (uint32_t v : ints) single.PutInt(v);
+    for (int64_t v : longs) single.PutLong(v);
+    for (double v : doubles) single.PutDouble(v);
+    
+    ByteBuffer bulk(buffer_.data(), buffer_.size());
+    bulk.PutByte(0xAA);
+    bulk.PutInts(ints.data(), ints.size());
+    bulk.PutLongs(longs.data(), longs.size());
+    bulk.PutDoubles(doubles.data(), doubles.size());
+    bulk.PutInts(nullptr, 0);
+    ASSERT_EQ(single.Position(), bulk.Position());
+    EXPECT_EQ(0, std::memcmp(expected.data(), buffer_.data(), bulk.Position()));
+    
+    bulk.Reset();
+    bulk.GetByte();
+    std::vector<uint32_t> ints_out(ints.size());
+    std::vector<int64_t> longs_out(longs.size());
+    std::vector<double> doubles_out(doubles.size());
+    bulk.GetInts(ints_out.data(), ints_out.size());
+    bulk.GetLongs(longs_out.data(), longs_out.size());
+    bulk.GetDoubles(doubles_out.data(), doubles_out.size());
+    EXPECT_EQ(ints, ints_out);
+    EXPECT_EQ(longs, longs_out);
+    EXPECT_EQ(doubles, doubles_out);
+    
+    EXPECT_THROW(bulk.GetInts(ints_out.data(), buffer_.size()), std::underflow_error);
+}
+
+TEST_F(ByteBufferTest, StringViewAndReserve) {
+    ByteBuffer buf(buffer_.data(), buffer_.size());
+    buf.PutString("view");
+    buf.PutString("");
+    
+    uint8_t* out = buf.Reserve(6);
+    byte_order::StoreBigEndian<uint16_t>(out, 0xBEEF);
+    byte_order::StoreBigEndian<uint32_t>(out + 2, 0xCAFEBABE);
+    
+    buf.Reset();
+    std::string_view view = buf.GetStringView();
+    EXPECT_EQ("view", view);
+    EXPECT_EQ(reinterpret_cast<const char*>(buffer_.data() + 4), view.data());
+    EXPECT_TRUE(buf.GetStringView().empty());
+    EXPECT_EQ(buf.GetShort(), 0xBEEF);
+    EXPECT_EQ(buf.GetInt(), 0xCAFEBABEu);
+    
+    EXPECT_THROW(buf.Reserve(buffer_.size()), std::overflow_error);
+    EXPECT_EQ(buffer_.size() - buf.Position(), buf.Remaining());
+}
+
+TEST_F(ByteBufferTest, StringOverflowWritesNothing) {
+    std::vector<uint8_t> small_buffer(10);
+    ByteBuffer buf(small_buffer.data(), small_buffer.size());
+    
+    EXPECT_THROW(buf.PutString("longer than ten"), std::overflow_error);
+    EXPECT_EQ(0u, buf.Position());
+}
+
+TEST_F(ByteBufferTest, MapViewReadsInPlace) {
+    ByteBuffer buf(buffer_.data(), buffer_.size());
+    buf.PutInt(3);
+    for (const char* text : {"key", "first", "other", "", "key", "last"}) {
+        buf.PutString(text);
+    }
+    buf.PutByte(0x5A);
+    
+    buf.Reset();
+    MapView view = buf.GetMapView();
+    EXPECT_EQ(buf.GetByte(), 0x5A);
+    ASSERT_EQ(3u, view.size());
+    
+    std::vector<std::pair<std::string, std::string>> entries;
+    for (const auto& [key, value] : view) {
+        entries.emplace_back(key, value);
+    }
+    std::vector<std::pair<std::string, std::string>> expected = {{"key", "first"}, {"other", ""}, {"key", "last"}};
+    EXPECT_EQ(expected, entries);
+    
+    // Last duplicate wins, as in GetMap()
+    EXPECT_EQ("last", view.Find("key").value());
+    EXPECT_EQ("", view.Find("other").value());
+    EXPECT_FALSE(view.Find("missing").has_value());
+    const char* begin = reinterpret_cast<const char*>(buffer_.data());
+    EXPECT_GE(view.Find("key")->data(), begin);
+    EXPECT_LT(view.Find("key")->data(), begin + buffer_.size());
+    
+    buf.Reset();
+    auto map = buf.GetMap();
+    EXPECT_EQ(2u, map.size());
+    EXPECT_EQ("last", map["key"]);
+}
+
+TEST_F(ByteBufferTest, MapViewRejectsTruncatedEntries) {
+    std::vector<uint8_t> small(16);
+    ByteBuffer buf(small.data(), small.size());
+    buf.PutInt(1000000); // Count far beyond the buffer
+    buf.PutString("k");
+    buf.PutString("v");
+    
+    buf.Reset();
+    EXPECT_THROW(buf.GetMapView(), std::underflow_error);
+    buf.Reset();
+    EXPECT_THROW(buf.GetMap(), std::underflow_error);
+}
+
+TEST_F(ByteBufferTest, ArraySpanReadsInPlace) {
+    const uint8_t payload[] = {1, 2, 3, 4, 5};
+    ByteBuffer buf(buffer_.data(), buffer_.size());
+    buf.PutArray(payload, sizeof(payload));
+    buf.PutArray(nullptr, 0);
+    buf.PutInt(static_cast<uint32_t>(buffer_.size())); // Longer than what is left
+    
+    buf.Reset();
+    ByteSpan span = buf.GetArraySpan();
+    ASSERT_EQ(sizeof(payload), span.size);
+    EXPECT_EQ(buffer_.data() + 4, span.data);
+    EXPECT_TRUE(std::equal(span.begin(), span.end(), payload));
+    EXPECT_TRUE(buf.GetArraySpan().empty());
+    EXPECT_THROW(buf.GetArraySpan(), std::underflow_error);
+}
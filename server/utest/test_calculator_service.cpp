@@ -52,6 +52,10 @@ TEST_F(CalculatorServiceTest, RoutineIds) {
     EXPECT_EQ(service_->GetName(), "CalculatorService");
 }
 
+TEST_F(CalculatorServiceTest, IsInlineSafe) {
+    EXPECT_TRUE(service_->IsInlineSafe());
+}
+
 TEST_F(CalculatorServiceTest, Addition) {
     size_t req_len = BuildRequest(0x01, 10.5, 5.3);
     
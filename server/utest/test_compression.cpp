@@ -0,0 +1,326 @@
+/**
+ * @file test_compression.cpp
+ * @brief Unit tests for the LZ4 codec and per-connection payload compression
+ */
+
+#include "ServerFixture.hpp"
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/Compression.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Key/value text shaped like the payloads a dictionary is meant for
+std::string MapPayload(int entries) {
+    std::string text;
+    for (int i = 0; i < entries; ++i) {
+        text += "{\"sensor_id\":" + std::to_string(1000 + i) + ",\"temperature_celsius\":" +
+                std::to_string(20 + i % 7) + ",\"humidity_percent\":" + std::to_string(40 + i % 13) + "}";
+    }
+    return text;
+}
+
+std::vector<uint8_t> RandomBytes(size_t len, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(len);
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+const uint8_t* Bytes(const std::string& text) {
+    return reinterpret_cast<const uint8_t*>(text.data());
+}
+
+// Echoes its input back as the response payload (from the worker pool,
+// which must get its own copy of an inflated request)
+class EchoService : public IService {
+public:
+    static constexpr uint32_t REQUEST_ID = 0x3200;
+    static constexpr uint32_t RESPONSE_ID = 0x3201;
+
+    uint32_t GetRequestRoutineId() const override { return REQUEST_ID; }
+    uint32_t GetResponseRoutineId() const override { return RESPONSE_ID; }
+    std::string GetName() const override { return "EchoService"; }
+
+    size_t Execute(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len) override {
+        ResponseBuilder response(RESPONSE_ID, output, output_len);
+        if (input_len > response.PayloadCapacity()) {
+            return 0;
+        }
+        std::memcpy(response.Payload(), input, input_len);
+        return response.Finish(input_len);
+    }
+};
+
+} // namespace
+
+TEST(CompressionCodecTest, RoundTripsRepetitiveData) {
+    std::string text = MapPayload(40);
+    std::vector<uint8_t> block(lz4::CompressBound(text.size()));
+    size_t block_len = lz4::Compress(Bytes(text), text.size(), block.data(), block.size());
+    ASSERT_GT(block_len, 0u);
+    EXPECT_LT(block_len, text.size() / 3);
+
+    std::vector<uint8_t> out(text.size());
+    ASSERT_TRUE(lz4::Decompress(block.data(), block_len, out.data(), out.size()));
+    EXPECT_EQ(0, std::memcmp(out.data(), text.data(), text.size()));
+
+    // The exact output size is part of the contract
+    EXPECT_FALSE(lz4::Decompress(block.data(), block_len, out.data(), out.size() - 1));
+}
+
+TEST(CompressionCodecTest, RoundTripsRandomAndTinyInputs) {
+    for (size_t len : {size_t(0), size_t(1), size_t(12), size_t(13), size_t(300), size_t(5000)}) {
+        std::vector<uint8_t> input = RandomBytes(len, static_cast<unsigned>(len));
+        std::vector<uint8_t> block(lz4::CompressBound(len));
+        size_t block_len = lz4::Compress(input.data(), len, block.data(), block.size());
+        ASSERT_GT(block_len, 0u) << len;
+
+        std::vector<uint8_t> out(len);
+        ASSERT_TRUE(lz4::Decompress(block.data(), block_len, out.data(), len)) << len;
+        EXPECT_EQ(out, input) << len;
+    }
+}
+
+TEST(CompressionCodecTest, IncompressiblePayloadIsLeftAlone) {
+    std::vector<uint8_t> input = RandomBytes(1024, 7);
+    std::vector<uint8_t> out(2048);
+    EXPECT_EQ(CompressPayload(input.data(), input.size(), out.data(), out.size(), nullptr), 0u);
+
+    // Too small to ever win
+    EXPECT_EQ(CompressPayload(input.data(), 5, out.data(), out.size(), nullptr), 0u);
+}
+
+TEST(CompressionCodecTest, DictionaryShrinksShortPayloads) {
+    CompressionDictionary dictionary(MapPayload(8));
+    std::string text = MapPayload(2);
+
+    std::vector<uint8_t> plain(text.size());
+    std::vector<uint8_t> with_dictionary(text.size());
+    size_t plain_len = CompressPayload(Bytes(text), text.size(), plain.data(), plain.size(), nullptr);
+    size_t dictionary_len = CompressPayload(Bytes(text), text.size(), with_dictionary.data(),
+                                            with_dictionary.size(), &dictionary);
+    ASSERT_GT(dictionary_len, 0u);
+    EXPECT_TRUE(plain_len == 0 || dictionary_len < plain_len / 2);
+
+    std::vector<uint8_t> out(text.size());
+    ASSERT_EQ(DecompressPayload(with_dictionary.data(), dictionary_len, out.data(), out.size(), &dictionary),
+              text.size());
+    EXPECT_EQ(0, std::memcmp(out.data(), text.data(), text.size()));
+
+    // Without the dictionary the back-references point nowhere
+    EXPECT_EQ(DecompressPayload(with_dictionary.data(), dictionary_len, out.data(), out.size(), nullptr), 0u);
+}
+
+TEST(CompressionCodecTest, DictionaryIdFollowsContent) {
+    CompressionDictionary a("sensor_id temperature_celsius");
+    CompressionDictionary b("sensor_id temperature_celsius");
+    CompressionDictionary c("sensor_id humidity_percent");
+    EXPECT_NE(a.Id(), 0u);
+    EXPECT_EQ(a.Id(), b.Id());
+    EXPECT_NE(a.Id(), c.Id());
+
+    EXPECT_THROW(CompressionDictionary(""), std::invalid_argument);
+
+    std::string large(CompressionDictionary::MAX_SIZE + 100, 'x');
+    EXPECT_EQ(CompressionDictionary(large).Size(), CompressionDictionary::MAX_SIZE);
+}
+
+TEST(CompressionCodecTest, CorruptInputIsRejected) {
+    std::string text = MapPayload(20);
+    std::vector<uint8_t> encoded(text.size());
+    size_t encoded_len = CompressPayload(Bytes(text), text.size(), encoded.data(), encoded.size(), nullptr);
+    ASSERT_GT(encoded_len, 0u);
+
+    std::vector<uint8_t> out(text.size());
+    EXPECT_EQ(DecompressPayload(encoded.data(), encoded_len - 3, out.data(), out.size(), nullptr), 0u);
+    EXPECT_EQ(DecompressPayload(encoded.data(), encoded_len, out.data(), out.size() - 1, nullptr), 0u);
+    EXPECT_EQ(DecompressPayload(encoded.data(), 2, out.data(), out.size(), nullptr), 0u);
+
+    // A match reaching back before the start of the output
+    const uint8_t bad_offset[] = {0x10, 'a', 0x05, 0x00, 0x00};
+    uint8_t small[16];
+    EXPECT_FALSE(lz4::Decompress(bad_offset, sizeof(bad_offset), small, 5));
+
+    // Random garbage must fail cleanly, never write past the output
+    for (unsigned seed = 0; seed < 200; ++seed) {
+        std::vector<uint8_t> garbage = RandomBytes(64, seed);
+        std::vector<uint8_t> guarded(40, 0xEE);
+        lz4::Decompress(garbage.data(), garbage.size(), guarded.data(), 32);
+        for (size_t i = 32; i < guarded.size(); ++i) {
+            ASSERT_EQ(guarded[i], 0xEE);
+        }
+    }
+}
+
+class CompressionTest : public ServerFixture {
+protected:
+    std::shared_ptr<const CompressionDictionary> dictionary_ =
+        std::make_shared<const CompressionDictionary>(MapPayload(8));
+
+    CompressionTest() : ServerFixture("compression") {}
+
+    void SetUp() override {
+        manager_->RegisterService(std::make_shared<EchoService>());
+    }
+
+    ChannelOptions Options(bool pipelining) const {
+        ChannelOptions options;
+        options.timeout_ms = 1000;
+        options.pipelining = pipelining;
+        options.compression = true;
+        options.compression_threshold = 64;
+        return options;
+    }
+
+    // Echo text through the channel and check it comes back unchanged
+    static void ExpectEcho(Channel& channel, const std::string& text) {
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        ASSERT_TRUE(channel.ExecuteRPC(EchoService::REQUEST_ID, Bytes(text), text.size(),
+                                       response, sizeof(response), response_len))
+            << channel.GetLastError();
+        ASSERT_EQ(response_len, Protocol::GetMinFrameSize() + text.size());
+        EXPECT_EQ(response[9] & Protocol::FLAG_COMPRESSED, 0);
+        EXPECT_EQ(0, std::memcmp(response + 10, text.data(), text.size()));
+    }
+
+    // Negotiate on a raw socket and return the granted status
+    static uint8_t Negotiate(int fd, FrameParser& parser, uint32_t dictionary_id) {
+        uint8_t payload[Protocol::COMPRESSION_NEGOTIATE_PAYLOAD_SIZE];
+        ByteBuffer buf(payload, sizeof(payload));
+        buf.PutInt(dictionary_id);
+        EXPECT_TRUE(SendFrame(fd, BuildFrame(Protocol::COMPRESSION_NEGOTIATE_REQUEST_ROUTINE_ID,
+                                             payload, sizeof(payload))));
+
+        std::vector<uint8_t> response = ReadFrame(fd, parser);
+        EXPECT_EQ(response.size(), Protocol::GetMinFrameSize() + Protocol::COMPRESSION_NEGOTIATE_RESPONSE_SIZE);
+        return response.size() > 10 ? response[10] : 0xFF;
+    }
+};
+
+TEST_F(CompressionTest, ChannelRoundTripsCompressedPayloads) {
+    ServerConfig config;
+    config.compression_threshold = 64;
+    StartServer(config);
+
+    Channel channel(socket_path_, Options(false));
+    ExpectEcho(channel, MapPayload(40));       // Compressed both ways
+    ExpectEcho(channel, "short");              // Below the threshold
+    std::vector<uint8_t> random = RandomBytes(2000, 3);
+    ExpectEcho(channel, std::string(random.begin(), random.end())); // Sent as is
+
+    // Compressed well below the frame limit, so inline despite its size
+    ExpectEcho(channel, MapPayload(70));
+}
+
+TEST_F(CompressionTest, PipelinedChannelWithDictionary) {
+    ServerConfig config;
+    config.compression_threshold = 64;
+    config.compression_dictionary = dictionary_;
+    StartServer(config);
+
+    ChannelOptions options = Options(true);
+    options.compression_dictionary = dictionary_;
+    Channel channel(socket_path_, options);
+    for (int i = 1; i <= 20; ++i) {
+        ExpectEcho(channel, MapPayload(i));
+    }
+}
+
+TEST_F(CompressionTest, ResponsesCarryTheFlagOnlyAfterNegotiation) {
+    ServerConfig config;
+    config.compression_threshold = 64;
+    StartServer(config);
+    std::string text = MapPayload(20);
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    FrameParser parser;
+
+    // Before negotiating: plain, and a compressed request is refused
+    std::vector<uint8_t> plain = BuildFrame(EchoService::REQUEST_ID, Bytes(text), text.size());
+    ASSERT_TRUE(SendFrame(fd, plain));
+    std::vector<uint8_t> response = ReadFrame(fd, parser);
+    ASSERT_EQ(response.size(), plain.size());
+    EXPECT_EQ(response[9] & Protocol::FLAG_COMPRESSED, 0);
+
+    ASSERT_EQ(Negotiate(fd, parser, 0), Protocol::COMPRESSION_LZ4);
+
+    // A compressed request, answered compressed
+    std::vector<uint8_t> encoded(text.size());
+    size_t encoded_len = CompressPayload(Bytes(text), text.size(), encoded.data(), encoded.size(), nullptr);
+    ASSERT_GT(encoded_len, 0u);
+    std::vector<uint8_t> compressed = BuildFrame(EchoService::REQUEST_ID, encoded.data(), encoded_len,
+                                                 Protocol::FLAG_COMPRESSED);
+    ASSERT_TRUE(SendFrame(fd, compressed));
+    response = ReadFrame(fd, parser);
+    ASSERT_GT(response.size(), Protocol::GetMinFrameSize());
+    EXPECT_LT(response.size(), plain.size());
+    ASSERT_NE(response[9] & Protocol::FLAG_COMPRESSED, 0);
+
+    std::vector<uint8_t> out(text.size());
+    ASSERT_EQ(DecompressPayload(response.data() + 10, response.size() - Protocol::GetMinFrameSize(),
+                                out.data(), out.size(), nullptr), text.size());
+    EXPECT_EQ(0, std::memcmp(out.data(), text.data(), text.size()));
+
+    // A corrupt compressed payload gets no answer; the connection lives on
+    std::vector<uint8_t> corrupt = compressed;
+    corrupt[14] ^= 0xFF;
+    ASSERT_TRUE(SendFrame(fd, corrupt));
+    std::string small = "ping";
+    std::vector<uint8_t> ping = BuildFrame(EchoService::REQUEST_ID, Bytes(small), small.size());
+    ASSERT_TRUE(SendFrame(fd, ping));
+    response = ReadFrame(fd, parser);
+    EXPECT_EQ(response.size(), ping.size());
+
+    close(fd);
+}
+
+TEST_F(CompressionTest, MismatchedDictionaryFallsBackToPlainLz4) {
+    ServerConfig config;
+    config.compression_dictionary = dictionary_;
+    StartServer(config);
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    FrameParser parser;
+    EXPECT_EQ(Negotiate(fd, parser, dictionary_->Id() + 1), Protocol::COMPRESSION_LZ4);
+    EXPECT_EQ(Negotiate(fd, parser, dictionary_->Id()), Protocol::COMPRESSION_LZ4_DICTIONARY);
+    close(fd);
+
+    // A channel with another dictionary still works, without one
+    ChannelOptions options = Options(false);
+    options.compression_dictionary = std::make_shared<const CompressionDictionary>("unrelated content");
+    Channel channel(socket_path_, options);
+    ExpectEcho(channel, MapPayload(30));
+}
+
+TEST_F(CompressionTest, DisabledServerRefuses) {
+    ServerConfig config;
+    config.enable_compression = false;
+    StartServer(config);
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    FrameParser parser;
+    EXPECT_EQ(Negotiate(fd, parser, 0), Protocol::COMPRESSION_REFUSED);
+    close(fd);
+
+    Channel channel(socket_path_, Options(false));
+    ExpectEcho(channel, MapPayload(30));
+}
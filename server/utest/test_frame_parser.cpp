@@ -0,0 +1,266 @@
+/**
+ * @file test_frame_parser.cpp
+ * @brief Unit tests for RingBuffer and FrameParser stream reassembly
+ */
+
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/RingBuffer.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+std::vector<uint8_t> BuildFrame(uint32_t routine_id, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame(Protocol::GetMinFrameSize() + payload.size());
+    ByteBuffer buf(frame.data(), frame.size());
+    buf.PutByte(Protocol::START_BYTE);
+    buf.PutInt(static_cast<uint32_t>(frame.size()));
+    buf.PutInt(routine_id);
+    buf.PutByte(Protocol::VERSION);
+    for (uint8_t b : payload) {
+        buf.PutByte(b);
+    }
+    buf.PutByte(Protocol::END_BYTE);
+    return frame;
+}
+
+void Feed(FrameParser& parser, const uint8_t* data, size_t len) {
+    ASSERT_TRUE(parser.Buffer().Write(data, len));
+}
+
+} // namespace
+
+// ============================================================================
+// RingBuffer
+// ============================================================================
+
+TEST(RingBufferTest, CapacityRoundsUpToPowerOfTwo) {
+    RingBuffer ring(100);
+    EXPECT_EQ(ring.Capacity(), 128u);
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_THROW(RingBuffer(0), std::invalid_argument);
+}
+
+TEST(RingBufferTest, WritePeekConsume) {
+    RingBuffer ring(16);
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    ASSERT_TRUE(ring.Write(data, sizeof(data)));
+    EXPECT_EQ(ring.Size(), 5u);
+
+    uint8_t out[3];
+    ASSERT_TRUE(ring.Peek(1, out, sizeof(out)));
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[2], 4);
+    EXPECT_FALSE(ring.Peek(3, out, sizeof(out)));
+
+    ring.Consume(5);
+    EXPECT_TRUE(ring.Empty());
+}
+
+TEST(RingBufferTest, RejectsOverflow) {
+    RingBuffer ring(8);
+    uint8_t data[9] = {};
+    EXPECT_FALSE(ring.Write(data, sizeof(data)));
+    EXPECT_TRUE(ring.Write(data, 8));
+    EXPECT_EQ(ring.FreeSpace(), 0u);
+}
+
+TEST(RingBufferTest, WrapAround) {
+    RingBuffer ring(8);
+    const uint8_t first[] = {1, 2, 3, 4, 5, 6};
+    ASSERT_TRUE(ring.Write(first, sizeof(first)));
+    ring.Consume(4);
+
+    const uint8_t second[] = {7, 8, 9, 10};
+    ASSERT_TRUE(ring.Write(second, sizeof(second))); // Wraps
+
+    EXPECT_EQ(ring.ReadPtr(6), nullptr); // Not contiguous
+    uint8_t out[6];
+    ASSERT_TRUE(ring.Peek(0, out, sizeof(out)));
+    const uint8_t expected[] = {5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(0, memcmp(out, expected, sizeof(expected)));
+}
+
+TEST(RingBufferTest, WritePtrCommit) {
+    RingBuffer ring(8);
+    size_t space = 0;
+    uint8_t* dst = ring.WritePtr(space);
+    ASSERT_EQ(space, 8u);
+    dst[0] = 0xAB;
+    ring.CommitWrite(1);
+
+    const uint8_t* src = ring.ReadPtr(1);
+    ASSERT_NE(src, nullptr);
+    EXPECT_EQ(src[0], 0xAB);
+}
+
+TEST(RingBufferTest, WriteRegionsCoverWrappedFreeSpace) {
+    RingBuffer ring(8);
+    const uint8_t filler[6] = {};
+    ASSERT_TRUE(ring.Write(filler, sizeof(filler)));
+    ring.Consume(4); // Free space: 2 bytes at the end, 4 at the start
+
+    size_t first_len = 0;
+    size_t second_len = 0;
+    uint8_t* second = nullptr;
+    uint8_t* first = ring.WriteRegions(first_len, second, second_len);
+    ASSERT_EQ(first_len, 2u);
+    ASSERT_EQ(second_len, 4u);
+
+    const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+    memcpy(first, data, first_len);
+    memcpy(second, data + first_len, second_len);
+    ring.CommitWrite(first_len + second_len);
+
+    uint8_t out[8];
+    ASSERT_EQ(ring.Size(), 8u);
+    ASSERT_TRUE(ring.Peek(2, out, sizeof(data)));
+    EXPECT_EQ(0, memcmp(out, data, sizeof(data)));
+}
+
+TEST(RingBufferTest, WriteRegionsWithoutWrap) {
+    RingBuffer ring(8);
+    size_t first_len = 0;
+    size_t second_len = 0;
+    uint8_t* second = nullptr;
+    ring.WriteRegions(first_len, second, second_len);
+    EXPECT_EQ(first_len, 8u);
+    EXPECT_EQ(second_len, 0u);
+}
+
+// ============================================================================
+// FrameParser
+// ============================================================================
+
+TEST(FrameParserTest, EmptyNeedsMore) {
+    FrameParser parser;
+    FrameView frame;
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::NeedMore);
+}
+
+TEST(FrameParserTest, SingleFrame) {
+    FrameParser parser;
+    auto bytes = BuildFrame(0x1000, {0x01, 0x02});
+    Feed(parser, bytes.data(), bytes.size());
+
+    FrameView frame;
+    ASSERT_EQ(parser.Next(frame), FrameParser::Result::Frame);
+    EXPECT_EQ(frame.routine_id, 0x1000u);
+    EXPECT_EQ(frame.version, Protocol::VERSION);
+    EXPECT_EQ(frame.length, bytes.size());
+    ASSERT_EQ(frame.payload_len, 2u);
+    EXPECT_EQ(frame.payload[0], 0x01);
+    EXPECT_EQ(frame.payload[1], 0x02);
+
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::NeedMore);
+    EXPECT_FALSE(parser.HasPartialFrame());
+}
+
+TEST(FrameParserTest, CoalescedFramesInOneRead) {
+    FrameParser parser;
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 5; ++i) {
+        auto bytes = BuildFrame(0x1000 + i, {i});
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+    Feed(parser, stream.data(), stream.size());
+
+    FrameView frame;
+    for (uint8_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(parser.Next(frame), FrameParser::Result::Frame);
+        EXPECT_EQ(frame.routine_id, 0x1000u + i);
+        EXPECT_EQ(frame.payload[0], i);
+    }
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::NeedMore);
+}
+
+TEST(FrameParserTest, FrameSplitAcrossReads) {
+    FrameParser parser;
+    auto bytes = BuildFrame(0x2000, {0xAA, 0xBB, 0xCC});
+
+    FrameView frame;
+    for (size_t i = 0; i + 1 < bytes.size(); ++i) {
+        Feed(parser, &bytes[i], 1);
+        EXPECT_EQ(parser.Next(frame), FrameParser::Result::NeedMore) << "byte " << i;
+        EXPECT_TRUE(parser.HasPartialFrame());
+    }
+
+    Feed(parser, &bytes.back(), 1);
+    ASSERT_EQ(parser.Next(frame), FrameParser::Result::Frame);
+    EXPECT_EQ(frame.routine_id, 0x2000u);
+    EXPECT_EQ(frame.payload[2], 0xCC);
+}
+
+TEST(FrameParserTest, FrameWrappingTheRingIsLinearized) {
+    FrameParser parser(64); // 128 byte ring
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 20; ++i) {
+        auto bytes = BuildFrame(0x3000 + i, std::vector<uint8_t>(40, i)); // 51 bytes
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    // Odd chunk size keeps a partial frame buffered, so frames straddle the ring end
+    constexpr size_t CHUNK = 37;
+    FrameView frame;
+    uint8_t expected = 0;
+    for (size_t pos = 0; pos < stream.size(); pos += CHUNK) {
+        size_t len = std::min(CHUNK, stream.size() - pos);
+        Feed(parser, stream.data() + pos, len);
+
+        FrameParser::Result result;
+        while ((result = parser.Next(frame)) == FrameParser::Result::Frame) {
+            EXPECT_EQ(frame.routine_id, 0x3000u + expected);
+            ASSERT_EQ(frame.payload_len, 40u);
+            EXPECT_EQ(frame.payload[0], expected);
+            EXPECT_EQ(frame.payload[39], expected);
+            EXPECT_EQ(frame.data[frame.length - 1], Protocol::END_BYTE);
+            ++expected;
+        }
+        ASSERT_EQ(result, FrameParser::Result::NeedMore);
+    }
+    EXPECT_EQ(expected, 20);
+}
+
+TEST(FrameParserTest, InvalidStartByte) {
+    FrameParser parser;
+    auto bytes = BuildFrame(0x1000, {0x01});
+    bytes[0] = 0x00;
+    Feed(parser, bytes.data(), bytes.size());
+
+    FrameView frame;
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::Error);
+    EXPECT_FALSE(parser.GetError().empty());
+
+    // Error is sticky until Reset
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::Error);
+    parser.Reset();
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::NeedMore);
+}
+
+TEST(FrameParserTest, OversizedLength) {
+    FrameParser parser;
+    auto bytes = BuildFrame(0x1000, {0x01});
+    ByteBuffer buf(bytes.data(), bytes.size());
+    buf.SetPosition(1);
+    buf.PutInt(static_cast<uint32_t>(Protocol::MAX_PACKET_SIZE + 1));
+    Feed(parser, bytes.data(), bytes.size());
+
+    FrameView frame;
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::Error);
+}
+
+TEST(FrameParserTest, MissingEndByte) {
+    FrameParser parser;
+    auto bytes = BuildFrame(0x1000, {0x01});
+    bytes.back() = 0x00;
+    Feed(parser, bytes.data(), bytes.size());
+
+    FrameView frame;
+    EXPECT_EQ(parser.Next(frame), FrameParser::Result::Error);
+}
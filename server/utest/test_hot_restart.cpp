@@ -0,0 +1,411 @@
+/**
+ * @file test_hot_restart.cpp
+ * @brief In-process tests for hot restart: two servers on one socket path
+ */
+
+#include "ServerFixture.hpp"
+#include "HotRestart.hpp"
+#include "ServiceManager.hpp"
+#include "CalculatorService.hpp"
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/CalculatorClient.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/IoUring.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+constexpr uint32_t TAG_ROUTINE = 0x3400;
+
+// Answers with the tag of the server it runs in, after sleeping
+// (request byte x 10) ms
+class TagService : public IService {
+public:
+    explicit TagService(uint8_t tag) : tag_(tag) {}
+
+    uint32_t GetRequestRoutineId() const override { return TAG_ROUTINE; }
+    uint32_t GetResponseRoutineId() const override { return TAG_ROUTINE + 1; }
+    std::string GetName() const override { return "TagService"; }
+
+    size_t Execute(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len) override {
+        if (input_len > 0 && input[0] > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(input[0] * 10));
+        }
+        ResponseBuilder response(GetResponseRoutineId(), output, output_len);
+        ByteBuffer payload(response.Payload(), response.PayloadCapacity());
+        payload.PutByte(tag_);
+        return response.Finish(payload.Position());
+    }
+
+private:
+    uint8_t tag_;
+};
+
+std::vector<uint8_t> BuildTagFrame(uint8_t delay) {
+    return ServerFixture::BuildFrame(TAG_ROUTINE, &delay, 1);
+}
+
+// Tag of the server answering on fd, or -1
+int ReadTag(int fd) {
+    FrameParser parser;
+    FrameView frame;
+    if (!ServerFixture::NextFrame(fd, parser, frame, 2000)) {
+        return -1;
+    }
+    return frame.payload_len == 1 ? frame.payload[0] : -1;
+}
+
+bool SendTag(int fd, uint8_t delay = 0) {
+    return ServerFixture::SendFrame(fd, BuildTagFrame(delay));
+}
+
+int CallTag(int fd) {
+    return SendTag(fd) ? ReadTag(fd) : -1;
+}
+
+} // namespace
+
+class HotRestartTest : public ServerFixture {
+protected:
+    HotRestartTest() : ServerFixture("hot_restart") {}
+
+    std::string handoff_path_ = "/tmp/test_ipc_hot_restart_" + std::to_string(getpid()) + ".ctl";
+    std::unique_ptr<UDSServer> old_server_;
+    std::unique_ptr<UDSServer> new_server_;
+    std::vector<int> raw_fds_;
+
+    void TearDown() override {
+        for (int fd : raw_fds_) {
+            close(fd);
+        }
+        if (new_server_) {
+            new_server_->Stop();
+        }
+        if (old_server_) {
+            old_server_->Stop();
+        }
+        unlink(handoff_path_.c_str());
+        ServerFixture::TearDown();
+    }
+
+    ServerConfig HandoffConfig() const {
+        ServerConfig config;
+        config.handoff_path = handoff_path_;
+        return config;
+    }
+
+    // Each server gets its own services, so a tag tells them apart
+    std::unique_ptr<UDSServer> StartTagServer(uint8_t tag, const ServerConfig& config) {
+        auto manager = std::make_shared<ServiceManager>();
+        manager->RegisterService(std::make_shared<CalculatorService>());
+        manager->RegisterService(std::make_shared<TagService>(tag));
+        auto server = LaunchServer(manager, config);
+        // Serving once the control socket is up (after the takeover, if any)
+        EXPECT_TRUE(WaitUntil([this]() { return access(handoff_path_.c_str(), F_OK) == 0; }));
+        return server;
+    }
+
+    // Plain blocking socket, so the test sees whether the connection survives
+    int ConnectRaw() {
+        int fd = ServerFixture::ConnectRaw();
+        if (fd >= 0) {
+            raw_fds_.push_back(fd);
+        }
+        return fd;
+    }
+
+    // Control-socket connection that never sends a takeover request
+    int ConnectSilentSuccessor() {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, handoff_path_.c_str(), sizeof(addr.sun_path) - 1);
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        raw_fds_.push_back(fd);
+        return fd;
+    }
+
+    // Clients are still accepted meanwhile, and a real successor follows
+    void ExpectSilentSuccessorIgnored(IoBackend backend) {
+        ServerConfig config = HandoffConfig();
+        config.io_backend = backend;
+        old_server_ = StartTagServer(1, config);
+
+        int silent = ConnectSilentSuccessor();
+        ASSERT_GE(silent, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Accepted by now
+
+        auto start = std::chrono::steady_clock::now();
+        int fd = ConnectRaw();
+        ASSERT_GE(fd, 0);
+        EXPECT_EQ(CallTag(fd), 1);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+        // Hung up on once IO_TIMEOUT_MS has passed
+        struct pollfd pfd{silent, POLLIN, 0};
+        ASSERT_EQ(poll(&pfd, 1, hot_restart::IO_TIMEOUT_MS + 2000), 1);
+        uint8_t byte = 0;
+        EXPECT_EQ(recv(silent, &byte, 1, 0), 0);
+
+        new_server_ = StartTagServer(2, config);
+        ExpectHandedOff();
+        int fresh = ConnectRaw();
+        ASSERT_GE(fresh, 0);
+        EXPECT_EQ(CallTag(fresh), 2);
+    }
+
+    void ExpectHandedOff() {
+        ASSERT_TRUE(WaitUntil([this]() { return !old_server_->IsRunning(); }));
+        EXPECT_TRUE(old_server_->HasHandedOff());
+        EXPECT_FALSE(new_server_->HasHandedOff());
+    }
+};
+
+TEST_F(HotRestartTest, IdleConnectionsMoveToTheSuccessor) {
+    ServerConfig config = HandoffConfig();
+    config.num_reactors = 2;
+    old_server_ = StartTagServer(1, config);
+
+    std::vector<int> fds;
+    for (int i = 0; i < 6; ++i) {
+        int fd = ConnectRaw();
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(CallTag(fd), 1);
+        fds.push_back(fd);
+    }
+
+    new_server_ = StartTagServer(2, config);
+    ExpectHandedOff();
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), fds.size());
+    EXPECT_EQ(new_server_->GetClientCount(), fds.size());
+
+    // Same sockets, now answered by the new server
+    for (int fd : fds) {
+        EXPECT_EQ(CallTag(fd), 2);
+    }
+    int fresh = ConnectRaw();
+    ASSERT_GE(fresh, 0);
+    EXPECT_EQ(CallTag(fresh), 2);
+
+    // The socket file is the new server's: it stays when the old one is gone
+    old_server_->Stop();
+    EXPECT_EQ(access(socket_path_.c_str(), F_OK), 0);
+    new_server_->Stop();
+    EXPECT_NE(access(socket_path_.c_str(), F_OK), 0);
+    EXPECT_NE(access(handoff_path_.c_str(), F_OK), 0);
+}
+
+TEST_F(HotRestartTest, InFlightRequestFinishesBeforeItsConnectionMoves) {
+    old_server_ = StartTagServer(1, HandoffConfig());
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    ASSERT_TRUE(SendTag(fd, 20)); // 200 ms
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    new_server_ = StartTagServer(2, HandoffConfig());
+    EXPECT_EQ(ReadTag(fd), 1);
+    ExpectHandedOff();
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), 1u);
+    EXPECT_EQ(CallTag(fd), 2);
+}
+
+TEST_F(HotRestartTest, BusyConnectionsCloseAfterTheDrainTimeout) {
+    ServerConfig config = HandoffConfig();
+    config.handoff_drain_timeout_ms = 50;
+    config.execution_mode = ExecutionMode::ThreadPool; // The reactor stays free meanwhile
+    config.worker_threads = 1;
+    old_server_ = StartTagServer(1, config);
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    ASSERT_TRUE(SendTag(fd, 50)); // 500 ms
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    new_server_ = StartTagServer(2, config);
+    ExpectHandedOff();
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), 0u);
+    // The old server may still answer, then closes the connection
+    int tag = ReadTag(fd);
+    EXPECT_TRUE(tag == 1 || tag == -1) << tag;
+    EXPECT_EQ(CallTag(fd), -1);
+
+    int fresh = ConnectRaw();
+    ASSERT_GE(fresh, 0);
+    EXPECT_EQ(CallTag(fresh), 2);
+}
+
+TEST_F(HotRestartTest, NegotiatedCompressionMovesWithTheConnection) {
+    ServerConfig config = HandoffConfig();
+    config.compression_threshold = 64;
+    old_server_ = StartTagServer(1, config);
+
+    ChannelOptions options{1000, false};
+    options.compression = true;
+    options.compression_threshold = 64;
+    auto channel = std::make_shared<Channel>(socket_path_, options);
+    ASSERT_TRUE(channel->IsConnected());
+    Calculator calculator(channel);
+    std::vector<std::pair<double, double>> pairs(40, {1.5, 2.0});
+    ASSERT_EQ(calculator.AddBatch(pairs).size(), pairs.size());
+
+    new_server_ = StartTagServer(2, config);
+    ExpectHandedOff();
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), 1u);
+
+    auto results = calculator.AddBatch(pairs);
+    ASSERT_EQ(results.size(), pairs.size());
+    ASSERT_TRUE(results.back().success) << results.back().error_message;
+    EXPECT_DOUBLE_EQ(results.back().value, 3.5);
+    EXPECT_EQ(new_server_->GetClientCount(), 1u); // The adopted one, no reconnect
+}
+
+TEST_F(HotRestartTest, SharedMemoryClientsReconnect) {
+    old_server_ = StartTagServer(1, HandoffConfig());
+
+    ChannelOptions options{1000, false};
+    options.transport = Transport::SharedMemory;
+    auto channel = std::make_shared<Channel>(socket_path_, options);
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+    Calculator calculator(channel);
+    ASSERT_TRUE(calculator.Add(1, 2).success);
+
+    new_server_ = StartTagServer(2, HandoffConfig());
+    ExpectHandedOff();
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), 0u);
+
+    // Closed like an idle connection: the health check reconnects
+    ASSERT_TRUE(channel->CheckConnection());
+    auto result = calculator.Add(3, 4);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 7.0);
+    EXPECT_TRUE(channel->IsSharedMemoryActive());
+}
+
+TEST_F(HotRestartTest, IoUringAcceptorHandsOverTheListener) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not available";
+    }
+    ServerConfig config = HandoffConfig();
+    config.io_backend = IoBackend::IoUring;
+    old_server_ = StartTagServer(1, config);
+
+    auto channel = std::make_shared<Channel>(socket_path_, ChannelOptions{1000, false});
+    Calculator calculator(channel);
+    ASSERT_TRUE(calculator.Add(1, 2).success);
+
+    new_server_ = StartTagServer(2, config);
+    ExpectHandedOff();
+
+    // io_uring connections are not handed over; the channel reconnects
+    auto result = calculator.Add(3, 4);
+    ASSERT_TRUE(result.success) << result.error_message;
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(CallTag(fd), 2);
+}
+
+TEST_F(HotRestartTest, SilentSuccessorDoesNotStallAccepts) {
+    ExpectSilentSuccessorIgnored(IoBackend::Epoll);
+}
+
+TEST_F(HotRestartTest, SilentSuccessorDoesNotStallIoUringAccepts) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not available";
+    }
+    ExpectSilentSuccessorIgnored(IoBackend::IoUring);
+}
+
+TEST_F(HotRestartTest, StartsColdWithoutAPredecessor) {
+    // A control socket file left behind by a crashed server
+    int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, handoff_path_.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(bind(stale, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    close(stale);
+
+    new_server_ = StartTagServer(2, HandoffConfig());
+    EXPECT_EQ(new_server_->GetAdoptedClientCount(), 0u);
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(CallTag(fd), 2);
+
+    // And can itself be taken over
+    old_server_ = std::move(new_server_);
+    new_server_ = StartTagServer(3, HandoffConfig());
+    ExpectHandedOff();
+    EXPECT_EQ(CallTag(fd), 3);
+}
+
+TEST_F(HotRestartTest, ClientBatchesCarryTheirConnections) {
+    int pair[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+
+    std::vector<HandoffClient> sent;
+    for (int i = 0; i < 6; ++i) {
+        HandoffClient client;
+        client.fd = open("/dev/null", O_RDONLY);
+        client.idle_timeout_ms = 1000u * static_cast<uint32_t>(i);
+        client.compression = static_cast<uint8_t>(i % 3);
+        sent.push_back(client);
+    }
+    ASSERT_TRUE(hot_restart::SendClients(pair[0], sent));
+    ASSERT_TRUE(hot_restart::SendDone(pair[0]));
+
+    hot_restart::MessageReader reader;
+    std::vector<HandoffClient> received;
+    hot_restart::Message message;
+    int batches = 0;
+    ASSERT_EQ(reader.Read(pair[1], message), hot_restart::MessageReader::Status::Message);
+    while (message.kind == hot_restart::MessageKind::Clients) {
+        ASSERT_TRUE(hot_restart::ParseClients(message, received));
+        ++batches;
+        ASSERT_EQ(reader.Read(pair[1], message), hot_restart::MessageReader::Status::Message);
+    }
+    EXPECT_EQ(message.kind, hot_restart::MessageKind::Done);
+    EXPECT_EQ(batches, 2); // MAX_PASSED_FDS per batch
+
+    ASSERT_EQ(received.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); ++i) {
+        struct stat expected, actual;
+        ASSERT_EQ(fstat(sent[i].fd, &expected), 0);
+        ASSERT_EQ(fstat(received[i].fd, &actual), 0);
+        EXPECT_EQ(expected.st_ino, actual.st_ino);
+        EXPECT_NE(received[i].fd, sent[i].fd);
+        EXPECT_EQ(received[i].idle_timeout_ms, sent[i].idle_timeout_ms);
+        EXPECT_EQ(received[i].compression, sent[i].compression);
+        close(sent[i].fd);
+        close(received[i].fd);
+    }
+
+    // Garbage is an error, not a hang
+    const uint8_t garbage[] = {0x7f, 0, 0};
+    ASSERT_EQ(send(pair[0], garbage, sizeof(garbage), 0), static_cast<ssize_t>(sizeof(garbage)));
+    EXPECT_EQ(reader.Read(pair[1], message), hot_restart::MessageReader::Status::Error);
+
+    close(pair[0]);
+    close(pair[1]);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file test_io_uring.cpp
+ * @brief Unit tests for the IoUring wrapper (skipped on kernels without support)
+ */
+
+#include "ipc_sync/IoUring.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+constexpr uint16_t GROUP = 0;
+constexpr unsigned BUFFERS = 4;
+constexpr unsigned BUFFER_SIZE = 256;
+
+class IoUringTest : public ::testing::Test {
+protected:
+    std::unique_ptr<IoUring> ring_;
+    int sv_[2] = {-1, -1};
+    struct msghdr msg_;
+
+    void SetUp() override {
+        if (!IoUring::IsSupported()) {
+            GTEST_SKIP() << "io_uring not supported by this kernel";
+        }
+        std::string error;
+        ring_ = IoUring::Create(16, error);
+        ASSERT_NE(ring_, nullptr) << error;
+        ASSERT_TRUE(ring_->SetupBufferRing(GROUP, BUFFERS, BUFFER_SIZE, error)) << error;
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv_), 0);
+
+        std::memset(&msg_, 0, sizeof(msg_));
+        msg_.msg_controllen = CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS);
+    }
+
+    void TearDown() override {
+        ring_.reset(); // Before the sockets, so nothing is left in flight
+        for (int fd : sv_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    // Wait for at least one completion and collect everything available
+    std::vector<io_uring_cqe> Reap(int timeout_ms = 1000) {
+        std::vector<io_uring_cqe> cqes;
+        ring_->SubmitAndWait(1, timeout_ms);
+        ring_->ForEachCompletion([&cqes](const io_uring_cqe& cqe) { cqes.push_back(cqe); });
+        return cqes;
+    }
+};
+
+} // namespace
+
+TEST_F(IoUringTest, MultishotRecvMsgFillsProvidedBuffers) {
+    IoUring::PrepRecvMsgMultishot(ring_->GetSqe(), sv_[0], &msg_, GROUP, MSG_CMSG_CLOEXEC, 7);
+    ASSERT_GE(ring_->Submit(), 0);
+
+    std::string received;
+    for (const char* chunk : {"first", "second", "third"}) {
+        ASSERT_EQ(send(sv_[1], chunk, std::strlen(chunk), 0), static_cast<ssize_t>(std::strlen(chunk)));
+
+        auto cqes = Reap();
+        ASSERT_EQ(cqes.size(), 1u);
+        const io_uring_cqe& cqe = cqes[0];
+        EXPECT_EQ(cqe.user_data, 7u);
+        ASSERT_GT(cqe.res, 0);
+        ASSERT_TRUE(cqe.flags & IORING_CQE_F_BUFFER);
+        EXPECT_TRUE(IoUring::HasMore(cqe)); // Stays armed
+
+        IoUring::RecvMsg parts;
+        uint16_t id = IoUring::BufferId(cqe);
+        ASSERT_TRUE(IoUring::ParseRecvMsg(ring_->Buffer(id), static_cast<size_t>(cqe.res), msg_, parts));
+        received.append(reinterpret_cast<const char*>(parts.payload), parts.payload_len);
+        ring_->RecycleBuffer(id);
+    }
+    EXPECT_EQ(received, "firstsecondthird");
+
+    // More chunks than buffers: recycling keeps the request going
+    for (int i = 0; i < 3 * static_cast<int>(BUFFERS); ++i) {
+        ASSERT_EQ(send(sv_[1], "x", 1, 0), 1);
+        auto cqes = Reap();
+        for (const auto& cqe : cqes) {
+            ASSERT_GT(cqe.res, 0);
+            ring_->RecycleBuffer(IoUring::BufferId(cqe));
+        }
+    }
+
+    // Peer shutdown: an empty payload without F_MORE
+    shutdown(sv_[1], SHUT_WR);
+    auto cqes = Reap();
+    ASSERT_EQ(cqes.size(), 1u);
+    IoUring::RecvMsg parts;
+    ASSERT_TRUE(IoUring::ParseRecvMsg(ring_->Buffer(IoUring::BufferId(cqes[0])),
+                                      static_cast<size_t>(cqes[0].res), msg_, parts));
+    EXPECT_EQ(parts.payload_len, 0u);
+    EXPECT_FALSE(IoUring::HasMore(cqes[0]));
+}
+
+TEST_F(IoUringTest, MultishotRecvMsgCarriesPassedDescriptors) {
+    IoUring::PrepRecvMsgMultishot(ring_->GetSqe(), sv_[0], &msg_, GROUP, MSG_CMSG_CLOEXEC, 1);
+    ASSERT_GE(ring_->Submit(), 0);
+
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+    const uint8_t byte = 0x42;
+    ASSERT_EQ(SendWithFds(sv_[1], &byte, 1, pipe_fds, 2), 1);
+
+    auto cqes = Reap();
+    ASSERT_EQ(cqes.size(), 1u);
+    IoUring::RecvMsg parts;
+    ASSERT_TRUE(IoUring::ParseRecvMsg(ring_->Buffer(IoUring::BufferId(cqes[0])),
+                                      static_cast<size_t>(cqes[0].res), msg_, parts));
+    ASSERT_EQ(parts.payload_len, 1u);
+    EXPECT_EQ(parts.payload[0], byte);
+
+    std::vector<int> fds;
+    CollectPassedFds(parts.control, fds);
+    ASSERT_EQ(fds.size(), 2u);
+
+    // The received write end feeds the original read end
+    ASSERT_EQ(write(fds[1], "ok", 2), 2);
+    char check[2];
+    ASSERT_EQ(read(pipe_fds[0], check, sizeof(check)), 2);
+    for (int fd : {fds[0], fds[1], pipe_fds[0], pipe_fds[1]}) {
+        close(fd);
+    }
+}
+
+TEST_F(IoUringTest, CancelEndsMultishotRequest) {
+    IoUring::PrepRecvMsgMultishot(ring_->GetSqe(), sv_[0], &msg_, GROUP, 0, 5);
+    IoUring::PrepCancel(ring_->GetSqe(), 5, 6);
+
+    bool cancelled = false;
+    bool cancel_done = false;
+    for (int i = 0; i < 10 && !(cancelled && cancel_done); ++i) {
+        for (const auto& cqe : Reap()) {
+            if (cqe.user_data == 5) {
+                EXPECT_EQ(cqe.res, -ECANCELED);
+                EXPECT_FALSE(IoUring::HasMore(cqe));
+                cancelled = true;
+            } else if (cqe.user_data == 6) {
+                EXPECT_EQ(cqe.res, 0);
+                cancel_done = true;
+            }
+        }
+    }
+    EXPECT_TRUE(cancelled);
+    EXPECT_TRUE(cancel_done);
+}
+
+TEST_F(IoUringTest, LinkedSendRecvWithTimeout) {
+    // Keep the peer quiet: the receive is cut off by the linked timeout
+    const char request[] = "ping";
+    char reply[16];
+    struct __kernel_timespec timeout{0, 50 * 1000000};
+
+    io_uring_sqe* send_sqe = ring_->GetSqe();
+    IoUring::PrepSend(send_sqe, sv_[0], request, sizeof(request), MSG_NOSIGNAL, 1);
+    send_sqe->flags |= IOSQE_IO_LINK;
+    io_uring_sqe* recv_sqe = ring_->GetSqe();
+    IoUring::PrepRecv(recv_sqe, sv_[0], reply, sizeof(reply), 0, 2);
+    recv_sqe->flags |= IOSQE_IO_LINK;
+    IoUring::PrepLinkTimeout(ring_->GetSqe(), &timeout, 3);
+
+    std::vector<io_uring_cqe> cqes;
+    while (cqes.size() < 3) {
+        auto more = Reap();
+        ASSERT_FALSE(more.empty());
+        cqes.insert(cqes.end(), more.begin(), more.end());
+    }
+    for (const auto& cqe : cqes) {
+        if (cqe.user_data == 1) {
+            EXPECT_EQ(cqe.res, static_cast<int>(sizeof(request)));
+        } else if (cqe.user_data == 2) {
+            EXPECT_EQ(cqe.res, -ECANCELED);
+        } else {
+            EXPECT_EQ(cqe.res, -ETIME);
+        }
+    }
+
+    // The request did go out
+    char peer[sizeof(request)];
+    EXPECT_EQ(recv(sv_[1], peer, sizeof(peer), 0), static_cast<ssize_t>(sizeof(request)));
+}
+
+TEST_F(IoUringTest, RejectsBadBufferRingGeometry) {
+    std::string error;
+    auto ring = IoUring::Create(4, error);
+    ASSERT_NE(ring, nullptr) << error;
+    EXPECT_FALSE(ring->SetupBufferRing(GROUP, 3, BUFFER_SIZE, error)); // Not a power of two
+    EXPECT_FALSE(ring->SetupBufferRing(GROUP, BUFFERS, 0, error));
+    EXPECT_TRUE(ring->SetupBufferRing(GROUP, BUFFERS, BUFFER_SIZE, error)) << error;
+    EXPECT_FALSE(ring->SetupBufferRing(1, BUFFERS, BUFFER_SIZE, error)); // One ring per instance
+}
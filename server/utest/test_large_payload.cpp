@@ -0,0 +1,72 @@
+/**
+ * @file test_large_payload.cpp
+ * @brief Unit tests for sealed memfd payloads
+ */
+
+#include "ipc_sync/LargePayload.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+
+using namespace ipc_demo;
+
+TEST(LargePayloadTest, RoundTripThroughSealedMemfd) {
+    std::vector<uint8_t> data(3 * 1024 * 1024);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    std::string error;
+    int memfd = CreateSealedPayload(data.data(), data.size(), error);
+    ASSERT_GE(memfd, 0) << error;
+
+    auto view = PayloadView::Map(memfd, data.size(), error);
+    ASSERT_NE(view, nullptr) << error;
+    EXPECT_EQ(view->Size(), data.size());
+    EXPECT_EQ(std::memcmp(view->Data(), data.data(), data.size()), 0);
+}
+
+TEST(LargePayloadTest, SealedMemfdCannotBeModified) {
+    uint8_t data[64] = {1, 2, 3};
+    std::string error;
+    int memfd = CreateSealedPayload(data, sizeof(data), error);
+    ASSERT_GE(memfd, 0) << error;
+
+    EXPECT_LT(pwrite(memfd, data, 1, 0), 0);
+    EXPECT_LT(ftruncate(memfd, 0), 0);
+    EXPECT_EQ(mmap(nullptr, sizeof(data), PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0), MAP_FAILED);
+    close(memfd);
+}
+
+TEST(LargePayloadTest, CreateRejectsBadSizes) {
+    uint8_t byte = 0;
+    std::string error;
+    EXPECT_LT(CreateSealedPayload(&byte, 0, error), 0);
+    EXPECT_LT(CreateSealedPayload(&byte, Protocol::MAX_FD_PAYLOAD_SIZE + 1, error), 0);
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(LargePayloadTest, MapRejectsWritableMemfd) {
+    int memfd = memfd_create("test_writable_payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(memfd, 0);
+    ASSERT_EQ(ftruncate(memfd, 4096), 0);
+    ASSERT_EQ(fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK), 0); // No F_SEAL_WRITE
+
+    std::string error;
+    EXPECT_EQ(PayloadView::Map(memfd, 4096, error), nullptr);
+    EXPECT_NE(error.find("sealed"), std::string::npos);
+}
+
+TEST(LargePayloadTest, MapRejectsSizeMismatch) {
+    uint8_t data[100] = {};
+    std::string error;
+    int memfd = CreateSealedPayload(data, sizeof(data), error);
+    ASSERT_GE(memfd, 0) << error;
+
+    EXPECT_EQ(PayloadView::Map(memfd, 4096, error), nullptr);
+    EXPECT_FALSE(error.empty());
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for the client-side latency histogram
+ */
+
+#include "ipc_sync/LatencyHistogram.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+using namespace ipc_demo;
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.Min(), 0u);
+    EXPECT_EQ(histogram.Max(), 0u);
+    EXPECT_EQ(histogram.Mean(), 0.0);
+    EXPECT_EQ(histogram.Percentile(0.99), 0u);
+}
+
+TEST(LatencyHistogramTest, BucketsCoverValuesContinuously) {
+    using Buckets = LatencyHistogram::Buckets;
+    size_t previous = 0;
+    for (uint64_t value = 0; value < 100000; ++value) {
+        size_t index = Buckets::Index(value);
+        ASSERT_GE(index, previous);
+        ASSERT_LE(index, previous + 1);
+        ASSERT_LE(value, Buckets::UpperBound(index));
+        if (index > 0) {
+            ASSERT_GT(value, Buckets::UpperBound(index - 1));
+        }
+        previous = index;
+    }
+    EXPECT_EQ(Buckets::BUCKET_COUNT - 1, Buckets::Index(UINT64_MAX));
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.Record(value);
+    }
+    EXPECT_EQ(histogram.Count(), 100u);
+    EXPECT_EQ(histogram.Min(), 1u);
+    EXPECT_EQ(histogram.Max(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.Mean(), 50.5);
+    EXPECT_EQ(histogram.Percentile(0.0), 1u);
+    EXPECT_EQ(histogram.Percentile(0.5), 50u);
+    EXPECT_EQ(histogram.Percentile(0.99), 99u);
+    EXPECT_EQ(histogram.Percentile(1.0), 100u);
+}
+
+TEST(LatencyHistogramTest, LargeValuesStayWithinOnePercent) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<uint64_t> dist(1000, 5000000000ull);
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t value = dist(rng);
+        LatencyHistogram histogram;
+        histogram.Record(value);
+        histogram.Record(value + 1);
+        // The median falls in the bucket of the smaller value
+        uint64_t reported = histogram.Percentile(0.5);
+        EXPECT_GE(reported, value);
+        EXPECT_LE(static_cast<double>(reported), static_cast<double>(value) * 1.01) << value;
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesFollowTheDistribution) {
+    LatencyHistogram histogram;
+    histogram.RecordCount(10000, 990);     // 10 us
+    histogram.RecordCount(5000000, 10);    // A 5 ms tail of 1%
+    EXPECT_EQ(histogram.Count(), 1000u);
+
+    EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.5)), 10000.0, 100.0);
+    EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.99)), 10000.0, 100.0);
+    EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.991)), 5000000.0, 50000.0);
+    EXPECT_EQ(histogram.Percentile(1.0), 5000000u);
+}
+
+TEST(LatencyHistogramTest, AddMergesAndResetClears) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (uint64_t value = 1; value <= 50; ++value) {
+        a.Record(value);
+        b.Record(value + 50);
+    }
+
+    LatencyHistogram merged;
+    merged.Add(a);
+    merged.Add(b);
+    merged.Add(LatencyHistogram()); // Empty: no effect on min
+    EXPECT_EQ(merged.Count(), 100u);
+    EXPECT_EQ(merged.Min(), 1u);
+    EXPECT_EQ(merged.Max(), 100u);
+    EXPECT_EQ(merged.Percentile(0.5), 50u);
+    EXPECT_DOUBLE_EQ(merged.Mean(), 50.5);
+
+    merged.Reset();
+    EXPECT_EQ(merged.Count(), 0u);
+    EXPECT_EQ(merged.Percentile(0.5), 0u);
+    merged.Record(7);
+    EXPECT_EQ(merged.Min(), 7u);
+}
+
+TEST(LatencyHistogramTest, HugeValuesLandInTheLastBucket) {
+    LatencyHistogram histogram;
+    histogram.Record(UINT64_MAX);
+    histogram.Record(1);
+    EXPECT_EQ(histogram.Max(), UINT64_MAX);
+    EXPECT_EQ(histogram.Percentile(1.0), UINT64_MAX);
+    EXPECT_EQ(histogram.Percentile(0.5), 1u);
+}
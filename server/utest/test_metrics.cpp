@@ -0,0 +1,233 @@
+/**
+ * @file test_metrics.cpp
+ * @brief Unit tests for Metrics and the built-in stats routine
+ */
+
+#include "Metrics.hpp"
+#include "ServiceManager.hpp"
+#include "CalculatorService.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+const RoutineMetrics* FindRoutine(const MetricsSnapshot& snapshot, uint32_t routine_id) {
+    for (const auto& routine : snapshot.routines) {
+        if (routine.routine_id == routine_id) {
+            return &routine;
+        }
+    }
+    return nullptr;
+}
+
+// Calculator add request payload
+std::vector<uint8_t> AddRequest(double a, double b) {
+    std::vector<uint8_t> request(1 + 2 * sizeof(double));
+    ByteBuffer buf(request.data(), request.size());
+    buf.PutByte(static_cast<uint8_t>(CalculatorService::Operation::Add));
+    buf.PutDouble(a);
+    buf.PutDouble(b);
+    return request;
+}
+
+} // namespace
+
+TEST(MetricsTest, BucketsCoverValuesContinuously) {
+    size_t previous = 0;
+    for (uint64_t value = 0; value < 100000; ++value) {
+        size_t index = Metrics::BucketIndex(value);
+        ASSERT_GE(index, previous);
+        ASSERT_LE(index, previous + 1);
+        ASSERT_LE(value, Metrics::BucketUpperBound(index));
+        if (index > 0) {
+            ASSERT_GT(value, Metrics::BucketUpperBound(index - 1));
+        }
+        previous = index;
+    }
+    EXPECT_EQ(Metrics::BUCKET_COUNT - 1, Metrics::BucketIndex(UINT64_MAX));
+}
+
+TEST(MetricsTest, PercentilesWithinBucketResolution) {
+    Metrics metrics;
+    metrics.RegisterRoutine(0x1000, "Test");
+    for (uint64_t us = 1; us <= 1000; ++us) {
+        metrics.RecordRequest(0x1000, 0, 0, false, us * 1000);
+    }
+
+    MetricsSnapshot snapshot = metrics.Snapshot();
+    const RoutineMetrics* routine = FindRoutine(snapshot, 0x1000);
+    ASSERT_NE(nullptr, routine);
+    const HistogramSnapshot& execution = routine->execution;
+    EXPECT_EQ(1000u, execution.count);
+    EXPECT_EQ(500500u * 1000, execution.sum_ns);
+    EXPECT_EQ(1000000u, execution.max_ns);
+
+    EXPECT_NEAR(500000.0, static_cast<double>(execution.Percentile(0.5)), 500000.0 * 0.125);
+    EXPECT_NEAR(990000.0, static_cast<double>(execution.Percentile(0.99)), 990000.0 * 0.125);
+    EXPECT_EQ(1000000u, execution.Percentile(1.0));
+    EXPECT_EQ(0u, HistogramSnapshot{}.Percentile(0.5));
+}
+
+TEST(MetricsTest, SumsShardsFromManyThreads) {
+    constexpr int THREADS = 4;
+    constexpr int REQUESTS = 1000;
+    Metrics metrics;
+    metrics.RegisterRoutine(0x1000, "Test");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&metrics]() {
+            for (int i = 0; i < REQUESTS; ++i) {
+                metrics.RecordRequest(0x1000, 10, 20, i % 10 == 0, 100);
+                metrics.RecordQueueWait(0x1000, 50);
+            }
+            metrics.RecordConnectionOpened();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    MetricsSnapshot snapshot = metrics.Snapshot();
+    EXPECT_EQ(static_cast<uint64_t>(THREADS), snapshot.connections_opened);
+    const RoutineMetrics* routine = FindRoutine(snapshot, 0x1000);
+    ASSERT_NE(nullptr, routine);
+    EXPECT_EQ("Test", routine->name);
+    EXPECT_EQ(static_cast<uint64_t>(THREADS * REQUESTS), routine->requests);
+    EXPECT_EQ(static_cast<uint64_t>(THREADS * REQUESTS / 10), routine->errors);
+    EXPECT_EQ(static_cast<uint64_t>(THREADS * REQUESTS * 10), routine->bytes_in);
+    EXPECT_EQ(static_cast<uint64_t>(THREADS * REQUESTS * 20), routine->bytes_out);
+    EXPECT_EQ(static_cast<uint64_t>(THREADS * REQUESTS), routine->queue_wait.count);
+}
+
+TEST(MetricsTest, UnregisteredRoutinesShareOneSlot) {
+    Metrics metrics;
+    metrics.RegisterRoutine(0x1000, "Idle");
+    metrics.RecordRequest(0x1234, 0, 0, true, 1);
+    metrics.RecordRejected(0x5678);
+
+    MetricsSnapshot snapshot = metrics.Snapshot();
+    ASSERT_EQ(2u, snapshot.routines.size());
+
+    // Registered routines are listed before their first request
+    EXPECT_EQ(0x1000u, snapshot.routines[0].routine_id);
+    EXPECT_EQ(0u, snapshot.routines[0].requests);
+
+    const RoutineMetrics& other = snapshot.routines[1];
+    EXPECT_EQ(Metrics::OTHER_ROUTINE_ID, other.routine_id);
+    EXPECT_EQ("other", other.name);
+    EXPECT_EQ(1u, other.requests);
+    EXPECT_EQ(1u, other.errors);
+    EXPECT_EQ(1u, other.rejected);
+}
+
+TEST(MetricsTest, RegistrationIsBounded) {
+    Metrics metrics;
+    for (uint32_t i = 0; i < Metrics::MAX_ROUTINES; ++i) {
+        EXPECT_TRUE(metrics.RegisterRoutine(0x1000 + i, "Routine"));
+    }
+    EXPECT_TRUE(metrics.RegisterRoutine(0x1000, "Again"));
+    EXPECT_FALSE(metrics.RegisterRoutine(0x9000, "Overflow"));
+    EXPECT_FALSE(metrics.RegisterRoutine(Metrics::OTHER_ROUTINE_ID, "Invalid"));
+
+    metrics.RecordRequest(0x9000, 0, 0, false, 1);
+    MetricsSnapshot snapshot = metrics.Snapshot();
+    const RoutineMetrics* other = FindRoutine(snapshot, Metrics::OTHER_ROUTINE_ID);
+    ASSERT_NE(nullptr, other);
+    EXPECT_EQ(1u, other->requests);
+}
+
+TEST(MetricsTest, FormatsPrometheusText) {
+    Metrics metrics;
+    metrics.RegisterRoutine(0x1000, "Calc\"ulator");
+    metrics.RecordRequest(0x1000, 17, 19, false, 2000);
+    metrics.RecordConnectionOpened();
+
+    std::string text = Metrics::FormatPrometheus(metrics.Snapshot());
+    EXPECT_NE(std::string::npos, text.find("# TYPE ipc_requests_total counter\n"));
+    EXPECT_NE(std::string::npos, text.find("ipc_requests_total{routine=\"0x1000\",service=\"Calc\\\"ulator\"} 1\n"));
+    EXPECT_NE(std::string::npos, text.find("ipc_request_bytes_total{routine=\"0x1000\",service=\"Calc\\\"ulator\"} 17\n"));
+    EXPECT_NE(std::string::npos, text.find("ipc_connections_active 1\n"));
+    EXPECT_NE(std::string::npos, text.find("# TYPE ipc_request_execution_seconds summary\n"));
+    EXPECT_NE(std::string::npos, text.find(
+        "ipc_request_execution_seconds{routine=\"0x1000\",service=\"Calc\\\"ulator\",quantile=\"0.99\"} 2e-06\n"));
+    EXPECT_NE(std::string::npos, text.find(
+        "ipc_request_execution_seconds_count{routine=\"0x1000\",service=\"Calc\\\"ulator\"} 1\n"));
+}
+
+TEST(ServiceManagerMetricsTest, RecordsExecutedRequests) {
+    ServiceManager manager;
+    ASSERT_TRUE(manager.RegisterService(std::make_shared<CalculatorService>()));
+
+    auto request = AddRequest(1, 2);
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    size_t written = manager.ExecuteService(0x1000, request.data(), request.size(), output, sizeof(output));
+    ASSERT_GT(written, 0u);
+    EXPECT_EQ(0u, manager.ExecuteService(0x7777, request.data(), request.size(), output, sizeof(output)));
+
+    MetricsSnapshot snapshot = manager.GetMetrics().Snapshot();
+    const RoutineMetrics* calculator = FindRoutine(snapshot, 0x1000);
+    ASSERT_NE(nullptr, calculator);
+    EXPECT_EQ("CalculatorService", calculator->name);
+    EXPECT_EQ(1u, calculator->requests);
+    EXPECT_EQ(0u, calculator->errors);
+    EXPECT_EQ(request.size(), calculator->bytes_in);
+    EXPECT_EQ(written, calculator->bytes_out);
+    EXPECT_EQ(1u, calculator->execution.count);
+
+    const RoutineMetrics* other = FindRoutine(snapshot, Metrics::OTHER_ROUTINE_ID);
+    ASSERT_NE(nullptr, other);
+    EXPECT_EQ(1u, other->errors);
+
+    // Built-in routines are listed by name
+    ASSERT_NE(nullptr, FindRoutine(snapshot, Protocol::BATCH_REQUEST_ROUTINE_ID));
+    EXPECT_EQ("Stats", FindRoutine(snapshot, Protocol::STATS_REQUEST_ROUTINE_ID)->name);
+}
+
+TEST(ServiceManagerMetricsTest, StatsRoutineIsBuiltIn) {
+    ServiceManager manager;
+    EXPECT_FALSE(manager.IsInlineSafe(Protocol::STATS_REQUEST_ROUTINE_ID));
+
+    uint8_t format = Protocol::STATS_FORMAT_BINARY;
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    size_t written = manager.ExecuteService(Protocol::STATS_REQUEST_ROUTINE_ID, &format, 1, output, sizeof(output));
+    ASSERT_GT(written, 0u);
+
+    ByteBuffer response(output, written);
+    EXPECT_EQ(Protocol::START_BYTE, response.GetByte());
+    EXPECT_EQ(written, response.GetInt());
+    EXPECT_EQ(Protocol::STATS_RESPONSE_ROUTINE_ID, response.GetInt());
+    response.GetByte(); // Version
+    EXPECT_EQ(0, response.GetLong());   // Connections opened
+    EXPECT_EQ(0, response.GetLong());   // Connections closed
+    EXPECT_EQ(2u, response.GetInt());   // Batch and Stats
+    EXPECT_EQ(Protocol::END_BYTE, output[written - 1]);
+
+    uint8_t unknown = 0x42;
+    EXPECT_EQ(0u, manager.ExecuteService(Protocol::STATS_REQUEST_ROUTINE_ID, &unknown, 1, output, sizeof(output)));
+}
+
+TEST(ServiceManagerMetricsTest, PrometheusResponseKeepsWholeLines) {
+    ServiceManager manager;
+    ASSERT_TRUE(manager.RegisterService(std::make_shared<CalculatorService>()));
+
+    uint8_t format = Protocol::STATS_FORMAT_PROMETHEUS;
+    uint8_t output[600];
+    size_t written = manager.ExecuteService(Protocol::STATS_REQUEST_ROUTINE_ID, &format, 1, output, sizeof(output));
+    ASSERT_GT(written, 0u);
+
+    ByteBuffer response(output, written);
+    response.SetPosition(Protocol::GetMinFrameSize() - 1);
+    std::string text = response.GetString();
+    const std::string marker = "# truncated\n";
+    ASSERT_GT(text.size(), marker.size());
+    EXPECT_EQ(marker, text.substr(text.size() - marker.size()));
+    EXPECT_EQ('\n', text[text.size() - marker.size() - 1]);
+    EXPECT_EQ(0u, text.find("# HELP ipc_connections_opened_total"));
+}
@@ -236,6 +236,37 @@ TEST_F(MultiThreadingIntegrationTest, SharedChannelAccess) {
     EXPECT_GT(success_count, 0);
 }
 
+TEST_F(MultiThreadingIntegrationTest, SharedPipelinedChannelAccess) {
+    ChannelOptions options;
+    options.pipelining = true;
+    auto channel = std::make_shared<Channel>(socket_path_, options);
+    
+    ASSERT_TRUE(channel->IsConnected());
+    
+    constexpr int NUM_THREADS = 5;
+    std::atomic<int> success_count{0};
+    std::vector<std::thread> threads;
+    
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([channel, &success_count, i]() {
+            auto calculator = std::make_unique<Calculator>(channel);
+            
+            for (int j = 0; j < 20; ++j) {
+                auto result = calculator->Add(i, j);
+                if (result.success && result.value == i + j) {
+                    success_count++;
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(success_count, NUM_THREADS * 20);
+}
+
 TEST_F(MultiThreadingIntegrationTest, MultipleChannelsConcurrent) {
     constexpr int NUM_THREADS = 10;
     std::atomic<int> success_count{0};
@@ -0,0 +1,177 @@
+/**
+ * @file test_placement.cpp
+ * @brief In-process tests for thread pinning, busy polling and spin-wait receives
+ */
+
+#include "ServerFixture.hpp"
+#include "CalculatorService.hpp"
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/CalculatorClient.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Answers with the CPU it runs on and how many CPUs its thread may use
+class CpuService : public IService {
+public:
+    CpuService(uint32_t request_id, bool inline_safe)
+        : request_id_(request_id), inline_safe_(inline_safe) {}
+
+    uint32_t GetRequestRoutineId() const override { return request_id_; }
+    uint32_t GetResponseRoutineId() const override { return request_id_ + 1; }
+    std::string GetName() const override { return "CpuService"; }
+    bool IsInlineSafe() const override { return inline_safe_; }
+
+    size_t Execute(const uint8_t*, size_t, uint8_t* output, size_t output_len) override {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        sched_getaffinity(0, sizeof(set), &set);
+
+        ResponseBuilder response(GetResponseRoutineId(), output, output_len);
+        ByteBuffer payload(response.Payload(), response.PayloadCapacity());
+        payload.PutInt(static_cast<uint32_t>(sched_getcpu()));
+        payload.PutInt(static_cast<uint32_t>(CPU_COUNT(&set)));
+        return response.Finish(payload.Position());
+    }
+
+private:
+    uint32_t request_id_;
+    bool inline_safe_;
+};
+
+constexpr uint32_t INLINE_CPU_ROUTINE = 0x3300;
+constexpr uint32_t POOL_CPU_ROUTINE = 0x3310;
+
+// Last CPU this process may run on
+int AllowedCpu() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    for (int cpu = CPU_SETSIZE - 1; cpu >= 0; --cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+class PlacementTest : public ServerFixture {
+protected:
+    PlacementTest() : ServerFixture("placement") {}
+
+    void SetUp() override {
+        manager_->RegisterService(std::make_shared<CalculatorService>());
+        manager_->RegisterService(std::make_shared<CpuService>(INLINE_CPU_ROUTINE, true));
+        manager_->RegisterService(std::make_shared<CpuService>(POOL_CPU_ROUTINE, false));
+    }
+
+    // (CPU, allowed CPU count) of the thread that ran the routine
+    static std::pair<int, int> CpuOf(Channel& channel, uint32_t routine_id) {
+        uint8_t response[64];
+        size_t len = 0;
+        if (!channel.ExecuteRPC(routine_id, nullptr, 0, response, sizeof(response), len) ||
+            len != Protocol::GetMinFrameSize() + 8) {
+            return {-1, -1};
+        }
+        ByteBuffer buf(response + 10, 8);
+        int cpu = static_cast<int>(buf.GetInt());
+        int count = static_cast<int>(buf.GetInt());
+        return {cpu, count};
+    }
+
+    static void ExpectCalls(Channel& channel, int count) {
+        Calculator calculator(std::shared_ptr<Channel>(&channel, [](Channel*) {}));
+        for (int i = 0; i < count; ++i) {
+            auto result = calculator.Add(i, 0.5);
+            ASSERT_TRUE(result.success) << result.error_message;
+            EXPECT_DOUBLE_EQ(result.value, i + 0.5);
+        }
+    }
+};
+
+TEST_F(PlacementTest, ReactorsAndWorkersRunOnTheirCpus) {
+    int cpu = AllowedCpu();
+    ASSERT_GE(cpu, 0);
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    config.reactor_placement.cpus = {cpu};
+    config.worker_placement.cpus = {cpu};
+    StartServer(config);
+
+    // Two connections, one per reactor (round robin)
+    for (int i = 0; i < 2; ++i) {
+        Channel channel(socket_path_, 1000);
+        EXPECT_EQ(CpuOf(channel, INLINE_CPU_ROUTINE), std::make_pair(cpu, 1));
+        EXPECT_EQ(CpuOf(channel, POOL_CPU_ROUTINE), std::make_pair(cpu, 1));
+    }
+}
+
+TEST_F(PlacementTest, UnusableCpuOnlyCostsTheWarning) {
+    ServerConfig config;
+    config.reactor_placement.cpus = {CPU_SETSIZE - 1};
+    StartServer(config);
+
+    Channel channel(socket_path_, 1000);
+    ExpectCalls(channel, 5);
+}
+
+TEST_F(PlacementTest, BusyPollingServesSocketAndSharedMemory) {
+    ServerConfig config;
+    config.busy_poll_us = 20000;
+    StartServer(config);
+
+    ChannelOptions options;
+    options.timeout_ms = 1000;
+    options.spin_wait_us = 100;
+    Channel socket_channel(socket_path_, options);
+    ExpectCalls(socket_channel, 200);
+
+    options.transport = Transport::SharedMemory;
+    Channel shm_channel(socket_path_, options);
+    ASSERT_TRUE(shm_channel.IsSharedMemoryActive());
+    ExpectCalls(shm_channel, 200);
+
+    // Past the spin budget the reactor sleeps again; the doorbell must wake it
+    for (int round = 0; round < 3; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        auto start = std::chrono::steady_clock::now();
+        ExpectCalls(shm_channel, 1);
+        ExpectCalls(socket_channel, 1);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+    }
+}
+
+TEST_F(PlacementTest, BusyPollingWithWorkerPoolAndIoUring) {
+    ServerConfig config;
+    config.busy_poll_us = 5000;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    config.io_backend = IoBackend::IoUring; // Epoll where unsupported
+    StartServer(config);
+
+    ChannelOptions options;
+    options.timeout_ms = 1000;
+    options.spin_wait_us = 50;
+    Channel channel(socket_path_, options);
+    for (int round = 0; round < 3; ++round) {
+        EXPECT_NE(CpuOf(channel, POOL_CPU_ROUTINE).first, -1);
+        ExpectCalls(channel, 50);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
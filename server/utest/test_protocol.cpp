@@ -41,3 +41,13 @@ TEST(ProtocolTest, FrameSizeConsistency) {
     EXPECT_LE(min_frame, Protocol::MAX_PACKET_SIZE);
     EXPECT_GE(min_frame, Protocol::MIN_PACKET_SIZE);
 }
+
+TEST(ProtocolTest, HeaderFlags) {
+    EXPECT_EQ(Protocol::VERSION & Protocol::FLAGS_MASK, 0);
+    EXPECT_EQ(Protocol::FLAG_REQUEST_ID & Protocol::VERSION_MASK, 0);
+    EXPECT_EQ(Protocol::GetExtensionSize(Protocol::VERSION), 0u);
+    EXPECT_EQ(Protocol::GetExtensionSize(Protocol::VERSION | Protocol::FLAG_REQUEST_ID),
+              Protocol::REQUEST_ID_SIZE);
+    EXPECT_EQ(Protocol::GetExtensionSize(Protocol::VERSION | Protocol::FLAG_REQUEST_ID | Protocol::FLAG_TRACE_ID),
+              Protocol::REQUEST_ID_SIZE + Protocol::TRACE_ID_SIZE);
+}
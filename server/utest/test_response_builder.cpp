@@ -0,0 +1,148 @@
+/**
+ * @file test_response_builder.cpp
+ * @brief Unit tests for ResponseBuilder and IService::Respond
+ */
+
+#include "ResponseBuilder.hpp"
+#include "ServiceManager.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Writes only its payload behind the header ServiceManager stamped
+class PayloadService : public IService {
+public:
+    uint32_t GetRequestRoutineId() const override { return 0x5000; }
+    uint32_t GetResponseRoutineId() const override { return 0x5001; }
+    std::string GetName() const override { return "PayloadService"; }
+
+    size_t Execute(const uint8_t*, size_t, uint8_t*, size_t) override {
+        ADD_FAILURE() << "ServiceManager should call Respond()";
+        return 0;
+    }
+
+    size_t Respond(const uint8_t* input, size_t input_len, ResponseBuilder& response) override {
+        seen_routine_id = response.RoutineId();
+        ByteBuffer payload(response.Payload(), response.PayloadCapacity());
+        payload.PutArray(input, static_cast<uint32_t>(input_len));
+        return response.Finish(payload.Position());
+    }
+
+    uint32_t seen_routine_id = 0;
+};
+
+// Builds its own frame the old way
+class FrameService : public IService {
+public:
+    uint32_t GetRequestRoutineId() const override { return 0x6000; }
+    uint32_t GetResponseRoutineId() const override { return 0x6001; }
+    std::string GetName() const override { return "FrameService"; }
+
+    size_t Execute(const uint8_t*, size_t, uint8_t* output, size_t output_len) override {
+        ResponseBuilder response(0x6001, output, output_len);
+        response.Payload()[0] = 0x42;
+        return response.Finish(1);
+    }
+};
+
+} // namespace
+
+TEST(ResponseBuilderTest, FinishCompletesTheFrame) {
+    uint8_t frame[32] = {};
+    ResponseBuilder response(0x1234, frame, sizeof(frame));
+    EXPECT_EQ(response.RoutineId(), 0x1234u);
+    EXPECT_EQ(response.Payload(), frame + Protocol::FRAME_HEADER_SIZE);
+    EXPECT_EQ(response.PayloadCapacity(), sizeof(frame) - Protocol::GetMinFrameSize());
+
+    response.Payload()[0] = 0xAB;
+    response.Payload()[1] = 0xCD;
+    size_t len = response.Finish(2);
+    ASSERT_EQ(len, Protocol::GetMinFrameSize() + 2);
+
+    ByteBuffer check(frame, len);
+    EXPECT_EQ(check.GetByte(), Protocol::START_BYTE);
+    EXPECT_EQ(check.GetInt(), len);
+    EXPECT_EQ(check.GetInt(), 0x1234u);
+    EXPECT_EQ(check.GetByte(), Protocol::VERSION);
+    EXPECT_EQ(check.GetByte(), 0xAB);
+    EXPECT_EQ(check.GetByte(), 0xCD);
+    EXPECT_EQ(check.GetByte(), Protocol::END_BYTE);
+}
+
+TEST(ResponseBuilderTest, PreEncodedHeaderMatchesRoutine) {
+    ResponseBuilder::Header header = ResponseBuilder::EncodeHeader(0x1001);
+    uint8_t frame[Protocol::GetMinFrameSize()];
+    ResponseBuilder response(header, frame, sizeof(frame));
+    EXPECT_EQ(response.RoutineId(), 0x1001u);
+    EXPECT_EQ(response.PayloadCapacity(), 0u);
+    EXPECT_EQ(response.Finish(0), Protocol::GetMinFrameSize());
+    EXPECT_EQ(response.Finish(1), 0u);
+}
+
+TEST(ResponseBuilderTest, TooSmallBufferGivesNoFrame) {
+    uint8_t frame[Protocol::GetMinFrameSize() - 1];
+    ResponseBuilder response(0x1001, frame, sizeof(frame));
+    EXPECT_EQ(response.PayloadCapacity(), 0u);
+    EXPECT_EQ(response.FrameCapacity(), 0u);
+    EXPECT_EQ(response.Finish(0), 0u);
+}
+
+TEST(ResponseBuilderTest, EncodeMatchesEncodeFrame) {
+    CalculatorResponse message;
+    message.status = CalculatorStatus::Success;
+    message.result = 42.0;
+    message.error = "none";
+
+    uint8_t expected[64];
+    size_t expected_len = EncodeFrame(CalculatorRpc::RESPONSE_ROUTINE_ID, message, expected, sizeof(expected));
+    ASSERT_GT(expected_len, 0u);
+
+    uint8_t frame[64];
+    ResponseBuilder response(CalculatorRpc::RESPONSE_ROUTINE_ID, frame, sizeof(frame));
+    ASSERT_EQ(response.Encode(message), expected_len);
+    EXPECT_EQ(0, std::memcmp(frame, expected, expected_len));
+
+    // One byte short
+    ResponseBuilder small(CalculatorRpc::RESPONSE_ROUTINE_ID, frame, expected_len - 1);
+    EXPECT_EQ(small.Encode(message), 0u);
+}
+
+TEST(ResponseBuilderTest, ServiceManagerStampsResponseHeader) {
+    ServiceManager manager;
+    auto service = std::make_shared<PayloadService>();
+    ASSERT_TRUE(manager.RegisterService(service));
+
+    const uint8_t input[] = {9, 8, 7};
+    uint8_t output[64];
+    size_t len = manager.ExecuteService(0x5000, input, sizeof(input), output, sizeof(output));
+    ASSERT_EQ(len, Protocol::GetMinFrameSize() + 4 + sizeof(input));
+    EXPECT_EQ(service->seen_routine_id, 0x5001u);
+
+    ByteBuffer check(output, len);
+    check.GetByte();
+    EXPECT_EQ(check.GetInt(), len);
+    EXPECT_EQ(check.GetInt(), 0x5001u);
+    check.GetByte();
+    EXPECT_EQ(check.GetInt(), sizeof(input));
+    EXPECT_EQ(output[len - 1], Protocol::END_BYTE);
+
+    // A response that does not fit is no response
+    EXPECT_EQ(manager.ExecuteService(0x5000, input, sizeof(input), output, len - 1), 0u);
+}
+
+TEST(ResponseBuilderTest, FrameServicesStillWorkThroughRespond) {
+    ServiceManager manager;
+    ASSERT_TRUE(manager.RegisterService(std::make_shared<FrameService>()));
+
+    uint8_t output[64];
+    size_t len = manager.ExecuteService(0x6000, nullptr, 0, output, sizeof(output));
+    ASSERT_EQ(len, Protocol::GetMinFrameSize() + 1);
+    EXPECT_EQ(output[Protocol::FRAME_HEADER_SIZE], 0x42);
+}
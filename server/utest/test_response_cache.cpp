@@ -0,0 +1,192 @@
+/**
+ * @file test_response_cache.cpp
+ * @brief Unit tests for ResponseCache
+ */
+
+#include "ResponseCache.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+constexpr uint32_t ROUTINE = 0x1000;
+
+struct Request {
+    std::string bytes;
+
+    ResponseCache::Key Key(uint32_t routine_id = ROUTINE) const {
+        return ResponseCache::MakeKey(routine_id, reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+};
+
+void Put(ResponseCache& cache, const ResponseCache::Key& key, const std::string& response,
+         uint32_t ttl_ms = 0, uint64_t now_ms = 0) {
+    cache.Insert(key, reinterpret_cast<const uint8_t*>(response.data()), response.size(), ttl_ms, now_ms);
+}
+
+std::string Get(ResponseCache& cache, const ResponseCache::Key& key, uint64_t now_ms = 0) {
+    uint8_t output[64];
+    size_t len = cache.Lookup(key, output, sizeof(output), now_ms);
+    return std::string(reinterpret_cast<const char*>(output), len);
+}
+
+} // namespace
+
+TEST(ResponseCacheTest, HitsSameRoutineAndBytesOnly) {
+    ResponseCache cache;
+    Request add{"add 1 2"};
+    Put(cache, add.Key(), "3");
+
+    EXPECT_EQ("3", Get(cache, add.Key()));
+    EXPECT_EQ("", Get(cache, Request{"add 1 3"}.Key()));
+    EXPECT_EQ("", Get(cache, add.Key(0x2000)));  // Same bytes, other routine
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(1u, stats.insertions);
+    EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(ResponseCacheTest, CollidingHashIsAMiss) {
+    ResponseCache cache;
+    Request stored{"stored"};
+    Put(cache, stored.Key(), "answer");
+
+    // A different request that happens to hash the same must not get the answer
+    Request other{"other!"};
+    ResponseCache::Key forged = other.Key();
+    forged.hash = stored.Key().hash;
+    EXPECT_EQ("", Get(cache, forged));
+
+    // Inserting it replaces the entry instead of chaining
+    Put(cache, forged, "mine");
+    EXPECT_EQ("mine", Get(cache, forged));
+    EXPECT_EQ("", Get(cache, stored.Key()));
+}
+
+TEST(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+    // One entry per shard: fill a shard with one key, then push it out
+    ResponseCacheOptions options;
+    options.capacity = ResponseCache::SHARDS;
+    ResponseCache cache(options);
+
+    ResponseCache::Key first = Request{"first"}.Key();
+    Put(cache, first, "1");
+    ResponseCache::Key second = first;  // Same shard, different key
+    second.hash ^= 1;
+    second.request = reinterpret_cast<const uint8_t*>("second");
+    second.request_len = 6;
+    Put(cache, second, "2");
+
+    EXPECT_EQ("", Get(cache, first));
+    EXPECT_EQ("2", Get(cache, second));
+    EXPECT_EQ(1u, cache.GetStats().evictions);
+    EXPECT_EQ(1u, cache.GetStats().entries);
+}
+
+TEST(ResponseCacheTest, RecentlyUsedEntriesSurvive) {
+    ResponseCacheOptions options;
+    options.capacity = 2 * ResponseCache::SHARDS;
+    ResponseCache cache(options);
+
+    auto in_shard = [](uint64_t hash, const char* bytes) {
+        ResponseCache::Key key{ROUTINE, reinterpret_cast<const uint8_t*>(bytes), std::strlen(bytes), hash};
+        return key;
+    };
+    auto a = in_shard(0x100, "a"), b = in_shard(0x200, "b"), c = in_shard(0x300, "c");
+    Put(cache, a, "A");
+    Put(cache, b, "B");
+    EXPECT_EQ("A", Get(cache, a));  // b is now the least recently used
+    Put(cache, c, "C");
+
+    EXPECT_EQ("A", Get(cache, a));
+    EXPECT_EQ("", Get(cache, b));
+    EXPECT_EQ("C", Get(cache, c));
+}
+
+TEST(ResponseCacheTest, EntriesExpireAfterTtl) {
+    ResponseCache cache;
+    ResponseCache::Key key = Request{"now"}.Key();
+    Put(cache, key, "t0", 10, 1000);
+
+    EXPECT_EQ("t0", Get(cache, key, 1009));
+    EXPECT_EQ("", Get(cache, key, 1010));
+    EXPECT_EQ(0u, cache.GetStats().entries);  // Dropped on the expired lookup
+}
+
+TEST(ResponseCacheTest, RespectsSizeBounds) {
+    ResponseCacheOptions options;
+    options.max_request_bytes = 8;
+    options.max_response_bytes = 4;
+    ResponseCache cache(options);
+
+    EXPECT_TRUE(cache.Accepts(8));
+    EXPECT_FALSE(cache.Accepts(9));
+
+    ResponseCache::Key key = Request{"request"}.Key();
+    Put(cache, key, "too long");
+    EXPECT_EQ(0u, cache.GetStats().entries);
+
+    // A hit that does not fit the caller's buffer is a miss
+    Put(cache, key, "fits");
+    uint8_t small[2];
+    EXPECT_EQ(0u, cache.Lookup(key, small, sizeof(small), 0));
+    EXPECT_EQ("fits", Get(cache, key));
+}
+
+TEST(ResponseCacheTest, ZeroCapacityDisables) {
+    ResponseCacheOptions options;
+    options.capacity = 0;
+    ResponseCache cache(options);
+    EXPECT_FALSE(cache.Accepts(0));
+
+    ResponseCache::Key key = Request{"x"}.Key();
+    Put(cache, key, "y");
+    EXPECT_EQ("", Get(cache, key));
+}
+
+TEST(ResponseCacheTest, ClearDropsEverything) {
+    ResponseCache cache;
+    for (int i = 0; i < 100; ++i) {
+        Request request{"r" + std::to_string(i)};
+        Put(cache, request.Key(), "v");
+    }
+    EXPECT_EQ(100u, cache.GetStats().entries);
+    cache.Clear();
+    EXPECT_EQ(0u, cache.GetStats().entries);
+}
+
+TEST(ResponseCacheTest, ConcurrentReadersAndWriters) {
+    ResponseCacheOptions options;
+    options.capacity = 64;  // Small, so threads evict each other's entries
+    ResponseCache cache(options);
+
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &wrong, t]() {
+            for (int i = 0; i < 5000; ++i) {
+                Request request{std::to_string(t) + ":" + std::to_string(i % 100)};
+                std::string expected = "=" + request.bytes;
+                std::string got = Get(cache, request.Key());
+                if (got.empty()) {
+                    Put(cache, request.Key(), expected);
+                } else if (got != expected) {
+                    wrong.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, wrong.load());
+    EXPECT_LE(cache.GetStats().entries, 64u);
+}
@@ -0,0 +1,263 @@
+/**
+ * @file test_schema.cpp
+ * @brief Unit tests for message schemas, typed stubs and TypedService
+ */
+
+#include "TypedService.hpp"
+#include "ResponseBuilder.hpp"
+#include "CalculatorService.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/RpcClient.hpp"
+#include "ipc_sync/Schema.hpp"
+#include "ipc_sync/TimeSchema.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+enum class Color : uint16_t { Red = 1, Blue = 0xBEEF };
+
+struct Point {
+    int32_t x;
+    int32_t y;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&Point::x, &Point::y);
+    }
+};
+
+struct Everything {
+    bool flag;
+    uint8_t byte;
+    int16_t small;
+    uint32_t word;
+    int64_t big;
+    float ratio;
+    double value;
+    Color color;
+    Point origin;
+    std::string name;
+    std::string empty;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&Everything::flag, &Everything::byte, &Everything::small, &Everything::word,
+                               &Everything::big, &Everything::ratio, &Everything::value, &Everything::color,
+                               &Everything::origin, &Everything::name, &Everything::empty);
+    }
+};
+
+struct Empty {
+    static constexpr auto Fields() {
+        return std::make_tuple();
+    }
+};
+
+// Sizes are compile-time constants
+static_assert(MessageCodec<Point>::FIXED_SIZE && MessageCodec<Point>::MIN_SIZE == 8, "Point layout");
+static_assert(!MessageCodec<Everything>::FIXED_SIZE, "Strings make a message variable-size");
+static_assert(MessageCodec<Everything>::MIN_SIZE == 1 + 1 + 2 + 4 + 8 + 4 + 8 + 2 + 8 + 4 + 4, "Everything layout");
+static_assert(MessageCodec<Empty>::FIXED_SIZE && MessageCodec<Empty>::MIN_SIZE == 0, "Empty layout");
+static_assert(MessageCodec<TimeRequest>::MIN_SIZE == 1, "Time request layout");
+
+// Echoes CalculatorRequest operands back, to test the adapter
+class SumService : public TypedService<CalculatorRpc> {
+public:
+    std::string GetName() const override { return "SumService"; }
+
+protected:
+    void Handle(const CalculatorRequest& request, CalculatorResponse& response) override {
+        response.status = CalculatorStatus::Success;
+        response.result = request.a + request.b;
+        response.error = request.op == CalculatorOperation::Add ? "" : "not add";
+    }
+};
+
+} // namespace
+
+TEST(SchemaTest, MatchesByteBufferLayout) {
+    CalculatorRequest request{CalculatorOperation::Divide, 1.5, -2.25};
+    uint8_t encoded[MessageCodec<CalculatorRequest>::MIN_SIZE];
+    ASSERT_EQ(sizeof(encoded), MessageCodec<CalculatorRequest>::Encode(request, encoded, sizeof(encoded)));
+
+    uint8_t expected[sizeof(encoded)];
+    ByteBuffer buf(expected, sizeof(expected));
+    buf.PutByte(0x04);
+    buf.PutDouble(1.5);
+    buf.PutDouble(-2.25);
+    EXPECT_EQ(0, std::memcmp(expected, encoded, sizeof(encoded)));
+
+    TimeResponse response{TimeStatus::Success, "2026-01-01", -5, "none"};
+    std::vector<uint8_t> time_encoded(MessageCodec<TimeResponse>::Size(response));
+    MessageCodec<TimeResponse>::Encode(response, time_encoded.data(), time_encoded.size());
+
+    std::vector<uint8_t> time_expected(time_encoded.size());
+    ByteBuffer time_buf(time_expected.data(), time_expected.size());
+    time_buf.PutByte(0x00);
+    time_buf.PutString("2026-01-01");
+    time_buf.PutLong(-5);
+    time_buf.PutString("none");
+    EXPECT_EQ(time_buf.Position(), time_encoded.size());
+    EXPECT_EQ(time_expected, time_encoded);
+}
+
+TEST(SchemaTest, RoundTripsEveryFieldType) {
+    Everything in{true, 0xAB, -1234, 0xDEADBEEF, -(int64_t(1) << 40), 0.5f, 3.25,
+                  Color::Blue, Point{-7, 9}, "hello", ""};
+    std::vector<uint8_t> buffer(MessageCodec<Everything>::Size(in));
+    EXPECT_EQ(MessageCodec<Everything>::MIN_SIZE + 5, buffer.size());
+    ASSERT_EQ(buffer.size(), MessageCodec<Everything>::Encode(in, buffer.data(), buffer.size()));
+
+    Everything out{};
+    ASSERT_TRUE(MessageCodec<Everything>::Decode(buffer.data(), buffer.size(), out));
+    EXPECT_TRUE(out.flag);
+    EXPECT_EQ(0xAB, out.byte);
+    EXPECT_EQ(-1234, out.small);
+    EXPECT_EQ(0xDEADBEEFu, out.word);
+    EXPECT_EQ(in.big, out.big);
+    EXPECT_FLOAT_EQ(0.5f, out.ratio);
+    EXPECT_DOUBLE_EQ(3.25, out.value);
+    EXPECT_EQ(Color::Blue, out.color);
+    EXPECT_EQ(-7, out.origin.x);
+    EXPECT_EQ(9, out.origin.y);
+    EXPECT_EQ("hello", out.name);
+    EXPECT_TRUE(out.empty.empty());
+}
+
+TEST(SchemaTest, RejectsShortInputAndSmallBuffers) {
+    Everything in{false, 1, 2, 3, 4, 5.0f, 6.0, Color::Red, Point{0, 0}, "abc", "de"};
+    std::vector<uint8_t> buffer(MessageCodec<Everything>::Size(in));
+    EXPECT_EQ(0u, MessageCodec<Everything>::Encode(in, buffer.data(), buffer.size() - 1));
+    ASSERT_EQ(buffer.size(), MessageCodec<Everything>::Encode(in, buffer.data(), buffer.size()));
+
+    // Every truncation fails: the fixed part, then each string body
+    Everything out{};
+    for (size_t len = 0; len < buffer.size(); ++len) {
+        EXPECT_FALSE(MessageCodec<Everything>::Decode(buffer.data(), len, out)) << "length " << len;
+    }
+    EXPECT_TRUE(MessageCodec<Everything>::Decode(buffer.data(), buffer.size(), out));
+
+    // A string length pointing past the end
+    uint8_t data[MessageCodec<CalculatorResponse>::MIN_SIZE];
+    ByteBuffer buf(data, sizeof(data));
+    buf.PutByte(0x00);
+    buf.PutDouble(1.0);
+    buf.PutInt(1);
+    CalculatorResponse response{};
+    EXPECT_FALSE(MessageCodec<CalculatorResponse>::Decode(data, sizeof(data), response));
+}
+
+TEST(SchemaTest, RejectsStringsBeyondTheLengthField) {
+    // Only the sizes are read: nothing is encoded
+    static const char byte = 'x';
+    std::string_view huge(&byte, size_t{std::numeric_limits<uint32_t>::max()} + 1);
+    TimeResponseView view{TimeStatus::Success, huge, 0, huge};
+    EXPECT_EQ(schema_detail::OVERSIZED, MessageCodec<TimeResponseView>::Size(view));
+
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    EXPECT_EQ(0u, MessageCodec<TimeResponseView>::Encode(view, frame, sizeof(frame)));
+    EXPECT_EQ(0u, EncodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, view, frame, sizeof(frame)));
+    ResponseBuilder response(TimeRpc::RESPONSE_ROUTINE_ID, frame, sizeof(frame));
+    EXPECT_EQ(0u, response.Encode(view));
+
+    // The longest encodable string still adds up without wrapping
+    view.timestamp = std::string_view(&byte, std::numeric_limits<uint32_t>::max());
+    view.error = std::string_view();
+    EXPECT_EQ(MessageCodec<TimeResponseView>::MIN_SIZE + std::numeric_limits<uint32_t>::max(),
+              MessageCodec<TimeResponseView>::Size(view));
+}
+
+TEST(SchemaTest, EncodesAndChecksFrames) {
+    CalculatorResponse response{CalculatorStatus::DivisionByZero, 0.0, "Division by zero"};
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    size_t frame_len = EncodeFrame(CalculatorRpc::RESPONSE_ROUTINE_ID, response, frame, sizeof(frame));
+    ASSERT_EQ(Protocol::GetMinFrameSize() + MessageCodec<CalculatorResponse>::Size(response), frame_len);
+
+    ByteBuffer header(frame, frame_len);
+    EXPECT_EQ(Protocol::START_BYTE, header.GetByte());
+    EXPECT_EQ(frame_len, header.GetInt());
+    EXPECT_EQ(0x1001u, header.GetInt());
+    EXPECT_EQ(Protocol::VERSION, header.GetByte());
+    EXPECT_EQ(Protocol::END_BYTE, frame[frame_len - 1]);
+
+    CalculatorResponse decoded{};
+    std::string error;
+    ASSERT_TRUE(RpcClient<CalculatorRpc>::ParseResponse(frame, frame_len, decoded, error)) << error;
+    EXPECT_EQ(CalculatorStatus::DivisionByZero, decoded.status);
+    EXPECT_EQ("Division by zero", decoded.error);
+
+    EXPECT_FALSE(DecodeFrame(0x2001, frame, frame_len, decoded, error));
+    EXPECT_EQ("Unexpected routine ID in response", error);
+    EXPECT_FALSE(DecodeFrame(0x1001, frame, frame_len - 1, decoded, error));
+    EXPECT_EQ("Invalid response frame", error);
+
+    EXPECT_EQ(0u, EncodeFrame(0x1001, response, frame, frame_len - 1));
+}
+
+TEST(SchemaTest, TypedServiceDecodesAndEncodes) {
+    SumService service;
+    EXPECT_EQ(0x1000u, service.GetRequestRoutineId());
+    EXPECT_EQ(0x1001u, service.GetResponseRoutineId());
+
+    uint8_t request[MessageCodec<CalculatorRequest>::MIN_SIZE];
+    MessageCodec<CalculatorRequest>::Write(request, CalculatorRequest{CalculatorOperation::Add, 2.0, 3.5});
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    size_t written = service.Execute(request, sizeof(request), output, sizeof(output));
+
+    CalculatorResponse response{};
+    std::string error;
+    ASSERT_TRUE(RpcClient<CalculatorRpc>::ParseResponse(output, written, response, error)) << error;
+    EXPECT_DOUBLE_EQ(5.5, response.result);
+    EXPECT_TRUE(response.error.empty());
+
+    // Short requests get no response unless the service builds one
+    EXPECT_EQ(0u, service.Execute(request, sizeof(request) - 1, output, sizeof(output)));
+    // Responses that do not fit are dropped
+    EXPECT_EQ(0u, service.Execute(request, sizeof(request), output, 12));
+}
+
+TEST(SchemaTest, CalculatorServiceAnswersTruncatedRequests) {
+    CalculatorService service;
+    uint8_t request[1] = {0x01};
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    size_t written = service.Execute(request, sizeof(request), output, sizeof(output));
+
+    CalculatorResponse response{};
+    std::string error;
+    ASSERT_TRUE(RpcClient<CalculatorRpc>::ParseResponse(output, written, response, error)) << error;
+    EXPECT_EQ(CalculatorStatus::InvalidInput, response.status);
+    EXPECT_FALSE(response.error.empty());
+}
+
+TEST(SchemaTest, ViewsDecodeInPlace) {
+    TimeResponse owned{TimeStatus::Success, "2026-10-14 12:00:00", 42, ""};
+    uint8_t frame[Protocol::MAX_PACKET_SIZE];
+    size_t frame_len = EncodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, owned, frame, sizeof(frame));
+    ASSERT_GT(frame_len, 0u);
+
+    TimeResponseView view{};
+    std::string error;
+    ASSERT_TRUE(RpcClient<TimeRpc>::ParseResponse(frame, frame_len, view, error)) << error;
+    EXPECT_EQ(owned.timestamp, view.timestamp);
+    EXPECT_EQ(42, view.unix_timestamp);
+    EXPECT_TRUE(view.error.empty());
+    EXPECT_EQ(reinterpret_cast<const char*>(frame) + Protocol::FRAME_HEADER_SIZE + 1 + 4, view.timestamp.data());
+
+    // Views encode exactly like the owning message
+    uint8_t reencoded[Protocol::MAX_PACKET_SIZE];
+    ASSERT_EQ(frame_len, EncodeFrame(TimeRpc::RESPONSE_ROUTINE_ID, view, reencoded, sizeof(reencoded)));
+    EXPECT_EQ(0, std::memcmp(frame, reencoded, frame_len));
+
+    CalculatorResponseView truncated{};
+    EXPECT_FALSE(RpcClient<CalculatorRpc>::ParseResponse(frame, frame_len, truncated, error));
+}
+
+TEST(SchemaTest, RpcClientRejectsNullChannel) {
+    EXPECT_THROW(RpcClient<TimeRpc>(nullptr), std::invalid_argument);
+}
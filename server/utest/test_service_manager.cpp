@@ -8,6 +8,9 @@
 #include "ipc_sync/ByteBuffer.hpp"
 #include "ipc_sync/Protocol.hpp"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -162,6 +165,91 @@ TEST_F(ServiceManagerTest, IsRoutineNotPresent) {
     EXPECT_FALSE(manager_->IsRoutinePresent(0x9999));
 }
 
+TEST_F(ServiceManagerTest, IsInlineSafe) {
+    auto service = std::make_shared<MockService>(0x1000, 0x1001);
+    manager_->RegisterService(service);
+
+    // Services default to offloadable; unknown routines fail fast inline
+    EXPECT_FALSE(manager_->IsInlineSafe(0x1000));
+    EXPECT_TRUE(manager_->IsInlineSafe(0x9999));
+}
+
+TEST_F(ServiceManagerTest, RegisterReservedRoutineFails) {
+    auto service = std::make_shared<MockService>(Protocol::BATCH_REQUEST_ROUTINE_ID, 0xF0F1);
+    EXPECT_FALSE(manager_->RegisterService(service));
+    EXPECT_EQ(manager_->GetServiceCount(), 0u);
+}
+
+TEST_F(ServiceManagerTest, ExecuteBatch) {
+    auto service1 = std::make_shared<MockService>(0x1000, 0x1001);
+    auto service2 = std::make_shared<MockService>(0x2000, 0x2001);
+    manager_->RegisterService(service1);
+    manager_->RegisterService(service2);
+
+    // Three calls: two services and one unknown routine
+    uint8_t request[64];
+    ByteBuffer req(request, sizeof(request));
+    req.PutInt(3);
+    req.PutInt(0x1000);
+    req.PutInt(1);
+    req.PutByte(0xAA);
+    req.PutInt(0x9999);
+    req.PutInt(0);
+    req.PutInt(0x2000);
+    req.PutInt(0);
+
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    size_t len = manager_->ExecuteService(Protocol::BATCH_REQUEST_ROUTINE_ID,
+                                          request, req.Position(), output, sizeof(output));
+    ASSERT_GT(len, 0u);
+    EXPECT_EQ(service1->GetExecuteCount(), 1);
+    EXPECT_EQ(service2->GetExecuteCount(), 1);
+
+    ByteBuffer resp(output, len);
+    EXPECT_EQ(resp.GetByte(), Protocol::START_BYTE);
+    EXPECT_EQ(resp.GetInt(), len);
+    EXPECT_EQ(resp.GetInt(), Protocol::BATCH_RESPONSE_ROUTINE_ID);
+    EXPECT_EQ(resp.GetByte(), Protocol::VERSION);
+    ASSERT_EQ(resp.GetInt(), 3u);
+
+    // Each entry is the full response frame of the sub-call
+    uint32_t entry_len = resp.GetInt();
+    ASSERT_EQ(entry_len, 12u);
+    EXPECT_EQ(output[resp.Position()], Protocol::START_BYTE);
+    resp.SetPosition(resp.Position() + 5);
+    EXPECT_EQ(resp.GetInt(), 0x1001u);
+    resp.SetPosition(resp.Position() + 3);
+
+    EXPECT_EQ(resp.GetInt(), 0u); // Unknown routine: no response
+
+    entry_len = resp.GetInt();
+    ASSERT_EQ(entry_len, 12u);
+    resp.SetPosition(resp.Position() + entry_len);
+    EXPECT_EQ(resp.GetByte(), Protocol::END_BYTE);
+    EXPECT_EQ(resp.Position(), len);
+}
+
+TEST_F(ServiceManagerTest, ExecuteMalformedBatch) {
+    manager_->RegisterService(std::make_shared<MockService>(0x1000, 0x1001));
+
+    uint8_t request[16];
+    ByteBuffer req(request, sizeof(request));
+    req.PutInt(2);
+    req.PutInt(0x1000);
+    req.PutInt(100); // Longer than the frame
+
+    uint8_t output[Protocol::MAX_PACKET_SIZE];
+    EXPECT_EQ(manager_->ExecuteService(Protocol::BATCH_REQUEST_ROUTINE_ID,
+                                       request, req.Position(), output, sizeof(output)), 0u);
+
+    req.SetPosition(0);
+    req.PutInt(static_cast<uint32_t>(Protocol::MAX_BATCH_CALLS + 1));
+    EXPECT_EQ(manager_->ExecuteService(Protocol::BATCH_REQUEST_ROUTINE_ID,
+                                       request, 4, output, sizeof(output)), 0u);
+
+    EXPECT_FALSE(manager_->IsInlineSafe(Protocol::BATCH_REQUEST_ROUTINE_ID));
+}
+
 TEST_F(ServiceManagerTest, ConcurrentRegistration) {
     constexpr int NUM_THREADS = 10;
     std::vector<std::thread> threads;
@@ -180,3 +268,152 @@ TEST_F(ServiceManagerTest, ConcurrentRegistration) {
     
     EXPECT_EQ(manager_->GetServiceCount(), NUM_THREADS);
 }
+
+TEST_F(ServiceManagerTest, DispatchWhileRegistering) {
+    auto service = std::make_shared<MockService>(0x1000, 0x1001);
+    manager_->RegisterService(service);
+
+    // Every registration publishes a new routing snapshot under the reader
+    constexpr int REGISTRATIONS = 200;
+    std::thread writer([this]() {
+        for (int i = 0; i < REGISTRATIONS; ++i) {
+            manager_->RegisterService(std::make_shared<MockService>(0x4000 + i, 0x8000 + i));
+        }
+    });
+
+    int failures = 0;
+    uint8_t input[1] = {0};
+    uint8_t output[64];
+    for (int i = 0; i < 5000; ++i) {
+        if (manager_->ExecuteService(0x1000, input, sizeof(input), output, sizeof(output)) == 0) {
+            ++failures;
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(service->GetExecuteCount(), 5000);
+    EXPECT_EQ(manager_->GetServiceCount(), static_cast<size_t>(REGISTRATIONS + 1));
+    EXPECT_TRUE(manager_->IsRoutinePresent(0x4000 + REGISTRATIONS - 1));
+}
+
+TEST_F(ServiceManagerTest, ClearReleasesServices) {
+    auto service = std::make_shared<MockService>(0x1000, 0x1001);
+    std::weak_ptr<MockService> weak = service;
+    manager_->RegisterService(service);
+    service.reset();
+
+    // No request is running on the replaced snapshot, so it goes at once
+    manager_->Clear();
+    EXPECT_FALSE(manager_->IsRoutinePresent(0x1000));
+    EXPECT_TRUE(weak.expired());
+}
+
+// Mock service that blocks in Execute until released
+class BlockingMockService : public MockService {
+public:
+    using MockService::MockService;
+
+    size_t Execute(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_size) override {
+        running = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+        return MockService::Execute(input, input_len, output, output_size);
+    }
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> release{false};
+};
+
+TEST_F(ServiceManagerTest, ClearWaitsForInFlightRequests) {
+    auto service = std::make_shared<BlockingMockService>(0x1000, 0x1001);
+    std::weak_ptr<BlockingMockService> weak = service;
+    BlockingMockService* raw = service.get();
+    manager_->RegisterService(service);
+    service.reset();
+
+    size_t written = 0;
+    std::thread request([&]() {
+        uint8_t input[1] = {0};
+        uint8_t output[64];
+        written = manager_->ExecuteService(0x1000, input, sizeof(input), output, sizeof(output));
+    });
+    while (!raw->running) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> cleared{false};
+    std::thread clearer([&]() {
+        manager_->Clear();
+        cleared = true;
+    });
+
+    // The request still runs on the replaced snapshot
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(cleared.load());
+    EXPECT_FALSE(weak.expired());
+    EXPECT_FALSE(manager_->IsRoutinePresent(0x1000));
+
+    raw->release = true;
+    request.join();
+    clearer.join();
+    EXPECT_GT(written, 0u);
+    EXPECT_TRUE(cleared.load());
+    EXPECT_TRUE(weak.expired());
+}
+
+// Mock service whose responses may be cached
+class IdempotentMockService : public MockService {
+public:
+    using MockService::MockService;
+    bool IsIdempotent() const override { return true; }
+};
+
+TEST_F(ServiceManagerTest, IdempotentResponsesAreCached) {
+    auto service = std::make_shared<IdempotentMockService>(0x1000, 0x1001);
+    manager_->RegisterService(service);
+
+    uint8_t first[64];
+    uint8_t cached[64];
+    const uint8_t input[] = {1, 2, 3};
+    size_t len = manager_->ExecuteService(0x1000, input, sizeof(input), first, sizeof(first));
+    ASSERT_GT(len, 0u);
+    ASSERT_EQ(manager_->ExecuteService(0x1000, input, sizeof(input), cached, sizeof(cached)), len);
+    EXPECT_EQ(0, std::memcmp(first, cached, len));
+    EXPECT_EQ(service->GetExecuteCount(), 1);
+
+    // Different request bytes are executed
+    const uint8_t other[] = {1, 2, 4};
+    EXPECT_GT(manager_->ExecuteService(0x1000, other, sizeof(other), cached, sizeof(cached)), 0u);
+    EXPECT_EQ(service->GetExecuteCount(), 2);
+
+    EXPECT_EQ(manager_->GetCacheStats().hits, 1u);
+    MetricsSnapshot snapshot = manager_->GetMetrics().Snapshot();
+    ASSERT_FALSE(snapshot.routines.empty());
+    EXPECT_EQ(snapshot.routines[0].routine_id, 0x1000u);
+    EXPECT_EQ(snapshot.routines[0].requests, 3u);
+    EXPECT_EQ(snapshot.routines[0].cache_hits, 1u);
+
+    // Clear() drops cached responses along with the services
+    manager_->Clear();
+    manager_->RegisterService(service);
+    manager_->ExecuteService(0x1000, input, sizeof(input), cached, sizeof(cached));
+    EXPECT_EQ(service->GetExecuteCount(), 3);
+}
+
+TEST_F(ServiceManagerTest, ZeroCapacityDisablesResponseCache) {
+    ResponseCacheOptions options;
+    options.capacity = 0;
+    manager_ = std::make_unique<ServiceManager>(options);
+    auto service = std::make_shared<IdempotentMockService>(0x1000, 0x1001);
+    manager_->RegisterService(service);
+
+    uint8_t input[1] = {0};
+    uint8_t output[64];
+    for (int i = 0; i < 3; ++i) {
+        manager_->ExecuteService(0x1000, input, sizeof(input), output, sizeof(output));
+    }
+    EXPECT_EQ(service->GetExecuteCount(), 3);
+    EXPECT_EQ(manager_->GetCacheStats().hits, 0u);
+}
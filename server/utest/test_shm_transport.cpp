@@ -0,0 +1,327 @@
+/**
+ * @file test_shm_transport.cpp
+ * @brief Unit tests for ShmRing, ShmTransport and the socket helpers (SCM_RIGHTS, scatter/gather)
+ */
+
+#include "ipc_sync/ShmTransport.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Heap-backed ring region for single-process tests
+struct LocalRing {
+    explicit LocalRing(size_t capacity)
+        : region(static_cast<uint8_t*>(std::aligned_alloc(64, ShmRing::RegionSize(capacity))))
+        , ring(region, capacity) {
+        ring.Initialize();
+    }
+    ~LocalRing() { std::free(region); }
+    uint8_t* region; // Cache-line aligned, like the memfd mapping
+    ShmRing ring;
+};
+
+std::unique_ptr<ShmTransport> AttachDup(ShmTransport& transport, std::string& error) {
+    return ShmTransport::Attach(dup(transport.MemFd()), dup(transport.RequestEventFd()),
+                                dup(transport.ResponseEventFd()), error);
+}
+
+} // namespace
+
+// ============================================================================
+// ShmRing
+// ============================================================================
+
+TEST(ShmRingTest, WriteThenRead) {
+    LocalRing local(64);
+    uint8_t data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    EXPECT_TRUE(local.ring.Empty());
+    EXPECT_EQ(local.ring.Write(data, sizeof(data)), sizeof(data));
+    EXPECT_FALSE(local.ring.Empty());
+
+    uint8_t out[16];
+    bool corrupt = false;
+    EXPECT_EQ(local.ring.Read(out, sizeof(out), corrupt), sizeof(data));
+    EXPECT_FALSE(corrupt);
+    EXPECT_EQ(std::memcmp(out, data, sizeof(data)), 0);
+    EXPECT_TRUE(local.ring.Empty());
+}
+
+TEST(ShmRingTest, PartialWriteWhenFull) {
+    LocalRing local(64);
+    std::vector<uint8_t> data(100, 0xAB);
+
+    EXPECT_EQ(local.ring.Write(data.data(), data.size()), 64u);
+    EXPECT_EQ(local.ring.Write(data.data(), data.size()), 0u);
+
+    uint8_t out[32];
+    bool corrupt = false;
+    EXPECT_EQ(local.ring.Read(out, sizeof(out), corrupt), 32u);
+    EXPECT_EQ(local.ring.Write(data.data(), data.size()), 32u);
+}
+
+TEST(ShmRingTest, WrapAround) {
+    LocalRing local(64);
+    uint8_t filler[48] = {};
+    uint8_t out[64];
+    bool corrupt = false;
+
+    // Move the indices close to the end of the data area
+    ASSERT_EQ(local.ring.Write(filler, sizeof(filler)), sizeof(filler));
+    ASSERT_EQ(local.ring.Read(out, sizeof(out), corrupt), sizeof(filler));
+
+    uint8_t data[40];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    ASSERT_EQ(local.ring.Write(data, sizeof(data)), sizeof(data));
+    ASSERT_EQ(local.ring.Read(out, sizeof(out), corrupt), sizeof(data));
+    EXPECT_EQ(std::memcmp(out, data, sizeof(data)), 0);
+}
+
+TEST(ShmRingTest, CorruptIndicesAreReported) {
+    LocalRing local(64);
+    auto* header = reinterpret_cast<ShmRing::Header*>(local.region);
+    header->tail.store(1000); // Peer claims more data than the ring holds
+
+    uint8_t out[16];
+    bool corrupt = false;
+    EXPECT_EQ(local.ring.Read(out, sizeof(out), corrupt), 0u);
+    EXPECT_TRUE(corrupt);
+}
+
+TEST(ShmRingTest, WaitingFlags) {
+    LocalRing local(64);
+
+    // Readers start out asking to be woken
+    EXPECT_TRUE(local.ring.ReaderWaiting());
+    EXPECT_FALSE(local.ring.WriterWaiting());
+
+    local.ring.SetReaderWaiting(false);
+    local.ring.SetWriterWaiting(true);
+    EXPECT_FALSE(local.ring.ReaderWaiting());
+    EXPECT_TRUE(local.ring.WriterWaiting());
+}
+
+TEST(ShmRingTest, ConcurrentProducerConsumer) {
+    LocalRing local(4096);
+    constexpr size_t TOTAL = 1 << 18;
+
+    std::thread producer([&local]() {
+        uint8_t chunk[333];
+        size_t sent = 0;
+        while (sent < TOTAL) {
+            size_t len = std::min(sizeof(chunk), TOTAL - sent);
+            for (size_t i = 0; i < len; ++i) {
+                chunk[i] = static_cast<uint8_t>(sent + i);
+            }
+            size_t offset = 0;
+            while (offset < len) {
+                size_t written = local.ring.Write(chunk + offset, len - offset);
+                if (written == 0) {
+                    std::this_thread::yield();
+                }
+                offset += written;
+            }
+            sent += len;
+        }
+    });
+
+    size_t received = 0;
+    size_t mismatches = 0;
+    uint8_t out[500];
+    while (received < TOTAL) {
+        bool corrupt = false;
+        size_t n = local.ring.Read(out, sizeof(out), corrupt);
+        ASSERT_FALSE(corrupt);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] != static_cast<uint8_t>(received + i)) {
+                ++mismatches;
+            }
+        }
+        received += n;
+    }
+    producer.join();
+
+    EXPECT_EQ(mismatches, 0u);
+}
+
+// ============================================================================
+// ShmTransport
+// ============================================================================
+
+TEST(ShmTransportTest, CreateAndAttachShareRings) {
+    std::string error;
+    auto client = ShmTransport::Create(32 * 1024, error);
+    ASSERT_NE(client, nullptr) << error;
+
+    auto server = AttachDup(*client, error);
+    ASSERT_NE(server, nullptr) << error;
+    EXPECT_EQ(server->Requests().Capacity(), 32u * 1024);
+
+    const uint8_t request[] = "request";
+    ASSERT_EQ(client->Requests().Write(request, sizeof(request)), sizeof(request));
+
+    uint8_t out[32];
+    bool corrupt = false;
+    ASSERT_EQ(server->Requests().Read(out, sizeof(out), corrupt), sizeof(request));
+    EXPECT_STREQ(reinterpret_cast<char*>(out), "request");
+
+    const uint8_t response[] = "response";
+    ASSERT_EQ(server->Responses().Write(response, sizeof(response)), sizeof(response));
+    ASSERT_EQ(client->Responses().Read(out, sizeof(out), corrupt), sizeof(response));
+    EXPECT_STREQ(reinterpret_cast<char*>(out), "response");
+}
+
+TEST(ShmTransportTest, CapacityIsClampedToPowerOfTwo) {
+    std::string error;
+    auto small = ShmTransport::Create(1, error);
+    ASSERT_NE(small, nullptr) << error;
+    EXPECT_EQ(small->Requests().Capacity(), ShmTransport::MIN_RING_CAPACITY);
+
+    auto odd = ShmTransport::Create(100 * 1024, error);
+    ASSERT_NE(odd, nullptr) << error;
+    EXPECT_EQ(odd->Requests().Capacity(), 128u * 1024);
+}
+
+TEST(ShmTransportTest, DoorbellNotifyAndDrain) {
+    std::string error;
+    auto transport = ShmTransport::Create(0, error);
+    ASSERT_NE(transport, nullptr) << error;
+
+    ShmTransport::Notify(transport->ResponseEventFd());
+    uint64_t count = 0;
+    ASSERT_EQ(read(transport->ResponseEventFd(), &count, sizeof(count)), static_cast<ssize_t>(sizeof(count)));
+    EXPECT_EQ(count, 1u);
+
+    ShmTransport::Drain(transport->ResponseEventFd()); // Nothing pending: must not block
+}
+
+TEST(ShmTransportTest, AttachRejectsUnsealedMemory) {
+    int memfd = memfd_create("test_unsealed", MFD_CLOEXEC);
+    ASSERT_GE(memfd, 0);
+    ASSERT_EQ(ftruncate(memfd, 1 << 20), 0);
+
+    std::string error;
+    auto transport = ShmTransport::Attach(memfd, dup(memfd), dup(memfd), error);
+    EXPECT_EQ(transport, nullptr);
+    EXPECT_NE(error.find("sealed"), std::string::npos);
+}
+
+TEST(ShmTransportTest, AttachRejectsBadLayout) {
+    int memfd = memfd_create("test_bad_layout", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(memfd, 0);
+    ASSERT_EQ(ftruncate(memfd, 1 << 20), 0);
+    ASSERT_EQ(fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW), 0);
+
+    uint32_t layout[2] = {0xDEADBEEF, 1 << 16}; // Wrong magic
+    ASSERT_EQ(pwrite(memfd, layout, sizeof(layout), 0), static_cast<ssize_t>(sizeof(layout)));
+
+    std::string error;
+    auto transport = ShmTransport::Attach(memfd, dup(memfd), dup(memfd), error);
+    EXPECT_EQ(transport, nullptr);
+    EXPECT_FALSE(error.empty());
+}
+
+// ============================================================================
+// FdPassing
+// ============================================================================
+
+TEST(FdPassingTest, DescriptorsTravelWithData) {
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+
+    const uint8_t payload[] = {0x7E, 0x01};
+    ASSERT_EQ(SendWithFds(sv[0], payload, sizeof(payload), &pipe_fds[1], 1),
+              static_cast<ssize_t>(sizeof(payload)));
+
+    uint8_t buffer[8];
+    std::vector<int> fds;
+    ASSERT_EQ(RecvWithFds(sv[1], buffer, sizeof(buffer), fds), static_cast<ssize_t>(sizeof(payload)));
+    ASSERT_EQ(fds.size(), 1u);
+
+    // The received descriptor is the pipe's write end
+    ASSERT_EQ(write(fds[0], "x", 1), 1);
+    char c = 0;
+    ASSERT_EQ(read(pipe_fds[0], &c, 1), 1);
+    EXPECT_EQ(c, 'x');
+
+    for (int fd : {sv[0], sv[1], pipe_fds[0], pipe_fds[1], fds[0]}) {
+        close(fd);
+    }
+}
+
+TEST(FdPassingTest, TooManyDescriptorsRejected) {
+    int fds[MAX_PASSED_FDS + 1] = {};
+    uint8_t byte = 0;
+    EXPECT_EQ(SendWithFds(-1, &byte, 1, fds, MAX_PASSED_FDS + 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+}
+
+TEST(FdPassingTest, VectoredSendGathersSegments) {
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+    uint8_t head[] = {1, 2, 3};
+    uint8_t body[] = {4, 5, 6, 7};
+    uint8_t tail[] = {8};
+    struct iovec out[3] = {{head, sizeof(head)}, {body, sizeof(body)}, {tail, sizeof(tail)}};
+    ASSERT_EQ(SendVectored(sv[0], out, 3), 8);
+
+    // Scatter into two regions, split differently from the sender
+    uint8_t first[5] = {};
+    uint8_t second[5] = {};
+    struct iovec in[2] = {{first, sizeof(first)}, {second, sizeof(second)}};
+    std::vector<int> fds;
+    ASSERT_EQ(RecvVectored(sv[1], in, 2, fds), 8);
+    EXPECT_TRUE(fds.empty());
+
+    const uint8_t expected_first[] = {1, 2, 3, 4, 5};
+    const uint8_t expected_second[] = {6, 7, 8};
+    EXPECT_EQ(std::memcmp(first, expected_first, sizeof(expected_first)), 0);
+    EXPECT_EQ(std::memcmp(second, expected_second, sizeof(expected_second)), 0);
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
+TEST(FdPassingTest, AdvanceIovecAfterPartialSend) {
+    uint8_t a[4];
+    uint8_t b[6];
+    uint8_t c[2];
+    struct iovec iov[3] = {{a, sizeof(a)}, {b, sizeof(b)}, {c, sizeof(c)}};
+    struct iovec* next = iov;
+
+    // Ends inside the second segment
+    EXPECT_EQ(AdvanceIovec(next, 3, 5), 2u);
+    EXPECT_EQ(next, &iov[1]);
+    EXPECT_EQ(next->iov_base, static_cast<void*>(b + 1));
+    EXPECT_EQ(next->iov_len, 5u);
+
+    // Ends exactly on a segment boundary
+    EXPECT_EQ(AdvanceIovec(next, 2, 5), 1u);
+    EXPECT_EQ(next, &iov[2]);
+    EXPECT_EQ(next->iov_len, 2u);
+
+    EXPECT_EQ(AdvanceIovec(next, 1, 2), 0u);
+}
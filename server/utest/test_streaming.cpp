@@ -0,0 +1,310 @@
+/**
+ * @file test_streaming.cpp
+ * @brief In-process tests for server-push streams (subscribe, credits, cancel)
+ */
+
+#include "ServerFixture.hpp"
+#include "CalculatorService.hpp"
+#include "TimeService.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/CalculatorSchema.hpp"
+#include "ipc_sync/RpcClient.hpp"
+#include "ipc_sync/TimeClient.hpp"
+#include "ipc_sync/TimeSchema.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+// Tagged control frame: [START][LEN][ROUTINE][VERSION|ID][ID][payload][END]
+std::vector<uint8_t> TaggedFrame(uint32_t routine_id, uint32_t request_id, const std::vector<uint8_t>& payload) {
+    return ServerFixture::BuildFrame(routine_id, payload.data(), payload.size(), 0, request_id);
+}
+
+std::vector<uint8_t> SubscribePayload(uint32_t routine_id, uint32_t interval_ms, uint32_t credits) {
+    std::vector<uint8_t> payload(Protocol::STREAM_SUBSCRIBE_HEADER_SIZE);
+    ByteBuffer buf(payload.data(), payload.size());
+    buf.PutInt(routine_id);
+    buf.PutInt(interval_ms);
+    buf.PutInt(credits);
+    payload.push_back(static_cast<uint8_t>(TimeOperation::GetTimestamp));
+    return payload;
+}
+
+// Frame received on a raw socket
+struct RawFrame {
+    uint32_t routine_id;
+    uint32_t request_id;
+    std::vector<uint8_t> payload;
+};
+
+} // namespace
+
+class StreamingTest : public ServerFixture {
+protected:
+    StreamingTest() : ServerFixture("streaming") {}
+
+    void SetUp() override {
+        manager_->RegisterService(std::make_shared<CalculatorService>());
+        manager_->RegisterService(std::make_shared<TimeService>());
+    }
+
+    std::shared_ptr<Channel> Connect() {
+        ChannelOptions options;
+        options.timeout_ms = 1000;
+        options.pipelining = true;
+        return ServerFixture::Connect(options);
+    }
+
+    // Collect the frames arriving within window_ms
+    static std::vector<RawFrame> ReadFramesFor(int fd, FrameParser& parser, int window_ms) {
+        std::vector<RawFrame> frames;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(window_ms);
+        FrameView frame;
+        while (true) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0 || !NextFrame(fd, parser, frame, static_cast<int>(left))) {
+                return frames;
+            }
+            ByteBuffer buf(const_cast<uint8_t*>(frame.data), frame.length);
+            buf.SetPosition(5);
+            RawFrame raw;
+            raw.routine_id = buf.GetInt();
+            buf.GetByte();
+            raw.request_id = (frame.version & Protocol::FLAG_REQUEST_ID) ? buf.GetInt() : 0;
+            raw.payload.assign(frame.data + buf.Position(), frame.data + frame.length - 1);
+            frames.push_back(std::move(raw));
+        }
+    }
+};
+
+// Ticks and end of a TimeClient stream, recorded from the event-loop thread
+struct TickLog {
+    std::mutex mutex;
+    int ticks = 0;
+    int failures = 0;
+    std::string end;
+
+    TimeClient::Callback Callback() {
+        return [this](const TimeClient::TimeResult& result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (result.success) {
+                ticks += result.unix_timestamp > 0 ? 1 : 0;
+            } else if (end.empty()) {
+                end = result.error_message;
+            } else {
+                ++failures; // Nothing may follow the end
+            }
+        };
+    }
+
+    int Ticks() { std::lock_guard<std::mutex> lock(mutex); return ticks; }
+    int Failures() { std::lock_guard<std::mutex> lock(mutex); return failures; }
+    std::string End() { std::lock_guard<std::mutex> lock(mutex); return end; }
+};
+
+TEST_F(StreamingTest, TimeStreamTicksUntilCancelled) {
+    StartServer();
+    TickLog log;  // Outlives the channel, whose destruction ends the stream
+    auto channel = Connect();
+    TimeClient time(channel);
+    uint32_t stream_id = 0;
+    ASSERT_TRUE(time.Subscribe(20, log.Callback(), stream_id)) << channel->GetLastError();
+
+    // Far more ticks than the default window: credits keep flowing back
+    EXPECT_TRUE(WaitUntil([&]() { return log.Ticks() >= 40; }, 5000)) << log.Ticks() << " ticks";
+
+    ASSERT_TRUE(time.Unsubscribe(stream_id));
+    ASSERT_TRUE(WaitUntil([&]() { return !log.End().empty(); }));
+    EXPECT_EQ(log.End(), "Stream cancelled");
+
+    int ticks = log.Ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(log.Ticks(), ticks);
+    EXPECT_EQ(log.Failures(), 0);
+    EXPECT_FALSE(time.Unsubscribe(stream_id)); // Already ended
+
+    // The connection still serves plain calls
+    EXPECT_TRUE(time.GetCurrentTime().success);
+}
+
+TEST_F(StreamingTest, FirstFrameArrivesAtOnce) {
+    StartServer();
+    TickLog log;
+    auto channel = Connect();
+    TimeClient time(channel);
+    uint32_t stream_id = 0;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(time.Subscribe(60000, log.Callback(), stream_id));
+    ASSERT_TRUE(WaitUntil([&]() { return log.Ticks() == 1; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+}
+
+TEST_F(StreamingTest, ServerStopsAtZeroCredits) {
+    StartServer();
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    FrameParser parser;
+
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, 7,
+                                          SubscribePayload(TimeRpc::REQUEST_ROUTINE_ID, 5, 3))));
+    std::vector<RawFrame> frames = ReadFramesFor(fd, parser, 300);
+    ASSERT_EQ(frames.size(), 3u); // 60 intervals passed, but only 3 credits
+    for (const RawFrame& frame : frames) {
+        EXPECT_EQ(frame.routine_id, TimeRpc::RESPONSE_ROUTINE_ID);
+        EXPECT_EQ(frame.request_id, 7u);
+    }
+
+    // Two more credits, two more frames
+    std::vector<uint8_t> credit(Protocol::STREAM_CREDIT_PAYLOAD_SIZE);
+    ByteBuffer buf(credit.data(), credit.size());
+    buf.PutInt(7);
+    buf.PutInt(2);
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_CREDIT_ROUTINE_ID, 100, credit)));
+    EXPECT_EQ(ReadFramesFor(fd, parser, 300).size(), 2u);
+
+    // Cancel is answered by the end frame on the stream's ID
+    std::vector<uint8_t> cancel(Protocol::STREAM_CANCEL_PAYLOAD_SIZE);
+    ByteBuffer cancel_buf(cancel.data(), cancel.size());
+    cancel_buf.PutInt(7);
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_CANCEL_ROUTINE_ID, 101, cancel)));
+    frames = ReadFramesFor(fd, parser, 300);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].routine_id, Protocol::STREAM_END_ROUTINE_ID);
+    EXPECT_EQ(frames[0].request_id, 7u);
+    ASSERT_EQ(frames[0].payload.size(), Protocol::STREAM_END_PAYLOAD_SIZE);
+    EXPECT_EQ(frames[0].payload[0], Protocol::STREAM_CANCELLED);
+    close(fd);
+}
+
+TEST_F(StreamingTest, RejectsUnknownAndControlRoutines) {
+    StartServer();
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    FrameParser parser;
+
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, 1,
+                                          SubscribePayload(0x7777, 10, 4))));
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, 2,
+                                          SubscribePayload(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, 10, 4))));
+    ASSERT_TRUE(SendFrame(fd, TaggedFrame(Protocol::STREAM_SUBSCRIBE_ROUTINE_ID, 3, {0x00, 0x01})));
+
+    std::vector<RawFrame> frames = ReadFramesFor(fd, parser, 300);
+    ASSERT_EQ(frames.size(), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(frames[i].routine_id, Protocol::STREAM_END_ROUTINE_ID);
+        EXPECT_EQ(frames[i].request_id, i + 1);
+        ASSERT_EQ(frames[i].payload.size(), 1u);
+        EXPECT_EQ(frames[i].payload[0], Protocol::STREAM_REJECTED);
+    }
+    close(fd);
+
+    // The channel reports the rejection through the callback
+    std::atomic<bool> rejected{false};
+    auto channel = Connect();
+    uint32_t stream_id = 0;
+    ASSERT_TRUE(channel->Subscribe(0x7777, nullptr, 0, StreamOptions{}, [&](bool success, const uint8_t*, size_t,
+                                                                            const std::string& error) {
+        rejected = !success && error == "Stream rejected";
+    }, stream_id));
+    EXPECT_TRUE(WaitUntil([&]() { return rejected.load(); }));
+}
+
+TEST_F(StreamingTest, LimitsStreamsPerConnection) {
+    StartServer();
+    std::vector<TickLog> logs(Protocol::MAX_STREAMS_PER_CONNECTION + 1);
+    auto channel = Connect();
+    TimeClient time(channel);
+    for (auto& log : logs) {
+        uint32_t stream_id = 0;
+        ASSERT_TRUE(time.Subscribe(60000, log.Callback(), stream_id));
+    }
+    ASSERT_TRUE(WaitUntil([&]() { return logs.back().End() == "Stream rejected"; }));
+    for (size_t i = 0; i < Protocol::MAX_STREAMS_PER_CONNECTION; ++i) {
+        EXPECT_TRUE(WaitUntil([&]() { return logs[i].Ticks() == 1; })) << "stream " << i;
+        EXPECT_EQ(logs[i].End(), "");
+    }
+}
+
+TEST_F(StreamingTest, OffloadedRoutinesStreamFromWorkers) {
+    ServerConfig config;
+    config.num_reactors = 1;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    TickLog log;
+    auto channel = Connect();
+    TimeClient time(channel);
+    uint32_t stream_id = 0;
+    ASSERT_TRUE(time.Subscribe(10, log.Callback(), stream_id));
+    EXPECT_TRUE(WaitUntil([&]() { return log.Ticks() >= 30; }, 5000)) << log.Ticks() << " ticks";
+    ASSERT_TRUE(time.Unsubscribe(stream_id));
+    ASSERT_TRUE(WaitUntil([&]() { return log.End() == "Stream cancelled"; }));
+}
+
+TEST_F(StreamingTest, TypedStreamDecodesEveryFrame) {
+    StartServer();
+    std::mutex mutex;
+    std::vector<double> results;
+    auto channel = Connect();
+    RpcClient<CalculatorRpc> calculator(channel);
+    StreamOptions options;
+    options.interval_ms = 10;
+    options.window = 2;
+
+    uint32_t stream_id = 0;
+    std::string error;
+    ASSERT_TRUE(calculator.Subscribe(CalculatorRequest{CalculatorOperation::Multiply, 6, 7}, options,
+        [&](bool success, const CalculatorResponse& response, const std::string&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (success) {
+                results.push_back(response.result);
+            }
+        }, stream_id, error)) << error;
+
+    EXPECT_TRUE(WaitUntil([&]() { std::lock_guard<std::mutex> lock(mutex); return results.size() >= 10; }));
+    EXPECT_TRUE(calculator.Unsubscribe(stream_id));
+    std::lock_guard<std::mutex> lock(mutex);
+    for (double result : results) {
+        EXPECT_DOUBLE_EQ(result, 42.0);
+    }
+}
+
+TEST_F(StreamingTest, StreamsEndWithTheConnection) {
+    StartServer();
+    TickLog log;
+    auto channel = Connect();
+    TimeClient time(channel);
+    uint32_t stream_id = 0;
+    ASSERT_TRUE(time.Subscribe(10, log.Callback(), stream_id));
+    ASSERT_TRUE(WaitUntil([&]() { return log.Ticks() > 0; }));
+
+    server_->Stop();
+    ASSERT_TRUE(WaitUntil([&]() { return !log.End().empty(); }));
+    EXPECT_NE(log.End(), "Stream cancelled");
+}
+
+TEST_F(StreamingTest, NeedsPipelinedChannel) {
+    StartServer();
+    auto channel = std::make_shared<Channel>(socket_path_, ChannelOptions{1000, false});
+    uint32_t stream_id = 0;
+    EXPECT_FALSE(channel->Subscribe(TimeRpc::REQUEST_ROUTINE_ID, nullptr, 0, StreamOptions{},
+                                    [](bool, const uint8_t*, size_t, const std::string&) {}, stream_id));
+    EXPECT_NE(channel->GetLastError().find("pipelining"), std::string::npos);
+    EXPECT_THROW(channel->Subscribe(TimeRpc::REQUEST_ROUTINE_ID, nullptr, 0, StreamOptions{}, nullptr, stream_id),
+                 std::invalid_argument);
+}
@@ -7,6 +7,8 @@
 #include "ipc_sync/ByteBuffer.hpp"
 #include "ipc_sync/Protocol.hpp"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <ctime>
 
@@ -141,3 +143,37 @@ TEST_F(TimeServiceTest, TimestampFormat) {
     EXPECT_NE(timestamp.find('-'), std::string::npos);
     EXPECT_NE(timestamp.find(':'), std::string::npos);
 }
+
+TEST_F(TimeServiceTest, TimestampMatchesUnixTime) {
+    ByteBuffer req(input_buffer_.data(), input_buffer_.size());
+    req.PutByte(0x01);
+
+    // The formatted seconds are reused within a second; they must follow the clock
+    for (int i = 0; i < 3; ++i) {
+        size_t resp_len = service_->Execute(
+            input_buffer_.data(), req.Position(),
+            output_buffer_.data(), output_buffer_.size()
+        );
+        ASSERT_GT(resp_len, 0u);
+
+        ByteBuffer resp(output_buffer_.data(), resp_len);
+        resp.GetByte(); // START_BYTE
+        resp.GetInt();  // frame_len
+        resp.GetInt();  // routine_id
+        resp.GetByte(); // version
+        resp.GetByte(); // status
+        std::string timestamp = resp.GetString();
+        time_t unix_timestamp = static_cast<time_t>(resp.GetLong());
+
+        // Format: "YYYY-MM-DD HH:MM:SS.mmm"
+        struct tm tm_buf;
+        localtime_r(&unix_timestamp, &tm_buf);
+        char expected[32];
+        strftime(expected, sizeof(expected), "%Y-%m-%d %H:%M:%S", &tm_buf);
+        ASSERT_EQ(timestamp.length(), 23u);
+        EXPECT_EQ(timestamp.substr(0, 19), expected);
+        EXPECT_EQ(timestamp[19], '.');
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    }
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_timer_wheel.cpp
+ * @brief Unit tests for TimerWheel
+ */
+
+#include "TimerWheel.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace ipc_demo;
+
+namespace {
+
+constexpr uint32_t TICK_MS = 10;
+
+struct Timer {
+    int id;
+    TimerNode node;
+
+    explicit Timer(int timer_id) : id(timer_id) { node.owner = this; }
+};
+
+// Advance and return the IDs fired, in firing order
+std::vector<int> Fire(TimerWheel& wheel, uint64_t now_ms) {
+    std::vector<int> fired;
+    wheel.Advance(now_ms, [&fired](TimerNode& node) {
+        fired.push_back(static_cast<Timer*>(node.owner)->id);
+    });
+    return fired;
+}
+
+} // namespace
+
+TEST(TimerWheelTest, FiresAtDeadlineNeverEarly) {
+    TimerWheel wheel(1000, TICK_MS);
+    Timer a(1), b(2);
+    wheel.Schedule(a.node, 1055);  // Rounds up to tick 106
+    wheel.Schedule(b.node, 1030);
+    EXPECT_EQ(2u, wheel.Size());
+
+    EXPECT_TRUE(Fire(wheel, 1029).empty());
+    EXPECT_EQ(std::vector<int>{2}, Fire(wheel, 1030));
+    EXPECT_TRUE(Fire(wheel, 1055).empty());
+    EXPECT_EQ(std::vector<int>{1}, Fire(wheel, 1060));
+    EXPECT_EQ(0u, wheel.Size());
+    EXPECT_FALSE(a.node.IsScheduled());
+}
+
+TEST(TimerWheelTest, PastDeadlinesFireOnNextTick) {
+    TimerWheel wheel(1000, TICK_MS);
+    Timer a(1);
+    wheel.Schedule(a.node, 500);
+    EXPECT_TRUE(Fire(wheel, 1009).empty());
+    EXPECT_EQ(std::vector<int>{1}, Fire(wheel, 1010));
+}
+
+TEST(TimerWheelTest, CancelAndReschedule) {
+    TimerWheel wheel(0, TICK_MS);
+    Timer a(1), b(2);
+    wheel.Schedule(a.node, 100);
+    wheel.Schedule(b.node, 100);
+    wheel.Cancel(a.node);
+    wheel.Cancel(a.node);  // No-op
+    EXPECT_EQ(1u, wheel.Size());
+
+    // Moving a scheduled timer keeps one entry
+    wheel.Schedule(b.node, 300);
+    EXPECT_EQ(1u, wheel.Size());
+    EXPECT_TRUE(Fire(wheel, 200).empty());
+    EXPECT_EQ(std::vector<int>{2}, Fire(wheel, 300));
+}
+
+TEST(TimerWheelTest, CascadesThroughEveryLevel) {
+    TimerWheel wheel(0, 1);
+    // One timer per level boundary, plus odd offsets
+    std::vector<uint64_t> deadlines = {63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, 16777215};
+    std::vector<std::unique_ptr<Timer>> timers;
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        timers.push_back(std::make_unique<Timer>(static_cast<int>(i)));
+        wheel.Schedule(timers.back()->node, deadlines[i]);
+    }
+
+    // Step close to each deadline, then onto it
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        EXPECT_TRUE(Fire(wheel, deadlines[i] - 1).empty()) << "deadline " << deadlines[i];
+        EXPECT_EQ(std::vector<int>{static_cast<int>(i)}, Fire(wheel, deadlines[i])) << "deadline " << deadlines[i];
+    }
+    EXPECT_EQ(0u, wheel.Size());
+}
+
+TEST(TimerWheelTest, ParksDeadlinesBeyondTheTopLevel) {
+    TimerWheel wheel(0, 1);
+    Timer far(1);
+    uint64_t deadline = TimerWheel::MAX_TICKS + 12345;
+    wheel.Schedule(far.node, deadline);
+
+    EXPECT_TRUE(Fire(wheel, TimerWheel::MAX_TICKS).empty());
+    EXPECT_TRUE(Fire(wheel, deadline - 1).empty());
+    EXPECT_EQ(std::vector<int>{1}, Fire(wheel, deadline));
+}
+
+TEST(TimerWheelTest, CallbackMayCancelAndReschedule) {
+    TimerWheel wheel(0, TICK_MS);
+    Timer a(1), b(2), c(3);
+    wheel.Schedule(a.node, 50);
+    wheel.Schedule(b.node, 50);
+    wheel.Schedule(c.node, 50);
+
+    std::vector<int> fired;
+    size_t count = wheel.Advance(50, [&](TimerNode& node) {
+        Timer& timer = *static_cast<Timer*>(node.owner);
+        fired.push_back(timer.id);
+        if (timer.id == 1) {
+            wheel.Cancel(b.node);           // Due in the same tick, never fires
+            wheel.Schedule(a.node, 120);    // Re-armed from its own callback
+        }
+    });
+    EXPECT_EQ(2u, count);
+    EXPECT_EQ((std::vector<int>{1, 3}), fired);
+    EXPECT_EQ(1u, wheel.Size());
+    EXPECT_EQ(std::vector<int>{1}, Fire(wheel, 120));
+}
+
+TEST(TimerWheelTest, DestroyedNodesAndWheelsDetach) {
+    Timer outlives(1);
+    {
+        TimerWheel wheel(0, TICK_MS);
+        auto gone = std::make_unique<Timer>(2);
+        wheel.Schedule(gone->node, 100);
+        wheel.Schedule(outlives.node, 100);
+        wheel.Cancel(gone->node);
+        gone.reset();
+        EXPECT_EQ(std::vector<int>{1}, Fire(wheel, 100));
+        wheel.Schedule(outlives.node, 200);
+    }
+    EXPECT_FALSE(outlives.node.IsScheduled());
+}
+
+TEST(TimerWheelTest, ClockNeverMovesBackward) {
+    TimerWheel wheel(1000, TICK_MS);
+    Timer a(1);
+    wheel.Schedule(a.node, 1100);
+    EXPECT_TRUE(Fire(wheel, 500).empty());
+    EXPECT_EQ(std::vector<int>{1}, Fire(wheel, 1100));
+
+    uint64_t before = TimerWheel::CoarseNowMs();
+    EXPECT_GE(TimerWheel::CoarseNowMs(), before);
+}
+
+TEST(TimerWheelTest, RejectsZeroTick) {
+    EXPECT_THROW(TimerWheel(0, 0), std::invalid_argument);
+}
@@ -0,0 +1,395 @@
+/**
+ * @file test_tracer.cpp
+ * @brief Unit tests for the sampling tracer, and client/server spans end to end
+ */
+
+#include "ServerFixture.hpp"
+#include "ResponseBuilder.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/Tracer.hpp"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+using namespace ipc_demo::trace;
+
+namespace {
+
+constexpr uint32_t ECHO_ROUTINE = 0x3500;
+
+// Echoes its request; inline-safe or not, to pick where it runs
+class EchoService : public IService {
+public:
+    explicit EchoService(bool inline_safe) : inline_safe_(inline_safe) {}
+
+    uint32_t GetRequestRoutineId() const override { return ECHO_ROUTINE; }
+    uint32_t GetResponseRoutineId() const override { return ECHO_ROUTINE + 1; }
+    std::string GetName() const override { return "EchoService"; }
+    bool IsInlineSafe() const override { return inline_safe_; }
+
+    size_t Execute(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len) override {
+        ResponseBuilder response(GetResponseRoutineId(), output, output_len);
+        if (input_len > response.PayloadCapacity()) {
+            return 0;
+        }
+        std::copy(input, input + input_len, response.Payload());
+        return response.Finish(input_len);
+    }
+
+private:
+    bool inline_safe_;
+};
+
+std::vector<CollectedSpan> SpansOf(const std::vector<CollectedSpan>& spans, Side side) {
+    std::vector<CollectedSpan> matching;
+    for (const CollectedSpan& collected : spans) {
+        if (collected.span.side == side) {
+            matching.push_back(collected);
+        }
+    }
+    return matching;
+}
+
+Span StampedSpan(uint64_t trace_id) {
+    Span span;
+    span.trace_id = trace_id;
+    span.routine_id = ECHO_ROUTINE;
+    span.Mark(ServerStage::Received);
+    span.Mark(ServerStage::Parsed);
+    span.Mark(ServerStage::Executed);
+    span.Mark(ServerStage::Sent);
+    return span;
+}
+
+} // namespace
+
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // The tracer is process-wide; start from an empty one
+        Tracer::Global().TakeSpans();
+    }
+};
+
+TEST_F(TracerTest, SamplerRates) {
+    Sampler off(0.0);
+    EXPECT_FALSE(off.Enabled());
+    EXPECT_FALSE(off.Sample());
+
+    Sampler always(1.0);
+    EXPECT_TRUE(always.Enabled());
+    Sampler clamped(5.0);
+    Sampler negative(-1.0);
+    EXPECT_FALSE(negative.Enabled());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(always.Sample());
+        ASSERT_TRUE(clamped.Sample());
+    }
+
+    Sampler tenth(0.1);
+    int sampled = 0;
+    for (int i = 0; i < 100000; ++i) {
+        sampled += tenth.Sample() ? 1 : 0;
+    }
+    EXPECT_GT(sampled, 8000);
+    EXPECT_LT(sampled, 12000);
+}
+
+TEST_F(TracerTest, TraceIdsAreNonZeroAndDistinct) {
+    uint64_t first = NewTraceId();
+    uint64_t second = NewTraceId();
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(second, 0u);
+    EXPECT_NE(first, second);
+}
+
+TEST_F(TracerTest, RecordedSpansAreCollectedInOrder) {
+    for (uint64_t i = 1; i <= 10; ++i) {
+        Tracer::Global().Record(StampedSpan(i));
+    }
+    std::vector<CollectedSpan> spans = Tracer::Global().TakeSpans();
+    ASSERT_EQ(spans.size(), 10u);
+    for (size_t i = 0; i < spans.size(); ++i) {
+        EXPECT_EQ(spans[i].span.trace_id, i + 1);
+        EXPECT_NE(spans[i].thread_id, 0u);
+    }
+    EXPECT_TRUE(Tracer::Global().TakeSpans().empty());
+}
+
+TEST_F(TracerTest, FullRingDropsAndCounts) {
+    uint64_t dropped_before = Tracer::Global().Dropped();
+    // A fresh thread has an empty ring
+    std::thread recorder([]() {
+        for (size_t i = 0; i < Tracer::RING_CAPACITY + 100; ++i) {
+            Tracer::Global().Record(StampedSpan(i + 1));
+        }
+    });
+    recorder.join();
+
+    EXPECT_EQ(Tracer::Global().TakeSpans().size(), Tracer::RING_CAPACITY);
+    EXPECT_EQ(Tracer::Global().Dropped() - dropped_before, 100u);
+}
+
+TEST_F(TracerTest, CollectMakesRoomInTheRing) {
+    std::promise<void> filled;
+    std::promise<void> collected;
+    std::thread recorder([&]() {
+        for (size_t i = 0; i < Tracer::RING_CAPACITY; ++i) {
+            Tracer::Global().Record(StampedSpan(1));
+        }
+        filled.set_value();
+        collected.get_future().wait();
+        Tracer::Global().Record(StampedSpan(2));
+    });
+
+    filled.get_future().wait();
+    EXPECT_EQ(Tracer::Global().Collect(), Tracer::RING_CAPACITY);
+    collected.set_value();
+    recorder.join();
+
+    std::vector<CollectedSpan> spans = Tracer::Global().TakeSpans();
+    ASSERT_EQ(spans.size(), Tracer::RING_CAPACITY + 1);
+    EXPECT_EQ(spans.back().span.trace_id, 2u);
+}
+
+TEST_F(TracerTest, MarkActiveStampsOnlyTheScopedSpanOnce) {
+    MarkActive(ServerStage::Lookup);    // No active span: nothing to do
+
+    Span span;
+    {
+        ScopedActiveSpan active(&span);
+        MarkActive(ServerStage::Lookup);
+        uint64_t first = span.At(ServerStage::Lookup);
+        EXPECT_NE(first, 0u);
+        MarkActive(ServerStage::Lookup);
+        EXPECT_EQ(span.At(ServerStage::Lookup), first);
+
+        ScopedActiveSpan none(nullptr);
+        MarkActive(ServerStage::Executed);
+    }
+    EXPECT_EQ(span.At(ServerStage::Executed), 0u);
+    EXPECT_EQ(detail::active_span, nullptr);
+}
+
+TEST_F(TracerTest, TicksConvertToMonotonicNanoseconds) {
+    auto before = std::chrono::steady_clock::now().time_since_epoch();
+    uint64_t ticks = Now();
+    auto after = std::chrono::steady_clock::now().time_since_epoch();
+
+    EXPECT_GT(Tracer::Global().NsPerTick(), 0.0);
+    auto ns = static_cast<int64_t>(Tracer::Global().TicksToNs(ticks));
+    // Within a millisecond of where it was taken
+    EXPECT_GT(ns, std::chrono::duration_cast<std::chrono::nanoseconds>(before).count() - 1000000);
+    EXPECT_LT(ns, std::chrono::duration_cast<std::chrono::nanoseconds>(after).count() + 1000000);
+}
+
+TEST_F(TracerTest, ChromeTraceHasStagesAndFlows) {
+    Span client;
+    client.side = Side::Client;
+    client.trace_id = 0xabc;
+    client.routine_id = ECHO_ROUTINE;
+    client.Mark(ClientStage::Start);
+    client.Mark(ClientStage::Encoded);
+    client.Mark(ClientStage::Sent);
+    Span server = StampedSpan(0xabc);
+    client.Mark(ClientStage::Received);
+    client.Mark(ClientStage::Done);
+    Tracer::Global().Record(client);
+    Tracer::Global().Record(server);
+    Tracer::Global().Record(StampedSpan(0));    // Untraced by the client: no flow
+
+    std::string json = Tracer::Global().ExportChromeTrace();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\""), 0u);
+    EXPECT_NE(json.find("\"name\":\"client 0x3500\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"server 0x3500\""), std::string::npos);
+    for (const char* stage : {"\"encode\"", "\"send\"", "\"wait\"", "\"decode\"", "\"parse\"", "\"execute\""}) {
+        EXPECT_NE(json.find(stage), std::string::npos) << stage;
+    }
+    // Skipped stages get no interval
+    EXPECT_EQ(json.find("\"queue\""), std::string::npos);
+    EXPECT_EQ(json.find("\"lookup\""), std::string::npos);
+
+    EXPECT_NE(json.find("\"ph\":\"s\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"f\""), std::string::npos);
+    size_t flows = 0;
+    for (size_t at = json.find("\"id\":\"0xabc\""); at != std::string::npos; at = json.find("\"id\":\"0xabc\"", at + 1)) {
+        ++flows;
+    }
+    EXPECT_EQ(flows, 2u);
+
+    // Exporting took the spans
+    EXPECT_TRUE(Tracer::Global().TakeSpans().empty());
+}
+
+TEST_F(TracerTest, WriteChromeTrace) {
+    Tracer::Global().Record(StampedSpan(7));
+    std::string path = "/tmp/test_ipc_trace_" + std::to_string(getpid()) + ".json";
+    ASSERT_TRUE(Tracer::Global().WriteChromeTrace(path));
+
+    std::ifstream in(path);
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(json.find("\"trace_id\":\"0x7\""), std::string::npos);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(Tracer::Global().WriteChromeTrace("/nonexistent_dir/trace.json"));
+}
+
+class TracedServerTest : public ServerFixture {
+protected:
+    TracedServerTest() : ServerFixture("tracer") {}
+
+    void SetUp() override {
+        // As in TracerTest: no spans left over from earlier tests
+        Tracer::Global().TakeSpans();
+    }
+
+    void StartServer(double rate, ExecutionMode mode, bool inline_safe) {
+        manager_->RegisterService(std::make_shared<EchoService>(inline_safe));
+        ServerConfig config;
+        config.trace_sample_rate = rate;
+        config.execution_mode = mode;
+        config.worker_threads = 1;
+        ServerFixture::StartServer(config);
+    }
+
+    static bool Echo(Channel& channel, uint8_t value) {
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        // The response is a whole frame: its one payload byte precedes END_BYTE
+        return channel.ExecuteRPC(ECHO_ROUTINE, &value, 1, response, sizeof(response), response_len) &&
+               response_len == Protocol::GetMinFrameSize() + 1 && response[response_len - 2] == value;
+    }
+
+    // Server spans are recorded after the response is written
+    static std::vector<CollectedSpan> WaitForSpans(size_t count) {
+        std::vector<CollectedSpan> spans;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        while (spans.size() < count && std::chrono::steady_clock::now() < deadline) {
+            std::vector<CollectedSpan> more = Tracer::Global().TakeSpans();
+            spans.insert(spans.end(), more.begin(), more.end());
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return spans;
+    }
+
+    static void ExpectJoined(const std::vector<CollectedSpan>& spans, size_t calls, bool offloaded) {
+        std::vector<CollectedSpan> clients = SpansOf(spans, Side::Client);
+        std::vector<CollectedSpan> servers = SpansOf(spans, Side::Server);
+        ASSERT_EQ(clients.size(), calls);
+        ASSERT_EQ(servers.size(), calls);
+
+        for (size_t i = 0; i < calls; ++i) {
+            const Span& client = clients[i].span;
+            const Span& server = servers[i].span;
+            EXPECT_NE(client.trace_id, 0u);
+            EXPECT_EQ(server.trace_id, client.trace_id);
+            EXPECT_EQ(server.routine_id, ECHO_ROUTINE);
+
+            for (ClientStage stage : {ClientStage::Start, ClientStage::Encoded, ClientStage::Received,
+                                      ClientStage::Done}) {
+                EXPECT_NE(client.At(stage), 0u);
+            }
+            EXPECT_LE(client.At(ClientStage::Start), client.At(ClientStage::Encoded));
+            EXPECT_LE(client.At(ClientStage::Received), client.At(ClientStage::Done));
+
+            for (ServerStage stage : {ServerStage::Received, ServerStage::Parsed, ServerStage::Lookup,
+                                      ServerStage::Executed, ServerStage::Sent}) {
+                EXPECT_NE(server.At(stage), 0u);
+            }
+            EXPECT_EQ(server.At(ServerStage::Dequeued) != 0, offloaded);
+            EXPECT_LE(server.At(ServerStage::Received), server.At(ServerStage::Parsed));
+            EXPECT_LE(server.At(ServerStage::Lookup), server.At(ServerStage::Executed));
+            EXPECT_LE(server.At(ServerStage::Executed), server.At(ServerStage::Sent));
+
+            // The server's work happens while the client waits
+            EXPECT_LE(client.At(ClientStage::Encoded), server.At(ServerStage::Parsed));
+            EXPECT_LE(server.At(ServerStage::Executed), client.At(ClientStage::Received));
+        }
+    }
+};
+
+TEST_F(TracedServerTest, InlineRequestsShareTheClientTraceId) {
+    StartServer(1.0, ExecutionMode::Inline, true);
+    ChannelOptions options;
+    options.trace_sample_rate = 1.0;
+    Channel channel(socket_path_, options);
+
+    for (uint8_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(Echo(channel, i));
+    }
+    ExpectJoined(WaitForSpans(10), 5, false);
+}
+
+TEST_F(TracedServerTest, OffloadedRequestsRecordTheirQueueWait) {
+    StartServer(1.0, ExecutionMode::ThreadPool, false);
+    ChannelOptions options;
+    options.trace_sample_rate = 1.0;
+    Channel channel(socket_path_, options);
+
+    for (uint8_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(Echo(channel, i));
+    }
+    ExpectJoined(WaitForSpans(10), 5, true);
+}
+
+TEST_F(TracedServerTest, PipelinedCallsAreTraced) {
+    StartServer(1.0, ExecutionMode::Inline, true);
+    ChannelOptions options;
+    options.pipelining = true;
+    options.trace_sample_rate = 1.0;
+    Channel channel(socket_path_, options);
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(Echo(channel, i));
+    }
+    ExpectJoined(WaitForSpans(6), 3, false);
+}
+
+TEST_F(TracedServerTest, ServerWithoutSamplingIgnoresTraceIds) {
+    StartServer(0.0, ExecutionMode::Inline, true);
+    ChannelOptions options;
+    options.trace_sample_rate = 1.0;
+    Channel channel(socket_path_, options);
+
+    ASSERT_TRUE(Echo(channel, 1));
+    std::vector<CollectedSpan> spans = Tracer::Global().TakeSpans();
+    EXPECT_EQ(SpansOf(spans, Side::Client).size(), 1u);
+    EXPECT_TRUE(SpansOf(spans, Side::Server).empty());
+}
+
+TEST_F(TracedServerTest, UnpropagatedClientSpansHaveNoTraceId) {
+    StartServer(0.0, ExecutionMode::Inline, true);
+    ChannelOptions options;
+    options.trace_sample_rate = 1.0;
+    options.trace_propagation = false;
+    Channel channel(socket_path_, options);
+
+    ASSERT_TRUE(Echo(channel, 1));
+    std::vector<CollectedSpan> spans = Tracer::Global().TakeSpans();
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].span.side, Side::Client);
+    EXPECT_EQ(spans[0].span.trace_id, 0u);
+}
+
+TEST_F(TracedServerTest, UntracedClientsAreSampledByTheServer) {
+    StartServer(1.0, ExecutionMode::Inline, true);
+    Channel channel(socket_path_, 2000);
+
+    ASSERT_TRUE(Echo(channel, 1));
+    std::vector<CollectedSpan> spans = WaitForSpans(1);
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].span.side, Side::Server);
+    EXPECT_EQ(spans[0].span.trace_id, 0u);
+    EXPECT_NE(spans[0].span.At(ServerStage::Sent), 0u);
+}
@@ -0,0 +1,1641 @@
+/**
+ * @file test_uds_server.cpp
+ * @brief In-process tests for UDSServer (server and clients run in the test binary)
+ */
+
+#include "ServerFixture.hpp"
+#include "UDSServer.hpp"
+#include "ServiceManager.hpp"
+#include "CalculatorService.hpp"
+#include "TimeService.hpp"
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/ChannelPool.hpp"
+#include "ipc_sync/CalculatorClient.hpp"
+#include "ipc_sync/TimeClient.hpp"
+#include "ipc_sync/StatsClient.hpp"
+#include "ipc_sync/ByteBuffer.hpp"
+#include "ipc_sync/FrameParser.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include "ipc_sync/ShmTransport.hpp"
+#include "ipc_sync/FdPassing.hpp"
+#include "ipc_sync/IoUring.hpp"
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace ipc_demo;
+
+// Service that blocks for a while, to show whether it stalls other clients
+class SlowService : public IService {
+public:
+    static constexpr uint32_t REQUEST_ID = 0x3000;
+    static constexpr uint32_t RESPONSE_ID = 0x3001;
+
+    explicit SlowService(int delay_ms) : delay_ms_(delay_ms) {}
+
+    uint32_t GetRequestRoutineId() const override { return REQUEST_ID; }
+    uint32_t GetResponseRoutineId() const override { return RESPONSE_ID; }
+    std::string GetName() const override { return "SlowService"; }
+
+    size_t Execute(const uint8_t* input, size_t input_len,
+                   uint8_t* output, size_t output_len) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+
+        // Echo the first request byte back
+        ByteBuffer resp(output, output_len);
+        resp.PutByte(Protocol::START_BYTE);
+        resp.PutInt(0); // Placeholder for length
+        resp.PutInt(GetResponseRoutineId());
+        resp.PutByte(Protocol::VERSION);
+        resp.PutByte(input_len > 0 ? input[0] : 0);
+        resp.PutByte(Protocol::END_BYTE);
+
+        size_t frame_len = resp.Position();
+        resp.SetPosition(1);
+        resp.PutInt(static_cast<uint32_t>(frame_len));
+        return frame_len;
+    }
+
+private:
+    int delay_ms_;
+};
+
+// Slow service that records how many calls ran at the same time
+class ConcurrencyService : public SlowService {
+public:
+    explicit ConcurrencyService(int delay_ms) : SlowService(delay_ms) {}
+
+    size_t Execute(const uint8_t* input, size_t input_len,
+                   uint8_t* output, size_t output_len) override {
+        int now = ++running_;
+        int seen = max_running_.load();
+        while (now > seen && !max_running_.compare_exchange_weak(seen, now)) {
+        }
+        size_t len = SlowService::Execute(input, input_len, output, output_len);
+        --running_;
+        return len;
+    }
+
+    int Running() const { return running_.load(); }
+    int MaxRunning() const { return max_running_.load(); }
+
+private:
+    std::atomic<int> running_{0};
+    std::atomic<int> max_running_{0};
+};
+
+// Service that answers with the length and byte sum of its input, to check
+// large payloads arrive intact
+class ChecksumService : public IService {
+public:
+    static constexpr uint32_t REQUEST_ID = 0x3100;
+    static constexpr uint32_t RESPONSE_ID = 0x3101;
+
+    uint32_t GetRequestRoutineId() const override { return REQUEST_ID; }
+    uint32_t GetResponseRoutineId() const override { return RESPONSE_ID; }
+    std::string GetName() const override { return "ChecksumService"; }
+
+    size_t Execute(const uint8_t* input, size_t input_len,
+                   uint8_t* output, size_t output_len) override {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < input_len; ++i) {
+            sum += input[i];
+        }
+
+        ByteBuffer resp(output, output_len);
+        resp.PutByte(Protocol::START_BYTE);
+        resp.PutInt(0); // Placeholder for length
+        resp.PutInt(GetResponseRoutineId());
+        resp.PutByte(Protocol::VERSION);
+        resp.PutInt(static_cast<uint32_t>(input_len));
+        resp.PutInt(sum);
+        resp.PutByte(Protocol::END_BYTE);
+
+        size_t frame_len = resp.Position();
+        resp.SetPosition(1);
+        resp.PutInt(static_cast<uint32_t>(frame_len));
+        return frame_len;
+    }
+
+    // Parse a response frame into (length, sum)
+    static std::pair<uint32_t, uint32_t> Parse(const uint8_t* frame, size_t len) {
+        ByteBuffer buf(const_cast<uint8_t*>(frame), len);
+        buf.SetPosition(Protocol::GetMinFrameSize() - 1);
+        uint32_t length = buf.GetInt();
+        return {length, buf.GetInt()};
+    }
+};
+
+// Calculator request frame built by hand, for raw-socket tests
+std::vector<uint8_t> BuildCalculatorFrame(uint8_t op, double a, double b) {
+    uint8_t payload[1 + 2 * sizeof(double)];
+    ByteBuffer buf(payload, sizeof(payload));
+    buf.PutByte(op);
+    buf.PutDouble(a);
+    buf.PutDouble(b);
+    return ServerFixture::BuildFrame(0x1000, payload, sizeof(payload));
+}
+
+class UDSServerTest : public ServerFixture {
+protected:
+    UDSServerTest() : ServerFixture("uds_server") {}
+
+    void SetUp() override {
+        manager_->RegisterService(std::make_shared<CalculatorService>());
+        manager_->RegisterService(std::make_shared<TimeService>());
+    }
+
+    // Read calculator responses until count results arrived (or timeout)
+    static std::vector<double> ReadCalculatorResults(int fd, size_t count) {
+        FrameParser parser;
+        std::vector<double> results;
+        FrameView frame;
+        while (results.size() < count && NextFrame(fd, parser, frame, 2000)) {
+            ByteBuffer buf(const_cast<uint8_t*>(frame.payload), frame.payload_len);
+            buf.GetByte(); // status
+            results.push_back(buf.GetDouble());
+        }
+        return results;
+    }
+};
+
+TEST_F(UDSServerTest, RejectsZeroReactors) {
+    ServerConfig config;
+    config.num_reactors = 0;
+    EXPECT_THROW(UDSServer(socket_path_, manager_, config), std::invalid_argument);
+}
+
+TEST_F(UDSServerTest, DefaultConfigRoundTrip) {
+    StartServer(ServerConfig{});
+    EXPECT_EQ(server_->GetReactorCount(), 1u);
+
+    auto channel = Connect();
+    ASSERT_TRUE(channel->IsConnected());
+
+    Calculator calculator(channel);
+    auto result = calculator.Add(2.5, 4.0);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 6.5);
+
+    TimeClient time_client(channel);
+    auto time_result = time_client.GetCurrentTime();
+    ASSERT_TRUE(time_result.success) << time_result.error_message;
+    EXPECT_GT(time_result.unix_timestamp, 0);
+}
+
+TEST_F(UDSServerTest, ViewResultsPointIntoTheResponseBuffer) {
+    StartServer(ServerConfig{});
+    auto channel = Connect();
+    ASSERT_TRUE(channel->IsConnected());
+
+    auto inside = [](const ResponseBuffer& buffer, std::string_view view) {
+        const char* begin = reinterpret_cast<const char*>(buffer.data);
+        return view.data() >= begin && view.data() + view.size() <= begin + sizeof(buffer.data);
+    };
+
+    ResponseBuffer buffer;
+    Calculator calculator(channel);
+    auto sum = calculator.Add(2.5, 4.0, buffer);
+    ASSERT_TRUE(sum.success) << sum.error_message;
+    EXPECT_DOUBLE_EQ(6.5, sum.value);
+    EXPECT_TRUE(sum.error_message.empty());
+
+    auto quotient = calculator.Divide(1.0, 0.0, buffer);
+    EXPECT_FALSE(quotient.success);
+    ASSERT_FALSE(quotient.error_message.empty());
+    EXPECT_TRUE(inside(buffer, quotient.error_message));
+    EXPECT_EQ(calculator.Divide(1.0, 0.0).error_message, quotient.ToResult().error_message);
+
+    TimeClient time_client(channel);
+    auto time = time_client.GetCurrentTime(buffer);
+    ASSERT_TRUE(time.success) << time.error_message;
+    EXPECT_GT(time.unix_timestamp, 0);
+    EXPECT_FALSE(time.timestamp.empty());
+    EXPECT_TRUE(inside(buffer, time.timestamp));
+
+    // Transport errors are copied into the buffer too
+    server_->Stop();
+    auto failed = calculator.Add(1.0, 1.0, buffer);
+    EXPECT_FALSE(failed.success);
+    EXPECT_EQ(0u, failed.error_message.find("RPC failed"));
+    EXPECT_TRUE(inside(buffer, failed.error_message));
+}
+
+TEST_F(UDSServerTest, ChannelPoolPreConnectsAndBindsThreads) {
+    StartServer(ServerConfig{});
+
+    ChannelPoolOptions options;
+    options.size = 2;
+    options.channel.timeout_ms = 1000;
+    ChannelPool pool(socket_path_, options);
+    EXPECT_EQ(2u, pool.Size());
+    EXPECT_EQ(2u, pool.ConnectedCount());
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 2; }));
+
+    // A thread keeps its channel; threads are spread round-robin
+    const Channel* main_channel = pool.Get().get();
+    EXPECT_EQ(main_channel, pool.Get().get());
+
+    std::mutex mutex;
+    std::set<const Channel*> used{main_channel};
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            const std::shared_ptr<Channel>& channel = pool.Get();
+            if (channel != pool.Get()) {
+                failures++;
+            }
+            Calculator calculator(channel);
+            for (int i = 0; i < 20; ++i) {
+                if (!calculator.Add(i, 1).success) {
+                    failures++;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            used.insert(channel.get());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures.load());
+    EXPECT_EQ(2u, used.size());
+    EXPECT_EQ(2u, server_->GetClientCount());
+    EXPECT_THROW(pool.At(2), std::out_of_range);
+}
+
+TEST_F(UDSServerTest, ChannelPoolAffinitySurvivesOtherPools) {
+    StartServer(ServerConfig{});
+
+    ChannelPoolOptions options;
+    options.size = 2;
+    options.channel.timeout_ms = 1000;
+    ChannelPool first(socket_path_, options);
+    ChannelPool second(socket_path_, options);
+
+    // Binding to the second pool does not rebind the thread in the first
+    const Channel* channel = first.Get().get();
+    second.Get();
+    EXPECT_EQ(channel, first.Get().get());
+
+    // Threads new to the pool still spread round-robin
+    std::set<const Channel*> used{channel};
+    for (int t = 0; t < 3; ++t) {
+        std::thread([&]() { used.insert(first.Get().get()); }).join();
+    }
+    EXPECT_EQ(2u, used.size());
+}
+
+TEST_F(UDSServerTest, ChannelPoolHealthCheckReconnects) {
+    StartServer(ServerConfig{});
+
+    ChannelPoolOptions options;
+    options.size = 2;
+    options.channel.timeout_ms = 1000;
+    options.health_check_interval_ms = 20;
+    ChannelPool pool(socket_path_, options);
+    ASSERT_EQ(2u, pool.ConnectedCount());
+
+    // Idle channels notice the server going away without an RPC...
+    server_->Stop();
+    EXPECT_TRUE(WaitUntil([&pool]() { return pool.ConnectedCount() == 0; }));
+
+    // ...and are connected again before anyone uses them
+    StartServer(ServerConfig{});
+    EXPECT_TRUE(WaitUntil([&pool]() { return pool.ConnectedCount() == 2; }));
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 2; }));
+    EXPECT_TRUE(Calculator(pool.Get()).Add(1, 2).success);
+
+    options.health_check_interval_ms = -1;
+    EXPECT_THROW(ChannelPool(socket_path_, options), std::invalid_argument);
+}
+
+TEST_F(UDSServerTest, IdleConnectionsTimeOut) {
+    ServerConfig config;
+    config.inactivity_timeout_ms = 300;
+    StartServer(config);
+
+    auto idle = Connect();
+    auto active = Connect();
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 2; }));
+
+    // Activity keeps a connection open well past its timeout
+    Calculator calc(active);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(calc.Add(i, 1).success);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+    EXPECT_TRUE(calc.Add(1, 1).success);
+    EXPECT_EQ(1u, server_->GetClientCount());
+}
+
+TEST_F(UDSServerTest, ChannelRequestsItsOwnIdleTimeout) {
+    ServerConfig config;
+    config.inactivity_timeout_ms = 0;  // Never, unless the connection asks
+    StartServer(config);
+
+    ChannelOptions options{1000, false};
+    options.idle_timeout_ms = 200;
+    auto short_lived = Connect(options);
+    auto lasting = Connect();
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 2; }));
+
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(1u, server_->GetClientCount());
+
+    // The closed channel reconnects (and asks again) on its next call
+    EXPECT_TRUE(Calculator(short_lived).Add(2, 3).success);
+    EXPECT_TRUE(Calculator(lasting).Add(2, 3).success);
+}
+
+TEST_F(UDSServerTest, IdleTimeoutRequestsAreCapped) {
+    ServerConfig config;
+    config.inactivity_timeout_ms = 1000;
+    config.max_inactivity_timeout_ms = 5000;
+    StartServer(config);
+
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    auto negotiate = [fd](uint32_t requested) -> uint32_t {
+        uint8_t request[Protocol::GetMinFrameSize() + Protocol::IDLE_TIMEOUT_PAYLOAD_SIZE];
+        ByteBuffer req(request, sizeof(request));
+        req.PutByte(Protocol::START_BYTE);
+        req.PutInt(sizeof(request));
+        req.PutInt(Protocol::IDLE_TIMEOUT_REQUEST_ROUTINE_ID);
+        req.PutByte(Protocol::VERSION);
+        req.PutInt(requested);
+        req.PutByte(Protocol::END_BYTE);
+        EXPECT_EQ(static_cast<ssize_t>(sizeof(request)), send(fd, request, sizeof(request), 0));
+
+        uint8_t response[sizeof(request)];
+        size_t received = 0;
+        while (received < sizeof(response)) {
+            ssize_t n = recv(fd, response + received, sizeof(response) - received, 0);
+            if (n <= 0) {
+                return UINT32_MAX;
+            }
+            received += static_cast<size_t>(n);
+        }
+        ByteBuffer resp(response, sizeof(response));
+        resp.SetPosition(5);
+        EXPECT_EQ(Protocol::IDLE_TIMEOUT_RESPONSE_ROUTINE_ID, resp.GetInt());
+        resp.GetByte(); // version
+        return resp.GetInt();
+    };
+
+    EXPECT_EQ(5000u, negotiate(60000));
+    EXPECT_EQ(250u, negotiate(250));
+    EXPECT_EQ(1000u, negotiate(0));
+    close(fd);
+}
+
+TEST_F(UDSServerTest, RoundRobinSpreadsClientsAcrossReactors) {
+    ServerConfig config;
+    config.num_reactors = 4;
+    config.accept_policy = AcceptPolicy::RoundRobin;
+    StartServer(config);
+
+    std::vector<std::shared_ptr<Channel>> channels;
+    for (int i = 0; i < 8; ++i) {
+        channels.push_back(Connect());
+        ASSERT_TRUE(channels.back()->IsConnected());
+    }
+
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 8; }));
+    for (size_t i = 0; i < server_->GetReactorCount(); ++i) {
+        EXPECT_EQ(server_->GetReactorClientCount(i), 2u) << "reactor " << i;
+    }
+}
+
+TEST_F(UDSServerTest, LeastLoadedFillsEmptiestReactor) {
+    ServerConfig config;
+    config.num_reactors = 3;
+    config.accept_policy = AcceptPolicy::LeastLoaded;
+    StartServer(config);
+
+    std::vector<std::shared_ptr<Channel>> channels;
+    for (int i = 0; i < 6; ++i) {
+        channels.push_back(Connect());
+        ASSERT_TRUE(WaitUntil([&]() { return server_->GetClientCount() == channels.size(); }));
+    }
+
+    for (size_t i = 0; i < server_->GetReactorCount(); ++i) {
+        EXPECT_EQ(server_->GetReactorClientCount(i), 2u) << "reactor " << i;
+    }
+
+    // Freed slots are refilled first
+    channels[0].reset();
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 5; }));
+    channels.push_back(Connect());
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 6; }));
+    for (size_t i = 0; i < server_->GetReactorCount(); ++i) {
+        EXPECT_EQ(server_->GetReactorClientCount(i), 2u) << "reactor " << i;
+    }
+}
+
+TEST_F(UDSServerTest, ConcurrentClientsOnMultipleReactors) {
+    ServerConfig config;
+    config.num_reactors = 4;
+    StartServer(config);
+
+    constexpr int NUM_THREADS = 8;
+    constexpr int OPERATIONS_PER_THREAD = 50;
+    std::atomic<int> success_count{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([this, &success_count, i]() {
+            auto channel = Connect();
+            Calculator calculator(channel);
+            for (int j = 0; j < OPERATIONS_PER_THREAD; ++j) {
+                auto result = calculator.Multiply(i, j);
+                if (result.success && result.value == static_cast<double>(i * j)) {
+                    success_count++;
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(success_count.load(), NUM_THREADS * OPERATIONS_PER_THREAD);
+}
+
+TEST_F(UDSServerTest, StopDisconnectsClients) {
+    ServerConfig config;
+    config.num_reactors = 2;
+    StartServer(config);
+
+    auto channel = Connect();
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+
+    server_->Stop();
+    EXPECT_FALSE(server_->IsRunning());
+    EXPECT_EQ(server_->GetClientCount(), 0u);
+    EXPECT_NE(access(socket_path_.c_str(), F_OK), 0);
+}
+
+TEST_F(UDSServerTest, ThreadPoolModeDoesNotStallInlineClients) {
+    manager_->RegisterService(std::make_shared<SlowService>(400));
+
+    ServerConfig config;
+    config.num_reactors = 1;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto slow_channel = Connect();
+    auto fast_channel = Connect();
+    ASSERT_TRUE(slow_channel->IsConnected());
+    ASSERT_TRUE(fast_channel->IsConnected());
+
+    std::atomic<bool> slow_ok{false};
+    std::thread slow_caller([&]() {
+        uint8_t request[1] = {0x5A};
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        bool ok = slow_channel->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                           response, sizeof(response), response_len);
+        slow_ok = ok && response_len == 12 && response[10] == 0x5A;
+    });
+
+    // Let the slow request reach the worker pool
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Calculator calculator(fast_channel);
+    auto start = std::chrono::steady_clock::now();
+    auto result = calculator.Add(1.0, 2.0);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 3.0);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 200);
+
+    slow_caller.join();
+    EXPECT_TRUE(slow_ok.load());
+}
+
+TEST_F(UDSServerTest, ThreadPoolModeServesOffloadedRequestsInOrder) {
+    manager_->RegisterService(std::make_shared<SlowService>(5));
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    StartServer(config);
+
+    auto channel = Connect();
+    Calculator calculator(channel);
+    TimeClient time_client(channel);
+
+    // Alternate offloaded (slow, time) and inline (calculator) requests
+    for (int i = 0; i < 20; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        ASSERT_TRUE(channel->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                        response, sizeof(response), response_len));
+        EXPECT_EQ(response[10], static_cast<uint8_t>(i));
+
+        auto sum = calculator.Add(i, 1);
+        ASSERT_TRUE(sum.success) << sum.error_message;
+        EXPECT_DOUBLE_EQ(sum.value, i + 1.0);
+
+        auto now = time_client.GetCurrentTime();
+        ASSERT_TRUE(now.success) << now.error_message;
+    }
+}
+
+TEST_F(UDSServerTest, WorkStealingPoolServesConcurrentCalls) {
+    manager_->RegisterService(std::make_shared<SlowService>(1));
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    config.worker_pool = WorkerPoolKind::WorkStealing;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{3000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    constexpr int CALLS = 64;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+
+    // Tagged requests run concurrently on the pool; each echoes its byte
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        EXPECT_EQ(response.frame[10], static_cast<uint8_t>(i));
+    }
+
+    TimeClient time_client(channel);
+    EXPECT_TRUE(time_client.GetCurrentTime().success);
+}
+
+TEST_F(UDSServerTest, ConnectionLimitRejectsWithServerBusy) {
+    manager_->RegisterService(std::make_shared<SlowService>(50));
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    config.max_pending_per_connection = 4;
+    config.overload_policy = OverloadPolicy::Reject;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{3000, true});
+    constexpr int CALLS = 16;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+
+    int served = 0;
+    int busy = 0;
+    for (auto& future : futures) {
+        auto response = future.get();
+        if (response.success) {
+            ++served;
+        } else {
+            EXPECT_EQ(response.error_message, "Server busy");
+            ++busy;
+        }
+    }
+    EXPECT_GE(served, 4);
+    EXPECT_GE(busy, 1);
+    EXPECT_EQ(served + busy, CALLS);
+
+    // Shedding leaves the connection usable
+    uint8_t request[1] = {42};
+    auto response = channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)).get();
+    ASSERT_TRUE(response.success) << response.error_message;
+    EXPECT_EQ(response.frame[10], 42);
+}
+
+TEST_F(UDSServerTest, ConnectionLimitBackpressureBoundsConcurrency) {
+    auto service = std::make_shared<ConcurrencyService>(10);
+    manager_->RegisterService(service);
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    config.max_pending_per_connection = 2;
+    config.overload_policy = OverloadPolicy::Backpressure;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{5000, true});
+    constexpr int CALLS = 24;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+
+    // Nothing is shed; the reactor just stops reading beyond two requests
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        EXPECT_EQ(response.frame[10], static_cast<uint8_t>(i));
+    }
+    EXPECT_LE(service->MaxRunning(), 2);
+}
+
+TEST_F(UDSServerTest, FullWorkerPoolRejectsOtherClients) {
+    auto service = std::make_shared<ConcurrencyService>(300);
+    manager_->RegisterService(service);
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 1;
+    config.max_queued_requests = 1;
+    config.overload_policy = OverloadPolicy::Reject;
+    StartServer(config);
+
+    // One call occupies the only worker, the next one takes the only queue slot
+    auto pipelined = Connect(ChannelOptions{3000, true});
+    std::vector<std::future<RPCResponse>> futures;
+    auto call = [&](uint8_t byte) {
+        uint8_t request[1] = {byte};
+        futures.push_back(pipelined->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    };
+    call(0);
+    ASSERT_TRUE(WaitUntil([&]() { return service->Running() == 1; }));
+    call(1);
+
+    // Same connection, so it is read after call 1: it finds the queue full
+    call(2);
+    auto shed = futures.back().get();
+    futures.pop_back();
+    EXPECT_FALSE(shed.success);
+    EXPECT_EQ(shed.error_message, "Server busy");
+
+    // The bound is global: a blocking client on another reactor is shed too
+    auto blocking = Connect();
+    uint8_t request[1] = {9};
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    size_t response_len = 0;
+    EXPECT_FALSE(blocking->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                      response, sizeof(response), response_len));
+    EXPECT_EQ(blocking->GetLastError(), "Server busy");
+
+    // Inline services are not queued, so they are never shed
+    Calculator calculator(blocking);
+    EXPECT_TRUE(calculator.Add(1, 2).success);
+
+    for (auto& future : futures) {
+        auto result = future.get();
+        EXPECT_TRUE(result.success) << result.error_message;
+    }
+}
+
+TEST_F(UDSServerTest, FullWorkerPoolBackpressureServesEveryRequest) {
+    manager_->RegisterService(std::make_shared<SlowService>(2));
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 1;
+    config.max_queued_requests = 1;
+    config.overload_policy = OverloadPolicy::Backpressure;
+    StartServer(config);
+
+    // Two pipelined clients on different reactors compete for one queue slot
+    std::vector<std::shared_ptr<Channel>> channels = {Connect(ChannelOptions{5000, true}),
+                                                      Connect(ChannelOptions{5000, true})};
+    constexpr int CALLS = 32;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channels[i % 2]->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        EXPECT_EQ(response.frame[10], static_cast<uint8_t>(i));
+    }
+}
+
+TEST_F(UDSServerTest, CoalescedFramesAreAllAnswered) {
+    StartServer(ServerConfig{});
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    // Three requests in a single write
+    std::vector<uint8_t> stream;
+    for (int i = 1; i <= 3; ++i) {
+        auto frame = BuildCalculatorFrame(0x01, i, 100.0);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    ASSERT_EQ(send(fd, stream.data(), stream.size(), 0), static_cast<ssize_t>(stream.size()));
+
+    auto results = ReadCalculatorResults(fd, 3);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_DOUBLE_EQ(results[0], 101.0);
+    EXPECT_DOUBLE_EQ(results[1], 102.0);
+    EXPECT_DOUBLE_EQ(results[2], 103.0);
+    close(fd);
+}
+
+TEST_F(UDSServerTest, FrameSplitAcrossWritesIsReassembled) {
+    StartServer(ServerConfig{});
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    auto first = BuildCalculatorFrame(0x03, 6.0, 7.0);
+    auto second = BuildCalculatorFrame(0x02, 10.0, 4.0);
+    std::vector<uint8_t> stream(first);
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    // Cut inside the header of the second frame, then inside its payload
+    size_t cut1 = first.size() + 3;
+    size_t cut2 = first.size() + 15;
+    ASSERT_EQ(send(fd, stream.data(), cut1, 0), static_cast<ssize_t>(cut1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(send(fd, stream.data() + cut1, cut2 - cut1, 0), static_cast<ssize_t>(cut2 - cut1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(send(fd, stream.data() + cut2, stream.size() - cut2, 0),
+              static_cast<ssize_t>(stream.size() - cut2));
+
+    auto results = ReadCalculatorResults(fd, 2);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_DOUBLE_EQ(results[0], 42.0);
+    EXPECT_DOUBLE_EQ(results[1], 6.0);
+    close(fd);
+}
+
+TEST_F(UDSServerTest, LargeBurstIsDrainedAndFlushed) {
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    // More requests than fit in one read and than the responses fit in
+    // the socket buffer, so both the drain loop and the send queue run
+    constexpr int COUNT = 2000;
+    std::thread writer([fd]() {
+        for (int i = 0; i < COUNT; ++i) {
+            auto frame = BuildCalculatorFrame(0x01, i, 0.0);
+            send(fd, frame.data(), frame.size(), MSG_NOSIGNAL);
+        }
+    });
+
+    auto results = ReadCalculatorResults(fd, COUNT);
+    writer.join();
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; ++i) {
+        EXPECT_DOUBLE_EQ(results[i], static_cast<double>(i));
+    }
+    close(fd);
+}
+
+TEST_F(UDSServerTest, CorruptStreamClosesConnection) {
+    StartServer(ServerConfig{});
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+
+    const uint8_t garbage[16] = {0x00, 0x01, 0x02};
+    ASSERT_EQ(send(fd, garbage, sizeof(garbage), 0), static_cast<ssize_t>(sizeof(garbage)));
+
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0); // Orderly close by the server
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 0; }));
+    close(fd);
+}
+
+TEST_F(UDSServerTest, PipelinedChannelCompletesOutOfOrder) {
+    manager_->RegisterService(std::make_shared<SlowService>(400));
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{1000, true});
+    ASSERT_TRUE(channel->IsConnected());
+    ASSERT_TRUE(channel->IsPipelined());
+
+    std::atomic<bool> slow_ok{false};
+    std::thread slow_caller([&]() {
+        uint8_t request[1] = {0x42};
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        bool ok = channel->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                      response, sizeof(response), response_len);
+        // Request ID extension is stripped before the response is handed back
+        slow_ok = ok && response_len == 12 && response[9] == Protocol::VERSION && response[10] == 0x42;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Same socket, answered while the slow request is still executing
+    Calculator calculator(channel);
+    auto start = std::chrono::steady_clock::now();
+    auto result = calculator.Multiply(6.0, 7.0);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 42.0);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 200);
+
+    slow_caller.join();
+    EXPECT_TRUE(slow_ok.load());
+}
+
+TEST_F(UDSServerTest, PipelinedChannelOverlapsCallsFromManyThreads) {
+    manager_->RegisterService(std::make_shared<SlowService>(200));
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 8;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{2000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    constexpr int THREADS = 8;
+    std::atomic<int> ok_count{0};
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            uint8_t request[1] = {static_cast<uint8_t>(t)};
+            uint8_t response[Protocol::MAX_PACKET_SIZE];
+            size_t response_len = 0;
+            if (channel->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                    response, sizeof(response), response_len) &&
+                response[10] == static_cast<uint8_t>(t)) {
+                ++ok_count;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(ok_count.load(), THREADS);
+    // Serialized calls would take THREADS * 200 ms
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 1000);
+    EXPECT_EQ(server_->GetClientCount(), 1u);
+}
+
+TEST_F(UDSServerTest, PipelinedChannelConcurrentCalculatorCalls) {
+    ServerConfig config;
+    config.num_reactors = 2;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{2000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    constexpr int THREADS = 8;
+    constexpr int CALLS = 200;
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            Calculator calculator(channel);
+            for (int i = 0; i < CALLS; ++i) {
+                auto result = calculator.Add(t * 1000.0, i);
+                if (!result.success || result.value != t * 1000.0 + i) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST_F(UDSServerTest, PipelinedChannelFailsOutstandingCallsOnDisconnect) {
+    manager_->RegisterService(std::make_shared<SlowService>(500));
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 1;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{3000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::thread caller([&]() {
+        uint8_t request[1] = {0x01};
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        ok = channel->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                 response, sizeof(response), response_len);
+        done = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    channel->Disconnect();
+
+    // Fails promptly instead of waiting for the 3 second timeout
+    EXPECT_TRUE(WaitUntil([&]() { return done.load(); }, 1000));
+    caller.join();
+    EXPECT_FALSE(ok.load());
+    EXPECT_FALSE(channel->GetLastError().empty());
+}
+
+TEST_F(UDSServerTest, AsyncFuturesFanOutFromOneThread) {
+    StartServer(ServerConfig{});
+    auto channel = Connect(ChannelOptions{2000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    Calculator calculator(channel);
+    constexpr int CALLS = 1000;
+    std::vector<std::future<Calculator::Result>> futures;
+    futures.reserve(CALLS);
+    for (int i = 0; i < CALLS; ++i) {
+        futures.push_back(calculator.AddAsync(i, 0.5));
+    }
+
+    for (int i = 0; i < CALLS; ++i) {
+        auto result = futures[i].get();
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_DOUBLE_EQ(result.value, i + 0.5);
+    }
+
+    TimeClient time_client(channel);
+    auto time_result = time_client.GetCurrentTimeAsync().get();
+    ASSERT_TRUE(time_result.success) << time_result.error_message;
+    EXPECT_GT(time_result.unix_timestamp, 0);
+}
+
+TEST_F(UDSServerTest, AsyncCallbacksComplete) {
+    StartServer(ServerConfig{});
+    auto channel = Connect(ChannelOptions{2000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    Calculator calculator(channel);
+    constexpr int CALLS = 2000;
+    std::atomic<int> completed{0};
+    std::atomic<int> failed{0};
+
+    for (int i = 0; i < CALLS; ++i) {
+        calculator.MultiplyAsync(i, 2.0, [&completed, &failed, i](const Calculator::Result& result) {
+            if (!result.success || result.value != i * 2.0) {
+                ++failed;
+            }
+            ++completed;
+        });
+    }
+
+    EXPECT_TRUE(WaitUntil([&]() { return completed.load() == CALLS; }));
+    EXPECT_EQ(failed.load(), 0);
+}
+
+TEST_F(UDSServerTest, AsyncCallTimesOutWithoutBlockingTheChannel) {
+    manager_->RegisterService(std::make_shared<SlowService>(500));
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 1;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{150, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    uint8_t request[1] = {0x07};
+    auto start = std::chrono::steady_clock::now();
+    auto response = channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)).get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(response.success);
+    EXPECT_EQ(response.error_message, "Receive timeout");
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 400);
+
+    // The late response is dropped and the channel keeps working
+    Calculator calculator(channel);
+    auto result = calculator.Add(1.0, 1.0);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 2.0);
+}
+
+TEST_F(UDSServerTest, AsyncRequiresPipelinedChannel) {
+    StartServer(ServerConfig{});
+    auto channel = Connect();
+    ASSERT_TRUE(channel->IsConnected());
+
+    Calculator calculator(channel);
+    auto result = calculator.AddAsync(1.0, 2.0).get();
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error_message.find("pipelining"), std::string::npos);
+    EXPECT_THROW(channel->ExecuteRPCAsync(0x1000, nullptr, 0, RPCCallback()), std::invalid_argument);
+}
+
+TEST_F(UDSServerTest, AddBatchSpansSeveralFrames) {
+    StartServer(ServerConfig{});
+    auto channel = Connect();
+    ASSERT_TRUE(channel->IsConnected());
+
+    std::vector<std::pair<double, double>> operands;
+    for (int i = 0; i < 500; ++i) { // Several MAX_BATCH_CALLS frames
+        operands.emplace_back(i, 0.25);
+    }
+
+    Calculator calculator(channel);
+    auto results = calculator.AddBatch(operands);
+    ASSERT_EQ(results.size(), operands.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_TRUE(results[i].success) << results[i].error_message;
+        EXPECT_DOUBLE_EQ(results[i].value, i + 0.25);
+    }
+}
+
+TEST_F(UDSServerTest, MixedBatchOnPipelinedPoolServer) {
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{2000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    uint8_t calc_request[17];
+    ByteBuffer calc(calc_request, sizeof(calc_request));
+    calc.PutByte(0x03); // Multiply
+    calc.PutDouble(3.0);
+    calc.PutDouble(5.0);
+    uint8_t time_request[1] = {0x01};
+
+    std::vector<BatchCall> calls = {
+        {0x1000, calc_request, sizeof(calc_request)},
+        {0x2000, time_request, sizeof(time_request)},
+        {0x7777, nullptr, 0}, // No such service
+    };
+    std::vector<RPCResponse> responses;
+    ASSERT_TRUE(channel->ExecuteBatch(calls, responses)) << channel->GetLastError();
+    ASSERT_EQ(responses.size(), 3u);
+
+    ASSERT_TRUE(responses[0].success);
+    ByteBuffer calc_response(responses[0].frame.data(), responses[0].frame.size());
+    calc_response.SetPosition(5);
+    EXPECT_EQ(calc_response.GetInt(), 0x1001u);
+    calc_response.SetPosition(11);
+    EXPECT_DOUBLE_EQ(calc_response.GetDouble(), 15.0);
+
+    ASSERT_TRUE(responses[1].success);
+    ByteBuffer time_response(responses[1].frame.data(), responses[1].frame.size());
+    time_response.SetPosition(5);
+    EXPECT_EQ(time_response.GetInt(), 0x2001u);
+
+    EXPECT_FALSE(responses[2].success);
+}
+
+ChannelOptions SharedMemoryOptions(int timeout_ms, bool pipelining) {
+    ChannelOptions options;
+    options.timeout_ms = timeout_ms;
+    options.pipelining = pipelining;
+    options.transport = Transport::SharedMemory;
+    return options;
+}
+
+TEST_F(UDSServerTest, SharedMemoryChannelServesCalls) {
+    StartServer(ServerConfig{});
+    auto channel = Connect(SharedMemoryOptions(1000, false));
+    ASSERT_TRUE(channel->IsConnected());
+    EXPECT_TRUE(channel->IsSharedMemoryActive());
+
+    Calculator calculator(channel);
+    for (int i = 0; i < 200; ++i) {
+        auto result = calculator.Add(i, 1.5);
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_DOUBLE_EQ(result.value, i + 1.5);
+    }
+
+    TimeClient time_client(channel);
+    auto time_result = time_client.GetCurrentTime();
+    ASSERT_TRUE(time_result.success) << time_result.error_message;
+
+    auto batch = calculator.AddBatch({{1.0, 2.0}, {3.0, 4.0}});
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_DOUBLE_EQ(batch[1].value, 7.0);
+}
+
+TEST_F(UDSServerTest, SharedMemoryPipelinedFanOut) {
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto channel = Connect(SharedMemoryOptions(3000, true));
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+
+    // Far more response bytes than the smallest ring holds
+    Calculator calculator(channel);
+    constexpr int CALLS = 5000;
+    std::vector<std::future<Calculator::Result>> futures;
+    futures.reserve(CALLS);
+    for (int i = 0; i < CALLS; ++i) {
+        futures.push_back(calculator.MultiplyAsync(i, 2.0));
+    }
+
+    for (int i = 0; i < CALLS; ++i) {
+        auto result = futures[i].get();
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_DOUBLE_EQ(result.value, i * 2.0);
+    }
+}
+
+TEST_F(UDSServerTest, SharedMemoryBackpressureWithSmallRing) {
+    StartServer(ServerConfig{});
+    ChannelOptions options = SharedMemoryOptions(3000, true);
+    options.shm_ring_capacity = ShmTransport::MIN_RING_CAPACITY;
+    auto channel = Connect(options);
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+
+    // Callbacks are slow, so the server fills the response ring and must
+    // wait for the client to ring back
+    Calculator calculator(channel);
+    constexpr int CALLS = 3000;
+    std::atomic<int> completed{0};
+    std::atomic<int> failed{0};
+    for (int i = 0; i < CALLS; ++i) {
+        calculator.AddAsync(i, 1.0, [&completed, &failed, i](const Calculator::Result& result) {
+            if (!result.success || result.value != i + 1.0) {
+                ++failed;
+            }
+            if (completed.load() % 500 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            ++completed;
+        });
+    }
+
+    EXPECT_TRUE(WaitUntil([&]() { return completed.load() == CALLS; }, 5000));
+    EXPECT_EQ(failed.load(), 0);
+}
+
+TEST_F(UDSServerTest, SharedMemoryBackpressureAtConnectionLimit) {
+    auto service = std::make_shared<ConcurrencyService>(5);
+    manager_->RegisterService(service);
+
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    config.max_pending_per_connection = 3;
+    StartServer(config);
+
+    auto channel = Connect(SharedMemoryOptions(5000, true));
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+
+    // The reactor leaves the request ring alone while three calls are out
+    constexpr int CALLS = 40;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        EXPECT_EQ(response.frame[10], static_cast<uint8_t>(i));
+    }
+    EXPECT_LE(service->MaxRunning(), 3);
+}
+
+TEST_F(UDSServerTest, SharedMemoryRefusedFallsBackToSocket) {
+    ServerConfig config;
+    config.enable_shared_memory = false;
+    StartServer(config);
+
+    auto channel = Connect(SharedMemoryOptions(1000, false));
+    ASSERT_TRUE(channel->IsConnected());
+    EXPECT_FALSE(channel->IsSharedMemoryActive());
+
+    Calculator calculator(channel);
+    auto result = calculator.Subtract(5.0, 3.0);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_DOUBLE_EQ(result.value, 2.0);
+}
+
+TEST_F(UDSServerTest, SharedMemoryBusyWhileTaggedRequestsAreOffloaded) {
+    manager_->RegisterService(std::make_shared<SlowService>(300));
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 1;
+    StartServer(config);
+
+    int fd = ConnectRaw();
+    ASSERT_GE(fd, 0);
+    uint8_t value = 7;
+    ASSERT_TRUE(SendFrame(fd, BuildFrame(SlowService::REQUEST_ID, &value, 1, 0, 1u)));
+
+    // Its answer would take the ring while the slow one still owes the socket
+    std::string error;
+    std::shared_ptr<ShmTransport> transport = ShmTransport::Create(ShmTransport::MIN_RING_CAPACITY, error);
+    ASSERT_TRUE(transport) << error;
+    std::vector<uint8_t> offer = BuildFrame(Protocol::SHM_NEGOTIATE_REQUEST_ROUTINE_ID, nullptr, 0, 0, 2u);
+    int fds[3] = {transport->MemFd(), transport->RequestEventFd(), transport->ResponseEventFd()};
+    ASSERT_EQ(SendWithFds(fd, offer.data(), offer.size(), fds, 3), static_cast<ssize_t>(offer.size()));
+
+    FrameParser parser;
+    FrameView frame;
+    ASSERT_TRUE(NextFrame(fd, parser, frame));
+    ASSERT_EQ(frame.routine_id, Protocol::SHM_NEGOTIATE_RESPONSE_ROUTINE_ID);
+    EXPECT_EQ(frame.payload[frame.payload_len - 1], Protocol::SHM_BUSY);
+
+    // The slow answer still comes back on the socket
+    ASSERT_TRUE(NextFrame(fd, parser, frame, 2000));
+    EXPECT_EQ(frame.routine_id, SlowService::RESPONSE_ID);
+    EXPECT_EQ(frame.payload[frame.payload_len - 1], value);
+    close(fd);
+}
+
+TEST_F(UDSServerTest, SharedMemoryChannelNoticesServerStop) {
+    StartServer(ServerConfig{});
+    auto channel = Connect(SharedMemoryOptions(3000, false));
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+
+    Calculator calculator(channel);
+    ASSERT_TRUE(calculator.Add(1.0, 1.0).success);
+
+    server_->Stop();
+
+    // The closed socket is noticed without waiting for the full timeout
+    auto start = std::chrono::steady_clock::now();
+    auto result = calculator.Add(1.0, 1.0);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(result.success);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 2000);
+}
+
+std::vector<uint8_t> MakeLargePayload(size_t len, uint32_t& sum) {
+    std::vector<uint8_t> payload(len);
+    sum = 0;
+    for (size_t i = 0; i < len; ++i) {
+        payload[i] = static_cast<uint8_t>(i * 31 + 7);
+        sum += payload[i];
+    }
+    return payload;
+}
+
+TEST_F(UDSServerTest, LargePayloadPassedAsMemfd) {
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    StartServer(ServerConfig{});
+    auto channel = Connect();
+    ASSERT_TRUE(channel->IsConnected());
+
+    // Inline, just over the threshold, and far beyond MAX_PACKET_SIZE
+    for (size_t len : {size_t{100}, size_t{4097}, size_t{4 * 1024 * 1024}}) {
+        uint32_t sum = 0;
+        auto payload = MakeLargePayload(len, sum);
+
+        uint8_t response[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        ASSERT_TRUE(channel->ExecuteRPC(ChecksumService::REQUEST_ID, payload.data(), payload.size(),
+                                        response, sizeof(response), response_len))
+            << channel->GetLastError();
+        auto [length, checksum] = ChecksumService::Parse(response, response_len);
+        EXPECT_EQ(length, len);
+        EXPECT_EQ(checksum, sum);
+    }
+
+    // The connection keeps working for ordinary calls afterwards
+    Calculator calculator(channel);
+    EXPECT_TRUE(calculator.Add(1.0, 2.0).success);
+}
+
+TEST_F(UDSServerTest, LargePayloadsPipelinedOnPoolServer) {
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    ServerConfig config;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{3000, true});
+    ASSERT_TRUE(channel->IsConnected());
+
+    constexpr int CALLS = 20;
+    std::vector<uint32_t> sums(CALLS);
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        auto payload = MakeLargePayload(64 * 1024 + i * 1000, sums[i]);
+        futures.push_back(channel->ExecuteRPCAsync(ChecksumService::REQUEST_ID, payload.data(), payload.size()));
+    }
+
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        auto [length, checksum] = ChecksumService::Parse(response.frame.data(), response.frame.size());
+        EXPECT_EQ(length, 64u * 1024 + i * 1000);
+        EXPECT_EQ(checksum, sums[i]);
+    }
+}
+
+TEST_F(UDSServerTest, LargePayloadRejectedOverSharedMemory) {
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    StartServer(ServerConfig{});
+    auto channel = Connect(SharedMemoryOptions(1000, false));
+    ASSERT_TRUE(channel->IsSharedMemoryActive());
+
+    std::vector<uint8_t> payload(Protocol::MAX_PACKET_SIZE * 2, 1);
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    size_t response_len = 0;
+    EXPECT_FALSE(channel->ExecuteRPC(ChecksumService::REQUEST_ID, payload.data(), payload.size(),
+                                     response, sizeof(response), response_len));
+    EXPECT_NE(channel->GetLastError().find("socket transport"), std::string::npos);
+}
+
+TEST_F(UDSServerTest, LargePayloadFrameWithoutDescriptorClosesConnection) {
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    StartServer(ServerConfig{});
+
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    std::vector<uint8_t> frame(Protocol::GetMinFrameSize() + Protocol::FD_PAYLOAD_HEADER_SIZE);
+    ByteBuffer buf(frame.data(), frame.size());
+    buf.PutByte(Protocol::START_BYTE);
+    buf.PutInt(static_cast<uint32_t>(frame.size()));
+    buf.PutInt(ChecksumService::REQUEST_ID);
+    buf.PutByte(Protocol::VERSION | Protocol::FLAG_FD_PAYLOAD);
+    buf.PutInt(1024);
+    buf.PutByte(Protocol::END_BYTE);
+    ASSERT_EQ(send(fd, frame.data(), frame.size(), 0), static_cast<ssize_t>(frame.size()));
+
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0); // Orderly close, no response
+    close(fd);
+}
+
+TEST_F(UDSServerTest, GatheredRequestsUpToTheInlineLimit) {
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    StartServer(ServerConfig{});
+
+    // Keep everything inline that fits a frame, so the header, the
+    // caller's payload and END go out as separate segments
+    ChannelOptions options{3000, true};
+    options.large_payload_threshold = Protocol::MAX_PACKET_SIZE;
+    auto channel = Connect(options);
+    ASSERT_TRUE(channel->IsConnected());
+
+    constexpr size_t INLINE_LIMIT = Protocol::MAX_PACKET_SIZE - Protocol::GetMinFrameSize() -
+                                    Protocol::REQUEST_ID_SIZE;
+    constexpr int CALLS = 64;
+    std::vector<size_t> lengths;
+    std::vector<uint32_t> sums(CALLS);
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        lengths.push_back(INLINE_LIMIT - static_cast<size_t>(i % 3)); // Full frames, and one over
+        if (i == CALLS - 1) {
+            lengths.back() = INLINE_LIMIT + 1;
+        }
+        auto payload = MakeLargePayload(lengths.back(), sums[i]);
+        futures.push_back(channel->ExecuteRPCAsync(ChecksumService::REQUEST_ID, payload.data(), payload.size()));
+    }
+
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        auto [length, checksum] = ChecksumService::Parse(response.frame.data(), response.frame.size());
+        EXPECT_EQ(length, lengths[i]);
+        EXPECT_EQ(checksum, sums[i]);
+    }
+}
+
+TEST_F(UDSServerTest, StatsClientReportsServerTraffic) {
+    manager_->RegisterService(std::make_shared<SlowService>(5));
+
+    ServerConfig config;
+    config.num_reactors = 2;
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+
+    auto first = Connect();
+    auto second = Connect();
+    ASSERT_TRUE(first->IsConnected());
+    ASSERT_TRUE(second->IsConnected());
+
+    Calculator calculator(first);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(calculator.Add(i, 1).success);
+    }
+    uint8_t request[1] = {7};
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    size_t response_len = 0;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(second->ExecuteRPC(SlowService::REQUEST_ID, request, sizeof(request),
+                                       response, sizeof(response), response_len));
+    }
+
+    StatsClient stats(second);
+    auto result = stats.GetStats();
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(2u, result.connections_opened - result.connections_closed);
+
+    const StatsClient::RoutineStats* calculator_stats = nullptr;
+    const StatsClient::RoutineStats* slow_stats = nullptr;
+    for (const auto& routine : result.routines) {
+        if (routine.routine_id == 0x1000) {
+            calculator_stats = &routine;
+        } else if (routine.routine_id == SlowService::REQUEST_ID) {
+            slow_stats = &routine;
+        }
+    }
+    ASSERT_NE(nullptr, calculator_stats);
+    ASSERT_NE(nullptr, slow_stats);
+
+    // Inline requests never wait in the pool; offloaded ones do
+    EXPECT_EQ("CalculatorService", calculator_stats->name);
+    EXPECT_EQ(5u, calculator_stats->requests);
+    EXPECT_EQ(0u, calculator_stats->queue_wait.count);
+    EXPECT_EQ(3u, slow_stats->requests);
+    EXPECT_EQ(3u, slow_stats->queue_wait.count);
+    EXPECT_EQ(3u, slow_stats->bytes_in);
+    EXPECT_GE(slow_stats->execution.p50_ns, 5000000u);
+
+    auto text = stats.GetPrometheusText();
+    ASSERT_TRUE(text.success) << text.error_message;
+    EXPECT_NE(std::string::npos,
+              text.text.find("ipc_requests_total{routine=\"0x3000\",service=\"SlowService\"} 3\n"));
+}
+
+ServerConfig IoUringConfig() {
+    ServerConfig config;
+    config.io_backend = IoBackend::IoUring;
+    return config;
+}
+
+TEST_F(UDSServerTest, IoUringBackendServesChannels) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not supported by this kernel";
+    }
+    ServerConfig config = IoUringConfig();
+    config.num_reactors = 2;
+    StartServer(config);
+    EXPECT_EQ(IoBackend::IoUring, server_->GetIoBackend());
+
+    // Plain, io_uring-driven and pipelined channels against the same server
+    ChannelOptions uring_options{1000, false};
+    uring_options.io_uring = true;
+    std::vector<std::shared_ptr<Channel>> channels = {
+        Connect(), Connect(uring_options), Connect(ChannelOptions{1000, true})};
+    for (size_t c = 0; c < channels.size(); ++c) {
+        ASSERT_TRUE(channels[c]->IsConnected());
+        Calculator calculator(channels[c]);
+        for (int i = 0; i < 100; ++i) {
+            auto result = calculator.Add(i, c);
+            ASSERT_TRUE(result.success) << result.error_message;
+            EXPECT_DOUBLE_EQ(result.value, i + static_cast<double>(c));
+        }
+        auto batch = calculator.AddBatch({{1.0, 2.0}, {3.0, 4.0}});
+        ASSERT_EQ(batch.size(), 2u);
+        EXPECT_DOUBLE_EQ(batch[1].value, 7.0);
+    }
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 3; }));
+
+    channels.clear();
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 0; }));
+}
+
+TEST_F(UDSServerTest, IoUringBackendDrainsLargeBurst) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not supported by this kernel";
+    }
+    ServerConfig config = IoUringConfig();
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 2;
+    StartServer(config);
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+
+    // Responses outgrow the socket buffer, so sends complete partially
+    // and the receive side spills into the backlog while paused
+    constexpr int COUNT = 2000;
+    std::thread writer([fd]() {
+        for (int i = 0; i < COUNT; ++i) {
+            auto frame = BuildCalculatorFrame(0x01, i, 0.0);
+            send(fd, frame.data(), frame.size(), MSG_NOSIGNAL);
+        }
+    });
+
+    auto results = ReadCalculatorResults(fd, COUNT);
+    writer.join();
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; ++i) {
+        EXPECT_DOUBLE_EQ(results[i], static_cast<double>(i));
+    }
+    close(fd);
+}
+
+TEST_F(UDSServerTest, IoUringBackendBackpressureBoundsConcurrency) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not supported by this kernel";
+    }
+    auto service = std::make_shared<ConcurrencyService>(10);
+    manager_->RegisterService(service);
+
+    ServerConfig config = IoUringConfig();
+    config.execution_mode = ExecutionMode::ThreadPool;
+    config.worker_threads = 4;
+    config.max_pending_per_connection = 2;
+    config.overload_policy = OverloadPolicy::Backpressure;
+    StartServer(config);
+
+    auto channel = Connect(ChannelOptions{5000, true});
+    constexpr int CALLS = 24;
+    std::vector<std::future<RPCResponse>> futures;
+    for (int i = 0; i < CALLS; ++i) {
+        uint8_t request[1] = {static_cast<uint8_t>(i)};
+        futures.push_back(channel->ExecuteRPCAsync(SlowService::REQUEST_ID, request, sizeof(request)));
+    }
+    for (int i = 0; i < CALLS; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success) << response.error_message;
+        EXPECT_EQ(response.frame[10], static_cast<uint8_t>(i));
+    }
+    EXPECT_LE(service->MaxRunning(), 2);
+}
+
+TEST_F(UDSServerTest, IoUringBackendSharedMemoryAndLargePayloads) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not supported by this kernel";
+    }
+    manager_->RegisterService(std::make_shared<ChecksumService>());
+    StartServer(IoUringConfig());
+
+    // Doorbell polled through the ring
+    auto shm = Connect(SharedMemoryOptions(1000, true));
+    ASSERT_TRUE(shm->IsSharedMemoryActive());
+    Calculator shm_calculator(shm);
+    for (int i = 0; i < 200; ++i) {
+        auto result = shm_calculator.Multiply(i, 2.0);
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_DOUBLE_EQ(result.value, i * 2.0);
+    }
+
+    // The memfd descriptor arrives in the multishot recvmsg control data
+    ChannelOptions uring_options{2000, false};
+    uring_options.io_uring = true;
+    auto channel = Connect(uring_options);
+    uint32_t sum = 0;
+    auto payload = MakeLargePayload(1024 * 1024, sum);
+    uint8_t response[Protocol::MAX_PACKET_SIZE];
+    size_t response_len = 0;
+    ASSERT_TRUE(channel->ExecuteRPC(ChecksumService::REQUEST_ID, payload.data(), payload.size(),
+                                    response, sizeof(response), response_len))
+        << channel->GetLastError();
+    auto [length, checksum] = ChecksumService::Parse(response, response_len);
+    EXPECT_EQ(length, payload.size());
+    EXPECT_EQ(checksum, sum);
+}
+
+TEST_F(UDSServerTest, IoUringBackendClosesCorruptAndIdleConnections) {
+    if (!IoUring::IsSupported()) {
+        GTEST_SKIP() << "io_uring not supported by this kernel";
+    }
+    ServerConfig config = IoUringConfig();
+    config.inactivity_timeout_ms = 300;
+    StartServer(config);
+
+    int fd = -1;
+    ASSERT_TRUE(WaitUntil([&]() { return (fd = ConnectRaw()) >= 0; }));
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+    const uint8_t garbage[16] = {0x00, 0x01, 0x02};
+    ASSERT_EQ(send(fd, garbage, sizeof(garbage), 0), static_cast<ssize_t>(sizeof(garbage)));
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0);
+    close(fd);
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 0; }));
+
+    // The timer wheel is ticked from a polled timerfd
+    auto idle = Connect();
+    ASSERT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 1; }));
+    EXPECT_TRUE(WaitUntil([this]() { return server_->GetClientCount() == 0; }));
+}
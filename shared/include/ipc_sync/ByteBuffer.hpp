@@ -0,0 +1,364 @@
+/**
+ * @file ByteBuffer.hpp
+ * @brief Interface for byte buffer serialization/deserialization
+ * 
+ * Provides methods to serialize and deserialize various data types
+ * for network communication. Follows Interface Segregation Principle.
+ */
+
+#ifndef IPC_SYNC_BYTE_BUFFER_HPP
+#define IPC_SYNC_BYTE_BUFFER_HPP
+
+#include "ipc_sync/ByteOrder.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+namespace ipc_demo {
+
+/**
+ * @class IByteBuffer
+ * @brief Abstract interface for byte buffer operations
+ * 
+ * Allows serialization/deserialization of primitive types, strings,
+ * maps, and arrays for network communication.
+ */
+class IByteBuffer {
+public:
+    virtual ~IByteBuffer() = default;
+
+    // Write operations
+    virtual void PutByte(uint8_t data) = 0;
+    virtual void PutInt(uint32_t data) = 0;
+    virtual void PutShort(uint16_t data) = 0;
+    virtual void PutLong(int64_t data) = 0;
+    virtual void PutFloat(float data) = 0;
+    virtual void PutDouble(double data) = 0;
+    virtual void PutString(const std::string& data) = 0;
+    virtual void PutMap(const std::unordered_map<std::string, std::string>& data) = 0;
+    virtual void PutArray(const uint8_t* data, uint32_t len) = 0;
+
+    // Read operations
+    virtual uint8_t GetByte() = 0;
+    virtual uint32_t GetInt() = 0;
+    virtual uint16_t GetShort() = 0;
+    virtual int64_t GetLong() = 0;
+    virtual float GetFloat() = 0;
+    virtual double GetDouble() = 0;
+    virtual std::string GetString() = 0;
+    virtual std::unordered_map<std::string, std::string> GetMap() = 0;
+    virtual size_t GetArray(uint8_t* data, uint32_t max_len) = 0;
+
+    // Buffer management
+    virtual void Reset() = 0;
+    virtual size_t Position() const = 0;
+    virtual void SetPosition(size_t pos) = 0;
+    virtual size_t Capacity() const = 0;
+};
+
+/**
+ * @struct ByteSpan
+ * @brief Bytes inside a buffer, not owned (std::span is C++20)
+ */
+struct ByteSpan {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    const uint8_t* begin() const { return data; }
+    const uint8_t* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+};
+
+/**
+ * @class MapView
+ * @brief Encoded map read in place: [count:uint32_t][key:string][value:string]...
+ *
+ * Obtained from ByteBuffer::GetMapView(), which checks every entry once, so
+ * iterating does no bounds checks and allocates nothing. Keys and values
+ * point into the buffer and are valid while the buffer is. Entries come in
+ * wire order; duplicate keys are kept (Find() returns the last one, as
+ * GetMap() would).
+ */
+class MapView {
+public:
+    using Entry = std::pair<std::string_view, std::string_view>;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = Entry;
+
+        Iterator() = default;
+
+        Entry operator*() const {
+            uint32_t key_len = byte_order::LoadBigEndian<uint32_t>(entry_);
+            const uint8_t* value = entry_ + 4 + key_len;
+            uint32_t value_len = byte_order::LoadBigEndian<uint32_t>(value);
+            return Entry{std::string_view(reinterpret_cast<const char*>(entry_ + 4), key_len),
+                         std::string_view(reinterpret_cast<const char*>(value + 4), value_len)};
+        }
+
+        Iterator& operator++() {
+            entry_ += 4 + byte_order::LoadBigEndian<uint32_t>(entry_);
+            entry_ += 4 + byte_order::LoadBigEndian<uint32_t>(entry_);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return entry_ == other.entry_; }
+        bool operator!=(const Iterator& other) const { return entry_ != other.entry_; }
+
+    private:
+        friend class MapView;
+        explicit Iterator(const uint8_t* entry) : entry_(entry) {}
+
+        const uint8_t* entry_ = nullptr;
+    };
+
+    MapView() = default;
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    Iterator begin() const { return Iterator(entries_); }
+    Iterator end() const { return Iterator(end_); }
+
+    /**
+     * @brief Look a key up (linear scan)
+     * @return Value of the last entry with this key, nullopt if none
+     */
+    std::optional<std::string_view> Find(std::string_view key) const {
+        std::optional<std::string_view> found;
+        for (const Entry& entry : *this) {
+            if (entry.first == key) {
+                found = entry.second;
+            }
+        }
+        return found;
+    }
+
+private:
+    friend class ByteBuffer;
+    MapView(const uint8_t* entries, const uint8_t* end, uint32_t count)
+        : entries_(entries), end_(end), count_(count) {}
+
+    const uint8_t* entries_ = nullptr;
+    const uint8_t* end_ = nullptr;
+    uint32_t count_ = 0;
+};
+
+/**
+ * @class ByteBuffer
+ * @brief Concrete implementation of IByteBuffer
+ * 
+ * Handles byte-level serialization with boundary checking
+ * and proper error handling. Single Responsibility: serialization only.
+ *
+ * The class is final and its primitives are defined inline, so calls on a
+ * ByteBuffer (rather than through IByteBuffer) are devirtualized and compile
+ * to one bounds check plus a move. For longer sequences, Reserve() checks
+ * once and the byte_order::Store helpers write without further checks;
+ * arrays go through the bulk Put/Get methods.
+ */
+class ByteBuffer final : public IByteBuffer {
+public:
+    /**
+     * @brief Construct ByteBuffer with external buffer
+     * @param buffer Pointer to buffer (not owned)
+     * @param length Buffer capacity in bytes
+     */
+    ByteBuffer(uint8_t* buffer, size_t length);
+
+    // Disable copy/move to prevent buffer ownership issues
+    ByteBuffer(const ByteBuffer&) = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+    ByteBuffer(ByteBuffer&&) = delete;
+    ByteBuffer& operator=(ByteBuffer&&) = delete;
+
+    ~ByteBuffer() override = default;
+
+    // Write operations
+    void PutByte(uint8_t data) override { *Reserve(1) = data; }
+    void PutInt(uint32_t data) override { byte_order::StoreBigEndian(Reserve(4), data); }
+    void PutShort(uint16_t data) override { byte_order::StoreBigEndian(Reserve(2), data); }
+    void PutLong(int64_t data) override { byte_order::StoreBigEndian(Reserve(8), static_cast<uint64_t>(data)); }
+    // Floating point is IEEE 754 in host order
+    void PutFloat(float data) override { std::memcpy(Reserve(sizeof(data)), &data, sizeof(data)); }
+    void PutDouble(double data) override { std::memcpy(Reserve(sizeof(data)), &data, sizeof(data)); }
+    void PutString(const std::string& data) override;
+    void PutMap(const std::unordered_map<std::string, std::string>& data) override;
+    void PutArray(const uint8_t* data, uint32_t len) override;
+
+    // Read operations
+    uint8_t GetByte() override { return *Consume(1); }
+    uint32_t GetInt() override { return byte_order::LoadBigEndian<uint32_t>(Consume(4)); }
+    uint16_t GetShort() override { return byte_order::LoadBigEndian<uint16_t>(Consume(2)); }
+    int64_t GetLong() override { return static_cast<int64_t>(byte_order::LoadBigEndian<uint64_t>(Consume(8))); }
+    float GetFloat() override;
+    double GetDouble() override;
+    std::string GetString() override;
+    std::unordered_map<std::string, std::string> GetMap() override;
+    size_t GetArray(uint8_t* data, uint32_t max_len) override;
+
+    // Zero-copy reads: the results point into the buffer and are valid
+    // while the buffer is
+
+    /**
+     * @brief Read a string without copying it
+     */
+    std::string_view GetStringView();
+
+    /**
+     * @brief Read a map without building it
+     * @throws std::underflow_error if any entry exceeds the buffer
+     */
+    MapView GetMapView();
+
+    /**
+     * @brief Read an array (PutArray format) without copying it
+     */
+    ByteSpan GetArraySpan();
+
+    // Bulk operations: count elements, no length prefix
+    void PutInts(const uint32_t* data, size_t count);
+    void PutLongs(const int64_t* data, size_t count);
+    void PutDoubles(const double* data, size_t count);
+    void GetInts(uint32_t* data, size_t count);
+    void GetLongs(int64_t* data, size_t count);
+    void GetDoubles(double* data, size_t count);
+
+    /**
+     * @brief Claim size bytes for writing and advance past them
+     * @return Start of the claimed bytes, to be filled without further checks
+     * @throws std::overflow_error if fewer than size bytes remain
+     */
+    uint8_t* Reserve(size_t size) {
+        if (!CheckBoundary(size)) {
+            ThrowWriteOverflow();
+        }
+        uint8_t* out = buffer_ + position_;
+        position_ += size;
+        return out;
+    }
+
+    /**
+     * @brief Claim size bytes for reading and advance past them
+     * @throws std::underflow_error if fewer than size bytes remain
+     */
+    const uint8_t* Consume(size_t size) {
+        if (!CheckBoundary(size)) {
+            ThrowReadUnderflow();
+        }
+        const uint8_t* in = buffer_ + position_;
+        position_ += size;
+        return in;
+    }
+
+    // Buffer management
+    void Reset() override { position_ = 0; }
+    size_t Position() const override { return position_; }
+    void SetPosition(size_t pos) override;
+    size_t Capacity() const override { return length_; }
+    size_t Remaining() const { return length_ - position_; }
+
+private:
+    uint8_t* buffer_;         // External buffer (not owned)
+    const size_t length_;     // Buffer capacity
+    size_t position_;         // Current read/write position
+
+    /**
+     * @brief Check if operation would exceed buffer bounds
+     * @param size Number of bytes to check
+     * @return true if operation is safe, false otherwise
+     */
+    bool CheckBoundary(size_t size) const { return size <= length_ - position_; }
+
+    // Out of line so the inline fast path stays small
+    [[noreturn]] static void ThrowWriteOverflow();
+    [[noreturn]] static void ThrowReadUnderflow();
+};
+
+inline float ByteBuffer::GetFloat() {
+    float data;
+    std::memcpy(&data, Consume(sizeof(data)), sizeof(data));
+    return data;
+}
+
+inline double ByteBuffer::GetDouble() {
+    double data;
+    std::memcpy(&data, Consume(sizeof(data)), sizeof(data));
+    return data;
+}
+
+inline void ByteBuffer::PutString(const std::string& data) {
+    // Format: [length:uint32_t][string data]
+    uint8_t* out = Reserve(4 + data.size());
+    byte_order::StoreBigEndian(out, static_cast<uint32_t>(data.size()));
+    if (!data.empty()) {
+        std::memcpy(out + 4, data.data(), data.size());
+    }
+}
+
+inline void ByteBuffer::PutInts(const uint32_t* data, size_t count) {
+    if (count > 0) {
+        byte_order::ConvertBigEndian<4>(Reserve(count * 4), data, count);
+    }
+}
+
+inline void ByteBuffer::PutLongs(const int64_t* data, size_t count) {
+    if (count > 0) {
+        byte_order::ConvertBigEndian<8>(Reserve(count * 8), data, count);
+    }
+}
+
+inline void ByteBuffer::PutDoubles(const double* data, size_t count) {
+    if (count > 0) {
+        std::memcpy(Reserve(count * sizeof(double)), data, count * sizeof(double));
+    }
+}
+
+inline void ByteBuffer::GetInts(uint32_t* data, size_t count) {
+    if (count > 0) {
+        byte_order::ConvertBigEndian<4>(data, Consume(count * 4), count);
+    }
+}
+
+inline void ByteBuffer::GetLongs(int64_t* data, size_t count) {
+    if (count > 0) {
+        byte_order::ConvertBigEndian<8>(data, Consume(count * 8), count);
+    }
+}
+
+inline void ByteBuffer::GetDoubles(double* data, size_t count) {
+    if (count > 0) {
+        std::memcpy(data, Consume(count * sizeof(double)), count * sizeof(double));
+    }
+}
+
+/**
+ * @brief Factory function to create ByteBuffer instances
+ * @param buffer External buffer pointer
+ * @param length Buffer capacity
+ * @return Unique pointer to ByteBuffer
+ */
+inline std::unique_ptr<IByteBuffer> CreateByteBuffer(uint8_t* buffer, size_t length) {
+    return std::make_unique<ByteBuffer>(buffer, length);
+}
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_BYTE_BUFFER_HPP
@@ -0,0 +1,159 @@
+/**
+ * @file ByteOrder.hpp
+ * @brief Big-endian load/store helpers and bulk byte-swap kernels
+ *
+ * Header-only so ByteBuffer's inline fast path compiles to plain moves and
+ * bswap instructions. The bulk kernels convert whole arrays between host
+ * order and the wire's big-endian order 16 or 32 bytes at a time: pshufb
+ * when the build enables SSSE3/AVX2 (e.g. -march=native), otherwise the
+ * SSE2 shuffles every x86-64 CPU has; other targets use a scalar loop.
+ */
+#ifndef IPC_SYNC_BYTE_ORDER_HPP
+#define IPC_SYNC_BYTE_ORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ipc_demo {
+namespace byte_order {
+
+constexpr bool HOST_IS_BIG_ENDIAN = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+/**
+ * @brief Reverse the bytes of an unsigned integer
+ */
+template <typename T>
+inline T ByteSwap(T value) {
+    static_assert(std::is_unsigned_v<T>, "ByteSwap needs an unsigned integer");
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else if constexpr (sizeof(T) == 2) {
+        return __builtin_bswap16(value);
+    } else if constexpr (sizeof(T) == 4) {
+        return __builtin_bswap32(value);
+    } else {
+        static_assert(sizeof(T) == 8, "Unsupported integer size");
+        return __builtin_bswap64(value);
+    }
+}
+
+/**
+ * @brief Host order <-> big-endian (the swap is its own inverse)
+ */
+template <typename T>
+inline T ToBigEndian(T value) {
+    return HOST_IS_BIG_ENDIAN ? value : ByteSwap(value);
+}
+
+/**
+ * @brief Store an unsigned integer big-endian at an unaligned address
+ */
+template <typename T>
+inline void StoreBigEndian(uint8_t* out, T value) {
+    value = ToBigEndian(value);
+    std::memcpy(out, &value, sizeof(T));
+}
+
+/**
+ * @brief Load a big-endian unsigned integer from an unaligned address
+ */
+template <typename T>
+inline T LoadBigEndian(const uint8_t* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    return ToBigEndian(value);
+}
+
+namespace detail {
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+// pshufb control reversing every Size-byte lane of a 16-byte block
+template <size_t Size>
+inline __m128i SwapMask128() {
+    alignas(16) uint8_t mask[16];
+    for (size_t i = 0; i < 16; ++i) {
+        mask[i] = static_cast<uint8_t>((i / Size) * Size + (Size - 1 - i % Size));
+    }
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+#elif defined(__SSE2__)
+// Reverse every Size-byte lane: order the 16-bit words, then swap their bytes
+template <size_t Size>
+inline __m128i Swap128(__m128i v) {
+    if constexpr (Size == 4) {
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+    } else if constexpr (Size == 8) {
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+    }
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Copy count integers of Size bytes, reversing each one's bytes
+ *
+ * dst and src may be unaligned but must not overlap.
+ */
+template <size_t Size>
+inline void SwapCopy(void* dst, const void* src, size_t count) {
+    static_assert(Size == 2 || Size == 4 || Size == 8, "Unsupported integer size");
+    auto* out = static_cast<uint8_t*>(dst);
+    const auto* in = static_cast<const uint8_t*>(src);
+    size_t bytes = count * Size;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_broadcastsi128_si256(detail::SwapMask128<Size>());
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+    const __m128i mask128 = detail::SwapMask128<Size>();
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(v, mask128));
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), detail::Swap128<Size>(v));
+    }
+#endif
+
+    using Word = std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>;
+    for (; i < bytes; i += Size) {
+        Word word;
+        std::memcpy(&word, in + i, Size);
+        word = ByteSwap(word);
+        std::memcpy(out + i, &word, Size);
+    }
+}
+
+/**
+ * @brief Copy count host-order integers of Size bytes to/from big-endian
+ */
+template <size_t Size>
+inline void ConvertBigEndian(void* dst, const void* src, size_t count) {
+    if constexpr (HOST_IS_BIG_ENDIAN) {
+        std::memcpy(dst, src, count * Size);
+    } else {
+        SwapCopy<Size>(dst, src, count);
+    }
+}
+
+} // namespace byte_order
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_BYTE_ORDER_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file Calculator.hpp
+ * @brief Client-side proxy for Calculator service (Pimpl interface)
+ */
+#ifndef IPC_SYNC_CALCULATOR_HPP
+#define IPC_SYNC_CALCULATOR_HPP
+
+#include "ipc_sync/Channel.hpp"
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class Calculator
+ * @brief Client proxy for Calculator service
+ * 
+ * Uses Pimpl idiom - all implementation is hidden in shared library
+ *
+ * Every operation has a blocking form and two asynchronous forms (future
+ * and callback). The asynchronous forms need a pipelined channel, see
+ * ChannelOptions::pipelining.
+ */
+class Calculator {
+public:
+    struct Result {
+        bool success;
+        double value;
+        std::string error_message;
+    };
+
+    /**
+     * @brief Result whose error message points into a ResponseBuffer
+     *
+     * Returned by the operations that take a buffer; no heap allocation is
+     * made, and the view is valid while the buffer is neither reused nor
+     * destroyed.
+     */
+    struct ResultView {
+        bool success;
+        double value;
+        std::string_view error_message;
+
+        Result ToResult() const { return Result{success, value, std::string(error_message)}; }
+    };
+
+    /**
+     * @brief Completion callback for asynchronous operations
+     *
+     * Runs on the channel's event-loop thread (see Channel::ExecuteRPCAsync).
+     */
+    using Callback = std::function<void(const Result&)>;
+
+    /**
+     * @brief Construct Calculator proxy
+     * @param channel Communication channel
+     */
+    explicit Calculator(std::shared_ptr<Channel> channel);
+    
+    ~Calculator();
+
+    // Disable copy/move
+    Calculator(const Calculator&) = delete;
+    Calculator& operator=(const Calculator&) = delete;
+    Calculator(Calculator&&) = delete;
+    Calculator& operator=(Calculator&&) = delete;
+
+    /**
+     * @brief Add two numbers
+     */
+    Result Add(double a, double b);
+
+    /**
+     * @brief Subtract two numbers
+     */
+    Result Subtract(double a, double b);
+
+    /**
+     * @brief Multiply two numbers
+     */
+    Result Multiply(double a, double b);
+
+    /**
+     * @brief Divide two numbers
+     */
+    Result Divide(double a, double b);
+
+    /**
+     * @brief Add / Subtract / Multiply / Divide, decoded in place into buffer
+     */
+    ResultView Add(double a, double b, ResponseBuffer& buffer);
+    ResultView Subtract(double a, double b, ResponseBuffer& buffer);
+    ResultView Multiply(double a, double b, ResponseBuffer& buffer);
+    ResultView Divide(double a, double b, ResponseBuffer& buffer);
+
+    /**
+     * @brief Add many pairs with one round trip per batch frame
+     * @param operands (a, b) pairs
+     * @return One result per pair, in order
+     */
+    std::vector<Result> AddBatch(const std::vector<std::pair<double, double>>& operands);
+
+    /**
+     * @brief Asynchronous Add / Subtract / Multiply / Divide (future)
+     */
+    std::future<Result> AddAsync(double a, double b);
+    std::future<Result> SubtractAsync(double a, double b);
+    std::future<Result> MultiplyAsync(double a, double b);
+    std::future<Result> DivideAsync(double a, double b);
+
+    /**
+     * @brief Asynchronous Add / Subtract / Multiply / Divide (callback)
+     */
+    void AddAsync(double a, double b, Callback callback);
+    void SubtractAsync(double a, double b, Callback callback);
+    void MultiplyAsync(double a, double b, Callback callback);
+    void DivideAsync(double a, double b, Callback callback);
+
+private:
+    // Opaque pointer to implementation
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_CALCULATOR_HPP
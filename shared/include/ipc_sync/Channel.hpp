@@ -0,0 +1,395 @@
+/**
+ * @file Channel.hpp
+ * @brief Client-side channel for RPC communication (Pimpl interface)
+ */
+#ifndef IPC_SYNC_CHANNEL_HPP
+#define IPC_SYNC_CHANNEL_HPP
+
+#include "ipc_sync/Compression.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <string>
+#include <memory>
+#include <functional>
+#include <future>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace ipc_demo {
+
+/**
+ * @brief Byte transport used once connected
+ */
+enum class Transport {
+    Socket,        // Frames travel over the Unix socket
+    SharedMemory   // Frames travel through shared-memory rings (socket kept for setup and liveness)
+};
+
+/**
+ * @struct ChannelOptions
+ * @brief Connection options for Channel
+ */
+struct ChannelOptions {
+    int timeout_ms = 5000;      // Connect and per-RPC timeout in milliseconds
+
+    /**
+     * Pipelined mode: every request carries a request ID and many threads
+     * may have RPCs outstanding on the one socket at the same time. A
+     * dedicated reader thread hands each response to the caller waiting
+     * for its ID, so responses may arrive in any order. When false, RPCs
+     * on the channel are serialized (one in flight).
+     */
+    bool pipelining = false;
+
+    /**
+     * SharedMemory: after connecting, offer the server a memfd with two
+     * SPSC rings; frames then bypass the socket and each side is woken
+     * through an eventfd only while the other sleeps. Falls back to the
+     * socket silently if the server refuses (see IsSharedMemoryActive).
+     */
+    Transport transport = Transport::Socket;
+    size_t shm_ring_capacity = 256 * 1024;  // Bytes per direction (power of two, rounded up)
+
+    /**
+     * Request payloads longer than this (and any that do not fit a frame)
+     * are written to a sealed memfd passed with SCM_RIGHTS; the server maps
+     * it read-only instead of copying it. Up to Protocol::MAX_FD_PAYLOAD_SIZE,
+     * socket transport only.
+     */
+    size_t large_payload_threshold = 4096;
+
+    /**
+     * Inactivity timeout the server should apply to this connection,
+     * requested again on every (re)connect; the server may cap it.
+     * 0 keeps the server's default.
+     */
+    uint32_t idle_timeout_ms = 0;
+
+    /**
+     * io_uring: each non-pipelined socket RPC is one io_uring_enter that
+     * sends the request and receives the response (linked SENDMSG, RECV
+     * and LINK_TIMEOUT) instead of a sendmsg and a recv. Silently uses
+     * plain syscalls on kernels without the needed features, and for
+     * shared memory and large (memfd) payloads.
+     */
+    bool io_uring = false;
+
+    /**
+     * Spin-wait: a non-pipelined RPC polls for its response for up to
+     * this many microseconds (non-blocking recv, or reading the shared
+     * memory ring without arming its doorbell) before it falls back to a
+     * blocking wait. Trades a busy CPU for wake-up latency; pair it with a
+     * server using ServerConfig::busy_poll_us. Not used with io_uring.
+     * 0 always blocks.
+     */
+    uint32_t spin_wait_us = 0;
+
+    /**
+     * Compression: negotiated on every (re)connect; request payloads of at
+     * least compression_threshold bytes are sent LZ4-compressed when that
+     * makes them smaller, and the server does the same for responses.
+     * With a dictionary, it is used only if the server holds the same one
+     * (otherwise plain LZ4). Silently off if the server refuses.
+     */
+    bool compression = false;
+    size_t compression_threshold = 512;
+    std::shared_ptr<const CompressionDictionary> compression_dictionary = nullptr;
+
+    /**
+     * Tracing: this fraction of RPCs (0 = none, 1 = all) records a span of
+     * per-stage timings into trace::Tracer::Global(). With trace_propagation
+     * the span's trace ID travels in the request (Protocol::FLAG_TRACE_ID),
+     * and the server traces that request under the same ID; servers that
+     * predate the flag reject such requests.
+     */
+    double trace_sample_rate = 0.0;
+    bool trace_propagation = true;
+};
+
+/**
+ * @struct RPCResponse
+ * @brief Outcome of an asynchronous RPC (future-based API)
+ */
+struct RPCResponse {
+    bool success;
+    std::vector<uint8_t> frame;     // Response frame (START..END) when success
+    std::string error_message;
+};
+
+/**
+ * @struct ResponseBuffer
+ * @brief Caller-owned storage for a response frame decoded in place
+ *
+ * The view-returning client calls (e.g. Calculator::Add with a buffer) leave
+ * the frame here and return views into it; reusing or destroying the buffer
+ * invalidates them. On failure the error message is copied here instead.
+ */
+struct ResponseBuffer {
+    uint8_t data[Protocol::MAX_PACKET_SIZE];
+
+    /**
+     * @brief Copy text into the buffer (truncated to its size)
+     * @return View of the copy
+     */
+    std::string_view Keep(std::string_view text) {
+        size_t len = text.size() < sizeof(data) ? text.size() : sizeof(data);
+        std::memcpy(data, text.data(), len);
+        return std::string_view(reinterpret_cast<const char*>(data), len);
+    }
+};
+
+/**
+ * @struct BatchCall
+ * @brief One sub-request of a batch (payload is not owned)
+ */
+struct BatchCall {
+    uint32_t routine_id;
+    const uint8_t* request_data;
+    size_t request_len;
+};
+
+/**
+ * @brief Completion callback for asynchronous RPCs
+ *
+ * Arguments: success, response frame, response frame length, error message.
+ * The frame pointer is only valid for the duration of the call.
+ */
+using RPCCallback = std::function<void(bool, const uint8_t*, size_t, const std::string&)>;
+
+/**
+ * @struct StreamOptions
+ * @brief Cadence and flow control of a server-push stream (Channel::Subscribe)
+ */
+struct StreamOptions {
+    uint32_t interval_ms = 1000;   // Time between frames (the server allows down to a few ms)
+    uint32_t window = 16;          // Frames the server may send ahead of the callback, at least 1
+};
+
+/**
+ * @class Channel
+ * @brief Manages client-side UDS connection and RPC execution
+ * 
+ * Uses Pimpl idiom - all implementation is hidden in shared library
+ * 
+ * RAII Design:
+ * - Constructor automatically connects (retries on first API call if fails)
+ * - Destructor automatically disconnects (no manual cleanup needed)
+ * - Auto-reconnects on timeout or connection loss
+ * 
+ * Usage:
+ * @code
+ * {
+ *     auto channel = std::make_shared<Channel>("/tmp/server.sock");
+ *     // No need to call Connect() - already connected!
+ *     
+ *     Calculator calc(channel);
+ *     auto result = calc.Add(5, 3);  // Works even after server timeout
+ *     
+ *     // No need to call Disconnect() - destructor handles it
+ * }
+ * @endcode
+ *
+ * Thread Safety: ExecuteRPC() may be called from many threads. In the
+ * default mode calls are serialized; with ChannelOptions::pipelining they
+ * overlap on the same socket.
+ *
+ * Asynchronous calls (ExecuteRPCAsync) need ChannelOptions::pipelining.
+ * A per-channel event loop polls the socket, matches responses by request
+ * ID and expires calls after timeout_ms. Callbacks run on that event-loop
+ * thread: keep them short and never make blocking ExecuteRPC() calls from
+ * them (issuing more asynchronous calls is fine). Stream frames
+ * (Subscribe) are delivered the same way.
+ */
+class Channel {
+public:
+    /**
+     * @brief Construct channel and auto-connect to server
+     * @param socket_path Path to UDS socket
+     * @param timeout_ms Connection timeout in milliseconds
+     * 
+     * Note: If initial connection fails, the channel will retry
+     *       automatically on the first API call (ExecuteRPC)
+     */
+    explicit Channel(const std::string& socket_path, int timeout_ms = 5000);
+
+    /**
+     * @brief Construct channel with explicit options and auto-connect
+     * @param socket_path Path to UDS socket
+     * @param options Connection options (timeout, pipelining)
+     */
+    Channel(const std::string& socket_path, const ChannelOptions& options);
+    
+    /**
+     * @brief Destructor - automatically disconnects (RAII)
+     */
+    ~Channel();
+
+    // Disable copy/move
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    Channel(Channel&&) = delete;
+    Channel& operator=(Channel&&) = delete;
+
+    /**
+     * @brief Connect or reconnect to server
+     * @return true if connected
+     * 
+     * Note: You typically don't need to call this manually.
+     *       Constructor auto-connects, and ExecuteRPC auto-reconnects.
+     *       Exposed for explicit reconnection if needed.
+     */
+    bool Connect();
+
+    /**
+     * @brief Execute RPC call with automatic reconnection
+     * @param routine_id Service routine ID
+     * @param request_data Request payload
+     * @param request_len Request payload length
+     * @param response_buffer Buffer for response
+     * @param response_buffer_size Size of response buffer
+     * @param response_len Actual response length received
+     * @return true if RPC succeeded
+     * 
+     * This method automatically:
+     * - Checks connection status
+     * - Reconnects if connection was lost (e.g., server timeout)
+     * - Retries send once on connection failure
+     *
+     * In pipelined mode the request ID extension is stripped before the
+     * response is copied out, so response_buffer holds a plain frame.
+     *
+     * Fails with GetLastError() "Server busy" when an overloaded server
+     * shed the request (Protocol::SERVER_BUSY_ROUTINE_ID); the connection
+     * stays usable.
+     *
+     * request_len may exceed Protocol::MAX_PACKET_SIZE: large payloads travel
+     * in a sealed memfd (see ChannelOptions::large_payload_threshold).
+     */
+    bool ExecuteRPC(uint32_t routine_id,
+                    const uint8_t* request_data, size_t request_len,
+                    uint8_t* response_buffer, size_t response_buffer_size,
+                    size_t& response_len);
+
+    /**
+     * @brief Execute many calls with one round trip per batch frame
+     * @param calls Sub-requests (any mix of routine IDs)
+     * @param responses Output: one entry per call, in call order
+     * @return true if every batch frame was answered; individual calls may
+     *         still have failed (see RPCResponse::success)
+     *
+     * Calls are packed into frames of at most Protocol::MAX_BATCH_CALLS
+     * calls and Protocol::MAX_PACKET_SIZE bytes. The server runs a frame's
+     * calls back-to-back and their responses share one response frame, so
+     * batching suits small calls.
+     */
+    bool ExecuteBatch(const std::vector<BatchCall>& calls, std::vector<RPCResponse>& responses);
+
+    /**
+     * @brief Execute RPC asynchronously and return a future for the response
+     * @param routine_id Service routine ID
+     * @param request_data Request payload (copied before returning)
+     * @param request_len Request payload length
+     * @return Future completed with the response frame or an error
+     */
+    std::future<RPCResponse> ExecuteRPCAsync(uint32_t routine_id,
+                                             const uint8_t* request_data, size_t request_len);
+
+    /**
+     * @brief Execute RPC asynchronously and invoke a callback on completion
+     * @param routine_id Service routine ID
+     * @param request_data Request payload (copied before returning)
+     * @param request_len Request payload length
+     * @param callback Invoked exactly once: on the event-loop thread, or on
+     *        the calling thread if the request could not be sent
+     * @throws std::invalid_argument if callback is empty
+     */
+    void ExecuteRPCAsync(uint32_t routine_id,
+                         const uint8_t* request_data, size_t request_len,
+                         RPCCallback callback);
+
+    /**
+     * @brief Subscribe to a routine: the server runs it every interval and
+     *        pushes each response, instead of the client polling
+     * @param routine_id Service routine ID (or Protocol::STATS_REQUEST_ROUTINE_ID)
+     * @param request_data Request payload the routine runs with each time (copied)
+     * @param request_len Request payload length
+     * @param options Interval and credit window
+     * @param on_frame Called on the event-loop thread with every response
+     *        frame, then once with success false when the stream ends
+     *        (error "Stream cancelled" after Unsubscribe, "Stream rejected",
+     *        "Stream failed", or the connection error)
+     * @param stream_id Output: ID for Unsubscribe()
+     * @return true if the subscription was sent; on false on_frame is never
+     *         called and GetLastError() says why
+     * @throws std::invalid_argument if on_frame is empty
+     *
+     * Needs ChannelOptions::pipelining. The server sends at most
+     * options.window frames the callback has not returned from yet; the
+     * channel grants more as callbacks return, so a slow callback slows the
+     * stream instead of queueing frames. Streams end with their connection
+     * and are not resubscribed on reconnect.
+     */
+    bool Subscribe(uint32_t routine_id,
+                   const uint8_t* request_data, size_t request_len,
+                   const StreamOptions& options, RPCCallback on_frame,
+                   uint32_t& stream_id);
+
+    /**
+     * @brief Cancel a stream; its callback ends with "Stream cancelled"
+     * @return false if the stream is unknown (already ended) or the cancel
+     *         could not be sent
+     */
+    bool Unsubscribe(uint32_t stream_id);
+
+    /**
+     * @brief Check if connected
+     * @return true if connected
+     */
+    bool IsConnected() const;
+
+    /**
+     * @brief Check if the channel runs in pipelined mode
+     */
+    bool IsPipelined() const;
+
+    /**
+     * @brief Check if frames currently travel over shared memory
+     */
+    bool IsSharedMemoryActive() const;
+
+    /**
+     * @brief Health check: find out, without sending a request, whether the
+     *        server closed the connection, and reconnect if so
+     * @return true if connected afterwards
+     *
+     * Returns at once while another thread has an RPC in progress on the
+     * channel. Used by ChannelPool for its idle connections.
+     */
+    bool CheckConnection();
+
+    /**
+     * @brief Get last error message
+     * @return Error message string
+     */
+    std::string GetLastError() const;
+
+    /**
+     * @brief Disconnect from server
+     * 
+     * Note: You typically don't need to call this manually.
+     *       Destructor auto-disconnects (RAII pattern).
+     *       Exposed for explicit cleanup if needed.
+     */
+    void Disconnect();
+
+private:
+    // Opaque pointer to implementation
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_CHANNEL_HPP
@@ -0,0 +1,212 @@
+/**
+ * @file IoUring.hpp
+ * @brief Minimal io_uring instance on raw syscalls (no liburing dependency)
+ *
+ * Covers what the server reactors and Channel use: submission and
+ * completion queues, one ring of provided receive buffers, and the
+ * handful of opcodes below. Kernels older than 6.3 (multishot recvmsg,
+ * provided buffer rings, registered ring fds) are reported unsupported so
+ * callers can fall back to epoll / plain syscalls.
+ */
+#ifndef IPC_SYNC_IO_URING_HPP
+#define IPC_SYNC_IO_URING_HPP
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/socket.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ipc_demo {
+
+/**
+ * @class IoUring
+ * @brief One submission/completion queue pair and its provided buffers
+ *
+ * SQEs taken with GetSqe() are queued locally and handed to the kernel by
+ * the next Submit() or SubmitAndWait(), so a whole event-loop iteration
+ * costs one io_uring_enter.
+ *
+ * Thread Safety: none; one thread owns the instance.
+ */
+class IoUring {
+public:
+    /**
+     * @brief Whether this kernel supports everything IoUring relies on (cached)
+     */
+    static bool IsSupported();
+
+    /**
+     * @brief Set up a ring
+     * @param entries Submission queue size (rounded up to a power of two)
+     * @param error Output: reason on failure
+     * @return Instance, or nullptr on failure
+     */
+    static std::unique_ptr<IoUring> Create(unsigned entries, std::string& error);
+
+    ~IoUring();
+
+    // Disable copy/move
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    IoUring(IoUring&&) = delete;
+    IoUring& operator=(IoUring&&) = delete;
+
+    /**
+     * @brief Next free SQE, zeroed
+     *
+     * Submits the queued SQEs first when the queue is full.
+     * @return SQE, or nullptr if the queue stays full (submit failed)
+     */
+    io_uring_sqe* GetSqe();
+
+    /**
+     * @brief Hand queued SQEs to the kernel without waiting
+     * @return Number submitted, or -errno
+     */
+    int Submit();
+
+    /**
+     * @brief Submit queued SQEs and wait for completions
+     * @param wait_nr Completions to wait for
+     * @param timeout_ms Longest wait, or -1 for no limit
+     * @return Number submitted (0 also on timeout or EINTR), or -errno
+     */
+    int SubmitAndWait(unsigned wait_nr, int timeout_ms = -1);
+
+    /**
+     * @brief Consume every available completion
+     * @param on_completion Called with each CQE; may queue new SQEs
+     * @return Number of completions consumed
+     */
+    template <typename Callback>
+    unsigned ForEachCompletion(Callback&& on_completion) {
+        unsigned count = 0;
+        unsigned head = *cq_head_;
+        unsigned tail;
+        while (head != (tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))) {
+            for (; head != tail; ++head, ++count) {
+                on_completion(cqes_[head & cq_mask_]);
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Register the provided-buffer ring used with IOSQE_BUFFER_SELECT
+     * @param group Buffer group ID passed in SQEs
+     * @param count Number of buffers (power of two, at most 32768)
+     * @param buffer_size Bytes per buffer
+     * @param error Output: reason on failure
+     * @return true if registered (at most one ring per instance)
+     */
+    bool SetupBufferRing(uint16_t group, unsigned count, unsigned buffer_size, std::string& error);
+
+    /**
+     * @brief Memory of a provided buffer (as reported by a CQE)
+     */
+    uint8_t* Buffer(uint16_t buffer_id) const {
+        return buffers_ + static_cast<size_t>(buffer_id) * buffer_size_;
+    }
+
+    /**
+     * @brief Size of every provided buffer
+     */
+    unsigned BufferSize() const { return buffer_size_; }
+
+    /**
+     * @brief Give a consumed buffer back to the kernel
+     */
+    void RecycleBuffer(uint16_t buffer_id);
+
+    /**
+     * @brief Buffer ID carried by a CQE with IORING_CQE_F_BUFFER
+     */
+    static uint16_t BufferId(const io_uring_cqe& cqe) {
+        return static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    }
+
+    /**
+     * @brief Whether a multishot request stays armed after this CQE
+     */
+    static bool HasMore(const io_uring_cqe& cqe) { return (cqe.flags & IORING_CQE_F_MORE) != 0; }
+
+    /**
+     * @brief Parts of a multishot recvmsg buffer
+     */
+    struct RecvMsg {
+        const uint8_t* payload;
+        size_t payload_len;
+        struct msghdr control;   // msg_control/msg_controllen only, for CMSG_* macros
+    };
+
+    /**
+     * @brief Split a multishot recvmsg buffer laid out per msg
+     * @param data Buffer of the CQE
+     * @param len cqe.res
+     * @param msg msghdr the request was prepared with
+     * @param out Output: payload and control data
+     * @return false if the buffer is malformed
+     */
+    static bool ParseRecvMsg(const uint8_t* data, size_t len, const struct msghdr& msg, RecvMsg& out);
+
+    // SQE preparation; user_data identifies the CQE(s)
+    static void PrepPollMultishot(io_uring_sqe* sqe, int fd, uint32_t events, uint64_t user_data);
+    static void PrepRecvMsgMultishot(io_uring_sqe* sqe, int fd, struct msghdr* msg, uint16_t group,
+                                     unsigned flags, uint64_t user_data);
+    static void PrepRecv(io_uring_sqe* sqe, int fd, void* data, size_t len, unsigned flags, uint64_t user_data);
+    static void PrepSend(io_uring_sqe* sqe, int fd, const void* data, size_t len, unsigned flags,
+                         uint64_t user_data);
+    static void PrepSendMsg(io_uring_sqe* sqe, int fd, const struct msghdr* msg, unsigned flags,
+                            uint64_t user_data);
+    static void PrepAcceptMultishot(io_uring_sqe* sqe, int fd, int flags, uint64_t user_data);
+    static void PrepLinkTimeout(io_uring_sqe* sqe, const struct __kernel_timespec* timeout, uint64_t user_data);
+    static void PrepCancel(io_uring_sqe* sqe, uint64_t target_user_data, uint64_t user_data);
+    static void PrepCancelAll(io_uring_sqe* sqe, uint64_t user_data);
+    static void PrepPollRemove(io_uring_sqe* sqe, uint64_t target_user_data, uint64_t user_data);
+
+private:
+    IoUring() = default;
+
+    int ring_fd_{-1};
+    unsigned features_{0};
+
+    // Submission queue
+    void* sq_ring_{nullptr};
+    size_t sq_ring_size_{0};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sqes_size_{0};
+    unsigned* sq_head_{nullptr};
+    unsigned* sq_tail_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned sq_entries_{0};
+    unsigned sqe_tail_{0};       // Next SQE to hand out (published on submit)
+
+    // Completion queue (shares the SQ mapping with IORING_FEAT_SINGLE_MMAP)
+    void* cq_ring_{nullptr};
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    unsigned cq_mask_{0};
+    io_uring_cqe* cqes_{nullptr};
+
+    // Provided buffers
+    io_uring_buf* buf_ring_{nullptr};   // Entries; the tail shares slot 0 (see RecycleBuffer)
+    size_t buf_ring_size_{0};
+    uint8_t* buffers_{nullptr};
+    size_t buffers_size_{0};
+    unsigned buffer_size_{0};
+    unsigned buf_mask_{0};
+    uint16_t buf_tail_{0};
+    uint16_t buf_group_{0};
+
+    bool Setup(unsigned entries, std::string& error);
+    unsigned Publish();
+    int Enter(unsigned to_submit, unsigned wait_nr, unsigned flags, const void* arg, size_t arg_size);
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_IO_URING_HPP
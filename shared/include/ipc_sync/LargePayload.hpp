@@ -0,0 +1,66 @@
+/**
+ * @file LargePayload.hpp
+ * @brief Request payloads carried in a sealed memfd instead of the frame
+ */
+
+#ifndef IPC_SYNC_LARGE_PAYLOAD_HPP
+#define IPC_SYNC_LARGE_PAYLOAD_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ipc_demo {
+
+/**
+ * @brief Copy data into a new memfd and seal it against any modification
+ *
+ * The memfd is written with write(), never mapped writable, so it can be
+ * sealed with F_SEAL_WRITE: the receiver can map it and read it in place
+ * without the sender changing it underneath.
+ *
+ * @param data Payload bytes
+ * @param len Payload length (1 .. Protocol::MAX_FD_PAYLOAD_SIZE)
+ * @param error Output: reason on failure
+ * @return memfd owned by the caller, or -1 on failure
+ */
+int CreateSealedPayload(const uint8_t* data, size_t len, std::string& error);
+
+/**
+ * @class PayloadView
+ * @brief Read-only mapping of a sealed payload memfd (receiver side)
+ */
+class PayloadView {
+public:
+    /**
+     * @brief Validate and map a payload memfd
+     *
+     * Takes ownership of memfd, also on failure. The memfd must be sealed
+     * against writes and shrinking and hold exactly size bytes.
+     *
+     * @return View, or nullptr if the memfd is unusable
+     */
+    static std::shared_ptr<const PayloadView> Map(int memfd, size_t size, std::string& error);
+
+    ~PayloadView();
+
+    // Disable copy/move
+    PayloadView(const PayloadView&) = delete;
+    PayloadView& operator=(const PayloadView&) = delete;
+    PayloadView(PayloadView&&) = delete;
+    PayloadView& operator=(PayloadView&&) = delete;
+
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    PayloadView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    const uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_LARGE_PAYLOAD_HPP
@@ -0,0 +1,82 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @brief HDR-style latency histogram for client-side measurements
+ *
+ * Fixed log-linear buckets: 128 sub-buckets per power of two, so every
+ * value is reported within 1% of what was recorded, from 1 ns up to about
+ * 36 minutes, in 35 KB. Recording is an index computation and an
+ * increment; histograms of the same geometry add bucket by bucket, so
+ * per-thread histograms merge losslessly.
+ */
+#ifndef IPC_SYNC_LATENCY_HISTOGRAM_HPP
+#define IPC_SYNC_LATENCY_HISTOGRAM_HPP
+
+#include "ipc_sync/LogLinearBuckets.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class LatencyHistogram
+ * @brief Distribution of latencies in nanoseconds
+ *
+ * Thread Safety: none; give each recording thread its own histogram and
+ * Add() them together.
+ */
+class LatencyHistogram {
+public:
+    // Geometry: values up to 2^(MAX_EXPONENT + 1) ns are kept apart
+    using Buckets = LogLinearBuckets<7>;
+    static constexpr unsigned SUB_BUCKET_BITS = Buckets::SUB_BUCKET_BITS;
+    static constexpr size_t SUB_BUCKETS = Buckets::SUB_BUCKETS;
+    static constexpr unsigned MAX_EXPONENT = Buckets::MAX_EXPONENT;
+    static constexpr size_t BUCKET_COUNT = Buckets::BUCKET_COUNT;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Count one value (larger ones land in the last bucket)
+     */
+    void Record(uint64_t value_ns) { RecordCount(value_ns, 1); }
+
+    /**
+     * @brief Count the same value several times
+     */
+    void RecordCount(uint64_t value_ns, uint64_t count);
+
+    /**
+     * @brief Add another histogram's samples to this one
+     */
+    void Add(const LatencyHistogram& other);
+
+    /**
+     * @brief Forget every sample
+     */
+    void Reset();
+
+    uint64_t Count() const { return count_; }
+    uint64_t Min() const { return count_ ? min_ : 0; }
+    uint64_t Max() const { return max_; }
+    double Mean() const;
+
+    /**
+     * @brief Value below which a fraction q of the samples fall
+     * @param q Quantile in [0, 1]
+     * @return Upper bound of the bucket holding the quantile (at most Max()),
+     *         or 0 without samples
+     */
+    uint64_t Percentile(double q) const;
+
+private:
+    std::vector<uint64_t> buckets_;
+    uint64_t count_ = 0;
+    uint64_t min_ = 0;
+    uint64_t max_ = 0;
+    double sum_ = 0;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_LATENCY_HISTOGRAM_HPP
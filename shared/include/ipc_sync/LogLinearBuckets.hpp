@@ -0,0 +1,59 @@
+/**
+ * @file LogLinearBuckets.hpp
+ * @brief Bucket geometry shared by the HDR-style histograms
+ *
+ * Values below 2^SubBucketBits get a bucket each; every power of two above
+ * that is split into 2^SubBucketBits equal sub-buckets, so a bucket's width
+ * is at most 1 / 2^SubBucketBits of the values it holds. Values beyond
+ * 2^(MaxExponent + 1) share the last bucket. Used by the server's Metrics
+ * (3 bits, 12.5%) and the client's LatencyHistogram (7 bits, 1%).
+ */
+#ifndef IPC_SYNC_LOG_LINEAR_BUCKETS_HPP
+#define IPC_SYNC_LOG_LINEAR_BUCKETS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc_demo {
+
+template <unsigned SubBucketBits, unsigned MaxExponent = 40>
+struct LogLinearBuckets {
+    static_assert(SubBucketBits > 0 && SubBucketBits <= MaxExponent && MaxExponent < 64,
+                  "Sub-buckets must fit below the largest exponent");
+
+    static constexpr unsigned SUB_BUCKET_BITS = SubBucketBits;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = MaxExponent;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Bucket of a value
+     */
+    static size_t Index(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+        if (exponent > MAX_EXPONENT) {
+            return BUCKET_COUNT - 1;
+        }
+        unsigned shift = exponent - SUB_BUCKET_BITS;
+        return SUB_BUCKETS + shift * SUB_BUCKETS + static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    /**
+     * @brief Largest value stored in a bucket
+     */
+    static uint64_t UpperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub) << shift) + ((uint64_t(1) << shift) - 1);
+    }
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_LOG_LINEAR_BUCKETS_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file Protocol.hpp
+ * @brief Protocol constants and definitions
+ */
+
+#ifndef IPC_SYNC_PROTOCOL_HPP
+#define IPC_SYNC_PROTOCOL_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ipc_demo {
+
+/**
+ * @namespace Protocol
+ * @brief Protocol-level constants
+ */
+namespace Protocol {
+
+    // Frame delimiters
+    constexpr uint8_t START_BYTE = 0x7E;
+    constexpr uint8_t END_BYTE = 0x7F;
+    constexpr uint8_t VERSION = 0x01;
+
+    // START(1) + LENGTH(4) + ROUTINE_ID(4) + VERSION(1); extensions and payload follow
+    constexpr size_t FRAME_HEADER_SIZE = 10;
+
+    // Header flags, carried in the high nibble of the VERSION byte
+    constexpr uint8_t VERSION_MASK = 0x0F;
+    constexpr uint8_t FLAGS_MASK = 0xF0;
+    constexpr uint8_t FLAG_REQUEST_ID = 0x10;      // 4-byte request ID follows VERSION
+    constexpr size_t REQUEST_ID_SIZE = 4;
+    constexpr uint8_t FLAG_COMPRESSED = 0x20;      // Payload is [ORIGINAL_LEN:4][LZ4 block], only on
+                                                   // connections that negotiated compression
+    constexpr size_t MAX_DECOMPRESSED_PAYLOAD_SIZE = 64 * 1024;
+    constexpr uint8_t FLAG_TRACE_ID = 0x40;        // 8-byte trace ID follows VERSION (and the request ID),
+                                                   // requests only (see ipc_sync/Tracer.hpp)
+    constexpr size_t TRACE_ID_SIZE = 8;
+    constexpr uint8_t FLAG_FD_PAYLOAD = 0x80;      // Payload is [SIZE:4]; the bytes are in a sealed memfd
+                                                   // attached to the frame with SCM_RIGHTS
+    constexpr size_t FD_PAYLOAD_HEADER_SIZE = 4;
+
+    // Built-in routine IDs, handled by the server core (0xF000 - 0xFFFF reserved)
+    constexpr uint32_t RESERVED_ROUTINE_MIN = 0x0000F000;
+    constexpr uint32_t RESERVED_ROUTINE_MAX = 0x0000FFFF;
+    constexpr uint32_t BATCH_REQUEST_ROUTINE_ID = 0x0000F000;
+    constexpr uint32_t BATCH_RESPONSE_ROUTINE_ID = 0x0000F001;
+    constexpr uint32_t SHM_NEGOTIATE_REQUEST_ROUTINE_ID = 0x0000F002;
+    constexpr uint32_t SHM_NEGOTIATE_RESPONSE_ROUTINE_ID = 0x0000F003;
+    constexpr uint32_t SERVER_BUSY_ROUTINE_ID = 0x0000F004;
+    constexpr uint32_t STATS_REQUEST_ROUTINE_ID = 0x0000F005;
+    constexpr uint32_t STATS_RESPONSE_ROUTINE_ID = 0x0000F006;
+    constexpr uint32_t IDLE_TIMEOUT_REQUEST_ROUTINE_ID = 0x0000F007;
+    constexpr uint32_t IDLE_TIMEOUT_RESPONSE_ROUTINE_ID = 0x0000F008;
+    constexpr uint32_t STREAM_SUBSCRIBE_ROUTINE_ID = 0x0000F009;
+    constexpr uint32_t STREAM_CREDIT_ROUTINE_ID = 0x0000F00A;
+    constexpr uint32_t STREAM_CANCEL_ROUTINE_ID = 0x0000F00B;
+    constexpr uint32_t STREAM_END_ROUTINE_ID = 0x0000F00C;
+    constexpr uint32_t COMPRESSION_NEGOTIATE_REQUEST_ROUTINE_ID = 0x0000F00D;
+    constexpr uint32_t COMPRESSION_NEGOTIATE_RESPONSE_ROUTINE_ID = 0x0000F00E;
+
+    // Batch frames
+    // Request payload:  [COUNT:4] COUNT x [ROUTINE_ID:4][LEN:4][request payload]
+    // Response payload: [COUNT:4] COUNT x [LEN:4][response frame] (LEN 0: no response)
+    constexpr size_t MAX_BATCH_CALLS = 64;
+
+    // Shared-memory negotiation
+    // Request: empty payload, memfd + request eventfd + response eventfd
+    //          attached with SCM_RIGHTS
+    // Response payload: [STATUS:1] (SHM_ACCEPTED, otherwise the socket stays in use)
+    constexpr uint8_t SHM_ACCEPTED = 0x00;
+    constexpr uint8_t SHM_DISABLED = 0x01;
+    constexpr uint8_t SHM_INVALID = 0x02;
+    constexpr uint8_t SHM_BUSY = 0x03;
+
+    // Server busy (load shedding): sent instead of a response when the
+    // server rejects a request under overload; the request ID is echoed
+    // Response payload: [ROUTINE_ID:4] of the rejected request
+    constexpr size_t SERVER_BUSY_PAYLOAD_SIZE = 4;
+
+    // Server statistics
+    // Request payload: [FORMAT:1] (empty: STATS_FORMAT_BINARY)
+    // Binary response payload:
+    //   [CONN_OPENED:8][CONN_CLOSED:8][COUNT:4] COUNT x
+    //   [ROUTINE_ID:4][NAME:string][REQUESTS:8][ERRORS:8][REJECTED:8][BYTES_IN:8][BYTES_OUT:8]
+    //   [queue wait][execution], each [COUNT:8][SUM_NS:8][MAX_NS:8][P50:8][P90:8][P99:8][P999:8]
+    //   Routines that do not fit the frame are left out.
+    // Prometheus response payload: [TEXT:string], cut after the last line that fits
+    constexpr uint8_t STATS_FORMAT_BINARY = 0x00;
+    constexpr uint8_t STATS_FORMAT_PROMETHEUS = 0x01;
+    constexpr uint32_t STATS_OTHER_ROUTINE_ID = 0xFFFFFFFF;   // Unregistered routines, summed
+
+    // Idle timeout: the connection's own inactivity timeout
+    // Request payload:  [TIMEOUT_MS:4] (0: server default)
+    // Response payload: [TIMEOUT_MS:4] now in effect, capped by the server (0: never)
+    constexpr size_t IDLE_TIMEOUT_PAYLOAD_SIZE = 4;
+
+    // Compression: from the response on, either side may send payloads
+    // compressed (FLAG_COMPRESSED); each decides by size on its own
+    // Request payload:  [DICTIONARY_ID:4] (0: none, see CompressionDictionary::Id)
+    // Response payload: [STATUS:1]
+    constexpr size_t COMPRESSION_NEGOTIATE_PAYLOAD_SIZE = 4;
+    constexpr size_t COMPRESSION_NEGOTIATE_RESPONSE_SIZE = 1;
+    constexpr uint8_t COMPRESSION_REFUSED = 0x00;
+    constexpr uint8_t COMPRESSION_LZ4 = 0x01;              // Without dictionary (none offered, or a different one)
+    constexpr uint8_t COMPRESSION_LZ4_DICTIONARY = 0x02;   // With the offered dictionary
+
+    // Streams: the server pushes a routine's response every INTERVAL_MS
+    // Subscribe (tagged; the request ID becomes the stream ID):
+    //   [ROUTINE_ID:4][INTERVAL_MS:4][CREDITS:4][request payload]
+    //   Answered by the routine's response frames, tagged with the stream
+    //   ID, the first one at once. Each frame spends a credit; without
+    //   credits the stream pauses.
+    // Credit (no response):  [STREAM_ID:4][CREDITS:4] more frames the client accepts
+    // Cancel:               [STREAM_ID:4], answered by End
+    // End (server to client, tagged with the stream ID): [STATUS:1], the
+    //   last frame of the stream
+    constexpr size_t STREAM_SUBSCRIBE_HEADER_SIZE = 12;
+    constexpr size_t STREAM_CREDIT_PAYLOAD_SIZE = 8;
+    constexpr size_t STREAM_CANCEL_PAYLOAD_SIZE = 4;
+    constexpr size_t STREAM_END_PAYLOAD_SIZE = 1;
+    constexpr uint8_t STREAM_CANCELLED = 0x00;
+    constexpr uint8_t STREAM_REJECTED = 0x01;   // Untagged, malformed, unknown routine or too many streams
+    constexpr uint8_t STREAM_FAILED = 0x02;     // The routine produced no response
+    constexpr size_t MAX_STREAMS_PER_CONNECTION = 16;
+
+    // Buffer sizes
+    constexpr size_t MAX_PACKET_SIZE = 8 * 1024;  // 8KB max packet
+    constexpr size_t MIN_PACKET_SIZE = 11;         // Minimum valid packet
+    constexpr size_t MAX_FD_PAYLOAD_SIZE = 256 * 1024 * 1024; // Largest request payload passed in a memfd
+
+    // Timeout settings
+    constexpr int CONNECTION_TIMEOUT_MS = 5000;    // 5 seconds
+    constexpr int READ_TIMEOUT_MS = 3000;          // 3 seconds
+    constexpr int INACTIVITY_TIMEOUT_SEC = 300;    // 5 minutes, default (see ServerConfig)
+
+    // UDS path
+    const std::string UDS_PATH = "/tmp/ipc_demo.sock";
+
+    // Retry configuration
+    constexpr int MAX_RETRIES = 2;
+
+    /**
+     * @brief Calculate minimum frame size
+     * START(1) + LENGTH(4) + ROUTINE_ID(4) + VERSION(1) + END(1) = 11 bytes
+     */
+    constexpr size_t GetMinFrameSize() {
+        return 11;
+    }
+
+    /**
+     * @brief Size of the header extension announced by the flags
+     * @param version_byte VERSION byte as sent on the wire
+     */
+    constexpr size_t GetExtensionSize(uint8_t version_byte) {
+        return ((version_byte & FLAG_REQUEST_ID) ? REQUEST_ID_SIZE : 0) +
+               ((version_byte & FLAG_TRACE_ID) ? TRACE_ID_SIZE : 0);
+    }
+
+    /**
+     * @brief Whether a routine ID belongs to the built-in (reserved) range
+     */
+    constexpr bool IsReservedRoutine(uint32_t routine_id) {
+        return routine_id >= RESERVED_ROUTINE_MIN && routine_id <= RESERVED_ROUTINE_MAX;
+    }
+
+} // namespace Protocol
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_PROTOCOL_HPP
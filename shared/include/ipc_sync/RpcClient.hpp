@@ -0,0 +1,209 @@
+/**
+ * @file RpcClient.hpp
+ * @brief Typed client stub generated from an RpcMethod schema
+ */
+#ifndef IPC_SYNC_RPC_CLIENT_HPP
+#define IPC_SYNC_RPC_CLIENT_HPP
+
+#include "ipc_sync/Channel.hpp"
+#include "ipc_sync/Schema.hpp"
+#include "ipc_sync/Protocol.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ipc_demo {
+
+/**
+ * @class RpcClient
+ * @brief Calls one RpcMethod over a Channel
+ *
+ * Encodes the request with MessageCodec, runs it on the channel and
+ * decodes the response frame. Stateless besides the channel, so one stub
+ * may be shared by many threads.
+ *
+ * @code
+ * RpcClient<CalculatorRpc> stub(channel);
+ * CalculatorResponse response;
+ * std::string error;
+ * if (stub.Call(CalculatorRequest{CalculatorOperation::Add, 1, 2}, response, error)) { ... }
+ * @endcode
+ */
+template <typename Method>
+class RpcClient {
+public:
+    using Request = typename Method::Request;
+    using Response = typename Method::Response;
+
+    /**
+     * @brief Completion callback for CallAsync
+     *
+     * Runs on the channel's event-loop thread (see Channel::ExecuteRPCAsync).
+     * response is only meaningful when success is true.
+     */
+    using Callback = std::function<void(bool success, const Response& response, const std::string& error)>;
+
+    /**
+     * @param channel Communication channel
+     * @throws std::invalid_argument if channel is null
+     */
+    explicit RpcClient(std::shared_ptr<Channel> channel)
+        : channel_(std::move(channel)) {
+        if (!channel_) {
+            throw std::invalid_argument("RpcClient: channel cannot be null");
+        }
+    }
+
+    /**
+     * @brief Blocking call
+     * @param error Set when returning false
+     * @return false if the RPC failed or the response is malformed
+     */
+    bool Call(const Request& request, Response& response, std::string& error) const {
+        RequestBuffer buffer(request);
+
+        uint8_t response_data[Protocol::MAX_PACKET_SIZE];
+        size_t response_len = 0;
+        if (!channel_->ExecuteRPC(Method::REQUEST_ROUTINE_ID, buffer.Data(), buffer.Size(),
+                                  response_data, sizeof(response_data), response_len)) {
+            error = "RPC failed: " + channel_->GetLastError();
+            return false;
+        }
+        return ParseResponse(response_data, response_len, response, error);
+    }
+
+    /**
+     * @brief Blocking call decoding the response in place
+     *
+     * View is a message with the Response layout whose strings are
+     * std::string_view (e.g. CalculatorResponseView). They point into
+     * buffer, so the response is valid while buffer is unchanged; no heap
+     * allocation is made on success.
+     *
+     * @param buffer At least Protocol::MAX_PACKET_SIZE bytes, owned by the caller
+     */
+    template <typename View>
+    bool CallView(const Request& request, uint8_t* buffer, size_t buffer_size,
+                  View& response, std::string& error) const {
+        RequestBuffer request_buffer(request);
+
+        size_t response_len = 0;
+        if (!channel_->ExecuteRPC(Method::REQUEST_ROUTINE_ID, request_buffer.Data(), request_buffer.Size(),
+                                  buffer, buffer_size, response_len)) {
+            error = "RPC failed: " + channel_->GetLastError();
+            return false;
+        }
+        return ParseResponse(buffer, response_len, response, error);
+    }
+
+    /**
+     * @brief Asynchronous call (needs a pipelined channel)
+     * @throws std::invalid_argument if callback is empty
+     */
+    void CallAsync(const Request& request, Callback callback) const {
+        if (!callback) {
+            throw std::invalid_argument("RpcClient: callback cannot be empty");
+        }
+
+        RequestBuffer buffer(request);
+        channel_->ExecuteRPCAsync(Method::REQUEST_ROUTINE_ID, buffer.Data(), buffer.Size(),
+            [callback = std::move(callback)](bool success, const uint8_t* frame,
+                                             size_t frame_len, const std::string& error) {
+                Response response{};
+                if (!success) {
+                    callback(false, response, "RPC failed: " + error);
+                    return;
+                }
+                std::string parse_error;
+                bool parsed = ParseResponse(frame, frame_len, response, parse_error);
+                callback(parsed, response, parse_error);
+            });
+    }
+
+    /**
+     * @brief Subscribe to this method: the server answers request every
+     *        options.interval_ms and callback gets each response
+     * @param callback Runs on the event-loop thread per response, then once
+     *        with success false when the stream ends (see Channel::Subscribe)
+     * @param stream_id Output: ID for Unsubscribe()
+     * @param error Set when returning false
+     * @throws std::invalid_argument if callback is empty
+     */
+    bool Subscribe(const Request& request, const StreamOptions& options, Callback callback,
+                   uint32_t& stream_id, std::string& error) const {
+        if (!callback) {
+            throw std::invalid_argument("RpcClient: callback cannot be empty");
+        }
+
+        RequestBuffer buffer(request);
+        bool subscribed = channel_->Subscribe(Method::REQUEST_ROUTINE_ID, buffer.Data(), buffer.Size(), options,
+            [callback = std::move(callback)](bool success, const uint8_t* frame,
+                                             size_t frame_len, const std::string& stream_error) {
+                Response response{};
+                if (!success) {
+                    callback(false, response, stream_error);
+                    return;
+                }
+                std::string parse_error;
+                bool parsed = ParseResponse(frame, frame_len, response, parse_error);
+                callback(parsed, response, parse_error);
+            }, stream_id);
+        if (!subscribed) {
+            error = "Subscribe failed: " + channel_->GetLastError();
+        }
+        return subscribed;
+    }
+
+    /**
+     * @brief End a stream started with Subscribe
+     */
+    bool Unsubscribe(uint32_t stream_id) const {
+        return channel_->Unsubscribe(stream_id);
+    }
+
+    /**
+     * @brief Decode a response frame of this method (e.g. from a batch)
+     * @tparam View Response, or a view variant of it (see CallView)
+     */
+    template <typename View = Response>
+    static bool ParseResponse(const uint8_t* frame, size_t frame_len, View& response, std::string& error) {
+        static_assert(MessageCodec<View>::MIN_SIZE == MessageCodec<Response>::MIN_SIZE,
+                      "View must have the layout of the response");
+        return DecodeFrame(Method::RESPONSE_ROUTINE_ID, frame, frame_len, response, error);
+    }
+
+private:
+    /**
+     * @class RequestBuffer
+     * @brief Encoded request; on the stack for fixed-size requests
+     */
+    class RequestBuffer {
+    public:
+        explicit RequestBuffer(const Request& request) {
+            if constexpr (MessageCodec<Request>::FIXED_SIZE) {
+                MessageCodec<Request>::Write(data_.data(), request);
+            } else {
+                data_.resize(MessageCodec<Request>::Size(request));
+                MessageCodec<Request>::Write(data_.data(), request);
+            }
+        }
+
+        const uint8_t* Data() const { return data_.data(); }
+        size_t Size() const { return data_.size(); }
+
+    private:
+        std::conditional_t<MessageCodec<Request>::FIXED_SIZE,
+                           std::array<uint8_t, MessageCodec<Request>::MIN_SIZE>,
+                           std::vector<uint8_t>> data_;
+    };
+
+    std::shared_ptr<Channel> channel_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_RPC_CLIENT_HPP
@@ -0,0 +1,180 @@
+/**
+ * @file ShmTransport.hpp
+ * @brief Shared-memory transport: two SPSC byte rings in a memfd plus eventfd doorbells
+ */
+
+#ifndef IPC_SYNC_SHM_TRANSPORT_HPP
+#define IPC_SYNC_SHM_TRANSPORT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ipc_demo {
+
+/**
+ * @class ShmRing
+ * @brief Lock-free single-producer/single-consumer byte ring in shared memory
+ *
+ * The ring carries the ordinary frame byte stream, so the consumer feeds
+ * it into a FrameParser exactly like socket data. Producer and consumer
+ * live in different processes; head/tail are the only shared state.
+ *
+ * Wakeups: a consumer about to sleep sets reader_waiting and re-checks the
+ * ring; a producer rings the consumer's doorbell only when the flag is set.
+ * A producer that could not write everything sets writer_waiting and the
+ * consumer rings back once it made room.
+ *
+ * Contents are written by an untrusted peer, so Read() validates the
+ * indices and reports corruption instead of trusting them.
+ */
+class ShmRing {
+public:
+    /**
+     * @struct Header
+     * @brief Shared ring state (placed at the start of the ring region)
+     */
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head;            // Consumer position
+        alignas(64) std::atomic<uint64_t> tail;            // Producer position
+        alignas(64) std::atomic<uint32_t> reader_waiting;  // Consumer asleep
+        std::atomic<uint32_t> writer_waiting;              // Producer waits for space
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "ShmRing needs lock-free 64-bit atomics to work across processes");
+
+    ShmRing() = default;
+
+    /**
+     * @brief Attach to a ring region
+     * @param region Start of the ring region (Header followed by data)
+     * @param capacity Data capacity in bytes (power of two)
+     */
+    ShmRing(void* region, size_t capacity);
+
+    /**
+     * @brief Bytes needed for a ring with the given data capacity
+     */
+    static size_t RegionSize(size_t capacity);
+
+    /**
+     * @brief Reset indices and flags (creator only, before sharing)
+     */
+    void Initialize();
+
+    /**
+     * @brief Copy as much of data as fits (producer only)
+     * @return Bytes written
+     */
+    size_t Write(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Copy up to max bytes out of the ring (consumer only)
+     * @param corrupt Output: set if the peer left inconsistent indices
+     * @return Bytes read
+     */
+    size_t Read(uint8_t* dst, size_t max, bool& corrupt);
+
+    bool Empty() const;
+    size_t Capacity() const { return capacity_; }
+
+    void SetReaderWaiting(bool waiting);
+    bool ReaderWaiting() const;
+    void SetWriterWaiting(bool waiting);
+    bool WriterWaiting() const;
+
+private:
+    Header* header_{nullptr};
+    uint8_t* data_{nullptr};
+    size_t capacity_{0};
+};
+
+/**
+ * @class ShmTransport
+ * @brief One connection's shared-memory channel
+ *
+ * Layout of the memfd: [Layout][request ring][response ring].
+ * The client creates the memfd and both eventfds, then passes them to the
+ * server with SCM_RIGHTS. The client produces into the request ring and
+ * the server into the response ring.
+ *
+ * Doorbells:
+ * - request_event: client -> server (requests available, or room freed in
+ *   the response ring)
+ * - response_event: server -> client (responses available)
+ */
+class ShmTransport {
+public:
+    static constexpr uint32_t MAGIC = 0x53484D31;  // "SHM1"
+    static constexpr size_t MIN_RING_CAPACITY = 16 * 1024;
+    static constexpr size_t MAX_RING_CAPACITY = 64 * 1024 * 1024;
+
+    /**
+     * @brief Create a new transport (client side)
+     * @param ring_capacity Data capacity of each ring (rounded up to a power of two)
+     * @param error Output: reason on failure
+     * @return Transport, or nullptr on failure
+     */
+    static std::unique_ptr<ShmTransport> Create(size_t ring_capacity, std::string& error);
+
+    /**
+     * @brief Map a transport received from a client (server side)
+     *
+     * Takes ownership of the descriptors, also on failure.
+     *
+     * @return Transport, or nullptr if the memfd is not a valid transport
+     */
+    static std::unique_ptr<ShmTransport> Attach(int memfd, int request_event, int response_event,
+                                                std::string& error);
+
+    ~ShmTransport();
+
+    // Disable copy/move
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+    ShmTransport(ShmTransport&&) = delete;
+    ShmTransport& operator=(ShmTransport&&) = delete;
+
+    ShmRing& Requests() { return requests_; }
+    ShmRing& Responses() { return responses_; }
+
+    int MemFd() const { return memfd_; }
+    int RequestEventFd() const { return request_event_; }
+    int ResponseEventFd() const { return response_event_; }
+
+    /**
+     * @brief Ring a doorbell eventfd
+     */
+    static void Notify(int event_fd);
+
+    /**
+     * @brief Reset a doorbell eventfd after it woke us
+     */
+    static void Drain(int event_fd);
+
+private:
+    struct Layout {
+        uint32_t magic;
+        uint32_t ring_capacity;
+        uint64_t reserved;
+    };
+
+    ShmTransport(int memfd, int request_event, int response_event);
+
+    bool Map(size_t ring_capacity, std::string& error);
+
+    int memfd_;
+    int request_event_;
+    int response_event_;
+    void* base_{nullptr};
+    size_t size_{0};
+    ShmRing requests_;
+    ShmRing responses_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_SHM_TRANSPORT_HPP
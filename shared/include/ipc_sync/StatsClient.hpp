@@ -0,0 +1,101 @@
+/**
+ * @file StatsClient.hpp
+ * @brief Client-side proxy for the built-in stats routine (Pimpl interface)
+ */
+#ifndef IPC_SYNC_STATS_CLIENT_HPP
+#define IPC_SYNC_STATS_CLIENT_HPP
+
+#include "ipc_sync/Channel.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ipc_demo {
+
+/**
+ * @class StatsClient
+ * @brief Reads the server's request metrics
+ *
+ * Uses Pimpl idiom - all implementation is hidden in shared library
+ */
+class StatsClient {
+public:
+    /**
+     * @brief Latency summary, in nanoseconds
+     */
+    struct Histogram {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+        uint64_t p50_ns = 0;
+        uint64_t p90_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t p999_ns = 0;
+    };
+
+    /**
+     * @brief Totals for one routine ID (Protocol::STATS_OTHER_ROUTINE_ID:
+     *        every unregistered routine)
+     */
+    struct RoutineStats {
+        uint32_t routine_id = 0;
+        std::string name;
+        uint64_t requests = 0;
+        uint64_t errors = 0;
+        uint64_t rejected = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        Histogram queue_wait;
+        Histogram execution;
+    };
+
+    struct StatsResult {
+        bool success = false;
+        uint64_t connections_opened = 0;
+        uint64_t connections_closed = 0;
+        std::vector<RoutineStats> routines;
+        std::string error_message;
+    };
+
+    struct TextResult {
+        bool success = false;
+        std::string text;
+        std::string error_message;
+    };
+
+    /**
+     * @brief Construct StatsClient proxy
+     * @param channel Communication channel
+     */
+    explicit StatsClient(std::shared_ptr<Channel> channel);
+
+    ~StatsClient();
+
+    // Disable copy/move
+    StatsClient(const StatsClient&) = delete;
+    StatsClient& operator=(const StatsClient&) = delete;
+    StatsClient(StatsClient&&) = delete;
+    StatsClient& operator=(StatsClient&&) = delete;
+
+    /**
+     * @brief Get the per-routine counters and latency summaries
+     */
+    StatsResult GetStats();
+
+    /**
+     * @brief Get the metrics in the Prometheus text format
+     *
+     * Cut after the last line fitting one frame ("# truncated" is appended).
+     */
+    TextResult GetPrometheusText();
+
+private:
+    // Opaque pointer to implementation
+    struct Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_STATS_CLIENT_HPP
@@ -0,0 +1,74 @@
+/**
+ * @file TimeSchema.hpp
+ * @brief Time RPC messages, shared by the client proxy and the service
+ */
+#ifndef IPC_SYNC_TIME_SCHEMA_HPP
+#define IPC_SYNC_TIME_SCHEMA_HPP
+
+#include "ipc_sync/Schema.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ipc_demo {
+
+enum class TimeOperation : uint8_t {
+    GetTimestamp = 0x01
+};
+
+enum class TimeStatus : uint8_t {
+    Success = 0x00,
+    InvalidOperation = 0x01,
+    InvalidInput = 0x02
+};
+
+/**
+ * @struct TimeRequest
+ * @brief [operation:byte]
+ */
+struct TimeRequest {
+    TimeOperation op;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&TimeRequest::op);
+    }
+};
+
+/**
+ * @struct TimeResponse
+ * @brief [status:byte][timestamp:string][unix_timestamp:int64][error_msg:string]
+ */
+struct TimeResponse {
+    TimeStatus status;
+    std::string timestamp;
+    int64_t unix_timestamp;
+    std::string error;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&TimeResponse::status, &TimeResponse::timestamp,
+                               &TimeResponse::unix_timestamp, &TimeResponse::error);
+    }
+};
+
+/**
+ * @struct TimeResponseView
+ * @brief TimeResponse decoded in place (strings point into the frame)
+ */
+struct TimeResponseView {
+    TimeStatus status;
+    std::string_view timestamp;
+    int64_t unix_timestamp;
+    std::string_view error;
+
+    static constexpr auto Fields() {
+        return std::make_tuple(&TimeResponseView::status, &TimeResponseView::timestamp,
+                               &TimeResponseView::unix_timestamp, &TimeResponseView::error);
+    }
+};
+
+using TimeRpc = RpcMethod<0x00002000, 0x00002001, TimeRequest, TimeResponse>;
+
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_TIME_SCHEMA_HPP
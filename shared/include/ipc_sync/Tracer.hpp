@@ -0,0 +1,275 @@
+/**
+ * @file Tracer.hpp
+ * @brief Sampling tracer: per-stage timestamps of individual requests
+ *
+ * A sampled request carries a Span: one timestamp per stage it passes
+ * (Now(), the TSC on x86). When it completes the span goes into the
+ * recording thread's ring, a lock-free single-producer ring owned by the
+ * process-wide Tracer; a full ring drops the span and counts it. Collect()
+ * moves every ring's spans aside, ExportChromeTrace() turns them into the
+ * Chrome trace JSON that chrome://tracing and ui.perfetto.dev open.
+ *
+ * Requests that are not sampled cost one random number (Sampler::Sample)
+ * and a few thread-local accesses; with a rate of 0, nothing is drawn.
+ *
+ * A client that samples a call sends its trace ID with the request
+ * (Protocol::FLAG_TRACE_ID); the server traces such requests too, under
+ * the same ID. Timestamps are exported on CLOCK_MONOTONIC, so traces of a
+ * client and a server on one machine can be merged into one timeline,
+ * where flow arrows join the spans of a trace ID.
+ */
+#ifndef IPC_SYNC_TRACER_HPP
+#define IPC_SYNC_TRACER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace ipc_demo {
+namespace trace {
+
+enum class Side : uint8_t {
+    Client,
+    Server
+};
+
+// Stages of a client call, in order; each ends the interval named after it
+enum class ClientStage : uint8_t {
+    Start,      // ExecuteRPC entered
+    Encoded,    // "encode": connected if needed, request frame built (compressed, memfd sealed)
+    Sent,       // "send": request written (not seen with io_uring: folded into "wait")
+    Received,   // "wait": response read
+    Done        // "decode": response checked and inflated
+};
+
+// Stages of a server request, in order; each ends the interval named after it
+enum class ServerStage : uint8_t {
+    Received,   // Bytes holding the frame were read
+    Parsed,     // "parse": header decoded, payload inflated
+    Dequeued,   // "queue": a worker picked the request up (offloaded only)
+    Lookup,     // "lookup": ServiceManager found the route
+    Executed,   // "execute": the service returned
+    Sent        // "send": response written or queued
+};
+
+constexpr size_t MAX_STAGES = 6;
+
+/**
+ * @brief Current timestamp in ticks (TSC where available, else nanoseconds)
+ */
+inline uint64_t Now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @struct Span
+ * @brief Stage timestamps of one request (0 = stage not passed)
+ */
+struct Span {
+    uint64_t trace_id = 0;
+    uint64_t ticks[MAX_STAGES] = {};
+    uint32_t routine_id = 0;
+    Side side = Side::Server;
+
+    void Mark(ClientStage stage) { ticks[static_cast<size_t>(stage)] = Now(); }
+    void Mark(ServerStage stage) { ticks[static_cast<size_t>(stage)] = Now(); }
+    uint64_t At(ClientStage stage) const { return ticks[static_cast<size_t>(stage)]; }
+    uint64_t At(ServerStage stage) const { return ticks[static_cast<size_t>(stage)]; }
+};
+
+namespace detail {
+inline thread_local Span* active_span = nullptr;
+} // namespace detail
+
+/**
+ * @class ScopedActiveSpan
+ * @brief Makes span the target of MarkActive() on this thread for a scope
+ */
+class ScopedActiveSpan {
+public:
+    explicit ScopedActiveSpan(Span* span) : previous_(detail::active_span) { detail::active_span = span; }
+    ~ScopedActiveSpan() { detail::active_span = previous_; }
+
+    // Disable copy/move
+    ScopedActiveSpan(const ScopedActiveSpan&) = delete;
+    ScopedActiveSpan& operator=(const ScopedActiveSpan&) = delete;
+    ScopedActiveSpan(ScopedActiveSpan&&) = delete;
+    ScopedActiveSpan& operator=(ScopedActiveSpan&&) = delete;
+
+private:
+    Span* previous_;
+};
+
+/**
+ * @brief Mark a stage of this thread's active span, if any, the first time
+ *        it is passed (a batch looks up every call; the first one counts)
+ */
+inline void MarkActive(ServerStage stage) {
+    Span* span = detail::active_span;
+    if (span && span->At(stage) == 0) {
+        span->Mark(stage);
+    }
+}
+
+/**
+ * @class Sampler
+ * @brief Decides which requests are traced
+ *
+ * Thread Safety: Sample() draws from a thread-local generator, so one
+ * Sampler may be shared by any number of threads.
+ */
+class Sampler {
+public:
+    /**
+     * @param rate Fraction of requests to trace, clamped to [0, 1]
+     */
+    explicit Sampler(double rate = 0.0);
+
+    bool Enabled() const { return enabled_; }
+
+    /**
+     * @brief Whether to trace the next request
+     */
+    bool Sample() const;
+
+private:
+    bool enabled_{false};
+    bool always_{false};
+    uint64_t threshold_{0};
+};
+
+/**
+ * @brief Random, non-zero trace ID
+ */
+uint64_t NewTraceId();
+
+/**
+ * @struct CollectedSpan
+ * @brief Span taken out of a ring, with the thread that recorded it
+ */
+struct CollectedSpan {
+    Span span;
+    uint32_t thread_id = 0;
+};
+
+/**
+ * @class Tracer
+ * @brief Process-wide span rings and their export
+ *
+ * Thread Safety: Record() is lock-free and only touches the calling
+ * thread's ring. Collect(), TakeSpans() and the exports may be called from
+ * any thread; they serialize among themselves.
+ */
+class Tracer {
+public:
+    static constexpr size_t RING_CAPACITY = 4096;      // Spans per recording thread
+    static constexpr size_t MAX_RETAINED = 262144;     // Collected spans kept for export
+
+    /**
+     * @brief The tracer of this process
+     */
+    static Tracer& Global();
+
+    ~Tracer();
+
+    // Disable copy/move
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+    Tracer& operator=(Tracer&&) = delete;
+
+    /**
+     * @brief Store a finished span in the calling thread's ring
+     *
+     * The ring is allocated on the thread's first span. Dropped (and
+     * counted in Dropped()) if the ring is full.
+     */
+    void Record(const Span& span);
+
+    /**
+     * @brief Move every ring's spans into the retained set
+     *
+     * Call periodically (the server app does, every second) so rings do not
+     * overflow between exports. Beyond MAX_RETAINED, spans are dropped.
+     * @return Number of spans collected now
+     */
+    size_t Collect();
+
+    /**
+     * @brief Collect, then hand over (and forget) every retained span
+     */
+    std::vector<CollectedSpan> TakeSpans();
+
+    /**
+     * @brief Spans lost to full rings or the retained limit
+     */
+    uint64_t Dropped() const;
+
+    /**
+     * @brief Take every span as a Chrome trace JSON document
+     *
+     * Each span is a complete ("X") event with one nested event per stage
+     * interval. pid is this process, tid the recording thread, timestamps
+     * are CLOCK_MONOTONIC microseconds. Spans with a trace ID also get a
+     * flow event: the client's starts at its send, the server's ends at
+     * its receive.
+     */
+    std::string ExportChromeTrace();
+
+    /**
+     * @brief ExportChromeTrace() into a file (replaced atomically)
+     * @return false if the file could not be written
+     */
+    bool WriteChromeTrace(const std::string& path);
+
+    /**
+     * @brief Nanoseconds per tick, measured against CLOCK_MONOTONIC
+     */
+    double NsPerTick();
+
+    /**
+     * @brief CLOCK_MONOTONIC nanoseconds of a tick count
+     */
+    uint64_t TicksToNs(uint64_t ticks);
+
+private:
+    struct Ring;
+    struct ThreadRing;
+
+    Tracer();
+
+    Ring* RegisterThread();
+    void Calibrate();
+
+    mutable std::mutex mutex_;                  // Guards everything below
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::vector<CollectedSpan> retained_;
+    std::atomic<uint64_t> dropped_{0};          // Retained-limit drops (ring drops are per ring)
+
+    // Calibration: a (ticks, ns) pair at start, refreshed on export
+    uint64_t base_ticks_{0};
+    uint64_t base_ns_{0};
+    double ns_per_tick_{1.0};
+
+    static thread_local ThreadRing thread_ring_;    // The calling thread's ring
+};
+
+} // namespace trace
+} // namespace ipc_demo
+
+#endif // IPC_SYNC_TRACER_HPP